@@ -0,0 +1,40 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by CMake Version 3.25
+cmake_policy(SET CMP0009 NEW)
+
+# BENCH_SRCS at bench/CMakeLists.txt:47 (file)
+file(GLOB NEW_GLOB LIST_DIRECTORIES true "/root/repo/bench/*.c")
+set(OLD_GLOB
+  "/root/repo/bench/bench_gc_live.c"
+  "/root/repo/bench/bench_gc_scaling.c"
+  "/root/repo/bench/bench_gc_snapshot.c"
+  "/root/repo/bench/bench_gc_threads.c"
+  "/root/repo/bench/bench_gc_trees.c"
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_bench_build/CMakeFiles/cmake.verify_globs")
+endif()
+
+# TEST_SRCS at tests/CMakeLists.txt:86 (file)
+file(GLOB_RECURSE NEW_GLOB LIST_DIRECTORIES false "/root/repo/tests/*.c")
+set(OLD_GLOB
+  "/root/repo/tests/test_cgroup.c"
+  "/root/repo/tests/test_double_free.c"
+  "/root/repo/tests/test_free_reuse.c"
+  "/root/repo/tests/test_gc.c"
+  "/root/repo/tests/test_graph.c"
+  "/root/repo/tests/test_internal_fragmentation.c"
+  "/root/repo/tests/test_limits.c"
+  "/root/repo/tests/test_linked_list.c"
+  "/root/repo/tests/test_max_heap.c"
+  "/root/repo/tests/test_memalloc.c"
+  "/root/repo/tests/test_multi_strategy.c"
+  "/root/repo/tests/test_psi.c"
+  "/root/repo/tests/test_realloc.c"
+  "/root/repo/tests/test_tags.c"
+  )
+if(NOT "${NEW_GLOB}" STREQUAL "${OLD_GLOB}")
+  message("-- GLOB mismatch!")
+  file(TOUCH_NOCREATE "/root/repo/_bench_build/CMakeFiles/cmake.verify_globs")
+endif()
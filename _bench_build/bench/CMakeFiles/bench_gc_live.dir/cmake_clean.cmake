@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/bench/Release/bench_gc_live"
+  "../bin/bench/Release/bench_gc_live.pdb"
+  "CMakeFiles/bench_gc_live.dir/bench_gc_live.c.o"
+  "CMakeFiles/bench_gc_live.dir/bench_gc_live.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/bench_gc_live.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/bench/Release/bench_gc_scaling"
+  "../bin/bench/Release/bench_gc_scaling.pdb"
+  "CMakeFiles/bench_gc_scaling.dir/bench_gc_scaling.c.o"
+  "CMakeFiles/bench_gc_scaling.dir/bench_gc_scaling.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/bench_gc_scaling.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
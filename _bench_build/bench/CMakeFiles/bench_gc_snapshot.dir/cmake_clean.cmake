@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/bench/Release/bench_gc_snapshot"
+  "../bin/bench/Release/bench_gc_snapshot.pdb"
+  "CMakeFiles/bench_gc_snapshot.dir/bench_gc_snapshot.c.o"
+  "CMakeFiles/bench_gc_snapshot.dir/bench_gc_snapshot.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/bench_gc_snapshot.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/bench/Release/bench_gc_threads"
+  "../bin/bench/Release/bench_gc_threads.pdb"
+  "CMakeFiles/bench_gc_threads.dir/bench_gc_threads.c.o"
+  "CMakeFiles/bench_gc_threads.dir/bench_gc_threads.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/bench_gc_threads.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
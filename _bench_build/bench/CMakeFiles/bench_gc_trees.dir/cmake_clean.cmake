@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/bench/Release/bench_gc_trees"
+  "../bin/bench/Release/bench_gc_trees.pdb"
+  "CMakeFiles/bench_gc_trees.dir/bench_gc_trees.c.o"
+  "CMakeFiles/bench_gc_trees.dir/bench_gc_trees.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/bench_gc_trees.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
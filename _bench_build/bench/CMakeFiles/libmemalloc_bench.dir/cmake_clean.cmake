@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/Release/liblibmemalloc_bench.a"
+  "/root/repo/bin/Release/liblibmemalloc_bench.pdb"
+  "CMakeFiles/libmemalloc_bench.dir/__/src/libmemalloc.c.o"
+  "CMakeFiles/libmemalloc_bench.dir/__/src/libmemalloc.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/libmemalloc_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
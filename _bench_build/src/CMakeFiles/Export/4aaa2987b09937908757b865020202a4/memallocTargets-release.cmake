@@ -0,0 +1,29 @@
+#----------------------------------------------------------------
+# Generated CMake target import file for configuration "Release".
+#----------------------------------------------------------------
+
+# Commands may need to know the format version.
+set(CMAKE_IMPORT_FILE_VERSION 1)
+
+# Import target "memalloc::memalloc_static" for configuration "Release"
+set_property(TARGET memalloc::memalloc_static APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(memalloc::memalloc_static PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_RELEASE "C"
+  IMPORTED_LOCATION_RELEASE "${_IMPORT_PREFIX}/lib/libmemalloc.a"
+  )
+
+list(APPEND _cmake_import_check_targets memalloc::memalloc_static )
+list(APPEND _cmake_import_check_files_for_memalloc::memalloc_static "${_IMPORT_PREFIX}/lib/libmemalloc.a" )
+
+# Import target "memalloc::memalloc" for configuration "Release"
+set_property(TARGET memalloc::memalloc APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(memalloc::memalloc PROPERTIES
+  IMPORTED_LOCATION_RELEASE "${_IMPORT_PREFIX}/lib/libmemalloc.so.3.5.00"
+  IMPORTED_SONAME_RELEASE "libmemalloc.so.3"
+  )
+
+list(APPEND _cmake_import_check_targets memalloc::memalloc )
+list(APPEND _cmake_import_check_files_for_memalloc::memalloc "${_IMPORT_PREFIX}/lib/libmemalloc.so.3.5.00" )
+
+# Commands beyond this point should not need to know the version.
+set(CMAKE_IMPORT_FILE_VERSION)
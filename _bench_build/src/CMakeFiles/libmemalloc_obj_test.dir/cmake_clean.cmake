@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libmemalloc_obj_test.dir/libmemalloc.c.o"
+  "CMakeFiles/libmemalloc_obj_test.dir/libmemalloc.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/libmemalloc_obj_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
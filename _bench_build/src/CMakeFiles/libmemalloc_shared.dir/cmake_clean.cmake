@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/Release/libmemalloc.pdb"
+  "/root/repo/bin/Release/libmemalloc.so"
+  "/root/repo/bin/Release/libmemalloc.so.3"
+  "/root/repo/bin/Release/libmemalloc.so.3.5.00"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/libmemalloc_shared.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/test/Release/libmemalloc_cov.pdb"
+  "/root/repo/bin/test/Release/libmemalloc_cov.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/libmemalloc_shared_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/Release/libmemalloc.a"
+  "/root/repo/bin/Release/libmemalloc.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/libmemalloc_static.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/Release/libmemalloc.a"
+)
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/tests/Release/test_cgroup"
+  "../bin/tests/Release/test_cgroup.pdb"
+  "CMakeFiles/test_cgroup.dir/test_cgroup.c.o"
+  "CMakeFiles/test_cgroup.dir/test_cgroup.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_cgroup.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
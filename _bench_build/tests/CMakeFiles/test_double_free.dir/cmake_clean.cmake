@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/tests/Release/test_double_free"
+  "../bin/tests/Release/test_double_free.pdb"
+  "CMakeFiles/test_double_free.dir/test_double_free.c.o"
+  "CMakeFiles/test_double_free.dir/test_double_free.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_double_free.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/tests/Release/test_free_reuse"
+  "../bin/tests/Release/test_free_reuse.pdb"
+  "CMakeFiles/test_free_reuse.dir/test_free_reuse.c.o"
+  "CMakeFiles/test_free_reuse.dir/test_free_reuse.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_free_reuse.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
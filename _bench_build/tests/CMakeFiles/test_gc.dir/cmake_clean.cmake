@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/tests/Release/test_gc"
+  "../bin/tests/Release/test_gc.pdb"
+  "CMakeFiles/test_gc.dir/test_gc.c.o"
+  "CMakeFiles/test_gc.dir/test_gc.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_gc.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/tests/Release/test_graph"
+  "../bin/tests/Release/test_graph.pdb"
+  "CMakeFiles/test_graph.dir/test_graph.c.o"
+  "CMakeFiles/test_graph.dir/test_graph.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_graph.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
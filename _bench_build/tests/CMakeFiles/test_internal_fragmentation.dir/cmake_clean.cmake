@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/tests/Release/test_internal_fragmentation"
+  "../bin/tests/Release/test_internal_fragmentation.pdb"
+  "CMakeFiles/test_internal_fragmentation.dir/test_internal_fragmentation.c.o"
+  "CMakeFiles/test_internal_fragmentation.dir/test_internal_fragmentation.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_internal_fragmentation.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/tests/Release/test_limits"
+  "../bin/tests/Release/test_limits.pdb"
+  "CMakeFiles/test_limits.dir/test_limits.c.o"
+  "CMakeFiles/test_limits.dir/test_limits.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_limits.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
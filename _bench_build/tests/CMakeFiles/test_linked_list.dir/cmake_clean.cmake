@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/tests/Release/test_linked_list"
+  "../bin/tests/Release/test_linked_list.pdb"
+  "CMakeFiles/test_linked_list.dir/test_linked_list.c.o"
+  "CMakeFiles/test_linked_list.dir/test_linked_list.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_linked_list.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
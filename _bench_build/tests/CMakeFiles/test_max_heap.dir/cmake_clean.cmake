@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/tests/Release/test_max_heap"
+  "../bin/tests/Release/test_max_heap.pdb"
+  "CMakeFiles/test_max_heap.dir/test_max_heap.c.o"
+  "CMakeFiles/test_max_heap.dir/test_max_heap.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_max_heap.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/tests/Release/test_memalloc"
+  "../bin/tests/Release/test_memalloc.pdb"
+  "CMakeFiles/test_memalloc.dir/test_memalloc.c.o"
+  "CMakeFiles/test_memalloc.dir/test_memalloc.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_memalloc.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
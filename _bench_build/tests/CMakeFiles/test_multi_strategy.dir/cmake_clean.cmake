@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/tests/Release/test_multi_strategy"
+  "../bin/tests/Release/test_multi_strategy.pdb"
+  "CMakeFiles/test_multi_strategy.dir/test_multi_strategy.c.o"
+  "CMakeFiles/test_multi_strategy.dir/test_multi_strategy.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_multi_strategy.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/tests/Release/test_psi"
+  "../bin/tests/Release/test_psi.pdb"
+  "CMakeFiles/test_psi.dir/test_psi.c.o"
+  "CMakeFiles/test_psi.dir/test_psi.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_psi.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
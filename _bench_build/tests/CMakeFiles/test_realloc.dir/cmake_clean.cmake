@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/tests/Release/test_realloc"
+  "../bin/tests/Release/test_realloc.pdb"
+  "CMakeFiles/test_realloc.dir/test_realloc.c.o"
+  "CMakeFiles/test_realloc.dir/test_realloc.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_realloc.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
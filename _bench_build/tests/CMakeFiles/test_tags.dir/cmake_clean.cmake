@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/tests/Release/test_tags"
+  "../bin/tests/Release/test_tags.pdb"
+  "CMakeFiles/test_tags.dir/test_tags.c.o"
+  "CMakeFiles/test_tags.dir/test_tags.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_tags.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,36 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests
+# Build directory: /root/repo/_bench_build/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(test_cgroup "/root/repo/_bench_build/bin/tests/Release/test_cgroup")
+set_tests_properties(test_cgroup PROPERTIES  ENVIRONMENT "TZ=UTC" LABELS "unit" PROCESSORS "1" RUN_SERIAL "TRUE" TIMEOUT "60" WORKING_DIRECTORY "/root/repo/_bench_build/bin/tests/Release" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;176;add_test;/root/repo/tests/CMakeLists.txt;199;add_memalloc_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_double_free "/root/repo/_bench_build/bin/tests/Release/test_double_free")
+set_tests_properties(test_double_free PROPERTIES  ENVIRONMENT "TZ=UTC" LABELS "unit" PROCESSORS "1" RUN_SERIAL "TRUE" TIMEOUT "60" WORKING_DIRECTORY "/root/repo/_bench_build/bin/tests/Release" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;176;add_test;/root/repo/tests/CMakeLists.txt;199;add_memalloc_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_free_reuse "/root/repo/_bench_build/bin/tests/Release/test_free_reuse")
+set_tests_properties(test_free_reuse PROPERTIES  ENVIRONMENT "TZ=UTC" LABELS "unit" PROCESSORS "1" RUN_SERIAL "TRUE" TIMEOUT "60" WORKING_DIRECTORY "/root/repo/_bench_build/bin/tests/Release" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;176;add_test;/root/repo/tests/CMakeLists.txt;199;add_memalloc_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_gc "/root/repo/_bench_build/bin/tests/Release/test_gc")
+set_tests_properties(test_gc PROPERTIES  ENVIRONMENT "TZ=UTC" LABELS "unit" PROCESSORS "1" RUN_SERIAL "TRUE" TIMEOUT "60" WORKING_DIRECTORY "/root/repo/_bench_build/bin/tests/Release" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;176;add_test;/root/repo/tests/CMakeLists.txt;199;add_memalloc_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_graph "/root/repo/_bench_build/bin/tests/Release/test_graph")
+set_tests_properties(test_graph PROPERTIES  ENVIRONMENT "TZ=UTC" LABELS "unit" PROCESSORS "1" RUN_SERIAL "TRUE" TIMEOUT "60" WORKING_DIRECTORY "/root/repo/_bench_build/bin/tests/Release" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;176;add_test;/root/repo/tests/CMakeLists.txt;199;add_memalloc_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_internal_fragmentation "/root/repo/_bench_build/bin/tests/Release/test_internal_fragmentation")
+set_tests_properties(test_internal_fragmentation PROPERTIES  ENVIRONMENT "TZ=UTC" LABELS "unit" PROCESSORS "1" RUN_SERIAL "TRUE" TIMEOUT "60" WORKING_DIRECTORY "/root/repo/_bench_build/bin/tests/Release" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;176;add_test;/root/repo/tests/CMakeLists.txt;199;add_memalloc_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_limits "/root/repo/_bench_build/bin/tests/Release/test_limits")
+set_tests_properties(test_limits PROPERTIES  ENVIRONMENT "TZ=UTC" LABELS "unit" PROCESSORS "1" RUN_SERIAL "TRUE" TIMEOUT "60" WORKING_DIRECTORY "/root/repo/_bench_build/bin/tests/Release" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;176;add_test;/root/repo/tests/CMakeLists.txt;199;add_memalloc_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_linked_list "/root/repo/_bench_build/bin/tests/Release/test_linked_list")
+set_tests_properties(test_linked_list PROPERTIES  ENVIRONMENT "TZ=UTC" LABELS "unit" PROCESSORS "1" RUN_SERIAL "TRUE" TIMEOUT "60" WORKING_DIRECTORY "/root/repo/_bench_build/bin/tests/Release" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;176;add_test;/root/repo/tests/CMakeLists.txt;199;add_memalloc_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_max_heap "/root/repo/_bench_build/bin/tests/Release/test_max_heap")
+set_tests_properties(test_max_heap PROPERTIES  ENVIRONMENT "TZ=UTC" LABELS "unit" PROCESSORS "1" RUN_SERIAL "TRUE" TIMEOUT "60" WORKING_DIRECTORY "/root/repo/_bench_build/bin/tests/Release" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;176;add_test;/root/repo/tests/CMakeLists.txt;199;add_memalloc_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_memalloc "/root/repo/_bench_build/bin/tests/Release/test_memalloc")
+set_tests_properties(test_memalloc PROPERTIES  ENVIRONMENT "TZ=UTC" LABELS "unit" PROCESSORS "1" RUN_SERIAL "TRUE" TIMEOUT "60" WORKING_DIRECTORY "/root/repo/_bench_build/bin/tests/Release" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;176;add_test;/root/repo/tests/CMakeLists.txt;199;add_memalloc_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_multi_strategy "/root/repo/_bench_build/bin/tests/Release/test_multi_strategy")
+set_tests_properties(test_multi_strategy PROPERTIES  ENVIRONMENT "TZ=UTC" LABELS "unit" PROCESSORS "1" RUN_SERIAL "TRUE" TIMEOUT "60" WORKING_DIRECTORY "/root/repo/_bench_build/bin/tests/Release" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;176;add_test;/root/repo/tests/CMakeLists.txt;199;add_memalloc_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_psi "/root/repo/_bench_build/bin/tests/Release/test_psi")
+set_tests_properties(test_psi PROPERTIES  ENVIRONMENT "TZ=UTC" LABELS "unit" PROCESSORS "1" RUN_SERIAL "TRUE" TIMEOUT "60" WORKING_DIRECTORY "/root/repo/_bench_build/bin/tests/Release" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;176;add_test;/root/repo/tests/CMakeLists.txt;199;add_memalloc_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_realloc "/root/repo/_bench_build/bin/tests/Release/test_realloc")
+set_tests_properties(test_realloc PROPERTIES  ENVIRONMENT "TZ=UTC" LABELS "unit" PROCESSORS "1" RUN_SERIAL "TRUE" TIMEOUT "60" WORKING_DIRECTORY "/root/repo/_bench_build/bin/tests/Release" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;176;add_test;/root/repo/tests/CMakeLists.txt;199;add_memalloc_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_tags "/root/repo/_bench_build/bin/tests/Release/test_tags")
+set_tests_properties(test_tags PROPERTIES  ENVIRONMENT "TZ=UTC" LABELS "unit" PROCESSORS "1" RUN_SERIAL "TRUE" TIMEOUT "60" WORKING_DIRECTORY "/root/repo/_bench_build/bin/tests/Release" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;176;add_test;/root/repo/tests/CMakeLists.txt;199;add_memalloc_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(__cleanup_covlib "/usr/bin/cmake" "-E" "rm" "-rf" "/root/repo/bin/test")
+set_tests_properties(__cleanup_covlib PROPERTIES  DEPENDS "__coverage_generate" LABELS "coverage" RUN_SERIAL "TRUE" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;269;add_test;/root/repo/tests/CMakeLists.txt;0;")
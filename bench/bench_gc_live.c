@@ -0,0 +1,488 @@
+/*
+ * SPDX-FileCopyrightText: 2024-2025 Rafael V. Volkmer
+ * SPDX-FileCopyrightText: <rafael.v.volkmer@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+/** ============================================================================
+ *  @ingroup    Libmemalloc
+ *
+ *  @brief      Large live heap benchmark with small mutations.
+ *
+ *  @file       bench_gc_live.c
+ *  @headerfile libmemalloc.h
+ *
+ *  @details    Fills a table, reachable from a global, with nodes making up
+ *              a large live heap, then enables the collector thread and
+ *              mutates it in small steps: each step replaces a random slot
+ *              with a fresh node, dropping the old one, and points a field
+ *              of another random node at it. Every collection traces the
+ *              whole table while only a little of it becomes garbage, which
+ *              is where pause times grow with the live heap. At the end,
+ *              each node is checked to still hold its slot number. Reports
+ *              the total time, the longest stop of the world, the share of
+ *              the process CPU time spent marking and sweeping, and the
+ *              peak RSS, read from MEM_getGcStats() and getrusage().
+ *
+ *              Usage: bench_gc_live [heap_mb] [rounds]
+ *
+ *  @version    v1.0.00
+ *  @date       18.10.2026
+ *  @author     Rafael V. Volkmer <rafael.v.volkmer@gmail.com>
+ * ========================================================================== */
+
+/** ============================================================================
+ *                      P R I V A T E  I N C L U D E S
+ * ========================================================================== */
+
+/*< Implemented >*/
+#include "libmemalloc.h"
+#include "logs.h"
+
+/*< Dependencies >*/
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <time.h>
+
+/** ============================================================================
+ *               P R I V A T E  D E F I N E S  &  M A C R O S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @def        EXIT_ERROR
+ *  @brief      Standard error return code for benchmark failures.
+ * ========================================================================== */
+#define EXIT_ERROR      (uint8_t)(1U)
+
+/** ============================================================================
+ *  @def        DEFAULT_HEAP_MB
+ *  @brief      Default size of the live table, in MiB.
+ * ========================================================================== */
+#define DEFAULT_HEAP_MB (size_t)(32U)
+
+/** ============================================================================
+ *  @def        DEFAULT_ROUNDS
+ *  @brief      Default number of mutations per live node.
+ * ========================================================================== */
+#define DEFAULT_ROUNDS  (uint32_t)(2U)
+
+/** ============================================================================
+ *  @def        RANDOM_SEED
+ *  @brief      Seed of the xorshift generator picking the mutated slots.
+ * ========================================================================== */
+#define RANDOM_SEED     (uint64_t)(0x9E3779B97F4A7C15ULL)
+
+/** ============================================================================
+ *  @def        NSEC_PER_MSEC
+ *  @brief      Nanoseconds per millisecond.
+ * ========================================================================== */
+#define NSEC_PER_MSEC     (double)(1000000.0)
+
+/** ============================================================================
+ *  @def        KIB_PER_MIB
+ *  @brief      KiB per MiB, for ru_maxrss.
+ * ========================================================================== */
+#define KIB_PER_MIB       (double)(1024.0)
+
+/** ============================================================================
+ *  @def        CHECK(expr)
+ *  @brief      Assertion macro for validating benchmark steps.
+ *
+ *  @param [in] expr  Boolean expression to evaluate.
+ * ========================================================================== */
+#define CHECK(expr)                                                          \
+  do                                                                         \
+  {                                                                          \
+    if (!(expr))                                                             \
+    {                                                                        \
+      LOG_ERROR("Assertion failed at %s:%d: %s", __FILE__, __LINE__, #expr); \
+      return EXIT_ERROR;                                                     \
+    }                                                                        \
+  } while (0)
+
+/** ============================================================================
+ *                P R I V A T E  T Y P E S  D E F I N I T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @typedef    bench_node_t
+ *  @brief      Table node, padded to a typical small object size.
+ * ========================================================================== */
+typedef struct BenchNode
+{
+  struct BenchNode *link;       /**< Another node, or NULL */
+  uint64_t          slot;       /**< Table slot holding the node */
+  uint64_t          payload[6]; /**< Filler */
+} bench_node_t;
+
+/** ============================================================================
+ *  @typedef    bench_sample_t
+ *  @brief      Clocks and collector counters read at one point of a run.
+ * ========================================================================== */
+typedef struct BenchSample
+{
+  uint64_t wall_ns;      /**< CLOCK_MONOTONIC time */
+  uint64_t cpu_us;       /**< Process and reaped children CPU time */
+  uint64_t gc_ns;        /**< Collector mark and sweep time */
+  uint64_t max_pause_ns; /**< Longest stop of the world so far */
+  uint64_t cycles;       /**< Completed collections */
+} bench_sample_t;
+
+/** ============================================================================
+ *              P R I V A T E  G L O B A L  V A R I A B L E S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @var        g_table
+ *  @brief      Table of live nodes; the only reference to it.
+ * ========================================================================== */
+static bench_node_t **volatile g_table = (bench_node_t **)NULL;
+
+/** ============================================================================
+ *          P R I V A T E  F U N C T I O N S  P R O T O T Y P E S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         BENCH_now
+ *  @brief      Reads CLOCK_MONOTONIC in nanoseconds.
+ *
+ *  @return     Current time.
+ * ========================================================================== */
+static uint64_t BENCH_now(void);
+
+/** ============================================================================
+ *  @fn         BENCH_cpuUs
+ *  @brief      Reads the CPU time of the process and its reaped children.
+ *
+ *  @return     User plus system time, in microseconds.
+ * ========================================================================== */
+static uint64_t BENCH_cpuUs(void);
+
+/** ============================================================================
+ *  @fn         BENCH_sample
+ *  @brief      Reads the clocks and the collector counters.
+ *
+ *  @param [out] sample  Destination.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_sample(bench_sample_t *const sample);
+
+/** ============================================================================
+ *  @fn         BENCH_report
+ *  @brief      Prints the metrics of the run started at @p start.
+ *
+ *  @param [in] start  Sample taken when the run started.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_report(const bench_sample_t *const start);
+
+/** ============================================================================
+ *  @fn         BENCH_random
+ *  @brief      Advances an xorshift64 generator.
+ *
+ *  @param [in,out] state  Generator state, never zero.
+ *
+ *  @return     Next pseudo-random value.
+ * ========================================================================== */
+static uint64_t BENCH_random(uint64_t *const state);
+
+/** ============================================================================
+ *  @fn         BENCH_fill
+ *  @brief      Allocates g_table and @p count nodes into it.
+ *
+ *  @param [in] count  Number of live nodes.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_fill(const size_t count) __attribute__((noinline));
+
+/** ============================================================================
+ *  @fn         BENCH_mutate
+ *  @brief      Replaces @p mutations random nodes of g_table.
+ *
+ *  @param [in] count      Number of live nodes.
+ *  @param [in] mutations  Number of replacements.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_mutate(const size_t count, const size_t mutations)
+  __attribute__((noinline));
+
+/** ============================================================================
+ *  @fn         BENCH_verify
+ *  @brief      Checks that every node of g_table still holds its slot.
+ *
+ *  @param [in] count  Number of live nodes.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_verify(const size_t count);
+
+/** ============================================================================
+ *                          M A I N  F U N C T I O N
+ * ========================================================================== */
+
+int main(int argc, char **argv)
+{
+  int ret = EXIT_SUCCESS;
+
+  bench_sample_t start = { 0 };
+
+  size_t heap_mb = DEFAULT_HEAP_MB;
+  size_t count   = 0u;
+
+  uint32_t rounds = DEFAULT_ROUNDS;
+
+  if (argc > 1)
+    heap_mb = (size_t)strtoull(argv[1], (char **)NULL, 10);
+  if (argc > 2)
+    rounds = (uint32_t)strtoul(argv[2], (char **)NULL, 10);
+
+  CHECK(heap_mb > 0u && rounds > 0u);
+
+  count = heap_mb * 1024u * 1024u / sizeof(bench_node_t);
+
+  ret = BENCH_fill(count);
+  CHECK(ret == EXIT_SUCCESS);
+
+  printf("live nodes: %zu (%zu MiB payload), %zu mutations\n",
+         count,
+         heap_mb,
+         count * rounds);
+
+  ret = MEM_enableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = BENCH_sample(&start);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = BENCH_mutate(count, count * rounds);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = BENCH_report(&start);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_disableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = BENCH_verify(count);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *                  F U N C T I O N S  D E F I N I T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         BENCH_now
+ *  @brief      Reads CLOCK_MONOTONIC in nanoseconds.
+ *
+ *  @return     Current time.
+ * ========================================================================== */
+static uint64_t BENCH_now(void)
+{
+  struct timespec ts = { 0 };
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/** ============================================================================
+ *  @fn         BENCH_cpuUs
+ *  @brief      Reads the CPU time of the process and its reaped children.
+ *
+ *  @return     User plus system time, in microseconds.
+ * ========================================================================== */
+static uint64_t BENCH_cpuUs(void)
+{
+  struct rusage self     = { 0 };
+  struct rusage children = { 0 };
+
+  getrusage(RUSAGE_SELF, &self);
+  getrusage(RUSAGE_CHILDREN, &children);
+
+  return (uint64_t)(self.ru_utime.tv_sec + self.ru_stime.tv_sec
+                    + children.ru_utime.tv_sec + children.ru_stime.tv_sec)
+           * 1000000u
+       + (uint64_t)(self.ru_utime.tv_usec + self.ru_stime.tv_usec
+                    + children.ru_utime.tv_usec + children.ru_stime.tv_usec);
+}
+
+/** ============================================================================
+ *  @fn         BENCH_sample
+ *  @brief      Reads the clocks and the collector counters.
+ *
+ *  @param [out] sample  Destination.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_sample(bench_sample_t *const sample)
+{
+  static mem_gc_stats_t stats = { 0 };
+
+  int ret = EXIT_SUCCESS;
+
+  ret = MEM_getGcStats((mem_allocator_t *)NULL, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+
+  sample->wall_ns      = BENCH_now( );
+  sample->cpu_us       = BENCH_cpuUs( );
+  sample->gc_ns        = stats.gc_ns;
+  sample->max_pause_ns = stats.max_pause_ns;
+  sample->cycles       = stats.cycles;
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         BENCH_report
+ *  @brief      Prints the metrics of the run started at @p start.
+ *
+ *  @param [in] start  Sample taken when the run started.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_report(const bench_sample_t *const start)
+{
+  int ret = EXIT_SUCCESS;
+
+  bench_sample_t end = { 0 };
+
+  struct rusage usage = { 0 };
+
+  double share = 0.0;
+
+  ret = BENCH_sample(&end);
+  CHECK(ret == EXIT_SUCCESS);
+
+  getrusage(RUSAGE_SELF, &usage);
+
+  if (end.cpu_us > start->cpu_us)
+    share = 100.0 * (double)(end.gc_ns - start->gc_ns)
+          / ((double)(end.cpu_us - start->cpu_us) * 1000.0);
+
+  printf("%10s %14s %10s %14s %8s\n",
+         "total ms",
+         "max pause ms",
+         "gc cpu %",
+         "peak rss MiB",
+         "cycles");
+  printf("%10.1f %14.3f %10.1f %14.1f %8llu\n",
+         (double)(end.wall_ns - start->wall_ns) / NSEC_PER_MSEC,
+         (double)end.max_pause_ns / NSEC_PER_MSEC,
+         share,
+         (double)usage.ru_maxrss / KIB_PER_MIB,
+         (unsigned long long)(end.cycles - start->cycles));
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         BENCH_random
+ *  @brief      Advances an xorshift64 generator.
+ *
+ *  @param [in,out] state  Generator state, never zero.
+ *
+ *  @return     Next pseudo-random value.
+ * ========================================================================== */
+static uint64_t BENCH_random(uint64_t *const state)
+{
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+
+  return *state;
+}
+
+/** ============================================================================
+ *  @fn         BENCH_fill
+ *  @brief      Allocates g_table and @p count nodes into it.
+ *
+ *  @param [in] count  Number of live nodes.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_fill(const size_t count)
+{
+  bench_node_t *node = (bench_node_t *)NULL;
+
+  size_t iterator = 0u;
+
+  g_table = MEM_alloc(count * sizeof(bench_node_t *), FIRST_FIT);
+  CHECK(g_table != NULL);
+
+  for (iterator = 0u; iterator < count; ++iterator)
+  {
+    node = MEM_alloc(sizeof(bench_node_t), FIRST_FIT);
+    CHECK(node != NULL);
+
+    node->link        = (bench_node_t *)NULL;
+    node->slot        = iterator;
+    g_table[iterator] = node;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         BENCH_mutate
+ *  @brief      Replaces @p mutations random nodes of g_table.
+ *
+ *  @param [in] count      Number of live nodes.
+ *  @param [in] mutations  Number of replacements.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_mutate(const size_t count, const size_t mutations)
+{
+  bench_node_t *node = (bench_node_t *)NULL;
+
+  uint64_t state = RANDOM_SEED;
+
+  size_t iterator = 0u;
+  size_t slot     = 0u;
+
+  for (iterator = 0u; iterator < mutations; ++iterator)
+  {
+    slot = (size_t)(BENCH_random(&state) % count);
+
+    node = MEM_alloc(sizeof(bench_node_t), FIRST_FIT);
+    CHECK(node != NULL);
+
+    node->link    = (bench_node_t *)NULL;
+    node->slot    = slot;
+    g_table[slot] = node;
+
+    g_table[(size_t)(BENCH_random(&state) % count)]->link = node;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         BENCH_verify
+ *  @brief      Checks that every node of g_table still holds its slot.
+ *
+ *  @param [in] count  Number of live nodes.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_verify(const size_t count)
+{
+  size_t iterator = 0u;
+
+  for (iterator = 0u; iterator < count; ++iterator)
+    CHECK(g_table[iterator]->slot == iterator);
+
+  return EXIT_SUCCESS;
+}
+
+/*< end of file >*/
@@ -0,0 +1,430 @@
+/*
+ * SPDX-FileCopyrightText: 2024-2025 Rafael V. Volkmer
+ * SPDX-FileCopyrightText: <rafael.v.volkmer@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+/** ============================================================================
+ *  @ingroup    Libmemalloc
+ *
+ *  @brief      Garbage collector pause scaling benchmark.
+ *
+ *  @file       bench_gc_scaling.c
+ *  @headerfile libmemalloc.h
+ *
+ *  @details    Builds a binary tree of heap nodes reachable only from a
+ *              global root, with a share of unreachable nodes mixed in, and
+ *              measures the worst pause seen by a registered probe thread
+ *              while the collector runs with 1, 2, 4, ... workers. The probe
+ *              allocates and frees a small block, then sleeps, in a loop;
+ *              an iteration that overruns its sleep was held up by a stopped
+ *              world or by gc_lock during the sweep.
+ *
+ *              Usage: bench_gc_scaling [heap_mb] [max_workers] [runs]
+ *
+ *  @version    v1.0.00
+ *  @date       18.10.2026
+ *  @author     Rafael V. Volkmer <rafael.v.volkmer@gmail.com>
+ * ========================================================================== */
+
+/** ============================================================================
+ *                      P R I V A T E  I N C L U D E S
+ * ========================================================================== */
+
+/*< Implemented >*/
+#include "libmemalloc.h"
+#include "logs.h"
+
+/*< Dependencies >*/
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+/** ============================================================================
+ *               P R I V A T E  D E F I N E S  &  M A C R O S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @def        EXIT_ERROR
+ *  @brief      Standard error return code for benchmark failures.
+ * ========================================================================== */
+#define EXIT_ERROR       (uint8_t)(1U)
+
+/** ============================================================================
+ *  @def        DEFAULT_HEAP_MB
+ *  @brief      Default size of the live tree, in MiB.
+ * ========================================================================== */
+#define DEFAULT_HEAP_MB  (size_t)(64U)
+
+/** ============================================================================
+ *  @def        DEFAULT_RUNS
+ *  @brief      Default number of measurements per worker count.
+ * ========================================================================== */
+#define DEFAULT_RUNS     (uint32_t)(3U)
+
+/** ============================================================================
+ *  @def        GARBAGE_EVERY
+ *  @brief      One node in GARBAGE_EVERY is allocated and dropped.
+ * ========================================================================== */
+#define GARBAGE_EVERY    (size_t)(4U)
+
+/** ============================================================================
+ *  @def        PROBE_SLEEP_NS
+ *  @brief      Sleep of one probe iteration, in nanoseconds.
+ * ========================================================================== */
+#define PROBE_SLEEP_NS   (long)(100000L)
+
+/** ============================================================================
+ *  @def        RUN_TIME_US
+ *  @brief      Time the collector runs for each measurement.
+ * ========================================================================== */
+#define RUN_TIME_US      (useconds_t)(250000U)
+
+/** ============================================================================
+ *  @def        NSEC_PER_MSEC
+ *  @brief      Nanoseconds per millisecond.
+ * ========================================================================== */
+#define NSEC_PER_MSEC    (double)(1000000.0)
+
+/** ============================================================================
+ *  @def        CHECK(expr)
+ *  @brief      Assertion macro for validating benchmark steps.
+ *
+ *  @param [in] expr  Boolean expression to evaluate.
+ * ========================================================================== */
+#define CHECK(expr)                                                          \
+  do                                                                         \
+  {                                                                          \
+    if (!(expr))                                                             \
+    {                                                                        \
+      LOG_ERROR("Assertion failed at %s:%d: %s", __FILE__, __LINE__, #expr); \
+      return EXIT_ERROR;                                                     \
+    }                                                                        \
+  } while (0)
+
+/** ============================================================================
+ *                P R I V A T E  T Y P E S  D E F I N I T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @typedef    bench_node_t
+ *  @brief      Binary tree node, padded to a typical small object size.
+ * ========================================================================== */
+typedef struct BenchNode
+{
+  struct BenchNode *left;       /**< Left child, or NULL */
+  struct BenchNode *right;      /**< Right child, or NULL */
+  uint64_t          payload[6]; /**< Filler */
+} bench_node_t;
+
+/** ============================================================================
+ *              P R I V A T E  G L O B A L  V A R I A B L E S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @var        g_tree
+ *  @brief      Root of the live tree; the only reference to it.
+ * ========================================================================== */
+static bench_node_t *volatile g_tree = (bench_node_t *)NULL;
+
+/** ============================================================================
+ *  @var        g_stop
+ *  @brief      Tells the probe thread to finish.
+ * ========================================================================== */
+static _Atomic bool g_stop = false;
+
+/** ============================================================================
+ *  @var        g_worst_ns
+ *  @brief      Worst probe iteration overrun of the current run.
+ * ========================================================================== */
+static _Atomic uint64_t g_worst_ns = 0u;
+
+/** ============================================================================
+ *          P R I V A T E  F U N C T I O N S  P R O T O T Y P E S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         BENCH_now
+ *  @brief      Reads CLOCK_MONOTONIC in nanoseconds.
+ *
+ *  @return     Current time.
+ * ========================================================================== */
+static uint64_t BENCH_now(void);
+
+/** ============================================================================
+ *  @fn         BENCH_buildTree
+ *  @brief      Allocates a complete binary tree of @p count nodes into
+ *              g_tree, dropping one extra node in GARBAGE_EVERY.
+ *
+ *  @param [in] count  Number of live nodes.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_buildTree(const size_t count) __attribute__((noinline));
+
+/** ============================================================================
+ *  @fn         BENCH_probe
+ *  @brief      Registered thread recording the worst allocation pause.
+ *
+ *  @param [in] arg  Unused.
+ *
+ *  @return     NULL.
+ * ========================================================================== */
+static void *BENCH_probe(void *arg);
+
+/** ============================================================================
+ *  @fn         BENCH_measure
+ *  @brief      Runs the collector with @p workers workers and returns the
+ *              worst pause seen by the probe.
+ *
+ *  @param [in]  workers   Worker count.
+ *  @param [out] worst_ns  Worst pause, in nanoseconds.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_measure(const uint32_t workers, uint64_t *const worst_ns);
+
+/** ============================================================================
+ *                          M A I N  F U N C T I O N
+ * ========================================================================== */
+
+int main(int argc, char **argv)
+{
+  int ret = EXIT_SUCCESS;
+
+  size_t heap_mb = DEFAULT_HEAP_MB;
+  size_t count   = 0u;
+
+  uint32_t max_workers = 0u;
+  uint32_t runs        = DEFAULT_RUNS;
+  uint32_t workers     = 0u;
+  uint32_t run         = 0u;
+
+  uint64_t worst    = 0u;
+  uint64_t best     = 0u;
+  uint64_t baseline = 0u;
+
+  long cpus = 0;
+
+  cpus        = sysconf(_SC_NPROCESSORS_ONLN);
+  max_workers = (cpus > 0) ? (uint32_t)cpus : 1u;
+
+  if (argc > 1)
+    heap_mb = (size_t)strtoull(argv[1], (char **)NULL, 10);
+  if (argc > 2)
+    max_workers = (uint32_t)strtoul(argv[2], (char **)NULL, 10);
+  if (argc > 3)
+    runs = (uint32_t)strtoul(argv[3], (char **)NULL, 10);
+
+  if (max_workers > MEM_GC_MAX_WORKERS)
+    max_workers = MEM_GC_MAX_WORKERS;
+
+  CHECK(heap_mb > 0u && max_workers > 0u && runs > 0u);
+
+  count = heap_mb * 1024u * 1024u / sizeof(bench_node_t);
+
+  ret = BENCH_buildTree(count);
+  CHECK(ret == EXIT_SUCCESS);
+
+  printf("live nodes: %zu (%zu MiB payload), %u runs per point\n",
+         count,
+         heap_mb,
+         runs);
+  printf("%8s %14s %10s\n", "workers", "max pause ms", "speedup");
+
+  for (workers = 1u; workers <= max_workers;
+       workers = (workers * 2u > max_workers && workers < max_workers)
+                   ? max_workers
+                   : workers * 2u)
+  {
+    best = UINT64_MAX;
+
+    for (run = 0u; run < runs; ++run)
+    {
+      ret = BENCH_measure(workers, &worst);
+      CHECK(ret == EXIT_SUCCESS);
+
+      if (worst < best)
+        best = worst;
+    }
+
+    if (workers == 1u)
+      baseline = best;
+
+    printf("%8u %14.3f %9.2fx\n",
+           workers,
+           (double)best / NSEC_PER_MSEC,
+           (double)baseline / (double)best);
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *                  F U N C T I O N S  D E F I N I T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         BENCH_now
+ *  @brief      Reads CLOCK_MONOTONIC in nanoseconds.
+ *
+ *  @return     Current time.
+ * ========================================================================== */
+static uint64_t BENCH_now(void)
+{
+  struct timespec ts = { 0 };
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/** ============================================================================
+ *  @fn         BENCH_buildTree
+ *  @brief      Allocates a complete binary tree of @p count nodes into
+ *              g_tree, dropping one extra node in GARBAGE_EVERY.
+ *
+ *  @param [in] count  Number of live nodes.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_buildTree(const size_t count)
+{
+  int ret = EXIT_SUCCESS;
+
+  bench_node_t **nodes   = (bench_node_t **)NULL;
+  void          *garbage = (void *)NULL;
+
+  size_t iterator = 0u;
+
+  nodes = MEM_alloc(count * sizeof(bench_node_t *), FIRST_FIT);
+  CHECK(nodes != NULL);
+
+  for (iterator = 0u; iterator < count; ++iterator)
+  {
+    nodes[iterator] = MEM_alloc(sizeof(bench_node_t), FIRST_FIT);
+    CHECK(nodes[iterator] != NULL);
+
+    nodes[iterator]->left  = (bench_node_t *)NULL;
+    nodes[iterator]->right = (bench_node_t *)NULL;
+
+    if (iterator % GARBAGE_EVERY == 0u)
+    {
+      garbage = MEM_alloc(sizeof(bench_node_t), FIRST_FIT);
+      CHECK(garbage != NULL);
+    }
+  }
+
+  for (iterator = 0u; 2u * iterator + 1u < count; ++iterator)
+  {
+    nodes[iterator]->left = nodes[2u * iterator + 1u];
+    if (2u * iterator + 2u < count)
+      nodes[iterator]->right = nodes[2u * iterator + 2u];
+  }
+
+  g_tree = nodes[0];
+
+  ret = MEM_free(nodes);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         BENCH_probe
+ *  @brief      Registered thread recording the worst allocation pause.
+ *
+ *  @param [in] arg  Unused.
+ *
+ *  @return     NULL.
+ * ========================================================================== */
+static void *BENCH_probe(void *arg)
+{
+  struct timespec nap = { .tv_sec = 0, .tv_nsec = PROBE_SLEEP_NS };
+
+  void *block = (void *)NULL;
+
+  uint64_t start   = 0u;
+  uint64_t elapsed = 0u;
+
+  (void)arg;
+
+  (void)MEM_gcRegisterThread((mem_allocator_t *)NULL);
+
+  while (!atomic_load(&g_stop))
+  {
+    start = BENCH_now( );
+
+    block = MEM_alloc(32u, FIRST_FIT);
+    if (block != NULL)
+      (void)MEM_free(block);
+
+    nanosleep(&nap, (struct timespec *)NULL);
+
+    elapsed = BENCH_now( ) - start;
+    if (elapsed > (uint64_t)PROBE_SLEEP_NS
+        && elapsed - (uint64_t)PROBE_SLEEP_NS > atomic_load(&g_worst_ns))
+      atomic_store(&g_worst_ns, elapsed - (uint64_t)PROBE_SLEEP_NS);
+  }
+
+  (void)MEM_gcUnregisterThread((mem_allocator_t *)NULL);
+
+  return NULL;
+}
+
+/** ============================================================================
+ *  @fn         BENCH_measure
+ *  @brief      Runs the collector with @p workers workers and returns the
+ *              worst pause seen by the probe.
+ *
+ *  @param [in]  workers   Worker count.
+ *  @param [out] worst_ns  Worst pause, in nanoseconds.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_measure(const uint32_t workers, uint64_t *const worst_ns)
+{
+  int ret = EXIT_SUCCESS;
+
+  pthread_t probe;
+
+  ret = MEM_gcSetWorkers((mem_allocator_t *)NULL, workers);
+  CHECK(ret == EXIT_SUCCESS);
+
+  atomic_store(&g_stop, false);
+  atomic_store(&g_worst_ns, 0u);
+
+  ret = pthread_create(&probe,
+                       (const pthread_attr_t *)NULL,
+                       BENCH_probe,
+                       (void *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  usleep(RUN_TIME_US / 10u);
+
+  ret = MEM_enableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  usleep(RUN_TIME_US);
+
+  ret = MEM_disableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  atomic_store(&g_stop, true);
+
+  ret = pthread_join(probe, (void **)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  CHECK(g_tree != NULL && g_tree->left != NULL);
+
+  *worst_ns = atomic_load(&g_worst_ns);
+
+  return EXIT_SUCCESS;
+}
+
+/*< end of file >*/
@@ -0,0 +1,558 @@
+/*
+ * SPDX-FileCopyrightText: 2024-2025 Rafael V. Volkmer
+ * SPDX-FileCopyrightText: <rafael.v.volkmer@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+/** ============================================================================
+ *  @ingroup    Libmemalloc
+ *
+ *  @brief      Fork-snapshot versus in-process marking benchmark.
+ *
+ *  @file       bench_gc_snapshot.c
+ *  @headerfile libmemalloc.h
+ *
+ *  @details    Builds the same binary tree as bench_gc_scaling, then times
+ *              collections with in-process marking and with
+ *              MEM_gcSetSnapshot() enabled. Each run drops a fresh batch of
+ *              tagged garbage nodes, starts the collector thread and waits
+ *              until the tag counters show the batch freed. It reports the
+ *              worst pause seen by a registered probe thread, which
+ *              allocates and frees a small block then sleeps in a loop, the
+ *              wall time of the collection, and the CPU time the process
+ *              and its reaped children used meanwhile.
+ *
+ *              Usage: bench_gc_snapshot [heap_mb] [runs]
+ *
+ *  @version    v1.0.00
+ *  @date       18.10.2026
+ *  @author     Rafael V. Volkmer <rafael.v.volkmer@gmail.com>
+ * ========================================================================== */
+
+/** ============================================================================
+ *                      P R I V A T E  I N C L U D E S
+ * ========================================================================== */
+
+/*< Implemented >*/
+#include "libmemalloc.h"
+#include "logs.h"
+
+/*< Dependencies >*/
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
+
+/** ============================================================================
+ *               P R I V A T E  D E F I N E S  &  M A C R O S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @def        EXIT_ERROR
+ *  @brief      Standard error return code for benchmark failures.
+ * ========================================================================== */
+#define EXIT_ERROR       (uint8_t)(1U)
+
+/** ============================================================================
+ *  @def        DEFAULT_HEAP_MB
+ *  @brief      Default size of the live tree, in MiB.
+ * ========================================================================== */
+#define DEFAULT_HEAP_MB  (size_t)(64U)
+
+/** ============================================================================
+ *  @def        DEFAULT_RUNS
+ *  @brief      Default number of measurements per mode.
+ * ========================================================================== */
+#define DEFAULT_RUNS     (uint32_t)(3U)
+
+/** ============================================================================
+ *  @def        GARBAGE_EVERY
+ *  @brief      Each run drops one garbage node per GARBAGE_EVERY live ones.
+ * ========================================================================== */
+#define GARBAGE_EVERY    (size_t)(4U)
+
+/** ============================================================================
+ *  @def        GARBAGE_SLACK
+ *  @brief      A collection is done once all but 1/GARBAGE_SLACK of the
+ *              garbage was freed; a conservative scan may keep a few.
+ * ========================================================================== */
+#define GARBAGE_SLACK    (size_t)(16U)
+
+/** ============================================================================
+ *  @def        PROBE_SLEEP_NS
+ *  @brief      Sleep of one probe iteration, in nanoseconds.
+ * ========================================================================== */
+#define PROBE_SLEEP_NS   (long)(100000L)
+
+/** ============================================================================
+ *  @def        POLL_US
+ *  @brief      Delay between two polls of the garbage tag counters.
+ * ========================================================================== */
+#define POLL_US          (useconds_t)(1000U)
+
+/** ============================================================================
+ *  @def        MAX_POLLS
+ *  @brief      Polls of the garbage tag counters before a run fails.
+ * ========================================================================== */
+#define MAX_POLLS        (uint32_t)(30000U)
+
+/** ============================================================================
+ *  @def        NSEC_PER_MSEC
+ *  @brief      Nanoseconds per millisecond.
+ * ========================================================================== */
+#define NSEC_PER_MSEC    (double)(1000000.0)
+
+/** ============================================================================
+ *  @def        USEC_PER_MSEC
+ *  @brief      Microseconds per millisecond.
+ * ========================================================================== */
+#define USEC_PER_MSEC    (double)(1000.0)
+
+/** ============================================================================
+ *  @def        CHECK(expr)
+ *  @brief      Assertion macro for validating benchmark steps.
+ *
+ *  @param [in] expr  Boolean expression to evaluate.
+ * ========================================================================== */
+#define CHECK(expr)                                                          \
+  do                                                                         \
+  {                                                                          \
+    if (!(expr))                                                             \
+    {                                                                        \
+      LOG_ERROR("Assertion failed at %s:%d: %s", __FILE__, __LINE__, #expr); \
+      return EXIT_ERROR;                                                     \
+    }                                                                        \
+  } while (0)
+
+/** ============================================================================
+ *                P R I V A T E  T Y P E S  D E F I N I T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @typedef    bench_node_t
+ *  @brief      Binary tree node, padded to a typical small object size.
+ * ========================================================================== */
+typedef struct BenchNode
+{
+  struct BenchNode *left;       /**< Left child, or NULL */
+  struct BenchNode *right;      /**< Right child, or NULL */
+  uint64_t          payload[6]; /**< Filler */
+} bench_node_t;
+
+/** ============================================================================
+ *  @typedef    bench_result_t
+ *  @brief      Measurements of one collection.
+ * ========================================================================== */
+typedef struct BenchResult
+{
+  uint64_t worst_ns; /**< Worst probe pause */
+  uint64_t cycle_ns; /**< Wall time until the garbage was freed */
+  uint64_t cpu_us;   /**< CPU time of the process and its children */
+} bench_result_t;
+
+/** ============================================================================
+ *              P R I V A T E  G L O B A L  V A R I A B L E S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @var        g_tree
+ *  @brief      Root of the live tree; the only reference to it.
+ * ========================================================================== */
+static bench_node_t *volatile g_tree = (bench_node_t *)NULL;
+
+/** ============================================================================
+ *  @var        g_stop
+ *  @brief      Tells the probe thread to finish.
+ * ========================================================================== */
+static _Atomic bool g_stop = false;
+
+/** ============================================================================
+ *  @var        g_worst_ns
+ *  @brief      Worst probe iteration overrun of the current run.
+ * ========================================================================== */
+static _Atomic uint64_t g_worst_ns = 0u;
+
+/** ============================================================================
+ *  @var        g_tag
+ *  @brief      Tag of the garbage nodes.
+ * ========================================================================== */
+static uint32_t g_tag = 0u;
+
+/** ============================================================================
+ *          P R I V A T E  F U N C T I O N S  P R O T O T Y P E S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         BENCH_now
+ *  @brief      Reads CLOCK_MONOTONIC in nanoseconds.
+ *
+ *  @return     Current time.
+ * ========================================================================== */
+static uint64_t BENCH_now(void);
+
+/** ============================================================================
+ *  @fn         BENCH_cpuUs
+ *  @brief      Reads the CPU time of the process and its reaped children.
+ *
+ *  @return     User plus system time, in microseconds.
+ * ========================================================================== */
+static uint64_t BENCH_cpuUs(void);
+
+/** ============================================================================
+ *  @fn         BENCH_buildTree
+ *  @brief      Allocates a complete binary tree of @p count nodes into
+ *              g_tree.
+ *
+ *  @param [in] count  Number of live nodes.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_buildTree(const size_t count) __attribute__((noinline));
+
+/** ============================================================================
+ *  @fn         BENCH_makeGarbage
+ *  @brief      Allocates @p count nodes tagged g_tag and drops them.
+ *
+ *  @param [in] count  Number of garbage nodes.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_makeGarbage(const size_t count) __attribute__((noinline));
+
+/** ============================================================================
+ *  @fn         BENCH_probe
+ *  @brief      Registered thread recording the worst allocation pause.
+ *
+ *  @param [in] arg  Unused.
+ *
+ *  @return     NULL.
+ * ========================================================================== */
+static void *BENCH_probe(void *arg);
+
+/** ============================================================================
+ *  @fn         BENCH_measure
+ *  @brief      Times one collection of @p garbage dropped nodes.
+ *
+ *  @param [in]  snapshot  true to mark in a fork()ed child.
+ *  @param [in]  garbage   Number of garbage nodes to drop.
+ *  @param [out] result    Measurements of the collection.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_measure(const bool            snapshot,
+                         const size_t          garbage,
+                         bench_result_t *const result);
+
+/** ============================================================================
+ *                          M A I N  F U N C T I O N
+ * ========================================================================== */
+
+int main(int argc, char **argv)
+{
+  int ret = EXIT_SUCCESS;
+
+  bench_result_t result = { 0 };
+  bench_result_t best   = { 0 };
+
+  size_t heap_mb = DEFAULT_HEAP_MB;
+  size_t count   = 0u;
+
+  uint32_t runs = DEFAULT_RUNS;
+  uint32_t mode = 0u;
+  uint32_t run  = 0u;
+
+  if (argc > 1)
+    heap_mb = (size_t)strtoull(argv[1], (char **)NULL, 10);
+  if (argc > 2)
+    runs = (uint32_t)strtoul(argv[2], (char **)NULL, 10);
+
+  CHECK(heap_mb > 0u && runs > 0u);
+
+  count = heap_mb * 1024u * 1024u / sizeof(bench_node_t);
+
+  ret = MEM_registerTag("garbage");
+  CHECK(ret > (int)MEM_TAG_DEFAULT);
+  g_tag = (uint32_t)ret;
+
+  ret = BENCH_buildTree(count);
+  CHECK(ret == EXIT_SUCCESS);
+
+  printf("live nodes: %zu (%zu MiB payload), %zu garbage nodes, "
+         "%u runs per mode\n",
+         count,
+         heap_mb,
+         count / GARBAGE_EVERY,
+         runs);
+  printf("%-14s %14s %10s %10s\n",
+         "marking",
+         "max pause ms",
+         "cycle ms",
+         "cpu ms");
+
+  for (mode = 0u; mode < 2u; ++mode)
+  {
+    best.worst_ns = UINT64_MAX;
+    best.cycle_ns = UINT64_MAX;
+    best.cpu_us   = UINT64_MAX;
+
+    for (run = 0u; run < runs; ++run)
+    {
+      ret = BENCH_measure(mode == 1u, count / GARBAGE_EVERY, &result);
+      CHECK(ret == EXIT_SUCCESS);
+
+      if (result.worst_ns < best.worst_ns)
+        best.worst_ns = result.worst_ns;
+      if (result.cycle_ns < best.cycle_ns)
+        best.cycle_ns = result.cycle_ns;
+      if (result.cpu_us < best.cpu_us)
+        best.cpu_us = result.cpu_us;
+    }
+
+    printf("%-14s %14.3f %10.1f %10.1f\n",
+           (mode == 1u) ? "fork snapshot" : "in process",
+           (double)best.worst_ns / NSEC_PER_MSEC,
+           (double)best.cycle_ns / NSEC_PER_MSEC,
+           (double)best.cpu_us / USEC_PER_MSEC);
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *                  F U N C T I O N S  D E F I N I T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         BENCH_now
+ *  @brief      Reads CLOCK_MONOTONIC in nanoseconds.
+ *
+ *  @return     Current time.
+ * ========================================================================== */
+static uint64_t BENCH_now(void)
+{
+  struct timespec ts = { 0 };
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/** ============================================================================
+ *  @fn         BENCH_cpuUs
+ *  @brief      Reads the CPU time of the process and its reaped children.
+ *
+ *  @return     User plus system time, in microseconds.
+ * ========================================================================== */
+static uint64_t BENCH_cpuUs(void)
+{
+  struct rusage self     = { 0 };
+  struct rusage children = { 0 };
+
+  getrusage(RUSAGE_SELF, &self);
+  getrusage(RUSAGE_CHILDREN, &children);
+
+  return (uint64_t)(self.ru_utime.tv_sec + self.ru_stime.tv_sec
+                    + children.ru_utime.tv_sec + children.ru_stime.tv_sec)
+           * 1000000u
+       + (uint64_t)(self.ru_utime.tv_usec + self.ru_stime.tv_usec
+                    + children.ru_utime.tv_usec + children.ru_stime.tv_usec);
+}
+
+/** ============================================================================
+ *  @fn         BENCH_buildTree
+ *  @brief      Allocates a complete binary tree of @p count nodes into
+ *              g_tree.
+ *
+ *  @param [in] count  Number of live nodes.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_buildTree(const size_t count)
+{
+  int ret = EXIT_SUCCESS;
+
+  bench_node_t **nodes = (bench_node_t **)NULL;
+
+  size_t iterator = 0u;
+
+  nodes = MEM_alloc(count * sizeof(bench_node_t *), FIRST_FIT);
+  CHECK(nodes != NULL);
+
+  for (iterator = 0u; iterator < count; ++iterator)
+  {
+    nodes[iterator] = MEM_alloc(sizeof(bench_node_t), FIRST_FIT);
+    CHECK(nodes[iterator] != NULL);
+
+    nodes[iterator]->left  = (bench_node_t *)NULL;
+    nodes[iterator]->right = (bench_node_t *)NULL;
+  }
+
+  for (iterator = 0u; 2u * iterator + 1u < count; ++iterator)
+  {
+    nodes[iterator]->left = nodes[2u * iterator + 1u];
+    if (2u * iterator + 2u < count)
+      nodes[iterator]->right = nodes[2u * iterator + 2u];
+  }
+
+  g_tree = nodes[0];
+
+  ret = MEM_free(nodes);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         BENCH_makeGarbage
+ *  @brief      Allocates @p count nodes tagged g_tag and drops them.
+ *
+ *  @param [in] count  Number of garbage nodes.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_makeGarbage(const size_t count)
+{
+  void *garbage = (void *)NULL;
+
+  size_t iterator = 0u;
+
+  for (iterator = 0u; iterator < count; ++iterator)
+  {
+    garbage = MEM_allocTagged(sizeof(bench_node_t), g_tag);
+    CHECK(garbage != NULL);
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         BENCH_probe
+ *  @brief      Registered thread recording the worst allocation pause.
+ *
+ *  @param [in] arg  Unused.
+ *
+ *  @return     NULL.
+ * ========================================================================== */
+static void *BENCH_probe(void *arg)
+{
+  struct timespec nap = { .tv_sec = 0, .tv_nsec = PROBE_SLEEP_NS };
+
+  void *block = (void *)NULL;
+
+  uint64_t start   = 0u;
+  uint64_t elapsed = 0u;
+
+  (void)arg;
+
+  (void)MEM_gcRegisterThread((mem_allocator_t *)NULL);
+
+  while (!atomic_load(&g_stop))
+  {
+    start = BENCH_now( );
+
+    block = MEM_alloc(32u, FIRST_FIT);
+    if (block != NULL)
+      (void)MEM_free(block);
+
+    nanosleep(&nap, (struct timespec *)NULL);
+
+    elapsed = BENCH_now( ) - start;
+    if (elapsed > (uint64_t)PROBE_SLEEP_NS
+        && elapsed - (uint64_t)PROBE_SLEEP_NS > atomic_load(&g_worst_ns))
+      atomic_store(&g_worst_ns, elapsed - (uint64_t)PROBE_SLEEP_NS);
+  }
+
+  (void)MEM_gcUnregisterThread((mem_allocator_t *)NULL);
+
+  return NULL;
+}
+
+/** ============================================================================
+ *  @fn         BENCH_measure
+ *  @brief      Times one collection of @p garbage dropped nodes.
+ *
+ *  @param [in]  snapshot  true to mark in a fork()ed child.
+ *  @param [in]  garbage   Number of garbage nodes to drop.
+ *  @param [out] result    Measurements of the collection.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_measure(const bool            snapshot,
+                         const size_t          garbage,
+                         bench_result_t *const result)
+{
+  int ret = EXIT_SUCCESS;
+
+  mem_tag_stats_t stats = { 0 };
+
+  uint64_t start     = 0u;
+  uint64_t cpu_start = 0u;
+
+  size_t target = 0u;
+
+  uint32_t polls = 0u;
+
+  pthread_t probe;
+
+  ret = MEM_gcSetSnapshot((mem_allocator_t *)NULL, snapshot);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_getTagStats(g_tag, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+  target = stats.free_count + garbage - garbage / GARBAGE_SLACK;
+
+  ret = BENCH_makeGarbage(garbage);
+  CHECK(ret == EXIT_SUCCESS);
+
+  atomic_store(&g_stop, false);
+
+  ret = pthread_create(&probe,
+                       (const pthread_attr_t *)NULL,
+                       BENCH_probe,
+                       (void *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  usleep(POLL_US * 10u);
+
+  atomic_store(&g_worst_ns, 0u);
+  start     = BENCH_now( );
+  cpu_start = BENCH_cpuUs( );
+
+  ret = MEM_enableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  for (polls = 0u; polls < MAX_POLLS; ++polls)
+  {
+    ret = MEM_getTagStats(g_tag, &stats);
+    CHECK(ret == EXIT_SUCCESS);
+    if (stats.free_count >= target)
+      break;
+
+    usleep(POLL_US);
+  }
+
+  result->cycle_ns = BENCH_now( ) - start;
+  result->cpu_us   = BENCH_cpuUs( ) - cpu_start;
+
+  atomic_store(&g_stop, true);
+
+  ret = pthread_join(probe, (void **)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  result->worst_ns = atomic_load(&g_worst_ns);
+
+  ret = MEM_disableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  CHECK(polls < MAX_POLLS);
+  CHECK(g_tree != NULL && g_tree->left != NULL);
+
+  return EXIT_SUCCESS;
+}
+
+/*< end of file >*/
@@ -0,0 +1,483 @@
+/*
+ * SPDX-FileCopyrightText: 2024-2025 Rafael V. Volkmer
+ * SPDX-FileCopyrightText: <rafael.v.volkmer@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+/** ============================================================================
+ *  @ingroup    Libmemalloc
+ *
+ *  @brief      Many-threads allocation benchmark.
+ *
+ *  @file       bench_gc_threads.c
+ *  @headerfile libmemalloc.h
+ *
+ *  @details    Starts registered threads that allocate small nodes of
+ *              varying sizes as fast as they can while the collector thread
+ *              runs. Each thread keeps its last RING_SLOTS nodes in an array
+ *              on its own stack, so a node dropped from the ring is garbage
+ *              and the live ones are only reachable from a thread stack.
+ *              Every stop of the world parks all of them. At the end, each
+ *              thread checks that its ring still holds its own nodes.
+ *              Reports the total time, the longest stop of the world, the
+ *              share of the process CPU time spent marking and sweeping, and
+ *              the peak RSS, read from MEM_getGcStats() and getrusage().
+ *
+ *              Usage: bench_gc_threads [threads] [allocs_per_thread]
+ *
+ *  @version    v1.0.00
+ *  @date       18.10.2026
+ *  @author     Rafael V. Volkmer <rafael.v.volkmer@gmail.com>
+ * ========================================================================== */
+
+/** ============================================================================
+ *                      P R I V A T E  I N C L U D E S
+ * ========================================================================== */
+
+/*< Implemented >*/
+#include "libmemalloc.h"
+#include "logs.h"
+
+/*< Dependencies >*/
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
+
+/** ============================================================================
+ *               P R I V A T E  D E F I N E S  &  M A C R O S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @def        EXIT_ERROR
+ *  @brief      Standard error return code for benchmark failures.
+ * ========================================================================== */
+#define EXIT_ERROR      (uint8_t)(1U)
+
+/** ============================================================================
+ *  @def        DEFAULT_ALLOCS
+ *  @brief      Default number of allocations per thread.
+ * ========================================================================== */
+#define DEFAULT_ALLOCS  (size_t)(100000U)
+
+/** ============================================================================
+ *  @def        MAX_THREADS
+ *  @brief      Most allocating threads; the main and GC threads also take a
+ *              registry slot.
+ * ========================================================================== */
+#define MAX_THREADS     (uint32_t)(MEM_GC_MAX_THREADS - 2U)
+
+/** ============================================================================
+ *  @def        RING_SLOTS
+ *  @brief      Nodes each thread keeps alive.
+ * ========================================================================== */
+#define RING_SLOTS      (size_t)(256U)
+
+/** ============================================================================
+ *  @def        MAX_EXTRA
+ *  @brief      Largest payload added to a node, in 8-byte words.
+ * ========================================================================== */
+#define MAX_EXTRA       (uint64_t)(32U)
+
+/** ============================================================================
+ *  @def        NSEC_PER_MSEC
+ *  @brief      Nanoseconds per millisecond.
+ * ========================================================================== */
+#define NSEC_PER_MSEC     (double)(1000000.0)
+
+/** ============================================================================
+ *  @def        KIB_PER_MIB
+ *  @brief      KiB per MiB, for ru_maxrss.
+ * ========================================================================== */
+#define KIB_PER_MIB       (double)(1024.0)
+
+/** ============================================================================
+ *  @def        CHECK(expr)
+ *  @brief      Assertion macro for validating benchmark steps.
+ *
+ *  @param [in] expr  Boolean expression to evaluate.
+ * ========================================================================== */
+#define CHECK(expr)                                                          \
+  do                                                                         \
+  {                                                                          \
+    if (!(expr))                                                             \
+    {                                                                        \
+      LOG_ERROR("Assertion failed at %s:%d: %s", __FILE__, __LINE__, #expr); \
+      return EXIT_ERROR;                                                     \
+    }                                                                        \
+  } while (0)
+
+/** ============================================================================
+ *                P R I V A T E  T Y P E S  D E F I N I T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @typedef    bench_node_t
+ *  @brief      Ring node, followed by up to MAX_EXTRA words of payload.
+ * ========================================================================== */
+typedef struct BenchNode
+{
+  uint64_t owner; /**< Index of the allocating thread */
+  uint64_t slot;  /**< Ring slot holding the node */
+} bench_node_t;
+
+/** ============================================================================
+ *  @typedef    bench_worker_t
+ *  @brief      Arguments and result of one allocating thread.
+ * ========================================================================== */
+typedef struct BenchWorker
+{
+  pthread_t thread; /**< Thread handle */
+  uint32_t  index;  /**< Thread index, also its generator seed */
+  size_t    allocs; /**< Allocations to perform */
+  int       ret;    /**< EXIT_SUCCESS once the ring checked out */
+} bench_worker_t;
+
+/** ============================================================================
+ *  @typedef    bench_sample_t
+ *  @brief      Clocks and collector counters read at one point of a run.
+ * ========================================================================== */
+typedef struct BenchSample
+{
+  uint64_t wall_ns;      /**< CLOCK_MONOTONIC time */
+  uint64_t cpu_us;       /**< Process and reaped children CPU time */
+  uint64_t gc_ns;        /**< Collector mark and sweep time */
+  uint64_t max_pause_ns; /**< Longest stop of the world so far */
+  uint64_t cycles;       /**< Completed collections */
+} bench_sample_t;
+
+/** ============================================================================
+ *              P R I V A T E  G L O B A L  V A R I A B L E S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @var        g_go
+ *  @brief      Set once every thread is registered, to start them together.
+ * ========================================================================== */
+static _Atomic bool g_go = false;
+
+/** ============================================================================
+ *  @var        g_workers
+ *  @brief      Allocating threads.
+ * ========================================================================== */
+static bench_worker_t g_workers[MAX_THREADS];
+
+/** ============================================================================
+ *          P R I V A T E  F U N C T I O N S  P R O T O T Y P E S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         BENCH_now
+ *  @brief      Reads CLOCK_MONOTONIC in nanoseconds.
+ *
+ *  @return     Current time.
+ * ========================================================================== */
+static uint64_t BENCH_now(void);
+
+/** ============================================================================
+ *  @fn         BENCH_cpuUs
+ *  @brief      Reads the CPU time of the process and its reaped children.
+ *
+ *  @return     User plus system time, in microseconds.
+ * ========================================================================== */
+static uint64_t BENCH_cpuUs(void);
+
+/** ============================================================================
+ *  @fn         BENCH_sample
+ *  @brief      Reads the clocks and the collector counters.
+ *
+ *  @param [out] sample  Destination.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_sample(bench_sample_t *const sample);
+
+/** ============================================================================
+ *  @fn         BENCH_report
+ *  @brief      Prints the metrics of the run started at @p start.
+ *
+ *  @param [in] start  Sample taken when the run started.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_report(const bench_sample_t *const start);
+
+/** ============================================================================
+ *  @fn         BENCH_churn
+ *  @brief      Runs the allocations of one thread and checks its ring.
+ *
+ *  @param [in] worker  Thread description.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_churn(const bench_worker_t *const worker)
+  __attribute__((noinline));
+
+/** ============================================================================
+ *  @fn         BENCH_worker
+ *  @brief      Registered allocating thread.
+ *
+ *  @param [in] arg  Its bench_worker_t.
+ *
+ *  @return     NULL.
+ * ========================================================================== */
+static void *BENCH_worker(void *arg);
+
+/** ============================================================================
+ *                          M A I N  F U N C T I O N
+ * ========================================================================== */
+
+int main(int argc, char **argv)
+{
+  int ret = EXIT_SUCCESS;
+
+  bench_sample_t start = { 0 };
+
+  size_t allocs = DEFAULT_ALLOCS;
+
+  uint32_t threads  = 0u;
+  uint32_t iterator = 0u;
+
+  long cpus = 0;
+
+  cpus    = sysconf(_SC_NPROCESSORS_ONLN);
+  threads = (cpus > 0) ? 2u * (uint32_t)cpus : 2u;
+
+  if (argc > 1)
+    threads = (uint32_t)strtoul(argv[1], (char **)NULL, 10);
+  if (argc > 2)
+    allocs = (size_t)strtoull(argv[2], (char **)NULL, 10);
+
+  if (threads > MAX_THREADS)
+    threads = MAX_THREADS;
+
+  CHECK(threads > 0u && allocs > 0u);
+
+  printf("%u threads, %zu allocations each, %zu live nodes per thread\n",
+         threads,
+         allocs,
+         RING_SLOTS);
+
+  ret = MEM_enableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  for (iterator = 0u; iterator < threads; ++iterator)
+  {
+    g_workers[iterator].index  = iterator;
+    g_workers[iterator].allocs = allocs;
+    g_workers[iterator].ret    = EXIT_ERROR;
+
+    ret = pthread_create(&g_workers[iterator].thread,
+                         (const pthread_attr_t *)NULL,
+                         BENCH_worker,
+                         (void *)&g_workers[iterator]);
+    CHECK(ret == EXIT_SUCCESS);
+  }
+
+  ret = BENCH_sample(&start);
+  CHECK(ret == EXIT_SUCCESS);
+
+  atomic_store(&g_go, true);
+
+  for (iterator = 0u; iterator < threads; ++iterator)
+  {
+    ret = pthread_join(g_workers[iterator].thread, (void **)NULL);
+    CHECK(ret == EXIT_SUCCESS);
+  }
+
+  ret = BENCH_report(&start);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_disableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  for (iterator = 0u; iterator < threads; ++iterator)
+    CHECK(g_workers[iterator].ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *                  F U N C T I O N S  D E F I N I T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         BENCH_now
+ *  @brief      Reads CLOCK_MONOTONIC in nanoseconds.
+ *
+ *  @return     Current time.
+ * ========================================================================== */
+static uint64_t BENCH_now(void)
+{
+  struct timespec ts = { 0 };
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/** ============================================================================
+ *  @fn         BENCH_cpuUs
+ *  @brief      Reads the CPU time of the process and its reaped children.
+ *
+ *  @return     User plus system time, in microseconds.
+ * ========================================================================== */
+static uint64_t BENCH_cpuUs(void)
+{
+  struct rusage self     = { 0 };
+  struct rusage children = { 0 };
+
+  getrusage(RUSAGE_SELF, &self);
+  getrusage(RUSAGE_CHILDREN, &children);
+
+  return (uint64_t)(self.ru_utime.tv_sec + self.ru_stime.tv_sec
+                    + children.ru_utime.tv_sec + children.ru_stime.tv_sec)
+           * 1000000u
+       + (uint64_t)(self.ru_utime.tv_usec + self.ru_stime.tv_usec
+                    + children.ru_utime.tv_usec + children.ru_stime.tv_usec);
+}
+
+/** ============================================================================
+ *  @fn         BENCH_sample
+ *  @brief      Reads the clocks and the collector counters.
+ *
+ *  @param [out] sample  Destination.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_sample(bench_sample_t *const sample)
+{
+  static mem_gc_stats_t stats = { 0 };
+
+  int ret = EXIT_SUCCESS;
+
+  ret = MEM_getGcStats((mem_allocator_t *)NULL, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+
+  sample->wall_ns      = BENCH_now( );
+  sample->cpu_us       = BENCH_cpuUs( );
+  sample->gc_ns        = stats.gc_ns;
+  sample->max_pause_ns = stats.max_pause_ns;
+  sample->cycles       = stats.cycles;
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         BENCH_report
+ *  @brief      Prints the metrics of the run started at @p start.
+ *
+ *  @param [in] start  Sample taken when the run started.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_report(const bench_sample_t *const start)
+{
+  int ret = EXIT_SUCCESS;
+
+  bench_sample_t end = { 0 };
+
+  struct rusage usage = { 0 };
+
+  double share = 0.0;
+
+  ret = BENCH_sample(&end);
+  CHECK(ret == EXIT_SUCCESS);
+
+  getrusage(RUSAGE_SELF, &usage);
+
+  if (end.cpu_us > start->cpu_us)
+    share = 100.0 * (double)(end.gc_ns - start->gc_ns)
+          / ((double)(end.cpu_us - start->cpu_us) * 1000.0);
+
+  printf("%10s %14s %10s %14s %8s\n",
+         "total ms",
+         "max pause ms",
+         "gc cpu %",
+         "peak rss MiB",
+         "cycles");
+  printf("%10.1f %14.3f %10.1f %14.1f %8llu\n",
+         (double)(end.wall_ns - start->wall_ns) / NSEC_PER_MSEC,
+         (double)end.max_pause_ns / NSEC_PER_MSEC,
+         share,
+         (double)usage.ru_maxrss / KIB_PER_MIB,
+         (unsigned long long)(end.cycles - start->cycles));
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         BENCH_churn
+ *  @brief      Runs the allocations of one thread and checks its ring.
+ *
+ *  @param [in] worker  Thread description.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_churn(const bench_worker_t *const worker)
+{
+  bench_node_t *ring[RING_SLOTS] = { 0 };
+
+  uint64_t state = 0u;
+
+  size_t iterator = 0u;
+  size_t slot     = 0u;
+  size_t size     = 0u;
+
+  state = (uint64_t)worker->index * 0x9E3779B97F4A7C15ULL + 1u;
+
+  for (iterator = 0u; iterator < worker->allocs; ++iterator)
+  {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    slot = iterator % RING_SLOTS;
+    size = sizeof(bench_node_t)
+         + (size_t)(state % (MAX_EXTRA + 1u)) * sizeof(uint64_t);
+
+    ring[slot] = MEM_alloc(size, FIRST_FIT);
+    CHECK(ring[slot] != NULL);
+
+    ring[slot]->owner = worker->index;
+    ring[slot]->slot  = slot;
+  }
+
+  for (slot = 0u; slot < RING_SLOTS && slot < worker->allocs; ++slot)
+    CHECK(ring[slot]->owner == worker->index && ring[slot]->slot == slot);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         BENCH_worker
+ *  @brief      Registered allocating thread.
+ *
+ *  @param [in] arg  Its bench_worker_t.
+ *
+ *  @return     NULL.
+ * ========================================================================== */
+static void *BENCH_worker(void *arg)
+{
+  bench_worker_t *worker = (bench_worker_t *)arg;
+
+  if (MEM_gcRegisterThread((mem_allocator_t *)NULL) != EXIT_SUCCESS)
+    return NULL;
+
+  while (!atomic_load(&g_go))
+    sched_yield( );
+
+  worker->ret = BENCH_churn(worker);
+
+  (void)MEM_gcUnregisterThread((mem_allocator_t *)NULL);
+
+  return NULL;
+}
+
+/*< end of file >*/
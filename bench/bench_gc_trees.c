@@ -0,0 +1,470 @@
+/*
+ * SPDX-FileCopyrightText: 2024-2025 Rafael V. Volkmer
+ * SPDX-FileCopyrightText: <rafael.v.volkmer@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+/** ============================================================================
+ *  @ingroup    Libmemalloc
+ *
+ *  @brief      Binary-trees allocation benchmark.
+ *
+ *  @file       bench_gc_trees.c
+ *  @headerfile libmemalloc.h
+ *
+ *  @details    Runs the classic binary-trees workload with the collector
+ *              thread enabled: a long-lived tree of the maximum depth stays
+ *              reachable from a global while many short-lived trees of
+ *              growing depth are built, checked and dropped without being
+ *              freed, so only the collector reclaims them. Reports the
+ *              total time, the longest stop of the world, the share of the
+ *              process CPU time spent marking and sweeping, and the peak
+ *              RSS, read from MEM_getGcStats() and getrusage().
+ *
+ *              Usage: bench_gc_trees [max_depth]
+ *
+ *  @version    v1.0.00
+ *  @date       18.10.2026
+ *  @author     Rafael V. Volkmer <rafael.v.volkmer@gmail.com>
+ * ========================================================================== */
+
+/** ============================================================================
+ *                      P R I V A T E  I N C L U D E S
+ * ========================================================================== */
+
+/*< Implemented >*/
+#include "libmemalloc.h"
+#include "logs.h"
+
+/*< Dependencies >*/
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <time.h>
+
+/** ============================================================================
+ *               P R I V A T E  D E F I N E S  &  M A C R O S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @def        EXIT_ERROR
+ *  @brief      Standard error return code for benchmark failures.
+ * ========================================================================== */
+#define EXIT_ERROR        (uint8_t)(1U)
+
+/** ============================================================================
+ *  @def        MIN_DEPTH
+ *  @brief      Depth of the smallest short-lived trees.
+ * ========================================================================== */
+#define MIN_DEPTH         (uint32_t)(4U)
+
+/** ============================================================================
+ *  @def        DEFAULT_MAX_DEPTH
+ *  @brief      Default depth of the long-lived tree.
+ * ========================================================================== */
+#define DEFAULT_MAX_DEPTH (uint32_t)(14U)
+
+/** ============================================================================
+ *  @def        MAX_DEPTH_LIMIT
+ *  @brief      Deepest tree accepted on the command line.
+ * ========================================================================== */
+#define MAX_DEPTH_LIMIT   (uint32_t)(24U)
+
+/** ============================================================================
+ *  @def        NSEC_PER_MSEC
+ *  @brief      Nanoseconds per millisecond.
+ * ========================================================================== */
+#define NSEC_PER_MSEC     (double)(1000000.0)
+
+/** ============================================================================
+ *  @def        KIB_PER_MIB
+ *  @brief      KiB per MiB, for ru_maxrss.
+ * ========================================================================== */
+#define KIB_PER_MIB       (double)(1024.0)
+
+/** ============================================================================
+ *  @def        CHECK(expr)
+ *  @brief      Assertion macro for validating benchmark steps.
+ *
+ *  @param [in] expr  Boolean expression to evaluate.
+ * ========================================================================== */
+#define CHECK(expr)                                                          \
+  do                                                                         \
+  {                                                                          \
+    if (!(expr))                                                             \
+    {                                                                        \
+      LOG_ERROR("Assertion failed at %s:%d: %s", __FILE__, __LINE__, #expr); \
+      return EXIT_ERROR;                                                     \
+    }                                                                        \
+  } while (0)
+
+/** ============================================================================
+ *                P R I V A T E  T Y P E S  D E F I N I T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @typedef    bench_node_t
+ *  @brief      Binary tree node.
+ * ========================================================================== */
+typedef struct BenchNode
+{
+  struct BenchNode *left;  /**< Left child, or NULL */
+  struct BenchNode *right; /**< Right child, or NULL */
+} bench_node_t;
+
+/** ============================================================================
+ *  @typedef    bench_sample_t
+ *  @brief      Clocks and collector counters read at one point of a run.
+ * ========================================================================== */
+typedef struct BenchSample
+{
+  uint64_t wall_ns;      /**< CLOCK_MONOTONIC time */
+  uint64_t cpu_us;       /**< Process and reaped children CPU time */
+  uint64_t gc_ns;        /**< Collector mark and sweep time */
+  uint64_t max_pause_ns; /**< Longest stop of the world so far */
+  uint64_t cycles;       /**< Completed collections */
+} bench_sample_t;
+
+/** ============================================================================
+ *              P R I V A T E  G L O B A L  V A R I A B L E S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @var        g_long_lived
+ *  @brief      Root of the long-lived tree; the only reference to it.
+ * ========================================================================== */
+static bench_node_t *volatile g_long_lived = (bench_node_t *)NULL;
+
+/** ============================================================================
+ *          P R I V A T E  F U N C T I O N S  P R O T O T Y P E S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         BENCH_now
+ *  @brief      Reads CLOCK_MONOTONIC in nanoseconds.
+ *
+ *  @return     Current time.
+ * ========================================================================== */
+static uint64_t BENCH_now(void);
+
+/** ============================================================================
+ *  @fn         BENCH_cpuUs
+ *  @brief      Reads the CPU time of the process and its reaped children.
+ *
+ *  @return     User plus system time, in microseconds.
+ * ========================================================================== */
+static uint64_t BENCH_cpuUs(void);
+
+/** ============================================================================
+ *  @fn         BENCH_sample
+ *  @brief      Reads the clocks and the collector counters.
+ *
+ *  @param [out] sample  Destination.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_sample(bench_sample_t *const sample);
+
+/** ============================================================================
+ *  @fn         BENCH_report
+ *  @brief      Prints the metrics of the run started at @p start.
+ *
+ *  @param [in] start  Sample taken when the run started.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_report(const bench_sample_t *const start);
+
+/** ============================================================================
+ *  @fn         BENCH_build
+ *  @brief      Allocates a complete binary tree of @p depth levels below
+ *              its root.
+ *
+ *  @param [in] depth  Levels below the root.
+ *
+ *  @return     Tree root, or NULL on allocation failure.
+ * ========================================================================== */
+static bench_node_t *BENCH_build(const uint32_t depth);
+
+/** ============================================================================
+ *  @fn         BENCH_count
+ *  @brief      Counts the nodes of a tree.
+ *
+ *  @param [in] node  Tree root.
+ *
+ *  @return     Number of nodes.
+ * ========================================================================== */
+static size_t BENCH_count(const bench_node_t *const node);
+
+/** ============================================================================
+ *  @fn         BENCH_churn
+ *  @brief      Builds, checks and drops the short-lived trees of one depth.
+ *
+ *  @param [in]  depth       Depth of the trees.
+ *  @param [in]  iterations  Number of trees.
+ *  @param [out] check       Total node count of the trees.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_churn(const uint32_t depth,
+                       const size_t   iterations,
+                       size_t *const  check) __attribute__((noinline));
+
+/** ============================================================================
+ *                          M A I N  F U N C T I O N
+ * ========================================================================== */
+
+int main(int argc, char **argv)
+{
+  int ret = EXIT_SUCCESS;
+
+  bench_sample_t start = { 0 };
+
+  bench_node_t *stretch = (bench_node_t *)NULL;
+
+  size_t iterations = 0u;
+  size_t check      = 0u;
+
+  uint32_t max_depth = DEFAULT_MAX_DEPTH;
+  uint32_t depth     = 0u;
+
+  if (argc > 1)
+    max_depth = (uint32_t)strtoul(argv[1], (char **)NULL, 10);
+
+  CHECK(max_depth >= MIN_DEPTH + 2u && max_depth <= MAX_DEPTH_LIMIT);
+
+  ret = MEM_enableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = BENCH_sample(&start);
+  CHECK(ret == EXIT_SUCCESS);
+
+  stretch = BENCH_build(max_depth + 1u);
+  CHECK(stretch != NULL);
+  printf("stretch tree of depth %u\t check: %zu\n",
+         max_depth + 1u,
+         BENCH_count(stretch));
+  stretch = (bench_node_t *)NULL;
+
+  g_long_lived = BENCH_build(max_depth);
+  CHECK(g_long_lived != NULL);
+
+  for (depth = MIN_DEPTH; depth <= max_depth; depth += 2u)
+  {
+    iterations = (size_t)1u << (max_depth - depth + MIN_DEPTH);
+
+    ret = BENCH_churn(depth, iterations, &check);
+    CHECK(ret == EXIT_SUCCESS);
+
+    printf("%zu\t trees of depth %u\t check: %zu\n",
+           iterations,
+           depth,
+           check);
+  }
+
+  printf("long lived tree of depth %u\t check: %zu\n",
+         max_depth,
+         BENCH_count(g_long_lived));
+
+  ret = BENCH_report(&start);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_disableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *                  F U N C T I O N S  D E F I N I T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         BENCH_now
+ *  @brief      Reads CLOCK_MONOTONIC in nanoseconds.
+ *
+ *  @return     Current time.
+ * ========================================================================== */
+static uint64_t BENCH_now(void)
+{
+  struct timespec ts = { 0 };
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/** ============================================================================
+ *  @fn         BENCH_cpuUs
+ *  @brief      Reads the CPU time of the process and its reaped children.
+ *
+ *  @return     User plus system time, in microseconds.
+ * ========================================================================== */
+static uint64_t BENCH_cpuUs(void)
+{
+  struct rusage self     = { 0 };
+  struct rusage children = { 0 };
+
+  getrusage(RUSAGE_SELF, &self);
+  getrusage(RUSAGE_CHILDREN, &children);
+
+  return (uint64_t)(self.ru_utime.tv_sec + self.ru_stime.tv_sec
+                    + children.ru_utime.tv_sec + children.ru_stime.tv_sec)
+           * 1000000u
+       + (uint64_t)(self.ru_utime.tv_usec + self.ru_stime.tv_usec
+                    + children.ru_utime.tv_usec + children.ru_stime.tv_usec);
+}
+
+/** ============================================================================
+ *  @fn         BENCH_sample
+ *  @brief      Reads the clocks and the collector counters.
+ *
+ *  @param [out] sample  Destination.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_sample(bench_sample_t *const sample)
+{
+  static mem_gc_stats_t stats = { 0 };
+
+  int ret = EXIT_SUCCESS;
+
+  ret = MEM_getGcStats((mem_allocator_t *)NULL, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+
+  sample->wall_ns      = BENCH_now( );
+  sample->cpu_us       = BENCH_cpuUs( );
+  sample->gc_ns        = stats.gc_ns;
+  sample->max_pause_ns = stats.max_pause_ns;
+  sample->cycles       = stats.cycles;
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         BENCH_report
+ *  @brief      Prints the metrics of the run started at @p start.
+ *
+ *  @param [in] start  Sample taken when the run started.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_report(const bench_sample_t *const start)
+{
+  int ret = EXIT_SUCCESS;
+
+  bench_sample_t end = { 0 };
+
+  struct rusage usage = { 0 };
+
+  double share = 0.0;
+
+  ret = BENCH_sample(&end);
+  CHECK(ret == EXIT_SUCCESS);
+
+  getrusage(RUSAGE_SELF, &usage);
+
+  if (end.cpu_us > start->cpu_us)
+    share = 100.0 * (double)(end.gc_ns - start->gc_ns)
+          / ((double)(end.cpu_us - start->cpu_us) * 1000.0);
+
+  printf("%10s %14s %10s %14s %8s\n",
+         "total ms",
+         "max pause ms",
+         "gc cpu %",
+         "peak rss MiB",
+         "cycles");
+  printf("%10.1f %14.3f %10.1f %14.1f %8llu\n",
+         (double)(end.wall_ns - start->wall_ns) / NSEC_PER_MSEC,
+         (double)end.max_pause_ns / NSEC_PER_MSEC,
+         share,
+         (double)usage.ru_maxrss / KIB_PER_MIB,
+         (unsigned long long)(end.cycles - start->cycles));
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         BENCH_build
+ *  @brief      Allocates a complete binary tree of @p depth levels below
+ *              its root.
+ *
+ *  @param [in] depth  Levels below the root.
+ *
+ *  @return     Tree root, or NULL on allocation failure.
+ * ========================================================================== */
+static bench_node_t *BENCH_build(const uint32_t depth)
+{
+  bench_node_t *node = (bench_node_t *)NULL;
+
+  node = MEM_alloc(sizeof(bench_node_t), FIRST_FIT);
+  if (node == NULL)
+    return (bench_node_t *)NULL;
+
+  node->left  = (bench_node_t *)NULL;
+  node->right = (bench_node_t *)NULL;
+
+  if (depth == 0u)
+    return node;
+
+  node->left = BENCH_build(depth - 1u);
+  if (node->left == NULL)
+    return (bench_node_t *)NULL;
+
+  node->right = BENCH_build(depth - 1u);
+  if (node->right == NULL)
+    return (bench_node_t *)NULL;
+
+  return node;
+}
+
+/** ============================================================================
+ *  @fn         BENCH_count
+ *  @brief      Counts the nodes of a tree.
+ *
+ *  @param [in] node  Tree root.
+ *
+ *  @return     Number of nodes.
+ * ========================================================================== */
+static size_t BENCH_count(const bench_node_t *const node)
+{
+  if (node->left == NULL)
+    return 1u;
+
+  return 1u + BENCH_count(node->left) + BENCH_count(node->right);
+}
+
+/** ============================================================================
+ *  @fn         BENCH_churn
+ *  @brief      Builds, checks and drops the short-lived trees of one depth.
+ *
+ *  @param [in]  depth       Depth of the trees.
+ *  @param [in]  iterations  Number of trees.
+ *  @param [out] check       Total node count of the trees.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int BENCH_churn(const uint32_t depth,
+                       const size_t   iterations,
+                       size_t *const  check)
+{
+  bench_node_t *tree = (bench_node_t *)NULL;
+
+  size_t iterator = 0u;
+
+  *check = 0u;
+
+  for (iterator = 0u; iterator < iterations; ++iterator)
+  {
+    tree = BENCH_build(depth);
+    CHECK(tree != NULL);
+
+    *check += BENCH_count(tree);
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/*< end of file >*/
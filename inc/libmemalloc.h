@@ -58,6 +58,109 @@ extern "C"
  * ========================================================================== */
 #define GC_INTERVAL_MS (uint16_t)(100U)
 
+/** ============================================================================
+ *  @def        MEM_TAG_DEFAULT
+ *  @brief      Accounting tag charged for untagged allocations.
+ *
+ *  @details    Every block carries an accounting tag. Allocations made
+ *              through the untagged API (MEM_alloc(), MEM_calloc(), ...)
+ *              are charged to this tag, which is always registered.
+ * ========================================================================== */
+#define MEM_TAG_DEFAULT (uint32_t)(0U)
+
+/** ============================================================================
+ *  @def        MEM_MAX_TAGS
+ *  @brief      Maximum number of accounting tags, default tag included.
+ * ========================================================================== */
+#define MEM_MAX_TAGS     (uint8_t)(32U)
+
+/** ============================================================================
+ *  @def        MEM_TAG_NAME_LEN
+ *  @brief      Maximum tag name length, terminating NUL included.
+ * ========================================================================== */
+#define MEM_TAG_NAME_LEN (uint8_t)(32U)
+
+/** ============================================================================
+ *  @def        MEM_LAYOUT_CONSERVATIVE
+ *  @brief      Layout of untyped blocks: every payload word is scanned.
+ * ========================================================================== */
+#define MEM_LAYOUT_CONSERVATIVE (uint32_t)(0U)
+
+/** ============================================================================
+ *  @def        MEM_LAYOUT_ATOMIC
+ *  @brief      Layout of pointer-free blocks: the payload is never scanned.
+ * ========================================================================== */
+#define MEM_LAYOUT_ATOMIC       (uint32_t)(1U)
+
+/** ============================================================================
+ *  @def        MEM_LAYOUT_FIRST
+ *  @brief      First identifier handed out by MEM_registerLayout().
+ * ========================================================================== */
+#define MEM_LAYOUT_FIRST        (uint32_t)(2U)
+
+/** ============================================================================
+ *  @def        MEM_MAX_LAYOUTS
+ *  @brief      Maximum number of pointer layouts, reserved ones included.
+ * ========================================================================== */
+#define MEM_MAX_LAYOUTS         (uint8_t)(64U)
+
+/** ============================================================================
+ *  @def        MEM_LAYOUT_MAX_WORDS
+ *  @brief      Maximum size, in words, of a type described by a layout.
+ * ========================================================================== */
+#define MEM_LAYOUT_MAX_WORDS    (uint16_t)(256U)
+
+/** ============================================================================
+ *  @def        MEM_MAX_PRESSURE_CBS
+ *  @brief      Maximum number of callbacks registered via MEM_onPressure().
+ * ========================================================================== */
+#define MEM_MAX_PRESSURE_CBS (uint8_t)(8U)
+
+/** ============================================================================
+ *  @def        MEM_CGROUP_ENV
+ *  @brief      Environment variable overriding the cgroup v2 directory.
+ *
+ *  @details    When set, the allocator reads memory.max and memory.current
+ *              from this directory instead of the cgroup found through
+ *              /proc/self/cgroup.
+ * ========================================================================== */
+#define MEM_CGROUP_ENV       "MEMALLOC_CGROUP_DIR"
+
+/** ============================================================================
+ *  @def        MEM_GC_MAX_THREADS
+ *  @brief      Maximum number of threads registered as GC roots.
+ * ========================================================================== */
+#define MEM_GC_MAX_THREADS   (uint8_t)(64U)
+
+/** ============================================================================
+ *  @def        MEM_GC_MAX_WORKERS
+ *  @brief      Maximum number of parallel garbage collector workers.
+ * ========================================================================== */
+#define MEM_GC_MAX_WORKERS   (uint8_t)(16U)
+
+/** ============================================================================
+ *  @def        MEM_GC_WORKERS_ENV
+ *  @brief      Environment variable selecting the GC worker count.
+ *
+ *  @details    Read when the collector first runs, unless
+ *              MEM_gcSetWorkers() was called. Values above
+ *              MEM_GC_MAX_WORKERS are clamped; unset or invalid means a
+ *              single worker.
+ * ========================================================================== */
+#define MEM_GC_WORKERS_ENV   "MEMALLOC_GC_WORKERS"
+
+/** ============================================================================
+ *  @def        MEM_GC_CYCLE_DONE
+ *  @brief      MEM_gcStep() result when the step completed a GC cycle.
+ * ========================================================================== */
+#define MEM_GC_CYCLE_DONE    (int)(1)
+
+/** ============================================================================
+ *  @def        MEM_GC_STATS_RING
+ *  @brief      Number of recent GC cycles kept by MEM_getGcStats().
+ * ========================================================================== */
+#define MEM_GC_STATS_RING    (uint8_t)(64U)
+
 /** ============================================================================
  *              P U B L I C  S T R U C T U R E S  &  T Y P E S
  * ========================================================================== */
@@ -82,6 +185,219 @@ typedef enum AllocationStrategy
   BEST_FIT  = (uint8_t)(2u) /**< Use the smallest block that fits the request */
 } allocation_strategy_t;
 
+/** ============================================================================
+ *  @struct     MemTagStats
+ *  @typedef    mem_tag_stats_t
+ *  @brief      Snapshot of the accounting counters of one tag.
+ *
+ *  @details    Filled by MEM_getTagStats(). Byte counters refer to usable
+ *              payload bytes (header and canary excluded). peak_bytes
+ *              includes spikes allocated and freed between two reads:
+ *              each thread shard keeps a high-water mark updated by the
+ *              allocating thread. It is exact while one thread at a time
+ *              allocates under the tag, and may overstate the peak when
+ *              several threads spike at different times.
+ *
+ *  @par Fields:
+ *    @li @b live_bytes  – Bytes currently allocated under the tag
+ *    @li @b peak_bytes  – Highest live_bytes since registration
+ *    @li @b total_bytes – Bytes ever allocated under the tag
+ *    @li @b alloc_count – Number of allocations charged to the tag
+ *    @li @b free_count  – Number of frees charged to the tag
+ *    @li @b alloc_rate  – Bytes/s allocated since the previous snapshot
+ *    @li @b soft_limit  – Configured soft limit (0 when disabled)
+ *    @li @b limit_hits  – Allocations that left the tag above its soft limit
+ * ========================================================================== */
+typedef struct MemTagStats
+{
+  size_t live_bytes;    /**< Bytes currently allocated under the tag */
+  size_t peak_bytes;    /**< Highest live_bytes reached */
+
+  uint64_t total_bytes; /**< Bytes ever allocated under the tag */
+  uint64_t alloc_count; /**< Number of allocations charged to the tag */
+  uint64_t free_count;  /**< Number of frees charged to the tag */
+  uint64_t alloc_rate;  /**< Bytes/s allocated since the previous snapshot */
+
+  size_t   soft_limit;  /**< Configured soft limit (0 when disabled) */
+  uint64_t limit_hits;  /**< Allocations leaving the tag above soft_limit */
+} mem_tag_stats_t;
+
+/** ============================================================================
+ *  @enum       MemPressureLevel
+ *  @typedef    mem_pressure_level_t
+ *  @brief      Severity reported to memory pressure callbacks.
+ *
+ *  @par Fields:
+ *    @li @b MEM_PRESSURE_SOFT – Footprint crossed the soft limit
+ *    @li @b MEM_PRESSURE_HARD – A growth request was refused by the hard limit
+ * ========================================================================== */
+typedef enum MemPressureLevel
+{
+  MEM_PRESSURE_SOFT = (uint8_t)(1u), /**< Footprint crossed the soft limit */
+  MEM_PRESSURE_HARD = (uint8_t)(2u)  /**< Growth refused by the hard limit */
+} mem_pressure_level_t;
+
+/** ============================================================================
+ *  @typedef    mem_pressure_cb_t
+ *  @brief      Memory pressure callback.
+ *
+ *  @details    Invoked on the allocating thread after the allocator lock has
+ *              been released, so the callback may free (or allocate) memory
+ *              through the public API.
+ *
+ *  @param[in]  level     Pressure severity.
+ *  @param[in]  footprint Heap plus mmap bytes at the time of the event.
+ *  @param[in]  arg       User pointer given to MEM_onPressure().
+ * ========================================================================== */
+typedef void (*mem_pressure_cb_t)(const mem_pressure_level_t level,
+                                  const size_t               footprint,
+                                  void *const                arg);
+
+/** ============================================================================
+ *  @struct     MemCgroupInfo
+ *  @typedef    mem_cgroup_info_t
+ *  @brief      cgroup v2 readings and the tuning derived from them.
+ *
+ *  @details    Filled by MEM_getCgroupInfo(). When the cgroup has no memory
+ *              limit, @b max is SIZE_MAX and the derived limits are 0.
+ *              Only @b soft_limit is applied; @b hard_limit is reported
+ *              but never refuses an allocation, since memory.current also
+ *              counts page cache and other processes of the cgroup. Set a
+ *              hard cap with MEM_setLimit().
+ *
+ *              The snapshot is refreshed every @b refresh_ms only while
+ *              the garbage collector thread or the PSI monitor runs.
+ *              Without either, it is refreshed when the heap grows, so an
+ *              idle process does not notice the cgroup filling up until
+ *              its next growth or MEM_cgroupRefresh() call.
+ *
+ *  @par Fields:
+ *    @li @b max            – memory.max of the cgroup
+ *    @li @b current        – memory.current at the last refresh
+ *    @li @b soft_limit     – Derived soft footprint limit
+ *    @li @b hard_limit     – Derived hard level (reported, not enforced)
+ *    @li @b cache_budget   – Suggested default size of application caches
+ *    @li @b gc_interval_ms – Derived garbage collector cadence
+ *    @li @b refresh_ms     – Derived refresh/scavenge period
+ * ========================================================================== */
+typedef struct MemCgroupInfo
+{
+  size_t max;              /**< memory.max of the cgroup */
+  size_t current;          /**< memory.current at the last refresh */
+
+  size_t soft_limit;       /**< Derived soft footprint limit */
+  size_t hard_limit;       /**< Derived hard level, not enforced */
+  size_t cache_budget;     /**< Suggested application cache size */
+
+  uint32_t gc_interval_ms; /**< Derived GC cadence */
+  uint32_t refresh_ms;     /**< Derived refresh/scavenge period */
+} mem_cgroup_info_t;
+
+/** ============================================================================
+ *  @typedef    mem_handle_t
+ *  @brief      Reference to a movable allocation.
+ *
+ *  @details    Returned by MEM_hAlloc(). Valid handles are positive;
+ *              MEM_hAlloc() reports failures as negative error codes.
+ * ========================================================================== */
+typedef int32_t mem_handle_t;
+
+/** ============================================================================
+ *  @enum       MemGcKind
+ *  @typedef    mem_gc_kind_t
+ *  @brief      How a garbage collection cycle was run.
+ *
+ *  @par Fields:
+ *    @li @b MEM_GC_KIND_FULL        – Stop-the-world mark of the whole heap
+ *    @li @b MEM_GC_KIND_INCREMENTAL – Incremental or mostly-concurrent mark
+ *    @li @b MEM_GC_KIND_SNAPSHOT    – Mark of a fork()ed snapshot
+ *    @li @b MEM_GC_KIND_MINOR       – Generational minor collection
+ * ========================================================================== */
+typedef enum MemGcKind
+{
+  MEM_GC_KIND_FULL        = (uint8_t)(0u), /**< Stop-the-world mark */
+  MEM_GC_KIND_INCREMENTAL = (uint8_t)(1u), /**< Incremental mark */
+  MEM_GC_KIND_SNAPSHOT    = (uint8_t)(2u), /**< fork()ed snapshot mark */
+  MEM_GC_KIND_MINOR       = (uint8_t)(3u)  /**< Generational minor cycle */
+} mem_gc_kind_t;
+
+/** ============================================================================
+ *  @struct     MemGcCycle
+ *  @typedef    mem_gc_cycle_t
+ *  @brief      Metrics of one completed garbage collection cycle.
+ *
+ *  @details    Times are CLOCK_MONOTONIC nanoseconds. @b mark_ns and
+ *              @b sweep_ns add up the time spent in each phase, which for
+ *              incremental and lazy cycles is spread over many slices;
+ *              @b total_ns runs from the start of the cycle to the end of
+ *              its sweep. Heap figures are live payload bytes summed over
+ *              every accounting tag. Snapshot cycles mark in a child
+ *              process, so their scan and mark counters stay at zero and
+ *              @b mark_ns is the time spent waiting for the child.
+ *
+ *  @par Fields:
+ *    @li @b seq           – Cycle number, from 1
+ *    @li @b kind          – How the cycle was run
+ *    @li @b total_ns      – Start of the cycle to the end of its sweep
+ *    @li @b mark_ns       – Time spent marking
+ *    @li @b sweep_ns      – Time spent sweeping
+ *    @li @b pause_ns      – Time mutators were stopped
+ *    @li @b max_pause_ns  – Longest single stop of the world
+ *    @li @b bytes_scanned – Bytes of roots and payloads scanned
+ *    @li @b blocks_marked – Blocks found reachable by scanning
+ *    @li @b blocks_freed  – Blocks reclaimed by the sweep
+ *    @li @b bytes_freed   – Bytes reclaimed by the sweep
+ *    @li @b heap_before   – Live bytes when the cycle started
+ *    @li @b heap_after    – Live bytes when the cycle ended
+ * ========================================================================== */
+typedef struct MemGcCycle
+{
+  uint64_t      seq;  /**< Cycle number, from 1 */
+  mem_gc_kind_t kind; /**< How the cycle was run */
+
+  uint64_t total_ns;     /**< Start to end of the sweep */
+  uint64_t mark_ns;      /**< Time spent marking */
+  uint64_t sweep_ns;     /**< Time spent sweeping */
+  uint64_t pause_ns;     /**< Time mutators were stopped */
+  uint64_t max_pause_ns; /**< Longest single stop */
+
+  uint64_t bytes_scanned; /**< Bytes of roots and payloads scanned */
+  uint64_t blocks_marked; /**< Blocks found reachable */
+  uint64_t blocks_freed;  /**< Blocks reclaimed */
+  uint64_t bytes_freed;   /**< Bytes reclaimed */
+
+  size_t heap_before; /**< Live bytes at the start */
+  size_t heap_after;  /**< Live bytes at the end */
+} mem_gc_cycle_t;
+
+/** ============================================================================
+ *  @struct     MemGcStats
+ *  @typedef    mem_gc_stats_t
+ *  @brief      Garbage collector totals and its most recent cycles.
+ *
+ *  @details    Filled by MEM_getGcStats(). Totals cover every completed
+ *              cycle; @b recent keeps the last MEM_GC_STATS_RING of them,
+ *              oldest first.
+ *
+ *  @par Fields:
+ *    @li @b cycles       – Cycles completed
+ *    @li @b gc_ns        – Marking and sweeping time of all cycles
+ *    @li @b pause_ns     – Stop-the-world time of all cycles
+ *    @li @b max_pause_ns – Longest single stop of the world
+ *    @li @b count        – Valid entries in @b recent
+ *    @li @b recent       – Most recent cycles, oldest first
+ * ========================================================================== */
+typedef struct MemGcStats
+{
+  uint64_t cycles;       /**< Cycles completed */
+  uint64_t gc_ns;        /**< Marking and sweeping time */
+  uint64_t pause_ns;     /**< Stop-the-world time */
+  uint64_t max_pause_ns; /**< Longest single stop */
+
+  uint32_t       count;                     /**< Valid entries in recent */
+  mem_gc_cycle_t recent[MEM_GC_STATS_RING]; /**< Oldest first */
+} mem_gc_stats_t;
+
 /** ============================================================================
  *          P U B L I C  F U N C T I O N S  P R O T O T Y P E S
  * ========================================================================== */
@@ -249,19 +565,402 @@ __LIBMEMALLOC_API void *MEM_realloc(void *const                 ptr,
  * ========================================================================== */
 __LIBMEMALLOC_API int MEM_free(void *const ptr);
 
+/** ============================================================================
+ *            T A G G E D  A C C O U N T I N G  F U N C T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @brief  Registers (or looks up) a named accounting tag.
+ *
+ *  Registering a name that already exists returns the existing identifier,
+ *  so subsystems may call this unconditionally at start-up. This includes
+ *  the reserved name "default", which yields MEM_TAG_DEFAULT.
+ *
+ *  @param[in]  name      NUL-terminated tag name (truncated to
+ *                        MEM_TAG_NAME_LEN - 1 characters).
+ *
+ *  @return Tag identifier on success (> MEM_TAG_DEFAULT for any name but
+ *          "default"), negative error code on failure.
+ *
+ *  @retval -EINVAL:  @p name is NULL or empty.
+ *  @retval -ENOSPC:  All MEM_MAX_TAGS slots are in use.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_registerTag(const char *const name);
+
+/** ============================================================================
+ *  @brief  Allocates memory (FIRST_FIT) and charges it to an accounting tag.
+ *
+ *  The tag travels with the block: MEM_free() credits it back and
+ *  MEM_realloc() keeps it on the new block.
+ *
+ *  @param[in]  size      Number of bytes requested.
+ *  @param[in]  tag       Identifier returned by MEM_registerTag().
+ *
+ *  @return Pointer to the allocated user memory on success,
+ *          or an error‐encoded pointer (via PTR_ERR()) on failure.
+ *
+ *  @retval -EINVAL:  @p tag is not registered or @p size is zero.
+ * ========================================================================== */
+__LIBMEMALLOC_API void *MEM_allocTagged(const size_t size, const uint32_t tag)
+  __LIBMEMALLOC_MALLOC;
+
+/** ============================================================================
+ *  @brief  Registers (or looks up) a precise pointer layout.
+ *
+ *  Describes a type once so that the garbage collector follows only its
+ *  real pointer fields: bit i of @p bitmap is set when word i of the type
+ *  holds a heap pointer. Registering an existing layout returns its
+ *  identifier. A layout without pointer words is MEM_LAYOUT_ATOMIC.
+ *
+ *  @param[in]  bitmap    Pointer-word bitmap, (words + 63) / 64 words long.
+ *  @param[in]  words     Size of the type in words.
+ *
+ *  @return Layout identifier on success, negative error code on failure.
+ *
+ *  @retval -EINVAL:  @p bitmap is NULL or @p words is 0 or above
+ *                    MEM_LAYOUT_MAX_WORDS.
+ *  @retval -ENOSPC:  All MEM_MAX_LAYOUTS slots are in use.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_registerLayout(const uint64_t *const bitmap,
+                                         const size_t          words);
+
+/** ============================================================================
+ *  @brief  Allocates memory (FIRST_FIT) with a precise pointer layout.
+ *
+ *  With the garbage collector, only the pointer words of @p layout are
+ *  scanned; the layout repeats over the payload, so an array of the type
+ *  shares its layout. Integers that look like addresses no longer keep
+ *  blocks alive. MEM_realloc() keeps the layout on the new block. Without
+ *  the collector it behaves like MEM_allocFirstFit().
+ *
+ *  @param[in]  size      Number of bytes requested.
+ *  @param[in]  layout    MEM_LAYOUT_* constant or identifier returned by
+ *                        MEM_registerLayout().
+ *
+ *  @return Pointer to the allocated user memory on success,
+ *          or an error‐encoded pointer (via PTR_ERR()) on failure.
+ *
+ *  @retval -EINVAL:  @p layout is not registered or @p size is zero.
+ * ========================================================================== */
+__LIBMEMALLOC_API void *MEM_allocTyped(const size_t size, const uint32_t layout)
+  __LIBMEMALLOC_MALLOC;
+
+/** ============================================================================
+ *  @brief  Allocates memory (FIRST_FIT) that will never hold heap pointers.
+ *
+ *  Meant for numeric buffers, strings and images. Same as MEM_allocTyped()
+ *  with MEM_LAYOUT_ATOMIC: the block is kept alive while referenced but its
+ *  payload is never scanned.
+ *
+ *  @param[in]  size      Number of bytes requested.
+ *
+ *  @return Pointer to the allocated user memory on success,
+ *          or an error‐encoded pointer (via PTR_ERR()) on failure.
+ * ========================================================================== */
+__LIBMEMALLOC_API void *MEM_allocAtomic(const size_t size)
+  __LIBMEMALLOC_MALLOC;
+
+/** ============================================================================
+ *  @brief  Sets or clears the soft limit of an accounting tag.
+ *
+ *  Allocations that leave the tag above @p soft_limit still succeed; they
+ *  are counted in mem_tag_stats_t::limit_hits and a warning is logged when
+ *  the limit is first crossed.
+ *
+ *  @param[in]  tag         Identifier returned by MEM_registerTag().
+ *  @param[in]  soft_limit  Limit in payload bytes, or 0 to disable.
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ *
+ *  @retval -EINVAL:  @p tag is not registered.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_setTagLimit(const uint32_t tag,
+                                      const size_t   soft_limit);
+
+/** ============================================================================
+ *  @brief  Reads the accounting counters of a tag.
+ *
+ *  Counters are summed from per-thread shards without taking the allocator
+ *  lock; peak_bytes also covers spikes freed before this call. alloc_rate
+ *  is computed against the previous call for the same tag.
+ *
+ *  @param[in]  tag       Identifier returned by MEM_registerTag().
+ *  @param[out] stats     Destination snapshot.
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ *
+ *  @retval -EINVAL:  @p tag is not registered or @p stats is NULL.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_getTagStats(const uint32_t         tag,
+                                      mem_tag_stats_t *const stats);
+
+/** ============================================================================
+ *              M E M O R Y  L I M I T  F U N C T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @brief  Sets the soft and hard footprint limits of the allocator.
+ *
+ *  The footprint is the size of the user heap plus every mmap region. Limits
+ *  are only evaluated when the allocator asks the kernel for more memory.
+ *  Crossing @p soft runs the MEM_onPressure() callbacks followed by
+ *  MEM_trim(); a request that would exceed @p hard fails with -ENOMEM.
+ *  Passing 0 for both falls back to the soft limit derived from the cgroup
+ *  (see MEM_cgroupRefresh()), if any; no hard limit is derived from it.
+ *
+ *  @param[in]  soft      Soft limit in bytes, or 0 to disable.
+ *  @param[in]  hard      Hard limit in bytes, or 0 to disable.
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ *
+ *  @retval -EINVAL:  Both limits set and @p soft is above @p hard.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_setLimit(const size_t soft, const size_t hard);
+
+/** ============================================================================
+ *  @brief  Registers a memory pressure callback.
+ *
+ *  @param[in]  callback  Function run on soft/hard limit events.
+ *  @param[in]  arg       User pointer handed back to @p callback.
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ *
+ *  @retval -EINVAL:  @p callback is NULL.
+ *  @retval -ENOSPC:  MEM_MAX_PRESSURE_CBS callbacks already registered.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_onPressure(const mem_pressure_cb_t callback,
+                                     void *const             arg);
+
+/** ============================================================================
+ *  @brief  Returns free memory to the kernel.
+ *
+ *  Releases a free block sitting at the top of the heap through sbrk() and
+ *  applies madvise(MADV_DONTNEED) to the page-aligned interior of the other
+ *  free blocks. Block headers and canaries are left resident.
+ *
+ *  @return Number of bytes released (>= 0) on success,
+ *          negative error code on failure.
+ * ========================================================================== */
+__LIBMEMALLOC_API intptr_t MEM_trim(void);
+
+/** ============================================================================
+ *                    C G R O U P  F U N C T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @brief  Re-reads the cgroup v2 memory files and re-derives the tuning.
+ *
+ *  The allocator reads its cgroup once at initialisation and again every
+ *  mem_cgroup_info_t::refresh_ms, from the garbage collector thread while
+ *  it runs, from the PSI monitor thread while it runs (MEM_psiMonitorStart())
+ *  and from the growth path otherwise. This call forces a
+ *  refresh, optionally switching to another cgroup directory. Limits set
+ *  through MEM_setLimit() take precedence over the derived soft limit, and
+ *  the derived GC cadence is then left alone. The derived hard level is
+ *  only reported; a hard cap needs MEM_setLimit().
+ *
+ *  @param[in]  dir       cgroup directory, or NULL to keep the current one.
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ *
+ *  @retval -ENOENT:        memory.max or memory.current cannot be read.
+ *  @retval -EINVAL:        A file holds an unparsable value.
+ *  @retval -ENAMETOOLONG:  @p dir does not fit in PATH_MAX.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_cgroupRefresh(const char *const dir);
+
+/** ============================================================================
+ *  @brief  Reads the last cgroup snapshot and derived tuning.
+ *
+ *  @param[out] info      Destination snapshot.
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ *
+ *  @retval -EINVAL:  @p info is NULL.
+ *  @retval -ENOENT:  No cgroup v2 memory controller was found.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_getCgroupInfo(mem_cgroup_info_t *const info);
+
+/** ============================================================================
+ *              P R E S S U R E  S T A L L  F U N C T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @brief  Starts the memory pressure-stall (PSI) monitor thread.
+ *
+ *  Registers the trigger "some <stall_us> <window_us>" on
+ *  /proc/pressure/memory and blocks in poll() until the kernel reports that
+ *  tasks stalled on memory for @p stall_us within @p window_us. Each event
+ *  runs the MEM_onPressure() callbacks, trims the heap and wakes the
+ *  garbage collector. While a cgroup is tracked the thread also wakes every
+ *  mem_cgroup_info_t::refresh_ms to refresh it (see MEM_cgroupRefresh()).
+ *
+ *  Unprivileged processes need @p window_us to be a multiple of 2 s.
+ *
+ *  @param[in]  stall_us  Stall threshold in microseconds.
+ *  @param[in]  window_us Tracking window in microseconds.
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ *
+ *  @retval -EINVAL:    @p stall_us is 0 or above @p window_us.
+ *  @retval -EALREADY:  The monitor is already running.
+ *  @retval -ENOTSUP:   The kernel does not expose PSI.
+ *  @retval ret<0:      Negated errno of a refused trigger or thread creation.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_psiMonitorStart(const uint32_t stall_us,
+                                          const uint32_t window_us);
+
+/** ============================================================================
+ *  @brief  Stops the PSI monitor thread and releases its trigger.
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ *
+ *  @retval -EINVAL:  The monitor is not running, or it already exited on
+ *                    a failed poll() or a torn-down trigger.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_psiMonitorStop(void);
+
+/** ============================================================================
+ *              M O V A B L E  A L L O C A T I O N  F U N C T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @brief  Allocates a movable block and returns its handle.
+ *
+ *  The block is unpinned: MEM_compact() and pressure events may move it.
+ *  Its address is only obtained, and kept stable, through MEM_hLock().
+ *
+ *  @param[in]  size      Number of bytes requested.
+ *
+ *  @return Handle (> 0) on success, negative error code on failure.
+ *
+ *  @retval -EINVAL:  @p size is zero or too large.
+ *  @retval -ENOSPC:  INT32_MAX handles are in use.
+ *  @retval -ENOMEM:  Out of memory.
+ * ========================================================================== */
+__LIBMEMALLOC_API mem_handle_t MEM_hAlloc(const size_t size);
+
+/** ============================================================================
+ *  @brief  Pins a movable block and returns its current address.
+ *
+ *  Locks nest: the block stays in place until every MEM_hLock() has been
+ *  matched by MEM_hUnlock().
+ *
+ *  @param[in]  handle    Handle returned by MEM_hAlloc().
+ *
+ *  @return Pointer to the payload on success,
+ *          or an error-encoded pointer (via PTR_ERR()) on failure.
+ *
+ *  @retval -EINVAL:    @p handle is not allocated.
+ *  @retval -EOVERFLOW: @p handle holds UINT32_MAX locks.
+ * ========================================================================== */
+__LIBMEMALLOC_API void *MEM_hLock(const mem_handle_t handle);
+
+/** ============================================================================
+ *  @brief  Drops one pin taken by MEM_hLock().
+ *
+ *  Once the last pin is gone, the address returned by MEM_hLock() must no
+ *  longer be used: the block may move.
+ *
+ *  @param[in]  handle    Handle returned by MEM_hAlloc().
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ *
+ *  @retval -EINVAL:  @p handle is not allocated.
+ *  @retval -EPERM:   @p handle is not locked.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_hUnlock(const mem_handle_t handle);
+
+/** ============================================================================
+ *  @brief  Releases a movable block and its handle.
+ *
+ *  @param[in]  handle    Handle returned by MEM_hAlloc().
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ *
+ *  @retval -EINVAL:  @p handle is not allocated.
+ *  @retval -EBUSY:   @p handle is locked.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_hFree(const mem_handle_t handle);
+
+/** ============================================================================
+ *  @brief  Compacts the heap, then returns free memory to the kernel.
+ *
+ *  Slides every unlocked MEM_hAlloc() block toward the heap start, over
+ *  the free space below it, so the free space gathers at the top where
+ *  MEM_trim() can release it. Ordinary and locked blocks stay in place.
+ *  Meant for idle time: the heap is walked and copied with the allocator
+ *  lock held. Blocks are not moved while a collection is in progress.
+ *
+ *  @return Number of bytes released (>= 0) on success,
+ *          negative error code on failure.
+ * ========================================================================== */
+__LIBMEMALLOC_API intptr_t MEM_compact(void);
+
+/** ============================================================================
+ *  @brief  Tells whether a block is worth moving to defragment the heap.
+ *
+ *  True when freeing the block would let heap pages it keeps resident be
+ *  released and a free block in densely used pages can take it. mmap
+ *  blocks always report false.
+ *
+ *  @param[in]  ptr       Pointer returned by an allocation function.
+ *
+ *  @return true if MEM_relocate() would move the block, false otherwise.
+ * ========================================================================== */
+__LIBMEMALLOC_API bool MEM_shouldRelocate(const void *const ptr);
+
+/** ============================================================================
+ *  @brief  Moves a block out of a sparsely used heap region.
+ *
+ *  When MEM_shouldRelocate() holds, copies the payload into a block in
+ *  densely used pages and frees the original, so applications can migrate
+ *  their data incrementally. Otherwise returns @p ptr unchanged.
+ *
+ *  @param[in]  ptr       Pointer returned by an allocation function.
+ *
+ *  @return New pointer when the block moved, @p ptr when it stays,
+ *          or an error-encoded pointer (via PTR_ERR()) on failure.
+ *
+ *  @retval -EINVAL:  @p ptr is NULL or the allocator is not initialised.
+ * ========================================================================== */
+__LIBMEMALLOC_API void *MEM_relocate(void *const ptr);
+
 /** ============================================================================
  *          G A R B A G E  C O L L E C T O R  F U N C T I O N S
  * ========================================================================== */
 
 #if defined(GARBAGE_COLLECTOR)
 
+/** ============================================================================
+ *  @typedef    mem_allocator_t
+ *  @brief      Opaque allocator context; pass NULL for the global allocator.
+ * ========================================================================== */
+typedef struct MemoryAllocator mem_allocator_t;
+
 /** ============================================================================
  *  @brief  Start or signal the garbage collector thread.
  *
- *  This function simply wraps MEM_runGc(), starting the GC thread if needed
- *  or signaling it to perform a collection cycle.
+ *  This function wraps MEM_runGc(), starting the GC thread if needed
+ *  or signaling it to perform a collection cycle. Marking is conservative
+ *  and transitive: every block reachable from a registered thread's stack
+ *  or registers, or from the writable segments of any loaded object,
+ *  directly or through other blocks, survives the sweep. Where the kernel
+ *  tracks soft-dirty pages, the thread marks while mutators run and only
+ *  stops the world to scan roots and rescan the pages written meanwhile.
  *
- *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator (initialised on first use).
  *
  *  @return EXIT_SUCCESS on success,
  *          negative error code on failure.
@@ -271,16 +970,262 @@ __LIBMEMALLOC_API int MEM_enableGc(mem_allocator_t *const allocator);
 /** ============================================================================
  *  @brief  Stop the garbage collector thread and perform a final collection.
  *
- *  This function simply wraps MEM_stopGc(), signaling the GC thread to exit,
+ *  This function wraps MEM_stopGc(), signaling the GC thread to exit,
  *  joining it, and running a final mark-and-sweep cycle on the caller thread.
  *
- *  @param[in]  allocator Memory allocator context
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator (initialised on first use).
  *
  *  @return EXIT_SUCCESS on success,
  *          negative error code on failure.
  * ========================================================================== */
 __LIBMEMALLOC_API int MEM_disableGc(mem_allocator_t *const allocator);
 
+/** ============================================================================
+ *  @brief  Registers the calling thread as a garbage collector root.
+ *
+ *  While the collector marks, registered threads are stopped with a signal
+ *  (SIGPWR, resumed with SIGXCPU) and their registers and live stack are
+ *  scanned. Threads that hold heap pointers only on their stack must
+ *  register; the thread calling MEM_enableGc() is registered automatically.
+ *  A registered thread should call MEM_gcUnregisterThread() when it no
+ *  longer holds heap pointers; one that exits first is unregistered
+ *  automatically. It must not block the two signals.
+ *
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator (initialised on first use).
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ *
+ *  @retval -EALREADY:  The calling thread is already registered.
+ *  @retval -ENOSPC:    MEM_GC_MAX_THREADS threads are already registered.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_gcRegisterThread(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Removes the calling thread from the garbage collector roots.
+ *
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator.
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ *
+ *  @retval -ENOENT:  The calling thread is not registered.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_gcUnregisterThread(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Sets the number of threads that mark and sweep in parallel.
+ *
+ *  The collector thread counts as one worker; the others are created before
+ *  the next cycle and steal marking work from each other. Sweeping splits
+ *  the heap bitmap into one range per worker. Takes effect from the next
+ *  cycle.
+ *
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator (initialised on first use).
+ *  @param[in]  workers   Worker count, 1 to MEM_GC_MAX_WORKERS.
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ *
+ *  @retval -EINVAL:  @p workers is out of range.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_gcSetWorkers(mem_allocator_t *const allocator,
+                                       const uint32_t         workers);
+
+/** ============================================================================
+ *  @brief  Performs a bounded slice of an incremental collection.
+ *
+ *  The first call starts a cycle: marks are cleared and the roots are
+ *  scanned with the world stopped. Later calls trace marked blocks and then
+ *  sweep the heap bitmap, each stopping once @p budget_us has elapsed and
+ *  resuming there on the next call. Mutators run between steps; blocks they
+ *  allocate meanwhile are kept, and the step that ends tracing stops the
+ *  world once more to rescan the roots and every marked block, so pointers
+ *  stored while tracing was under way are not missed. Each step makes some
+ *  progress even with a zero budget.
+ *
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator (initialised on first use).
+ *  @param[in]  budget_us Time budget of the step, in microseconds.
+ *
+ *  @return EXIT_SUCCESS while the cycle is in progress,
+ *          MEM_GC_CYCLE_DONE when this step completed it,
+ *          negative error code on failure.
+ *
+ *  @retval -ENOMEM:  The mark bitmaps or the mmap index could not be grown.
+ *  @retval -EBUSY:   The GC thread is collecting a fork() snapshot.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_gcStep(mem_allocator_t *const allocator,
+                                 const uint32_t         budget_us);
+
+/** ============================================================================
+ *  @brief  Makes allocations pay for incremental collection work.
+ *
+ *  While a cycle started by MEM_gcStep() is in progress, every allocation
+ *  through the MEM_alloc*() family adds its size to a debt; once the debt
+ *  reaches 64 KiB the allocating thread runs a step of
+ *  debt * @p us_per_mib / 1 MiB microseconds. Idle allocators pay nothing.
+ *
+ *  @param[in]  allocator  Memory allocator context, or NULL for the global
+ *                         allocator (initialised on first use).
+ *  @param[in]  us_per_mib Step time charged per MiB allocated; 0 disables
+ *                         mutator assists.
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_gcSetAssist(mem_allocator_t *const allocator,
+                                      const uint32_t         us_per_mib);
+
+/** ============================================================================
+ *  @brief  Marks GC thread cycles in a fork()ed child process.
+ *
+ *  When enabled, each cycle of the GC thread stops the world only for a
+ *  fork(). The child marks the copy-on-write snapshot of the heap it
+ *  inherited and reports the unreachable blocks through shared memory,
+ *  while the parent's threads keep running; the GC thread then frees them
+ *  in short slices. Blocks the program frees or allocates in the meantime
+ *  are left alone. A cycle whose fork() fails is marked in process.
+ *
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator (initialised on first use).
+ *  @param[in]  enable    true to mark in a child process, false to mark in
+ *                        the calling process.
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_gcSetSnapshot(mem_allocator_t *const allocator,
+                                        const bool             enable);
+
+/** ============================================================================
+ *  @brief  Makes GC thread cycles generational.
+ *
+ *  Blocks that survive a collection keep their mark and become old. Minor
+ *  cycles trace from the roots and from the old blocks on pages written
+ *  since the last cycle (all old blocks when the kernel lacks soft-dirty
+ *  tracking) and sweep only the blocks allocated since then. After every
+ *  @p full_every minor cycles, a full collection runs. Calling this function
+ *  forces the next cycle to be a full one.
+ *
+ *  @param[in]  allocator  Memory allocator context, or NULL for the global
+ *                         allocator (initialised on first use).
+ *  @param[in]  full_every Minor cycles between full ones; 0 disables
+ *                         generational collection.
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_gcSetGenerational(mem_allocator_t *const allocator,
+                                            const uint32_t         full_every);
+
+/** ============================================================================
+ *  @brief  Makes allocations sweep the heap after GC thread cycles.
+ *
+ *  When enabled, the GC thread only marks; each later heap allocation
+ *  sweeps a small part of the heap, and more of it while no free block
+ *  fits the request, before the heap is grown. Sweeping cost is spread
+ *  over allocations and dead blocks are reclaimed where memory is needed.
+ *  Whatever is left unswept is finished by the GC thread before its next
+ *  cycle. Generational and fork()-snapshot cycles sweep as before.
+ *
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator (initialised on first use).
+ *  @param[in]  enable    true to sweep on allocation, false to sweep in the
+ *                        GC thread.
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_gcSetLazySweep(mem_allocator_t *const allocator,
+                                         const bool             enable);
+
+/** ============================================================================
+ *  @brief  Allows or forbids soft-dirty page tracking in GC cycles.
+ *
+ *  Tracking is allowed by default and used where the kernel supports it:
+ *  GC thread cycles then mark while mutators run and only rescan the pages
+ *  written meanwhile, and generational cycles use the written pages as
+ *  their remembered set. Forbidding it makes the GC thread run
+ *  stop-the-world cycles and remarks rescan every marked block. The
+ *  setting applies from the next cycle.
+ *
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator (initialised on first use).
+ *  @param[in]  enable    true to use soft-dirty tracking when available,
+ *                        false to never use it.
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ *
+ *  @retval -ENOTSUP: @p enable is true but the kernel does not report
+ *                    soft-dirty pages; the setting is stored anyway.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_gcSetDirtyTracking(
+  mem_allocator_t *const allocator,
+  const bool             enable);
+
+/** ============================================================================
+ *  @brief  Sets the allocation volume that triggers a GC thread cycle.
+ *
+ *  Like GOGC: the GC thread starts a cycle once the bytes allocated since
+ *  the last one reach @p percent of the bytes that cycle left live (never
+ *  less than 4 MiB). Independently, it runs timed cycles whose interval
+ *  doubles, up to 2 s, while nothing is allocated. The default is 100.
+ *
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator (initialised on first use).
+ *  @param[in]  percent   Heap growth, in percent of the live heap, that
+ *                        triggers a cycle; 0 leaves only timed cycles.
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_gcSetRatio(mem_allocator_t *const allocator,
+                                     const uint32_t         percent);
+
+/** ============================================================================
+ *  @brief  Runs a full collection and waits for it to complete.
+ *
+ *  With the GC thread running, wakes it for a full cycle and waits until
+ *  that cycle and its sweep are done. Otherwise the collection runs on the
+ *  calling thread.
+ *
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator (initialised on first use).
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ *
+ *  @retval -ENOMEM:  The mark bitmaps could not be grown.
+ *  @retval -EBUSY:   The GC thread is collecting a fork() snapshot.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_gcCollect(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Reads the garbage collector cycle metrics.
+ *
+ *  Every completed cycle, whichever way it ran, records its phase times,
+ *  stop-the-world pauses, scan and sweep counters and live heap before and
+ *  after, and logs them as one info line. Takes the collector lock, so the
+ *  call waits for a stop-the-world phase in progress.
+ *
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator (initialised on first use).
+ *  @param[out] stats     Destination snapshot.
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ *
+ *  @retval -EINVAL:  @p stats is NULL.
+ * ========================================================================== */
+__LIBMEMALLOC_API int MEM_getGcStats(mem_allocator_t *const allocator,
+                                     mem_gc_stats_t *const  stats);
+
 #endif
 
 /*< C++ Compatibility >*/
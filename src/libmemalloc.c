@@ -93,11 +93,20 @@
 #include "logs.h"
 
 /*< Dependencies >*/
+#include <fcntl.h>
 #include <inttypes.h>
+#include <limits.h>
+#include <link.h>
+#include <poll.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <signal.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <sys/mman.h>
 #include <sys/resource.h>
+#include <sys/wait.h>
+#include <ucontext.h>
 
 #if defined(__linux__) || defined(__unix__) || defined(__APPLE__)
   #if __has_include(<valgrind/memcheck.h>)
@@ -213,15 +222,263 @@
 #define MIN_BLOCK_SIZE  (size_t)(sizeof(block_header_t) + ARCH_ALIGNMENT)
 
 /** ============================================================================
- *  @def        NR_OBJS
- *  @brief      Number of iterations used to scale GC sleep duration
+ *  @def        HANDLE_PREFIX
+ *  @brief      Payload bytes reserved in front of a movable allocation.
  *
- *  @details    Specifies the multiplier applied to the base GC interval
- *              (in milliseconds) to compute the actual sleep time between
- *              successive garbage-collection cycles:
- *                  sleep_time = gc_interval_ms * NR_OBJS
+ *  @details    The first payload word of a block allocated by MEM_hAlloc()
+ *              holds its handle, so the compactor can map a block back to
+ *              its slot. MEM_hLock() returns the payload past this prefix.
  * ========================================================================== */
-#define NR_OBJS         (uint16_t)(1000U)
+#define HANDLE_PREFIX   (size_t)(ALIGN(sizeof(uintptr_t)))
+
+/** ============================================================================
+ *  @def        GC_RATIO_DEFAULT
+ *  @brief      Default heap growth, in percent of the live heap, that
+ *              triggers a GC cycle.
+ *
+ *  @details    The GC thread starts a cycle once the bytes allocated since
+ *              the last one reach this share of the bytes it left live.
+ *              At 100, the heap may double between collections.
+ * ========================================================================== */
+#define GC_RATIO_DEFAULT (uint32_t)(100U)
+
+/** ============================================================================
+ *  @def        GC_MIN_TRIGGER
+ *  @brief      Smallest allocation volume, in bytes, that triggers a cycle.
+ *
+ *  @details    Keeps a small live heap from being collected every few
+ *              allocations.
+ * ========================================================================== */
+#define GC_MIN_TRIGGER   (size_t)(4U * 1024U * 1024U)
+
+/** ============================================================================
+ *  @def        GC_IDLE_MAX_MS
+ *  @brief      Longest wait, in milliseconds, between GC cycles.
+ *
+ *  @details    While nothing is allocated, the wait between timed cycles
+ *              doubles from gc_interval_ms up to this value.
+ * ========================================================================== */
+#define GC_IDLE_MAX_MS   (uint32_t)(2000U)
+
+/** ============================================================================
+ *  @def        GC_MARK_STACK_INIT
+ *  @brief      Initial capacity, in entries, of the GC mark stack.
+ * ========================================================================== */
+#define GC_MARK_STACK_INIT (size_t)(4096U)
+
+/** ============================================================================
+ *  @def        GC_MARK_STACK_MAX
+ *  @brief      Capacity, in entries, beyond which the mark stack overflows.
+ *
+ *  @details    Once full, newly marked blocks are not pushed; marking then
+ *              falls back to rescanning every marked block.
+ * ========================================================================== */
+#define GC_MARK_STACK_MAX  (size_t)(1U << 20U)
+
+/** ============================================================================
+ *  @def        GC_GRANULE
+ *  @brief      Heap bytes covered by one bit of the GC mark bitmap.
+ *
+ *  @details    Block headers are ARCH_ALIGNMENT aligned, so each header maps
+ *              to a distinct bit.
+ * ========================================================================== */
+#define GC_GRANULE         (size_t)(ARCH_ALIGNMENT)
+
+/** ============================================================================
+ *  @def        GC_BITS_PER_WORD
+ *  @brief      Number of mark bits per bitmap word.
+ * ========================================================================== */
+#define GC_BITS_PER_WORD   (size_t)(64U)
+
+/** ============================================================================
+ *  @def        GC_STEAL_BATCH
+ *  @brief      Maximum number of mark stack entries taken in one steal.
+ * ========================================================================== */
+#define GC_STEAL_BATCH     (size_t)(64U)
+
+/** ============================================================================
+ *  @def        GC_STEP_CHECK
+ *  @brief      Blocks traced by MEM_gcStep() between two clock reads.
+ * ========================================================================== */
+#define GC_STEP_CHECK      (size_t)(64U)
+
+/** ============================================================================
+ *  @def        GC_SWEEP_CHUNK
+ *  @brief      Bitmap words swept by MEM_gcStep() between two clock reads.
+ * ========================================================================== */
+#define GC_SWEEP_CHUNK     (size_t)(16U)
+
+/** ============================================================================
+ *  @def        GC_BLACKLIST_PAGE
+ *  @brief      Heap bytes covered by one bit of the GC blacklist.
+ * ========================================================================== */
+#define GC_BLACKLIST_PAGE  (size_t)(4096U)
+
+/** ============================================================================
+ *  @def        GC_BLACKLIST_SLACK
+ *  @brief      Bytes past the heap end still recorded by the GC blacklist.
+ *
+ *  @details    The heap grows into this range, so false pointers into it
+ *              are remembered before any block is placed there.
+ * ========================================================================== */
+#define GC_BLACKLIST_SLACK (size_t)(1024U * 1024U)
+
+/** ============================================================================
+ *  @def        GC_BLACKLIST_GROW
+ *  @brief      Heap growth per cycle allowed to avoid blacklisted pages.
+ *
+ *  @details    Past it, blocks are placed on blacklisted pages again until
+ *              the next cycle rebuilds the blacklist.
+ * ========================================================================== */
+#define GC_BLACKLIST_GROW  (size_t)(1024U * 1024U)
+
+/** ============================================================================
+ *  @def        GC_SCAN_LANES
+ *  @brief      Words range-checked together by MEM_gcScanRange().
+ * ========================================================================== */
+#define GC_SCAN_LANES      (size_t)(4U)
+
+/** ============================================================================
+ *  @def        GC_ASSIST_QUANTUM
+ *  @brief      Allocation debt, in bytes, that triggers a mutator assist.
+ * ========================================================================== */
+#define GC_ASSIST_QUANTUM  (size_t)(64U * 1024U)
+
+/** ============================================================================
+ *  @def        GC_SLICE_US
+ *  @brief      Step budget of the GC thread between two gc_lock releases.
+ * ========================================================================== */
+#define GC_SLICE_US        (uint32_t)(1000U)
+
+/** ============================================================================
+ *  @def        GC_PAGEMAP_CHUNK
+ *  @brief      Pagemap entries read per pread() during the remark.
+ * ========================================================================== */
+#define GC_PAGEMAP_CHUNK   (size_t)(256U)
+
+/** ============================================================================
+ *  @def        GC_PM_SOFT_DIRTY
+ *  @brief      Soft-dirty bit of a /proc/self/pagemap entry.
+ * ========================================================================== */
+#define GC_PM_SOFT_DIRTY   (uint64_t)(1ULL << 55U)
+
+/** ============================================================================
+ *  @def        GC_SNAP_MAX_MAPS
+ *  @brief      Unreachable mmap blocks a snapshot child reports per cycle.
+ * ========================================================================== */
+#define GC_SNAP_MAX_MAPS   (size_t)(1024U)
+
+/** ============================================================================
+ *  @def        GC_MAX_ROOT_RANGES
+ *  @brief      Maximum number of writable segments scanned as GC roots.
+ * ========================================================================== */
+#define GC_MAX_ROOT_RANGES (uint16_t)(256U)
+
+/** ============================================================================
+ *  @def        GC_SUSPEND_SIGNAL
+ *  @brief      Signal that parks registered threads during marking.
+ * ========================================================================== */
+#if defined(SIGPWR)
+  #define GC_SUSPEND_SIGNAL SIGPWR
+#else
+  #define GC_SUSPEND_SIGNAL SIGUSR1
+#endif
+
+/** ============================================================================
+ *  @def        GC_RESTART_SIGNAL
+ *  @brief      Signal that wakes parked threads once marking is done.
+ * ========================================================================== */
+#if defined(SIGXCPU)
+  #define GC_RESTART_SIGNAL SIGXCPU
+#else
+  #define GC_RESTART_SIGNAL SIGUSR2
+#endif
+
+/** ============================================================================
+ *  @def        MEM_TAG_SHARDS
+ *  @brief      Number of per-thread counter shards kept for each tag.
+ *
+ *  @details    Threads are assigned a shard round-robin on their first
+ *              tagged operation; each shard lives on its own cache line so
+ *              concurrent updates never share a line.
+ * ========================================================================== */
+#define MEM_TAG_SHARDS  (uint8_t)(16U)
+
+/** ============================================================================
+ *  @def        NSEC_PER_SEC
+ *  @brief      Nanoseconds per second, used for rate computations.
+ * ========================================================================== */
+#define NSEC_PER_SEC    (uint64_t)(1000000000ULL)
+
+/** ============================================================================
+ *  @def        NSEC_PER_MSEC
+ *  @brief      Nanoseconds per millisecond.
+ * ========================================================================== */
+#define NSEC_PER_MSEC   (uint64_t)(1000000ULL)
+
+/** ============================================================================
+ *  @def        NSEC_PER_USEC
+ *  @brief      Nanoseconds per microsecond.
+ * ========================================================================== */
+#define NSEC_PER_USEC   (uint64_t)(1000ULL)
+
+/** ============================================================================
+ *  @def        CGROUP_ROOT
+ *  @brief      Mount point of the cgroup v2 unified hierarchy.
+ * ========================================================================== */
+#define CGROUP_ROOT       "/sys/fs/cgroup"
+
+/** ============================================================================
+ *  @def        CGROUP_SOFT_PCT
+ *  @brief      Soft footprint limit, in percent of memory.max.
+ * ========================================================================== */
+#define CGROUP_SOFT_PCT   (size_t)(80U)
+
+/** ============================================================================
+ *  @def        CGROUP_HARD_PCT
+ *  @brief      Hard footprint limit, in percent of memory.max.
+ * ========================================================================== */
+#define CGROUP_HARD_PCT   (size_t)(95U)
+
+/** ============================================================================
+ *  @def        CGROUP_BUSY_PCT
+ *  @brief      memory.current level (percent of memory.max) from which the
+ *              GC and scavenger run at twice their idle cadence.
+ * ========================================================================== */
+#define CGROUP_BUSY_PCT   (size_t)(50U)
+
+/** ============================================================================
+ *  @def        CGROUP_CACHE_DIV
+ *  @brief      Divisor of memory.max giving the suggested cache budget.
+ * ========================================================================== */
+#define CGROUP_CACHE_DIV  (size_t)(8U)
+
+/** ============================================================================
+ *  @def        CGROUP_REFRESH_MS
+ *  @brief      Idle cgroup refresh period, in milliseconds.
+ *
+ *  @details    Divided by 4 when memory.current is above CGROUP_BUSY_PCT and
+ *              by 20 when above CGROUP_SOFT_PCT.
+ * ========================================================================== */
+#define CGROUP_REFRESH_MS (uint32_t)(1000U)
+
+/** ============================================================================
+ *  @def        PSI_MEMORY_PATH
+ *  @brief      System-wide memory pressure-stall file.
+ * ========================================================================== */
+#define PSI_MEMORY_PATH   "/proc/pressure/memory"
+
+/** ============================================================================
+ *  @def        CLEAR_REFS_PATH
+ *  @brief      File whose "4" command clears the soft-dirty bits.
+ * ========================================================================== */
+#define CLEAR_REFS_PATH   "/proc/self/clear_refs"
+
+/** ============================================================================
+ *  @def        PAGEMAP_PATH
+ *  @brief      Per-page flags of the process, one 64-bit entry per page.
+ * ========================================================================== */
+#define PAGEMAP_PATH      "/proc/self/pagemap"
 
 /** ============================================================================
  *              P R I V A T E  T Y P E S  D E F I N I T I O N
@@ -241,6 +498,8 @@
  *    @li @b size     – Total block size (includes header, data, and canary)
  *    @li @b free     – 1 if block is free, 0 if allocated
  *    @li @b marked   – Garbage collector mark flag
+ *    @li @b tag      – Accounting tag charged for the block
+ *    @li @b layout   – Pointer layout of the payload (MEM_LAYOUT_*)
  *    @li @b file     – Source file of allocation (for debugging)
  *    @li @b line     – Line number of allocation (for debugging)
  *    @li @b canary   – Canary value for buffer-overflow detection
@@ -257,6 +516,9 @@ typedef struct __ALIGN BlockHeader
   uint32_t free;    /**< 1 if block is free, 0 if allocated */
   uint32_t marked;  /**< Garbage collector mark flag */
 
+  uint32_t tag;     /**< Accounting tag charged for the block */
+  uint32_t layout;  /**< Pointer layout of the payload (MEM_LAYOUT_*) */
+
   const char *file; /**< Source file of allocation (for debugging) */
   uint64_t    line; /**< Line number of allocation (for debugging) */
 
@@ -275,14 +537,15 @@ typedef struct __ALIGN BlockHeader
  *  @brief      Represents a memory arena with its own free lists.
  *
  *  @details    This structure manages a group of free lists (bins)
- *              and tracks the top chunk in the heap for allocation
- *              strategies like top chunk extension. Each arena can
- *              hold multiple size classes to optimize allocation
- *              and minimize fragmentation.
+ *              and tracks the top chunk of the heap, so a block appended
+ *              by a heap growth is linked to its physical predecessor.
+ *              Each arena can hold multiple size classes to optimize
+ *              allocation and minimize fragmentation.
  *
  *  @par Fields:
  *    @li @b bins      – Array of free lists (one per size class)
- *    @li @b top_chunk – Top free block in the heap (for fast extension)
+ *    @li @b top_chunk – Physically last heap block, free or not (NULL when
+ *                       unknown)
  *    @li @b num_bins  – Number of size classes (bins) managed by this arena
  * ========================================================================== */
 typedef struct __ALIGN MemArena
@@ -353,140 +616,874 @@ typedef struct __ALIGN GcThread
 } gc_thread_t;
 
 /** ============================================================================
- *  @struct     mem_allocator_t
- *  @brief      Manages dynamic memory allocation.
- *
- *  @details    This structure manages the heap, including free
- *              lists for memory blocks, garbage collection, and
- *              allocation strategies.
+ *  @struct     gc_mark_stack_t
+ *  @brief      Explicit stack of marked blocks whose payload is unscanned.
  *
  *  @par Fields:
- *    @li @b heap_start       – Base of the user heap region
- *    @li @b heap_end         – Current end of the heap
- *    @li @b metadata_size    – Bytes reserved for bins and arenas
- *    @li @b stack_top        – Upper bound of application stack
- *    @li @b stack_bottom     – Lower bound of application stack
- *    @li @b last_allocated   – Last block returned (NEXT_FIT)
- *    @li @b num_size_classes – Total size classes available
- *    @li @b num_arenas       – Number of arena partitions
- *    @li @b arenas           – Array of arena metadata
- *    @li @b mmap_list        – Linked list of mmap’d regions
- *    @li @b free_lists       – Segregated free lists by size class
- *    @li @b last_brk_start   – Start address of the last sbrk(+) lease
- *    @li @b last_brk_end     – End (exclusive) of the last sbrk(+) lease
- *    @li @b gc_thread        – Garbage collector controller
+ *    @li @b items    – Stack storage (own anonymous mapping)
+ *    @li @b len      – Number of pending entries
+ *    @li @b cap      – Capacity of @b items, in entries
+ *    @li @b overflow – An entry was dropped because the stack was full
+ *    @li @b busy     – Spin lock held by the owner or a stealing worker
+ *    @li @b scanned  – Bytes scanned by the owner this cycle
+ *    @li @b marked   – Blocks marked by the owner this cycle
  * ========================================================================== */
-typedef struct __ALIGN MemoryAllocator
+typedef struct GcMarkStack
 {
-  uint8_t *heap_start;             /**< Base of the user heap region */
-  uint8_t *heap_end;               /**< Current end of the heap */
-
-  size_t metadata_size;            /**< Bytes reserved for bins and arenas */
+  block_header_t **items;    /**< Stack storage */
+  size_t           len;      /**< Pending entries */
+  size_t           cap;      /**< Capacity, in entries */
+  bool             overflow; /**< An entry was dropped */
+  _Atomic bool     busy;     /**< Spin lock */
+  uint64_t         scanned;  /**< Bytes scanned this cycle */
+  uint64_t         marked;   /**< Blocks marked this cycle */
+} gc_mark_stack_t;
 
-  uintptr_t *stack_top;            /**< Upper bound of application stack */
-  uintptr_t *stack_bottom;         /**< Lower bound of application stack */
-
-  size_t num_size_classes;         /**< Total size classes available */
-  size_t num_arenas;               /**< Number of arena partitions */
-
-  block_header_t  *last_allocated; /**< Last block returned (NEXT_FIT) */
-  block_header_t **free_lists;     /**< Segregated free lists by size class */
-
-  mem_arena_t *arenas;             /**< Array of arena metadata */
-  mmap_t      *mmap_list;          /**< Linked list of mmap’d regions */
-
-  uint8_t *last_brk_start; /**< Start address of the last sbrk(+) lease */
-  uint8_t *last_brk_end;   /**< End (exclusive) of the last sbrk(+) lease */
+/** ============================================================================
+ *  @enum       gc_phase_t
+ *  @brief      Work handed to the GC worker pool.
+ * ========================================================================== */
+typedef enum GcPhase
+{
+  GC_PHASE_MARK  = (uint8_t)(0u), /**< Trace, stealing from other stacks */
+  GC_PHASE_SWEEP = (uint8_t)(1u)  /**< Collect dead blocks of a partition */
+} gc_phase_t;
 
-  gc_thread_t gc_thread;   /**< Garbage collector controller */
-} mem_allocator_t;
+/** ============================================================================
+ *  @struct     gc_worker_t
+ *  @brief      Parallel mark/sweep worker; worker 0 is the collector itself.
+ *
+ *  @par Fields:
+ *    @li @b stack     – Own mark stack, stolen from by idle workers
+ *    @li @b thread    – Pool thread (unused for worker 0)
+ *    @li @b allocator – Owning allocator
+ *    @li @b id        – Index in the pool
+ *    @li @b seen      – Pool generation when the thread was created
+ *    @li @b first     – First bitmap word of the sweep partition
+ *    @li @b last      – One past the last bitmap word of the partition
+ * ========================================================================== */
+typedef struct __attribute__((aligned(CACHE_LINE_SIZE))) GcWorker
+{
+  gc_mark_stack_t         stack;     /**< Own mark stack */
+  pthread_t               thread;    /**< Pool thread */
+  struct MemoryAllocator *allocator; /**< Owning allocator */
+  uint32_t                id;        /**< Index in the pool */
+  uint32_t                seen;      /**< Generation at creation */
+  size_t                  first;     /**< First sweep bitmap word */
+  size_t                  last;      /**< One past the last sweep word */
+} gc_worker_t;
 
 /** ============================================================================
- *  @typedef  find_fn_t
- *  @brief    Type for functions that locate a suitable free block.
+ *  @struct     gc_pool_t
+ *  @brief      Parallel mark/sweep worker pool.
  *
- *  @param [in]  allocator  Memory allocator context in which to search.
- *  @param [in]  size       Total size requested (including header and canary).
- *  @param [out] block      Address of pointer to store the found block header.
+ *  @details    Workers 1..num_workers-1 are threads created before a cycle
+ *              and parked on @b wake; each phase the collector bumps
+ *              @b generation and works as worker 0. Pool threads are never
+ *              registered as roots, so they keep running while the world
+ *              is stopped, and they take no lock a mutator may hold.
  *
- *  @return Integer
+ *  @par Fields:
+ *    @li @b workers     – Worker slots
+ *    @li @b num_workers – Configured worker count (0: not resolved yet)
+ *    @li @b num_started – Pool threads created
+ *    @li @b active      – Workers taking part in the current cycle
+ *    @li @b done        – Pool threads done with the current phase
+ *    @li @b generation  – Phase counter pool threads wait on
+ *    @li @b phase       – Work of the current phase
+ *    @li @b idle        – Workers out of mark work (termination)
+ *    @li @b exit        – Pool threads must exit
+ *    @li @b ready       – @b lock and the conditions are initialised
+ *    @li @b lock        – Protects the phase fields
+ *    @li @b wake        – Signalled when a phase starts or on exit
+ *    @li @b finished    – Signalled when the last pool thread is done
  * ========================================================================== */
-typedef int (*find_fn_t)(mem_allocator_t *const,
-                         const size_t,
-                         block_header_t **);
+typedef struct GcPool
+{
+  gc_worker_t      workers[MEM_GC_MAX_WORKERS]; /**< Worker slots */
+  uint32_t         num_workers;                 /**< Configured workers */
+  uint32_t         num_started;                 /**< Pool threads created */
+  uint32_t         active;                      /**< Workers this cycle */
+  uint32_t         done;                        /**< Threads done */
+  uint32_t         generation;                  /**< Phase counter */
+  gc_phase_t       phase;                       /**< Current phase */
+  _Atomic uint32_t idle;                        /**< Idle mark workers */
+  bool             exit;                        /**< Threads must exit */
+  bool             ready;                       /**< Primitives ready */
+  pthread_mutex_t  lock;                        /**< Phase lock */
+  pthread_cond_t   wake;                        /**< Phase start / exit */
+  pthread_cond_t   finished;                    /**< Phase done */
+} gc_pool_t;
 
 /** ============================================================================
- *          P R I V A T E  F U N C T I O N S  P R O T O T Y P E S
+ *  @enum       gc_incr_phase_t
+ *  @brief      Progress of an incremental collection driven by MEM_gcStep().
  * ========================================================================== */
+typedef enum GcIncrPhase
+{
+  GC_INCR_IDLE  = (uint8_t)(0u), /**< No cycle in progress */
+  GC_INCR_MARK  = (uint8_t)(1u), /**< Tracing from the mark stack */
+  GC_INCR_SWEEP = (uint8_t)(2u)  /**< Sweeping the heap bitmap */
+} gc_incr_phase_t;
 
 /** ============================================================================
- *  @brief  Invokes sbrk-like behavior by moving the program break.
- *
- *  This function reads the current program break, attempts to move it by the
- *  signed offset @p increment via sbrk(), and returns the original break on
- *  success.  If any call to sbrk() or reading the break fails, it encodes the
- *  negative errno into a pointer via PTR_ERR.
+ *  @enum       gc_dirty_t
+ *  @brief      Availability of soft-dirty page tracking.
+ * ========================================================================== */
+typedef enum GcDirty
+{
+  GC_DIRTY_UNPROBED = (uint8_t)(0u), /**< Not probed yet */
+  GC_DIRTY_NONE     = (uint8_t)(1u), /**< Kernel lacks soft-dirty bits */
+  GC_DIRTY_SOFT     = (uint8_t)(2u)  /**< clear_refs and pagemap work */
+} gc_dirty_t;
+
+/** ============================================================================
+ *  @struct     gc_incr_t
+ *  @brief      State of the incremental collector.
+ *
+ *  @details    Outside GC_INCR_IDLE, MEM_gcTrack() keeps start_bits and the
+ *              mmap index exact as mutators allocate and free, and marks
+ *              new blocks, so work left on the mark stack or in the bitmap
+ *              stays valid between steps. With @b tracking set, the pages
+ *              mutators write during tracing are flagged soft-dirty and the
+ *              remark rescans only those. With @b lazy set, the GC thread
+ *              leaves the heap in GC_INCR_SWEEP after marking and
+ *              allocations sweep it (MEM_gcLazySweep()).
  *
- *  @param[in]  increment Signed offset in bytes to move the program break:
- *                        positive to grow, negative to shrink.
+ *  @par Fields:
+ *    @li @b phase      – Current phase
+ *    @li @b sweep_word – Next bitmap word to sweep
+ *    @li @b assist     – Assist step time per MiB allocated (0: off)
+ *    @li @b debt       – Bytes allocated since the last assist
+ *    @li @b dirty      – Soft-dirty tracking availability
+ *    @li @b dirty_off  – Tracking forbidden by MEM_gcSetDirtyTracking()
+ *    @li @b tracking   – Soft-dirty bits were cleared when the cycle began
+ *    @li @b lazy       – GC thread cycles are swept by allocations
+ * ========================================================================== */
+typedef struct GcIncr
+{
+  gc_incr_phase_t phase;      /**< Current phase */
+  size_t          sweep_word; /**< Next bitmap word to sweep */
+  uint32_t        assist;     /**< Assist microseconds per MiB */
+  size_t          debt;       /**< Bytes allocated since last assist */
+  gc_dirty_t      dirty;      /**< Soft-dirty availability */
+  bool            dirty_off;  /**< Tracking forbidden by the user */
+  bool            tracking;   /**< Dirty pages tracked this cycle */
+  bool            lazy;       /**< Sweep on allocation */
+} gc_incr_t;
+
+/** ============================================================================
+ *  @struct     gc_gen_t
+ *  @brief      State of the generational collector.
  *
- *  @return Original program break address on success;
- *          an error-encoded pointer (via PTR_ERR()) on failure.
+ *  @details    Marks are sticky: after a collection, the marked blocks are
+ *              the old generation. While @b valid, MEM_gcTrack() keeps
+ *              start_bits exact between collections, clears the mark of
+ *              every new block, which is young until it survives one, and
+ *              widens the young word range swept by MEM_gcMinor().
  *
- *  @retval ret>-1:   Previous break on success.
- *  @retval -ENOMEM:  Failed to read or adjust the break.
+ *  @par Fields:
+ *    @li @b full_every – Minor collections between full ones (0: off)
+ *    @li @b minors     – Minor collections since the last full one
+ *    @li @b valid      – Marks and start_bits describe the heap
+ *    @li @b tracking   – Soft-dirty bits serve as the remembered set
+ *    @li @b young_lo   – First bitmap word allocated into since the last
+ *                        collection
+ *    @li @b young_hi   – One past the last such word
  * ========================================================================== */
-void *MEM_sbrk(const intptr_t increment);
+typedef struct GcGen
+{
+  uint32_t full_every; /**< Minor collections between full ones */
+  uint32_t minors;     /**< Minor collections since the last full one */
+  bool     valid;      /**< Marks describe the old generation */
+  bool     tracking;   /**< Soft-dirty remembered set in use */
+  size_t   young_lo;   /**< First young bitmap word */
+  size_t   young_hi;   /**< One past the last young bitmap word */
+} gc_gen_t;
 
 /** ============================================================================
- *  @brief  Calculates the size class index for a requested memory size.
+ *  @struct     gc_pace_t
+ *  @brief      Scheduling state of the GC thread.
  *
- *  This function determines which size class the given allocation request
- *  belongs to by dividing the requested @p size by BYTES_PER_CLASS (rounding
- *  up). If the computed index exceeds the maximum available class, it will
- *  be clamped to the highest class and a warning emitted.
+ *  @details    Every field is protected by gc_lock. The allocator charges
+ *              each allocation to @b allocated and wakes the GC thread once
+ *              it reaches @b trigger; otherwise the thread wakes after
+ *              @b idle_ms, which backs off while nothing is allocated.
  *
- *  @param[in]  allocator Pointer to the allocator context.
- *  @param[in]  size  Requested memory size in bytes (must be > 0).
+ *  @par Fields:
+ *    @li @b ratio      – Heap growth, in percent, that triggers a cycle
+ *                        (0: timed cycles only)
+ *    @li @b idle_ms    – Current wait before a timed cycle
+ *    @li @b allocated  – Bytes allocated since the last cycle
+ *    @li @b trigger    – Value of @b allocated that starts a cycle
+ *    @li @b live_bytes – Live payload bytes after the last cycle
+ *    @li @b started    – Cycles started by the GC thread
+ *    @li @b cycles     – Cycles completed by the GC thread
+ *    @li @b requested  – MEM_gcCollect() waits for the next cycle
+ *    @li @b done       – Broadcast when a cycle completes
+ * ========================================================================== */
+typedef struct GcPace
+{
+  uint32_t ratio;      /**< Heap growth that triggers a cycle (%) */
+  uint32_t idle_ms;    /**< Current wait before a timed cycle */
+  size_t   allocated;  /**< Bytes allocated since the last cycle */
+  size_t   trigger;    /**< Allocated bytes that start a cycle */
+  size_t   live_bytes; /**< Live bytes after the last cycle */
+  uint64_t started;    /**< Cycles started */
+  uint64_t cycles;     /**< Cycles completed */
+  bool     requested;  /**< A collection was requested */
+
+  pthread_cond_t done; /**< Broadcast when a cycle completes */
+} gc_pace_t;
+
+/** ============================================================================
+ *  @struct     gc_stats_t
+ *  @brief      Metrics of the GC cycle in progress and of the recent ones.
  *
- *  @return On success, returns a non-negative integer size class index;
- *          on failure, returns a negative error code.
+ *  @details    Every field is protected by gc_lock. MEM_gcStatsBegin() opens
+ *              a cycle when marking starts and MEM_gcStatsEnd() records it
+ *              in @b ring once its sweep completes; a cycle abandoned in
+ *              between is dropped when the next one opens. Scan and mark
+ *              counters are kept in the workers' mark stacks and summed
+ *              when the cycle ends.
  *
- *  @retval ret>0:    Valid size class index.
- *  @retval -EINVAL:  @p allocator is NULL, or @p size is zero.
+ *  @par Fields:
+ *    @li @b ring         – Recent cycles, at seq modulo MEM_GC_STATS_RING
+ *    @li @b current      – Cycle in progress
+ *    @li @b cycles       – Cycles recorded
+ *    @li @b gc_ns        – Marking and sweeping time of all cycles
+ *    @li @b pause_ns     – Stop-the-world time of all cycles
+ *    @li @b max_pause_ns – Longest single stop of the world
+ *    @li @b start_ns     – Start of the cycle in progress
+ *    @li @b stop_ns      – Start of the current stop of the world
+ *    @li @b open         – A cycle is in progress
  * ========================================================================== */
-static int MEM_getSizeClass(mem_allocator_t *const allocator,
-                            const size_t           size);
+typedef struct GcStats
+{
+  mem_gc_cycle_t ring[MEM_GC_STATS_RING]; /**< Recent cycles */
+  mem_gc_cycle_t current;                 /**< Cycle in progress */
+
+  uint64_t cycles;       /**< Cycles recorded */
+  uint64_t gc_ns;        /**< Marking and sweeping time */
+  uint64_t pause_ns;     /**< Stop-the-world time */
+  uint64_t max_pause_ns; /**< Longest single stop */
+  uint64_t start_ns;     /**< Start of the cycle in progress */
+  uint64_t stop_ns;      /**< Start of the current stop */
+  bool     open;         /**< A cycle is in progress */
+} gc_stats_t;
 
 /** ============================================================================
- *  @brief  Initializes the memory allocator and its internal structures.
+ *  @struct     gc_snap_report_t
+ *  @brief      Result of a snapshot mark, written by the child process into
+ *              a shared mapping.
  *
- *  This function prepares the allocator’s heap by:
- *    - Reading and aligning the initial program break to ARCH_ALIGNMENT.
- *    - Allocating the arena array and free‐list bins via MEM_growUserHeap().
- *    - Zeroing out the free‐list bins.
- *    - Initializing the allocator fields (heap_start, heap_end, free_lists).
- *    - Setting up the garbage‐collector thread state and its mutex/cond.
- *    - Capturing the current thread’s stack bounds via MEM_stackBounds().
- *    - (If under Valgrind) creating a mempool for the allocator.
+ *  @par Fields:
+ *    @li @b complete – Set last, once the report is whole
+ *    @li @b num_maps – Entries used in @b maps
+ *    @li @b maps     – Unreachable mmap blocks
+ *    @li @b words    – Unreachable heap block starts, one bit per granule
+ * ========================================================================== */
+typedef struct GcSnapReport
+{
+  _Atomic bool    complete;               /**< Report is whole */
+  size_t          num_maps;               /**< Entries used in maps */
+  block_header_t *maps[GC_SNAP_MAX_MAPS]; /**< Unreachable mmap blocks */
+  uint64_t        words[];                /**< Unreachable heap starts */
+} gc_snap_report_t;
+
+/** ============================================================================
+ *  @struct     gc_snap_t
+ *  @brief      State of the fork()-snapshot collector.
  *
- *  @param[in]  allocator Pointer to a mem_allocator_t instance to initialize.
+ *  @details    A block unreachable in the snapshot stays unreachable, so
+ *              the parent may free what the child reports at any later
+ *              time, as long as no other collection frees it first: while
+ *              @b active, MEM_gcStep() returns -EBUSY.
  *
- *  @return Integer status code indicating initialization result.
+ *  @par Fields:
+ *    @li @b enabled    – GC thread marks fork() snapshots
+ *    @li @b active     – A snapshot cycle is in progress
+ *    @li @b child      – Marking child process
+ *    @li @b report     – Mapping shared with the child
+ *    @li @b size       – Bytes of the mapping
+ *    @li @b words      – Heap bitmap words in the report
+ *    @li @b sweep_word – Next report word to sweep
+ *    @li @b sweep_map  – Next report mmap block to sweep
+ * ========================================================================== */
+typedef struct GcSnap
+{
+  bool              enabled;    /**< GC thread marks snapshots */
+  bool              active;     /**< Snapshot cycle in progress */
+  pid_t             child;      /**< Marking child process */
+  gc_snap_report_t *report;     /**< Mapping shared with the child */
+  size_t            size;       /**< Bytes of the mapping */
+  size_t            words;      /**< Heap bitmap words in the report */
+  size_t            sweep_word; /**< Next report word to sweep */
+  size_t            sweep_map;  /**< Next report mmap block to sweep */
+} gc_snap_t;
+
+/** ============================================================================
+ *  @struct     gc_bitmap_t
+ *  @brief      Side table of per-granule GC bits for the sbrk heap.
  *
- *  @retval EXIT_SUCCESS: Allocator initialized successfully.
- *  @retval -EINVAL:      Invalid @p allocator pointer.
- *  @retval -ENOMEM:      Heap alignment or arena/bin allocation failed.
+ *  @par Fields:
+ *    @li @b words      – Bit storage (own anonymous mapping)
+ *    @li @b cap_words  – Capacity of @b words, in 64-bit words
+ *    @li @b used_words – Words covering the heap in the current cycle
+ *    @li @b base       – Heap address of bit 0
  * ========================================================================== */
-static int MEM_allocatorInit(mem_allocator_t *const allocator);
+typedef struct GcBitmap
+{
+  uint64_t *words;      /**< Bit storage */
+  size_t    cap_words;  /**< Capacity, in words */
+  size_t    used_words; /**< Words in use this cycle */
+  uintptr_t base;       /**< Heap address of bit 0 */
+} gc_bitmap_t;
 
 /** ============================================================================
- *  @brief  Validates the integrity and boundaries of a memory block.
+ *  @struct     gc_blacklist_t
+ *  @brief      Heap pages referenced by false pointers.
+ *
+ *  @details    While marking, a scanned word that points into the heap (or
+ *              up to GC_BLACKLIST_SLACK past its end) without hitting an
+ *              allocated block sets the bit of its GC_BLACKLIST_PAGE page.
+ *              A block placed there later would be kept alive by that
+ *              word, so the free-list searches pass over blocks whose
+ *              payload touches a page set in either of the last two
+ *              cycles. Cycle starts swap @b pages and clear the new current
+ *              table. Bits are set with atomics by the mark workers; the
+ *              rest is protected by gc_lock.
  *
- *  This function ensures that the specified @p block lies within the
- * allocator’s heap or one of its mmap regions, that its header canary matches
- * the expected magic value to detect metadata corruption, that its data canary
- * is intact to catch buffer overruns, and that the block’s size does not extend
+ *  @par Fields:
+ *    @li @b pages   – Page bits of the current and previous cycles
+ *    @li @b current – Index in @b pages written by this cycle
+ *    @li @b grown   – Heap bytes grown this cycle to avoid the blacklist
+ *    @li @b bypass  – Searches ignore the blacklist
+ *    @li @b skipped – The current allocation passed over a block
+ *    @li @b hits    – False pointers recorded
+ *    @li @b avoided – Free blocks passed over by the searches
+ * ========================================================================== */
+typedef struct GcBlacklist
+{
+  gc_bitmap_t pages[2u]; /**< Current and previous page bits */
+  uint32_t    current;   /**< Table written by this cycle */
+  size_t      grown;     /**< Heap grown to avoid the blacklist */
+  bool        bypass;    /**< Searches ignore the blacklist */
+  bool        skipped;   /**< Current allocation passed over a block */
+
+  _Atomic uint64_t hits;    /**< False pointers recorded */
+  uint64_t         avoided; /**< Free blocks passed over */
+} gc_blacklist_t;
+
+/** ============================================================================
+ *  @struct     gc_map_range_t
+ *  @brief      Payload range of a live mmap block in the GC lookup index.
+ * ========================================================================== */
+typedef struct GcMapRange
+{
+  uintptr_t       start; /**< First payload byte */
+  uintptr_t       end;   /**< One past the last payload byte */
+  block_header_t *block; /**< Block header */
+} gc_map_range_t;
+
+/** ============================================================================
+ *  @struct     gc_map_index_t
+ *  @brief      mmap blocks sorted by address for binary search.
+ * ========================================================================== */
+typedef struct GcMapIndex
+{
+  gc_map_range_t *ranges; /**< Sorted ranges (own anonymous mapping) */
+  size_t          len;    /**< Valid entries */
+  size_t          cap;    /**< Capacity, in entries */
+} gc_map_index_t;
+
+/** ============================================================================
+ *  @struct     gc_scan_window_t
+ *  @brief      Address windows a scanned word must fall in to be looked up.
+ *
+ *  @details    Words are tested as (word - lo) < len, so one unsigned
+ *              compare per window rejects both sides. The heap window also
+ *              covers the blacklist table; an empty window has len 0.
+ * ========================================================================== */
+typedef struct GcScanWindow
+{
+  uintptr_t heap_lo;  /**< Start of the heap and blacklist range */
+  uintptr_t heap_len; /**< Length of the heap and blacklist range */
+  uintptr_t map_lo;   /**< Start of the first indexed mmap block */
+  uintptr_t map_len;  /**< Span up to the end of the last one */
+} gc_scan_window_t;
+
+/** ============================================================================
+ *  @typedef    gc_word_vec_t
+ *  @brief      GC_SCAN_LANES scanned words as a generic compiler vector.
+ *
+ *  @details    Lowered to the target's vector unit (SSE2, AVX2, NEON) or to
+ *              scalar code, without extra build flags. Only word alignment
+ *              is assumed, and may_alias lets it load any scanned memory.
+ * ========================================================================== */
+typedef uintptr_t gc_word_vec_t
+  __attribute__((vector_size(GC_SCAN_LANES * sizeof(uintptr_t)),
+                 aligned(sizeof(uintptr_t)),
+                 may_alias));
+
+/** ============================================================================
+ *  @struct     gc_root_range_t
+ *  @brief      Writable segment of a loaded object scanned as a GC root.
+ * ========================================================================== */
+typedef struct GcRootRange
+{
+  uintptr_t start; /**< First byte of the segment */
+  uintptr_t end;   /**< One past the last byte */
+} gc_root_range_t;
+
+/** ============================================================================
+ *  @struct     gc_thread_entry_t
+ *  @brief      Mutator thread whose stack is scanned by the collector.
+ *
+ *  @par Fields:
+ *    @li @b thread    – Registered thread
+ *    @li @b sp        – Stack pointer captured by the suspend handler
+ *    @li @b stack_lo  – Lowest usable stack address
+ *    @li @b stack_hi  – One past the highest usable stack address
+ *    @li @b used      – Slot is taken
+ *    @li @b suspended – Thread was signalled in the current stop
+ * ========================================================================== */
+typedef struct GcThreadEntry
+{
+  pthread_t         thread;    /**< Registered thread */
+  _Atomic uintptr_t sp;        /**< Stack pointer at suspension */
+  uintptr_t         stack_lo;  /**< Lowest usable stack address */
+  uintptr_t         stack_hi;  /**< One past the highest stack address */
+  bool              used;      /**< Slot is taken */
+  bool              suspended; /**< Signalled in the current stop */
+} gc_thread_entry_t;
+
+/** ============================================================================
+ *  @struct     gc_registry_t
+ *  @brief      Threads and global segments that provide GC roots.
+ *
+ *  @details    Registered threads are parked with GC_SUSPEND_SIGNAL while
+ *              the collector marks; each handler records its stack pointer,
+ *              whose frame also holds the registers saved by the kernel, and
+ *              acknowledges through @b ack. Writable PT_LOAD segments are
+ *              collected with dl_iterate_phdr() before the world is stopped.
+ *
+ *  @par Fields:
+ *    @li @b threads       – Registered threads
+ *    @li @b num_threads   – Number of used slots
+ *    @li @b roots         – Writable segments of loaded objects
+ *    @li @b num_roots     – Number of valid entries in @b roots
+ *    @li @b roots_dropped – Segments skipped because @b roots was full
+ *    @li @b ack           – Suspend/resume acknowledgements
+ *    @li @b world_stopped – Parked threads must keep waiting
+ *    @li @b exit_key      – Key whose destructor unregisters exiting threads
+ *    @li @b signals_ready – Handlers, @b ack and @b exit_key are initialised
+ * ========================================================================== */
+typedef struct GcRegistry
+{
+  gc_thread_entry_t threads[MEM_GC_MAX_THREADS]; /**< Registered threads */
+  uint32_t          num_threads;                 /**< Used slots */
+
+  gc_root_range_t roots[GC_MAX_ROOT_RANGES]; /**< Writable segments */
+  uint32_t        num_roots;                 /**< Valid root ranges */
+  uint32_t        roots_dropped;             /**< Segments not recorded */
+
+  sem_t         ack;           /**< Suspend/resume acknowledgements */
+  _Atomic bool  world_stopped; /**< Parked threads keep waiting */
+  pthread_key_t exit_key;      /**< Unregisters threads on exit */
+  bool          signals_ready; /**< Handlers installed */
+} gc_registry_t;
+
+/** ============================================================================
+ *  @struct     mem_tag_shard_t
+ *  @brief      One cache-line sized slice of a tag's counters.
+ *
+ *  @details    Counters are monotonic and updated with relaxed atomics by
+ *              the threads mapped to this shard; readers sum every shard.
+ *              The shard's net bytes (allocated minus freed through it)
+ *              are tracked by @b peak_net, raised by the allocating thread,
+ *              and @b base_net; both are reset by MEM_tagPeak().
+ *
+ *  @par Fields:
+ *    @li @b alloc_bytes – Payload bytes allocated through this shard
+ *    @li @b free_bytes  – Payload bytes freed through this shard
+ *    @li @b alloc_count – Allocations accounted through this shard
+ *    @li @b free_count  – Frees accounted through this shard
+ *    @li @b peak_net    – Highest net bytes since the last MEM_tagPeak()
+ *    @li @b base_net    – Net bytes at the last MEM_tagPeak()
+ * ========================================================================== */
+typedef struct __attribute__((aligned(CACHE_LINE_SIZE))) MemTagShard
+{
+  _Atomic uint64_t alloc_bytes; /**< Payload bytes allocated */
+  _Atomic uint64_t free_bytes;  /**< Payload bytes freed */
+  _Atomic uint64_t alloc_count; /**< Allocations accounted */
+  _Atomic uint64_t free_count;  /**< Frees accounted */
+  _Atomic int64_t  peak_net;    /**< Net bytes high-water mark */
+  _Atomic int64_t  base_net;    /**< Net bytes at the last fold */
+} mem_tag_shard_t;
+
+/** ============================================================================
+ *  @struct     mem_tag_t
+ *  @brief      Registry entry of a named accounting tag.
+ *
+ *  @par Fields:
+ *    @li @b name       – NUL-terminated tag name
+ *    @li @b soft_limit – Soft limit in payload bytes (0 when disabled)
+ *    @li @b peak_bytes – Highest live byte count seen by MEM_tagSum() or
+ *                        folded in from the shards by MEM_tagPeak()
+ *    @li @b limit_hits – Allocations that left the tag above soft_limit
+ *    @li @b rate_bytes – total allocated bytes at the previous snapshot
+ *    @li @b rate_ns    – Monotonic timestamp of the previous snapshot
+ *    @li @b shards     – Per-thread counter shards
+ * ========================================================================== */
+typedef struct MemTag
+{
+  char name[MEM_TAG_NAME_LEN]; /**< NUL-terminated tag name */
+
+  _Atomic size_t   soft_limit;  /**< Soft limit (0 when disabled) */
+  _Atomic size_t   peak_bytes;  /**< Highest live bytes seen */
+  _Atomic uint64_t limit_hits;  /**< Allocations above soft_limit */
+
+  _Atomic uint64_t rate_bytes;  /**< Allocated bytes at last snapshot */
+  _Atomic uint64_t rate_ns;     /**< Timestamp of last snapshot */
+
+  mem_tag_shard_t shards[MEM_TAG_SHARDS]; /**< Per-thread counter shards */
+} mem_tag_t;
+
+/** ============================================================================
+ *  @struct     mem_layout_t
+ *  @brief      Registry entry of a precise pointer layout.
+ *
+ *  @par Fields:
+ *    @li @b words – Words in one element of the layout
+ *    @li @b bits  – Bit i set when word i of an element holds a pointer
+ * ========================================================================== */
+typedef struct MemLayout
+{
+  size_t words; /**< Words per element */
+
+  uint64_t bits[MEM_LAYOUT_MAX_WORDS / GC_BITS_PER_WORD]; /**< Pointer words */
+} mem_layout_t;
+
+/** ============================================================================
+ *  @struct     mem_limits_t
+ *  @brief      Footprint limits and memory pressure callbacks.
+ *
+ *  @details    The footprint is the user heap span plus every mmap region.
+ *              The soft limit derived from the cgroup is compared instead
+ *              with memory.current, as last read, plus the footprint growth
+ *              since that read; the cgroup never sets a hard limit, as
+ *              memory.current also counts page cache and other processes.
+ *              Limits are evaluated on the growth path only; pressure
+ *              events are queued in @b pending and dispatched once the
+ *              allocator lock has been released.
+ *
+ *  @par Fields:
+ *    @li @b soft_limit        – Soft footprint limit (0 when disabled)
+ *    @li @b hard_limit        – Hard footprint limit (0 when disabled)
+ *    @li @b mapped_bytes      – Bytes currently held in mmap regions
+ *    @li @b user_set          – Limits come from MEM_setLimit(), not cgroup
+ *    @li @b over_soft         – Footprint is above the soft limit
+ *    @li @b pending           – Highest pressure level awaiting dispatch
+ *    @li @b pending_footprint – Footprint recorded with the pending event
+ *    @li @b num_cbs           – Number of registered callbacks
+ *    @li @b cbs               – Registered pressure callbacks
+ *    @li @b cb_args           – User pointers handed to @b cbs
+ * ========================================================================== */
+typedef struct MemLimits
+{
+  size_t soft_limit;   /**< Soft footprint limit (0 when disabled) */
+  size_t hard_limit;   /**< Hard footprint limit (0 when disabled) */
+  size_t mapped_bytes; /**< Bytes held in mmap regions */
+
+  bool user_set;       /**< Limits set through MEM_setLimit() */
+  bool over_soft;      /**< Footprint is above soft_limit */
+
+  _Atomic uint8_t pending;           /**< Pressure level awaiting dispatch */
+  _Atomic size_t  pending_footprint; /**< Footprint of the pending event */
+
+  size_t            num_cbs;                    /**< Registered callbacks */
+  mem_pressure_cb_t cbs[MEM_MAX_PRESSURE_CBS];  /**< Pressure callbacks */
+  void             *cb_args[MEM_MAX_PRESSURE_CBS]; /**< Callback user data */
+} mem_limits_t;
+
+/** ============================================================================
+ *  @struct     mem_cgroup_t
+ *  @brief      cgroup v2 memory controller state.
+ *
+ *  @par Fields:
+ *    @li @b dir          – Directory holding memory.max / memory.current
+ *    @li @b enabled      – The last read of both files succeeded
+ *    @li @b max          – memory.max (SIZE_MAX when unlimited)
+ *    @li @b current      – memory.current at the last refresh
+ *    @li @b footprint    – Allocator footprint at the last refresh
+ *    @li @b soft_limit   – Derived soft footprint limit
+ *    @li @b hard_limit   – Derived hard level (reported, not enforced)
+ *    @li @b cache_budget – Suggested application cache size
+ *    @li @b refresh_ms   – Period between two refreshes
+ *    @li @b last_ns      – Monotonic timestamp of the last refresh
+ * ========================================================================== */
+typedef struct MemCgroup
+{
+  char dir[PATH_MAX];  /**< cgroup directory */
+
+  bool enabled;        /**< Last refresh succeeded */
+
+  size_t max;          /**< memory.max (SIZE_MAX when unlimited) */
+  size_t current;      /**< memory.current at the last refresh */
+  size_t footprint;    /**< Footprint at the last refresh */
+  size_t soft_limit;   /**< Derived soft footprint limit */
+  size_t hard_limit;   /**< Derived hard level, not enforced */
+  size_t cache_budget; /**< Suggested application cache size */
+
+  uint32_t refresh_ms; /**< Period between two refreshes */
+  uint64_t last_ns;    /**< Timestamp of the last refresh */
+} mem_cgroup_t;
+
+/** ============================================================================
+ *  @struct     mem_psi_t
+ *  @brief      Pressure-stall (PSI) monitor state.
+ *
+ *  @par Fields:
+ *    @li @b thread   – Monitor thread handle
+ *    @li @b running  – Monitor thread is alive (cleared by whichever of
+ *                      MEM_psiMonitorStop() or the exiting thread owns the
+ *                      teardown)
+ *    @li @b fd       – PSI trigger file descriptor
+ *    @li @b wake     – Pipe used to stop the monitor thread
+ *    @li @b events   – Number of PSI events handled
+ * ========================================================================== */
+typedef struct MemPsi
+{
+  pthread_t thread;          /**< Monitor thread handle */
+  bool      running;         /**< Monitor thread is alive */
+
+  int fd;                    /**< PSI trigger file descriptor */
+  int wake[2];               /**< Stop pipe (read, write) */
+
+  _Atomic uint64_t events;   /**< PSI events handled */
+} mem_psi_t;
+
+/** ============================================================================
+ *  @struct     mem_handle_slot_t
+ *  @brief      Entry of the movable allocation table.
+ *
+ *  @par Fields:
+ *    @li @b ptr       – Payload of the block, handle word first (NULL when
+ *                       the slot is free)
+ *    @li @b locks     – Outstanding MEM_hLock() pins
+ *    @li @b next_free – Next free slot plus one (0 ends the list)
+ * ========================================================================== */
+typedef struct MemHandleSlot
+{
+  void *ptr;          /**< Payload of the block, NULL when free */
+
+  uint32_t locks;     /**< Outstanding pins */
+  uint32_t next_free; /**< Next free slot plus one */
+} mem_handle_slot_t;
+
+/** ============================================================================
+ *  @struct     mem_handles_t
+ *  @brief      Table of movable allocations.
+ *
+ *  @details    Every field is protected by gc_lock. A handle is its slot
+ *              index plus one. The slots live in their own mapping, grown
+ *              with mremap(); with the garbage collector they are scanned
+ *              as a root, so handles keep their blocks alive.
+ *
+ *  @par Fields:
+ *    @li @b slots     – Slot storage (own anonymous mapping)
+ *    @li @b cap       – Capacity of @b slots
+ *    @li @b len       – Slots handed out at least once
+ *    @li @b free_head – First free slot plus one (0: none)
+ *    @li @b moved     – Blocks moved by the compactor
+ * ========================================================================== */
+typedef struct MemHandles
+{
+  mem_handle_slot_t *slots; /**< Slot storage */
+
+  size_t cap;               /**< Capacity of slots */
+  size_t len;               /**< Slots handed out at least once */
+
+  uint32_t free_head;       /**< First free slot plus one */
+  uint64_t moved;           /**< Blocks moved by the compactor */
+} mem_handles_t;
+
+/** ============================================================================
+ *  @struct     mem_allocator_t
+ *  @brief      Manages dynamic memory allocation.
+ *
+ *  @details    This structure manages the heap, including free
+ *              lists for memory blocks, garbage collection, and
+ *              allocation strategies.
+ *
+ *  @par Fields:
+ *    @li @b heap_start       – Base of the user heap region
+ *    @li @b heap_end         – Current end of the heap
+ *    @li @b metadata_size    – Bytes reserved for bins and arenas
+ *    @li @b stack_top        – Upper bound of application stack
+ *    @li @b stack_bottom     – Lower bound of application stack
+ *    @li @b last_allocated   – Last block returned (NEXT_FIT)
+ *    @li @b num_size_classes – Total size classes available
+ *    @li @b num_arenas       – Number of arena partitions
+ *    @li @b arenas           – Array of arena metadata
+ *    @li @b mmap_list        – Linked list of mmap’d regions
+ *    @li @b free_lists       – Segregated free lists by size class
+ *    @li @b last_brk_start   – Start address of the last sbrk(+) lease
+ *    @li @b last_brk_end     – End (exclusive) of the last sbrk(+) lease
+ *    @li @b gc_thread        – Garbage collector controller
+ *    @li @b gc_pool          – GC mark/sweep workers and their stacks
+ *    @li @b mark_bits        – GC mark bitmap of the sbrk heap
+ *    @li @b start_bits       – GC block-start bitmap of the sbrk heap
+ *    @li @b gc_blacklist     – Heap pages hit by false pointers
+ *    @li @b map_index        – GC lookup index of mmap blocks
+ *    @li @b gc_registry      – GC root threads and segments
+ *    @li @b gc_incr          – Incremental collection state
+ *    @li @b gc_snap          – fork()-snapshot collection state
+ *    @li @b gc_gen           – Generational collection state
+ *    @li @b gc_pace          – GC thread scheduling state
+ *    @li @b gc_stats         – GC cycle metrics
+ *    @li @b limits           – Footprint limits and pressure callbacks
+ *    @li @b cgroup           – cgroup v2 memory controller state
+ *    @li @b psi              – Pressure-stall monitor state
+ *    @li @b handles          – Movable allocation table
+ *    @li @b num_tags         – Number of registered accounting tags
+ *    @li @b tags             – Accounting tag registry
+ *    @li @b num_layouts      – Number of registered pointer layouts
+ *    @li @b layouts          – Pointer layout registry
+ * ========================================================================== */
+typedef struct __ALIGN MemoryAllocator
+{
+  uint8_t *heap_start;             /**< Base of the user heap region */
+  uint8_t *heap_end;               /**< Current end of the heap */
+
+  size_t metadata_size;            /**< Bytes reserved for bins and arenas */
+
+  uintptr_t *stack_top;            /**< Upper bound of application stack */
+  uintptr_t *stack_bottom;         /**< Lower bound of application stack */
+
+  size_t num_size_classes;         /**< Total size classes available */
+  size_t num_arenas;               /**< Number of arena partitions */
+
+  block_header_t  *last_allocated; /**< Last block returned (NEXT_FIT) */
+  block_header_t **free_lists;     /**< Segregated free lists by size class */
+
+  mem_arena_t *arenas;             /**< Array of arena metadata */
+  mmap_t      *mmap_list;          /**< Linked list of mmap’d regions */
+
+  uint8_t *last_brk_start; /**< Start address of the last sbrk(+) lease */
+  uint8_t *last_brk_end;   /**< End (exclusive) of the last sbrk(+) lease */
+
+  gc_thread_t     gc_thread;   /**< Garbage collector controller */
+  gc_pool_t       gc_pool;     /**< GC mark/sweep workers */
+  gc_bitmap_t     mark_bits;   /**< GC mark bitmap of the sbrk heap */
+  gc_bitmap_t     start_bits;  /**< GC block-start bitmap of the sbrk heap */
+  gc_blacklist_t  gc_blacklist; /**< Heap pages hit by false pointers */
+  gc_map_index_t  map_index;   /**< GC lookup index of mmap blocks */
+  gc_registry_t   gc_registry; /**< GC root threads and segments */
+  gc_incr_t       gc_incr;     /**< Incremental collection state */
+  gc_snap_t       gc_snap;     /**< fork()-snapshot collection state */
+  gc_gen_t        gc_gen;      /**< Generational collection state */
+  gc_pace_t       gc_pace;     /**< GC thread scheduling state */
+  gc_stats_t      gc_stats;    /**< GC cycle metrics */
+  mem_limits_t    limits;      /**< Footprint limits and pressure callbacks */
+  mem_cgroup_t    cgroup;      /**< cgroup v2 memory controller state */
+  mem_psi_t       psi;         /**< Pressure-stall monitor state */
+  mem_handles_t   handles;     /**< Movable allocation table */
+
+  _Atomic uint32_t num_tags;           /**< Number of registered tags */
+  mem_tag_t        tags[MEM_MAX_TAGS]; /**< Accounting tag registry */
+
+  _Atomic uint32_t num_layouts;             /**< Registered layouts */
+  mem_layout_t     layouts[MEM_MAX_LAYOUTS]; /**< Pointer layout registry */
+} mem_allocator_t;
+
+/** ============================================================================
+ *  @typedef  find_fn_t
+ *  @brief    Type for functions that locate a suitable free block.
+ *
+ *  @param [in]  allocator  Memory allocator context in which to search.
+ *  @param [in]  size       Total size requested (including header and canary).
+ *  @param [out] block      Address of pointer to store the found block header.
+ *
+ *  @return Integer
+ * ========================================================================== */
+typedef int (*find_fn_t)(mem_allocator_t *const,
+                         const size_t,
+                         block_header_t **);
+
+/** ============================================================================
+ *          P R I V A T E  F U N C T I O N S  P R O T O T Y P E S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @brief  Invokes sbrk-like behavior by moving the program break.
+ *
+ *  This function reads the current program break, attempts to move it by the
+ *  signed offset @p increment via sbrk(), and returns the original break on
+ *  success.  If any call to sbrk() or reading the break fails, it encodes the
+ *  negative errno into a pointer via PTR_ERR.
+ *
+ *  @param[in]  increment Signed offset in bytes to move the program break:
+ *                        positive to grow, negative to shrink.
+ *
+ *  @return Original program break address on success;
+ *          an error-encoded pointer (via PTR_ERR()) on failure.
+ *
+ *  @retval ret>-1:   Previous break on success.
+ *  @retval -ENOMEM:  Failed to read or adjust the break.
+ * ========================================================================== */
+void *MEM_sbrk(const intptr_t increment);
+
+/** ============================================================================
+ *  @brief  Calculates the size class index for a requested memory size.
+ *
+ *  This function determines which size class the given allocation request
+ *  belongs to by dividing the requested @p size by BYTES_PER_CLASS (rounding
+ *  up). If the computed index exceeds the maximum available class, it will
+ *  be clamped to the highest class and a warning emitted.
+ *
+ *  @param[in]  allocator Pointer to the allocator context.
+ *  @param[in]  size  Requested memory size in bytes (must be > 0).
+ *
+ *  @return On success, returns a non-negative integer size class index;
+ *          on failure, returns a negative error code.
+ *
+ *  @retval ret>0:    Valid size class index.
+ *  @retval -EINVAL:  @p allocator is NULL, or @p size is zero.
+ * ========================================================================== */
+static int MEM_getSizeClass(mem_allocator_t *const allocator,
+                            const size_t           size);
+
+/** ============================================================================
+ *  @brief  Initializes the memory allocator and its internal structures.
+ *
+ *  This function prepares the allocator’s heap by:
+ *    - Reading and aligning the initial program break to ARCH_ALIGNMENT.
+ *    - Allocating the arena array and free‐list bins via MEM_growUserHeap().
+ *    - Zeroing out the free‐list bins.
+ *    - Initializing the allocator fields (heap_start, heap_end, free_lists).
+ *    - Setting up the garbage‐collector thread state and its mutex/cond.
+ *    - Capturing the current thread’s stack bounds via MEM_stackBounds().
+ *    - (If under Valgrind) creating a mempool for the allocator.
+ *
+ *  @param[in]  allocator Pointer to a mem_allocator_t instance to initialize.
+ *
+ *  @return Integer status code indicating initialization result.
+ *
+ *  @retval EXIT_SUCCESS: Allocator initialized successfully.
+ *  @retval -EINVAL:      Invalid @p allocator pointer.
+ *  @retval -ENOMEM:      Heap alignment or arena/bin allocation failed.
+ * ========================================================================== */
+static int MEM_allocatorInit(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Validates the integrity and boundaries of a memory block.
+ *
+ *  This function ensures that the specified @p block lies within the
+ * allocator’s heap or one of its mmap regions, that its header canary matches
+ * the expected magic value to detect metadata corruption, that its data canary
+ * is intact to catch buffer overruns, and that the block’s size does not extend
  * past the heap’s end.  On any failure, an appropriate negative errno is
  * returned.
  *
@@ -546,6 +1543,23 @@ static int MEM_insertFreeBlock(mem_allocator_t *const allocator,
 static int MEM_removeFreeBlock(mem_allocator_t *const allocator,
                                block_header_t *const  block);
 
+/** ============================================================================
+ *  @brief  Tells whether a free-list block can hold an allocation.
+ *
+ *  The block must pass MEM_validateBlock(), be free and span at least
+ *  @p size bytes. With the garbage collector, the part a split would hand
+ *  out must also stay clear of blacklisted pages (MEM_gcBlacklisted()).
+ *
+ *  @param[in]  allocator Pointer to the allocator context.
+ *  @param[in]  block     Candidate free block.
+ *  @param[in]  size      Total size requested (including header and canary).
+ *
+ *  @return true if @p block can be split to hold @p size bytes.
+ * ========================================================================== */
+static bool MEM_blockFits(mem_allocator_t *const allocator,
+                          block_header_t *const  block,
+                          const size_t           size);
+
 /** ============================================================================
  *  @brief  Searches for the first suitable free memory block in size‐class
  * lists.
@@ -693,7 +1707,7 @@ static int MEM_mergeBlocks(mem_allocator_t *const allocator,
  *
  *  @retval (ret>=0): Previous heap end address (new region start).
  *  @retval -EINVAL:  @p allocator is NULL.
- *  @retval -ENOMEM:  Heap expansion failed (out of memory).
+ *  @retval -ENOMEM:  Heap expansion failed or refused by the hard limit.
  * ========================================================================== */
 static void *MEM_growUserHeap(mem_allocator_t *const allocator,
                               const intptr_t         inc);
@@ -717,7 +1731,8 @@ static void *MEM_growUserHeap(mem_allocator_t *const allocator,
  *  @retval ret!=MAP_FAILED:  Address of the mapped region.
  *  @retval -EINVAL:          @p allocator is NULL.
  *  @retval -EIO:             mmap() failed.
- *  @retval -ENOMEM:          Allocation of mmap_t metadata failed.
+ *  @retval -ENOMEM:          Hard limit reached or allocation of mmap_t
+ *                            metadata failed.
  * ========================================================================== */
 static void *MEM_mapAlloc(mem_allocator_t *const allocator,
                           const size_t           total_size);
@@ -751,15 +1766,20 @@ static int MEM_mapFree(mem_allocator_t *const allocator, void *const addr);
  *  growth) or mmap (for large requests > MMAP_THRESHOLD).  It uses the
  *  given @p strategy (FIRST_FIT, NEXT_FIT, BEST_FIT) to locate a free block,
  *  grows the heap if necessary, splits a larger block to fit exactly, and
- *  records debugging metadata (source file, line).  For mmap
- *  allocations it rounds up to page size and tracks the region in the
- * allocator.
+ *  records debugging metadata (source file, line).  While a lazy sweep is
+ *  pending, heap requests first sweep part of the heap with
+ *  MEM_gcLazySweep(), and keep sweeping before growing it.  Free blocks
+ *  whose payload would sit on pages blacklisted by the collector are passed
+ *  over; if only the grown space is left and it is blacklisted too, the
+ *  search runs again ignoring the blacklist.  For mmap allocations it rounds
+ *  up to page size and tracks the region in the allocator.
  *
  *  @param[in]  allocator Memory allocator context.
  *  @param[in]  size      Number of bytes requested.
  *  @param[in]  file      Source file name for debugging metadata.
  *  @param[in]  line      Source line number for debugging metadata.
  *  @param[in]  strategy  Allocation strategy.
+ *  @param[in]  tag       Accounting tag charged for the block.
  *
  *  @return Pointer to the start of the allocated user region (just past
  *          the internal header) on success; an error‐encoded pointer
@@ -776,7 +1796,8 @@ static void *MEM_allocOp(mem_allocator_t *const      allocator,
                          const size_t                size,
                          const char *const           file,
                          const int                   line,
-                         const allocation_strategy_t strategy)
+                         const allocation_strategy_t strategy,
+                         const uint32_t              tag)
   __LIBMEMALLOC_INTERNAL_MALLOC;
 
 /** ============================================================================
@@ -851,8 +1872,8 @@ static void *MEM_callocOp(mem_allocator_t *const      allocator,
  metadata.
  *    - For heap blocks, it validates the block, checks for double frees,
  *      marks the block free, merges with adjacent free blocks, and reinserts
- *      the merged block into the free list.  If the freed block lies at the
- *      current heap end, it shrinks the heap via MEM_sbrk().
+ *      the merged block into the free list.  If the merged block lies at
+ *      the current heap end, it shrinks the heap via MEM_sbrk().
  *
  *  @param[in]  allocator Memory allocator context.
  *  @param[in]  ptr       Pointer to memory to free.
@@ -879,229 +1900,250 @@ static int MEM_freeOp(mem_allocator_t *const allocator,
                       const int              line);
 
 /** ============================================================================
- *  @brief  Determine at runtime whether the stack grows downward
- *
- *  This function places two volatile local variables on the stack and compares
- *  their addresses to infer the growth direction:
- *    - If &addr_1 < &addr_0, the stack grows toward lower addresses.
- *    - Otherwise, it grows toward higher addresses.
+ *  @brief  Returns the last sbrk() lease when a free block covers it.
  *
- *  @return true if stack grows down (higher addresses → lower),
- *          false if it grows up (lower addresses → higher)
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  block     Free block, on its free list.
  *
- *  @retval true:   Stack grows downward (newer frames at lower addresses)
- *  @retval false:  Stack grows upward (newer frames at higher addresses)
+ *  @return true if the heap was shrunk, false otherwise.
  * ========================================================================== */
-static bool MEM_stackGrowsDown(void);
+static bool MEM_shrinkTail(mem_allocator_t *const allocator,
+                           block_header_t *const  block);
 
 /** ============================================================================
- *  @brief  Query and record the bounding addresses of a thread’s stack
+ *  @brief  Resolves a handle to its slot. Caller holds gc_lock.
  *
- *  This function retrieves the stack base address, total stack size, and
- *  guard size for the specified thread, then computes the usable stack
- *  bounds within the allocator object, taking into account whether the
- *  stack grows up or down in memory.
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  handle    Handle returned by MEM_hAlloc().
  *
- *  @param[in]  id          The thread identifier whose stack to inspect.
- *  @param[in]  allocator   Pointer to the allocator object where stack_bottom
- *                          and stack_top will be stored.
+ *  @return Slot of @p handle, or NULL if @p handle is not allocated.
+ * ========================================================================== */
+static mem_handle_slot_t *MEM_handleSlot(mem_allocator_t *const allocator,
+                                         const mem_handle_t     handle);
+
+/** ============================================================================
+ *  @brief  Makes room for one more slot in the handle table.
+ *
+ *  The table lives in its own mapping, created with mmap() and grown with
+ *  mremap() to twice its size. Caller holds gc_lock.
+ *
+ *  @param[in]  allocator Memory allocator context.
  *
  *  @return Integer status code.
  *
- *  @retval EXIT_SUCCESS: Stack bounds successfully recorded.
- *  @retval -EINVAL:      @p allocator was NULL.
- *  @retval ret>0:        Error code from one of the pthread or system calls
+ *  @retval EXIT_SUCCESS: A slot past @b len is available.
+ *  @retval -ENOSPC:      INT32_MAX handles are in use.
+ *  @retval -ENOMEM:      The table could not be grown.
  * ========================================================================== */
-static int MEM_stackBounds(const pthread_t        id,
-                           mem_allocator_t *const allocator);
-
-#if defined(GARBAGE_COLLECTOR)
+static int MEM_handleGrow(mem_allocator_t *const allocator);
 
 /** ============================================================================
- *  @brief  Dedicated thread loop driving mark-and-sweep iterations.
+ *  @brief  Allocates a movable block and its handle. Caller holds gc_lock.
  *
- *  This function runs as the GC worker thread.  It locks gc_lock and waits
- *  on gc_cond until either gc_running or gc_exit is set.  On wakeup, if
- *  gc_exit is true, it breaks and exits the loop; otherwise it unlocks and
- *  performs one full GC cycle by calling MEM_gcMark() and MEM_gcSweep(),
- *  then sleeps for gc_interval_ms before re-acquiring the lock and waiting
- *  again.  On exit it ensures gc_lock is released.
+ *  The block is placed FIRST_FIT, with HANDLE_PREFIX extra bytes in front of
+ *  the payload holding the handle, and charged to MEM_TAG_DEFAULT.
  *
- *  @param[in]  arg Pointer to the mem_allocator_t context.
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  size      Number of bytes requested.
+ *  @param[in]  file      Source file name for debugging metadata.
+ *  @param[in]  line      Source line number for debugging metadata.
  *
- *  @return NULL on clean exit; an error-encoded pointer (via PTR_ERR())
- *          if any initialization or GC step fails.
+ *  @return Handle (> 0) on success, negative error code on failure.
  *
- *  @retval NULL:     Clean exit after gc_exit.
- *  @retval -EINVAL:  @p arg is NULL.
- *  @retval ret<0:    cond errors, or MEM_gcMark() / MEM_gcSweep() failures.
+ *  @retval -EINVAL:  @p size is zero or too large.
+ *  @retval -ENOSPC:  INT32_MAX handles are in use.
+ *  @retval -ENOMEM:  The table or the block could not be allocated.
  * ========================================================================== */
-__GC_HOT static void *MEM_gcThreadFunc(void *arg);
+static mem_handle_t MEM_hAllocOp(mem_allocator_t *const allocator,
+                                 const size_t           size,
+                                 const char *const      file,
+                                 const int              line);
 
 /** ============================================================================
- *  @brief  Reset “marked” flags across all allocated regions.
- *
- *  This function prepares for a new garbage-collection cycle by clearing the
- *  mark flag on every heap block and every mmap’d block payload.  It scans
- *  the heap from allocator->heap_start + metadata_size up to
- * allocator->heap_end, resetting each valid block’s marked flag (and skipping
- * malformed blocks to avoid infinite loops).  It then iterates
- * allocator->mmap_list, clearing the mark on each payload block while
- * preserving the metadata header’s mark so the allocator’s own bookkeeping
- * regions are never freed.
+ *  @brief  Releases a movable block and its handle. Caller holds gc_lock.
  *
  *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  handle    Handle returned by MEM_hAlloc().
+ *  @param[in]  file      Source file name for debugging metadata.
+ *  @param[in]  line      Source line number for debugging metadata.
  *
  *  @return Integer status code.
  *
- *  @retval EXIT_SUCCESS: All marks cleared and metadata marks preserved.
- *  @retval -EINVAL:      @p allocator is NULL.
+ *  @retval EXIT_SUCCESS: Block and handle released.
+ *  @retval -EINVAL:      @p handle is not allocated.
+ *  @retval -EBUSY:       @p handle is locked.
+ *  @retval ret<0:        Error returned by MEM_freeOp().
  * ========================================================================== */
-__GC_HOT static int MEM_setInitialMarks(mem_allocator_t *const allocator);
+static int MEM_hFreeOp(mem_allocator_t *const allocator,
+                       const mem_handle_t     handle,
+                       const char *const      file,
+                       const int              line);
 
 /** ============================================================================
- *  @brief  Mark all live blocks reachable from the stack.
+ *  @brief  Finds the slot of a heap block the compactor may move.
  *
- *  This function performs the marking phase of garbage collection by:
- *    - Calling MEM_setInitialMarks() to clear previous marks.
- *    - Capturing stack bounds via MEM_stackBounds() for the current thread.
- *    - Optionally informing Valgrind to treat the stack region as defined.
- *    - Scanning each word between stack_bottom and stack_top:
- *        • If the word’s value lies within the heap bounds, validating the
- *          corresponding block header and marking the block if it is live.
- *    - Iterating the allocator’s mmap_list and marking any mmap’d block whose
- *      payload contains a stack reference.
+ *  The handle word in front of the payload is only trusted when the slot
+ *  it names points back at the block, so ordinary blocks are never taken
+ *  for movable ones.
  *
  *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  block     Candidate heap block header.
  *
- *  @return Integer status code.
- *
- *  @retval EXIT_SUCCESS: All reachable blocks marked successfully.
- *  @retval -EINVAL:      @p allocator is NULL.
- *  @retval ret<0:        Error code returned by MEM_stackBounds(),
- *                        MEM_validateBlock(), or other internal calls.
+ *  @return Slot owning @p block if it is allocated through MEM_hAlloc()
+ *          and unlocked, NULL otherwise.
  * ========================================================================== */
-__GC_HOT static int MEM_gcMark(mem_allocator_t *const allocator);
+static mem_handle_slot_t *MEM_handleOwner(mem_allocator_t *const allocator,
+                                          block_header_t *const  block);
 
 /** ============================================================================
- *  @brief  Reclaim any unmarked blocks from heap and mmap regions.
+ *  @brief  Swaps a free block with the movable block that follows it.
  *
- *  This function performs the “sweep” phase of garbage collection:
- *    - It iterates over every block in the heap:
- *        • Logs each block’s free and marked status.
- *        • If a block is allocated (free==0) but unmarked, calls
- *          MEM_freeOp() on its payload pointer to reclaim it.
- *        • Clears each block’s marked flag.
- *    - It then traverses allocator->mmap_list via a pointer-to-pointer scan:
- *        • Logs each mmap’d region’s status.
- *        • If an mmap’d block is unmarked and not already free, unlinks
- *          the mmap_t node, calls munmap() on the region, and frees its
- *          metadata header via MEM_freeOp().
- *        • Otherwise, clears the block’s marked flag and advances to the next
- * node.
+ *  Copies @p block, header and canary included, down to @p hole, then
+ *  writes the free block back behind it, merged with a free successor.
+ *  The copy runs forward and the destination is lower, so the overlap is
+ *  harmless. Caller holds gc_lock.
  *
  *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  hole      Free block, on its free list.
+ *  @param[in]  block     Unlocked movable block right after @p hole.
+ *  @param[in]  slot      Slot owning @p block.
  *
- *  @return Integer status code.
- *
- *  @retval EXIT_SUCCESS: All unreachable blocks reclaimed successfully.
- *  @retval -EINVAL:      @p allocator is NULL.
- *  @retval ret<0:        Errors returned by MEM_freeOp(),
- *                        munmap(), or internal validation functions.
+ *  @return The free block now following the moved one, or NULL if @p hole
+ *          could not be taken off its free list.
  * ========================================================================== */
-__GC_HOT static int MEM_gcSweep(mem_allocator_t *const allocator);
+static block_header_t *MEM_compactSlide(mem_allocator_t *const   allocator,
+                                        block_header_t *const    hole,
+                                        block_header_t *const    block,
+                                        mem_handle_slot_t *const slot);
 
 /** ============================================================================
- *  @brief  Start or signal the GC thread to perform a collection cycle.
+ *  @brief  Slides movable blocks toward the heap start, then trims.
+ *
+ *  Walks the heap in address order. Each free block followed by an
+ *  unlocked MEM_hAlloc() block that links back to it trades places with
+ *  it, so free space bubbles up until a locked or ordinary block stops it
+ *  and coalesces on the way. Words that are not block headers, such as
+ *  memory another sbrk() user took between two heap growths, are skipped
+ *  one alignment unit at a time rather than ending the walk. MEM_trimOp()
+ *  then returns the top of the heap. While a collection is in progress,
+ *  blocks are not moved. Moving a block invalidates the generational
+ *  marks, so the next collection is full.
+ *  Caller holds gc_lock.
  *
- *  This function saves the caller’s thread ID as main_thread, locks gc_lock,
- *  and if the GC thread has not been started, sets gc_running and gc_exit
- *  flags and spawns MEM_gcThreadFunc(); otherwise it sets gc_running and
- *  signals gc_cond to wake the existing thread.  Finally it unlocks gc_lock.
- *
- *  @param[in]  allocator Pointer to the mem_allocator_t context.
+ *  @param[in]  allocator Memory allocator context.
  *
- *  @return Integer status code.
+ *  @return Number of bytes released (>= 0) on success,
+ *          negative error code on failure.
  *
- *  @retval EXIT_SUCCESS: GC thread started or signaled successfully.
  *  @retval -EINVAL:      @p allocator is NULL.
- *  @retval ret<0:        Error code returned by pthread_create().
  * ========================================================================== */
-__GC_COLD static int MEM_runGc(mem_allocator_t *const allocator);
+static intptr_t MEM_compactOp(mem_allocator_t *const allocator);
 
 /** ============================================================================
- *  @brief  Stop the GC thread and perform a final collection.
- *
- *  This function clears gc_running and sets gc_exit, signals gc_cond to wake
- *  the GC thread if it’s running, then joins it.  After the thread exits, it
- *  runs one final MEM_gcMark() + MEM_gcSweep() on the caller thread to
- *  reclaim any remaining garbage, then clears gc_thread_started.
+ *  @brief  Bytes of a free heap run that MEM_trimOp() hands back.
  *
- *  @param[in]  allocator Pointer to the mem_allocator_t context.
+ *  A run ending at the heap top and spanning a page is returned whole
+ *  through sbrk(); any other run only gives up the pages lying between its
+ *  header and its canary.
  *
- *  @return Integer status code.
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  start     First byte of the run (a block header).
+ *  @param[in]  end       One past the last byte of the run.
  *
- *  @retval EXIT_SUCCESS: GC thread stopped and final collection done.
- *  @retval -EINVAL:      @p allocator is NULL.
- *  @retval ret<0:        Error code from pthread MEM_gcMark(), or
- * MEM_gcSweep().
+ *  @return Releasable bytes.
  * ========================================================================== */
-__GC_COLD static int MEM_stopGc(mem_allocator_t *const allocator);
-
-#endif
+static size_t MEM_releasable(mem_allocator_t *const allocator,
+                             const uint8_t *const   start,
+                             const uint8_t *const   end);
 
 /** ============================================================================
- *              	P R I V A T E  G L O B A L  V A R I A B L E S
+ *  @brief  Bytes that freeing a heap block would let MEM_trimOp() release.
+ *
+ *  Joins @p block with the free neighbours MEM_mergeBlocks() would absorb
+ *  and compares what the merged run gives back with what the neighbours
+ *  give back on their own. A block alone in otherwise free pages gains
+ *  those pages; one packed among live blocks gains nothing.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  block     Allocated heap block.
+ *  @param[out] lo        Start of the merged run.
+ *
+ *  @return Releasable bytes gained.
  * ========================================================================== */
+static size_t MEM_relocateGain(mem_allocator_t *const allocator,
+                               block_header_t *const  block,
+                               uint8_t              **lo);
 
 /** ============================================================================
- *  @var        g_allocator
- *  @brief      Process-wide default allocator instance.
- *
- *  @details    Statically allocated allocator used when the API is called
- *              without an explicit @c mem_allocator_t handle. This instance
- *              is initialized exactly once (see @c g_allocator_inited) and then
- *              reused for all subsequent allocation requests routed through
- *              the “global” path.
+ *  @brief  Picks the free block a relocated heap block should move to.
  *
- *  @note       File-scope @c static grants internal linkage: the symbol is
- *              private to this translation unit.
+ *  Considers the free blocks that fit @p block and lie below @p lo, so
+ *  relocation moves data down, away from the run being emptied. Placing
+ *  the block costs the releasable bytes the candidate loses
+ *  (MEM_releasable()); the cheapest candidate wins, and one that costs
+ *  nothing, because it sits in pages already holding live data, ends the
+ *  search.
  *
- *  @par Thread-Safety
- *              Initialization must be synchronized so only one thread performs
- *              it (e.g., via @c pthread_once or equivalent). Normal allocator
- *              operations should rely on the allocator’s internal locking.
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  block     Allocated heap block to relocate.
+ *  @param[in]  lo        Start of the run freeing @p block would create.
+ *  @param[in]  gain      Bytes freeing @p block would release.
  *
- *  @see        MEM_allocatorInit(), MEM_allocOp(), MEM_free(), MEM_realloc()
+ *  @return Free block whose cost is below @p gain, or NULL.
  * ========================================================================== */
-static mem_allocator_t g_allocator;
+static block_header_t *MEM_relocateTarget(mem_allocator_t *const allocator,
+                                          block_header_t *const  block,
+                                          const uint8_t *const   lo,
+                                          const size_t           gain);
 
 /** ============================================================================
- *  @var        g_allocator_inited
- *  @brief      One-time initialization guard for @c g_allocator.
+ *  @brief  Resolves a user pointer to a heap block worth relocating.
  *
- *  @details    Boolean-like flag controlling lazy init of the global allocator.
- *              A value of 0 means “not initialized”; 1 means “initialized”.
- *              It should be set to 1 only after a successful call to
- *              @c MEM_allocatorInit(&g_allocator).
+ *  mmap blocks are released on their own and are never reported.
+ *  Caller holds gc_lock.
  *
- *  @warning    This flag is a plain @c int and is not atomic. In multi-threaded
- *              contexts, protect initialization with proper synchronization
- *              (e.g., @c pthread_once, a mutex, or atomic CAS) to avoid races.
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  ptr       Pointer returned by an allocation function.
+ *  @param[out] target    Free block to move the payload to.
+ *
+ *  @return Header of the block behind @p ptr when it sits in a sparsely
+ *          used part of the heap and @p target was found, NULL otherwise.
  * ========================================================================== */
-static bool g_allocator_inited = false;
+static block_header_t *MEM_relocateFind(mem_allocator_t *const allocator,
+                                        const void *const      ptr,
+                                        block_header_t       **target);
 
 /** ============================================================================
- *                  F U N C T I O N S  D E F I N I T I O N S
+ *  @brief  Moves a heap block out of a sparsely used region.
+ *
+ *  When MEM_relocateFind() reports the block, allocates its replacement in
+ *  the chosen free block, keeping tag and layout, copies the payload and
+ *  frees the original. Otherwise @p ptr is returned unchanged. Caller holds
+ *  gc_lock.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  ptr       Pointer returned by an allocation function.
+ *  @param[in]  file      Source file name for debugging metadata.
+ *  @param[in]  line      Source line number for debugging metadata.
+ *
+ *  @return New pointer when the block moved, @p ptr when it stays, or an
+ *          error-encoded pointer (via PTR_ERR()) on failure.
+ *
+ *  @retval -EINVAL:  @p ptr is NULL.
+ *  @retval ret<0:    Error returned by MEM_splitBlock() or MEM_freeOp().
  * ========================================================================== */
+static void *MEM_relocateOp(mem_allocator_t *const allocator,
+                            void *const            ptr,
+                            const char *const      file,
+                            const int              line);
 
 /** ============================================================================
  *  @brief  Determine at runtime whether the stack grows downward
  *
- *  This function places two volatile local variables on the stack and compares
- *  their addresses to infer the growth direction:
- *    - If &addr_1 < &addr_0, the stack grows toward lower addresses.
- *    - Otherwise, it grows toward higher addresses.
+ *  This function passes the address of a volatile local to
+ *  MEM_stackDeeper(), which compares it with one of its own locals, to infer
+ *  the growth direction. Two locals of the same frame would not do: the
+ *  compiler lays a frame out in any order.
  *
  *  @return true if stack grows down (higher addresses → lower),
  *          false if it grows up (lower addresses → higher)
@@ -1109,17 +2151,19 @@ static bool g_allocator_inited = false;
  *  @retval true:   Stack grows downward (newer frames at lower addresses)
  *  @retval false:  Stack grows upward (newer frames at higher addresses)
  * ========================================================================== */
-static bool MEM_stackGrowsDown(void)
-{
-  bool ret = false;
-
-  volatile int addr_0 = 0u;
-  volatile int addr_1 = 0u;
-
-  ret = (bool)(&addr_1 < &addr_0);
+static bool MEM_stackGrowsDown(void);
 
-  return ret;
-}
+/** ============================================================================
+ *  @brief  Tells whether a callee frame sits below its caller's.
+ *
+ *  Never inlined, so its local lives in a frame of its own.
+ *
+ *  @param[in]  outer Address of a local of the calling frame.
+ *
+ *  @return true if the local of this frame has the lower address.
+ * ========================================================================== */
+static bool MEM_stackDeeper(const uintptr_t outer)
+  __attribute__((noinline));
 
 /** ============================================================================
  *  @brief  Query and record the bounding addresses of a thread’s stack
@@ -1139,3080 +2183,12886 @@ static bool MEM_stackGrowsDown(void)
  *  @retval -EINVAL:      @p allocator was NULL.
  *  @retval ret>0:        Error code from one of the pthread or system calls
  * ========================================================================== */
-static int MEM_stackBounds(const pthread_t id, mem_allocator_t *const allocator)
-{
-  int ret = EXIT_SUCCESS;
-
-  pthread_attr_t attr;
-
-  void *base_addr = (void *)NULL;
-
-  uintptr_t base = 0u;
-
-  size_t stack_size = 0u;
-  size_t guard_size = 0u;
-
-  size_t page = 0u;
-
-  bool grows_down = false;
-
-  if (UNLIKELY(allocator == NULL))
-  {
-    ret = -EINVAL;
-    LOG_ERROR("Invalid allocator pointer: %p. "
-              "Error code: %d.\n",
-              (void *)allocator,
-              ret);
-    goto function_output;
-  }
-
-  page = (size_t)sysconf(_SC_PAGESIZE);
-
-  ret = pthread_getattr_np(id, &attr);
-  if (ret != EXIT_SUCCESS)
-    goto function_output;
-
-  ret = pthread_attr_getstack(&attr, &base_addr, &stack_size);
-  if (ret != EXIT_SUCCESS)
-    goto function_output;
-
-  ret = pthread_attr_getguardsize(&attr, &guard_size);
-  if (ret != EXIT_SUCCESS)
-    goto function_output;
-
-  ret = pthread_attr_destroy(&attr);
-  if (ret != EXIT_SUCCESS)
-    goto function_output;
-
-  if (guard_size < page)
-    guard_size = page;
+static int MEM_stackBounds(const pthread_t        id,
+                           mem_allocator_t *const allocator);
 
-  base = (uintptr_t)base_addr;
+/** ============================================================================
+ *  @brief  Returns the counter shard assigned to the calling thread.
+ *
+ *  Threads are assigned round-robin on first use; the index is cached in
+ *  thread-local storage afterwards.
+ *
+ *  @return Shard index in [0, MEM_TAG_SHARDS).
+ * ========================================================================== */
+static uint32_t MEM_getTagShard(void);
 
-  grows_down = MEM_stackGrowsDown( );
-  if (grows_down)
-  {
-    allocator->stack_bottom = (uintptr_t *)(base + guard_size);
-    allocator->stack_top    = (uintptr_t *)(base + stack_size);
-  }
-  else
-  {
-    allocator->stack_bottom = (uintptr_t *)base_addr;
-    allocator->stack_top    = (uintptr_t *)(base + stack_size - guard_size);
-  }
+/** ============================================================================
+ *  @brief  Sums the per-thread shards of a tag into a stats snapshot.
+ *
+ *  Fills live_bytes, total_bytes, alloc_count and free_count of @p stats.
+ *  The remaining fields are left untouched. The tag's peak is raised to the
+ *  summed live bytes, so it reflects the highest value seen by any reader.
+ *
+ *  @param[in]  tag       Tag registry entry.
+ *  @param[out] stats     Destination snapshot.
+ * ========================================================================== */
+static void MEM_tagSum(mem_tag_t *const tag, mem_tag_stats_t *const stats);
 
-  LOG_INFO("Stack: grows %s | guard size=%zu | Bounds=[%p .. %p].\n",
-           grows_down ? "down" : "up",
-           guard_size,
-           (void *)allocator->stack_bottom,
-           (void *)allocator->stack_top);
+/** ============================================================================
+ *  @brief  Folds the shard high-water marks into the tag's peak.
+ *
+ *  A shard whose net bytes rose above both its value at the previous fold
+ *  and its current value saw a spike that no sum caught; the spikes of
+ *  every shard are added to @p live_bytes and the tag's peak is raised to
+ *  the result. The marks are then reset to the current net bytes. The
+ *  peak is exact while one thread at a time allocates under the tag, and
+ *  an upper bound when spikes on several shards did not overlap.
+ *
+ *  @param[in]  tag        Tag registry entry.
+ *  @param[in]  live_bytes Live bytes just summed by MEM_tagSum().
+ * ========================================================================== */
+static void MEM_tagPeak(mem_tag_t *const tag, const size_t live_bytes);
 
-function_output:
-  return ret;
-}
+/** ============================================================================
+ *  @brief  Charges or credits a block to its accounting tag.
+ *
+ *  On allocation, the block's payload size is added to the calling thread's
+ *  shard, the shard's net bytes high-water mark is raised and, when the tag
+ *  has a soft limit, the shards are summed to check it. Tags without a
+ *  limit never read the other shards here; MEM_tagPeak() folds the shard
+ *  marks into the tag's peak on the stats path. On free, the payload size
+ *  is credited back. Blocks carrying an unknown tag are accounted to
+ *  MEM_TAG_DEFAULT.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  block     Block being allocated or freed.
+ *  @param[in]  alloc     true on allocation, false on free.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Block accounted.
+ *  @retval -EINVAL:      @p allocator or @p block is NULL.
+ * ========================================================================== */
+static int MEM_tagAccount(mem_allocator_t *const allocator,
+                          block_header_t *const  block,
+                          const bool             alloc);
 
 /** ============================================================================
- *  @brief  Fills a memory block with a specified byte value
- *          using optimized operations.
+ *  @brief  Checks a growth request against the footprint limits.
  *
- *  This function sets each byte in the given memory region to the specified
- *  value. It first advances the pointer to meet the architecture’s alignment
- *  requirements, then writes data in ARCH_ALIGNMENT-sized chunks using 64-bit
- *  stores multiplied by PREFETCH_MULT, with prefetch hints for cache lines.
- *  Any remaining bytes at the end are filled one by one.
+ *  Called before the allocator asks the kernel for @p inc more bytes. A
+ *  request above the hard limit is refused; crossing the soft limit is
+ *  accepted. Both queue a pressure event for MEM_pressureDispatch().
+ *  The soft limit derived from the cgroup is checked against
+ *  memory.current (see mem_limits_t). While the GC thread runs it keeps
+ *  the cgroup snapshot fresh; otherwise a stale snapshot is refreshed
+ *  here.
  *
- *  @param[in]  source  Pointer to the memory block to fill.
- *  @param[in]  value   Byte value to set (0–255).
- *  @param[in]  size    Number of bytes to set.
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  inc       Number of bytes about to be requested.
  *
- *  @return Original source pointer on success,
- *          an error‐encoded pointer (via PTR_ERR()) on failure.
+ *  @return Integer status code.
  *
- *  @retval dest:     Original Pointer on successful operation.
- *  @retval -EINVAL:  Invalid @p src or @p size.
+ *  @retval EXIT_SUCCESS: Growth allowed.
+ *  @retval -EINVAL:      @p allocator is NULL.
+ *  @retval -ENOMEM:      Growth would exceed the hard limit.
  * ========================================================================== */
-void *MEM_memset(void *const source, const int value, const size_t size)
-{
-  void *ret = (void *)NULL;
+static int MEM_checkLimits(mem_allocator_t *const allocator, const size_t inc);
 
-  unsigned char *ptr       = (unsigned char *)NULL;
-  unsigned char *ptr_aux   = (unsigned char *)NULL;
+/** ============================================================================
+ *  @brief  Runs pending pressure callbacks, then compacts and trims the
+ *          allocator.
+ *
+ *  Must be called without holding gc_lock: callbacks are free to call back
+ *  into the public API. Movable blocks are slid down before the trim
+ *  (MEM_compactOp()).
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Nothing pending, or callbacks and trim completed.
+ *  @retval -EINVAL:      @p allocator is NULL.
+ * ========================================================================== */
+static int MEM_pressureDispatch(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Returns free heap memory to the kernel. Caller holds gc_lock.
+ *
+ *  Releases a free block ending at the heap top through sbrk() and applies
+ *  madvise(MADV_DONTNEED) to the page-aligned interior of every other free
+ *  block, leaving headers and canaries resident.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Number of bytes released (>= 0) on success,
+ *          negative error code on failure.
+ *
+ *  @retval -EINVAL:      @p allocator is NULL.
+ * ========================================================================== */
+static intptr_t MEM_trimOp(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Queues a pressure event for MEM_pressureDispatch().
+ *
+ *  A pending event is only ever upgraded (SOFT to HARD), never downgraded.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  level     Pressure severity.
+ *  @param[in]  footprint Footprint reported to the callbacks.
+ * ========================================================================== */
+static void MEM_raisePressure(mem_allocator_t *const     allocator,
+                              const mem_pressure_level_t level,
+                              const size_t               footprint);
+
+/** ============================================================================
+ *  @brief  Reads a single value from a cgroup v2 memory file.
+ *
+ *  @param[in]  dir       cgroup directory.
+ *  @param[in]  file      File name inside @p dir.
+ *  @param[out] value     Parsed value; "max" is reported as SIZE_MAX.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS:   Value parsed.
+ *  @retval -ENOENT:        The file cannot be opened or read.
+ *  @retval -EINVAL:        The file holds no number.
+ *  @retval -ENAMETOOLONG:  Path does not fit in PATH_MAX.
+ * ========================================================================== */
+static int MEM_cgroupRead(const char *const dir,
+                          const char *const file,
+                          size_t *const     value);
+
+/** ============================================================================
+ *  @brief  Locates the cgroup directory of the calling process.
+ *
+ *  Uses MEM_CGROUP_ENV when set, otherwise the "0::" entry of
+ *  /proc/self/cgroup below CGROUP_ROOT.
+ *
+ *  @param[out] dir       Destination buffer of PATH_MAX bytes.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS:   Directory resolved.
+ *  @retval -ENOENT:        No cgroup v2 entry found.
+ *  @retval -ENAMETOOLONG:  Path does not fit in PATH_MAX.
+ * ========================================================================== */
+static int MEM_cgroupResolve(char *const dir);
+
+/** ============================================================================
+ *  @brief  Refreshes the cgroup snapshot and applies the derived tuning.
+ *
+ *  Derives the soft footprint limit and the GC interval (unless limits
+ *  were set by MEM_setLimit()), the reported hard level, the refresh
+ *  period and the cache budget from memory.max, and queues a soft
+ *  pressure event when
+ *  memory.current is already above the soft level. Caller holds gc_lock
+ *  (or is initialising).
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Snapshot refreshed.
+ *  @retval -EINVAL:      @p allocator is NULL.
+ *  @retval ret<0:        Errors returned by MEM_cgroupRead().
+ * ========================================================================== */
+static int MEM_cgroupLoad(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Tells whether the cgroup snapshot is due for a refresh.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return true when the cgroup is enabled and was last read at least
+ *          refresh_ms ago, false otherwise.
+ * ========================================================================== */
+static bool MEM_cgroupDue(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  PSI monitor thread body.
+ *
+ *  Sleeps in poll() on the trigger descriptor and the stop pipe. Each
+ *  POLLPRI event queues a soft pressure event, dispatches it (callbacks and
+ *  trim) and wakes the garbage collector thread. While a cgroup is tracked
+ *  the poll() also times out every refresh_ms, so the cgroup snapshot is
+ *  refreshed (MEM_cgroupLoad()) and any pressure this raises dispatched
+ *  without waiting for heap growth or the GC thread. When it exits on its own
+ *  (poll() failure or POLLERR) while @b running is still set, it clears
+ *  @b running under gc_lock, releases the descriptors (MEM_psiClose()) and
+ *  detaches itself, so MEM_psiMonitorStart() can start a new monitor.
+ *
+ *  @param[in]  arg Pointer to the mem_allocator_t context.
+ *
+ *  @return NULL on clean exit; an error-encoded pointer (via PTR_ERR())
+ *          if poll() fails or the trigger is torn down.
+ * ========================================================================== */
+static void *MEM_psiThreadFunc(void *arg);
+
+/** ============================================================================
+ *  @brief  Closes the PSI trigger and stop pipe and marks them unused.
+ *
+ *  @param[in]  psi       PSI monitor state.
+ * ========================================================================== */
+static void MEM_psiClose(mem_psi_t *const psi);
+
+#if defined(GARBAGE_COLLECTOR)
+
+/** ============================================================================
+ *  @brief  Dedicated thread loop driving mark-and-sweep iterations.
+ *
+ *  This function runs as the GC worker thread.  It locks gc_lock and waits
+ *  on gc_cond until either gc_running or gc_exit is set.  On wakeup, it
+ *  refreshes the cgroup snapshot once refresh_ms elapsed (MEM_cgroupLoad())
+ *  and dispatches any pressure event this raised; then, if gc_exit is
+ *  true, it breaks and exits the loop; otherwise it performs one
+ *  GC cycle, then waits on gc_cond (MEM_gcPaceWait()) until the allocation
+ *  volume since the cycle reaches the trigger, MEM_gcCollect() requests a
+ *  collection, or the idle back-off elapses.  With MEM_gcSetGenerational() enabled, the
+ *  cycle is a minor or full generational one (MEM_gcGenCycle()); else,
+ *  with MEM_gcSetSnapshot() enabled, it is marked by a fork()ed child
+ *  (MEM_gcSnapCycle()). Otherwise, or
+ *  when the snapshot fails, it is mostly concurrent when soft-dirty page
+ *  tracking works (MEM_gcConcurrentCycle()), and else a stop-the-world
+ *  MEM_gcMark() and MEM_gcSweep() with gc_lock held, so no allocation can
+ *  reshape the heap mid-cycle.  With MEM_gcSetLazySweep() enabled, the
+ *  last two leave the sweep to allocations; whatever they did not sweep
+ *  is finished in GC_SLICE_US slices before the next cycle.  A requested
+ *  collection is a full one.  On exit it clears gc_running, wakes
+ *  MEM_gcCollect() callers and ensures gc_lock is released.
+ *
+ *  @param[in]  arg Pointer to the mem_allocator_t context.
+ *
+ *  @return NULL on clean exit; an error-encoded pointer (via PTR_ERR())
+ *          if any initialization or GC step fails.
+ *
+ *  @retval NULL:     Clean exit after gc_exit.
+ *  @retval -EINVAL:  @p arg is NULL.
+ *  @retval ret<0:    cond errors, or MEM_gcMark() / MEM_gcSweep() failures.
+ * ========================================================================== */
+__GC_HOT static void *MEM_gcThreadFunc(void *arg);
+
+/** ============================================================================
+ *  @brief  Runs a mostly-concurrent collection from the GC thread.
+ *
+ *  Must be called with gc_lock held; the lock is dropped between steps.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return EXIT_SUCCESS once the cycle completed or gc_exit was raised,
+ *          negative error code on failure.
+ * ========================================================================== */
+__GC_COLD static int MEM_gcConcurrentCycle(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Runs a collection marked by a fork()ed child from the GC thread.
+ *
+ *  Must be called with gc_lock held; the lock is dropped while the child
+ *  marks and between sweep steps.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return EXIT_SUCCESS once the cycle completed or gc_exit was raised,
+ *          negative error code when no snapshot could be marked.
+ * ========================================================================== */
+__GC_COLD static int MEM_gcSnapCycle(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Collects only the blocks allocated since the last collection.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Minor collection done.
+ *  @retval -ENOMEM:      The mmap index could not be grown.
+ * ========================================================================== */
+__GC_HOT static int MEM_gcMinor(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Runs a minor or, now and then, a full collection.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return EXIT_SUCCESS on success, negative error code on failure.
+ * ========================================================================== */
+__GC_COLD static int MEM_gcGenCycle(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Extends a heap bitmap to cover the current heap, keeping its bits.
+ *
+ *  The bitmap holds one bit per GC_GRANULE bytes of the user heap and lives
+ *  in its own mapping, grown with mremap() as the heap grows. Words that
+ *  come into use are cleared; block headers are not touched.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  bits      Bitmap to extend (mark_bits or start_bits).
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Bitmap covers the heap.
+ *  @retval -ENOMEM:      The bitmap could not be grown.
+ * ========================================================================== */
+__GC_HOT static int MEM_gcBitmapGrow(mem_allocator_t *const allocator,
+                                     gc_bitmap_t *const     bits);
+
+/** ============================================================================
+ *  @brief  Sizes and clears a heap bitmap for a new cycle.
+ *
+ *  Drops every word in use and lets MEM_gcBitmapGrow() cover the heap
+ *  again, so clearing is a single MEM_memset(); block headers are not
+ *  touched.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  bits      Bitmap to reset (mark_bits or start_bits).
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Bitmap covers the heap and is clear.
+ *  @retval -ENOMEM:      The bitmap could not be grown.
+ * ========================================================================== */
+__GC_HOT static int MEM_gcBitmapReset(mem_allocator_t *const allocator,
+                                      gc_bitmap_t *const     bits);
+
+/** ============================================================================
+ *  @brief  Makes a side bitmap hold @p need words, keeping its bits.
+ *
+ *  The bitmap lives in its own mapping, created with mmap() and grown with
+ *  mremap() to twice the need. Words that come into use are cleared.
+ *
+ *  @param[in]  bits Bitmap to extend.
+ *  @param[in]  need Words the bitmap must cover.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Bitmap holds @p need words.
+ *  @retval -ENOMEM:      The bitmap could not be grown.
+ * ========================================================================== */
+__GC_HOT static int MEM_gcBitmapCover(gc_bitmap_t *const bits,
+                                      const size_t       need);
+
+/** ============================================================================
+ *  @brief  Starts a new blacklist cycle. Caller holds gc_lock.
+ *
+ *  The current table becomes the previous one, and the other table is
+ *  cleared and sized to the heap plus GC_BLACKLIST_SLACK. Pages hit by the
+ *  last two cycles are thus avoided, while pages no longer referenced are
+ *  released after one cycle. Cycles marked by a fork()ed child record
+ *  nothing, since the child's writes are lost.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Blacklist rotated.
+ *  @retval -ENOMEM:      The new table could not be grown.
+ * ========================================================================== */
+__GC_COLD static int MEM_gcBlacklistRotate(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Records a scanned word that resolved to no allocated block.
+ *
+ *  Words pointing into the range covered by the current table blacklist
+ *  their page; anything else is ignored. Mark workers race on the table,
+ *  so the bit is set with an atomic fetch-or.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  addr      Scanned word.
+ * ========================================================================== */
+__GC_HOT static void MEM_gcBlacklistAdd(mem_allocator_t *const allocator,
+                                        const uintptr_t        addr);
+
+/** ============================================================================
+ *  @brief  Tells whether an allocation split from a block would sit on a
+ *          blacklisted page.
+ *
+ *  Checks the payload a split of @p size bytes would hand out against
+ *  both tables and counts the block as avoided. The check is skipped while
+ *  @b bypass is set or once the heap grew by GC_BLACKLIST_GROW this cycle.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  block     Candidate free block.
+ *  @param[in]  size      Total size requested (including header and canary).
+ *
+ *  @return true if the block should be passed over.
+ * ========================================================================== */
+__GC_HOT static bool MEM_gcBlacklisted(mem_allocator_t *const allocator,
+                                       block_header_t *const  block,
+                                       const size_t           size);
+
+/** ============================================================================
+ *  @brief  Tests whether a block carries a GC mark.
+ *
+ *  Heap blocks are looked up in the mark bitmap; mmap blocks, which lie
+ *  outside it, keep using their header flag.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  block     Block header.
+ *
+ *  @return true if @p block is marked.
+ * ========================================================================== */
+__GC_HOT static bool MEM_gcIsMarked(mem_allocator_t *const allocator,
+                                    block_header_t *const  block);
+
+/** ============================================================================
+ *  @brief  Marks a block, reporting whether it was unmarked before.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  block     Block header.
+ *
+ *  @return true if this call set the mark.
+ * ========================================================================== */
+__GC_HOT static bool MEM_gcSetMark(mem_allocator_t *const allocator,
+                                   block_header_t *const  block);
+
+/** ============================================================================
+ *  @brief  Records the start of every allocated heap block in start_bits.
+ *
+ *  One pass over the block headers, before the world is stopped, lets
+ *  MEM_gcFindBlock() resolve interior pointers and lets MEM_gcSweep() find
+ *  unmarked blocks word by word. Only a header with a valid magic and an
+ *  aligned size is stepped over; anything else, such as chunks another
+ *  allocator placed on the program break, is skipped a granule at a time.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Heap indexed.
+ *  @retval -ENOMEM:      The start bitmap could not be grown.
+ * ========================================================================== */
+__GC_HOT static int MEM_gcIndexHeap(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  qsort() comparator ordering mmap ranges by start address.
+ *
+ *  @param[in]  lhs First gc_map_range_t.
+ *  @param[in]  rhs Second gc_map_range_t.
+ *
+ *  @return Negative, zero or positive as @p lhs starts before, with or
+ *          after @p rhs.
+ * ========================================================================== */
+static int MEM_gcRangeCompare(const void *lhs, const void *rhs);
+
+/** ============================================================================
+ *  @brief  Builds the sorted payload index of live mmap blocks.
+ *
+ *  The index lives in its own mapping, grown with mremap(); MEM_gcFindBlock()
+ *  binary-searches it instead of walking mmap_list for every word.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Index built.
+ *  @retval -ENOMEM:      The index could not be grown.
+ * ========================================================================== */
+__GC_HOT static int MEM_gcIndexMaps(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Finds the allocated heap block whose payload contains an address.
+ *
+ *  Looks up the nearest block start at or below @p addr in start_bits,
+ *  scanning backwards a 64-bit word at a time.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  addr      Heap address inside the indexed range.
+ *
+ *  @return Header of the containing block, or NULL.
+ * ========================================================================== */
+__GC_HOT static block_header_t *MEM_gcFindHeapBlock(
+  mem_allocator_t *const allocator,
+  const uintptr_t        addr);
+
+/** ============================================================================
+ *  @brief  Reset “marked” flags across all allocated regions.
+ *
+ *  This function prepares for a new garbage-collection cycle by clearing the
+ *  mark of every heap block and every mmap’d block payload.  Heap marks live
+ *  in the side bitmap and are cleared at once by MEM_gcBitmapReset(), without
+ *  touching any block header.  The GC blacklist moves on to a new table
+ *  (MEM_gcBlacklistRotate()).  It then builds the lookup structures used to
+ *  resolve interior pointers (MEM_gcIndexHeap(), MEM_gcIndexMaps()) and
+ *  iterates allocator->mmap_list, clearing the mark on each payload block.
+ *  mmap metadata headers are unmarked too, so tracing never scans them;
+ *  MEM_gcMark() pins them once tracing is done.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: All marks cleared.
+ *  @retval -EINVAL:      @p allocator is NULL.
+ *  @retval -ENOMEM:      A bitmap or the mmap index could not be grown.
+ * ========================================================================== */
+__GC_HOT static int MEM_setInitialMarks(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Maps a candidate pointer to the live block it references.
+ *
+ *  Quiet counterpart of MEM_validateBlock() used while marking: arbitrary
+ *  words are tested without logging. A word may point anywhere inside a
+ *  payload. Heap words are resolved through the block-start bitmap
+ *  (MEM_gcFindHeapBlock()); other words are binary-searched in the sorted
+ *  mmap index.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  addr      Candidate pointer value.
+ *
+ *  @return Header of the allocated block referenced by @p addr, or NULL.
+ * ========================================================================== */
+__GC_HOT static block_header_t *MEM_gcFindBlock(
+  mem_allocator_t *const allocator,
+  const uintptr_t        addr);
+
+/** ============================================================================
+ *  @brief  Pushes a freshly marked block on the mark stack.
+ *
+ *  The stack lives in its own mapping and doubles via mremap() up to
+ *  GC_MARK_STACK_MAX entries. When it cannot grow, the block is dropped and
+ *  the overflow flag is raised; MEM_gcMark() then rescans marked blocks.
+ *  The stack's spin lock is held, since idle workers steal from it.
+ *
+ *  @param[in]  stack Mark stack of the calling worker.
+ *  @param[in]  block Block to scan later.
+ * ========================================================================== */
+__GC_HOT static void MEM_gcPush(gc_mark_stack_t *const stack,
+                                block_header_t *const  block);
+
+/** ============================================================================
+ *  @brief  Conservatively scans a memory range for block references.
+ *
+ *  Every aligned word in [@p start, @p end) that references an unmarked
+ *  live block marks it and pushes it on @p stack, unless the block has the
+ *  MEM_LAYOUT_ATOMIC layout: its payload is never scanned. Words that
+ *  reference no block are handed to MEM_gcBlacklistAdd().
+ *
+ *  Words are loaded GC_SCAN_LANES at a time and range-checked against
+ *  MEM_gcScanWindow() with vector compares; only the words inside a window
+ *  reach MEM_gcScanWord(). The remaining tail is checked one word at a time.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  stack     Mark stack of the calling worker.
+ *  @param[in]  start     First byte of the range.
+ *  @param[in]  end       One past the last byte of the range.
+ * ========================================================================== */
+__GC_HOT static void MEM_gcScanRange(mem_allocator_t *const allocator,
+                                     gc_mark_stack_t *const stack,
+                                     uintptr_t              start,
+                                     const uintptr_t        end);
+
+/** ============================================================================
+ *  @brief  Computes the address windows of MEM_gcScanRange().
+ *
+ *  The heap window spans the block-start bitmap base up to the heap end or
+ *  the blacklist table end, whichever is higher; the mmap window spans the
+ *  sorted mmap index. Every word MEM_gcFindBlock() or MEM_gcBlacklistAdd()
+ *  can act on falls in one of them.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[out] window    Windows to fill.
+ * ========================================================================== */
+__GC_HOT static void MEM_gcScanWindow(mem_allocator_t *const  allocator,
+                                      gc_scan_window_t *const window);
+
+/** ============================================================================
+ *  @brief  Marks the block a candidate word references.
+ *
+ *  Marks the referenced live block and pushes it on @p stack, unless it has
+ *  the MEM_LAYOUT_ATOMIC layout. A word that references no block is handed
+ *  to MEM_gcBlacklistAdd().
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  stack     Mark stack of the calling worker.
+ *  @param[in]  word      Scanned word inside a window of MEM_gcScanWindow().
+ * ========================================================================== */
+__GC_HOT static void MEM_gcScanWord(mem_allocator_t *const allocator,
+                                    gc_mark_stack_t *const stack,
+                                    const uintptr_t        word);
+
+/** ============================================================================
+ *  @brief  Scans the part [@p first, @p last) of a block's payload.
+ *
+ *  Conservative blocks are scanned word by word. Blocks with a registered
+ *  layout only have their pointer words scanned: the layout describes one
+ *  element and repeats over the payload, so arrays of a type share it.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  stack     Mark stack of the calling worker.
+ *  @param[in]  block     Marked block owning the range.
+ *  @param[in]  first     First payload byte to scan.
+ *  @param[in]  last      One past the last payload byte to scan.
+ * ========================================================================== */
+__GC_HOT static void MEM_gcScanPayload(mem_allocator_t *const allocator,
+                                       gc_mark_stack_t *const stack,
+                                       block_header_t *const  block,
+                                       const uintptr_t        first,
+                                       const uintptr_t        last);
+
+/** ============================================================================
+ *  @brief  Scans the payload of marked blocks until the mark stack is empty.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  stack     Mark stack of the calling worker.
+ * ========================================================================== */
+__GC_HOT static void MEM_gcDrain(mem_allocator_t *const allocator,
+                                 gc_mark_stack_t *const stack);
+
+/** ============================================================================
+ *  @brief  Recovers from a mark stack overflow.
+ *
+ *  Rescans the payload of every marked heap and mmap block, draining after
+ *  each one, so that children dropped on overflow get marked. Heap blocks
+ *  are enumerated from the set bits of the mark bitmap.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+__GC_COLD static void MEM_gcRescan(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Acquires the spin lock of a mark stack.
+ *
+ *  @param[in]  stack Mark stack.
+ * ========================================================================== */
+__GC_HOT static void MEM_gcStackLock(gc_mark_stack_t *const stack);
+
+/** ============================================================================
+ *  @brief  Releases the spin lock of a mark stack.
+ *
+ *  @param[in]  stack Mark stack.
+ * ========================================================================== */
+__GC_HOT static void MEM_gcStackUnlock(gc_mark_stack_t *const stack);
+
+/** ============================================================================
+ *  @brief  Pops the most recently pushed block from a mark stack.
+ *
+ *  @param[in]  stack Mark stack.
+ *
+ *  @return Block to scan, or NULL when the stack is empty.
+ * ========================================================================== */
+__GC_HOT static block_header_t *MEM_gcPop(gc_mark_stack_t *const stack);
+
+/** ============================================================================
+ *  @brief  Moves pending blocks from another worker's mark stack.
+ *
+ *  Victims are tried round-robin starting after the thief. Half of the
+ *  first non-empty stack, at most GC_STEAL_BATCH entries, is taken from its
+ *  top and pushed on the thief's own stack.
+ *
+ *  @param[in]  pool  Worker pool.
+ *  @param[in]  thief Worker looking for work.
+ *
+ *  @return Number of entries stolen.
+ * ========================================================================== */
+__GC_HOT static size_t MEM_gcSteal(gc_pool_t *const   pool,
+                                   gc_worker_t *const thief);
+
+/** ============================================================================
+ *  @brief  Parallel mark loop of one worker.
+ *
+ *  Drains the worker's own stack, then steals from the others. A worker
+ *  that finds no work counts itself idle and polls the other stacks; the
+ *  phase ends once every active worker is idle. Only busy workers push, so
+ *  at that point every stack is empty.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  worker    Calling worker.
+ * ========================================================================== */
+__GC_HOT static void MEM_gcMarkWorker(mem_allocator_t *const allocator,
+                                      gc_worker_t *const     worker);
+
+/** ============================================================================
+ *  @brief  Records the unreachable heap blocks of one sweep partition.
+ *
+ *  Walks start_bits & ~mark_bits over the worker's [first, last) bitmap
+ *  words and pushes every candidate that is still an allocated block on the
+ *  worker's stack, in address order. Nothing is freed: MEM_gcSweepRun() is
+ *  not thread-safe, so MEM_gcSweep() releases the lists afterwards.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  worker    Calling worker.
+ * ========================================================================== */
+__GC_HOT static void MEM_gcSweepCollect(mem_allocator_t *const allocator,
+                                        gc_worker_t *const     worker);
+
+/** ============================================================================
+ *  @brief  Tells whether a heap block was allocated but left unmarked.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  block     Heap block header.
+ *
+ *  @return true if start_bits has @p block and mark_bits does not.
+ * ========================================================================== */
+__GC_HOT static bool MEM_gcIsDead(mem_allocator_t *const allocator,
+                                  block_header_t *const  block);
+
+/** ============================================================================
+ *  @brief  Frees a dead heap block together with its dead and free
+ *          neighbours, as one free block.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  block     Unmarked, allocated heap block.
+ *
+ *  @return Header of the resulting free block.
+ * ========================================================================== */
+__GC_HOT static block_header_t *MEM_gcSweepRun(
+  mem_allocator_t *const allocator,
+  block_header_t *const  block);
+
+/** ============================================================================
+ *  @brief  Frees the unreachable heap blocks of a bitmap word range.
+ *
+ *  Serial sweep used with a single worker, or for a partition whose list
+ *  overflowed its mark stack.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  first     First bitmap word.
+ *  @param[in]  last      One past the last bitmap word.
+ *
+ *  @return The free block the sweep left at the heap top, or NULL.
+ * ========================================================================== */
+__GC_HOT static block_header_t *MEM_gcSweepWords(
+  mem_allocator_t *const allocator,
+  const size_t           first,
+  const size_t           last);
+
+/** ============================================================================
+ *  @brief  Body of a parallel mark/sweep pool thread.
+ *
+ *  Waits on the pool's wake condition for a new phase, runs its share of
+ *  the work and reports completion, until the pool is stopped.
+ *
+ *  @param[in]  arg Pointer to the gc_worker_t of this thread.
+ *
+ *  @return NULL.
+ * ========================================================================== */
+static void *MEM_gcPoolThread(void *arg);
+
+/** ============================================================================
+ *  @brief  Prepares the worker pool for a cycle. Caller holds gc_lock.
+ *
+ *  Resolves the worker count on first use (MEM_GC_WORKERS_ENV, default 1),
+ *  creates missing pool threads and fixes the number of active workers for
+ *  the cycle. Runs before the world is stopped; a thread that cannot be
+ *  created only lowers the worker count.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+__GC_COLD static void MEM_gcPoolStart(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Starts a phase on the pool threads.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  phase     Work to run.
+ * ========================================================================== */
+static void MEM_gcPoolBegin(mem_allocator_t *const allocator,
+                            const gc_phase_t       phase);
+
+/** ============================================================================
+ *  @brief  Waits until every pool thread finished the current phase.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+static void MEM_gcPoolWait(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Joins the pool threads and releases the worker mark stacks.
+ *
+ *  The configured worker count is kept for the next MEM_runGc().
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+__GC_COLD static void MEM_gcPoolStop(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Parks a registered thread until the collector restarts the world.
+ *
+ *  Records the address of a local as the thread's stack pointer; the kernel
+ *  saved the interrupted registers above it, on the same stack. Only
+ *  async-signal-safe calls are made.
+ *
+ *  @param[in]  sig Signal number (unused).
+ * ========================================================================== */
+static void MEM_gcSuspendHandler(int sig);
+
+/** ============================================================================
+ *  @brief  Wakes a parked thread out of sigsuspend(); does nothing else.
+ *
+ *  @param[in]  sig Signal number (unused).
+ * ========================================================================== */
+static void MEM_gcRestartHandler(int sig);
+
+/** ============================================================================
+ *  @brief  Installs the stop-the-world signal handlers once per process.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Handlers installed (or already installed).
+ *  @retval -errno:       sem_init() or sigaction() failed.
+ * ========================================================================== */
+__GC_COLD static int MEM_gcInstallSignals(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Adds a thread to the GC root registry. Caller holds gc_lock.
+ *
+ *  The thread's stack bounds are queried once here, through
+ *  MEM_stackBounds(), and cached in its registry slot. When @p thread is
+ *  the caller, @b exit_key is set so that MEM_gcThreadExit() drops the
+ *  slot if the thread exits without unregistering.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  thread    Thread to register.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Thread registered.
+ *  @retval -EALREADY:    Thread already registered.
+ *  @retval -ENOSPC:      MEM_GC_MAX_THREADS threads already registered.
+ *  @retval ret>0:        Error code returned by MEM_stackBounds().
+ * ========================================================================== */
+__GC_COLD static int MEM_gcRegister(mem_allocator_t *const allocator,
+                                    const pthread_t        thread);
+
+/** ============================================================================
+ *  @brief  Removes a thread from the GC root registry. Caller holds gc_lock.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  thread    Thread to unregister.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Thread unregistered.
+ *  @retval -ENOENT:      Thread was not registered.
+ * ========================================================================== */
+__GC_COLD static int MEM_gcUnregister(mem_allocator_t *const allocator,
+                                      const pthread_t        thread);
+
+/** ============================================================================
+ *  @brief  @b exit_key destructor; unregisters a thread that is exiting.
+ *
+ *  Runs on the exiting thread, so its slot is released before its
+ *  pthread_t becomes invalid and MEM_gcStopWorld() never signals it.
+ *
+ *  @param[in]  arg Memory allocator context the thread registered with.
+ * ========================================================================== */
+__GC_COLD static void MEM_gcThreadExit(void *arg);
+
+/** ============================================================================
+ *  @brief  Parks every registered thread except the caller.
+ *
+ *  Sends GC_SUSPEND_SIGNAL to each registered thread and waits until all of
+ *  them acknowledged from their handler. A thread reported gone (ESRCH)
+ *  exited without unregistering; its slot is dropped. Threads that cannot
+ *  be signalled otherwise are skipped and scanned over their full stack.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+__GC_HOT static void MEM_gcStopWorld(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Restarts the threads parked by MEM_gcStopWorld().
+ *
+ *  Waits for every thread to leave its handler, so a following stop cannot
+ *  consume a stale acknowledgement, then charges the pause to the current
+ *  cycle's metrics.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+__GC_HOT static void MEM_gcStartWorld(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  dl_iterate_phdr() callback recording writable PT_LOAD segments.
+ *
+ *  @param[in]  info Loaded object description.
+ *  @param[in]  size Size of @p info (unused).
+ *  @param[in]  data Memory allocator context.
+ *
+ *  @return 0 to continue the iteration.
+ * ========================================================================== */
+static int MEM_gcPhdrCallback(struct dl_phdr_info *info,
+                              size_t               size,
+                              void                *data);
+
+/** ============================================================================
+ *  @brief  Scans a root range, skipping the allocator's own state.
+ *
+ *  The allocator lives in a writable segment and holds pointers to its own
+ *  bookkeeping blocks, which must not act as roots.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  start     First byte of the range.
+ *  @param[in]  end       One past the last byte of the range.
+ * ========================================================================== */
+__GC_HOT static void MEM_gcScanRoot(mem_allocator_t *const allocator,
+                                    const uintptr_t        start,
+                                    const uintptr_t        end);
+
+/** ============================================================================
+ *  @brief  Records the writable segments of every loaded object.
+ *
+ *  Runs before the world is stopped: dl_iterate_phdr() takes a lock a
+ *  parked thread may hold. Thread stack bounds are cached at registration.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+__GC_HOT static void MEM_gcCollectRoots(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Scans the live stack of every registered thread.
+ *
+ *  Parked threads are scanned from the stack pointer captured by their
+ *  suspend handler; the calling thread from @p own_sp. Threads that were not
+ *  parked are scanned over their whole stack.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  own_sp    Stack address inside the caller's current frame.
+ *
+ *  @return Number of stack bytes scanned.
+ * ========================================================================== */
+__GC_HOT static size_t MEM_gcScanThreads(mem_allocator_t *const allocator,
+                                         const uintptr_t        own_sp);
+
+/** ============================================================================
+ *  @brief  Scans every root while the world is stopped.
+ *
+ *  Scans the caller's saved registers, the live stack of every registered
+ *  thread, the global segments collected by MEM_gcCollectRoots() and the
+ *  movable allocation table, all onto the collector's mark stack.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  registers Registers saved with getcontext() in the caller's
+ *                        frame; also bounds the caller's own stack scan.
+ *
+ *  @return Number of stack bytes scanned.
+ * ========================================================================== */
+__GC_HOT static size_t MEM_gcScanRoots(mem_allocator_t *const allocator,
+                                       ucontext_t *const      registers);
+
+/** ============================================================================
+ *  @brief  Mark all live blocks transitively reachable from the roots.
+ *
+ *  This function performs the marking phase of garbage collection by:
+ *    - Abandoning any incremental cycle in progress (MEM_gcStep()).
+ *    - Collecting the writable segments of every loaded object via
+ *      MEM_gcCollectRoots(); thread stack bounds are cached at registration.
+ *    - Starting the worker pool threads (MEM_gcPoolStart()).
+ *    - Calling MEM_setInitialMarks() to clear previous marks.
+ *    - Saving the caller's registers with getcontext(), which, unlike
+ *      setjmp(), stores the frame and stack pointers unmangled.
+ *    - Stopping every other registered thread with MEM_gcStopWorld().
+ *    - Waking the pool workers, which steal from the collector's stack.
+ *    - Conservatively scanning the context, the live part of each registered
+ *      stack and the global segments; every word referencing a live heap or
+ *      mmap payload marks that block and pushes it on the mark stack.
+ *    - Draining the mark stacks in parallel, each worker scanning marked
+ *      payloads and stealing when its own stack runs dry, so everything
+ *      reachable through heap objects is marked.
+ *    - On mark stack overflow, rescanning all marked blocks serially until
+ *      no entry was dropped.
+ *    - Restarting the world with MEM_gcStartWorld().
+ *    - Marking the mmap metadata headers so the sweep keeps them.
+ *
+ *  Unregistered threads are neither stopped nor scanned.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: All reachable blocks marked successfully.
+ *  @retval -EINVAL:      @p allocator is NULL.
+ *  @retval -ENOMEM:      A bitmap or the mmap index could not be grown.
+ * ========================================================================== */
+__GC_HOT static int MEM_gcMark(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Reclaim any unmarked blocks from heap and mmap regions.
+ *
+ *  This function performs the “sweep” phase of garbage collection:
+ *    - It walks the heap one bitmap word at a time:
+ *        • Candidates are start_bits & ~mark_bits, i.e. blocks that were
+ *          allocated when the cycle began but were not reached.
+ *        • Each candidate still allocated starts a MEM_gcSweepRun(), which
+ *          frees it with its dead and free neighbours as one free block,
+ *          inserted once. The heap top is trimmed once, at the end
+ *          (MEM_shrinkTail()), rather than by each free.
+ *        • Surviving block headers are neither read nor written, and words
+ *          with no candidates are skipped without touching the heap.
+ *        • With several workers, the bitmap is split into one contiguous
+ *          word range per worker; each collects its candidates in parallel
+ *          (MEM_gcSweepCollect()) and the lists are then swept in address
+ *          order on the caller. A partition whose list overflowed is swept
+ *          serially instead.
+ *    - It then traverses allocator->mmap_list via a pointer-to-pointer scan:
+ *        • Logs each mmap’d region’s status.
+ *        • If an mmap’d block is unmarked and not already free, unlinks
+ *          the mmap_t node, calls munmap() on the region, and frees its
+ *          metadata header via MEM_freeOp().
+ *        • Otherwise, clears the block’s marked flag and advances to the next
+ * node.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: All unreachable blocks reclaimed successfully.
+ *  @retval -EINVAL:      @p allocator is NULL.
+ *  @retval ret<0:        Errors returned by MEM_freeOp(),
+ *                        munmap(), or internal validation functions.
+ * ========================================================================== */
+__GC_HOT static int MEM_gcSweep(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Unmaps the mmap blocks left unmarked by the mark phase.
+ *
+ *  Traverses allocator->mmap_list via a pointer-to-pointer scan. An mmap'd
+ *  block that is unmarked and not already free is released with
+ *  MEM_gcFreeMap(); the others get their mark cleared, unless generational
+ *  mode keeps it to flag them old.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+__GC_HOT static void MEM_gcSweepMaps(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Unlinks and unmaps an unreachable mmap block.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  scan      Link in allocator->mmap_list pointing to the block.
+ * ========================================================================== */
+__GC_HOT static void MEM_gcFreeMap(mem_allocator_t *const allocator,
+                                   mmap_t **const         scan);
+
+/** ============================================================================
+ *  @brief  Keeps the GC tables in step with the heap during an incremental
+ *          cycle.
+ *
+ *  Called by MEM_allocOp() and MEM_freeOp() for every block that changes
+ *  state. Outside GC_INCR_IDLE, an allocated block is marked at once, so
+ *  the cycle keeps it and scans it when tracing ends; a freed block loses
+ *  its start and mark bits, or its mmap index entry, so stale mark stack
+ *  entries and interior pointers into it are ignored. The bitmaps are grown
+ *  when the heap did. Between collections in generational mode, the same
+ *  bookkeeping runs, except that new blocks are left unmarked (young).
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  block     Block header.
+ *  @param[in]  allocated true on allocation, false on release.
+ * ========================================================================== */
+__GC_HOT static void MEM_gcTrack(mem_allocator_t *const allocator,
+                                 block_header_t *const  block,
+                                 const bool             allocated);
+
+/** ============================================================================
+ *  @brief  Reads CLOCK_MONOTONIC in nanoseconds.
+ *
+ *  @return Current time.
+ * ========================================================================== */
+static uint64_t MEM_gcClockNs(void);
+
+/** ============================================================================
+ *  @brief  Clears the soft-dirty bits of every page of the process.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Bits cleared.
+ *  @retval ret<0:        Negated errno of open() or write().
+ * ========================================================================== */
+__GC_COLD static int MEM_gcDirtyClear(void);
+
+/** ============================================================================
+ *  @brief  Tells whether soft-dirty page tracking works, probing it once.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return true when clear_refs and pagemap report page writes and
+ *          tracking is allowed by MEM_gcSetDirtyTracking().
+ * ========================================================================== */
+__GC_COLD static bool MEM_gcDirtyProbe(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Rescans the part of the marked heap blocks lying in a range.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  lo        Range start (a dirty page).
+ *  @param[in]  hi        Range end.
+ * ========================================================================== */
+__GC_HOT static void MEM_gcDirtyHeap(mem_allocator_t *const allocator,
+                                     const uintptr_t        lo,
+                                     const uintptr_t        hi);
+
+/** ============================================================================
+ *  @brief  Rescans the soft-dirty pages of a range.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  fd        Open /proc/self/pagemap.
+ *  @param[in]  lo        Range start.
+ *  @param[in]  hi        Range end.
+ *  @param[in]  owner     NULL for the sbrk heap, else the mmap block whose
+ *                        payload the range is.
+ *  @param[out] pages     Incremented by the dirty pages rescanned.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Range rescanned.
+ *  @retval -EIO:         pagemap could not be read.
+ * ========================================================================== */
+__GC_HOT static int MEM_gcDirtyRange(mem_allocator_t *const allocator,
+                                     const int              fd,
+                                     const uintptr_t        lo,
+                                     const uintptr_t        hi,
+                                     block_header_t *const  owner,
+                                     size_t *const          pages);
+
+/** ============================================================================
+ *  @brief  Rescans the marked blocks on pages written since the cycle began.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[out] pages     Number of dirty pages rescanned.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Dirty pages rescanned.
+ *  @retval ret<0:        pagemap could not be opened or read.
+ * ========================================================================== */
+__GC_COLD static int MEM_gcRemarkDirty(mem_allocator_t *const allocator,
+                                       size_t *const          pages);
+
+/** ============================================================================
+ *  @brief  Starts an incremental cycle.
+ *
+ *  Clears the marks, indexes the heap and mmap blocks, then stops the world
+ *  only to scan the roots onto the collector's mark stack and to clear the
+ *  soft-dirty bits, when the kernel has them.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Cycle started.
+ *  @retval -ENOMEM:      A bitmap or the mmap index could not be grown.
+ * ========================================================================== */
+__GC_COLD static int MEM_gcIncrBegin(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Traces from the mark stack until it is empty or time is up.
+ *
+ *  Runs with mutators going; only gc_lock is held. Entries whose block was
+ *  freed since it was pushed are dropped.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  deadline  CLOCK_MONOTONIC time, in nanoseconds, to stop at.
+ *
+ *  @return true once the mark stack is empty.
+ * ========================================================================== */
+__GC_HOT static bool MEM_gcIncrMark(mem_allocator_t *const allocator,
+                                    const uint64_t         deadline);
+
+/** ============================================================================
+ *  @brief  Ends the tracing of an incremental cycle.
+ *
+ *  With the world stopped, rescans the roots and the marked blocks a
+ *  mutator may have stored a pointer into between steps: those on
+ *  soft-dirty pages, or all of them without tracking. Then pins the mmap
+ *  metadata headers and moves the cycle to GC_INCR_SWEEP.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+__GC_COLD static void MEM_gcIncrFinish(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Sweeps bitmap words from the cursor until done or time is up.
+ *
+ *  Frees unmarked heap blocks GC_SWEEP_CHUNK words at a time with
+ *  MEM_gcSweepWords(); once the heap is swept, sweeps the mmap blocks and
+ *  ends the cycle.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  deadline  CLOCK_MONOTONIC time, in nanoseconds, to stop at.
+ *
+ *  @return true once the cycle is complete.
+ * ========================================================================== */
+__GC_HOT static bool MEM_gcIncrSweep(mem_allocator_t *const allocator,
+                                     const uint64_t         deadline);
+
+/** ============================================================================
+ *  @brief  Advances the incremental cycle for about @p budget_us.
+ *
+ *  Must be called with gc_lock held. Starts a cycle when none is in
+ *  progress, then traces, finishes tracing and sweeps in turn until the
+ *  budget is spent or the cycle completes. Each call makes some progress,
+ *  even with a zero budget.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  budget_us Time budget, in microseconds.
+ *
+ *  @return EXIT_SUCCESS while the cycle is in progress, MEM_GC_CYCLE_DONE
+ *          when it completed, -EBUSY while a fork() snapshot is being
+ *          collected, negative error code on failure.
+ * ========================================================================== */
+__GC_HOT static int MEM_gcStepOp(mem_allocator_t *const allocator,
+                                 const uint32_t         budget_us);
+
+/** ============================================================================
+ *  @brief  Charges an allocation to the mutator assist debt.
+ *
+ *  Does nothing unless assists are enabled and an incremental cycle is in
+ *  progress. Once the debt reaches GC_ASSIST_QUANTUM, the calling thread
+ *  takes gc_lock and runs a step sized by MEM_gcSetAssist().
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  bytes     Bytes just allocated.
+ * ========================================================================== */
+__GC_HOT static void MEM_gcAssist(mem_allocator_t *const allocator,
+                                  const size_t           bytes);
+
+/** ============================================================================
+ *  @brief  Sweeps the next GC_SWEEP_CHUNK bitmap words for an allocation.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return true if words were swept and a free-list search may now succeed,
+ *          false when no lazy sweep is pending.
+ * ========================================================================== */
+__GC_HOT static bool MEM_gcLazySweep(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Charges an allocation to the GC trigger.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  bytes     Bytes just allocated.
+ * ========================================================================== */
+__GC_HOT static void MEM_gcPace(mem_allocator_t *const allocator,
+                                const size_t           bytes);
+
+/** ============================================================================
+ *  @brief  Records the end of a GC thread cycle and sets the next trigger.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+__GC_COLD static void MEM_gcPaceDone(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Waits, in the GC thread, until the next cycle is due.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+__GC_COLD static void MEM_gcPaceWait(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Sums the live payload bytes of every accounting tag.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Live bytes of the allocator.
+ * ========================================================================== */
+__GC_COLD static size_t MEM_gcLiveBytes(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Opens the metrics of a GC cycle. Caller holds gc_lock.
+ *
+ *  Drops any cycle left open, clears the scan and mark counters of every
+ *  worker and samples the live heap.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  kind      How the cycle runs.
+ * ========================================================================== */
+__GC_COLD static void MEM_gcStatsBegin(mem_allocator_t *const allocator,
+                                       const mem_gc_kind_t    kind);
+
+/** ============================================================================
+ *  @brief  Records the GC cycle whose sweep just completed. Caller holds
+ *          gc_lock.
+ *
+ *  Sums the workers' counters, samples the live heap, stores the cycle in
+ *  the ring, adds it to the totals and logs it. Does nothing when no cycle
+ *  is open.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+__GC_COLD static void MEM_gcStatsEnd(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Forks a child that marks a copy-on-write snapshot of the heap.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Child marking.
+ *  @retval -ENOMEM:      The bitmaps or the report could not be mapped.
+ *  @retval ret<0:        Negated errno of fork().
+ * ========================================================================== */
+__GC_COLD static int MEM_gcSnapBegin(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Marks the snapshot and writes the report; runs in the child.
+ *
+ *  @param[in]  allocator Memory allocator context (the child's copy).
+ *  @param[in]  registers Registers spilled by the parent before fork().
+ * ========================================================================== */
+__GC_COLD static void MEM_gcSnapMark(mem_allocator_t *const allocator,
+                                     ucontext_t *const      registers);
+
+/** ============================================================================
+ *  @brief  Waits for the marking child and checks its report.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Report complete.
+ *  @retval -ECHILD:      The child ended without a complete report.
+ *  @retval ret<0:        Negated errno of waitpid().
+ * ========================================================================== */
+__GC_COLD static int MEM_gcSnapWait(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Frees reported blocks from the cursor until done or time is up.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  deadline  CLOCK_MONOTONIC time, in nanoseconds, to stop at.
+ *
+ *  @return true once every reported block was handled.
+ * ========================================================================== */
+__GC_HOT static bool MEM_gcSnapSweep(mem_allocator_t *const allocator,
+                                     const uint64_t         deadline);
+
+/** ============================================================================
+ *  @brief  Releases the report and ends the snapshot cycle.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+__GC_COLD static void MEM_gcSnapEnd(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Start or signal the GC thread to perform a collection cycle.
+ *
+ *  This function saves the caller’s thread ID as main_thread, locks gc_lock,
+ *  installs the stop-the-world handlers, registers the caller as a root
+ *  thread, and if the GC thread has not been started, sets gc_running and
+ *  gc_exit flags and spawns MEM_gcThreadFunc(); otherwise it sets gc_running
+ *  and signals gc_cond to wake the existing thread.  Finally it unlocks
+ *  gc_lock.
+ *
+ *  @param[in]  allocator Pointer to the mem_allocator_t context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: GC thread started or signaled successfully.
+ *  @retval -EINVAL:      @p allocator is NULL.
+ *  @retval ret<0:        Negated error code returned by pthread_create().
+ * ========================================================================== */
+__GC_COLD static int MEM_runGc(mem_allocator_t *const allocator);
+
+/** ============================================================================
+ *  @brief  Stop the GC thread and perform a final collection.
+ *
+ *  This function clears gc_running and sets gc_exit under gc_lock, signals
+ *  gc_cond to wake the GC thread if it’s running, then joins it without the
+ *  lock held.  After the thread exits, it runs one final MEM_gcMark() +
+ *  MEM_gcSweep() on the caller thread under gc_lock to reclaim any remaining
+ *  garbage, clears gc_thread_started, joins the mark/sweep worker pool and
+ *  releases the mark stacks, bitmaps and mmap index.
+ *
+ *  @param[in]  allocator Pointer to the mem_allocator_t context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: GC thread stopped and final collection done.
+ *  @retval -EINVAL:      @p allocator is NULL.
+ *  @retval ret<0:        Error code from pthread MEM_gcMark(), or
+ * MEM_gcSweep().
+ * ========================================================================== */
+__GC_COLD static int MEM_stopGc(mem_allocator_t *const allocator);
+
+#endif
+
+/** ============================================================================
+ *              	P R I V A T E  G L O B A L  V A R I A B L E S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @var        g_allocator
+ *  @brief      Process-wide default allocator instance.
+ *
+ *  @details    Statically allocated allocator used when the API is called
+ *              without an explicit @c mem_allocator_t handle. This instance
+ *              is initialized exactly once (see @c g_allocator_inited) and then
+ *              reused for all subsequent allocation requests routed through
+ *              the “global” path.
+ *
+ *  @note       File-scope @c static grants internal linkage: the symbol is
+ *              private to this translation unit.
+ *
+ *  @par Thread-Safety
+ *              Initialization must be synchronized so only one thread performs
+ *              it (e.g., via @c pthread_once or equivalent). Normal allocator
+ *              operations should rely on the allocator’s internal locking.
+ *
+ *  @see        MEM_allocatorInit(), MEM_allocOp(), MEM_free(), MEM_realloc()
+ * ========================================================================== */
+static mem_allocator_t g_allocator;
+
+/** ============================================================================
+ *  @var        g_allocator_inited
+ *  @brief      One-time initialization guard for @c g_allocator.
+ *
+ *  @details    Boolean-like flag controlling lazy init of the global allocator.
+ *              A value of 0 means “not initialized”; 1 means “initialized”.
+ *              It should be set to 1 only after a successful call to
+ *              @c MEM_allocatorInit(&g_allocator).
+ *
+ *  @warning    This flag is a plain @c int and is not atomic. In multi-threaded
+ *              contexts, protect initialization with proper synchronization
+ *              (e.g., @c pthread_once, a mutex, or atomic CAS) to avoid races.
+ * ========================================================================== */
+static bool g_allocator_inited = false;
+
+/** ============================================================================
+ *  @var        g_tag_shard_seq
+ *  @brief      Round-robin source for per-thread tag shard assignment.
+ * ========================================================================== */
+static _Atomic uint32_t g_tag_shard_seq = 0u;
+
+/** ============================================================================
+ *  @var        t_tag_shard
+ *  @brief      Tag counter shard owned by the calling thread.
+ *
+ *  @details    UINT32_MAX until the thread performs its first tagged
+ *              operation, see MEM_getTagShard().
+ * ========================================================================== */
+static _Thread_local uint32_t t_tag_shard = UINT32_MAX;
+
+#if defined(GARBAGE_COLLECTOR)
+/** ============================================================================
+ *  @var        g_gc_registry
+ *  @brief      Registry consulted by the GC suspend handler.
+ *
+ *  @details    Signal handlers take no context argument; MEM_runGc() points
+ *              this at the collecting allocator's registry.
+ * ========================================================================== */
+static gc_registry_t *g_gc_registry = (gc_registry_t *)NULL;
+#endif
+
+/** ============================================================================
+ *                  F U N C T I O N S  D E F I N I T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @brief  Determine at runtime whether the stack grows downward
+ *
+ *  This function passes the address of a volatile local to
+ *  MEM_stackDeeper(), which compares it with one of its own locals, to infer
+ *  the growth direction. Two locals of the same frame would not do: the
+ *  compiler lays a frame out in any order.
+ *
+ *  @return true if stack grows down (higher addresses → lower),
+ *          false if it grows up (lower addresses → higher)
+ *
+ *  @retval true:   Stack grows downward (newer frames at lower addresses)
+ *  @retval false:  Stack grows upward (newer frames at higher addresses)
+ * ========================================================================== */
+static bool MEM_stackGrowsDown(void)
+{
+  bool ret = false;
+
+  volatile int outer = 0;
+
+  ret = MEM_stackDeeper((uintptr_t)&outer);
+
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Tells whether a callee frame sits below its caller's.
+ *
+ *  Never inlined, so its local lives in a frame of its own.
+ *
+ *  @param[in]  outer Address of a local of the calling frame.
+ *
+ *  @return true if the local of this frame has the lower address.
+ * ========================================================================== */
+static bool MEM_stackDeeper(const uintptr_t outer)
+{
+  bool ret = false;
+
+  volatile int inner = 0;
+
+  ret = (bool)((uintptr_t)&inner < outer);
+
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Query and record the bounding addresses of a thread’s stack
+ *
+ *  This function retrieves the stack base address, total stack size, and
+ *  guard size for the specified thread, then computes the usable stack
+ *  bounds within the allocator object, taking into account whether the
+ *  stack grows up or down in memory.
+ *
+ *  @param[in]  id          The thread identifier whose stack to inspect.
+ *  @param[in]  allocator   Pointer to the allocator object where stack_bottom
+ *                          and stack_top will be stored.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Stack bounds successfully recorded.
+ *  @retval -EINVAL:      @p allocator was NULL.
+ *  @retval ret>0:        Error code from one of the pthread or system calls
+ * ========================================================================== */
+static int MEM_stackBounds(const pthread_t id, mem_allocator_t *const allocator)
+{
+  int ret = EXIT_SUCCESS;
+
+  pthread_attr_t attr;
+
+  void *base_addr = (void *)NULL;
+
+  uintptr_t base = 0u;
+
+  size_t stack_size = 0u;
+  size_t guard_size = 0u;
+
+  size_t page = 0u;
+
+  bool grows_down = false;
+
+  if (UNLIKELY(allocator == NULL))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid allocator pointer: %p. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              ret);
+    goto function_output;
+  }
+
+  page = (size_t)sysconf(_SC_PAGESIZE);
+
+  ret = pthread_getattr_np(id, &attr);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  ret = pthread_attr_getstack(&attr, &base_addr, &stack_size);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  ret = pthread_attr_getguardsize(&attr, &guard_size);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  ret = pthread_attr_destroy(&attr);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  if (guard_size < page)
+    guard_size = page;
+
+  base = (uintptr_t)base_addr;
+
+  grows_down = MEM_stackGrowsDown( );
+  if (grows_down)
+  {
+    allocator->stack_bottom = (uintptr_t *)(base + guard_size);
+    allocator->stack_top    = (uintptr_t *)(base + stack_size);
+  }
+  else
+  {
+    allocator->stack_bottom = (uintptr_t *)base_addr;
+    allocator->stack_top    = (uintptr_t *)(base + stack_size - guard_size);
+  }
+
+  LOG_INFO("Stack: grows %s | guard size=%zu | Bounds=[%p .. %p].\n",
+           grows_down ? "down" : "up",
+           guard_size,
+           (void *)allocator->stack_bottom,
+           (void *)allocator->stack_top);
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Returns the counter shard assigned to the calling thread.
+ *
+ *  Threads are assigned round-robin on first use; the index is cached in
+ *  thread-local storage afterwards.
+ *
+ *  @return Shard index in [0, MEM_TAG_SHARDS).
+ * ========================================================================== */
+static uint32_t MEM_getTagShard(void)
+{
+  if (UNLIKELY(t_tag_shard == UINT32_MAX))
+  {
+    t_tag_shard
+      = atomic_fetch_add_explicit(&g_tag_shard_seq, 1u, memory_order_relaxed)
+      % MEM_TAG_SHARDS;
+  }
+
+  return t_tag_shard;
+}
+
+/** ============================================================================
+ *  @brief  Sums the per-thread shards of a tag into a stats snapshot.
+ *
+ *  Fills live_bytes, total_bytes, alloc_count and free_count of @p stats.
+ *  The remaining fields are left untouched. The tag's peak is raised to the
+ *  summed live bytes, so it reflects the highest value seen by any reader.
+ *
+ *  @param[in]  tag       Tag registry entry.
+ *  @param[out] stats     Destination snapshot.
+ * ========================================================================== */
+static void MEM_tagSum(mem_tag_t *const tag, mem_tag_stats_t *const stats)
+{
+  mem_tag_shard_t *shard = (mem_tag_shard_t *)NULL;
+
+  uint64_t alloc_bytes = 0u;
+  uint64_t free_bytes  = 0u;
+  uint64_t alloc_count = 0u;
+  uint64_t free_count  = 0u;
+
+  size_t iterator = 0u;
+  size_t peak     = 0u;
+
+  for (iterator = 0u; iterator < MEM_TAG_SHARDS; ++iterator)
+  {
+    shard = &tag->shards[iterator];
+
+    alloc_bytes
+      += atomic_load_explicit(&shard->alloc_bytes, memory_order_relaxed);
+    free_bytes += atomic_load_explicit(&shard->free_bytes, memory_order_relaxed);
+    alloc_count
+      += atomic_load_explicit(&shard->alloc_count, memory_order_relaxed);
+    free_count += atomic_load_explicit(&shard->free_count, memory_order_relaxed);
+  }
+
+  stats->live_bytes
+    = (alloc_bytes > free_bytes) ? (size_t)(alloc_bytes - free_bytes) : 0u;
+  stats->total_bytes = alloc_bytes;
+  stats->alloc_count = alloc_count;
+  stats->free_count  = free_count;
+
+  peak = atomic_load_explicit(&tag->peak_bytes, memory_order_relaxed);
+  while ((stats->live_bytes > peak)
+         && !atomic_compare_exchange_weak_explicit(&tag->peak_bytes,
+                                                   &peak,
+                                                   stats->live_bytes,
+                                                   memory_order_relaxed,
+                                                   memory_order_relaxed))
+    ;
+}
+
+/** ============================================================================
+ *  @brief  Folds the shard high-water marks into the tag's peak.
+ *
+ *  A shard whose net bytes rose above both its value at the previous fold
+ *  and its current value saw a spike that no sum caught; the spikes of
+ *  every shard are added to @p live_bytes and the tag's peak is raised to
+ *  the result. The marks are then reset to the current net bytes. The
+ *  peak is exact while one thread at a time allocates under the tag, and
+ *  an upper bound when spikes on several shards did not overlap.
+ *
+ *  @param[in]  tag        Tag registry entry.
+ *  @param[in]  live_bytes Live bytes just summed by MEM_tagSum().
+ * ========================================================================== */
+static void MEM_tagPeak(mem_tag_t *const tag, const size_t live_bytes)
+{
+  mem_tag_shard_t *shard = (mem_tag_shard_t *)NULL;
+
+  int64_t net   = 0;
+  int64_t high  = 0;
+  int64_t floor = 0;
+
+  size_t iterator = 0u;
+  size_t spikes   = 0u;
+  size_t peak     = 0u;
+
+  for (iterator = 0u; iterator < MEM_TAG_SHARDS; ++iterator)
+  {
+    shard = &tag->shards[iterator];
+
+    net = (int64_t)(atomic_load_explicit(&shard->alloc_bytes,
+                                         memory_order_relaxed)
+                    - atomic_load_explicit(&shard->free_bytes,
+                                           memory_order_relaxed));
+
+    high = atomic_exchange_explicit(&shard->peak_net, net, memory_order_relaxed);
+    floor
+      = atomic_exchange_explicit(&shard->base_net, net, memory_order_relaxed);
+    if (net > floor)
+      floor = net;
+
+    if (high > floor)
+      spikes += (size_t)(high - floor);
+  }
+
+  peak = atomic_load_explicit(&tag->peak_bytes, memory_order_relaxed);
+  while ((live_bytes + spikes > peak)
+         && !atomic_compare_exchange_weak_explicit(&tag->peak_bytes,
+                                                   &peak,
+                                                   live_bytes + spikes,
+                                                   memory_order_relaxed,
+                                                   memory_order_relaxed))
+    ;
+}
+
+/** ============================================================================
+ *  @brief  Charges or credits a block to its accounting tag.
+ *
+ *  On allocation, the block's payload size is added to the calling thread's
+ *  shard, the shard's net bytes high-water mark is raised and, when the tag
+ *  has a soft limit, the shards are summed to check it. Tags without a
+ *  limit never read the other shards here; MEM_tagPeak() folds the shard
+ *  marks into the tag's peak on the stats path. On free, the payload size
+ *  is credited back. Blocks carrying an unknown tag are accounted to
+ *  MEM_TAG_DEFAULT.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  block     Block being allocated or freed.
+ *  @param[in]  alloc     true on allocation, false on free.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Block accounted.
+ *  @retval -EINVAL:      @p allocator or @p block is NULL.
+ * ========================================================================== */
+static int MEM_tagAccount(mem_allocator_t *const allocator,
+                          block_header_t *const  block,
+                          const bool             alloc)
+{
+  int ret = EXIT_SUCCESS;
+
+  mem_tag_t       *tag   = (mem_tag_t *)NULL;
+  mem_tag_shard_t *shard = (mem_tag_shard_t *)NULL;
+
+  mem_tag_stats_t snapshot = { 0 };
+
+  size_t bytes = 0u;
+  size_t limit = 0u;
+
+  int64_t net  = 0;
+  int64_t high = 0;
+
+  if (UNLIKELY(allocator == NULL || block == NULL))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid parameters: allocator=%p, block=%p. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              (void *)block,
+              ret);
+    goto function_output;
+  }
+
+  if (UNLIKELY(block->tag
+               >= atomic_load_explicit(&allocator->num_tags,
+                                       memory_order_acquire)))
+    block->tag = MEM_TAG_DEFAULT;
+
+  tag   = &allocator->tags[block->tag];
+  shard = &tag->shards[MEM_getTagShard( )];
+  bytes = (size_t)(block->size - sizeof(block_header_t) - sizeof(uintptr_t));
+
+  if (!alloc)
+  {
+    atomic_fetch_add_explicit(&shard->free_bytes, bytes, memory_order_relaxed);
+    atomic_fetch_add_explicit(&shard->free_count, 1u, memory_order_relaxed);
+    goto function_output;
+  }
+
+  net = (int64_t)(atomic_fetch_add_explicit(&shard->alloc_bytes,
+                                            bytes,
+                                            memory_order_relaxed)
+                  + bytes
+                  - atomic_load_explicit(&shard->free_bytes,
+                                         memory_order_relaxed));
+  atomic_fetch_add_explicit(&shard->alloc_count, 1u, memory_order_relaxed);
+
+  high = atomic_load_explicit(&shard->peak_net, memory_order_relaxed);
+  while ((net > high)
+         && !atomic_compare_exchange_weak_explicit(&shard->peak_net,
+                                                   &high,
+                                                   net,
+                                                   memory_order_relaxed,
+                                                   memory_order_relaxed))
+    ;
+
+  limit = atomic_load_explicit(&tag->soft_limit, memory_order_relaxed);
+  if (limit == 0u)
+    goto function_output;
+
+  MEM_tagSum(tag, &snapshot);
+
+  if (snapshot.live_bytes > limit)
+  {
+    atomic_fetch_add_explicit(&tag->limit_hits, 1u, memory_order_relaxed);
+
+    if ((snapshot.live_bytes - bytes) <= limit)
+    {
+      LOG_WARNING("Tag '%s' crossed its soft limit: live=%zu | limit=%zu.\n",
+                  tag->name,
+                  snapshot.live_bytes,
+                  limit);
+    }
+  }
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Checks a growth request against the footprint limits.
+ *
+ *  Called before the allocator asks the kernel for @p inc more bytes. A
+ *  request above the hard limit is refused; crossing the soft limit is
+ *  accepted. Both queue a pressure event for MEM_pressureDispatch().
+ *  The soft limit derived from the cgroup is checked against
+ *  memory.current (see mem_limits_t). While the GC thread runs it keeps
+ *  the cgroup snapshot fresh; otherwise a stale snapshot is refreshed
+ *  here.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  inc       Number of bytes about to be requested.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Growth allowed.
+ *  @retval -EINVAL:      @p allocator is NULL.
+ *  @retval -ENOMEM:      Growth would exceed the hard limit.
+ * ========================================================================== */
+static int MEM_checkLimits(mem_allocator_t *const allocator, const size_t inc)
+{
+  int ret = EXIT_SUCCESS;
+
+  mem_limits_t *limits = (mem_limits_t *)NULL;
+  mem_cgroup_t *cgroup = (mem_cgroup_t *)NULL;
+
+  size_t footprint = 0u;
+
+  if (UNLIKELY(allocator == NULL))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid parameters: allocator=%p. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              ret);
+    goto function_output;
+  }
+
+  limits = &allocator->limits;
+  cgroup = &allocator->cgroup;
+
+  if (!allocator->gc_thread.gc_running && MEM_cgroupDue(allocator))
+    (void)MEM_cgroupLoad(allocator);
+
+  if (LIKELY(limits->soft_limit == 0u && limits->hard_limit == 0u))
+    goto function_output;
+
+  footprint = (size_t)(allocator->heap_end - allocator->heap_start)
+            + limits->mapped_bytes;
+
+  if (!limits->user_set && cgroup->enabled)
+  {
+    footprint = cgroup->current
+              + ((footprint > cgroup->footprint)
+                   ? footprint - cgroup->footprint
+                   : 0u);
+  }
+
+  if (limits->hard_limit != 0u && footprint + inc > limits->hard_limit)
+  {
+    ret = -ENOMEM;
+    LOG_WARNING("Hard limit reached: footprint=%zu | request=%zu | "
+                "limit=%zu.\n",
+                footprint,
+                inc,
+                limits->hard_limit);
+
+    MEM_raisePressure(allocator, MEM_PRESSURE_HARD, footprint);
+    goto function_output;
+  }
+
+  if (limits->soft_limit == 0u || footprint + inc <= limits->soft_limit)
+  {
+    limits->over_soft = false;
+    goto function_output;
+  }
+
+  if (limits->over_soft)
+    goto function_output;
+
+  limits->over_soft = true;
+  LOG_WARNING("Soft limit crossed: footprint=%zu | limit=%zu.\n",
+              footprint + inc,
+              limits->soft_limit);
+
+  MEM_raisePressure(allocator, MEM_PRESSURE_SOFT, footprint + inc);
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Runs pending pressure callbacks, then compacts and trims the
+ *          allocator.
+ *
+ *  Must be called without holding gc_lock: callbacks are free to call back
+ *  into the public API. Movable blocks are slid down before the trim
+ *  (MEM_compactOp()).
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Nothing pending, or callbacks and trim completed.
+ *  @retval -EINVAL:      @p allocator is NULL.
+ * ========================================================================== */
+static int MEM_pressureDispatch(mem_allocator_t *const allocator)
+{
+  int ret = EXIT_SUCCESS;
+
+  mem_limits_t *limits = (mem_limits_t *)NULL;
+
+  mem_pressure_cb_t cbs[MEM_MAX_PRESSURE_CBS]     = { NULL };
+  void             *cb_args[MEM_MAX_PRESSURE_CBS] = { NULL };
+
+  size_t num_cbs   = 0u;
+  size_t footprint = 0u;
+  size_t iterator  = 0u;
+
+  uint8_t level = 0u;
+
+  intptr_t released = 0;
+
+  if (UNLIKELY(allocator == NULL))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid parameters: allocator=%p. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              ret);
+    goto function_output;
+  }
+
+  limits = &allocator->limits;
+
+  if (LIKELY(atomic_load_explicit(&limits->pending, memory_order_relaxed)
+             == 0u))
+    goto function_output;
+
+  level = atomic_exchange_explicit(&limits->pending, 0u, memory_order_acquire);
+  if (level == 0u)
+    goto function_output;
+
+  footprint
+    = atomic_load_explicit(&limits->pending_footprint, memory_order_relaxed);
+
+  pthread_mutex_lock(&allocator->gc_thread.gc_lock);
+  num_cbs = limits->num_cbs;
+  MEM_memcpy(cbs, limits->cbs, num_cbs * sizeof(mem_pressure_cb_t));
+  MEM_memcpy(cb_args, limits->cb_args, num_cbs * sizeof(void *));
+  pthread_mutex_unlock(&allocator->gc_thread.gc_lock);
+
+  for (iterator = 0u; iterator < num_cbs; ++iterator)
+    cbs[iterator]((mem_pressure_level_t)level, footprint, cb_args[iterator]);
+
+  pthread_mutex_lock(&allocator->gc_thread.gc_lock);
+  released = MEM_compactOp(allocator);
+  pthread_mutex_unlock(&allocator->gc_thread.gc_lock);
+
+  LOG_INFO("Pressure level %u handled: %zu callbacks, %ld bytes trimmed.\n",
+           (unsigned)level,
+           num_cbs,
+           (long)released);
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Returns free heap memory to the kernel. Caller holds gc_lock.
+ *
+ *  Releases a free block ending at the heap top through sbrk() and applies
+ *  madvise(MADV_DONTNEED) to the page-aligned interior of every other free
+ *  block, leaving headers and canaries resident.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Number of bytes released (>= 0) on success,
+ *          negative error code on failure.
+ *
+ *  @retval -EINVAL:      @p allocator is NULL.
+ * ========================================================================== */
+static intptr_t MEM_trimOp(mem_allocator_t *const allocator)
+{
+  intptr_t released = 0;
+
+  block_header_t *block = (block_header_t *)NULL;
+  block_header_t *top   = (block_header_t *)NULL;
+
+  uint8_t *user_start = (uint8_t *)NULL;
+  uint8_t *cur_brk    = (uint8_t *)NULL;
+  void    *old        = (void *)NULL;
+
+  uintptr_t start = 0u;
+  uintptr_t end   = 0u;
+
+  size_t page     = 0u;
+  size_t iterator = 0u;
+
+  if (UNLIKELY(allocator == NULL))
+  {
+    released = -EINVAL;
+    LOG_ERROR("Invalid parameters: allocator=%p. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              (int)released);
+    goto function_output;
+  }
+
+  page       = (size_t)sysconf(_SC_PAGESIZE);
+  user_start = allocator->heap_start + allocator->metadata_size;
+
+  for (iterator = 0u; iterator < allocator->num_size_classes; ++iterator)
+  {
+    for (block = allocator->free_lists[iterator]; block; block = block->fl_next)
+    {
+      if ((uint8_t *)block + block->size == allocator->heap_end)
+        top = block;
+    }
+  }
+
+  cur_brk = (uint8_t *)sbrk(0);
+
+  if (top != NULL && (uint8_t *)top >= user_start && top->size >= page
+      && cur_brk == allocator->heap_end
+      && MEM_removeFreeBlock(allocator, top) == EXIT_SUCCESS)
+  {
+    old = MEM_sbrk(-(intptr_t)top->size);
+    if ((intptr_t)old >= 0)
+    {
+      released = (intptr_t)top->size;
+
+      if (top->prev)
+        top->prev->next = (block_header_t *)NULL;
+
+      if (allocator->arenas[0].top_chunk == top)
+        allocator->arenas[0].top_chunk = top->prev;
+
+      allocator->heap_end       = (uint8_t *)top;
+      allocator->last_brk_start = (uint8_t *)NULL;
+      allocator->last_brk_end   = (uint8_t *)NULL;
+      allocator->last_allocated
+        = (block_header_t *)(uintptr_t)allocator->heap_start;
+
+      LOG_INFO("Trim: heap top released, %zu bytes. New heap_end=%p.\n",
+               (size_t)released,
+               (void *)allocator->heap_end);
+    }
+    else
+    {
+      (void)MEM_insertFreeBlock(allocator, top);
+    }
+  }
+
+  for (iterator = 0u; iterator < allocator->num_size_classes; ++iterator)
+  {
+    for (block = allocator->free_lists[iterator]; block; block = block->fl_next)
+    {
+      start = (uintptr_t)block + sizeof(block_header_t);
+      start = (start + page - 1u) & ~(uintptr_t)(page - 1u);
+      end   = (uintptr_t)block + block->size - sizeof(uintptr_t);
+      end   = end & ~(uintptr_t)(page - 1u);
+
+      if (end > start && madvise((void *)start, end - start, MADV_DONTNEED) == 0)
+        released += (intptr_t)(end - start);
+    }
+  }
+
+function_output:
+  return released;
+}
+
+/** ============================================================================
+ *  @brief  Queues a pressure event for MEM_pressureDispatch().
+ *
+ *  A pending event is only ever upgraded (SOFT to HARD), never downgraded.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  level     Pressure severity.
+ *  @param[in]  footprint Footprint reported to the callbacks.
+ * ========================================================================== */
+static void MEM_raisePressure(mem_allocator_t *const     allocator,
+                              const mem_pressure_level_t level,
+                              const size_t               footprint)
+{
+  mem_limits_t *limits = (mem_limits_t *)NULL;
+
+  uint8_t pending = 0u;
+
+  if (UNLIKELY(allocator == NULL))
+    return;
+
+  limits = &allocator->limits;
+
+  atomic_store_explicit(&limits->pending_footprint,
+                        footprint,
+                        memory_order_relaxed);
+
+  pending = atomic_load_explicit(&limits->pending, memory_order_relaxed);
+  while ((pending < (uint8_t)level)
+         && !atomic_compare_exchange_weak_explicit(&limits->pending,
+                                                   &pending,
+                                                   (uint8_t)level,
+                                                   memory_order_release,
+                                                   memory_order_relaxed))
+    ;
+}
+
+/** ============================================================================
+ *  @brief  Reads a single value from a cgroup v2 memory file.
+ *
+ *  @param[in]  dir       cgroup directory.
+ *  @param[in]  file      File name inside @p dir.
+ *  @param[out] value     Parsed value; "max" is reported as SIZE_MAX.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS:   Value parsed.
+ *  @retval -ENOENT:        The file cannot be opened or read.
+ *  @retval -EINVAL:        The file holds no number.
+ *  @retval -ENAMETOOLONG:  Path does not fit in PATH_MAX.
+ * ========================================================================== */
+static int MEM_cgroupRead(const char *const dir,
+                          const char *const file,
+                          size_t *const     value)
+{
+  int ret = EXIT_SUCCESS;
+  int fd  = -1;
+
+  char  path[PATH_MAX] = { 0 };
+  char  buf[32]        = { 0 };
+  char *end            = (char *)NULL;
+
+  ssize_t len     = 0;
+  int     written = 0;
+
+  unsigned long long parsed = 0u;
+
+  written = snprintf(path, sizeof(path), "%s/%s", dir, file);
+  if (written < 0 || (size_t)written >= sizeof(path))
+  {
+    ret = -ENAMETOOLONG;
+    LOG_ERROR("cgroup path too long: %s/%s. "
+              "Error code: %d.\n",
+              dir,
+              file,
+              ret);
+    goto function_output;
+  }
+
+  fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+  {
+    ret = -ENOENT;
+    LOG_INFO("cgroup file unavailable: %s.\n", path);
+    goto function_output;
+  }
+
+  len = read(fd, buf, sizeof(buf) - 1u);
+  close(fd);
+
+  if (len <= 0)
+  {
+    ret = -ENOENT;
+    goto function_output;
+  }
+
+  buf[len] = '\0';
+
+  if (strncmp(buf, "max", sizeof("max") - 1u) == 0)
+  {
+    *value = SIZE_MAX;
+    goto function_output;
+  }
+
+  errno  = 0;
+  parsed = strtoull(buf, &end, 10);
+  if (end == buf || errno != 0)
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Unparsable cgroup value in %s: '%s'. "
+              "Error code: %d.\n",
+              path,
+              buf,
+              ret);
+    goto function_output;
+  }
+
+  *value = (size_t)parsed;
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Locates the cgroup directory of the calling process.
+ *
+ *  Uses MEM_CGROUP_ENV when set, otherwise the "0::" entry of
+ *  /proc/self/cgroup below CGROUP_ROOT.
+ *
+ *  @param[out] dir       Destination buffer of PATH_MAX bytes.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS:   Directory resolved.
+ *  @retval -ENOENT:        No cgroup v2 entry found.
+ *  @retval -ENAMETOOLONG:  Path does not fit in PATH_MAX.
+ * ========================================================================== */
+static int MEM_cgroupResolve(char *const dir)
+{
+  int ret = EXIT_SUCCESS;
+  int fd  = -1;
+
+  const char *env = (const char *)NULL;
+
+  char  buf[1024] = { 0 };
+  char *entry     = (char *)NULL;
+  char *newline   = (char *)NULL;
+
+  ssize_t len     = 0;
+  int     written = 0;
+
+  env = getenv(MEM_CGROUP_ENV);
+  if (env != NULL && env[0] != '\0')
+  {
+    written = snprintf(dir, PATH_MAX, "%s", env);
+    goto check_length;
+  }
+
+  fd = open("/proc/self/cgroup", O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+  {
+    ret = -ENOENT;
+    goto function_output;
+  }
+
+  len = read(fd, buf, sizeof(buf) - 1u);
+  close(fd);
+
+  if (len <= 0)
+  {
+    ret = -ENOENT;
+    goto function_output;
+  }
+
+  buf[len] = '\0';
+
+  for (entry = strstr(buf, "0::"); entry != NULL;
+       entry = strstr(entry + 1, "0::"))
+  {
+    if (entry == buf || entry[-1] == '\n')
+      break;
+  }
+
+  if (entry == NULL)
+  {
+    ret = -ENOENT;
+    LOG_INFO("No cgroup v2 entry in /proc/self/cgroup.\n");
+    goto function_output;
+  }
+
+  entry   += sizeof("0::") - 1u;
+  newline  = strchr(entry, '\n');
+  if (newline != NULL)
+    *newline = '\0';
+
+  written = snprintf(dir, PATH_MAX, "%s%s", CGROUP_ROOT, entry);
+
+check_length:
+  if (written < 0 || written >= PATH_MAX)
+  {
+    dir[0] = '\0';
+    ret    = -ENAMETOOLONG;
+    LOG_ERROR("cgroup directory does not fit in PATH_MAX. "
+              "Error code: %d.\n",
+              ret);
+  }
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Refreshes the cgroup snapshot and applies the derived tuning.
+ *
+ *  Derives the soft footprint limit and the GC interval (unless limits
+ *  were set by MEM_setLimit()), the reported hard level, the refresh
+ *  period and the cache budget from memory.max, and queues a soft
+ *  pressure event when
+ *  memory.current is already above the soft level. Caller holds gc_lock
+ *  (or is initialising).
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Snapshot refreshed.
+ *  @retval -EINVAL:      @p allocator is NULL.
+ *  @retval ret<0:        Errors returned by MEM_cgroupRead().
+ * ========================================================================== */
+static int MEM_cgroupLoad(mem_allocator_t *const allocator)
+{
+  int ret = EXIT_SUCCESS;
+
+  mem_cgroup_t *cgroup = (mem_cgroup_t *)NULL;
+  mem_limits_t *limits = (mem_limits_t *)NULL;
+
+  struct timespec now = { 0 };
+
+  size_t max       = 0u;
+  size_t current   = 0u;
+  size_t footprint = 0u;
+
+  uint32_t gc_interval = GC_INTERVAL_MS;
+
+  if (UNLIKELY(allocator == NULL))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid parameters: allocator=%p. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              ret);
+    goto function_output;
+  }
+
+  cgroup = &allocator->cgroup;
+  limits = &allocator->limits;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  cgroup->last_ns = (uint64_t)now.tv_sec * NSEC_PER_SEC + (uint64_t)now.tv_nsec;
+
+  ret = MEM_cgroupRead(cgroup->dir, "memory.max", &max);
+  if (ret != EXIT_SUCCESS)
+    goto disable;
+
+  ret = MEM_cgroupRead(cgroup->dir, "memory.current", &current);
+  if (ret != EXIT_SUCCESS)
+    goto disable;
+
+  footprint = (size_t)(allocator->heap_end - allocator->heap_start)
+            + limits->mapped_bytes;
+
+  cgroup->enabled      = true;
+  cgroup->max          = max;
+  cgroup->current      = current;
+  cgroup->footprint    = footprint;
+  cgroup->soft_limit   = 0u;
+  cgroup->hard_limit   = 0u;
+  cgroup->cache_budget = 0u;
+  cgroup->refresh_ms   = CGROUP_REFRESH_MS;
+
+  if (max != SIZE_MAX)
+  {
+    cgroup->soft_limit   = max / 100u * CGROUP_SOFT_PCT;
+    cgroup->hard_limit   = max / 100u * CGROUP_HARD_PCT;
+    cgroup->cache_budget = max / CGROUP_CACHE_DIV;
+
+    if (current >= cgroup->soft_limit)
+    {
+      gc_interval        = GC_INTERVAL_MS / 4u;
+      cgroup->refresh_ms = CGROUP_REFRESH_MS / 20u;
+
+      LOG_WARNING("cgroup usage high: current=%zu | max=%zu.\n",
+                  current,
+                  max);
+
+      MEM_raisePressure(allocator, MEM_PRESSURE_SOFT, current);
+    }
+    else if (current >= max / 100u * CGROUP_BUSY_PCT)
+    {
+      gc_interval        = GC_INTERVAL_MS / 2u;
+      cgroup->refresh_ms = CGROUP_REFRESH_MS / 4u;
+    }
+  }
+
+  if (!limits->user_set)
+  {
+    allocator->gc_thread.gc_interval_ms = gc_interval;
+
+    limits->soft_limit = cgroup->soft_limit;
+    limits->hard_limit = 0u;
+  }
+
+  LOG_INFO("cgroup %s: max=%zu | current=%zu | refresh=%ums.\n",
+           cgroup->dir,
+           max,
+           current,
+           cgroup->refresh_ms);
+  goto function_output;
+
+disable:
+  cgroup->enabled = false;
+
+  if (!limits->user_set)
+  {
+    limits->soft_limit = 0u;
+    limits->hard_limit = 0u;
+  }
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Tells whether the cgroup snapshot is due for a refresh.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return true when the cgroup is enabled and was last read at least
+ *          refresh_ms ago, false otherwise.
+ * ========================================================================== */
+static bool MEM_cgroupDue(mem_allocator_t *const allocator)
+{
+  struct timespec now = { 0 };
+
+  uint64_t now_ns = 0u;
+
+  bool due = false;
+
+  if (!allocator->cgroup.enabled)
+    goto function_output;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  now_ns = (uint64_t)now.tv_sec * NSEC_PER_SEC + (uint64_t)now.tv_nsec;
+
+  due = (now_ns - allocator->cgroup.last_ns
+         >= (uint64_t)allocator->cgroup.refresh_ms * NSEC_PER_MSEC);
+
+function_output:
+  return due;
+}
+
+/** ============================================================================
+ *  @brief  PSI monitor thread body.
+ *
+ *  Sleeps in poll() on the trigger descriptor and the stop pipe. Each
+ *  POLLPRI event queues a soft pressure event, dispatches it (callbacks and
+ *  trim) and wakes the garbage collector thread. While a cgroup is tracked
+ *  the poll() also times out every refresh_ms, so the cgroup snapshot is
+ *  refreshed (MEM_cgroupLoad()) and any pressure this raises dispatched
+ *  without waiting for heap growth or the GC thread. When it exits on its own
+ *  (poll() failure or POLLERR) while @b running is still set, it clears
+ *  @b running under gc_lock, releases the descriptors (MEM_psiClose()) and
+ *  detaches itself, so MEM_psiMonitorStart() can start a new monitor.
+ *
+ *  @param[in]  arg Pointer to the mem_allocator_t context.
+ *
+ *  @return NULL on clean exit; an error-encoded pointer (via PTR_ERR())
+ *          if poll() fails or the trigger is torn down.
+ * ========================================================================== */
+static void *MEM_psiThreadFunc(void *arg)
+{
+  int ret = EXIT_SUCCESS;
+
+  mem_allocator_t *allocator = (mem_allocator_t *)NULL;
+  gc_thread_t     *gc_thread = (gc_thread_t *)NULL;
+  mem_psi_t       *psi       = (mem_psi_t *)NULL;
+
+  struct pollfd fds[2] = { 0 };
+
+  size_t footprint = 0u;
+
+  int timeout = -1;
+  int ready   = 0;
+
+  if (UNLIKELY(arg == NULL))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid parameters: arg: %p. "
+              "Error code: %d.\n",
+              (void *)arg,
+              ret);
+    goto function_output;
+  }
+
+  allocator = (mem_allocator_t *)arg;
+  gc_thread = &allocator->gc_thread;
+  psi       = &allocator->psi;
+
+  fds[0].fd     = psi->fd;
+  fds[0].events = POLLPRI;
+  fds[1].fd     = psi->wake[0];
+  fds[1].events = POLLIN;
+
+  for (;;)
+  {
+    pthread_mutex_lock(&gc_thread->gc_lock);
+    timeout = allocator->cgroup.enabled ? (int)allocator->cgroup.refresh_ms
+                                        : -1;
+    pthread_mutex_unlock(&gc_thread->gc_lock);
+
+    ready = poll(fds, 2u, timeout);
+    if (ready < 0)
+    {
+      if (errno == EINTR)
+        continue;
+
+      ret = -errno;
+      LOG_ERROR("PSI poll failed. "
+                "Error code: %d.\n",
+                ret);
+      goto release;
+    }
+
+    if (ready == 0)
+    {
+      pthread_mutex_lock(&gc_thread->gc_lock);
+      if (MEM_cgroupDue(allocator))
+        (void)MEM_cgroupLoad(allocator);
+      pthread_mutex_unlock(&gc_thread->gc_lock);
+
+      (void)MEM_pressureDispatch(allocator);
+      continue;
+    }
+
+    if (fds[1].revents != 0)
+      goto release;
+
+    if (fds[0].revents & POLLERR)
+    {
+      ret = -ENODEV;
+      LOG_ERROR("PSI trigger torn down. "
+                "Error code: %d.\n",
+                ret);
+      goto release;
+    }
+
+    if (!(fds[0].revents & POLLPRI))
+      continue;
+
+    atomic_fetch_add_explicit(&psi->events, 1u, memory_order_relaxed);
+
+    pthread_mutex_lock(&gc_thread->gc_lock);
+    footprint = (size_t)(allocator->heap_end - allocator->heap_start)
+              + allocator->limits.mapped_bytes;
+    MEM_raisePressure(allocator, MEM_PRESSURE_SOFT, footprint);
+
+    if (gc_thread->gc_thread_started)
+    {
+      gc_thread->gc_running = true;
+      pthread_cond_broadcast(&gc_thread->gc_cond);
+    }
+    pthread_mutex_unlock(&gc_thread->gc_lock);
+
+    LOG_INFO("PSI memory stall event: footprint=%zu.\n", footprint);
+
+    (void)MEM_pressureDispatch(allocator);
+  }
+
+release:
+  pthread_mutex_lock(&gc_thread->gc_lock);
+  if (psi->running)
+  {
+    psi->running = false;
+    MEM_psiClose(psi);
+    (void)pthread_detach(pthread_self( ));
+  }
+  pthread_mutex_unlock(&gc_thread->gc_lock);
+function_output:
+  return PTR_ERR(ret);
+}
+
+/** ============================================================================
+ *  @brief  Closes the PSI trigger and stop pipe and marks them unused.
+ *
+ *  @param[in]  psi       PSI monitor state.
+ * ========================================================================== */
+static void MEM_psiClose(mem_psi_t *const psi)
+{
+  close(psi->fd);
+  close(psi->wake[0]);
+  close(psi->wake[1]);
+
+  psi->fd      = -1;
+  psi->wake[0] = -1;
+  psi->wake[1] = -1;
+}
+
+/** ============================================================================
+ *  @brief  Fills a memory block with a specified byte value
+ *          using optimized operations.
+ *
+ *  This function sets each byte in the given memory region to the specified
+ *  value. It first advances the pointer to meet the architecture’s alignment
+ *  requirements, then writes data in ARCH_ALIGNMENT-sized chunks using 64-bit
+ *  stores multiplied by PREFETCH_MULT, with prefetch hints for cache lines.
+ *  Any remaining bytes at the end are filled one by one.
+ *
+ *  @param[in]  source  Pointer to the memory block to fill.
+ *  @param[in]  value   Byte value to set (0–255).
+ *  @param[in]  size    Number of bytes to set.
+ *
+ *  @return Original source pointer on success,
+ *          an error‐encoded pointer (via PTR_ERR()) on failure.
+ *
+ *  @retval dest:     Original Pointer on successful operation.
+ *  @retval -EINVAL:  Invalid @p src or @p size.
+ * ========================================================================== */
+void *MEM_memset(void *const source, const int value, const size_t size)
+{
+  void *ret = (void *)NULL;
+
+  unsigned char *ptr       = (unsigned char *)NULL;
+  unsigned char *ptr_aux   = (unsigned char *)NULL;
   unsigned char *ptr_fetch = (unsigned char *)NULL;
 
-  uintptr_t *word = (uintptr_t *)NULL;
+  uintptr_t *word = (uintptr_t *)NULL;
+
+  uintptr_t pattern = 0u;
+
+  size_t iterator = 0u;
+
+  if (UNLIKELY((source == NULL) || (size <= 0)))
+  {
+    ret = PTR_ERR(-EINVAL);
+    LOG_ERROR("Invalid arguments: source=%p, size=%zu. "
+              "Error code: %d.\n",
+              source,
+              size,
+              (int)(intptr_t)ret);
+    goto function_output;
+  }
+
+  ptr = (unsigned char *)source;
+
+  if ((uintptr_t)ptr % ARCH_ALIGNMENT != 0)
+  {
+    while ((iterator < size)
+           && ((uintptr_t)(ptr + iterator) % ARCH_ALIGNMENT != 0))
+    {
+      ptr[iterator] = (unsigned char)value;
+      iterator++;
+    }
+  }
+
+  pattern = ((uintptr_t)(unsigned char)value) * PREFETCH_MULT;
+
+  for (; iterator + ARCH_ALIGNMENT <= size; iterator += ARCH_ALIGNMENT)
+  {
+    ptr_fetch = ptr + iterator;
+    PREFETCH_W(ptr_fetch + CACHE_LINE_SIZE);
+    word  = (uintptr_t *)ASSUME_ALIGNED(ptr_fetch, ARCH_ALIGNMENT);
+    *word = pattern;
+  }
+
+  ptr_aux = (unsigned char *)(ptr + iterator);
+  while (iterator < size)
+  {
+    *ptr_aux++ = (unsigned char)value;
+    iterator++;
+  }
+
+  ret = source;
+  LOG_INFO("Memory set: source=%p, value=0x%X, size=%zu.\n",
+           source,
+           (unsigned int)value,
+           size);
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Copies a memory block between buffers using optimized operations.
+ *
+ *  This function copies `size` bytes from the source buffer to the destination
+ *  buffer. It first advances the destination pointer to meet the architecture’s
+ *  alignment requirements, then copies data in ARCH_ALIGNMENT-sized chunks
+ *  using 64-bit loads and stores, with prefetch hints for both source and
+ *  destination cache lines. Any remaining bytes at the end are copied.
+ *
+ *  @param[in]  dest  Destination buffer pointer.
+ *  @param[in]  src   Source buffer pointer.
+ *  @param[in]  size  Number of bytes to copy.
+ *
+ *  @return Original dest pointer on success,
+ *          an error-encoded pointer (via PTR_ERR()) on failure.
+ *
+ *  @retval dest:     Original Pointer on successful operation.
+ *  @retval -EINVAL:  Invalid @p src or @p size.
+ * ========================================================================== */
+void *MEM_memcpy(void *const dest, const void *src, const size_t size)
+{
+  void *ret = (void *)NULL;
+
+  unsigned char       *destine      = (unsigned char *)NULL;
+  unsigned char       *destine_aux  = (unsigned char *)NULL;
+  unsigned char       *dest_fetch   = (unsigned char *)NULL;
+  const unsigned char *source       = (const unsigned char *)NULL;
+  const unsigned char *source_fetch = (const unsigned char *)NULL;
+
+  uintptr_t       *dest_word = (uintptr_t *)NULL;
+  const uintptr_t *src_word  = (const uintptr_t *)NULL;
+
+  size_t iterator = 0u;
+
+  if (UNLIKELY((dest == NULL) || (src == NULL) || (size <= 0)))
+  {
+    ret = PTR_ERR(-EINVAL);
+    LOG_ERROR("Invalid arguments: dest=%p, src=%p, size=%zu. "
+              "Error code: %d.\n",
+              dest,
+              src,
+              size,
+              (int)(intptr_t)ret);
+    goto function_output;
+  }
+
+  destine = (unsigned char *)dest;
+  source  = (const unsigned char *)src;
+
+  if ((uintptr_t)destine % ARCH_ALIGNMENT != 0)
+  {
+    while ((iterator < size)
+           && ((uintptr_t)(destine + iterator) % ARCH_ALIGNMENT != 0))
+    {
+      destine[iterator] = source[iterator];
+      iterator++;
+    }
+  }
+
+  for (; iterator + ARCH_ALIGNMENT <= size; iterator += ARCH_ALIGNMENT)
+  {
+    dest_fetch   = destine + iterator;
+    source_fetch = source + iterator;
+
+    PREFETCH_R(source_fetch + CACHE_LINE_SIZE);
+    PREFETCH_W(dest_fetch + CACHE_LINE_SIZE);
+
+    dest_word = (uintptr_t *)ASSUME_ALIGNED(dest_fetch, ARCH_ALIGNMENT);
+    src_word  = (const uintptr_t *)ASSUME_ALIGNED(source_fetch, ARCH_ALIGNMENT);
+
+    *dest_word = *src_word;
+  }
+
+  destine_aux = destine + iterator;
+  while (iterator < size)
+  {
+    *destine_aux++ = source[iterator];
+    iterator++;
+  }
+
+  ret = dest;
+  LOG_INFO("Memory copied: dest=%p, src=%p, size=%zu.\n", dest, src, size);
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Invokes sbrk-like behavior by moving the program break.
+ *
+ *  This function reads the current program break, attempts to move it by the
+ *  signed offset @p increment via sbrk(), and returns the original break on
+ *  success.  If any call to sbrk() or reading the break fails, it encodes the
+ *  negative errno into a pointer via PTR_ERR.
+ *
+ *  @param[in]  increment Signed offset in bytes to move the program break:
+ *                        positive to grow, negative to shrink.
+ *
+ *  @return Original program break address on success;
+ *          an error-encoded pointer (via PTR_ERR()) on failure.
+ *
+ *  @retval ret>-1:   Previous break on success.
+ *  @retval -ENOMEM:  Failed to read or adjust the break.
+ * ========================================================================== */
+void *MEM_sbrk(const intptr_t increment)
+{
+  void *old_break = (void *)NULL;
+  void *new_break = (void *)NULL;
+
+  old_break = sbrk(0);
+  if (old_break == (void *)-1)
+  {
+    old_break = PTR_ERR(-ENOMEM);
+    LOG_ERROR("Failed to read current break. "
+              "Error code: %d.\n",
+              (int)(intptr_t)old_break);
+    goto function_output;
+  }
+
+  if (sbrk(increment) == (void *)-1)
+  {
+    old_break = PTR_ERR(-ENOMEM);
+    LOG_ERROR("Failed to adjust break (increment=%" PRIdPTR ""
+              "Error code: %d.\n",
+              increment,
+              (int)(intptr_t)old_break);
+    goto function_output;
+  }
+
+  new_break = sbrk(0);
+  if (new_break == (void *)-1)
+  {
+    old_break = PTR_ERR(-ENOMEM);
+    LOG_ERROR("Failed to read new break. "
+              "Error code: %d.\n",
+              (int)(intptr_t)old_break);
+    goto function_output;
+  }
+
+  LOG_INFO("Program break moved from %p to %p (increment: %" PRIdPTR ").\n",
+           old_break,
+           new_break,
+           increment);
+
+function_output:
+  return old_break;
+}
+
+/** ============================================================================
+ *  @brief  Validates the integrity and boundaries of a memory block.
+ *
+ *  This function ensures that the specified @p block lies within the
+ * allocator’s heap or one of its mmap regions, that its header canary matches
+ * the expected magic value to detect metadata corruption, that its data canary
+ * is intact to catch buffer overruns, and that the block’s size does not extend
+ * past the heap’s end.  On any failure, an appropriate negative errno is
+ * returned.
+ *
+ *  @param[in]  allocator Pointer to the allocator context.
+ *  @param[in]  block     Pointer to the block header to validate.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: @p block is valid.
+ *  @retval -EINVAL:      @p allocator or @p block pointer is NULL.
+ *  @retval -EFAULT:      @p block lies outside heap and mmap regions.
+ *  @retval -EPROTO:      @p block canary does not match expected value.
+ *  @retval -EFBIG:       @p block size causes it to extend past heap end.
+ *  @retval -EOVERFLOW:   @p block canary indicates buffer overflow.
+ * ========================================================================== */
+static int MEM_validateBlock(mem_allocator_t *const allocator,
+                             block_header_t *const  block)
+{
+  int ret = EXIT_SUCCESS;
+
+  mmap_t *map = (mmap_t *)NULL;
+
+  uintptr_t addr       = 0u;
+  uintptr_t heap_start = 0u;
+  uintptr_t heap_end   = 0u;
+  uintptr_t map_start  = 0u;
+  uintptr_t map_end    = 0u;
+
+  size_t hdr_sz    = 0u;
+  size_t min_total = 0u;
+  size_t bsize     = 0u;
+
+  uintptr_t  tail_addr = 0u;
+  uintptr_t *tail      = (uintptr_t *)NULL;
+
+  bool in_heap = false;
+  bool in_mmap = false;
+
+  if (UNLIKELY((allocator == NULL) || (block == NULL)))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid parameters. Allocator: %p, Block: %p. Error code: %d.\n",
+              (void *)allocator,
+              (void *)block,
+              ret);
+    goto function_output;
+  }
+
+  addr       = (uintptr_t)block;
+  heap_start = (uintptr_t)allocator->heap_start;
+  heap_end   = (uintptr_t)allocator->heap_end;
+  hdr_sz     = sizeof(block_header_t);
+  min_total  = (size_t)(hdr_sz + sizeof(uintptr_t));
+
+  if ((addr >= heap_start) && (addr < heap_end))
+  {
+    in_heap = true;
+  }
+  else
+  {
+    for (map = allocator->mmap_list; map; map = map->next)
+    {
+      map_start = (uintptr_t)map->addr;
+      map_end   = map_start + map->size;
+
+      if ((addr >= map_start) && (addr < map_end))
+      {
+        in_mmap = true;
+        break;
+      }
+    }
+  }
+
+  if (UNLIKELY(!in_heap && !in_mmap))
+  {
+    ret = -EFAULT;
+    LOG_ERROR("Block %p is outside managed regions. Heap=[%p .. %p]. Error "
+              "code: %d.\n",
+              (void *)block,
+              (void *)allocator->heap_start,
+              (void *)allocator->heap_end,
+              ret);
+    goto function_output;
+  }
+
+  if ((addr & (ARCH_ALIGNMENT - 1u)) != 0u)
+  {
+    ret = -ENOENT;
+    LOG_WARNING("Not a memalloc block: misaligned header at %p (alignment=%u). "
+                "Error code: %d.\n",
+                (void *)block,
+                (unsigned)ARCH_ALIGNMENT,
+                ret);
+    goto function_output;
+  }
+
+  if (in_heap)
+  {
+    const uintptr_t user_start = heap_start + allocator->metadata_size;
+
+    if (addr < user_start)
+    {
+      ret = -ENOENT;
+      LOG_WARNING("Not a memalloc block: header at %p lies inside allocator "
+                  "metadata region [%p .. %p). Error code: %d.\n",
+                  (void *)block,
+                  (void *)allocator->heap_start,
+                  (void *)user_start,
+                  ret);
+      goto function_output;
+    }
+
+    if (addr > (heap_end - hdr_sz))
+    {
+      ret = -ENOENT;
+      LOG_WARNING("Not a memalloc block: header at %p truncated at heap end "
+                  "%p. Error code: %d.\n",
+                  (void *)block,
+                  (void *)allocator->heap_end,
+                  ret);
+      goto function_output;
+    }
+  }
+  else
+  {
+    if (addr > (map_end - hdr_sz))
+    {
+      ret = -ENOENT;
+      LOG_WARNING("Not a memalloc block: header at %p truncated inside mmap "
+                  "region [%p .. %p). Error code: %d.\n",
+                  (void *)block,
+                  (void *)map->addr,
+                  (void *)((uint8_t *)map->addr + map->size),
+                  ret);
+      goto function_output;
+    }
+  }
+
+  bsize = block->size;
+
+  if (bsize < min_total)
+  {
+    ret = -ENOENT;
+    LOG_WARNING("Not a memalloc block: too small size at %p (%zu < %zu). Error "
+                "code: %d.\n",
+                (void *)block,
+                bsize,
+                min_total,
+                ret);
+    goto function_output;
+  }
+
+  if ((bsize & (ARCH_ALIGNMENT - 1u)) != 0u)
+  {
+    ret = -ENOENT;
+    LOG_WARNING("Not a memalloc block: size not aligned at %p (%zu, "
+                "alignment=%u). Error code: %d.\n",
+                (void *)block,
+                bsize,
+                (unsigned)ARCH_ALIGNMENT,
+                ret);
+    goto function_output;
+  }
+
+  if (in_heap && ((addr + bsize) > heap_end))
+  {
+    ret = -ENOENT;
+    LOG_WARNING("Not a memalloc block: block at %p extends past heap end (%p). "
+                "size=%zu. Error code: %d.\n",
+                (void *)block,
+                (void *)allocator->heap_end,
+                bsize,
+                ret);
+    goto function_output;
+  }
+  if (in_mmap && ((addr + bsize) > map_end))
+  {
+    ret = -ENOENT;
+    LOG_WARNING("Not a memalloc block: block at %p extends past mmap end (%p). "
+                "size=%zu. Error code: %d.\n",
+                (void *)block,
+                (void *)map_end,
+                bsize,
+                ret);
+    goto function_output;
+  }
+
+  if (block->magic != MAGIC_NUMBER)
+  {
+    ret = -ENOENT;
+    LOG_WARNING("Not a memalloc block: magic mismatch at %p (0x%" PRIxPTR
+                " vs 0x%" PRIxPTR "). Error code: %d.\n",
+                (void *)block,
+                block->magic,
+                (uintptr_t)MAGIC_NUMBER,
+                ret);
+    goto function_output;
+  }
+
+  if (in_heap && (block->canary != CANARY_VALUE))
+  {
+    ret = -EPROTO;
+    LOG_WARNING("Memalloc block corrupted: header canary mismatch at %p "
+                "(0x%" PRIxPTR " vs 0x%" PRIxPTR "). Error code: %d.\n",
+                (void *)block,
+                block->canary,
+                (uintptr_t)CANARY_VALUE,
+                ret);
+    goto function_output;
+  }
+
+  tail_addr = addr + bsize - sizeof(uintptr_t);
+  tail      = (uintptr_t *)tail_addr;
+
+  if (in_heap)
+  {
+    if (*tail != CANARY_VALUE)
+    {
+      ret = -EOVERFLOW;
+      LOG_WARNING("Memalloc block corrupted: data canary mismatch at %p "
+                  "(0x%" PRIxPTR "). Error code: %d.\n",
+                  (void *)block,
+                  *tail,
+                  ret);
+      goto function_output;
+    }
+  }
+  else
+  {
+    if (tail_addr >= map_end)
+    {
+      ret = -ENOENT;
+      LOG_WARNING("Not a memalloc block: trailing canary out of mmap bounds at "
+                  "%p. Error code: %d.\n",
+                  (void *)block,
+                  ret);
+      goto function_output;
+    }
+
+    if (*tail != CANARY_VALUE)
+    {
+      ret = -EOVERFLOW;
+      LOG_WARNING("Memalloc block corrupted (mmap): data canary mismatch at %p "
+                  "(0x%" PRIxPTR "). Error code: %d.\n",
+                  (void *)block,
+                  *tail,
+                  ret);
+      goto function_output;
+    }
+  }
+
+  LOG_INFO("Block validated: addr=%p, size=%zu, region=%s.\n",
+           (void *)block,
+           bsize,
+           in_heap ? "heap" : "mmap");
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Calculates the size class index for a requested memory size.
+ *
+ *  This function determines which size class the given allocation request
+ *  belongs to by dividing the requested @p size by BYTES_PER_CLASS (rounding
+ *  up). If the computed index exceeds the maximum available class, it will
+ *  be clamped to the highest class and a warning emitted.
+ *
+ *  @param[in]  allocator Pointer to the allocator context.
+ *  @param[in]  size  Requested memory size in bytes (must be > 0).
+ *
+ *  @return On success, returns a non-negative integer size class index;
+ *          on failure, returns a negative error code.
+ *
+ *  @retval ret>0:    Valid size class index.
+ *  @retval -EINVAL:  @p allocator is NULL, or @p size is zero.
+ * ========================================================================== */
+static int MEM_getSizeClass(mem_allocator_t *const allocator, const size_t size)
+{
+  int ret = EXIT_SUCCESS;
+
+  size_t index     = 0u;
+  size_t max_class = 0u;
+
+  if (UNLIKELY(allocator == NULL))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid allocator pointer: %p. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              ret);
+    goto function_output;
+  }
+
+  if (UNLIKELY(size <= 0))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid size requested: %zu"
+              "Error code: %d.\n",
+              size,
+              ret);
+    goto function_output;
+  }
+
+  max_class = (size_t)((allocator->num_size_classes - 1u) * BYTES_PER_CLASS);
+  index     = (size_t)((size + BYTES_PER_CLASS - 1u) / BYTES_PER_CLASS);
+
+  if (UNLIKELY(index >= allocator->num_size_classes))
+  {
+    LOG_WARNING("Size overflow - "
+                "Requested: %zu bytes | Max class: %zu bytes | "
+                "Clamped to class %zu.\n",
+                size,
+                max_class,
+                (allocator->num_size_classes - 1u));
+    index = (size_t)(allocator->num_size_classes - 1);
+  }
+  else
+  {
+    LOG_INFO("Size class calculated - "
+             "Requested: %zu bytes | Class: %zu (%zu-%zu bytes).\n",
+             size,
+             index,
+             index * BYTES_PER_CLASS,
+             ((index + 1u) * BYTES_PER_CLASS - 1u));
+  }
+
+  ret = (int)index;
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Inserts a block into the appropriate free list based on its size.
+ *
+ *  This function computes the size class index for the given @p block by
+ *  calling MEM_getSizeClass(), then pushes the block onto the head of that
+ *  free list within the allocator. It updates both forward and backward
+ *  links to maintain the doubly‐linked list of free blocks.
+ *
+ *  @param[in]  allocator Pointer to the allocator context.
+ *  @param[in]  block     Pointer to the block header to insert.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: @p block successfully inserted.
+ *  @retval -EINVAL:      @p allocator or @p block is NULL.
+ *  @retval -ENOMEM:      Size class calculation failed (request too large).
+ * ========================================================================== */
+static int MEM_insertFreeBlock(mem_allocator_t *const allocator,
+                               block_header_t *const  block)
+{
+  int ret = EXIT_SUCCESS;
+
+  int index = 0u;
+
+  if (UNLIKELY(allocator == NULL || block == NULL))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid parameters - Allocator: %p, Block: %p. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              (void *)block,
+              ret);
+    goto function_output;
+  }
+
+  index = MEM_getSizeClass(allocator, block->size);
+  if (index < 0)
+  {
+    ret = -ENOMEM;
+    goto function_output;
+  }
+
+  block->fl_next = allocator->free_lists[index];
+
+  block->fl_prev = (block_header_t *)NULL;
+  if (allocator->free_lists[index])
+    allocator->free_lists[index]->fl_prev = block;
+
+  allocator->free_lists[index] = block;
+  LOG_INFO("Block %p inserted into free list %d (size: %zu)\n",
+           (void *)block,
+           index,
+           block->size);
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Removes a block from its free list.
+ *
+ *  This function unlinks the specified @p block from the free list
+ * corresponding to its size class within the allocator. It computes the
+ * size‐class index via MEM_getSizeClass(), validates parameters, then adjusts
+ * the neighboring blocks’ fl_next and fl_prev pointers (or the list head) to
+ * remove @p block. The block’s own fl_next and fl_prev are then cleared.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  block     Block header to remove.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Block removed successfully.
+ *  @retval -EINVAL:      @p allocator or @p block is NULL.
+ *  @retval -ENOMEM:      Size‐class calculation failed.
+ * ========================================================================== */
+static int MEM_removeFreeBlock(mem_allocator_t *const allocator,
+                               block_header_t *const  block)
+{
+  int ret = EXIT_SUCCESS;
+
+  int index = 0u;
+
+  if (UNLIKELY(allocator == NULL || block == NULL))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid parameters: allocator: %p, block: %p. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              (void *)block,
+              ret);
+    goto function_output;
+  }
+
+  index = MEM_getSizeClass(allocator, block->size);
+  if (index < 0)
+  {
+    ret = -ENOMEM;
+    goto function_output;
+  }
+
+  if (block->fl_prev)
+    block->fl_prev->fl_next = block->fl_next;
+  else
+    allocator->free_lists[index] = block->fl_next;
+
+  if (block->fl_next)
+    block->fl_next->fl_prev = block->fl_prev;
+
+  block->fl_next = (block_header_t *)NULL;
+  block->fl_prev = (block_header_t *)NULL;
+
+  LOG_INFO("Block %p removed from free list %d (size: %zu)\n",
+           (void *)block,
+           index,
+           block->size);
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Initializes the memory allocator and its internal structures.
+ *
+ *  This function prepares the allocator’s heap by:
+ *    - Reading and aligning the initial program break to ARCH_ALIGNMENT.
+ *    - Allocating the arena array and free‐list bins via MEM_growUserHeap().
+ *    - Zeroing out the free‐list bins.
+ *    - Initializing the allocator fields (heap_start, heap_end, free_lists).
+ *    - Setting up the garbage‐collector thread state and its mutex/cond.
+ *    - Capturing the current thread’s stack bounds via MEM_stackBounds().
+ *    - (If under Valgrind) creating a mempool for the allocator.
+ *
+ *  @param[in]  allocator Pointer to a mem_allocator_t instance to initialize.
+ *
+ *  @return Integer status code indicating initialization result.
+ *
+ *  @retval EXIT_SUCCESS: Allocator initialized successfully.
+ *  @retval -EINVAL:      Invalid @p allocator pointer.
+ *  @retval -ENOMEM:      Heap alignment or arena/bin allocation failed.
+ * ========================================================================== */
+static int MEM_allocatorInit(mem_allocator_t *const allocator)
+{
+  int ret = EXIT_SUCCESS;
+
+  __UNUSED static bool mempool_created = false;
+
+  mem_arena_t *arena     = (mem_arena_t *)NULL;
+  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
+
+  pthread_condattr_t cond_attr;
+
+  void *base = (void *)NULL;
+  void *old  = (void *)NULL;
+
+  uintptr_t addr = 0;
+
+  size_t pad        = 0u;
+  size_t bins_bytes = 0u;
+
+  g_allocator_inited = true;
+
+  allocator->last_brk_start = NULL;
+  allocator->last_brk_end   = NULL;
+
+  base = MEM_sbrk(0);
+  if (base == PTR_ERR(-ENOMEM))
+  {
+    ret = -ENOMEM;
+    LOG_ERROR("unable to get heap base address %p. "
+              "Error code: %d.\n",
+              (void *)base,
+              ret);
+    goto function_output;
+  }
+
+  addr = (uintptr_t)base;
+  pad  = (size_t)((ARCH_ALIGNMENT - (addr % ARCH_ALIGNMENT)) % ARCH_ALIGNMENT);
+
+  if (pad)
+  {
+    old = MEM_sbrk((intptr_t)pad);
+    if (old == PTR_ERR(-ENOMEM) || old == PTR_ERR(-EINVAL))
+    {
+      ret = -ENOMEM;
+      LOG_ERROR("Unable to align heap (requested pad=%zu bytes). "
+                "Error code: %d.\n",
+                pad,
+                ret);
+      goto function_output;
+    }
+  }
+
+  allocator->heap_start     = (uint8_t *)base;
+  allocator->heap_end       = (uint8_t *)base;
+  allocator->last_allocated = (block_header_t *)NULL;
+
+  allocator->num_arenas = 1u;
+
+  allocator->arenas
+    = (mem_arena_t *)MEM_growUserHeap(allocator, sizeof(mem_arena_t));
+  if (allocator->arenas == PTR_ERR(-ENOMEM))
+  {
+    ret = -ENOMEM;
+    LOG_ERROR("Unable to allocate memory for arenas. "
+              "Error code: %d.\n",
+              ret);
+    goto function_output;
+  }
+
+  arena = &allocator->arenas[0];
+
+  arena->top_chunk = (block_header_t *)NULL;
+  arena->num_bins  = DEFAULT_NUM_BINS;
+
+  bins_bytes = (size_t)(arena->num_bins * sizeof(block_header_t *));
+
+  arena->bins = MEM_growUserHeap(allocator, (intptr_t)bins_bytes);
+  if (arena->bins == (void *)(-ENOMEM))
+  {
+    ret = -ENOMEM;
+    LOG_ERROR("Unable to allocate memory for free lists (bins). "
+              "Error code: %d.\n",
+              ret);
+    goto function_output;
+  }
+
+  MEM_memset(arena->bins, 0, bins_bytes);
+
+  allocator->free_lists       = arena->bins;
+  allocator->num_size_classes = arena->num_bins;
+
+  allocator->mmap_list = (mmap_t *)NULL;
+
+  allocator->metadata_size
+    = ((uintptr_t)arena->bins + bins_bytes) - (uintptr_t)allocator->heap_start;
+
+  MEM_memcpy(allocator->tags[MEM_TAG_DEFAULT].name,
+             "default",
+             sizeof("default"));
+  atomic_store_explicit(&allocator->num_tags, 1u, memory_order_release);
+  atomic_store_explicit(&allocator->num_layouts,
+                        MEM_LAYOUT_FIRST,
+                        memory_order_release);
+
+  gc_thread = &allocator->gc_thread;
+
+  gc_thread->gc_interval_ms = GC_INTERVAL_MS;
+
+  if (MEM_cgroupResolve(allocator->cgroup.dir) == EXIT_SUCCESS)
+    (void)MEM_cgroupLoad(allocator);
+
+  gc_thread->gc_thread_started = false;
+  gc_thread->gc_running        = false;
+  gc_thread->gc_exit           = false;
+
+  ret = pthread_mutex_init(&gc_thread->gc_lock,
+                           (const pthread_mutexattr_t *)NULL);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  ret = pthread_condattr_init(&cond_attr);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  ret = pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+  if (ret == EXIT_SUCCESS)
+    ret = pthread_cond_init(&gc_thread->gc_cond, &cond_attr);
+
+  pthread_condattr_destroy(&cond_attr);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  ret = pthread_cond_init(&allocator->gc_pace.done,
+                          (const pthread_condattr_t *)NULL);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  allocator->gc_pace.ratio   = GC_RATIO_DEFAULT;
+  allocator->gc_pace.idle_ms = GC_INTERVAL_MS;
+  allocator->gc_pace.trigger = GC_MIN_TRIGGER;
+
+  ret = MEM_stackBounds(pthread_self( ), allocator);
+  if (ret != EXIT_SUCCESS)
+  {
+    LOG_ERROR("Unable to capture stack bounds. "
+              "Error code: %d.\n",
+              ret);
+    goto function_output;
+  }
+
+#ifdef RUNNING_ON_VALGRIND
+  if (mempool_created)
+    VALGRIND_DESTROY_MEMPOOL(allocator);
+
+  VALGRIND_CREATE_MEMPOOL(allocator, 0, false);
+  mempool_created = true;
+#endif
+
+  LOG_INFO("Allocator initialized: initial_heap=[%p...%p], bins=%zu.\n",
+           (void *)allocator->heap_start,
+           (void *)allocator->heap_end,
+           arena->num_bins);
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Expands the user heap by a specified increment.
+ *
+ *  This function moves the program break by @p inc bytes via MEM_sbrk(),
+ *  zeroes the newly allocated region, updates the allocator’s heap_end, and
+ *  initializes a block_header_t at the start of the new region to record its
+ *  size, mark it as allocated, and set its free flag to false.
+ *
+ *  @param[in]  allocator Pointer to the allocator context.
+ *  @param[in]  inc       Signed number of bytes to grow (or shrink) the heap.
+ *
+ *  @return Pointer to the previous program break (start of new region)
+ *          on success; an error-encoded pointer (via PTR_ERR()) on failure.
+ *
+ *  @retval (ret>=0): Previous heap end address (new region start).
+ *  @retval -EINVAL:  @p allocator is NULL.
+ *  @retval -ENOMEM:  Heap expansion failed (out of memory).
+ * ========================================================================== */
+static void *MEM_growUserHeap(mem_allocator_t *const allocator,
+                              const intptr_t         inc)
+{
+  void *old = (void *)NULL;
+
+  block_header_t *header = (block_header_t *)NULL;
+
+  if (UNLIKELY(allocator == NULL))
+  {
+    old = PTR_ERR(-EINVAL);
+    LOG_ERROR("Invalid arguments: allocator=%p. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              (int)(intptr_t)old);
+    goto function_output;
+  }
+
+  if (inc > 0 && MEM_checkLimits(allocator, (size_t)inc) != EXIT_SUCCESS)
+  {
+    old = PTR_ERR(-ENOMEM);
+    goto function_output;
+  }
+
+  old = MEM_sbrk(inc);
+
+  if ((intptr_t)old < 0)
+    goto function_output;
+
+  MEM_memset(old, 0, (size_t)inc);
+
+  header = (block_header_t *)old;
+
+  header->size   = (size_t)inc;
+  header->free   = 1u;
+  header->marked = 0u;
+
+  allocator->heap_end = (uint8_t *)((uint8_t *)old + inc);
+
+  allocator->last_brk_start = (uint8_t *)old;
+  allocator->last_brk_end   = (uint8_t *)old + inc;
+
+function_output:
+  return old;
+}
+/** ============================================================================
+ *  @brief      Allocates a page-aligned memory region via mmap and registers it
+ *              in the allocator’s mmap list for later freeing.
+ *
+ *  This function rounds up @p total_size to a multiple of the system page size,
+ *  invokes mmap() to obtain an anonymous read/write region, then allocates
+ *  an mmap_t metadata node via MEM_allocOp() and links it into
+ *  allocator->mmap_list.  It initializes a block_header_t and trailing canary
+ *  in the mapped region to integrate with the allocator’s debugging and GC.
+ *
+ *  @param[in]  allocator   Pointer to the memory allocator context.
+ *  @param[in]  total_size  Number of bytes requested.
+ *
+ *  @return On success, returns the address of the mapped region.
+ *          On failure, returns an error-encoded pointer (via PTR_ERR()).
+ *
+ *  @retval ret!=MAP_FAILED:  Address of the mapped region.
+ *  @retval -EINVAL:          @p allocator is NULL.
+ *  @retval -EIO:             mmap() failed.
+ *  @retval -ENOMEM:          Allocation of mmap_t metadata failed.
+ * ========================================================================== */
+static void *MEM_mapAlloc(mem_allocator_t *const allocator,
+                          const size_t           total_size)
+{
+  void *ptr = (void *)NULL;
+
+  mmap_t *map_block = (mmap_t *)NULL;
+
+  block_header_t *header = (block_header_t *)NULL;
+
+  uintptr_t *data_canary = (uintptr_t *)NULL;
+  uintptr_t  canary_addr = 0u;
+
+  size_t page     = 0u;
+  size_t map_size = 0u;
+
+  if (UNLIKELY(allocator == NULL))
+  {
+    ptr = PTR_ERR(-EINVAL);
+    LOG_ERROR("Invalid arguments: allocator=%p. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              (int)(intptr_t)ptr);
+    goto function_output;
+  }
+
+  page     = (size_t)sysconf(_SC_PAGESIZE);
+  map_size = ((total_size + page - 1u) / page) * page;
+
+  if (MEM_checkLimits(allocator, map_size) != EXIT_SUCCESS)
+  {
+    ptr = PTR_ERR(-ENOMEM);
+    goto function_output;
+  }
+
+  ptr = mmap(NULL,
+             map_size,
+             PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS,
+             -1,
+             0);
+  if (ptr == MAP_FAILED)
+  {
+    ptr = PTR_ERR(-EIO);
+    LOG_ERROR("Mmap failed: %zu bytes. "
+              "Error code: %d.\n",
+              map_size,
+              (int)(intptr_t)ptr);
+    goto function_output;
+  }
+
+  map_block = MEM_allocOp(allocator,
+                          sizeof(mmap_t),
+                          __FILE__,
+                          __LINE__,
+                          FIRST_FIT,
+                          MEM_TAG_DEFAULT);
+  if (map_block == NULL || (intptr_t)map_block < 0)
+  {
+    munmap(ptr, map_size);
+    ptr = PTR_ERR(-ENOMEM);
+    LOG_ERROR("Mmap metadata allocation failed: %zu bytes. "
+              "Error code: %d.\n",
+              sizeof(mmap_t),
+              (int)(intptr_t)ptr);
+    goto function_output;
+  }
+
+  map_block->addr      = ptr;
+  map_block->size      = map_size;
+  map_block->next      = allocator->mmap_list;
+  allocator->mmap_list = map_block;
+
+  allocator->limits.mapped_bytes += map_size;
+
+  header = (block_header_t *)ptr;
+
+  header->magic  = MAGIC_NUMBER;
+  header->size   = map_size;
+  header->free   = 0u;
+  header->marked = 1u;
+  header->prev   = (block_header_t *)NULL;
+  header->next   = (block_header_t *)NULL;
+  header->file   = (const char *)NULL;
+  header->line   = 0u;
+
+  canary_addr  = (uintptr_t)ptr + map_size - sizeof(uintptr_t);
+  data_canary  = (uintptr_t *)canary_addr;
+  *data_canary = CANARY_VALUE;
+
+  LOG_INFO("Mmap allocated: %zu bytes at %p.\n", map_size, ptr);
+
+function_output:
+  return ptr;
+}
+
+/** ============================================================================
+ *  @brief  Unmaps a previously mapped memory region and removes its
+ *          metadata entry from the allocator’s mmap list.
+ *
+ *  This function searches the allocator’s mmap_list for an entry matching
+ *  @p addr, calls munmap() to unmap the region, unlinks the corresponding
+ *  mmap_t metadata node, and frees it via MEM_freeOp().  Errors during
+ *  munmap are returned; if metadata freeing fails, an error is logged but
+ *  success is returned.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  addr      Address of the memory region to unmap.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Region unmapped and metadata entry removed.
+ *  @retval -EINVAL:      @p allocator / @p addr is NULL, or not found in list.
+ *  @retval -ENOMEM:      munmap() failed to unmap the region.
+ * ========================================================================== */
+static int MEM_mapFree(mem_allocator_t *const allocator, void *const addr)
+{
+  int ret = EXIT_SUCCESS;
+
+  mmap_t **map_ref = (mmap_t **)NULL;
+  mmap_t  *to_free = (mmap_t *)NULL;
+
+  size_t map_size = 0u;
+
+  if (UNLIKELY(allocator == NULL || addr == NULL))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid arguments: allocator=%p addr=%p. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              addr,
+              ret);
+    goto function_output;
+  }
+
+  map_ref = &allocator->mmap_list;
+  while (*map_ref)
+  {
+    if ((*map_ref)->addr == addr)
+    {
+      map_size = (*map_ref)->size;
+
+      if (munmap(addr, map_size) != 0)
+      {
+        ret = -ENOMEM;
+        LOG_ERROR("Mmap failed: %zu bytes. "
+                  "Error code: %d.\n",
+                  map_size,
+                  ret);
+        goto function_output;
+      }
+
+      to_free  = *map_ref;
+      *map_ref = to_free->next;
+
+      allocator->limits.mapped_bytes -= map_size;
+
+      ret = MEM_freeOp(allocator, (void *)to_free, __FILE__, __LINE__);
+      if (ret != EXIT_SUCCESS)
+      {
+        LOG_ERROR("Mmap metadata free failed: %zu bytes. "
+                  "Error code: %d.\n",
+                  sizeof(mmap_t),
+                  (int)(intptr_t)ret);
+        goto function_output;
+      }
+
+      LOG_INFO("Munmap freed: %zu bytes at %p.\n", map_size, addr);
+    }
+    else
+    {
+      map_ref = &(*map_ref)->next;
+    }
+  }
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Tells whether a free-list block can hold an allocation.
+ *
+ *  The block must pass MEM_validateBlock(), be free and span at least
+ *  @p size bytes. With the garbage collector, the part a split would hand
+ *  out must also stay clear of blacklisted pages (MEM_gcBlacklisted()).
+ *
+ *  @param[in]  allocator Pointer to the allocator context.
+ *  @param[in]  block     Candidate free block.
+ *  @param[in]  size      Total size requested (including header and canary).
+ *
+ *  @return true if @p block can be split to hold @p size bytes.
+ * ========================================================================== */
+static bool MEM_blockFits(mem_allocator_t *const allocator,
+                          block_header_t *const  block,
+                          const size_t           size)
+{
+  bool fits = false;
+
+  if (MEM_validateBlock(allocator, block) != EXIT_SUCCESS || !block->free
+      || block->size < size)
+    goto function_output;
+
+#if defined(GARBAGE_COLLECTOR)
+  if (MEM_gcBlacklisted(allocator, block, size))
+    goto function_output;
+#endif
+
+  fits = true;
+
+function_output:
+  return fits;
+}
+
+/** ============================================================================
+ *  @brief  Searches for the first suitable free memory block in size‐class
+ * lists.
+ *
+ *  This function computes the starting size class for the requested @p size via
+ *  MEM_getSizeClass(), then scans each free‐list from that class upward.  For
+ * each candidate block, it calls MEM_validateBlock() to ensure integrity, and
+ * returns the first block that is marked free and large enough. The found block
+ * pointer is stored in @p fit_block.
+ *
+ *  @param[in]  allocator Pointer to the allocator context.
+ *  @param[in]  size       Requested allocation size in bytes.
+ *  @param[out] fit_block On success, set to the pointer of a suitable free
+ * block.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Suitable block found successfully.
+ *  @retval -EINVAL:      @p allocator or @p fit_block are NULL;
+ *  @retval -ENOMEM:      Size calculation failed or no suitable block found.
+ * ========================================================================== */
+static int MEM_findFirstFit(mem_allocator_t *const allocator,
+                            const size_t           size,
+                            block_header_t       **fit_block)
+{
+  int ret = EXIT_SUCCESS;
+
+  block_header_t *current = (block_header_t *)NULL;
+
+  int    start_class = 0;
+  size_t class_idx   = 0u;
+
+  if (UNLIKELY(allocator == NULL || fit_block == NULL))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid parameters: allocator %p | fit_block %p. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              (void *)fit_block,
+              ret);
+    goto function_output;
+  }
+
+  start_class = MEM_getSizeClass(allocator, size);
+  if (start_class < 0)
+  {
+    ret = -ENOMEM;
+    goto function_output;
+  }
+
+  for (class_idx = (size_t)start_class; class_idx < allocator->num_size_classes;
+       class_idx++)
+  {
+    current = allocator->free_lists[class_idx];
+    while (current)
+    {
+      if (MEM_blockFits(allocator, current, size))
+      {
+        ret        = EXIT_SUCCESS;
+        *fit_block = current;
+        goto function_output;
+      }
+
+      current = current->fl_next;
+    }
+  }
+
+  ret = -ENOMEM;
+  LOG_WARNING("First-fit allocation failed: "
+              "Req size: %zu | Max checked class: %zu. "
+              "Error code: %d.\n",
+              size,
+              (size_t)(allocator->num_size_classes - 1u),
+              ret);
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Searches for the next suitable free memory block using the
+ *          NEXT_FIT strategy starting from the last allocated position.
+ *
+ *  This function attempts to find a free block of at least @p size bytes by
+ *  scanning the heap starting at allocator->last_allocated.  If last_allocated
+ *  is NULL, not free, or corrupted, it falls back to First-Fit.  It wraps
+ *  around to the heap start if needed, stopping once it returns to the start.
+ *
+ *  @param[in]  allocator Pointer to the allocator context.
+ *  @param[in]  size      Requested allocation size in bytes.
+ *  @param[out] fit_block Pointer to store the address of the found block.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Suitable block found and fit_block set.
+ *  @retval -EINVAL:      @p allocator or @p fit_block is NULL.
+ *  @retval -ENOMEM:      No suitable block found in heap.
+ * ========================================================================== */
+static int MEM_findNextFit(mem_allocator_t *const allocator,
+                           const size_t           size,
+                           block_header_t       **fit_block)
+{
+  int ret = EXIT_SUCCESS;
+
+  block_header_t *current = (block_header_t *)NULL;
+  block_header_t *start   = (block_header_t *)NULL;
+
+  if (UNLIKELY(allocator == NULL || fit_block == NULL))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid parameters: allocator %p | fit_block %p. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              (void *)fit_block,
+              ret);
+    goto function_output;
+  }
+
+  if (allocator->last_allocated == NULL || allocator->last_allocated->free == 0
+      || allocator->last_allocated->magic != MAGIC_NUMBER)
+  {
+    LOG_INFO("Fallback to First-Fit (no valid last_allocated).\n");
+    ret = MEM_findFirstFit(allocator, size, fit_block);
+    if (ret == EXIT_SUCCESS)
+      allocator->last_allocated = *fit_block;
+
+    goto function_output;
+  }
+
+  current = allocator->last_allocated;
+  start   = current;
+
+  do
+  {
+    if (MEM_blockFits(allocator, current, size))
+    {
+      ret                       = EXIT_SUCCESS;
+      *fit_block                = current;
+      allocator->last_allocated = current;
+      goto function_output;
+    }
+
+    current
+      = (current->next)
+          ? current->next
+          : (block_header_t *)ASSUME_ALIGNED((uint8_t *)allocator->heap_start
+                                               + allocator->metadata_size,
+                                             ARCH_ALIGNMENT);
+
+  } while (current != start);
+
+  ret = -ENOMEM;
+  LOG_WARNING("Next-fit allocation failed: "
+              "Req size: %zu | Start block: %p. "
+              "Error code: %d.\n",
+              size,
+              (void *)start,
+              ret);
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Searches for the smallest suitable free memory block
+ *          in size‐class lists (BEST_FIT).
+ *
+ *  This function computes the starting size class for the requested @p size via
+ *  MEM_getSizeClass(), then scans each free‐list from that class upward.  It
+ *  validates each candidate with MEM_validateBlock() and tracks the smallest
+ *  free block that is large enough.  Once a block in any class is chosen, the
+ *  search stops.
+ *
+ *  @param[in]   allocator  Pointer to the allocator context.
+ *  @param[in]   size       Requested allocation size in bytes.
+ *  @param[out]  best_fit   On success, set to the pointer of the free block.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Suitable block found successfully.
+ *  @retval -EINVAL:      @p allocator or @p best_fit is NULL.
+ *  @retval -ENOMEM:      Size calculation failed or no suitable block found.
+ * ========================================================================== */
+static int MEM_findBestFit(mem_allocator_t *const allocator,
+                           const size_t           size,
+                           block_header_t       **best_fit)
+{
+  int ret = EXIT_SUCCESS;
+
+  block_header_t *current = (block_header_t *)NULL;
+
+  size_t iterator = 0u;
+
+  int start_class = 0;
+
+  if (UNLIKELY(allocator == NULL || best_fit == NULL))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid parameters: allocator %p | best_fit %p"
+              "Error code: %d.\n",
+              (void *)allocator,
+              (void *)best_fit,
+              ret);
+    goto function_output;
+  }
+
+  *best_fit = (block_header_t *)NULL;
+
+  start_class = MEM_getSizeClass(allocator, size);
+  if (start_class < 0)
+  {
+    ret = -ENOMEM;
+    goto function_output;
+  }
+
+  for (iterator = (size_t)start_class; iterator < allocator->num_size_classes;
+       iterator++)
+  {
+    current = allocator->free_lists[iterator];
+
+    while (current)
+    {
+      if (MEM_blockFits(allocator, current, size))
+      {
+        if (!(*best_fit) || current->size < (*best_fit)->size)
+          *best_fit = current;
+      }
+
+      current = current->fl_next;
+    }
+
+    if (*best_fit)
+    {
+      ret = EXIT_SUCCESS;
+      goto function_output;
+    }
+  }
+
+  ret = -ENOMEM;
+  LOG_WARNING("Best-fit allocation failed: "
+              "Req size: %zu | Max checked class: %zu. "
+              "Error code: %d.\n",
+              size,
+              (allocator->num_size_classes - 1),
+              ret);
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Splits a memory block into allocated and free portions.
+ *
+ *  This function takes an existing free @p block and a requested allocation
+ *  size @p req_size, and divides the block into:
+ *    - an allocated portion of size aligned up to ALIGN(req_size) plus header
+ *      and canary, marked as used;
+ *    - a remaining free portion (if its size ≥ MIN_BLOCK_SIZE) inserted back
+ *      into the appropriate free list.
+ *  If the leftover space would be too small (< MIN_BLOCK_SIZE), the entire
+ *  block is allocated without splitting.
+ *
+ *  @param[in]  allocator Pointer to the mem_allocator_t context.
+ *  @param[in]  block     Pointer to the block_header_t to split.
+ *  @param[in]  req_size  Requested allocation size in bytes.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Block split (or fully allocated) successfully.
+ *  @retval -EINVAL:      nvalid @p allocator or @p block pointer.
+ *  @retval -EPROTO:      Header canary mismatch (block corrupted).
+ *  @retval -EOVERFLOW:   Data canary mismatch (buffer overflow detected).
+ *  @retval -EFBIG:       Block’s size would extend past heap end.
+ *  @retval -EFAULT:      Block lies outside heap or mmap regions.
+ *  @retval -ENOMEM:      Failed to insert the new free remainder block.
+ *
+ *  @note If the remaining space after splitting would be less than
+ *        MIN_BLOCK_SIZE, this function allocates the entire block
+ *        no split) and removes it from its free list.
+ * ========================================================================== */
+static int MEM_splitBlock(mem_allocator_t *const allocator,
+                          block_header_t *const  block,
+                          const size_t           req_size)
+{
+  int ret = EXIT_SUCCESS;
+
+  block_header_t *new_block = (block_header_t *)NULL;
+
+  uintptr_t *data_canary = (uintptr_t *)NULL;
+  uintptr_t  canary_addr = 0u;
+
+  size_t aligned_size   = 0u;
+  size_t total_size     = 0u;
+  size_t remaining_size = 0u;
+  size_t original_size  = 0u;
+
+  if (UNLIKELY(allocator == NULL || block == NULL))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid parameters: allocator %p | block %p. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              (void *)block,
+              ret);
+    goto function_output;
+  }
+
+  ret = MEM_validateBlock(allocator, block);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  aligned_size = ALIGN(req_size);
+  total_size
+    = (size_t)(aligned_size + sizeof(block_header_t) + sizeof(uintptr_t));
+
+  ret = MEM_removeFreeBlock(allocator, block);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  original_size = block->size;
+
+  if (block->size < total_size + MIN_BLOCK_SIZE)
+  {
+    block->free   = 0u;
+    block->magic  = MAGIC_NUMBER;
+    block->canary = CANARY_VALUE;
+
+    canary_addr  = (uintptr_t)block + block->size - sizeof(uintptr_t);
+    data_canary  = (uintptr_t *)canary_addr;
+    *data_canary = CANARY_VALUE;
+
+    LOG_DEBUG("Using full block %p | Req size: %zu | Block size: %zu.\n",
+              (void *)block,
+              req_size,
+              original_size);
+    goto function_output;
+  }
+
+  remaining_size = block->size - total_size;
+
+  block->size   = total_size;
+  block->free   = 0u;
+  block->magic  = MAGIC_NUMBER;
+  block->canary = CANARY_VALUE;
+
+  canary_addr  = (uintptr_t)block + block->size - sizeof(uintptr_t);
+  data_canary  = (uintptr_t *)canary_addr;
+  *data_canary = CANARY_VALUE;
+
+  new_block = (block_header_t *)((uintptr_t)block + total_size);
+
+  new_block->magic  = MAGIC_NUMBER;
+  new_block->size   = remaining_size;
+  new_block->free   = 1u;
+  new_block->marked = 0u;
+  new_block->file   = (const char *)NULL;
+  new_block->line   = 0ull;
+  new_block->prev   = block;
+  new_block->next   = block->next;
+
+  if (block->next)
+    block->next->prev = new_block;
+  block->next = new_block;
+
+  if (allocator->arenas[0].top_chunk == block)
+    allocator->arenas[0].top_chunk = new_block;
+
+  new_block->canary = CANARY_VALUE;
+  canary_addr  = (uintptr_t)new_block + new_block->size - sizeof(uintptr_t);
+  data_canary  = (uintptr_t *)canary_addr;
+  *data_canary = CANARY_VALUE;
+
+  new_block->fl_next = (block_header_t *)NULL;
+  new_block->fl_prev = (block_header_t *)NULL;
+
+  ret = MEM_insertFreeBlock(allocator, new_block);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  LOG_DEBUG("Block split | Original: %p (%zu) | Alloc: %p (%zu) | Remainder: "
+            "%p (%zu).\n",
+            (void *)block,
+            original_size,
+            (void *)block,
+            block->size,
+            (void *)new_block,
+            new_block->size);
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief      Merges adjacent free memory blocks.
+ *
+ *  This function removes the specified @p block from its free list, then checks
+ *  its immediate neighbor blocks in memory.  If the next block is free and
+ *  valid, it unlinks and combines it with @p block, updating size, links, and
+ *  trailing canary.  It then checks the previous block; if it is also free and
+ *  valid, it merges @p block into the previous block.  Finally, the resulting
+ *  merged block is reinserted into the appropriate free list.
+ *
+ *  @param[in]  allocator Pointer to the allocator context.
+ *  @param[in]  block     Pointer to the free block header to merge.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Blocks merged (or single block reinserted)
+ * successfully.
+ *  @retval -EINVAL:      @p allocator or @p block is NULL.
+ *  @retval ret<0:        Returned by MEM_removeFreeBlock(),
+ * MEM_validateBlock(), MEM_insertFreeBlock(), or munmap() in inner calls
+ *                        indicating the specific failure.
+ * ========================================================================== */
+static int MEM_mergeBlocks(mem_allocator_t *const allocator,
+                           block_header_t        *block)
+{
+  int ret = EXIT_SUCCESS;
+
+  uint8_t *next_addr = (uint8_t *)NULL;
+
+  block_header_t *next_block = (block_header_t *)NULL;
+  block_header_t *prev_block = (block_header_t *)NULL;
+
+  uintptr_t *data_canary = (uintptr_t *)NULL;
+  uintptr_t  canary_addr = 0u;
+
+  if (UNLIKELY(allocator == NULL || block == NULL))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid parameters: allocator=%p, block=%p. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              (void *)block,
+              ret);
+    goto function_output;
+  }
+
+  ret = MEM_validateBlock(allocator, block);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  next_addr = (uint8_t *)((uint8_t *)block + block->size);
+  if (next_addr + sizeof(block_header_t) <= allocator->heap_end)
+  {
+    next_block = (block_header_t *)(uintptr_t)next_addr;
+
+    ret = MEM_validateBlock(allocator, next_block);
+    if (ret == EXIT_SUCCESS && next_block->free)
+    {
+      LOG_DEBUG("Merging blocks (next): cur=%p (%zu) | next=%p (%zu).\n",
+                (void *)((uint8_t *)block + sizeof(block_header_t)),
+                block->size,
+                (void *)((uint8_t *)next_block + sizeof(block_header_t)),
+                next_block->size);
+
+      ret = MEM_removeFreeBlock(allocator, next_block);
+      if (ret != EXIT_SUCCESS)
+        goto function_output;
+
+      block->size += next_block->size;
+      block->next  = next_block->next;
+      if (next_block->next)
+        next_block->next->prev = block;
+
+      if (allocator->arenas[0].top_chunk == next_block)
+        allocator->arenas[0].top_chunk = block;
+
+      canary_addr  = (uintptr_t)block + block->size - sizeof(uintptr_t);
+      data_canary  = (uintptr_t *)canary_addr;
+      *data_canary = CANARY_VALUE;
+
+      LOG_DEBUG("Merged(next): payload=%p (%zu).\n",
+                (void *)((uint8_t *)block + sizeof(block_header_t)),
+                block->size);
+    }
+  }
+
+  prev_block = block->prev;
+  if (prev_block)
+  {
+    ret = MEM_validateBlock(allocator, prev_block);
+    if (ret == EXIT_SUCCESS && prev_block->free
+        && (uint8_t *)prev_block + prev_block->size == (uint8_t *)block)
+    {
+      LOG_DEBUG("Merging blocks (prev): prev=%p (%zu) | cur=%p (%zu).\n",
+                (void *)((uint8_t *)prev_block + sizeof(block_header_t)),
+                prev_block->size,
+                (void *)((uint8_t *)block + sizeof(block_header_t)),
+                block->size);
+
+      ret = MEM_removeFreeBlock(allocator, prev_block);
+      if (ret != EXIT_SUCCESS)
+        goto function_output;
+
+      prev_block->size += block->size;
+      prev_block->next  = block->next;
+      if (block->next)
+        block->next->prev = prev_block;
+
+      if (allocator->arenas[0].top_chunk == block)
+        allocator->arenas[0].top_chunk = prev_block;
+
+      canary_addr
+        = (uintptr_t)prev_block + prev_block->size - sizeof(uintptr_t);
+      data_canary  = (uintptr_t *)canary_addr;
+      *data_canary = CANARY_VALUE;
+
+      block = prev_block;
+
+      LOG_DEBUG("Merged(prev): payload=%p (%zu).\n",
+                (void *)((uint8_t *)block + sizeof(block_header_t)),
+                block->size);
+    }
+  }
+
+  block->fl_next = (block_header_t *)NULL;
+  block->fl_prev = (block_header_t *)NULL;
+
+  ret = MEM_insertFreeBlock(allocator, block);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Allocates memory using the specified strategy.
+ *
+ *  This function attempts to allocate at least @p size bytes of user data by
+ *  choosing between heap‐based allocation (via free‐lists and optional heap
+ *  growth) or mmap (for large requests > MMAP_THRESHOLD).  It uses the
+ *  given @p strategy (FIRST_FIT, NEXT_FIT, BEST_FIT) to locate a free block,
+ *  grows the heap if necessary, splits a larger block to fit exactly, and
+ *  records debugging metadata (source file, line).  While a lazy sweep is
+ *  pending, heap requests first sweep part of the heap with
+ *  MEM_gcLazySweep(), and keep sweeping before growing it.  Free blocks
+ *  whose payload would sit on pages blacklisted by the collector are passed
+ *  over; if only the grown space is left and it is blacklisted too, the
+ *  search runs again ignoring the blacklist.  For mmap allocations it rounds
+ *  up to page size and tracks the region in the allocator.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  size      Number of bytes requested.
+ *  @param[in]  file      Source file name for debugging metadata.
+ *  @param[in]  line      Source line number for debugging metadata.
+ *  @param[in]  strategy  Allocation strategy.
+ *  @param[in]  tag       Accounting tag charged for the block.
+ *
+ *  @return Pointer to the start of the allocated user region (just past
+ *          the internal header) on success; an error‐encoded pointer
+ *          (via PTR_ERR()) on failure.
+ *
+ *  @retval ptr:      Valid user pointer on success.
+ *  @retval -EINVAL:  @p allocator is NULL or @p size is zero.
+ *  @retval -ENOMEM:  Out of memory: heap grow failed, no free
+ *                    block found, or internal metadata allocation
+ *                    (e.g. mmap_t node) failed.
+ *  @retval -EIO:     mmap() I/O error for large allocations.
+ * ========================================================================== */
+static void *MEM_allocOp(mem_allocator_t *const      allocator,
+                         const size_t                size,
+                         const char *const           file,
+                         const int                   line,
+                         const allocation_strategy_t strategy,
+                         const uint32_t              tag)
+{
+  void *user_ptr = (void *)NULL;
+
+  mem_arena_t    *arena = (mem_arena_t *)NULL;
+  block_header_t *block = (block_header_t *)NULL;
+
+  void *old_brk  = (void *)NULL;
+  void *raw_mmap = (void *)NULL;
+
+  uintptr_t *data_canary = (uintptr_t *)NULL;
+  uintptr_t  canary_addr = 0u;
+
+  size_t total_size = 0u;
+
+  int ret = EXIT_SUCCESS;
+
+  const find_fn_t find_fns[] = {
+    [FIRST_FIT] = MEM_findFirstFit,
+    [NEXT_FIT]  = MEM_findNextFit,
+    [BEST_FIT]  = MEM_findBestFit,
+  };
+
+  if (UNLIKELY(allocator == NULL || size <= 0))
+  {
+    user_ptr = PTR_ERR(-EINVAL);
+    LOG_ERROR("Invalid arguments: allocator=%p | size=%zu. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              size,
+              (int)(intptr_t)user_ptr);
+    goto null_pointer;
+  }
+
+  total_size = ALIGN(size) + sizeof(block_header_t) + sizeof(uintptr_t);
+  arena      = &allocator->arenas[0];
+
+  if (size > MMAP_THRESHOLD)
+  {
+    raw_mmap = MEM_mapAlloc(allocator, total_size);
+    if (raw_mmap == NULL || (intptr_t)raw_mmap < 0)
+    {
+      user_ptr = (raw_mmap == NULL) ? PTR_ERR(-ENOMEM) : raw_mmap;
+      LOG_ERROR("Mmap failed: %zu bytes. Error code: %d.\n",
+                total_size,
+                (int)(intptr_t)user_ptr);
+      goto function_output;
+    }
+
+    block = (block_header_t *)raw_mmap;
+
+    block->magic  = MAGIC_NUMBER;
+    block->size   = total_size;
+    block->free   = 0u;
+    block->marked = 0u;
+    block->next   = (block_header_t *)NULL;
+    block->prev   = (block_header_t *)NULL;
+    block->canary = CANARY_VALUE;
+
+    canary_addr  = (uintptr_t)block + total_size - sizeof(uintptr_t);
+    data_canary  = (uintptr_t *)canary_addr;
+    *data_canary = CANARY_VALUE;
+
+    block->file = file;
+    block->line = (uint64_t)line;
+    block->tag    = tag;
+    block->layout = MEM_LAYOUT_CONSERVATIVE;
+
+    (void)MEM_tagAccount(allocator, block, true);
+
+#if defined(GARBAGE_COLLECTOR)
+    MEM_gcTrack(allocator, block, true);
+    MEM_gcPace(allocator, block->size);
+#endif
+
+    LOG_INFO("Mmap used for alloc: %p (%zu bytes).\n", raw_mmap, size);
+    user_ptr = (uint8_t *)raw_mmap + sizeof(block_header_t);
+    goto function_output;
+  }
+
+#if defined(GARBAGE_COLLECTOR)
+  (void)MEM_gcLazySweep(allocator);
+
+  allocator->gc_blacklist.skipped = false;
+#endif
+
+  ret = find_fns[strategy](allocator, total_size, &block);
+
+#if defined(GARBAGE_COLLECTOR)
+  while (ret == -ENOMEM && MEM_gcLazySweep(allocator))
+    ret = find_fns[strategy](allocator, total_size, &block);
+#endif
+
+  if (ret == -ENOMEM)
+  {
+    old_brk = MEM_growUserHeap(allocator, (intptr_t)total_size);
+    if ((intptr_t)old_brk < 0)
+    {
+      user_ptr = PTR_ERR(-ENOMEM);
+      LOG_ERROR("Heap grow failed: requested %zu bytes, old_brk=%ld. "
+                "Error code: %d.\n",
+                total_size,
+                (long)old_brk,
+                (int)(intptr_t)user_ptr);
+      goto function_output;
+    }
+
+    allocator->last_brk_start = (uint8_t *)((uint8_t *)old_brk);
+    allocator->last_brk_end   = (uint8_t *)((uint8_t *)old_brk + total_size);
+
+#if defined(GARBAGE_COLLECTOR)
+    if (allocator->gc_blacklist.skipped)
+      allocator->gc_blacklist.grown += total_size;
+#endif
+
+    block = (block_header_t *)old_brk;
+
+    block->magic  = MAGIC_NUMBER;
+    block->size   = total_size;
+    block->free   = 1u;
+    block->marked = 0u;
+    block->next   = (block_header_t *)NULL;
+    block->prev   = (block_header_t *)NULL;
+    block->canary = CANARY_VALUE;
+
+    if (arena->top_chunk != NULL && arena->top_chunk->magic == MAGIC_NUMBER
+        && (uint8_t *)arena->top_chunk + arena->top_chunk->size
+             == (uint8_t *)block)
+    {
+      block->prev            = arena->top_chunk;
+      arena->top_chunk->next = block;
+    }
+
+    arena->top_chunk = block;
+
+    canary_addr  = (uintptr_t)block + total_size - sizeof(uintptr_t);
+    data_canary  = (uintptr_t *)canary_addr;
+    *data_canary = CANARY_VALUE;
+
+    block->fl_next = (block_header_t *)NULL;
+    block->fl_prev = (block_header_t *)NULL;
+
+    ret = MEM_insertFreeBlock(allocator, block);
+    if (ret != EXIT_SUCCESS)
+      goto function_output;
+
+    ret = find_fns[strategy](allocator, total_size, &block);
+
+#if defined(GARBAGE_COLLECTOR)
+    if (ret == -ENOMEM)
+    {
+      allocator->gc_blacklist.bypass = true;
+      ret = find_fns[strategy](allocator, total_size, &block);
+      allocator->gc_blacklist.bypass = false;
+    }
+#endif
+  }
+
+  if (ret != EXIT_SUCCESS)
+  {
+    user_ptr = PTR_ERR((ret == -ENOMEM) ? -ENOMEM : -EIO);
+    goto function_output;
+  }
+
+  if (strategy == NEXT_FIT)
+    allocator->last_allocated = block;
+
+  ret = MEM_splitBlock(allocator, block, size);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  block->file = file;
+  block->line = (uint64_t)line;
+  block->tag    = tag;
+  block->layout = MEM_LAYOUT_CONSERVATIVE;
+
+  (void)MEM_tagAccount(allocator, block, true);
+
+#if defined(GARBAGE_COLLECTOR)
+  MEM_gcTrack(allocator, block, true);
+  MEM_gcPace(allocator, block->size);
+#endif
+
+  user_ptr = (void *)((uint8_t *)block + sizeof(block_header_t));
+
+function_output:
+
+#ifdef RUNNING_ON_VALGRIND
+  VALGRIND_MEMPOOL_ALLOC(allocator,
+                         user_ptr,
+                         block ? (block->size - sizeof(block_header_t)
+                                  - sizeof(uintptr_t))
+                               : 0);
+#endif
+
+null_pointer:
+  return user_ptr;
+}
+
+/** ============================================================================
+ *  @brief  Reallocates memory with safety checks.
+ *
+ *  This function resizes an existing allocation to @p new_size bytes:
+ *    - If @p ptr is NULL, behaves like malloc().
+ *    - If the existing block is already large enough, returns the same pointer.
+ *    - Otherwise, allocates a new block with the specified @p strategy,
+ *      copies the lesser of old and new sizes, frees the old block, and
+ *      returns the new pointer.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  ptr       Pointer to the block to resize, or NULL to allocate.
+ *  @param[in]  new_size  New requested size in bytes.
+ *  @param[in]  file      Source file name for debugging metadata.
+ *  @param[in]  line      Source line number for debugging metadata.
+ *  @param[in]  strategy  Allocation strategy to use.
+ *
+ *  @return Pointer to the reallocated memory region (which may be the same
+ *          as @p ptr) on success; an error-encoded pointer (via PTR_ERR())
+ *          on failure.
+ *
+ *  @retval ptr:      Valid pointer to a block of at least @p new_size bytes.
+ *  @retval -EINVAL:  @p allocator is NULL, @p new_size is zero.
+ *  @retval -ENOMEM:  Out of memory (allocation or free failure).
+ *  @retval -EIO:     I/O error for large mmap-based allocations.
+ * ========================================================================== */
+static void *MEM_reallocOp(mem_allocator_t *const      allocator,
+                           void *const                 ptr,
+                           const size_t                new_size,
+                           const char *const           file,
+                           const int                   line,
+                           const allocation_strategy_t strategy)
+{
+  int ret = EXIT_SUCCESS;
+
+  void *new_ptr = (void *)NULL;
+  ;
+
+  block_header_t *old_block = (block_header_t *)NULL;
+  block_header_t *new_block = (block_header_t *)NULL;
+  ;
+
+  size_t old_size = 0u;
+
+  if (UNLIKELY(allocator == NULL || new_size <= 0))
+  {
+    new_ptr = PTR_ERR(-EINVAL);
+    LOG_ERROR("Invalid arguments: allocator=%p | size=%zu. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              new_size,
+              (int)(intptr_t)new_ptr);
+    goto function_output;
+  }
+
+  if (ptr == NULL)
+  {
+    new_ptr = MEM_allocOp(allocator,
+                          new_size,
+                          file,
+                          line,
+                          strategy,
+                          MEM_TAG_DEFAULT);
+    goto function_output;
+  }
+
+  old_block = (block_header_t *)((uintptr_t)ptr - sizeof(block_header_t));
+
+  ret = MEM_validateBlock(allocator, old_block);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  old_size
+    = (size_t)(old_block->size - sizeof(block_header_t) - sizeof(uintptr_t));
+  if (old_size >= new_size)
+  {
+    LOG_DEBUG("Reallocation not needed: "
+              "Addr: %p | Current size: %zu | New size: %zu.\n",
+              ptr,
+              old_size,
+              new_size);
+    new_ptr = ptr;
+    goto function_output;
+  }
+
+  new_ptr
+    = MEM_allocOp(allocator, new_size, file, line, strategy, old_block->tag);
+  if (new_ptr != NULL && (intptr_t)new_ptr > 0)
+  {
+    new_block = (block_header_t *)((uintptr_t)new_ptr - sizeof(block_header_t));
+    new_block->layout = old_block->layout;
+
+    if (MEM_memcpy(new_ptr, ptr, old_size) != new_ptr)
+    {
+      new_ptr = PTR_ERR(-EINVAL);
+      goto function_output;
+    }
+
+    ret = MEM_freeOp(allocator, ptr, file, line);
+    if (ret != EXIT_SUCCESS)
+      goto function_output;
+
+    LOG_INFO("Reallocated: Old: %p (%zu bytes) | New: %p (%zu bytes).\n",
+             ptr,
+             old_size,
+             new_ptr,
+             new_size);
+  }
+
+function_output:
+  return new_ptr;
+}
+
+/** ============================================================================
+ *  @brief  Allocates and zero‐initializes memory.
+ *
+ *  This function behaves like calloc(), allocating at least @p size bytes of
+ *  zeroed memory via MEM_allocOp() and then setting all bytes to zero.
+ *  It records debugging metadata (source file, line) and uses
+ *  the given @p strategy for allocation.
+ *
+ *  @param[in]  allocator Pointer to the mem_allocator_t context.
+ *  @param[in]  size      Number of bytes to allocate.
+ *  @param[in]  file      Source file name for debugging metadata.
+ *  @param[in]  line      Source line number for debugging metadata.
+ *  @param[in]  strategy  Allocation strategy to use.
+ *
+ *  @return Pointer to the start of the allocated zeroed region;
+ *          an error‐encoded pointer via PTR_ERR() on failure.
+ *
+ *  @retval ptr:      Valid pointer to @p size bytes of zeroed memory.
+ *  @retval -EINVAL:  @p allocator is NULL or @p size is zero.
+ *  @retval -ENOMEM:  Out of memory: allocation failed.
+ *  @retval -EIO:     I/O error for large mmap‐based allocations.
+ * ========================================================================== */
+static void *MEM_callocOp(mem_allocator_t *const      allocator,
+                          const size_t                size,
+                          const char *const           file,
+                          const int                   line,
+                          const allocation_strategy_t strategy)
+{
+  void *ptr = (void *)NULL;
+  ;
+
+  block_header_t *block = (block_header_t *)NULL;
+  ;
+
+  size_t data_size = 0u;
+
+  if (UNLIKELY(allocator == NULL || size == 0))
+  {
+    ptr = PTR_ERR(-EINVAL);
+    LOG_ERROR("Invalid arguments: allocator=%p | size=%zu. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              size,
+              (int)(intptr_t)ptr);
+    goto function_output;
+  }
+
+  ptr = MEM_allocOp(allocator, size, file, line, strategy, MEM_TAG_DEFAULT);
+  if (ptr == NULL)
+    goto function_output;
+
+  block = (block_header_t *)((uintptr_t)ptr - sizeof(block_header_t));
+  data_size
+    = (size_t)(block->size - sizeof(block_header_t) - sizeof(uintptr_t));
+
+  MEM_memset(ptr, 0, data_size);
+
+  LOG_DEBUG("Zero-initialized memory: addr: %p (%zu bytes).\n", ptr, size);
+
+function_output:
+  return ptr;
+}
+
+/** ============================================================================
+ *  @brief  Releases allocated memory back to the heap.
+ *
+ *  This function frees a pointer previously returned by MEM_allocOp().
+ *  It supports both heap‐based and mmap‐based allocations:
+ *    - For mmap regions, it delegates to MEM_mapFree() to unmap and remove
+ metadata.
+ *    - For heap blocks, it validates the block, checks for double frees,
+ *      marks the block free, merges with adjacent free blocks, and reinserts
+ *      the merged block into the free list.  If the merged block lies at
+ *      the current heap end, it shrinks the heap via MEM_sbrk().
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  ptr       Pointer to memory to free.
+ *  @param[in]  file      Source file name for debugging metadata.
+ *  @param[in]  line      Source line number for debugging metadata.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Memory freed (and heap possibly shrunk) successfully.
+ *  @retval -EINVAL:      @p allocator or @p ptr is NULL, @p ptr not found in
+                          @p allocator, or double free detected.
+ *  @retval -ENOMEM:      munmap() failed when freeing an mmap region.
+ *  @retval -EFAULT:      Block lies outside heap and mmap regions.
+ *  @retval -EPROTO:      Header canary mismatch (block corrupted).
+ *  @retval -EOVERFLOW:   Data canary mismatch (buffer overrun detected).
+ *  @retval -EFBIG:       Block size extends past heap end.
+ *  @retval rer<0:        Errors returned by MEM_validateBlock(),
+ *                        MEM_removeFreeBlock(), MEM_mergeBlocks(),
+ *                        or MEM_insertFreeBlock().
+ * ========================================================================== */
+static int MEM_freeOp(mem_allocator_t *const allocator,
+                      void *const            ptr,
+                      const char *const      file,
+                      const int              line)
+{
+  int ret = EXIT_SUCCESS;
+
+  block_header_t *block = (block_header_t *)NULL;
+  block_header_t *prev  = (block_header_t *)NULL;
+  mmap_t         *map   = (mmap_t *)NULL;
+
+  size_t freed_size = 0u;
+
+  if (UNLIKELY(allocator == NULL || ptr == NULL))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid parameters: allocator: %p | ptr: %p. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              ptr,
+              ret);
+    goto function_output;
+  }
+
+  block = (block_header_t *)((uintptr_t)ptr - sizeof(block_header_t));
+  for (map = allocator->mmap_list; map; map = map->next)
+  {
+    if ((void *)block == map->addr)
+    {
+      (void)MEM_tagAccount(allocator, block, false);
+
+#if defined(GARBAGE_COLLECTOR)
+      MEM_gcTrack(allocator, block, false);
+#endif
+
+      ret = MEM_mapFree(allocator, map->addr);
+      goto function_output;
+    }
+  }
+
+  block = (block_header_t *)((uintptr_t)ptr - sizeof(block_header_t));
+
+  ret = MEM_validateBlock(allocator, block);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  if (block->free)
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Double free on a freed block (%p). "
+              "Error code: %d.\n",
+              ptr,
+              ret);
+    goto function_output;
+  }
+
+  (void)MEM_tagAccount(allocator, block, false);
+
+#if defined(GARBAGE_COLLECTOR)
+  MEM_gcTrack(allocator, block, false);
+#endif
+
+#ifdef RUNNING_ON_VALGRIND
+  VALGRIND_MEMPOOL_FREE(allocator, ptr);
+#endif
+
+  block->free   = 1u;
+  block->marked = 0u;
+  block->file   = file;
+  block->line   = (uint64_t)line;
+
+  prev = block->prev;
+
+  ret = MEM_mergeBlocks(allocator, block);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  if (prev != NULL && prev->free && (uint8_t *)prev < (uint8_t *)block
+      && (uint8_t *)prev + prev->size > (uint8_t *)block)
+    block = prev;
+
+  if (MEM_shrinkTail(allocator, block))
+    goto function_output;
+
+  freed_size = (size_t)(block->size - sizeof(*block) - sizeof(uintptr_t));
+  LOG_INFO("Memory freed: addr: %p (%zu bytes).\n", ptr, freed_size);
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Returns the last sbrk() lease when a free block covers it.
+ *
+ *  Shrinks the heap conservatively: only when @p block ends at the heap
+ *  top, the program break was not moved by anyone else, and @p block spans
+ *  the whole lease of the last heap growth. What precedes the lease stays
+ *  on the free lists.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  block     Free block, on its free list.
+ *
+ *  @return true if the heap was shrunk, false otherwise.
+ * ========================================================================== */
+static bool MEM_shrinkTail(mem_allocator_t *const allocator,
+                           block_header_t *const  block)
+{
+  void *old = (void *)NULL;
+
+  uint8_t *cur_brk = (uint8_t *)NULL;
+
+  uintptr_t *data_canary = (uintptr_t *)NULL;
+  uintptr_t  canary_addr = 0u;
+
+  block_header_t *prev = (block_header_t *)NULL;
+
+  size_t lease = 0u;
+  size_t size  = 0u;
+
+  bool shrunk = false;
+
+  if ((uint8_t *)block + block->size != allocator->heap_end)
+    goto function_output;
+
+  cur_brk = (uint8_t *)sbrk(0);
+
+  if (cur_brk != allocator->heap_end || allocator->last_brk_start == NULL
+      || allocator->last_brk_end != allocator->heap_end)
+    goto function_output;
+
+  lease = (size_t)(allocator->last_brk_end - allocator->last_brk_start);
+  if (lease == 0u || block->size < lease)
+    goto function_output;
+
+  if (MEM_removeFreeBlock(allocator, block) != EXIT_SUCCESS)
+    goto function_output;
+
+  prev = block->prev;
+  size = block->size;
+
+  LOG_INFO("Conservative shrink: returning last lease of %zu bytes.\n",
+           lease);
+
+  old = MEM_sbrk(-(intptr_t)lease);
+  if ((intptr_t)old < 0)
+  {
+    (void)MEM_insertFreeBlock(allocator, block);
+    LOG_WARNING("sbrk(-%zu) failed; skipping shrink. errno=%d\n",
+                lease,
+                ENOMEM);
+    goto function_output;
+  }
+
+  allocator->heap_end       = allocator->heap_end - lease;
+  allocator->last_brk_start = (uint8_t *)NULL;
+  allocator->last_brk_end   = (uint8_t *)NULL;
+  allocator->last_allocated
+    = (block_header_t *)(uintptr_t)allocator->heap_start;
+
+  if (size > lease)
+  {
+    block->size = size - lease;
+
+    canary_addr  = (uintptr_t)block + block->size - sizeof(uintptr_t);
+    data_canary  = (uintptr_t *)canary_addr;
+    *data_canary = CANARY_VALUE;
+
+    block->fl_next = (block_header_t *)NULL;
+    block->fl_prev = (block_header_t *)NULL;
+
+    (void)MEM_insertFreeBlock(allocator, block);
+  }
+  else
+  {
+    if (prev)
+      prev->next = (block_header_t *)NULL;
+
+    if (allocator->arenas[0].top_chunk == block)
+      allocator->arenas[0].top_chunk = prev;
+  }
+
+  LOG_INFO("Heap shrunk by %zu bytes. New heap_end=%p.\n",
+           lease,
+           (void *)allocator->heap_end);
+
+  shrunk = true;
+
+function_output:
+  return shrunk;
+}
+
+/** ============================================================================
+ *  @brief  Resolves a handle to its slot. Caller holds gc_lock.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  handle    Handle returned by MEM_hAlloc().
+ *
+ *  @return Slot of @p handle, or NULL if @p handle is not allocated.
+ * ========================================================================== */
+static mem_handle_slot_t *MEM_handleSlot(mem_allocator_t *const allocator,
+                                         const mem_handle_t     handle)
+{
+  mem_handle_slot_t *slot = (mem_handle_slot_t *)NULL;
+
+  if (handle <= 0 || (size_t)handle > allocator->handles.len)
+    goto function_output;
+
+  if (allocator->handles.slots[handle - 1].ptr == NULL)
+    goto function_output;
+
+  slot = &allocator->handles.slots[handle - 1];
+
+function_output:
+  return slot;
+}
+
+/** ============================================================================
+ *  @brief  Makes room for one more slot in the handle table.
+ *
+ *  The table lives in its own mapping, created with mmap() and grown with
+ *  mremap() to twice its size. Caller holds gc_lock.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: A slot past @b len is available.
+ *  @retval -ENOSPC:      INT32_MAX handles are in use.
+ *  @retval -ENOMEM:      The table could not be grown.
+ * ========================================================================== */
+static int MEM_handleGrow(mem_allocator_t *const allocator)
+{
+  int ret = EXIT_SUCCESS;
+
+  mem_handles_t *handles = (mem_handles_t *)NULL;
+
+  void *slots = (void *)NULL;
+
+  size_t cap  = 0u;
+  size_t page = 0u;
+
+  handles = &allocator->handles;
+
+  if (handles->len < handles->cap)
+    goto function_output;
+
+  if (handles->len >= (size_t)INT32_MAX)
+  {
+    ret = -ENOSPC;
+    LOG_ERROR("Handle table full (%zu handles). "
+              "Error code: %d.\n",
+              handles->len,
+              ret);
+    goto function_output;
+  }
+
+  page = (size_t)sysconf(_SC_PAGESIZE);
+  cap  = (handles->cap + 1u) * 2u * sizeof(mem_handle_slot_t);
+  cap  = (cap + page - 1u) & ~(page - 1u);
+
+  if (handles->slots == NULL)
+    slots = mmap(NULL,
+                 cap,
+                 PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS,
+                 -1,
+                 0);
+  else
+    slots = mremap(handles->slots,
+                   handles->cap * sizeof(mem_handle_slot_t),
+                   cap,
+                   MREMAP_MAYMOVE);
+
+  if (slots == MAP_FAILED)
+  {
+    ret = -ENOMEM;
+    LOG_ERROR("Failed to grow handle table to %zu bytes. "
+              "Error code: %d.\n",
+              cap,
+              ret);
+    goto function_output;
+  }
+
+  handles->slots = (mem_handle_slot_t *)slots;
+  handles->cap   = cap / sizeof(mem_handle_slot_t);
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Allocates a movable block and its handle. Caller holds gc_lock.
+ *
+ *  The block is placed FIRST_FIT, with HANDLE_PREFIX extra bytes in front of
+ *  the payload holding the handle, and charged to MEM_TAG_DEFAULT.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  size      Number of bytes requested.
+ *  @param[in]  file      Source file name for debugging metadata.
+ *  @param[in]  line      Source line number for debugging metadata.
+ *
+ *  @return Handle (> 0) on success, negative error code on failure.
+ *
+ *  @retval -EINVAL:  @p size is zero or too large.
+ *  @retval -ENOSPC:  INT32_MAX handles are in use.
+ *  @retval -ENOMEM:  The table or the block could not be allocated.
+ * ========================================================================== */
+static mem_handle_t MEM_hAllocOp(mem_allocator_t *const allocator,
+                                 const size_t           size,
+                                 const char *const      file,
+                                 const int              line)
+{
+  mem_handle_t handle = 0;
+
+  mem_handles_t     *handles = (mem_handles_t *)NULL;
+  mem_handle_slot_t *slot    = (mem_handle_slot_t *)NULL;
+
+  void *ptr = (void *)NULL;
+
+  uint32_t index = 0u;
+
+  int ret = EXIT_SUCCESS;
+
+  if (UNLIKELY(size == 0u || size > SIZE_MAX - HANDLE_PREFIX))
+  {
+    handle = -EINVAL;
+    LOG_ERROR("Invalid arguments: size=%zu. "
+              "Error code: %d.\n",
+              size,
+              handle);
+    goto function_output;
+  }
+
+  handles = &allocator->handles;
+
+  if (handles->free_head != 0u)
+  {
+    index = handles->free_head - 1u;
+  }
+  else
+  {
+    ret = MEM_handleGrow(allocator);
+    if (ret != EXIT_SUCCESS)
+    {
+      handle = (mem_handle_t)ret;
+      goto function_output;
+    }
+
+    index = (uint32_t)handles->len;
+  }
+
+  ptr = MEM_allocOp(allocator,
+                    size + HANDLE_PREFIX,
+                    file,
+                    line,
+                    FIRST_FIT,
+                    MEM_TAG_DEFAULT);
+  if (ptr == NULL || (intptr_t)ptr < 0)
+  {
+    handle = (ptr == NULL) ? -ENOMEM : (mem_handle_t)(intptr_t)ptr;
+    goto function_output;
+  }
+
+  slot = &handles->slots[index];
+
+  if (index == handles->len)
+    handles->len++;
+  else
+    handles->free_head = slot->next_free;
+
+  *(uintptr_t *)ptr = (uintptr_t)index + 1u;
+
+  slot->ptr       = ptr;
+  slot->locks     = 0u;
+  slot->next_free = 0u;
+
+  handle = (mem_handle_t)(index + 1u);
+
+  LOG_DEBUG("Handle %d allocated: %p (%zu bytes).\n",
+            handle,
+            (void *)((uint8_t *)ptr + HANDLE_PREFIX),
+            size);
+
+function_output:
+  return handle;
+}
+
+/** ============================================================================
+ *  @brief  Releases a movable block and its handle. Caller holds gc_lock.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  handle    Handle returned by MEM_hAlloc().
+ *  @param[in]  file      Source file name for debugging metadata.
+ *  @param[in]  line      Source line number for debugging metadata.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Block and handle released.
+ *  @retval -EINVAL:      @p handle is not allocated.
+ *  @retval -EBUSY:       @p handle is locked.
+ *  @retval ret<0:        Error returned by MEM_freeOp().
+ * ========================================================================== */
+static int MEM_hFreeOp(mem_allocator_t *const allocator,
+                       const mem_handle_t     handle,
+                       const char *const      file,
+                       const int              line)
+{
+  int ret = EXIT_SUCCESS;
+
+  mem_handle_slot_t *slot = (mem_handle_slot_t *)NULL;
+
+  slot = MEM_handleSlot(allocator, handle);
+  if (slot == NULL)
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid handle: %d. Error code: %d.\n", handle, ret);
+    goto function_output;
+  }
+
+  if (slot->locks != 0u)
+  {
+    ret = -EBUSY;
+    LOG_ERROR("Handle %d freed while locked (%u pins). "
+              "Error code: %d.\n",
+              handle,
+              (unsigned)slot->locks,
+              ret);
+    goto function_output;
+  }
+
+  ret = MEM_freeOp(allocator, slot->ptr, file, line);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  slot->ptr       = (void *)NULL;
+  slot->next_free = allocator->handles.free_head;
+
+  allocator->handles.free_head = (uint32_t)handle;
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Finds the slot of a heap block the compactor may move.
+ *
+ *  The handle word in front of the payload is only trusted when the slot
+ *  it names points back at the block, so ordinary blocks are never taken
+ *  for movable ones.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  block     Candidate heap block header.
+ *
+ *  @return Slot owning @p block if it is allocated through MEM_hAlloc()
+ *          and unlocked, NULL otherwise.
+ * ========================================================================== */
+static mem_handle_slot_t *MEM_handleOwner(mem_allocator_t *const allocator,
+                                          block_header_t *const  block)
+{
+  mem_handle_slot_t *slot = (mem_handle_slot_t *)NULL;
+
+  uint8_t *payload  = (uint8_t *)NULL;
+  uint8_t *heap_end = (uint8_t *)NULL;
+
+  uintptr_t word = 0u;
+
+  heap_end = allocator->heap_end;
+
+  if ((uint8_t *)block + MIN_BLOCK_SIZE > heap_end
+      || block->magic != MAGIC_NUMBER || block->canary != CANARY_VALUE
+      || block->free || block->size < MIN_BLOCK_SIZE + HANDLE_PREFIX
+      || block->size > (size_t)(heap_end - (uint8_t *)block))
+    goto function_output;
+
+  payload = (uint8_t *)block + sizeof(block_header_t);
+  word    = *(uintptr_t *)payload;
+
+  if (word == 0u || word > allocator->handles.len)
+    goto function_output;
+
+  slot = &allocator->handles.slots[word - 1u];
+  if (slot->ptr != (void *)payload || slot->locks != 0u)
+    slot = (mem_handle_slot_t *)NULL;
+
+function_output:
+  return slot;
+}
+
+/** ============================================================================
+ *  @brief  Swaps a free block with the movable block that follows it.
+ *
+ *  Copies @p block, header and canary included, down to @p hole, then
+ *  writes the free block back behind it, merged with a free successor.
+ *  The copy runs forward and the destination is lower, so the overlap is
+ *  harmless. Caller holds gc_lock.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  hole      Free block, on its free list.
+ *  @param[in]  block     Unlocked movable block right after @p hole.
+ *  @param[in]  slot      Slot owning @p block.
+ *
+ *  @return The free block now following the moved one, or NULL if @p hole
+ *          could not be taken off its free list.
+ * ========================================================================== */
+static block_header_t *MEM_compactSlide(mem_allocator_t *const   allocator,
+                                        block_header_t *const    hole,
+                                        block_header_t *const    block,
+                                        mem_handle_slot_t *const slot)
+{
+  block_header_t *gap  = (block_header_t *)NULL;
+  block_header_t *prev = (block_header_t *)NULL;
+  block_header_t *next = (block_header_t *)NULL;
+
+  uintptr_t *data_canary = (uintptr_t *)NULL;
+  uintptr_t  canary_addr = 0u;
+
+  size_t hole_size = 0u;
+  size_t size      = 0u;
+
+  if (MEM_removeFreeBlock(allocator, hole) != EXIT_SUCCESS)
+    goto function_output;
+
+  hole_size = hole->size;
+  size      = block->size;
+  prev      = hole->prev;
+  next      = block->next;
+
+  (void)MEM_memcpy(hole, block, size);
+
+  hole->prev = prev;
+  if (prev)
+    prev->next = hole;
+
+  gap = (block_header_t *)((uint8_t *)hole + size);
+
+  gap->magic   = MAGIC_NUMBER;
+  gap->size    = hole_size;
+  gap->free    = 1u;
+  gap->marked  = 0u;
+  gap->tag     = MEM_TAG_DEFAULT;
+  gap->layout  = MEM_LAYOUT_CONSERVATIVE;
+  gap->file    = __FILE__;
+  gap->line    = (uint64_t)__LINE__;
+  gap->canary  = CANARY_VALUE;
+  gap->prev    = hole;
+  gap->next    = next;
+  gap->fl_next = (block_header_t *)NULL;
+  gap->fl_prev = (block_header_t *)NULL;
+
+  hole->next = gap;
+  if (next)
+    next->prev = gap;
+
+  canary_addr  = (uintptr_t)gap + gap->size - sizeof(uintptr_t);
+  data_canary  = (uintptr_t *)canary_addr;
+  *data_canary = CANARY_VALUE;
+
+  slot->ptr = (uint8_t *)hole + sizeof(block_header_t);
+
+#ifdef RUNNING_ON_VALGRIND
+  VALGRIND_MEMPOOL_CHANGE(allocator,
+                          (uint8_t *)block + sizeof(block_header_t),
+                          slot->ptr,
+                          size - sizeof(block_header_t) - sizeof(uintptr_t));
+#endif
+
+  if (allocator->arenas[0].top_chunk == block)
+    allocator->arenas[0].top_chunk = gap;
+
+  (void)MEM_mergeBlocks(allocator, gap);
+
+  LOG_DEBUG("Compaction: block %p moved to %p (%zu bytes).\n",
+            (void *)block,
+            (void *)hole,
+            size);
+
+function_output:
+  return gap;
+}
+
+/** ============================================================================
+ *  @brief  Slides movable blocks toward the heap start, then trims.
+ *
+ *  Walks the heap in address order. Each free block followed by an
+ *  unlocked MEM_hAlloc() block that links back to it trades places with
+ *  it, so free space bubbles up until a locked or ordinary block stops it
+ *  and coalesces on the way. Words that are not block headers, such as
+ *  memory another sbrk() user took between two heap growths, are skipped
+ *  one alignment unit at a time rather than ending the walk. MEM_trimOp()
+ *  then returns the top of the heap. While a collection is in progress,
+ *  blocks are not moved. Moving a block invalidates the generational
+ *  marks, so the next collection is full.
+ *  Caller holds gc_lock.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Number of bytes released (>= 0) on success,
+ *          negative error code on failure.
+ *
+ *  @retval -EINVAL:      @p allocator is NULL.
+ * ========================================================================== */
+static intptr_t MEM_compactOp(mem_allocator_t *const allocator)
+{
+  intptr_t released = 0;
+
+  block_header_t    *block = (block_header_t *)NULL;
+  block_header_t    *next  = (block_header_t *)NULL;
+  mem_handle_slot_t *slot  = (mem_handle_slot_t *)NULL;
+
+  uint8_t *heap_end = (uint8_t *)NULL;
+
+  size_t moved = 0u;
+  size_t bytes = 0u;
+
+  if (UNLIKELY(allocator == NULL))
+  {
+    released = -EINVAL;
+    LOG_ERROR("Invalid parameters: allocator=%p. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              (int)released);
+    goto function_output;
+  }
+
+  if (allocator->handles.len == 0u)
+    goto trim_heap;
+
+#if defined(GARBAGE_COLLECTOR)
+  if (allocator->gc_incr.phase != GC_INCR_IDLE || allocator->gc_snap.active)
+  {
+    LOG_DEBUG("Compaction skipped: a collection is in progress.\n");
+    goto trim_heap;
+  }
+#endif
+
+  heap_end = allocator->heap_end;
+  block
+    = (block_header_t *)(allocator->heap_start + allocator->metadata_size);
+
+  while ((uint8_t *)block + MIN_BLOCK_SIZE <= heap_end)
+  {
+    if (block->magic != MAGIC_NUMBER || block->size < MIN_BLOCK_SIZE
+        || block->size > (size_t)(heap_end - (uint8_t *)block)
+        || (block->size & (ARCH_ALIGNMENT - 1u)) != 0u)
+    {
+      block = (block_header_t *)((uint8_t *)block + ARCH_ALIGNMENT);
+      continue;
+    }
+
+    next = (block_header_t *)((uint8_t *)block + block->size);
+    slot = block->free ? MEM_handleOwner(allocator, next)
+                       : (mem_handle_slot_t *)NULL;
+    if (slot != NULL && next->prev != block)
+      slot = (mem_handle_slot_t *)NULL;
+
+    if (slot == NULL)
+    {
+      block = next;
+      continue;
+    }
+
+    bytes += next->size;
+    ++moved;
+
+#if defined(GARBAGE_COLLECTOR)
+    allocator->gc_gen.valid = false;
+#endif
+
+    block = MEM_compactSlide(allocator, block, next, slot);
+    if (block == NULL)
+      break;
+  }
+
+  if (moved != 0u)
+  {
+    allocator->handles.moved += moved;
+    allocator->last_allocated
+      = (block_header_t *)(uintptr_t)allocator->heap_start;
+
+    LOG_INFO("Compaction: %zu blocks moved (%zu bytes).\n", moved, bytes);
+  }
+
+trim_heap:
+  released = MEM_trimOp(allocator);
+
+function_output:
+  return released;
+}
+
+/** ============================================================================
+ *  @brief  Bytes of a free heap run that MEM_trimOp() hands back.
+ *
+ *  A run ending at the heap top and spanning a page is returned whole
+ *  through sbrk(); any other run only gives up the pages lying between its
+ *  header and its canary.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  start     First byte of the run (a block header).
+ *  @param[in]  end       One past the last byte of the run.
+ *
+ *  @return Releasable bytes.
+ * ========================================================================== */
+static size_t MEM_releasable(mem_allocator_t *const allocator,
+                             const uint8_t *const   start,
+                             const uint8_t *const   end)
+{
+  size_t bytes = 0u;
+  size_t page  = 0u;
+
+  uintptr_t first = 0u;
+  uintptr_t last  = 0u;
+
+  page = (size_t)sysconf(_SC_PAGESIZE);
+
+  if (end == allocator->heap_end && (size_t)(end - start) >= page)
+  {
+    bytes = (size_t)(end - start);
+    goto function_output;
+  }
+
+  first = (uintptr_t)start + sizeof(block_header_t);
+  first = (first + page - 1u) & ~(uintptr_t)(page - 1u);
+  last  = (uintptr_t)end - sizeof(uintptr_t);
+  last  = last & ~(uintptr_t)(page - 1u);
+
+  if (last > first)
+    bytes = (size_t)(last - first);
+
+function_output:
+  return bytes;
+}
+
+/** ============================================================================
+ *  @brief  Bytes that freeing a heap block would let MEM_trimOp() release.
+ *
+ *  Joins @p block with the free neighbours MEM_mergeBlocks() would absorb
+ *  and compares what the merged run gives back with what the neighbours
+ *  give back on their own. A block alone in otherwise free pages gains
+ *  those pages; one packed among live blocks gains nothing.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  block     Allocated heap block.
+ *  @param[out] lo        Start of the merged run.
+ *
+ *  @return Releasable bytes gained.
+ * ========================================================================== */
+static size_t MEM_relocateGain(mem_allocator_t *const allocator,
+                               block_header_t *const  block,
+                               uint8_t              **lo)
+{
+  block_header_t *prev = (block_header_t *)NULL;
+  block_header_t *next = (block_header_t *)NULL;
+
+  uint8_t *start    = (uint8_t *)NULL;
+  uint8_t *end      = (uint8_t *)NULL;
+  uint8_t *heap_end = (uint8_t *)NULL;
+
+  size_t before = 0u;
+  size_t after  = 0u;
+
+  heap_end = allocator->heap_end;
+  start    = (uint8_t *)block;
+  end      = (uint8_t *)block + block->size;
+  prev     = block->prev;
+
+  if (prev != NULL && prev->free && prev->magic == MAGIC_NUMBER
+      && (uint8_t *)prev + prev->size == start)
+  {
+    before += MEM_releasable(allocator, (uint8_t *)prev, start);
+    start   = (uint8_t *)prev;
+  }
+
+  if (end + MIN_BLOCK_SIZE <= heap_end)
+  {
+    next = (block_header_t *)end;
+    if (next->free && next->magic == MAGIC_NUMBER
+        && next->size <= (size_t)(heap_end - end))
+    {
+      before += MEM_releasable(allocator, end, end + next->size);
+      end    += next->size;
+    }
+  }
+
+  after = MEM_releasable(allocator, start, end);
+  *lo   = start;
+
+  return (after > before) ? after - before : 0u;
+}
+
+/** ============================================================================
+ *  @brief  Picks the free block a relocated heap block should move to.
+ *
+ *  Considers the free blocks that fit @p block and lie below @p lo, so
+ *  relocation moves data down, away from the run being emptied. Placing
+ *  the block costs the releasable bytes the candidate loses
+ *  (MEM_releasable()); the cheapest candidate wins, and one that costs
+ *  nothing, because it sits in pages already holding live data, ends the
+ *  search.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  block     Allocated heap block to relocate.
+ *  @param[in]  lo        Start of the run freeing @p block would create.
+ *  @param[in]  gain      Bytes freeing @p block would release.
+ *
+ *  @return Free block whose cost is below @p gain, or NULL.
+ * ========================================================================== */
+static block_header_t *MEM_relocateTarget(mem_allocator_t *const allocator,
+                                          block_header_t *const  block,
+                                          const uint8_t *const   lo,
+                                          const size_t           gain)
+{
+  block_header_t *best    = (block_header_t *)NULL;
+  block_header_t *current = (block_header_t *)NULL;
+
+  uint8_t *start = (uint8_t *)NULL;
+  uint8_t *end   = (uint8_t *)NULL;
+
+  size_t cost      = 0u;
+  size_t best_cost = 0u;
+  size_t iterator  = 0u;
+
+  int start_class = 0;
+
+  start_class = MEM_getSizeClass(allocator, block->size);
+  if (start_class < 0)
+    goto function_output;
+
+  best_cost = gain;
+
+  for (iterator = (size_t)start_class;
+       iterator < allocator->num_size_classes && best_cost != 0u;
+       ++iterator)
+  {
+    for (current = allocator->free_lists[iterator];
+         current != NULL && best_cost != 0u;
+         current = current->fl_next)
+    {
+      if ((uint8_t *)current >= lo
+          || !MEM_blockFits(allocator, current, block->size))
+        continue;
+
+      start = (uint8_t *)current;
+      end   = start + current->size;
+      cost  = MEM_releasable(allocator, start, end);
+
+      if (current->size >= block->size + MIN_BLOCK_SIZE)
+        cost -= MEM_releasable(allocator, start + block->size, end);
+
+      if (cost < best_cost)
+      {
+        best      = current;
+        best_cost = cost;
+      }
+    }
+  }
+
+function_output:
+  return best;
+}
+
+/** ============================================================================
+ *  @brief  Resolves a user pointer to a heap block worth relocating.
+ *
+ *  mmap blocks are released on their own and are never reported.
+ *  Caller holds gc_lock.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  ptr       Pointer returned by an allocation function.
+ *  @param[out] target    Free block to move the payload to.
+ *
+ *  @return Header of the block behind @p ptr when it sits in a sparsely
+ *          used part of the heap and @p target was found, NULL otherwise.
+ * ========================================================================== */
+static block_header_t *MEM_relocateFind(mem_allocator_t *const allocator,
+                                        const void *const      ptr,
+                                        block_header_t       **target)
+{
+  block_header_t *block = (block_header_t *)NULL;
+
+  uint8_t *user_start = (uint8_t *)NULL;
+  uint8_t *lo         = (uint8_t *)NULL;
+
+  size_t gain = 0u;
+
+  *target = (block_header_t *)NULL;
+
+  user_start = allocator->heap_start + allocator->metadata_size;
+  block      = (block_header_t *)((uintptr_t)ptr - sizeof(block_header_t));
+
+  if ((uint8_t *)block < user_start
+      || (uint8_t *)block + MIN_BLOCK_SIZE > allocator->heap_end
+      || MEM_validateBlock(allocator, block) != EXIT_SUCCESS || block->free)
+  {
+    block = (block_header_t *)NULL;
+    goto function_output;
+  }
+
+  gain = MEM_relocateGain(allocator, block, &lo);
+  if (gain != 0u)
+    *target = MEM_relocateTarget(allocator, block, lo, gain);
+
+  if (*target == NULL)
+    block = (block_header_t *)NULL;
+
+function_output:
+  return block;
+}
+
+/** ============================================================================
+ *  @brief  Moves a heap block out of a sparsely used region.
+ *
+ *  When MEM_relocateFind() reports the block, allocates its replacement in
+ *  the chosen free block, keeping tag and layout, copies the payload and
+ *  frees the original. Otherwise @p ptr is returned unchanged. Caller holds
+ *  gc_lock.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  ptr       Pointer returned by an allocation function.
+ *  @param[in]  file      Source file name for debugging metadata.
+ *  @param[in]  line      Source line number for debugging metadata.
+ *
+ *  @return New pointer when the block moved, @p ptr when it stays, or an
+ *          error-encoded pointer (via PTR_ERR()) on failure.
+ *
+ *  @retval -EINVAL:  @p ptr is NULL.
+ *  @retval ret<0:    Error returned by MEM_splitBlock() or MEM_freeOp().
+ * ========================================================================== */
+static void *MEM_relocateOp(mem_allocator_t *const allocator,
+                            void *const            ptr,
+                            const char *const      file,
+                            const int              line)
+{
+  void *new_ptr = (void *)NULL;
+
+  block_header_t *block  = (block_header_t *)NULL;
+  block_header_t *target = (block_header_t *)NULL;
+
+  size_t payload = 0u;
+
+  int ret = EXIT_SUCCESS;
+
+  if (UNLIKELY(ptr == NULL))
+  {
+    new_ptr = PTR_ERR(-EINVAL);
+    LOG_ERROR("Invalid parameters: ptr=%p. Error code: %d.\n",
+              ptr,
+              (int)(intptr_t)new_ptr);
+    goto function_output;
+  }
+
+  block = MEM_relocateFind(allocator, ptr, &target);
+  if (block == NULL)
+  {
+    new_ptr = ptr;
+    goto function_output;
+  }
+
+  payload = block->size - sizeof(block_header_t) - sizeof(uintptr_t);
+
+  ret = MEM_splitBlock(allocator, target, payload);
+  if (ret != EXIT_SUCCESS)
+  {
+    new_ptr = PTR_ERR(ret);
+    goto function_output;
+  }
+
+  target->file   = file;
+  target->line   = (uint64_t)line;
+  target->tag    = block->tag;
+  target->layout = block->layout;
+
+  (void)MEM_tagAccount(allocator, target, true);
+
+#if defined(GARBAGE_COLLECTOR)
+  MEM_gcTrack(allocator, target, true);
+#endif
+
+  new_ptr = (uint8_t *)target + sizeof(block_header_t);
+
+#ifdef RUNNING_ON_VALGRIND
+  VALGRIND_MEMPOOL_ALLOC(allocator, new_ptr, payload);
+#endif
+
+  (void)MEM_memcpy(new_ptr, ptr, payload);
+
+  ret = MEM_freeOp(allocator, ptr, file, line);
+  if (ret != EXIT_SUCCESS)
+  {
+    new_ptr = PTR_ERR(ret);
+    goto function_output;
+  }
+
+  LOG_DEBUG("Relocated: %p -> %p (%zu bytes).\n", ptr, new_ptr, payload);
+
+function_output:
+  return new_ptr;
+}
+
+/** ============================================================================
+ *      P R I V A T E  G A R B A G E  C O L L E C T O R  F U N C T I O N S
+ * ========================================================================== */
+
+#if defined(GARBAGE_COLLECTOR)
+
+/** ============================================================================
+ *  @brief  Maps a candidate pointer to the live block it references.
+ *
+ *  Quiet counterpart of MEM_validateBlock() used while marking: arbitrary
+ *  words are tested without logging. A word may point anywhere inside a
+ *  payload. Heap words are resolved through the block-start bitmap
+ *  (MEM_gcFindHeapBlock()); other words are binary-searched in the sorted
+ *  mmap index.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  addr      Candidate pointer value.
+ *
+ *  @return Header of the allocated block referenced by @p addr, or NULL.
+ * ========================================================================== */
+static block_header_t *MEM_gcFindBlock(mem_allocator_t *const allocator,
+                                       const uintptr_t        addr)
+{
+  gc_map_index_t *index = (gc_map_index_t *)NULL;
+  gc_map_range_t *range = (gc_map_range_t *)NULL;
+
+  size_t low  = 0u;
+  size_t high = 0u;
+  size_t mid  = 0u;
+
+  if (addr >= allocator->start_bits.base + sizeof(block_header_t)
+      && addr < (uintptr_t)allocator->heap_end
+      && addr < allocator->start_bits.base
+                  + allocator->start_bits.used_words * GC_BITS_PER_WORD
+                      * GC_GRANULE)
+    return MEM_gcFindHeapBlock(allocator, addr);
+
+  index = &allocator->map_index;
+  high  = index->len;
+
+  while (low < high)
+  {
+    mid   = low + (high - low) / 2u;
+    range = &index->ranges[mid];
+
+    if (addr < range->start)
+      high = mid;
+    else if (addr >= range->end)
+      low = mid + 1u;
+    else
+      return range->block;
+  }
+
+  return (block_header_t *)NULL;
+}
+
+/** ============================================================================
+ *  @brief  Pushes a freshly marked block on the mark stack.
+ *
+ *  The stack lives in its own mapping and doubles via mremap() up to
+ *  GC_MARK_STACK_MAX entries. When it cannot grow, the block is dropped and
+ *  the overflow flag is raised; MEM_gcMark() then rescans marked blocks.
+ *  The stack's spin lock is held, since idle workers steal from it.
+ *
+ *  @param[in]  stack Mark stack of the calling worker.
+ *  @param[in]  block Block to scan later.
+ * ========================================================================== */
+static void MEM_gcPush(gc_mark_stack_t *const stack,
+                       block_header_t *const  block)
+{
+  void *items = (void *)NULL;
+
+  size_t cap = 0u;
+
+  MEM_gcStackLock(stack);
+
+  if (UNLIKELY(stack->len == stack->cap))
+  {
+    cap = (stack->cap == 0u) ? GC_MARK_STACK_INIT : stack->cap * 2u;
+
+    if (cap > GC_MARK_STACK_MAX)
+      items = MAP_FAILED;
+    else if (stack->items == NULL)
+      items = mmap(NULL,
+                   cap * sizeof(block_header_t *),
+                   PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS,
+                   -1,
+                   0);
+    else
+      items = mremap(stack->items,
+                     stack->cap * sizeof(block_header_t *),
+                     cap * sizeof(block_header_t *),
+                     MREMAP_MAYMOVE);
+
+    if (items == MAP_FAILED)
+    {
+      stack->overflow = true;
+      goto stack_unlock;
+    }
+
+    stack->items = (block_header_t **)items;
+    stack->cap   = cap;
+  }
+
+  stack->items[stack->len++] = block;
+
+stack_unlock:
+  MEM_gcStackUnlock(stack);
+}
+
+/** ============================================================================
+ *  @brief  Conservatively scans a memory range for block references.
+ *
+ *  Every aligned word in [@p start, @p end) that references an unmarked
+ *  live block marks it and pushes it on @p stack, unless the block has the
+ *  MEM_LAYOUT_ATOMIC layout: its payload is never scanned. Words that
+ *  reference no block are handed to MEM_gcBlacklistAdd().
+ *
+ *  Words are loaded GC_SCAN_LANES at a time and range-checked against
+ *  MEM_gcScanWindow() with vector compares; only the words inside a window
+ *  reach MEM_gcScanWord(). The remaining tail is checked one word at a time.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  stack     Mark stack of the calling worker.
+ *  @param[in]  start     First byte of the range.
+ *  @param[in]  end       One past the last byte of the range.
+ * ========================================================================== */
+static void MEM_gcScanRange(mem_allocator_t *const allocator,
+                            gc_mark_stack_t *const stack,
+                            uintptr_t              start,
+                            const uintptr_t        end)
+{
+  gc_scan_window_t window = { 0 };
+
+  gc_word_vec_t words = { 0 };
+  gc_word_vec_t hits  = { 0 };
+
+  uintptr_t word = 0u;
+
+  size_t lane = 0u;
+
+  start = (start + sizeof(uintptr_t) - 1u)
+        & ~(uintptr_t)(sizeof(uintptr_t) - 1u);
+
+  if (end <= start)
+    return;
+
+  stack->scanned += end - start;
+
+  MEM_gcScanWindow(allocator, &window);
+
+  for (; start + sizeof(gc_word_vec_t) <= end; start += sizeof(gc_word_vec_t))
+  {
+    words = *(const volatile gc_word_vec_t *)start;
+    hits  = (gc_word_vec_t)((words - window.heap_lo) < window.heap_len)
+          | (gc_word_vec_t)((words - window.map_lo) < window.map_len);
+
+    for (lane = 0u; lane < GC_SCAN_LANES; ++lane)
+    {
+      if (hits[lane] != 0u)
+        MEM_gcScanWord(allocator, stack, words[lane]);
+    }
+  }
+
+  for (; start + sizeof(uintptr_t) <= end; start += sizeof(uintptr_t))
+  {
+    word = *(const volatile uintptr_t *)start;
+
+    if (word - window.heap_lo < window.heap_len
+        || word - window.map_lo < window.map_len)
+      MEM_gcScanWord(allocator, stack, word);
+  }
+}
+
+/** ============================================================================
+ *  @brief  Computes the address windows of MEM_gcScanRange().
+ *
+ *  The heap window spans the block-start bitmap base up to the heap end or
+ *  the blacklist table end, whichever is higher; the mmap window spans the
+ *  sorted mmap index. Every word MEM_gcFindBlock() or MEM_gcBlacklistAdd()
+ *  can act on falls in one of them.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[out] window    Windows to fill.
+ * ========================================================================== */
+static void MEM_gcScanWindow(mem_allocator_t *const  allocator,
+                             gc_scan_window_t *const window)
+{
+  gc_bitmap_t    *bits  = (gc_bitmap_t *)NULL;
+  gc_map_index_t *index = (gc_map_index_t *)NULL;
+
+  uintptr_t lo = 0u;
+  uintptr_t hi = 0u;
+
+  bits  = &allocator->gc_blacklist.pages[allocator->gc_blacklist.current];
+  index = &allocator->map_index;
+
+  lo = allocator->start_bits.base;
+  hi = (uintptr_t)allocator->heap_end;
+
+  if (bits->used_words != 0u)
+  {
+    if (bits->base < lo)
+      lo = bits->base;
+
+    if (bits->base + bits->used_words * GC_BITS_PER_WORD * GC_BLACKLIST_PAGE
+        > hi)
+      hi = bits->base
+         + bits->used_words * GC_BITS_PER_WORD * GC_BLACKLIST_PAGE;
+  }
+
+  window->heap_lo  = lo;
+  window->heap_len = (hi > lo) ? hi - lo : 0u;
+
+  window->map_lo  = 0u;
+  window->map_len = 0u;
+
+  if (index->len != 0u)
+  {
+    window->map_lo  = index->ranges[0].start;
+    window->map_len = index->ranges[index->len - 1u].end - window->map_lo;
+  }
+}
+
+/** ============================================================================
+ *  @brief  Marks the block a candidate word references.
+ *
+ *  Marks the referenced live block and pushes it on @p stack, unless it has
+ *  the MEM_LAYOUT_ATOMIC layout. A word that references no block is handed
+ *  to MEM_gcBlacklistAdd().
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  stack     Mark stack of the calling worker.
+ *  @param[in]  word      Scanned word inside a window of MEM_gcScanWindow().
+ * ========================================================================== */
+static void MEM_gcScanWord(mem_allocator_t *const allocator,
+                           gc_mark_stack_t *const stack,
+                           const uintptr_t        word)
+{
+  block_header_t *block = (block_header_t *)NULL;
+
+  block = MEM_gcFindBlock(allocator, word);
+  if (block == NULL)
+  {
+    MEM_gcBlacklistAdd(allocator, word);
+    return;
+  }
+
+  if (!MEM_gcSetMark(allocator, block))
+    return;
+
+  ++stack->marked;
+
+  if (block->layout == MEM_LAYOUT_ATOMIC)
+    return;
+
+  MEM_gcPush(stack, block);
+}
+
+/** ============================================================================
+ *  @brief  Scans the part [@p first, @p last) of a block's payload.
+ *
+ *  Conservative blocks are scanned word by word. Blocks with a registered
+ *  layout only have their pointer words scanned: the layout describes one
+ *  element and repeats over the payload, so arrays of a type share it.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  stack     Mark stack of the calling worker.
+ *  @param[in]  block     Marked block owning the range.
+ *  @param[in]  first     First payload byte to scan.
+ *  @param[in]  last      One past the last payload byte to scan.
+ * ========================================================================== */
+static void MEM_gcScanPayload(mem_allocator_t *const allocator,
+                              gc_mark_stack_t *const stack,
+                              block_header_t *const  block,
+                              const uintptr_t        first,
+                              const uintptr_t        last)
+{
+  const mem_layout_t *layout = (const mem_layout_t *)NULL;
+
+  uintptr_t payload = 0u;
+  uintptr_t element = 0u;
+  uintptr_t addr    = 0u;
+
+  uint64_t bits = 0u;
+
+  size_t stride = 0u;
+  size_t index  = 0u;
+  size_t bit    = 0u;
+
+  if (block->layout == MEM_LAYOUT_CONSERVATIVE)
+  {
+    MEM_gcScanRange(allocator, stack, first, last);
+    return;
+  }
+
+  if (block->layout == MEM_LAYOUT_ATOMIC)
+    return;
+
+  layout  = &allocator->layouts[block->layout];
+  stride  = layout->words * sizeof(uintptr_t);
+  payload = (uintptr_t)block + sizeof(block_header_t);
+
+  for (element = payload + (first - payload) / stride * stride;
+       element < last;
+       element += stride)
+  {
+    for (index = 0u; index * GC_BITS_PER_WORD < layout->words; ++index)
+    {
+      bits = layout->bits[index];
+      while (bits != 0u)
+      {
+        bit   = (size_t)(unsigned)__builtin_ctzll(bits);
+        bits &= bits - 1u;
+
+        addr = element + (index * GC_BITS_PER_WORD + bit) * sizeof(uintptr_t);
+        if (addr < first || addr + sizeof(uintptr_t) > last)
+          continue;
+
+        MEM_gcScanRange(allocator, stack, addr, addr + sizeof(uintptr_t));
+      }
+    }
+  }
+}
+
+/** ============================================================================
+ *  @brief  Scans the payload of marked blocks until the mark stack is empty.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  stack     Mark stack of the calling worker.
+ * ========================================================================== */
+static void MEM_gcDrain(mem_allocator_t *const allocator,
+                        gc_mark_stack_t *const stack)
+{
+  block_header_t *block = (block_header_t *)NULL;
+
+  block = MEM_gcPop(stack);
+
+  while (block != NULL)
+  {
+    MEM_gcScanPayload(allocator,
+                      stack,
+                      block,
+                      (uintptr_t)block + sizeof(block_header_t),
+                      (uintptr_t)block + block->size - sizeof(uintptr_t));
+
+    block = MEM_gcPop(stack);
+  }
+}
+
+/** ============================================================================
+ *  @brief  Recovers from a mark stack overflow.
+ *
+ *  Rescans the payload of every marked heap and mmap block, draining after
+ *  each one, so that children dropped on overflow get marked. Heap blocks
+ *  are enumerated from the set bits of the mark bitmap.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+static void MEM_gcRescan(mem_allocator_t *const allocator)
+{
+  gc_bitmap_t     *bits  = (gc_bitmap_t *)NULL;
+  gc_mark_stack_t *stack = (gc_mark_stack_t *)NULL;
+
+  block_header_t *block = (block_header_t *)NULL;
+
+  mmap_t *map = (mmap_t *)NULL;
+
+  uint64_t word = 0u;
+
+  size_t index = 0u;
+  size_t bit   = 0u;
+
+  bits  = &allocator->mark_bits;
+  stack = &allocator->gc_pool.workers[0].stack;
+
+  for (index = 0u; index < bits->used_words; ++index)
+  {
+    word = bits->words[index];
+    while (word != 0u)
+    {
+      bit   = (size_t)(unsigned)__builtin_ctzll(word);
+      word &= word - 1u;
+
+      block = (block_header_t *)(bits->base
+                                 + (index * GC_BITS_PER_WORD + bit)
+                                     * GC_GRANULE);
+      MEM_gcScanPayload(allocator,
+                        stack,
+                        block,
+                        (uintptr_t)block + sizeof(block_header_t),
+                        (uintptr_t)block + block->size - sizeof(uintptr_t));
+      MEM_gcDrain(allocator, stack);
+    }
+  }
+
+  for (map = allocator->mmap_list; map; map = map->next)
+  {
+    block = (block_header_t *)map->addr;
+    if (!MEM_gcIsMarked(allocator, block) || block->free)
+      continue;
+
+    MEM_gcScanPayload(allocator,
+                      stack,
+                      block,
+                      (uintptr_t)map->addr + sizeof(block_header_t),
+                      (uintptr_t)map->addr + map->size - sizeof(uintptr_t));
+    MEM_gcDrain(allocator, stack);
+  }
+}
+
+/** ============================================================================
+ *  @brief  Acquires the spin lock of a mark stack.
+ *
+ *  @param[in]  stack Mark stack.
+ * ========================================================================== */
+static void MEM_gcStackLock(gc_mark_stack_t *const stack)
+{
+  while (atomic_exchange_explicit(&stack->busy, true, memory_order_acquire))
+  {
+    while (atomic_load_explicit(&stack->busy, memory_order_relaxed))
+      sched_yield( );
+  }
+}
+
+/** ============================================================================
+ *  @brief  Releases the spin lock of a mark stack.
+ *
+ *  @param[in]  stack Mark stack.
+ * ========================================================================== */
+static void MEM_gcStackUnlock(gc_mark_stack_t *const stack)
+{
+  atomic_store_explicit(&stack->busy, false, memory_order_release);
+}
+
+/** ============================================================================
+ *  @brief  Pops the most recently pushed block from a mark stack.
+ *
+ *  @param[in]  stack Mark stack.
+ *
+ *  @return Block to scan, or NULL when the stack is empty.
+ * ========================================================================== */
+static block_header_t *MEM_gcPop(gc_mark_stack_t *const stack)
+{
+  block_header_t *block = (block_header_t *)NULL;
+
+  MEM_gcStackLock(stack);
+
+  if (stack->len > 0u)
+    block = stack->items[--stack->len];
+
+  MEM_gcStackUnlock(stack);
+
+  return block;
+}
+
+/** ============================================================================
+ *  @brief  Moves pending blocks from another worker's mark stack.
+ *
+ *  Victims are tried round-robin starting after the thief. Half of the
+ *  first non-empty stack, at most GC_STEAL_BATCH entries, is taken from its
+ *  top and pushed on the thief's own stack.
+ *
+ *  @param[in]  pool  Worker pool.
+ *  @param[in]  thief Worker looking for work.
+ *
+ *  @return Number of entries stolen.
+ * ========================================================================== */
+static size_t MEM_gcSteal(gc_pool_t *const pool, gc_worker_t *const thief)
+{
+  gc_mark_stack_t *victim = (gc_mark_stack_t *)NULL;
+
+  block_header_t *batch[GC_STEAL_BATCH] = { NULL };
+
+  size_t count = 0u;
+  size_t index = 0u;
+
+  uint32_t offset = 0u;
+
+  for (offset = 1u; offset < pool->active && count == 0u; ++offset)
+  {
+    victim = &pool->workers[(thief->id + offset) % pool->active].stack;
+    if (__atomic_load_n(&victim->len, __ATOMIC_RELAXED) == 0u)
+      continue;
+
+    MEM_gcStackLock(victim);
+
+    count = (victim->len + 1u) / 2u;
+    if (count > GC_STEAL_BATCH)
+      count = GC_STEAL_BATCH;
+
+    victim->len -= count;
+    MEM_memcpy(batch,
+               &victim->items[victim->len],
+               count * sizeof(block_header_t *));
+
+    MEM_gcStackUnlock(victim);
+  }
+
+  for (index = 0u; index < count; ++index)
+    MEM_gcPush(&thief->stack, batch[index]);
+
+  return count;
+}
+
+/** ============================================================================
+ *  @brief  Parallel mark loop of one worker.
+ *
+ *  Drains the worker's own stack, then steals from the others. A worker
+ *  that finds no work counts itself idle and polls the other stacks; the
+ *  phase ends once every active worker is idle. Only busy workers push, so
+ *  at that point every stack is empty.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  worker    Calling worker.
+ * ========================================================================== */
+static void MEM_gcMarkWorker(mem_allocator_t *const allocator,
+                             gc_worker_t *const     worker)
+{
+  gc_pool_t *pool = (gc_pool_t *)NULL;
+
+  size_t pending = 0u;
+
+  uint32_t index = 0u;
+
+  pool = &allocator->gc_pool;
+
+  for (;;)
+  {
+    MEM_gcDrain(allocator, &worker->stack);
+
+    if (MEM_gcSteal(pool, worker) > 0u)
+      continue;
+
+    atomic_fetch_add_explicit(&pool->idle, 1u, memory_order_acq_rel);
+
+    for (pending = 0u; pending == 0u;)
+    {
+      if (atomic_load_explicit(&pool->idle, memory_order_acquire)
+          == pool->active)
+        return;
+
+      for (index = 0u; index < pool->active && pending == 0u; ++index)
+        pending = __atomic_load_n(&pool->workers[index].stack.len,
+                                  __ATOMIC_RELAXED);
+
+      if (pending == 0u)
+        sched_yield( );
+    }
+
+    atomic_fetch_sub_explicit(&pool->idle, 1u, memory_order_acq_rel);
+  }
+}
+
+/** ============================================================================
+ *  @brief  Records the unreachable heap blocks of one sweep partition.
+ *
+ *  Walks start_bits & ~mark_bits over the worker's [first, last) bitmap
+ *  words and pushes every candidate that is still an allocated block on the
+ *  worker's stack, in address order. Nothing is freed: MEM_gcSweepRun() is
+ *  not thread-safe, so MEM_gcSweep() releases the lists afterwards.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  worker    Calling worker.
+ * ========================================================================== */
+static void MEM_gcSweepCollect(mem_allocator_t *const allocator,
+                               gc_worker_t *const     worker)
+{
+  block_header_t *block = (block_header_t *)NULL;
+
+  uint64_t candidates = 0u;
+
+  size_t index = 0u;
+  size_t bit   = 0u;
+
+  for (index = worker->first; index < worker->last; ++index)
+  {
+    candidates = allocator->start_bits.words[index]
+               & ~allocator->mark_bits.words[index];
+
+    while (candidates != 0u)
+    {
+      bit         = (size_t)(unsigned)__builtin_ctzll(candidates);
+      candidates &= candidates - 1u;
+
+      block = (block_header_t *)(allocator->start_bits.base
+                                 + (index * GC_BITS_PER_WORD + bit)
+                                     * GC_GRANULE);
+
+      if (block->free || block->magic != MAGIC_NUMBER)
+        continue;
+
+      MEM_gcPush(&worker->stack, block);
+    }
+  }
+}
+
+/** ============================================================================
+ *  @brief  Tells whether a heap block was allocated but left unmarked.
+ *
+ *  Blocks outside the bitmaps are reported live.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  block     Heap block header.
+ *
+ *  @return true if start_bits has @p block and mark_bits does not.
+ * ========================================================================== */
+static bool MEM_gcIsDead(mem_allocator_t *const allocator,
+                         block_header_t *const  block)
+{
+  uint64_t mask = 0u;
+
+  size_t granule = 0u;
+  size_t word    = 0u;
+
+  bool dead = false;
+
+  if ((uintptr_t)block < allocator->start_bits.base)
+    goto function_output;
+
+  granule = ((uintptr_t)block - allocator->start_bits.base) / GC_GRANULE;
+  word    = granule / GC_BITS_PER_WORD;
+  mask    = (uint64_t)1u << (granule % GC_BITS_PER_WORD);
+
+  if (word >= allocator->start_bits.used_words
+      || word >= allocator->mark_bits.used_words)
+    goto function_output;
+
+  dead = (allocator->start_bits.words[word]
+          & ~allocator->mark_bits.words[word] & mask)
+      != 0u;
+
+function_output:
+  return dead;
+}
+
+/** ============================================================================
+ *  @brief  Frees a dead heap block together with its dead and free
+ *          neighbours, as one free block.
+ *
+ *  Must be called with gc_lock held. Absorbs the free block just before
+ *  @p block, then walks forward while the next block is free or dead
+ *  (MEM_gcIsDead()), taking free ones off their lists and settling the
+ *  tag and GC bookkeeping of dead ones. The whole run is written back as
+ *  one header and one canary and inserted once. Absorbed headers get their
+ *  magic cleared, so stale start bits or list entries pointing at them are
+ *  skipped. Unlike MEM_freeOp(), nothing is re-validated and the heap is
+ *  never shrunk here; MEM_gcSweep() trims once at the end.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  block     Unmarked, allocated heap block.
+ *
+ *  @return Header of the resulting free block.
+ * ========================================================================== */
+static block_header_t *MEM_gcSweepRun(mem_allocator_t *const allocator,
+                                      block_header_t *const  block)
+{
+  block_header_t *head = (block_header_t *)NULL;
+  block_header_t *cur  = (block_header_t *)NULL;
+  block_header_t *tail = (block_header_t *)NULL;
+  block_header_t *prev = (block_header_t *)NULL;
+
+  uint8_t *heap_end = (uint8_t *)NULL;
+  uint8_t *end      = (uint8_t *)NULL;
+
+  uintptr_t *data_canary = (uintptr_t *)NULL;
+  uintptr_t  canary_addr = 0u;
+
+  size_t freed = 0u;
+
+  uint32_t dead = 0u;
+
+  heap_end = allocator->heap_end;
+  head     = block;
+  prev     = block->prev;
+
+  if (prev != NULL && prev->free && prev->magic == MAGIC_NUMBER
+      && (uint8_t *)prev + prev->size == (uint8_t *)block
+      && MEM_removeFreeBlock(allocator, prev) == EXIT_SUCCESS)
+    head = prev;
+
+  cur = block;
+  for (;;)
+  {
+    if (!cur->free)
+    {
+      LOG_INFO("Sweep Free(sbrk): block %p (%zu bytes).\n",
+               (void *)((uint8_t *)cur + sizeof(block_header_t)),
+               cur->size);
+
+      (void)MEM_tagAccount(allocator, cur, false);
+      MEM_gcTrack(allocator, cur, false);
+
+#ifdef RUNNING_ON_VALGRIND
+      VALGRIND_MEMPOOL_FREE(allocator, (uint8_t *)cur + sizeof(*cur));
+#endif
+
+      freed += cur->size;
+      ++dead;
+    }
+
+    if (cur != head)
+      cur->magic = 0u;
+
+    tail = cur;
+    end  = (uint8_t *)cur + cur->size;
+
+    if (end + sizeof(block_header_t) > heap_end)
+      break;
+
+    cur = (block_header_t *)end;
+    if (cur->magic != MAGIC_NUMBER || cur->canary != CANARY_VALUE
+        || cur->size < MIN_BLOCK_SIZE || cur->size > (size_t)(heap_end - end))
+      break;
+
+    if (cur->free)
+    {
+      if (MEM_removeFreeBlock(allocator, cur) != EXIT_SUCCESS)
+        break;
+    }
+    else if (!MEM_gcIsDead(allocator, cur))
+    {
+      break;
+    }
+  }
+
+  head->size   = (size_t)(end - (uint8_t *)head);
+  head->free   = 1u;
+  head->marked = 0u;
+  head->file   = __FILE__;
+  head->line   = (uint64_t)__LINE__;
+  head->next   = tail->next;
+  if (head->next)
+    head->next->prev = head;
+
+  canary_addr  = (uintptr_t)head + head->size - sizeof(uintptr_t);
+  data_canary  = (uintptr_t *)canary_addr;
+  *data_canary = CANARY_VALUE;
+
+  if ((uint8_t *)allocator->arenas[0].top_chunk > (uint8_t *)head
+      && (uint8_t *)allocator->arenas[0].top_chunk < end)
+    allocator->arenas[0].top_chunk = head;
+
+  head->fl_next = (block_header_t *)NULL;
+  head->fl_prev = (block_header_t *)NULL;
+
+  (void)MEM_insertFreeBlock(allocator, head);
+
+  allocator->gc_stats.current.blocks_freed += dead;
+  allocator->gc_stats.current.bytes_freed  += freed;
+
+  LOG_DEBUG("Sweep run: %p (%zu bytes, %u dead blocks).\n",
+            (void *)((uint8_t *)head + sizeof(block_header_t)),
+            head->size,
+            dead);
+
+  return head;
+}
+
+/** ============================================================================
+ *  @brief  Frees the unreachable heap blocks of a bitmap word range.
+ *
+ *  Serial sweep used with a single worker, or for a partition whose list
+ *  overflowed its mark stack. Each candidate starts a MEM_gcSweepRun();
+ *  candidates it absorbed fail the magic check and are skipped.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  first     First bitmap word.
+ *  @param[in]  last      One past the last bitmap word.
+ *
+ *  @return The free block the sweep left at the heap top, or NULL.
+ * ========================================================================== */
+static block_header_t *MEM_gcSweepWords(mem_allocator_t *const allocator,
+                                        const size_t           first,
+                                        const size_t           last)
+{
+  block_header_t *block = (block_header_t *)NULL;
+  block_header_t *head  = (block_header_t *)NULL;
+  block_header_t *top   = (block_header_t *)NULL;
+
+  uint64_t candidates = 0u;
+
+  size_t index = 0u;
+  size_t bit   = 0u;
+
+  for (index = first; index < last; ++index)
+  {
+    candidates = allocator->start_bits.words[index]
+               & ~allocator->mark_bits.words[index];
+
+    while (candidates != 0u)
+    {
+      bit         = (size_t)(unsigned)__builtin_ctzll(candidates);
+      candidates &= candidates - 1u;
+
+      block = (block_header_t *)(allocator->start_bits.base
+                                 + (index * GC_BITS_PER_WORD + bit)
+                                     * GC_GRANULE);
+      if ((uint8_t *)block >= allocator->heap_end)
+        goto function_output;
+
+      if (block->free || block->magic != MAGIC_NUMBER)
+        continue;
+
+      head = MEM_gcSweepRun(allocator, block);
+      if ((uint8_t *)head + head->size == allocator->heap_end)
+        top = head;
+    }
+  }
+
+function_output:
+  return top;
+}
+
+/** ============================================================================
+ *  @brief  Body of a parallel mark/sweep pool thread.
+ *
+ *  Waits on the pool's wake condition for a new phase, runs its share of
+ *  the work and reports completion, until the pool is stopped.
+ *
+ *  @param[in]  arg Pointer to the gc_worker_t of this thread.
+ *
+ *  @return NULL.
+ * ========================================================================== */
+static void *MEM_gcPoolThread(void *arg)
+{
+  gc_worker_t     *worker    = (gc_worker_t *)arg;
+  mem_allocator_t *allocator = (mem_allocator_t *)NULL;
+  gc_pool_t       *pool      = (gc_pool_t *)NULL;
+
+  gc_phase_t phase = GC_PHASE_MARK;
+
+  uint32_t seen = 0u;
+
+  allocator = worker->allocator;
+  pool      = &allocator->gc_pool;
+
+  pthread_mutex_lock(&pool->lock);
+  seen = worker->seen;
+
+  while (!pool->exit)
+  {
+    while (pool->generation == seen && !pool->exit)
+      pthread_cond_wait(&pool->wake, &pool->lock);
+
+    if (pool->exit)
+      break;
+
+    seen = pool->generation;
+    if (worker->id >= pool->active)
+      continue;
+
+    phase = pool->phase;
+    pthread_mutex_unlock(&pool->lock);
+
+    if (phase == GC_PHASE_MARK)
+      MEM_gcMarkWorker(allocator, worker);
+    else
+      MEM_gcSweepCollect(allocator, worker);
+
+    pthread_mutex_lock(&pool->lock);
+    if (++pool->done == pool->active - 1u)
+      pthread_cond_signal(&pool->finished);
+  }
+
+  pthread_mutex_unlock(&pool->lock);
+
+  return NULL;
+}
+
+/** ============================================================================
+ *  @brief  Prepares the worker pool for a cycle. Caller holds gc_lock.
+ *
+ *  Resolves the worker count on first use (MEM_GC_WORKERS_ENV, default 1),
+ *  creates missing pool threads and fixes the number of active workers for
+ *  the cycle. Runs before the world is stopped; a thread that cannot be
+ *  created only lowers the worker count.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+static void MEM_gcPoolStart(mem_allocator_t *const allocator)
+{
+  int ret = EXIT_SUCCESS;
+
+  gc_pool_t   *pool   = (gc_pool_t *)NULL;
+  gc_worker_t *worker = (gc_worker_t *)NULL;
+
+  const char *env = (const char *)NULL;
+
+  unsigned long long parsed = 0u;
+
+  uint32_t index = 0u;
+
+  pool = &allocator->gc_pool;
+
+  if (pool->num_workers == 0u)
+  {
+    pool->num_workers = 1u;
+
+    env = getenv(MEM_GC_WORKERS_ENV);
+    if (env != NULL)
+    {
+      parsed = strtoull(env, (char **)NULL, 10);
+      if (parsed > MEM_GC_MAX_WORKERS)
+        parsed = MEM_GC_MAX_WORKERS;
+
+      if (parsed > 0u)
+        pool->num_workers = (uint32_t)parsed;
+    }
+  }
+
+  if (!pool->ready)
+  {
+    pool->active = 1u;
+
+    for (index = 0u; index < MEM_GC_MAX_WORKERS; ++index)
+    {
+      pool->workers[index].id        = index;
+      pool->workers[index].allocator = allocator;
+    }
+
+    if (pool->num_workers < 2u)
+      return;
+
+    ret = pthread_mutex_init(&pool->lock, (const pthread_mutexattr_t *)NULL);
+    if (ret != EXIT_SUCCESS)
+      goto pool_failed;
+
+    ret = pthread_cond_init(&pool->wake, (const pthread_condattr_t *)NULL);
+    if (ret != EXIT_SUCCESS)
+    {
+      pthread_mutex_destroy(&pool->lock);
+      goto pool_failed;
+    }
+
+    ret = pthread_cond_init(&pool->finished, (const pthread_condattr_t *)NULL);
+    if (ret != EXIT_SUCCESS)
+    {
+      pthread_cond_destroy(&pool->wake);
+      pthread_mutex_destroy(&pool->lock);
+      goto pool_failed;
+    }
+
+    pool->exit  = false;
+    pool->ready = true;
+  }
+
+  while (pool->num_started + 1u < pool->num_workers)
+  {
+    worker       = &pool->workers[pool->num_started + 1u];
+    worker->seen = pool->generation;
+
+    ret = pthread_create(&worker->thread,
+                         (const pthread_attr_t *)NULL,
+                         MEM_gcPoolThread,
+                         (void *)worker);
+    if (ret != EXIT_SUCCESS)
+    {
+      LOG_WARNING("Failed to create GC worker %u. "
+                  "Error code: %d.\n",
+                  worker->id,
+                  -ret);
+      break;
+    }
+
+    ++pool->num_started;
+  }
+
+  pool->active = pool->num_started + 1u;
+  if (pool->active > pool->num_workers)
+    pool->active = pool->num_workers;
+
+  return;
+
+pool_failed:
+  LOG_WARNING("GC worker pool unavailable; marking serially. "
+              "Error code: %d.\n",
+              -ret);
+}
+
+/** ============================================================================
+ *  @brief  Starts a phase on the pool threads.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  phase     Work to run.
+ * ========================================================================== */
+static void MEM_gcPoolBegin(mem_allocator_t *const allocator,
+                            const gc_phase_t       phase)
+{
+  gc_pool_t *pool = (gc_pool_t *)NULL;
+
+  pool = &allocator->gc_pool;
+
+  atomic_store_explicit(&pool->idle, 0u, memory_order_relaxed);
+
+  if (pool->active < 2u)
+    return;
+
+  pthread_mutex_lock(&pool->lock);
+
+  pool->phase = phase;
+  pool->done  = 0u;
+  ++pool->generation;
+
+  pthread_cond_broadcast(&pool->wake);
+  pthread_mutex_unlock(&pool->lock);
+}
+
+/** ============================================================================
+ *  @brief  Waits until every pool thread finished the current phase.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+static void MEM_gcPoolWait(mem_allocator_t *const allocator)
+{
+  gc_pool_t *pool = (gc_pool_t *)NULL;
+
+  pool = &allocator->gc_pool;
+
+  if (pool->active < 2u)
+    return;
+
+  pthread_mutex_lock(&pool->lock);
+
+  while (pool->done < pool->active - 1u)
+    pthread_cond_wait(&pool->finished, &pool->lock);
+
+  pthread_mutex_unlock(&pool->lock);
+}
+
+/** ============================================================================
+ *  @brief  Joins the pool threads and releases the worker mark stacks.
+ *
+ *  The configured worker count is kept for the next MEM_runGc().
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+static void MEM_gcPoolStop(mem_allocator_t *const allocator)
+{
+  gc_pool_t       *pool  = (gc_pool_t *)NULL;
+  gc_mark_stack_t *stack = (gc_mark_stack_t *)NULL;
+
+  uint32_t index = 0u;
+
+  pool = &allocator->gc_pool;
+
+  if (pool->ready)
+  {
+    pthread_mutex_lock(&pool->lock);
+    pool->exit = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (index = 1u; index <= pool->num_started; ++index)
+      pthread_join(pool->workers[index].thread, NULL);
+
+    pthread_cond_destroy(&pool->finished);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+  }
+
+  for (index = 0u; index < MEM_GC_MAX_WORKERS; ++index)
+  {
+    stack = &pool->workers[index].stack;
+    if (stack->items == NULL)
+      continue;
+
+    munmap(stack->items, stack->cap * sizeof(block_header_t *));
+
+    stack->items = (block_header_t **)NULL;
+    stack->len   = 0u;
+    stack->cap   = 0u;
+  }
+
+  pool->num_started = 0u;
+  pool->active      = 0u;
+  pool->ready       = false;
+  pool->exit        = false;
+}
+
+/** ============================================================================
+ *  @brief  Extends a heap bitmap to cover the current heap, keeping its bits.
+ *
+ *  The bitmap holds one bit per GC_GRANULE bytes of the user heap and lives
+ *  in its own mapping, grown with mremap() as the heap grows. Words that
+ *  come into use are cleared; block headers are not touched.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  bits      Bitmap to extend (mark_bits or start_bits).
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Bitmap covers the heap.
+ *  @retval -ENOMEM:      The bitmap could not be grown.
+ * ========================================================================== */
+static int MEM_gcBitmapGrow(mem_allocator_t *const allocator,
+                            gc_bitmap_t *const     bits)
+{
+  int ret = EXIT_SUCCESS;
+
+  uintptr_t base = 0u;
+
+  size_t granules = 0u;
+  size_t need     = 0u;
+
+  base     = (uintptr_t)allocator->heap_start + allocator->metadata_size;
+  granules = ((uintptr_t)allocator->heap_end - base) / GC_GRANULE;
+  need     = (granules + GC_BITS_PER_WORD - 1u) / GC_BITS_PER_WORD;
+
+  bits->base = base;
+
+  ret = MEM_gcBitmapCover(bits, need);
+
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Sizes and clears a heap bitmap for a new cycle.
+ *
+ *  Drops every word in use and lets MEM_gcBitmapGrow() cover the heap
+ *  again, so clearing is a single MEM_memset(); block headers are not
+ *  touched.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  bits      Bitmap to reset (mark_bits or start_bits).
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Bitmap covers the heap and is clear.
+ *  @retval -ENOMEM:      The bitmap could not be grown.
+ * ========================================================================== */
+static int MEM_gcBitmapReset(mem_allocator_t *const allocator,
+                             gc_bitmap_t *const     bits)
+{
+  int ret = EXIT_SUCCESS;
+
+  bits->used_words = 0u;
+
+  ret = MEM_gcBitmapGrow(allocator, bits);
+
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Makes a side bitmap hold @p need words, keeping its bits.
+ *
+ *  The bitmap lives in its own mapping, created with mmap() and grown with
+ *  mremap() to twice the need. Words that come into use are cleared.
+ *
+ *  @param[in]  bits Bitmap to extend.
+ *  @param[in]  need Words the bitmap must cover.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Bitmap holds @p need words.
+ *  @retval -ENOMEM:      The bitmap could not be grown.
+ * ========================================================================== */
+static int MEM_gcBitmapCover(gc_bitmap_t *const bits, const size_t need)
+{
+  int ret = EXIT_SUCCESS;
+
+  void *words = (void *)NULL;
+
+  size_t cap  = 0u;
+  size_t page = 0u;
+
+  if (need <= bits->used_words)
+    goto function_output;
+
+  if (need > bits->cap_words)
+  {
+    page = (size_t)sysconf(_SC_PAGESIZE);
+    cap  = need * 2u * sizeof(uint64_t);
+    cap  = (cap + page - 1u) & ~(page - 1u);
+
+    if (bits->words == NULL)
+      words = mmap(NULL,
+                   cap,
+                   PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS,
+                   -1,
+                   0);
+    else
+      words = mremap(bits->words,
+                     bits->cap_words * sizeof(uint64_t),
+                     cap,
+                     MREMAP_MAYMOVE);
+
+    if (words == MAP_FAILED)
+    {
+      ret = -ENOMEM;
+      LOG_ERROR("Failed to grow GC bitmap to %zu bytes. "
+                "Error code: %d.\n",
+                cap,
+                ret);
+      goto function_output;
+    }
+
+    bits->words     = (uint64_t *)words;
+    bits->cap_words = cap / sizeof(uint64_t);
+  }
+
+  MEM_memset(&bits->words[bits->used_words],
+             0,
+             (need - bits->used_words) * sizeof(uint64_t));
+
+  bits->used_words = need;
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Starts a new blacklist cycle. Caller holds gc_lock.
+ *
+ *  The current table becomes the previous one, and the other table is
+ *  cleared and sized to the heap plus GC_BLACKLIST_SLACK. Pages hit by the
+ *  last two cycles are thus avoided, while pages no longer referenced are
+ *  released after one cycle. Cycles marked by a fork()ed child record
+ *  nothing, since the child's writes are lost.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Blacklist rotated.
+ *  @retval -ENOMEM:      The new table could not be grown.
+ * ========================================================================== */
+static int MEM_gcBlacklistRotate(mem_allocator_t *const allocator)
+{
+  int ret = EXIT_SUCCESS;
+
+  gc_blacklist_t *blacklist = (gc_blacklist_t *)NULL;
+  gc_bitmap_t    *bits      = (gc_bitmap_t *)NULL;
+
+  size_t pages = 0u;
+
+  blacklist = &allocator->gc_blacklist;
+
+  blacklist->current ^= 1u;
+  blacklist->grown    = 0u;
+
+  bits             = &blacklist->pages[blacklist->current];
+  bits->base       = (uintptr_t)allocator->heap_start + allocator->metadata_size;
+  bits->used_words = 0u;
+
+  pages = ((uintptr_t)allocator->heap_end + GC_BLACKLIST_SLACK - bits->base
+           + GC_BLACKLIST_PAGE - 1u)
+        / GC_BLACKLIST_PAGE;
+
+  ret = MEM_gcBitmapCover(bits,
+                          (pages + GC_BITS_PER_WORD - 1u) / GC_BITS_PER_WORD);
+
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Records a scanned word that resolved to no allocated block.
+ *
+ *  Words pointing into the range covered by the current table blacklist
+ *  their page; anything else is ignored. Mark workers race on the table,
+ *  so the bit is set with an atomic fetch-or.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  addr      Scanned word.
+ * ========================================================================== */
+static void MEM_gcBlacklistAdd(mem_allocator_t *const allocator,
+                               const uintptr_t        addr)
+{
+  gc_blacklist_t *blacklist = (gc_blacklist_t *)NULL;
+  gc_bitmap_t    *bits      = (gc_bitmap_t *)NULL;
+
+  uint64_t *word = (uint64_t *)NULL;
+  uint64_t  mask = 0u;
+
+  size_t page = 0u;
+
+  blacklist = &allocator->gc_blacklist;
+  bits      = &blacklist->pages[blacklist->current];
+
+  if (addr < bits->base)
+    return;
+
+  page = (addr - bits->base) / GC_BLACKLIST_PAGE;
+  if (page >= bits->used_words * GC_BITS_PER_WORD)
+    return;
+
+  word = &bits->words[page / GC_BITS_PER_WORD];
+  mask = (uint64_t)1u << (page % GC_BITS_PER_WORD);
+
+  if (__atomic_load_n(word, __ATOMIC_RELAXED) & mask)
+    return;
+
+  if ((__atomic_fetch_or(word, mask, __ATOMIC_RELAXED) & mask) == 0u)
+    atomic_fetch_add_explicit(&blacklist->hits, 1u, memory_order_relaxed);
+}
+
+/** ============================================================================
+ *  @brief  Tells whether an allocation split from a block would sit on a
+ *          blacklisted page.
+ *
+ *  Checks the payload a split of @p size bytes would hand out against
+ *  both tables and counts the block as avoided. The check is skipped while
+ *  @b bypass is set or once the heap grew by GC_BLACKLIST_GROW this cycle.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  block     Candidate free block.
+ *  @param[in]  size      Total size requested (including header and canary).
+ *
+ *  @return true if the block should be passed over.
+ * ========================================================================== */
+static bool MEM_gcBlacklisted(mem_allocator_t *const allocator,
+                              block_header_t *const  block,
+                              const size_t           size)
+{
+  gc_blacklist_t *blacklist = (gc_blacklist_t *)NULL;
+  gc_bitmap_t    *bits      = (gc_bitmap_t *)NULL;
+
+  uintptr_t first = 0u;
+  uintptr_t last  = 0u;
+
+  size_t table = 0u;
+  size_t page  = 0u;
+  size_t end   = 0u;
+
+  bool listed = false;
+
+  blacklist = &allocator->gc_blacklist;
+  if (blacklist->bypass || blacklist->grown >= GC_BLACKLIST_GROW)
+    goto function_output;
+
+  first = (uintptr_t)block + sizeof(block_header_t);
+  last  = (uintptr_t)block + size - 1u;
+
+  for (table = 0u; table < 2u && !listed; ++table)
+  {
+    bits = &blacklist->pages[table];
+    if (bits->used_words == 0u || last < bits->base)
+      continue;
+
+    page = (first < bits->base) ? 0u : (first - bits->base) / GC_BLACKLIST_PAGE;
+    end  = (last - bits->base) / GC_BLACKLIST_PAGE;
+    if (end >= bits->used_words * GC_BITS_PER_WORD)
+      end = bits->used_words * GC_BITS_PER_WORD - 1u;
+
+    for (; page <= end; ++page)
+    {
+      if ((bits->words[page / GC_BITS_PER_WORD]
+           >> (page % GC_BITS_PER_WORD))
+          & 1u)
+      {
+        listed = true;
+        break;
+      }
+    }
+  }
+
+  if (listed)
+  {
+    blacklist->skipped = true;
+    ++blacklist->avoided;
+  }
+
+function_output:
+  return listed;
+}
+
+/** ============================================================================
+ *  @brief  Tests whether a block carries a GC mark.
+ *
+ *  Heap blocks are looked up in the mark bitmap; mmap blocks, which lie
+ *  outside it, keep using their header flag.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  block     Block header.
+ *
+ *  @return true if @p block is marked.
+ * ========================================================================== */
+static bool MEM_gcIsMarked(mem_allocator_t *const allocator,
+                           block_header_t *const  block)
+{
+  gc_bitmap_t *bits = &allocator->mark_bits;
+
+  size_t index = 0u;
+
+  if ((uintptr_t)block < bits->base
+      || (uintptr_t)block >= (uintptr_t)allocator->heap_end)
+    return block->marked != 0u;
+
+  index = ((uintptr_t)block - bits->base) / GC_GRANULE;
+
+  return (bits->words[index / GC_BITS_PER_WORD]
+          >> (index % GC_BITS_PER_WORD)) & 1u;
+}
+
+/** ============================================================================
+ *  @brief  Marks a block, reporting whether it was unmarked before.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  block     Block header.
+ *
+ *  Mark workers race on the same words, so the bit is set with an atomic
+ *  fetch-or and only the worker that flipped it pushes the block.
+ *
+ *  @return true if this call set the mark.
+ * ========================================================================== */
+static bool MEM_gcSetMark(mem_allocator_t *const allocator,
+                          block_header_t *const  block)
+{
+  gc_bitmap_t *bits = &allocator->mark_bits;
+
+  uint64_t *word = (uint64_t *)NULL;
+  uint64_t  mask = 0u;
+
+  size_t index = 0u;
+
+  if ((uintptr_t)block < bits->base
+      || (uintptr_t)block >= (uintptr_t)allocator->heap_end)
+  {
+    if (__atomic_load_n(&block->marked, __ATOMIC_RELAXED))
+      return false;
+
+    return __atomic_exchange_n(&block->marked, 1u, __ATOMIC_RELAXED) == 0u;
+  }
+
+  index = ((uintptr_t)block - bits->base) / GC_GRANULE;
+  word  = &bits->words[index / GC_BITS_PER_WORD];
+  mask  = (uint64_t)1u << (index % GC_BITS_PER_WORD);
+
+  if (__atomic_load_n(word, __ATOMIC_RELAXED) & mask)
+    return false;
+
+  return (__atomic_fetch_or(word, mask, __ATOMIC_RELAXED) & mask) == 0u;
+}
+
+/** ============================================================================
+ *  @brief  Records the start of every allocated heap block in start_bits.
+ *
+ *  One pass over the block headers, before the world is stopped, lets
+ *  MEM_gcFindBlock() resolve interior pointers and lets MEM_gcSweep() find
+ *  unmarked blocks word by word. Only a header with a valid magic and an
+ *  aligned size is stepped over; anything else, such as chunks another
+ *  allocator placed on the program break, is skipped a granule at a time.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Heap indexed.
+ *  @retval -ENOMEM:      The start bitmap could not be grown.
+ * ========================================================================== */
+static int MEM_gcIndexHeap(mem_allocator_t *const allocator)
+{
+  int ret = EXIT_SUCCESS;
+
+  gc_bitmap_t *bits = (gc_bitmap_t *)NULL;
+
+  block_header_t *block = (block_header_t *)NULL;
+
+  uintptr_t heap_ptr = 0u;
+  uintptr_t heap_end = 0u;
+
+  size_t index = 0u;
+
+  bits = &allocator->start_bits;
+
+  ret = MEM_gcBitmapReset(allocator, bits);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  heap_ptr = bits->base;
+  heap_end = (uintptr_t)allocator->heap_end;
+
+  while (heap_ptr < heap_end)
+  {
+    block = (block_header_t *)heap_ptr;
+    if (block->magic != MAGIC_NUMBER || block->size < MIN_BLOCK_SIZE
+        || block->size > heap_end - heap_ptr
+        || (block->size & (GC_GRANULE - 1u)) != 0u)
+    {
+      heap_ptr += GC_GRANULE;
+      continue;
+    }
+
+    if (!block->free && block->canary == CANARY_VALUE)
+    {
+      index = (heap_ptr - bits->base) / GC_GRANULE;
+      bits->words[index / GC_BITS_PER_WORD]
+        |= (uint64_t)1u << (index % GC_BITS_PER_WORD);
+    }
+
+    heap_ptr += block->size;
+  }
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  qsort() comparator ordering mmap ranges by start address.
+ *
+ *  @param[in]  lhs First gc_map_range_t.
+ *  @param[in]  rhs Second gc_map_range_t.
+ *
+ *  @return Negative, zero or positive as @p lhs starts before, with or
+ *          after @p rhs.
+ * ========================================================================== */
+static int MEM_gcRangeCompare(const void *lhs, const void *rhs)
+{
+  const gc_map_range_t *left  = (const gc_map_range_t *)lhs;
+  const gc_map_range_t *right = (const gc_map_range_t *)rhs;
+
+  return (left->start > right->start) - (left->start < right->start);
+}
+
+/** ============================================================================
+ *  @brief  Builds the sorted payload index of live mmap blocks.
+ *
+ *  The index lives in its own mapping, grown with mremap(); MEM_gcFindBlock()
+ *  binary-searches it instead of walking mmap_list for every word.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Index built.
+ *  @retval -ENOMEM:      The index could not be grown.
+ * ========================================================================== */
+static int MEM_gcIndexMaps(mem_allocator_t *const allocator)
+{
+  int ret = EXIT_SUCCESS;
+
+  gc_map_index_t *index = (gc_map_index_t *)NULL;
+  gc_map_range_t *range = (gc_map_range_t *)NULL;
+
+  block_header_t *block = (block_header_t *)NULL;
+
+  mmap_t *map = (mmap_t *)NULL;
+
+  void *ranges = (void *)NULL;
+
+  size_t count = 0u;
+  size_t cap   = 0u;
+  size_t page  = 0u;
+
+  index      = &allocator->map_index;
+  index->len = 0u;
+
+  for (map = allocator->mmap_list; map; map = map->next)
+    ++count;
+
+  if (count == 0u)
+    goto function_output;
+
+  if (count > index->cap)
+  {
+    page = (size_t)sysconf(_SC_PAGESIZE);
+    cap  = count * 2u * sizeof(gc_map_range_t);
+    cap  = (cap + page - 1u) & ~(page - 1u);
+
+    if (index->ranges == NULL)
+      ranges = mmap(NULL,
+                    cap,
+                    PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS,
+                    -1,
+                    0);
+    else
+      ranges = mremap(index->ranges,
+                      index->cap * sizeof(gc_map_range_t),
+                      cap,
+                      MREMAP_MAYMOVE);
+
+    if (ranges == MAP_FAILED)
+    {
+      ret = -ENOMEM;
+      LOG_ERROR("Failed to grow GC mmap index to %zu bytes. "
+                "Error code: %d.\n",
+                cap,
+                ret);
+      goto function_output;
+    }
+
+    index->ranges = (gc_map_range_t *)ranges;
+    index->cap    = cap / sizeof(gc_map_range_t);
+  }
+
+  for (map = allocator->mmap_list; map; map = map->next)
+  {
+    block = (block_header_t *)map->addr;
+    if (block->free)
+      continue;
+
+    range        = &index->ranges[index->len++];
+    range->start = (uintptr_t)map->addr + sizeof(block_header_t);
+    range->end   = (uintptr_t)map->addr + map->size - sizeof(uintptr_t);
+    range->block = block;
+  }
+
+  qsort(index->ranges, index->len, sizeof(gc_map_range_t), MEM_gcRangeCompare);
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Finds the allocated heap block whose payload contains an address.
+ *
+ *  Looks up the nearest block start at or below @p addr in start_bits,
+ *  scanning backwards a 64-bit word at a time.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  addr      Heap address inside the indexed range.
+ *
+ *  @return Header of the containing block, or NULL.
+ * ========================================================================== */
+static block_header_t *MEM_gcFindHeapBlock(mem_allocator_t *const allocator,
+                                           const uintptr_t        addr)
+{
+  gc_bitmap_t *bits = (gc_bitmap_t *)NULL;
+
+  block_header_t *block = (block_header_t *)NULL;
+
+  uintptr_t header = 0u;
+
+  uint64_t word = 0u;
+
+  size_t granule = 0u;
+  size_t index   = 0u;
+  size_t bit     = 0u;
+
+  bits = &allocator->start_bits;
+
+  granule = (addr - bits->base) / GC_GRANULE;
+  index   = granule / GC_BITS_PER_WORD;
+  bit     = granule % GC_BITS_PER_WORD;
+
+  word = bits->words[index];
+  if (bit != GC_BITS_PER_WORD - 1u)
+    word &= ((uint64_t)1u << (bit + 1u)) - 1u;
+
+  while (word == 0u)
+  {
+    if (index == 0u)
+      return (block_header_t *)NULL;
+
+    word = bits->words[--index];
+  }
+
+  granule = index * GC_BITS_PER_WORD + GC_BITS_PER_WORD - 1u
+          - (size_t)(unsigned)__builtin_clzll(word);
+  header  = bits->base + granule * GC_GRANULE;
+
+  block = (block_header_t *)header;
+  if (addr < header + sizeof(block_header_t)
+      || addr >= header + block->size - sizeof(uintptr_t))
+    return (block_header_t *)NULL;
+
+  return block;
+}
+
+/** ============================================================================
+ *  @brief  Reset “marked” flags across all allocated regions.
+ *
+ *  This function prepares for a new garbage-collection cycle by clearing the
+ *  mark of every heap block and every mmap’d block payload.  Heap marks live
+ *  in the side bitmap and are cleared at once by MEM_gcBitmapReset(), without
+ *  touching any block header.  The GC blacklist moves on to a new table
+ *  (MEM_gcBlacklistRotate()).  It then builds the lookup structures used to
+ *  resolve interior pointers (MEM_gcIndexHeap(), MEM_gcIndexMaps()) and
+ *  iterates allocator->mmap_list, clearing the mark on each payload block.
+ *  mmap metadata headers are unmarked too, so tracing never scans them;
+ *  MEM_gcMark() pins them once tracing is done.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: All marks cleared.
+ *  @retval -EINVAL:      @p allocator is NULL.
+ *  @retval -ENOMEM:      A bitmap or the mmap index could not be grown.
+ * ========================================================================== */
+static int MEM_setInitialMarks(mem_allocator_t *const allocator)
+{
+  int ret = EXIT_SUCCESS;
+
+  block_header_t *block = (block_header_t *)NULL;
+
+  mmap_t *map = (mmap_t *)NULL;
+
+  if (UNLIKELY(allocator == NULL))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid parameters: allocator: %p. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              ret);
+    goto function_output;
+  }
+
+  ret = MEM_gcBitmapReset(allocator, &allocator->mark_bits);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  ret = MEM_gcBlacklistRotate(allocator);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  ret = MEM_gcIndexHeap(allocator);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  ret = MEM_gcIndexMaps(allocator);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  for (map = allocator->mmap_list; map; map = map->next)
+  {
+    block = (block_header_t *)map->addr;
+
+    block->marked = 0u;
+  }
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Parks a registered thread until the collector restarts the world.
+ *
+ *  Records the address of a local as the thread's stack pointer; the kernel
+ *  saved the interrupted registers above it, on the same stack. Only
+ *  async-signal-safe calls are made.
+ *
+ *  @param[in]  sig Signal number (unused).
+ * ========================================================================== */
+static void MEM_gcSuspendHandler(int sig)
+{
+  gc_registry_t     *registry = (gc_registry_t *)NULL;
+  gc_thread_entry_t *entry    = (gc_thread_entry_t *)NULL;
+
+  volatile uintptr_t marker = 0u;
+
+  sigset_t mask;
+
+  pthread_t self;
+
+  uint32_t iterator = 0u;
+
+  int saved_errno = errno;
+
+  (void)sig;
+
+  registry = g_gc_registry;
+  if (registry == NULL)
+    goto function_output;
+
+  self = pthread_self( );
+  for (iterator = 0u; iterator < MEM_GC_MAX_THREADS; ++iterator)
+  {
+    if (registry->threads[iterator].used
+        && pthread_equal(registry->threads[iterator].thread, self))
+    {
+      entry = &registry->threads[iterator];
+      break;
+    }
+  }
+
+  if (entry == NULL)
+    goto function_output;
+
+  atomic_store_explicit(&entry->sp, (uintptr_t)&marker, memory_order_release);
+  sem_post(&registry->ack);
+
+  sigfillset(&mask);
+  sigdelset(&mask, GC_RESTART_SIGNAL);
+
+  while (atomic_load_explicit(&registry->world_stopped, memory_order_acquire))
+    sigsuspend(&mask);
+
+  sem_post(&registry->ack);
+
+function_output:
+  errno = saved_errno;
+}
+
+/** ============================================================================
+ *  @brief  Wakes a parked thread out of sigsuspend(); does nothing else.
+ *
+ *  @param[in]  sig Signal number (unused).
+ * ========================================================================== */
+static void MEM_gcRestartHandler(int sig)
+{
+  (void)sig;
+}
+
+/** ============================================================================
+ *  @brief  Installs the stop-the-world signal handlers once per process.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Handlers installed (or already installed).
+ *  @retval -errno:       sem_init() or sigaction() failed.
+ * ========================================================================== */
+static int MEM_gcInstallSignals(mem_allocator_t *const allocator)
+{
+  int ret = EXIT_SUCCESS;
+
+  gc_registry_t *registry = (gc_registry_t *)NULL;
+
+  struct sigaction action;
+
+  registry = &allocator->gc_registry;
+  if (registry->signals_ready)
+    goto function_output;
+
+  if (sem_init(&registry->ack, 0, 0u) != EXIT_SUCCESS)
+  {
+    ret = -errno;
+    LOG_ERROR("Failed to init GC ack semaphore. "
+              "Error code: %d.\n",
+              ret);
+    goto function_output;
+  }
+
+  MEM_memset(&action, 0, sizeof(action));
+  action.sa_handler = MEM_gcSuspendHandler;
+  action.sa_flags   = SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  sigaddset(&action.sa_mask, GC_RESTART_SIGNAL);
+
+  if (sigaction(GC_SUSPEND_SIGNAL, &action, (struct sigaction *)NULL)
+      != EXIT_SUCCESS)
+  {
+    ret = -errno;
+    LOG_ERROR("Failed to install GC suspend handler. "
+              "Error code: %d.\n",
+              ret);
+    goto function_output;
+  }
+
+  action.sa_handler = MEM_gcRestartHandler;
+  sigemptyset(&action.sa_mask);
+
+  if (sigaction(GC_RESTART_SIGNAL, &action, (struct sigaction *)NULL)
+      != EXIT_SUCCESS)
+  {
+    ret = -errno;
+    LOG_ERROR("Failed to install GC restart handler. "
+              "Error code: %d.\n",
+              ret);
+    goto function_output;
+  }
+
+  ret = -pthread_key_create(&registry->exit_key, MEM_gcThreadExit);
+  if (ret != EXIT_SUCCESS)
+  {
+    LOG_ERROR("Failed to create the GC thread exit key. "
+              "Error code: %d.\n",
+              ret);
+    goto function_output;
+  }
+
+  g_gc_registry           = registry;
+  registry->signals_ready = true;
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Adds a thread to the GC root registry. Caller holds gc_lock.
+ *
+ *  The thread's stack bounds are queried once here, through
+ *  MEM_stackBounds(), and cached in its registry slot. When @p thread is
+ *  the caller, @b exit_key is set so that MEM_gcThreadExit() drops the
+ *  slot if the thread exits without unregistering.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  thread    Thread to register.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Thread registered.
+ *  @retval -EALREADY:    Thread already registered.
+ *  @retval -ENOSPC:      MEM_GC_MAX_THREADS threads already registered.
+ *  @retval ret>0:        Error code returned by MEM_stackBounds().
+ * ========================================================================== */
+static int MEM_gcRegister(mem_allocator_t *const allocator,
+                          const pthread_t        thread)
+{
+  int ret = EXIT_SUCCESS;
+
+  gc_registry_t     *registry = (gc_registry_t *)NULL;
+  gc_thread_entry_t *slot     = (gc_thread_entry_t *)NULL;
+
+  uintptr_t bottom = 0u;
+  uintptr_t top    = 0u;
+
+  uint32_t iterator = 0u;
+
+  registry = &allocator->gc_registry;
+
+  for (iterator = 0u; iterator < MEM_GC_MAX_THREADS; ++iterator)
+  {
+    if (!registry->threads[iterator].used)
+    {
+      if (slot == NULL)
+        slot = &registry->threads[iterator];
+    }
+    else if (pthread_equal(registry->threads[iterator].thread, thread))
+    {
+      ret = -EALREADY;
+      goto function_output;
+    }
+  }
+
+  if (slot == NULL)
+  {
+    ret = -ENOSPC;
+    LOG_ERROR("GC thread registry full (%u threads). "
+              "Error code: %d.\n",
+              (unsigned)MEM_GC_MAX_THREADS,
+              ret);
+    goto function_output;
+  }
+
+  ret = MEM_stackBounds(thread, allocator);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  bottom = (uintptr_t)allocator->stack_bottom;
+  top    = (uintptr_t)allocator->stack_top;
+
+  MEM_memset(slot, 0, sizeof(*slot));
+  slot->thread   = thread;
+  slot->stack_lo = (bottom < top) ? bottom : top;
+  slot->stack_hi = (bottom < top) ? top : bottom;
+  slot->used     = true;
+
+  registry->num_threads++;
+
+  if (pthread_equal(thread, pthread_self( )))
+    (void)pthread_setspecific(registry->exit_key, allocator);
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Removes a thread from the GC root registry. Caller holds gc_lock.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  thread    Thread to unregister.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Thread unregistered.
+ *  @retval -ENOENT:      Thread was not registered.
+ * ========================================================================== */
+static int MEM_gcUnregister(mem_allocator_t *const allocator,
+                            const pthread_t        thread)
+{
+  int ret = -ENOENT;
+
+  gc_registry_t *registry = (gc_registry_t *)NULL;
+
+  uint32_t iterator = 0u;
+
+  registry = &allocator->gc_registry;
+
+  for (iterator = 0u; iterator < MEM_GC_MAX_THREADS; ++iterator)
+  {
+    if (registry->threads[iterator].used
+        && pthread_equal(registry->threads[iterator].thread, thread))
+    {
+      registry->threads[iterator].used = false;
+      registry->num_threads--;
+
+      if (pthread_equal(thread, pthread_self( )))
+        (void)pthread_setspecific(registry->exit_key, NULL);
+
+      ret = EXIT_SUCCESS;
+      break;
+    }
+  }
+
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  @b exit_key destructor; unregisters a thread that is exiting.
+ *
+ *  Runs on the exiting thread, so its slot is released before its
+ *  pthread_t becomes invalid and MEM_gcStopWorld() never signals it.
+ *
+ *  @param[in]  arg Memory allocator context the thread registered with.
+ * ========================================================================== */
+static void MEM_gcThreadExit(void *arg)
+{
+  mem_allocator_t *allocator = (mem_allocator_t *)NULL;
+
+  allocator = (mem_allocator_t *)arg;
+  if (allocator == NULL)
+    return;
+
+  pthread_mutex_lock(&allocator->gc_thread.gc_lock);
+  (void)MEM_gcUnregister(allocator, pthread_self( ));
+  pthread_mutex_unlock(&allocator->gc_thread.gc_lock);
+}
+
+/** ============================================================================
+ *  @brief  Parks every registered thread except the caller.
+ *
+ *  Sends GC_SUSPEND_SIGNAL to each registered thread and waits until all of
+ *  them acknowledged from their handler. A thread reported gone (ESRCH)
+ *  exited without unregistering; its slot is dropped. Threads that cannot
+ *  be signalled otherwise are skipped and scanned over their full stack.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+static void MEM_gcStopWorld(mem_allocator_t *const allocator)
+{
+  int ret = EXIT_SUCCESS;
+
+  gc_registry_t     *registry = (gc_registry_t *)NULL;
+  gc_thread_entry_t *entry    = (gc_thread_entry_t *)NULL;
+
+  pthread_t self;
+
+  uint32_t iterator = 0u;
+  uint32_t pending  = 0u;
+
+  registry = &allocator->gc_registry;
+  self     = pthread_self( );
+
+  allocator->gc_stats.stop_ns = MEM_gcClockNs( );
+
+  atomic_store_explicit(&registry->world_stopped, true, memory_order_release);
+
+  for (iterator = 0u; iterator < MEM_GC_MAX_THREADS; ++iterator)
+  {
+    entry = &registry->threads[iterator];
+
+    entry->suspended = false;
+    atomic_store_explicit(&entry->sp, 0u, memory_order_relaxed);
+
+    if (!entry->used || pthread_equal(entry->thread, self))
+      continue;
+
+    ret = pthread_kill(entry->thread, GC_SUSPEND_SIGNAL);
+    if (ret == EXIT_SUCCESS)
+    {
+      entry->suspended = true;
+      ++pending;
+    }
+    else if (ret == ESRCH)
+    {
+      entry->used = false;
+      registry->num_threads--;
+      LOG_WARNING("GC thread %u exited without unregistering; "
+                  "slot dropped.\n",
+                  iterator);
+    }
+  }
+
+  while (pending > 0u)
+  {
+    if (sem_wait(&registry->ack) == EXIT_SUCCESS)
+      --pending;
+  }
+}
+
+/** ============================================================================
+ *  @brief  Restarts the threads parked by MEM_gcStopWorld().
+ *
+ *  Waits for every thread to leave its handler, so a following stop cannot
+ *  consume a stale acknowledgement, then charges the pause to the current
+ *  cycle's metrics.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+static void MEM_gcStartWorld(mem_allocator_t *const allocator)
+{
+  gc_registry_t     *registry = (gc_registry_t *)NULL;
+  gc_thread_entry_t *entry    = (gc_thread_entry_t *)NULL;
+  mem_gc_cycle_t    *cycle    = (mem_gc_cycle_t *)NULL;
+
+  uint64_t pause = 0u;
+
+  uint32_t iterator = 0u;
+  uint32_t pending  = 0u;
+
+  registry = &allocator->gc_registry;
+
+  atomic_store_explicit(&registry->world_stopped, false, memory_order_release);
+
+  for (iterator = 0u; iterator < MEM_GC_MAX_THREADS; ++iterator)
+  {
+    entry = &registry->threads[iterator];
+    if (!entry->suspended)
+      continue;
+
+    entry->suspended = false;
+
+    if (pthread_kill(entry->thread, GC_RESTART_SIGNAL) == EXIT_SUCCESS)
+      ++pending;
+  }
+
+  while (pending > 0u)
+  {
+    if (sem_wait(&registry->ack) == EXIT_SUCCESS)
+      --pending;
+  }
+
+  cycle = &allocator->gc_stats.current;
+  pause = MEM_gcClockNs( ) - allocator->gc_stats.stop_ns;
+
+  cycle->pause_ns += pause;
+  if (pause > cycle->max_pause_ns)
+    cycle->max_pause_ns = pause;
+}
+
+/** ============================================================================
+ *  @brief  dl_iterate_phdr() callback recording writable PT_LOAD segments.
+ *
+ *  @param[in]  info Loaded object description.
+ *  @param[in]  size Size of @p info (unused).
+ *  @param[in]  data Memory allocator context.
+ *
+ *  @return 0 to continue the iteration.
+ * ========================================================================== */
+static int MEM_gcPhdrCallback(struct dl_phdr_info *info,
+                              size_t               size,
+                              void                *data)
+{
+  mem_allocator_t *allocator = (mem_allocator_t *)NULL;
+  gc_registry_t   *registry  = (gc_registry_t *)NULL;
+
+  const ElfW(Phdr) *phdr = (const ElfW(Phdr) *)NULL;
+
+  uint32_t iterator = 0u;
+
+  (void)size;
+
+  allocator = (mem_allocator_t *)data;
+  registry  = &allocator->gc_registry;
+
+  for (iterator = 0u; iterator < info->dlpi_phnum; ++iterator)
+  {
+    phdr = &info->dlpi_phdr[iterator];
+    if (phdr->p_type != PT_LOAD || (phdr->p_flags & PF_W) == 0u)
+      continue;
+
+    if (registry->num_roots == GC_MAX_ROOT_RANGES)
+    {
+      registry->roots_dropped++;
+      continue;
+    }
+
+    registry->roots[registry->num_roots].start
+      = (uintptr_t)(info->dlpi_addr + phdr->p_vaddr);
+    registry->roots[registry->num_roots].end
+      = registry->roots[registry->num_roots].start + phdr->p_memsz;
+    registry->num_roots++;
+  }
+
+  return 0;
+}
+
+/** ============================================================================
+ *  @brief  Scans a root range, skipping the allocator's own state.
+ *
+ *  The allocator lives in a writable segment and holds pointers to its own
+ *  bookkeeping blocks, which must not act as roots.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  start     First byte of the range.
+ *  @param[in]  end       One past the last byte of the range.
+ * ========================================================================== */
+static void MEM_gcScanRoot(mem_allocator_t *const allocator,
+                           const uintptr_t        start,
+                           const uintptr_t        end)
+{
+  gc_mark_stack_t *stack = (gc_mark_stack_t *)NULL;
+
+  uintptr_t self_start = 0u;
+  uintptr_t self_end   = 0u;
+
+  stack = &allocator->gc_pool.workers[0].stack;
+
+  self_start = (uintptr_t)allocator;
+  self_end   = self_start + sizeof(*allocator);
+
+  if (end <= self_start || start >= self_end)
+  {
+    MEM_gcScanRange(allocator, stack, start, end);
+    return;
+  }
+
+  if (start < self_start)
+    MEM_gcScanRange(allocator, stack, start, self_start);
+
+  if (end > self_end)
+    MEM_gcScanRange(allocator, stack, self_end, end);
+}
+
+/** ============================================================================
+ *  @brief  Records the writable segments of every loaded object.
+ *
+ *  Runs before the world is stopped: dl_iterate_phdr() takes a lock a
+ *  parked thread may hold. Thread stack bounds are cached at registration.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+static void MEM_gcCollectRoots(mem_allocator_t *const allocator)
+{
+  gc_registry_t *registry = (gc_registry_t *)NULL;
+
+  registry = &allocator->gc_registry;
+
+  registry->num_roots     = 0u;
+  registry->roots_dropped = 0u;
+
+  (void)dl_iterate_phdr(MEM_gcPhdrCallback, (void *)allocator);
+
+  if (registry->roots_dropped > 0u)
+  {
+    LOG_WARNING("%u writable segments not scanned (limit %u).\n",
+                registry->roots_dropped,
+                (unsigned)GC_MAX_ROOT_RANGES);
+  }
+}
+
+/** ============================================================================
+ *  @brief  Scans the live stack of every registered thread.
+ *
+ *  Parked threads are scanned from the stack pointer captured by their
+ *  suspend handler; the calling thread from @p own_sp. Threads that were not
+ *  parked are scanned over their whole stack.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  own_sp    Stack address inside the caller's current frame.
+ *
+ *  @return Number of stack bytes scanned.
+ * ========================================================================== */
+static size_t MEM_gcScanThreads(mem_allocator_t *const allocator,
+                                const uintptr_t        own_sp)
+{
+  gc_registry_t     *registry = (gc_registry_t *)NULL;
+  gc_thread_entry_t *entry    = (gc_thread_entry_t *)NULL;
+  gc_mark_stack_t   *stack    = (gc_mark_stack_t *)NULL;
+
+  pthread_t self;
+
+  uintptr_t sp = 0u;
+  uintptr_t lo = 0u;
+  uintptr_t hi = 0u;
+
+  size_t scanned = 0u;
+
+  uint32_t iterator = 0u;
+
+  bool grows_down = false;
+
+  registry   = &allocator->gc_registry;
+  stack      = &allocator->gc_pool.workers[0].stack;
+  self       = pthread_self( );
+  grows_down = MEM_stackGrowsDown( );
+
+  for (iterator = 0u; iterator < MEM_GC_MAX_THREADS; ++iterator)
+  {
+    entry = &registry->threads[iterator];
+    if (!entry->used)
+      continue;
+
+    if (pthread_equal(entry->thread, self))
+      sp = own_sp;
+    else
+      sp = atomic_load_explicit(&entry->sp, memory_order_acquire);
+
+    lo = entry->stack_lo;
+    hi = entry->stack_hi;
+
+    if (sp >= lo && sp < hi)
+    {
+      if (grows_down)
+        lo = sp;
+      else
+        hi = sp + sizeof(uintptr_t);
+    }
+
+    MEM_gcScanRange(allocator, stack, lo, hi);
+    scanned += (size_t)(hi - lo);
+  }
+
+  return scanned;
+}
+
+/** ============================================================================
+ *  @brief  Scans every root while the world is stopped.
+ *
+ *  Scans the caller's saved registers, the live stack of every registered
+ *  thread, the global segments collected by MEM_gcCollectRoots() and the
+ *  movable allocation table, all onto the collector's mark stack.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  registers Registers saved with getcontext() in the caller's
+ *                        frame; also bounds the caller's own stack scan.
+ *
+ *  @return Number of stack bytes scanned.
+ * ========================================================================== */
+static size_t MEM_gcScanRoots(mem_allocator_t *const allocator,
+                              ucontext_t *const      registers)
+{
+  gc_registry_t *registry = (gc_registry_t *)NULL;
+
+  size_t stack_bytes = 0u;
+
+  uint32_t iterator = 0u;
+
+  registry = &allocator->gc_registry;
+
+  MEM_gcScanRange(allocator,
+                  &allocator->gc_pool.workers[0].stack,
+                  (uintptr_t)registers,
+                  (uintptr_t)registers + sizeof(*registers));
+  stack_bytes = MEM_gcScanThreads(allocator, (uintptr_t)registers);
+
+  for (iterator = 0u; iterator < registry->num_roots; ++iterator)
+  {
+    MEM_gcScanRoot(allocator,
+                   registry->roots[iterator].start,
+                   registry->roots[iterator].end);
+  }
+
+  if (allocator->handles.slots != NULL)
+    MEM_gcScanRange(allocator,
+                    &allocator->gc_pool.workers[0].stack,
+                    (uintptr_t)allocator->handles.slots,
+                    (uintptr_t)(allocator->handles.slots
+                                + allocator->handles.len));
+
+  return stack_bytes;
+}
+
+/** ============================================================================
+ *  @brief  Mark all live blocks transitively reachable from the roots.
+ *
+ *  This function performs the marking phase of garbage collection by:
+ *    - Abandoning any incremental cycle in progress (MEM_gcStep()).
+ *    - Collecting the writable segments of every loaded object via
+ *      MEM_gcCollectRoots(); thread stack bounds are cached at registration.
+ *    - Starting the worker pool threads (MEM_gcPoolStart()).
+ *    - Calling MEM_setInitialMarks() to clear previous marks.
+ *    - Saving the caller's registers with getcontext(), which, unlike
+ *      setjmp(), stores the frame and stack pointers unmangled.
+ *    - Stopping every other registered thread with MEM_gcStopWorld().
+ *    - Waking the pool workers, which steal from the collector's stack.
+ *    - Conservatively scanning the context, the live part of each registered
+ *      stack and the global segments; every word referencing a live heap or
+ *      mmap payload marks that block and pushes it on the mark stack.
+ *    - Draining the mark stacks in parallel, each worker scanning marked
+ *      payloads and stealing when its own stack runs dry, so everything
+ *      reachable through heap objects is marked.
+ *    - On mark stack overflow, rescanning all marked blocks serially until
+ *      no entry was dropped.
+ *    - Restarting the world with MEM_gcStartWorld().
+ *    - Marking the mmap metadata headers so the sweep keeps them.
+ *
+ *  Unregistered threads are neither stopped nor scanned.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: All reachable blocks marked successfully.
+ *  @retval -EINVAL:      @p allocator is NULL.
+ *  @retval -ENOMEM:      A bitmap or the mmap index could not be grown.
+ * ========================================================================== */
+static int MEM_gcMark(mem_allocator_t *const allocator)
+{
+  int ret = EXIT_SUCCESS;
+
+  gc_mark_stack_t *stack    = (gc_mark_stack_t *)NULL;
+  gc_registry_t   *registry = (gc_registry_t *)NULL;
+  gc_pool_t       *pool     = (gc_pool_t *)NULL;
+
+  block_header_t *meta_data = (block_header_t *)NULL;
+  mmap_t         *map       = (mmap_t *)NULL;
+
+  uint32_t iterator = 0u;
+  uint32_t rescans  = 0u;
+
+  size_t stack_bytes = 0u;
+
+  ucontext_t registers;
+
+  if (UNLIKELY(allocator == NULL))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid parameters: allocator: %p. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              ret);
+    goto function_output;
+  }
+
+  pool     = &allocator->gc_pool;
+  stack    = &pool->workers[0].stack;
+  registry = &allocator->gc_registry;
+
+  MEM_gcStatsBegin(allocator, MEM_GC_KIND_FULL);
+
+  allocator->gc_incr.phase = GC_INCR_IDLE;
+
+  MEM_gcCollectRoots(allocator);
+  MEM_gcPoolStart(allocator);
+
+  ret = MEM_setInitialMarks(allocator);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  for (iterator = 0u; iterator < pool->active; ++iterator)
+  {
+    pool->workers[iterator].stack.len      = 0u;
+    pool->workers[iterator].stack.overflow = false;
+  }
+
+  MEM_memset(&registers, 0, sizeof(registers));
+  (void)getcontext(&registers);
+
+  MEM_gcStopWorld(allocator);
+  MEM_gcPoolBegin(allocator, GC_PHASE_MARK);
+
+  stack_bytes = MEM_gcScanRoots(allocator, &registers);
+
+  MEM_gcMarkWorker(allocator, &pool->workers[0]);
+  MEM_gcPoolWait(allocator);
+
+  for (iterator = 1u; iterator < pool->active; ++iterator)
+  {
+    if (pool->workers[iterator].stack.overflow)
+      stack->overflow = true;
+  }
+
+  while (stack->overflow)
+  {
+    stack->overflow = false;
+    ++rescans;
+    MEM_gcRescan(allocator);
+  }
+
+  MEM_gcStartWorld(allocator);
+
+  LOG_INFO("GC roots: %zu stack bytes | %u segments | %u workers.\n",
+           stack_bytes,
+           registry->num_roots,
+           pool->active);
+
+  if (rescans > 0u)
+  {
+    LOG_WARNING("Mark stack overflow (%zu entries); %u heap rescans.\n",
+                stack->cap,
+                rescans);
+  }
+
+  for (map = allocator->mmap_list; map; map = map->next)
+  {
+    meta_data = (block_header_t *)((uintptr_t)map - sizeof(block_header_t));
+
+    (void)MEM_gcSetMark(allocator, meta_data);
+  }
+
+  allocator->gc_stats.current.mark_ns
+    = MEM_gcClockNs( ) - allocator->gc_stats.start_ns;
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Reclaim any unmarked blocks from heap and mmap regions.
+ *
+ *  This function performs the “sweep” phase of garbage collection:
+ *    - It walks the heap one bitmap word at a time:
+ *        • Candidates are start_bits & ~mark_bits, i.e. blocks that were
+ *          allocated when the cycle began but were not reached.
+ *        • Each candidate still allocated starts a MEM_gcSweepRun(), which
+ *          frees it with its dead and free neighbours as one free block,
+ *          inserted once. The heap top is trimmed once, at the end
+ *          (MEM_shrinkTail()), rather than by each free.
+ *        • Surviving block headers are neither read nor written, and words
+ *          with no candidates are skipped without touching the heap.
+ *        • With several workers, the bitmap is split into one contiguous
+ *          word range per worker; each collects its candidates in parallel
+ *          (MEM_gcSweepCollect()) and the lists are then swept in address
+ *          order on the caller. A partition whose list overflowed is swept
+ *          serially instead.
+ *    - It then traverses allocator->mmap_list via a pointer-to-pointer scan:
+ *        • Logs each mmap’d region’s status.
+ *        • If an mmap’d block is unmarked and not already free, unlinks
+ *          the mmap_t node, calls munmap() on the region, and frees its
+ *          metadata header via MEM_freeOp().
+ *        • Otherwise, clears the block’s marked flag and advances to the next
+ * node.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: All unreachable blocks reclaimed successfully.
+ *  @retval -EINVAL:      @p allocator is NULL.
+ *  @retval ret<0:        Errors returned by MEM_freeOp(),
+ *                        munmap(), or internal validation functions.
+ * ========================================================================== */
+static int MEM_gcSweep(mem_allocator_t *const allocator)
+{
+  int ret = EXIT_SUCCESS;
+
+  block_header_t *block = (block_header_t *)NULL;
+  block_header_t *head  = (block_header_t *)NULL;
+  block_header_t *top   = (block_header_t *)NULL;
+
+  gc_pool_t       *pool   = (gc_pool_t *)NULL;
+  gc_worker_t     *worker = (gc_worker_t *)NULL;
+  gc_mark_stack_t *stack  = (gc_mark_stack_t *)NULL;
+
+  uint64_t start = 0u;
+
+  size_t index = 0u;
+  size_t words = 0u;
+  size_t chunk = 0u;
+
+  uint32_t id = 0u;
+
+  if (UNLIKELY(allocator == NULL))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid parameters: allocator: %p. "
+              "Error code: %d.\n",
+              (void *)allocator,
+              ret);
+    goto function_output;
+  }
+
+  pool  = &allocator->gc_pool;
+  start = MEM_gcClockNs( );
+
+  words = allocator->mark_bits.used_words;
+  if (allocator->start_bits.used_words < words)
+    words = allocator->start_bits.used_words;
+
+  if (pool->active < 2u)
+  {
+    top = MEM_gcSweepWords(allocator, 0u, words);
+    goto sweep_maps;
+  }
+
+  chunk = (words + pool->active - 1u) / pool->active;
+
+  for (id = 0u; id < pool->active; ++id)
+  {
+    worker = &pool->workers[id];
+
+    worker->first = (id * chunk < words) ? id * chunk : words;
+    worker->last  = (worker->first + chunk < words) ? worker->first + chunk
+                                                    : words;
+
+    worker->stack.len      = 0u;
+    worker->stack.overflow = false;
+  }
+
+  MEM_gcPoolBegin(allocator, GC_PHASE_SWEEP);
+  MEM_gcSweepCollect(allocator, &pool->workers[0]);
+  MEM_gcPoolWait(allocator);
+
+  for (id = 0u; id < pool->active; ++id)
+  {
+    worker = &pool->workers[id];
+    stack  = &worker->stack;
+
+    if (stack->overflow)
+    {
+      head = MEM_gcSweepWords(allocator, worker->first, worker->last);
+      if (head != NULL)
+        top = head;
+
+      stack->overflow = false;
+      stack->len      = 0u;
+      continue;
+    }
+
+    for (index = 0u; index < stack->len; ++index)
+    {
+      block = stack->items[index];
+      if ((uint8_t *)block >= allocator->heap_end)
+        break;
+
+      if (block->free || block->magic != MAGIC_NUMBER)
+        continue;
+
+      head = MEM_gcSweepRun(allocator, block);
+      if ((uint8_t *)head + head->size == allocator->heap_end)
+        top = head;
+    }
+
+    stack->len = 0u;
+  }
+
+sweep_maps:
+  if (top != NULL)
+    (void)MEM_shrinkTail(allocator, top);
+
+  MEM_gcSweepMaps(allocator);
+
+  allocator->gc_stats.current.sweep_ns += MEM_gcClockNs( ) - start;
+  MEM_gcStatsEnd(allocator);
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Unmaps the mmap blocks left unmarked by the mark phase.
+ *
+ *  Traverses allocator->mmap_list via a pointer-to-pointer scan. An mmap'd
+ *  block that is unmarked and not already free is released with
+ *  MEM_gcFreeMap(); the others get their mark cleared, unless generational
+ *  mode keeps it to flag them old.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+static void MEM_gcSweepMaps(mem_allocator_t *const allocator)
+{
+  block_header_t *block = (block_header_t *)NULL;
+
+  mmap_t  *map  = (mmap_t *)NULL;
+  mmap_t **scan = (mmap_t **)NULL;
+
+  scan = &allocator->mmap_list;
+  while (*scan)
+  {
+    map   = *scan;
+    block = (block_header_t *)map->addr;
+
+    LOG_INFO("Block Sweep(mmap): block %p (%zu bytes). "
+             "free=%u | marked=%u.\n",
+             (void *)((uint8_t *)block + sizeof(block_header_t)),
+             map->size,
+             block->free,
+             block->marked);
+
+    if (!block->marked && !block->free)
+    {
+      MEM_gcFreeMap(allocator, scan);
+    }
+    else
+    {
+      if (allocator->gc_gen.full_every == 0u)
+        block->marked = 0;
+
+      scan = &map->next;
+    }
+  }
+}
+
+/** ============================================================================
+ *  @brief  Unlinks and unmaps an unreachable mmap block.
+ *
+ *  Removes the mmap_t node @p scan points to from allocator->mmap_list,
+ *  releases the tag accounting and the mapping, then frees the node with
+ *  MEM_freeOp().
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  scan      Link in allocator->mmap_list pointing to the block.
+ * ========================================================================== */
+static void MEM_gcFreeMap(mem_allocator_t *const allocator,
+                          mmap_t **const         scan)
+{
+  block_header_t *block = (block_header_t *)NULL;
+
+  mmap_t *map = (mmap_t *)NULL;
+
+  map   = *scan;
+  block = (block_header_t *)map->addr;
+
+  *scan = map->next;
+
+  LOG_INFO("Sweep Free(mmap): block %p (%zu bytes).\n",
+           (void *)((uint8_t *)block + sizeof(block_header_t)),
+           map->size);
+
+  (void)MEM_tagAccount(allocator, block, false);
+
+  allocator->limits.mapped_bytes -= map->size;
+
+  ++allocator->gc_stats.current.blocks_freed;
+  allocator->gc_stats.current.bytes_freed += map->size;
+
+  munmap(map->addr, map->size);
+  MEM_freeOp(allocator, (void *)map, __FILE__, __LINE__);
+}
+
+/** ============================================================================
+ *  @brief  Keeps the GC tables in step with the heap during an incremental
+ *          cycle.
+ *
+ *  Called by MEM_allocOp() and MEM_freeOp() for every block that changes
+ *  state. Outside GC_INCR_IDLE, an allocated block is marked at once, so
+ *  the cycle keeps it and scans it when tracing ends; a freed block loses
+ *  its start and mark bits, or its mmap index entry, so stale mark stack
+ *  entries and interior pointers into it are ignored. The bitmaps are grown
+ *  when the heap did. Between collections in generational mode, the same
+ *  bookkeeping runs, except that new blocks are left unmarked (young).
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  block     Block header.
+ *  @param[in]  allocated true on allocation, false on release.
+ * ========================================================================== */
+static void MEM_gcTrack(mem_allocator_t *const allocator,
+                        block_header_t *const  block,
+                        const bool             allocated)
+{
+  gc_map_index_t *index = (gc_map_index_t *)NULL;
+  gc_gen_t       *gen   = (gc_gen_t *)NULL;
+
+  uint64_t mask = 0u;
+
+  size_t granule  = 0u;
+  size_t word     = 0u;
+  size_t iterator = 0u;
+
+  bool young = false;
+
+  gen = &allocator->gc_gen;
+
+  if (LIKELY(allocator->gc_incr.phase == GC_INCR_IDLE))
+  {
+    if (LIKELY(!gen->valid))
+      goto function_output;
+
+    young = true;
+  }
+
+  if ((uintptr_t)block < allocator->start_bits.base
+      || (uint8_t *)block >= allocator->heap_end)
+  {
+    if (allocated)
+    {
+      block->marked = young ? 0u : 1u;
+      goto function_output;
+    }
+
+    index = &allocator->map_index;
+    for (iterator = 0u; iterator < index->len; ++iterator)
+    {
+      if (index->ranges[iterator].block == block)
+        break;
+    }
+
+    if (iterator == index->len)
+      goto function_output;
+
+    for (--index->len; iterator < index->len; ++iterator)
+      index->ranges[iterator] = index->ranges[iterator + 1u];
+
+    goto function_output;
+  }
+
+  granule = ((uintptr_t)block - allocator->start_bits.base) / GC_GRANULE;
+  word    = granule / GC_BITS_PER_WORD;
+  mask    = (uint64_t)1u << (granule % GC_BITS_PER_WORD);
+
+  if (word >= allocator->start_bits.used_words
+      || word >= allocator->mark_bits.used_words)
+  {
+    if (MEM_gcBitmapGrow(allocator, &allocator->start_bits) != EXIT_SUCCESS
+        || MEM_gcBitmapGrow(allocator, &allocator->mark_bits) != EXIT_SUCCESS)
+    {
+      allocator->gc_incr.phase = GC_INCR_IDLE;
+      gen->valid               = false;
+      LOG_WARNING("GC bitmaps cannot cover the heap; "
+                  "incremental or generational cycle abandoned.\n");
+      goto function_output;
+    }
+  }
+
+  if (allocated && young)
+  {
+    allocator->start_bits.words[word] |= mask;
+    allocator->mark_bits.words[word]  &= ~mask;
+
+    if (word < gen->young_lo)
+      gen->young_lo = word;
+    if (word >= gen->young_hi)
+      gen->young_hi = word + 1u;
+  }
+  else if (allocated)
+  {
+    allocator->start_bits.words[word] |= mask;
+    allocator->mark_bits.words[word]  |= mask;
+  }
+  else
+  {
+    allocator->start_bits.words[word] &= ~mask;
+    allocator->mark_bits.words[word]  &= ~mask;
+  }
+
+function_output:
+  return;
+}
+
+/** ============================================================================
+ *  @brief  Reads CLOCK_MONOTONIC in nanoseconds.
+ *
+ *  @return Current time.
+ * ========================================================================== */
+static uint64_t MEM_gcClockNs(void)
+{
+  struct timespec now = { 0 };
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return (uint64_t)now.tv_sec * NSEC_PER_SEC + (uint64_t)now.tv_nsec;
+}
+
+/** ============================================================================
+ *  @brief  Clears the soft-dirty bits of every page of the process.
+ *
+ *  Writes "4" to /proc/self/clear_refs. The kernel write-protects every
+ *  page again, so the next write to each one sets its soft-dirty bit.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Bits cleared.
+ *  @retval ret<0:        Negated errno of open() or write().
+ * ========================================================================== */
+static int MEM_gcDirtyClear(void)
+{
+  int ret = EXIT_SUCCESS;
+  int fd  = -1;
+
+  fd = open(CLEAR_REFS_PATH, O_WRONLY | O_CLOEXEC);
+  if (fd < 0)
+  {
+    ret = -errno;
+    goto function_output;
+  }
+
+  if (write(fd, "4", 1u) != 1)
+    ret = -errno;
+
+  close(fd);
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Tells whether soft-dirty page tracking works, probing it once.
+ *
+ *  Kernels built without CONFIG_MEM_SOFT_DIRTY, and some sandboxes, accept
+ *  clear_refs but never set the bit. The probe clears the bits of a page
+ *  of its own, writes it and checks that pagemap reports the write; the
+ *  result is kept in gc_incr.dirty. Tracking forbidden by
+ *  MEM_gcSetDirtyTracking() is reported unavailable without probing.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return true when clear_refs and pagemap report page writes and
+ *          tracking is allowed.
+ * ========================================================================== */
+static bool MEM_gcDirtyProbe(mem_allocator_t *const allocator)
+{
+  void *area = MAP_FAILED;
+
+  volatile uint8_t *probe = (volatile uint8_t *)NULL;
+
+  uint64_t before = 0u;
+  uint64_t after  = 0u;
+
+  size_t page = 0u;
+
+  int fd = -1;
+
+  if (LIKELY(allocator->gc_incr.dirty != GC_DIRTY_UNPROBED)
+      || allocator->gc_incr.dirty_off)
+    goto function_output;
+
+  allocator->gc_incr.dirty = GC_DIRTY_NONE;
+
+  page  = (size_t)sysconf(_SC_PAGESIZE);
+  area  = mmap(NULL,
+              page,
+              PROT_READ | PROT_WRITE,
+              MAP_PRIVATE | MAP_ANONYMOUS,
+              -1,
+              0);
+  if (area == MAP_FAILED)
+    goto function_output;
+
+  probe = (volatile uint8_t *)area;
+
+  fd = open(PAGEMAP_PATH, O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    goto unmap_probe;
+
+  probe[0] = 1u;
+  if (MEM_gcDirtyClear( ) != EXIT_SUCCESS)
+    goto close_fd;
+
+  if (pread(fd,
+            &before,
+            sizeof(before),
+            (off_t)((uintptr_t)probe / page * sizeof(uint64_t)))
+      != (ssize_t)sizeof(before))
+    goto close_fd;
+
+  probe[0] = 2u;
+
+  if (pread(fd,
+            &after,
+            sizeof(after),
+            (off_t)((uintptr_t)probe / page * sizeof(uint64_t)))
+      != (ssize_t)sizeof(after))
+    goto close_fd;
+
+  if (!(before & GC_PM_SOFT_DIRTY) && (after & GC_PM_SOFT_DIRTY))
+    allocator->gc_incr.dirty = GC_DIRTY_SOFT;
+
+close_fd:
+  close(fd);
+unmap_probe:
+  munmap(area, page);
+
+  LOG_INFO("Soft-dirty page tracking %s.\n",
+           (allocator->gc_incr.dirty == GC_DIRTY_SOFT) ? "available"
+                                                       : "unavailable");
+function_output:
+  return !allocator->gc_incr.dirty_off
+      && allocator->gc_incr.dirty == GC_DIRTY_SOFT;
+}
+
+/** ============================================================================
+ *  @brief  Rescans the part of the marked heap blocks lying in a range.
+ *
+ *  Starts from the nearest block start at or below @p lo in start_bits, so
+ *  a block reaching into the range from an earlier page is included, then
+ *  walks the block starts up to @p hi. Only marked blocks are scanned, and
+ *  only the part of their payload inside the range.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  lo        Range start (a dirty page).
+ *  @param[in]  hi        Range end.
+ * ========================================================================== */
+static void MEM_gcDirtyHeap(mem_allocator_t *const allocator,
+                            const uintptr_t        lo,
+                            const uintptr_t        hi)
+{
+  gc_bitmap_t     *starts = (gc_bitmap_t *)NULL;
+  gc_bitmap_t     *marks  = (gc_bitmap_t *)NULL;
+  gc_mark_stack_t *stack  = (gc_mark_stack_t *)NULL;
+
+  block_header_t *block = (block_header_t *)NULL;
+
+  uintptr_t first = 0u;
+  uintptr_t last  = 0u;
+
+  uint64_t word = 0u;
+
+  size_t granule = 0u;
+  size_t end     = 0u;
+  size_t index   = 0u;
+  size_t bit     = 0u;
+
+  starts = &allocator->start_bits;
+  marks  = &allocator->mark_bits;
+  stack  = &allocator->gc_pool.workers[0].stack;
+
+  granule = (lo - starts->base) / GC_GRANULE;
+  end     = (hi - starts->base + GC_GRANULE - 1u) / GC_GRANULE;
+  index   = granule / GC_BITS_PER_WORD;
+  bit     = granule % GC_BITS_PER_WORD;
+
+  word = starts->words[index];
+  if (bit != GC_BITS_PER_WORD - 1u)
+    word &= ((uint64_t)1u << (bit + 1u)) - 1u;
+
+  while (word == 0u && index > 0u)
+    word = starts->words[--index];
+
+  if (word != 0u)
+    granule = index * GC_BITS_PER_WORD + GC_BITS_PER_WORD - 1u
+            - (size_t)(unsigned)__builtin_clzll(word);
+
+  for (index = granule / GC_BITS_PER_WORD; index * GC_BITS_PER_WORD < end;
+       ++index)
+  {
+    if (index >= starts->used_words || index >= marks->used_words)
+      break;
+
+    word = starts->words[index] & marks->words[index];
+    if (index == granule / GC_BITS_PER_WORD)
+      word &= ~(((uint64_t)1u << (granule % GC_BITS_PER_WORD)) - 1u);
+
+    while (word != 0u)
+    {
+      bit   = (size_t)(unsigned)__builtin_ctzll(word);
+      word &= word - 1u;
+
+      if (index * GC_BITS_PER_WORD + bit >= end)
+        break;
+
+      block = (block_header_t *)(starts->base
+                                 + (index * GC_BITS_PER_WORD + bit)
+                                     * GC_GRANULE);
+
+      first = (uintptr_t)block + sizeof(block_header_t);
+      last  = (uintptr_t)block + block->size - sizeof(uintptr_t);
+
+      if (first < lo)
+        first = lo;
+      if (last > hi)
+        last = hi;
+
+      if (first < last)
+        MEM_gcScanPayload(allocator, stack, block, first, last);
+    }
+  }
+
+  MEM_gcDrain(allocator, stack);
+}
+
+/** ============================================================================
+ *  @brief  Rescans the soft-dirty pages of a range.
+ *
+ *  Reads the pagemap entries of the range GC_PAGEMAP_CHUNK at a time and
+ *  rescans the part of the range on each soft-dirty page: the marked heap
+ *  blocks there (MEM_gcDirtyHeap()), or the mmap payload of @p owner.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  fd        Open /proc/self/pagemap.
+ *  @param[in]  lo        Range start.
+ *  @param[in]  hi        Range end.
+ *  @param[in]  owner     NULL for the sbrk heap, else the mmap block whose
+ *                        payload the range is.
+ *  @param[out] pages     Incremented by the dirty pages rescanned.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Range rescanned.
+ *  @retval -EIO:         pagemap could not be read.
+ * ========================================================================== */
+static int MEM_gcDirtyRange(mem_allocator_t *const allocator,
+                            const int              fd,
+                            const uintptr_t        lo,
+                            const uintptr_t        hi,
+                            block_header_t *const  owner,
+                            size_t *const          pages)
+{
+  int ret = EXIT_SUCCESS;
+
+  gc_mark_stack_t *stack = (gc_mark_stack_t *)NULL;
+
+  uint64_t entries[GC_PAGEMAP_CHUNK];
+
+  uintptr_t page_lo = 0u;
+  uintptr_t first   = 0u;
+  uintptr_t last    = 0u;
+
+  size_t page     = 0u;
+  size_t count    = 0u;
+  size_t iterator = 0u;
+
+  stack = &allocator->gc_pool.workers[0].stack;
+  page  = (size_t)sysconf(_SC_PAGESIZE);
+
+  for (page_lo = lo & ~(uintptr_t)(page - 1u); page_lo < hi;
+       page_lo += count * page)
+  {
+    count = (hi - page_lo + page - 1u) / page;
+    if (count > GC_PAGEMAP_CHUNK)
+      count = GC_PAGEMAP_CHUNK;
+
+    if (pread(fd,
+              entries,
+              count * sizeof(uint64_t),
+              (off_t)(page_lo / page * sizeof(uint64_t)))
+        != (ssize_t)(count * sizeof(uint64_t)))
+    {
+      ret = -EIO;
+      LOG_WARNING("Cannot read %s; falling back to a full rescan.\n",
+                  PAGEMAP_PATH);
+      goto function_output;
+    }
+
+    for (iterator = 0u; iterator < count; ++iterator)
+    {
+      if (!(entries[iterator] & GC_PM_SOFT_DIRTY))
+        continue;
+
+      first = page_lo + iterator * page;
+      last  = first + page;
+
+      if (first < lo)
+        first = lo;
+      if (last > hi)
+        last = hi;
+
+      ++*pages;
+
+      if (owner == NULL)
+      {
+        MEM_gcDirtyHeap(allocator, first, last);
+      }
+      else
+      {
+        MEM_gcScanPayload(allocator, stack, owner, first, last);
+        MEM_gcDrain(allocator, stack);
+      }
+    }
+  }
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Rescans the marked blocks on pages written since the cycle began.
+ *
+ *  Must run with the world stopped. Any pointer a mutator stored into a
+ *  block the collector had already traced lies on a page written after
+ *  MEM_gcIncrBegin() cleared the soft-dirty bits, so rescanning those pages
+ *  of the heap and of the marked mmap payloads completes the mark.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[out] pages     Number of dirty pages rescanned.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Dirty pages rescanned.
+ *  @retval ret<0:        pagemap could not be opened or read.
+ * ========================================================================== */
+static int MEM_gcRemarkDirty(mem_allocator_t *const allocator,
+                             size_t *const          pages)
+{
+  int ret = EXIT_SUCCESS;
+  int fd  = -1;
+
+  block_header_t *block = (block_header_t *)NULL;
+  mmap_t         *map   = (mmap_t *)NULL;
+
+  uintptr_t heap_hi = 0u;
+
+  *pages = 0u;
+
+  fd = open(PAGEMAP_PATH, O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+  {
+    ret = -errno;
+    goto function_output;
+  }
+
+  heap_hi = allocator->start_bits.base
+          + allocator->start_bits.used_words * GC_BITS_PER_WORD * GC_GRANULE;
+  if (heap_hi > (uintptr_t)allocator->heap_end)
+    heap_hi = (uintptr_t)allocator->heap_end;
+
+  if (heap_hi > allocator->start_bits.base)
+  {
+    ret = MEM_gcDirtyRange(allocator,
+                           fd,
+                           allocator->start_bits.base,
+                           heap_hi,
+                           (block_header_t *)NULL,
+                           pages);
+    if (ret != EXIT_SUCCESS)
+      goto close_fd;
+  }
+
+  for (map = allocator->mmap_list; map; map = map->next)
+  {
+    block = (block_header_t *)map->addr;
+    if (!MEM_gcIsMarked(allocator, block) || block->free)
+      continue;
+
+    ret = MEM_gcDirtyRange(allocator,
+                           fd,
+                           (uintptr_t)map->addr + sizeof(block_header_t),
+                           (uintptr_t)map->addr + map->size - sizeof(uintptr_t),
+                           block,
+                           pages);
+    if (ret != EXIT_SUCCESS)
+      goto close_fd;
+  }
+
+close_fd:
+  close(fd);
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Starts an incremental cycle.
+ *
+ *  Clears the marks, indexes the heap and mmap blocks, then stops the world
+ *  only to scan the roots onto the collector's mark stack and to clear the
+ *  soft-dirty bits, when the kernel has them.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: Cycle started.
+ *  @retval -ENOMEM:      A bitmap or the mmap index could not be grown.
+ * ========================================================================== */
+static int MEM_gcIncrBegin(mem_allocator_t *const allocator)
+{
+  int ret = EXIT_SUCCESS;
+
+  gc_mark_stack_t *stack = (gc_mark_stack_t *)NULL;
+
+  size_t stack_bytes = 0u;
+
+  ucontext_t registers;
+
+  stack = &allocator->gc_pool.workers[0].stack;
+
+  MEM_gcStatsBegin(allocator, MEM_GC_KIND_INCREMENTAL);
+
+  MEM_gcCollectRoots(allocator);
+
+  ret = MEM_setInitialMarks(allocator);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  stack->len      = 0u;
+  stack->overflow = false;
+
+  allocator->gc_incr.phase      = GC_INCR_MARK;
+  allocator->gc_incr.sweep_word = 0u;
+  allocator->gc_gen.valid       = false;
+
+  MEM_memset(&registers, 0, sizeof(registers));
+  (void)getcontext(&registers);
+
+  MEM_gcStopWorld(allocator);
+  stack_bytes = MEM_gcScanRoots(allocator, &registers);
+  allocator->gc_incr.tracking
+    = MEM_gcDirtyProbe(allocator) && MEM_gcDirtyClear( ) == EXIT_SUCCESS;
+  MEM_gcStartWorld(allocator);
+
+  LOG_INFO("GC step: cycle started | %zu stack bytes | %u segments | "
+           "dirty tracking %s.\n",
+           stack_bytes,
+           allocator->gc_registry.num_roots,
+           allocator->gc_incr.tracking ? "on" : "off");
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Traces from the mark stack until it is empty or time is up.
+ *
+ *  Runs with mutators going; only gc_lock is held. Entries whose block was
+ *  freed since it was pushed are dropped.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  deadline  CLOCK_MONOTONIC time, in nanoseconds, to stop at.
+ *
+ *  @return true once the mark stack is empty.
+ * ========================================================================== */
+static bool MEM_gcIncrMark(mem_allocator_t *const allocator,
+                           const uint64_t         deadline)
+{
+  gc_mark_stack_t *stack = (gc_mark_stack_t *)NULL;
+
+  block_header_t *block = (block_header_t *)NULL;
+
+  uintptr_t payload = 0u;
+
+  size_t count = 0u;
+
+  stack = &allocator->gc_pool.workers[0].stack;
+
+  do
+  {
+    for (count = 0u; count < GC_STEP_CHECK; ++count)
+    {
+      block = MEM_gcPop(stack);
+      if (block == NULL)
+        return true;
+
+      payload = (uintptr_t)block + sizeof(block_header_t);
+      if (MEM_gcFindBlock(allocator, payload) != block)
+        continue;
+
+      MEM_gcScanPayload(allocator,
+                        stack,
+                        block,
+                        payload,
+                        (uintptr_t)block + block->size - sizeof(uintptr_t));
+    }
+  } while (MEM_gcClockNs( ) < deadline);
+
+  return stack->len == 0u;
+}
+
+/** ============================================================================
+ *  @brief  Ends the tracing of an incremental cycle.
+ *
+ *  With the world stopped, rescans the roots and the marked blocks a
+ *  mutator may have stored a pointer into between steps. With dirty
+ *  tracking, that is only the part of the marked blocks lying on pages
+ *  written since the cycle began (MEM_gcRemarkDirty()); without it, or
+ *  after a mark stack overflow, every marked block is rescanned. Then pins
+ *  the mmap metadata headers and moves the cycle to GC_INCR_SWEEP.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+static void MEM_gcIncrFinish(mem_allocator_t *const allocator)
+{
+  gc_mark_stack_t *stack = (gc_mark_stack_t *)NULL;
+
+  block_header_t *meta_data = (block_header_t *)NULL;
+  mmap_t         *map       = (mmap_t *)NULL;
+
+  uint64_t start = 0u;
+
+  size_t stack_bytes = 0u;
+  size_t pages       = 0u;
+
+  uint32_t rescans = 0u;
+
+  bool full = false;
+
+  ucontext_t registers;
+
+  stack = &allocator->gc_pool.workers[0].stack;
+
+  MEM_gcCollectRoots(allocator);
+
+  MEM_memset(&registers, 0, sizeof(registers));
+  (void)getcontext(&registers);
+
+  start = MEM_gcClockNs( );
+
+  MEM_gcStopWorld(allocator);
+
+  full = !allocator->gc_incr.tracking || stack->overflow;
+
+  stack_bytes = MEM_gcScanRoots(allocator, &registers);
+  MEM_gcDrain(allocator, stack);
+
+  stack->overflow = false;
+  if (!full && MEM_gcRemarkDirty(allocator, &pages) != EXIT_SUCCESS)
+    full = true;
+
+  while (full || stack->overflow)
+  {
+    full            = false;
+    stack->overflow = false;
+    ++rescans;
+    MEM_gcRescan(allocator);
+  }
+
+  MEM_gcStartWorld(allocator);
+
+  for (map = allocator->mmap_list; map; map = map->next)
+  {
+    meta_data = (block_header_t *)((uintptr_t)map - sizeof(block_header_t));
+
+    (void)MEM_gcSetMark(allocator, meta_data);
+  }
+
+  allocator->gc_incr.phase      = GC_INCR_SWEEP;
+  allocator->gc_incr.sweep_word = 0u;
+
+  LOG_INFO("GC step: remark %llu us | %zu stack bytes | %zu dirty pages | "
+           "%u rescans.\n",
+           (unsigned long long)((MEM_gcClockNs( ) - start) / NSEC_PER_USEC),
+           stack_bytes,
+           pages,
+           rescans);
+}
+
+/** ============================================================================
+ *  @brief  Sweeps bitmap words from the cursor until done or time is up.
+ *
+ *  Frees unmarked heap blocks GC_SWEEP_CHUNK words at a time with
+ *  MEM_gcSweepWords(); once the heap is swept, sweeps the mmap blocks and
+ *  ends the cycle.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  deadline  CLOCK_MONOTONIC time, in nanoseconds, to stop at.
+ *
+ *  @return true once the cycle is complete.
+ * ========================================================================== */
+static bool MEM_gcIncrSweep(mem_allocator_t *const allocator,
+                            const uint64_t         deadline)
+{
+  gc_incr_t *incr = (gc_incr_t *)NULL;
+
+  uint64_t start = 0u;
+
+  size_t words = 0u;
+  size_t last  = 0u;
+
+  incr  = &allocator->gc_incr;
+  start = MEM_gcClockNs( );
+
+  for (;;)
+  {
+    words = allocator->mark_bits.used_words;
+    if (allocator->start_bits.used_words < words)
+      words = allocator->start_bits.used_words;
+
+    if (incr->sweep_word >= words)
+      break;
+
+    last = incr->sweep_word + GC_SWEEP_CHUNK;
+    if (last > words)
+      last = words;
+
+    (void)MEM_gcSweepWords(allocator, incr->sweep_word, last);
+    incr->sweep_word = last;
+
+    if (MEM_gcClockNs( ) >= deadline)
+    {
+      allocator->gc_stats.current.sweep_ns += MEM_gcClockNs( ) - start;
+      return false;
+    }
+  }
+
+  MEM_gcSweepMaps(allocator);
+
+  incr->phase = GC_INCR_IDLE;
+
+  allocator->gc_stats.current.sweep_ns += MEM_gcClockNs( ) - start;
+  MEM_gcStatsEnd(allocator);
+
+  return true;
+}
+
+/** ============================================================================
+ *  @brief  Advances the incremental cycle for about @p budget_us.
+ *
+ *  Must be called with gc_lock held. Starts a cycle when none is in
+ *  progress, then traces, finishes tracing and sweeps in turn until the
+ *  budget is spent or the cycle completes. Each call makes some progress,
+ *  even with a zero budget.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  budget_us Time budget, in microseconds.
+ *
+ *  @return EXIT_SUCCESS while the cycle is in progress, MEM_GC_CYCLE_DONE
+ *          when it completed, negative error code on failure.
+ * ========================================================================== */
+static int MEM_gcStepOp(mem_allocator_t *const allocator,
+                        const uint32_t         budget_us)
+{
+  int ret = EXIT_SUCCESS;
+
+  gc_incr_t *incr = (gc_incr_t *)NULL;
+
+  uint64_t deadline = 0u;
+  uint64_t start    = 0u;
+
+  incr     = &allocator->gc_incr;
+  deadline = MEM_gcClockNs( ) + (uint64_t)budget_us * NSEC_PER_USEC;
+
+  if (UNLIKELY(allocator->gc_snap.active))
+  {
+    ret = -EBUSY;
+    goto function_output;
+  }
+
+  do
+  {
+    start = MEM_gcClockNs( );
+
+    if (incr->phase == GC_INCR_IDLE)
+    {
+      ret = MEM_gcIncrBegin(allocator);
+      if (ret != EXIT_SUCCESS)
+        goto function_output;
+
+      allocator->gc_stats.current.mark_ns += MEM_gcClockNs( ) - start;
+    }
+    else if (incr->phase == GC_INCR_MARK)
+    {
+      if (MEM_gcIncrMark(allocator, deadline))
+        MEM_gcIncrFinish(allocator);
+
+      allocator->gc_stats.current.mark_ns += MEM_gcClockNs( ) - start;
+    }
+    else if (MEM_gcIncrSweep(allocator, deadline))
+    {
+      ret = MEM_GC_CYCLE_DONE;
+      goto function_output;
+    }
+  } while (MEM_gcClockNs( ) < deadline);
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Charges an allocation to the mutator assist debt.
+ *
+ *  Does nothing unless assists are enabled and an incremental cycle is in
+ *  progress. Once the debt reaches GC_ASSIST_QUANTUM, the calling thread
+ *  takes gc_lock and runs a step sized by MEM_gcSetAssist().
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  bytes     Bytes just allocated.
+ * ========================================================================== */
+static void MEM_gcAssist(mem_allocator_t *const allocator, const size_t bytes)
+{
+  gc_incr_t *incr = (gc_incr_t *)NULL;
+
+  size_t debt = 0u;
+
+  uint32_t budget_us = 0u;
+
+  incr = &allocator->gc_incr;
+
+  if (LIKELY(__atomic_load_n(&incr->assist, __ATOMIC_RELAXED) == 0u
+             || __atomic_load_n(&incr->phase, __ATOMIC_RELAXED)
+                  == GC_INCR_IDLE))
+    goto function_output;
+
+  debt = __atomic_add_fetch(&incr->debt, bytes, __ATOMIC_RELAXED);
+  if (debt < GC_ASSIST_QUANTUM)
+    goto function_output;
+
+  debt = __atomic_exchange_n(&incr->debt, 0u, __ATOMIC_RELAXED);
+  if (debt == 0u)
+    goto function_output;
+
+  budget_us = (uint32_t)((debt >> 10u) * incr->assist >> 10u);
+
+  pthread_mutex_lock(&allocator->gc_thread.gc_lock);
+
+  if (incr->phase != GC_INCR_IDLE)
+    (void)MEM_gcStepOp(allocator, budget_us);
+
+  pthread_mutex_unlock(&allocator->gc_thread.gc_lock);
+
+function_output:
+  return;
+}
+
+/** ============================================================================
+ *  @brief  Charges an allocation to the GC trigger.
+ *
+ *  Must be called with gc_lock held. Wakes the GC thread when the bytes
+ *  allocated since its last cycle cross the trigger, unless the ratio is 0.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  bytes     Bytes just allocated.
+ * ========================================================================== */
+static void MEM_gcPace(mem_allocator_t *const allocator, const size_t bytes)
+{
+  gc_pace_t *pace = (gc_pace_t *)NULL;
+
+  pace = &allocator->gc_pace;
 
-  uintptr_t pattern = 0u;
+  pace->allocated += bytes;
 
-  size_t iterator = 0u;
+  if (pace->ratio != 0u && pace->allocated >= pace->trigger
+      && pace->allocated - bytes < pace->trigger)
+    pthread_cond_signal(&allocator->gc_thread.gc_cond);
+}
 
-  if (UNLIKELY((source == NULL) || (size <= 0)))
+/** ============================================================================
+ *  @brief  Records the end of a GC thread cycle and sets the next trigger.
+ *
+ *  Must be called with gc_lock held. Sums the live bytes of every tag, sets
+ *  the trigger to @b ratio percent of them (at least GC_MIN_TRIGGER),
+ *  restarts the allocation count and wakes MEM_gcCollect() callers. After
+ *  a lazy-swept cycle, the live bytes still include the unswept garbage.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+static void MEM_gcPaceDone(mem_allocator_t *const allocator)
+{
+  gc_pace_t *pace = (gc_pace_t *)NULL;
+
+  size_t live = 0u;
+
+  pace = &allocator->gc_pace;
+  live = MEM_gcLiveBytes(allocator);
+
+  pace->live_bytes = live;
+  pace->trigger    = live / 100u * pace->ratio;
+  if (pace->trigger < GC_MIN_TRIGGER)
+    pace->trigger = GC_MIN_TRIGGER;
+
+  pace->allocated = 0u;
+  ++pace->cycles;
+
+  pthread_cond_broadcast(&pace->done);
+}
+
+/** ============================================================================
+ *  @brief  Waits, in the GC thread, until the next cycle is due.
+ *
+ *  Must be called with gc_lock held; gc_cond releases it while waiting.
+ *  Returns when the allocation volume reaches the trigger, a collection is
+ *  requested, the thread must exit, or @b idle_ms elapsed. A wake-up by
+ *  volume or request resets @b idle_ms to gc_interval_ms; a timeout with
+ *  nothing allocated doubles it, up to GC_IDLE_MAX_MS.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+static void MEM_gcPaceWait(mem_allocator_t *const allocator)
+{
+  int ret = EXIT_SUCCESS;
+
+  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
+  gc_pace_t   *pace      = (gc_pace_t *)NULL;
+
+  struct timespec deadline = { 0 };
+
+  uint64_t wake_ns = 0u;
+
+  gc_thread = &allocator->gc_thread;
+  pace      = &allocator->gc_pace;
+
+  wake_ns = MEM_gcClockNs( ) + (uint64_t)pace->idle_ms * NSEC_PER_MSEC;
+
+  deadline.tv_sec  = (time_t)(wake_ns / NSEC_PER_SEC);
+  deadline.tv_nsec = (long)(wake_ns % NSEC_PER_SEC);
+
+  while (ret != ETIMEDOUT && !gc_thread->gc_exit && !pace->requested
+         && (pace->ratio == 0u || pace->allocated < pace->trigger))
+    ret = pthread_cond_timedwait(&gc_thread->gc_cond,
+                                 &gc_thread->gc_lock,
+                                 &deadline);
+
+  if (ret != ETIMEDOUT)
+    pace->idle_ms = gc_thread->gc_interval_ms;
+  else if (pace->allocated == 0u)
+    pace->idle_ms = (pace->idle_ms < GC_IDLE_MAX_MS / 2u)
+                    ? pace->idle_ms * 2u
+                    : GC_IDLE_MAX_MS;
+}
+
+/** ============================================================================
+ *  @brief  Sums the live payload bytes of every accounting tag.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return Live bytes of the allocator.
+ * ========================================================================== */
+static size_t MEM_gcLiveBytes(mem_allocator_t *const allocator)
+{
+  mem_tag_stats_t stats = { 0 };
+
+  uint32_t num_tags = 0u;
+  uint32_t iterator = 0u;
+
+  size_t live = 0u;
+
+  num_tags = atomic_load_explicit(&allocator->num_tags, memory_order_acquire);
+  for (iterator = 0u; iterator < num_tags; ++iterator)
   {
-    ret = PTR_ERR(-EINVAL);
-    LOG_ERROR("Invalid arguments: source=%p, size=%zu. "
-              "Error code: %d.\n",
-              source,
-              size,
-              (int)(intptr_t)ret);
-    goto function_output;
+    MEM_tagSum(&allocator->tags[iterator], &stats);
+    live += stats.live_bytes;
   }
 
-  ptr = (unsigned char *)source;
+  return live;
+}
 
-  if ((uintptr_t)ptr % ARCH_ALIGNMENT != 0)
+/** ============================================================================
+ *  @brief  Opens the metrics of a GC cycle. Caller holds gc_lock.
+ *
+ *  Drops any cycle left open, clears the scan and mark counters of every
+ *  worker and samples the live heap.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  kind      How the cycle runs.
+ * ========================================================================== */
+static void MEM_gcStatsBegin(mem_allocator_t *const allocator,
+                             const mem_gc_kind_t    kind)
+{
+  gc_stats_t      *stats = (gc_stats_t *)NULL;
+  gc_mark_stack_t *stack = (gc_mark_stack_t *)NULL;
+
+  uint32_t iterator = 0u;
+
+  stats = &allocator->gc_stats;
+
+  for (iterator = 0u; iterator < MEM_GC_MAX_WORKERS; ++iterator)
   {
-    while ((iterator < size)
-           && ((uintptr_t)(ptr + iterator) % ARCH_ALIGNMENT != 0))
-    {
-      ptr[iterator] = (unsigned char)value;
-      iterator++;
-    }
+    stack          = &allocator->gc_pool.workers[iterator].stack;
+    stack->scanned = 0u;
+    stack->marked  = 0u;
   }
 
-  pattern = ((uintptr_t)(unsigned char)value) * PREFETCH_MULT;
+  MEM_memset(&stats->current, 0, sizeof(stats->current));
 
-  for (; iterator + ARCH_ALIGNMENT <= size; iterator += ARCH_ALIGNMENT)
+  stats->current.seq         = stats->cycles + 1u;
+  stats->current.kind        = kind;
+  stats->current.heap_before = MEM_gcLiveBytes(allocator);
+
+  stats->start_ns = MEM_gcClockNs( );
+  stats->open     = true;
+}
+
+/** ============================================================================
+ *  @brief  Records the GC cycle whose sweep just completed. Caller holds
+ *          gc_lock.
+ *
+ *  Sums the workers' counters, samples the live heap, stores the cycle in
+ *  the ring, adds it to the totals and logs it. Does nothing when no cycle
+ *  is open.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+static void MEM_gcStatsEnd(mem_allocator_t *const allocator)
+{
+  static const char *const kinds[] = {
+    [MEM_GC_KIND_FULL]        = "full",
+    [MEM_GC_KIND_INCREMENTAL] = "incremental",
+    [MEM_GC_KIND_SNAPSHOT]    = "snapshot",
+    [MEM_GC_KIND_MINOR]       = "minor",
+  };
+
+  gc_stats_t      *stats = (gc_stats_t *)NULL;
+  mem_gc_cycle_t  *cycle = (mem_gc_cycle_t *)NULL;
+  gc_mark_stack_t *stack = (gc_mark_stack_t *)NULL;
+
+  uint32_t iterator = 0u;
+
+  stats = &allocator->gc_stats;
+  cycle = &stats->current;
+
+  if (!stats->open)
+    goto function_output;
+
+  for (iterator = 0u; iterator < MEM_GC_MAX_WORKERS; ++iterator)
   {
-    ptr_fetch = ptr + iterator;
-    PREFETCH_W(ptr_fetch + CACHE_LINE_SIZE);
-    word  = (uintptr_t *)ASSUME_ALIGNED(ptr_fetch, ARCH_ALIGNMENT);
-    *word = pattern;
+    stack                 = &allocator->gc_pool.workers[iterator].stack;
+    cycle->bytes_scanned += stack->scanned;
+    cycle->blocks_marked += stack->marked;
   }
 
-  ptr_aux = (unsigned char *)(ptr + iterator);
-  while (iterator < size)
+  cycle->total_ns   = MEM_gcClockNs( ) - stats->start_ns;
+  cycle->heap_after = MEM_gcLiveBytes(allocator);
+
+  stats->ring[stats->cycles % MEM_GC_STATS_RING] = *cycle;
+
+  ++stats->cycles;
+  stats->gc_ns    += cycle->mark_ns + cycle->sweep_ns;
+  stats->pause_ns += cycle->pause_ns;
+  if (cycle->max_pause_ns > stats->max_pause_ns)
+    stats->max_pause_ns = cycle->max_pause_ns;
+
+  stats->open = false;
+
+  LOG_INFO("GC cycle %llu (%s): %llu us | mark %llu us | sweep %llu us | "
+           "pause %llu us (max %llu us) | %llu bytes scanned | "
+           "%llu marked | %llu freed (%llu bytes) | live %zu -> %zu.\n",
+           (unsigned long long)cycle->seq,
+           kinds[cycle->kind],
+           (unsigned long long)(cycle->total_ns / NSEC_PER_USEC),
+           (unsigned long long)(cycle->mark_ns / NSEC_PER_USEC),
+           (unsigned long long)(cycle->sweep_ns / NSEC_PER_USEC),
+           (unsigned long long)(cycle->pause_ns / NSEC_PER_USEC),
+           (unsigned long long)(cycle->max_pause_ns / NSEC_PER_USEC),
+           (unsigned long long)cycle->bytes_scanned,
+           (unsigned long long)cycle->blocks_marked,
+           (unsigned long long)cycle->blocks_freed,
+           (unsigned long long)cycle->bytes_freed,
+           cycle->heap_before,
+           cycle->heap_after);
+
+function_output:
+  return;
+}
+
+/** ============================================================================
+ *  @brief  Sweeps the next GC_SWEEP_CHUNK bitmap words for an allocation.
+ *
+ *  Must be called with gc_lock held. Does nothing unless lazy sweeping is
+ *  enabled and the GC thread left a marked heap in GC_INCR_SWEEP. The
+ *  allocator calls it once per heap allocation, so the sweep advances with
+ *  the allocation rate, then again while no free block fits the request.
+ *  Once the cursor reaches the end of the bitmaps, the mmap blocks are
+ *  swept and the cycle ends.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return true if words were swept and a free-list search may now succeed,
+ *          false when no lazy sweep is pending.
+ * ========================================================================== */
+static bool MEM_gcLazySweep(mem_allocator_t *const allocator)
+{
+  gc_incr_t *incr = (gc_incr_t *)NULL;
+
+  uint64_t start = 0u;
+
+  size_t words = 0u;
+  size_t last  = 0u;
+
+  bool swept = false;
+
+  incr = &allocator->gc_incr;
+
+  if (LIKELY(!incr->lazy || incr->phase != GC_INCR_SWEEP))
+    goto function_output;
+
+  start = MEM_gcClockNs( );
+
+  words = allocator->mark_bits.used_words;
+  if (allocator->start_bits.used_words < words)
+    words = allocator->start_bits.used_words;
+
+  if (incr->sweep_word < words)
   {
-    *ptr_aux++ = (unsigned char)value;
-    iterator++;
+    last = incr->sweep_word + GC_SWEEP_CHUNK;
+    if (last > words)
+      last = words;
+
+    (void)MEM_gcSweepWords(allocator, incr->sweep_word, last);
+    incr->sweep_word = last;
+
+    allocator->gc_stats.current.sweep_ns += MEM_gcClockNs( ) - start;
+
+    swept = true;
+    goto function_output;
   }
 
-  ret = source;
-  LOG_INFO("Memory set: source=%p, value=0x%X, size=%zu.\n",
-           source,
-           (unsigned int)value,
-           size);
+  MEM_gcSweepMaps(allocator);
+
+  incr->phase = GC_INCR_IDLE;
+
+  allocator->gc_stats.current.sweep_ns += MEM_gcClockNs( ) - start;
+  MEM_gcStatsEnd(allocator);
+
+  LOG_INFO("GC lazy sweep: %zu words swept by allocations.\n", words);
 
 function_output:
-  return ret;
+  return swept;
 }
 
 /** ============================================================================
- *  @brief  Copies a memory block between buffers using optimized operations.
+ *  @brief  Forks a child that marks a copy-on-write snapshot of the heap.
  *
- *  This function copies `size` bytes from the source buffer to the destination
- *  buffer. It first advances the destination pointer to meet the architecture’s
- *  alignment requirements, then copies data in ARCH_ALIGNMENT-sized chunks
- *  using 64-bit loads and stores, with prefetch hints for both source and
- *  destination cache lines. Any remaining bytes at the end are copied.
+ *  Abandons any incremental cycle, sizes the bitmaps for the current heap
+ *  and maps the report shared with the child. The world is stopped only
+ *  around fork(): the child inherits the heap and every parked stack as
+ *  they were at that instant, and indexes and marks them in
+ *  MEM_gcSnapMark() while the parent's mutators run on.
  *
- *  @param[in]  dest  Destination buffer pointer.
- *  @param[in]  src   Source buffer pointer.
- *  @param[in]  size  Number of bytes to copy.
+ *  @param[in]  allocator Memory allocator context.
  *
- *  @return Original dest pointer on success,
- *          an error-encoded pointer (via PTR_ERR()) on failure.
+ *  @return Integer status code.
  *
- *  @retval dest:     Original Pointer on successful operation.
- *  @retval -EINVAL:  Invalid @p src or @p size.
+ *  @retval EXIT_SUCCESS: Child marking.
+ *  @retval -ENOMEM:      The bitmaps or the report could not be mapped.
+ *  @retval ret<0:        Negated errno of fork().
  * ========================================================================== */
-void *MEM_memcpy(void *const dest, const void *src, const size_t size)
+static int MEM_gcSnapBegin(mem_allocator_t *const allocator)
 {
-  void *ret = (void *)NULL;
+  int ret = EXIT_SUCCESS;
 
-  unsigned char       *destine      = (unsigned char *)NULL;
-  unsigned char       *destine_aux  = (unsigned char *)NULL;
-  unsigned char       *dest_fetch   = (unsigned char *)NULL;
-  const unsigned char *source       = (const unsigned char *)NULL;
-  const unsigned char *source_fetch = (const unsigned char *)NULL;
+  gc_snap_t *snap = (gc_snap_t *)NULL;
 
-  uintptr_t       *dest_word = (uintptr_t *)NULL;
-  const uintptr_t *src_word  = (const uintptr_t *)NULL;
+  void *area = (void *)NULL;
 
-  size_t iterator = 0u;
+  uint64_t start = 0u;
 
-  if (UNLIKELY((dest == NULL) || (src == NULL) || (size <= 0)))
+  size_t words = 0u;
+  size_t size  = 0u;
+  size_t page  = 0u;
+
+  pid_t child = 0;
+
+  ucontext_t registers;
+
+  snap = &allocator->gc_snap;
+
+  MEM_gcStatsBegin(allocator, MEM_GC_KIND_SNAPSHOT);
+
+  allocator->gc_incr.phase = GC_INCR_IDLE;
+
+  MEM_gcCollectRoots(allocator);
+
+  ret = MEM_gcBitmapGrow(allocator, &allocator->start_bits);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  ret = MEM_gcBitmapGrow(allocator, &allocator->mark_bits);
+  if (ret != EXIT_SUCCESS)
+    goto function_output;
+
+  words = allocator->mark_bits.used_words;
+  if (allocator->start_bits.used_words < words)
+    words = allocator->start_bits.used_words;
+
+  page = (size_t)sysconf(_SC_PAGESIZE);
+  size = sizeof(gc_snap_report_t) + words * sizeof(uint64_t);
+  size = (size + page - 1u) & ~(page - 1u);
+
+  area = mmap(NULL,
+              size,
+              PROT_READ | PROT_WRITE,
+              MAP_SHARED | MAP_ANONYMOUS,
+              -1,
+              0);
+  if (area == MAP_FAILED)
   {
-    ret = PTR_ERR(-EINVAL);
-    LOG_ERROR("Invalid arguments: dest=%p, src=%p, size=%zu. "
+    ret = -ENOMEM;
+    LOG_ERROR("Failed to map the GC snapshot report (%zu bytes). "
               "Error code: %d.\n",
-              dest,
-              src,
               size,
-              (int)(intptr_t)ret);
+              ret);
     goto function_output;
   }
 
-  destine = (unsigned char *)dest;
-  source  = (const unsigned char *)src;
-
-  if ((uintptr_t)destine % ARCH_ALIGNMENT != 0)
-  {
-    while ((iterator < size)
-           && ((uintptr_t)(destine + iterator) % ARCH_ALIGNMENT != 0))
-    {
-      destine[iterator] = source[iterator];
-      iterator++;
-    }
-  }
+  snap->report     = (gc_snap_report_t *)area;
+  snap->size       = size;
+  snap->words      = words;
+  snap->sweep_word = 0u;
+  snap->sweep_map  = 0u;
 
-  for (; iterator + ARCH_ALIGNMENT <= size; iterator += ARCH_ALIGNMENT)
-  {
-    dest_fetch   = destine + iterator;
-    source_fetch = source + iterator;
+  MEM_memset(&registers, 0, sizeof(registers));
+  (void)getcontext(&registers);
 
-    PREFETCH_R(source_fetch + CACHE_LINE_SIZE);
-    PREFETCH_W(dest_fetch + CACHE_LINE_SIZE);
+  start = MEM_gcClockNs( );
 
-    dest_word = (uintptr_t *)ASSUME_ALIGNED(dest_fetch, ARCH_ALIGNMENT);
-    src_word  = (const uintptr_t *)ASSUME_ALIGNED(source_fetch, ARCH_ALIGNMENT);
+  MEM_gcStopWorld(allocator);
 
-    *dest_word = *src_word;
+  child = fork( );
+  if (child == 0)
+  {
+    MEM_gcSnapMark(allocator, &registers);
+    _exit(EXIT_SUCCESS);
   }
 
-  destine_aux = destine + iterator;
-  while (iterator < size)
+  if (child < 0)
+    ret = -errno;
+
+  MEM_gcStartWorld(allocator);
+
+  if (ret != EXIT_SUCCESS)
   {
-    *destine_aux++ = source[iterator];
-    iterator++;
+    LOG_ERROR("Failed to fork the GC snapshot. "
+              "Error code: %d.\n",
+              ret);
+    munmap(area, size);
+    snap->report = (gc_snap_report_t *)NULL;
+    goto function_output;
   }
 
-  ret = dest;
-  LOG_INFO("Memory copied: dest=%p, src=%p, size=%zu.\n", dest, src, size);
+  snap->child  = child;
+  snap->active = true;
+
+  LOG_INFO("GC snapshot: fork pause %llu us | %zu bitmap words | "
+           "child %d.\n",
+           (unsigned long long)((MEM_gcClockNs( ) - start) / NSEC_PER_USEC),
+           words,
+           (int)child);
 
 function_output:
   return ret;
 }
 
 /** ============================================================================
- *  @brief  Invokes sbrk-like behavior by moving the program break.
- *
- *  This function reads the current program break, attempts to move it by the
- *  signed offset @p increment via sbrk(), and returns the original break on
- *  success.  If any call to sbrk() or reading the break fails, it encodes the
- *  negative errno into a pointer via PTR_ERR.
- *
- *  @param[in]  increment Signed offset in bytes to move the program break:
- *                        positive to grow, negative to shrink.
- *
- *  @return Original program break address on success;
- *          an error-encoded pointer (via PTR_ERR()) on failure.
- *
- *  @retval ret>-1:   Previous break on success.
- *  @retval -ENOMEM:  Failed to read or adjust the break.
+ *  @brief  Marks the snapshot and writes the report; runs in the child.
+ *
+ *  Only the forking thread exists in the child, so marking is serial and
+ *  is not logged: a parked thread may have held the stdio locks at fork().
+ *  Clears the marks and indexes the heap and mmap blocks, scans the
+ *  spilled registers, the parked stacks and the global segments, drains
+ *  and recovers from overflow, then stores start & ~mark of every bitmap
+ *  word and the unreachable mmap blocks into the report. @b complete is
+ *  stored last; it stays false if indexing fails.
+ *
+ *  @param[in]  allocator Memory allocator context (the child's copy).
+ *  @param[in]  registers Registers spilled by the parent before fork().
  * ========================================================================== */
-void *MEM_sbrk(const intptr_t increment)
+static void MEM_gcSnapMark(mem_allocator_t *const allocator,
+                           ucontext_t *const      registers)
 {
-  void *old_break = (void *)NULL;
-  void *new_break = (void *)NULL;
+  gc_snap_report_t *report = (gc_snap_report_t *)NULL;
+  gc_mark_stack_t  *stack  = (gc_mark_stack_t *)NULL;
 
-  old_break = sbrk(0);
-  if (old_break == (void *)-1)
-  {
-    old_break = PTR_ERR(-ENOMEM);
-    LOG_ERROR("Failed to read current break. "
-              "Error code: %d.\n",
-              (int)(intptr_t)old_break);
+  block_header_t *block     = (block_header_t *)NULL;
+  block_header_t *meta_data = (block_header_t *)NULL;
+  mmap_t         *map       = (mmap_t *)NULL;
+
+  size_t index = 0u;
+
+  report = allocator->gc_snap.report;
+  stack  = &allocator->gc_pool.workers[0].stack;
+
+  if (MEM_setInitialMarks(allocator) != EXIT_SUCCESS)
     goto function_output;
+
+  stack->len      = 0u;
+  stack->overflow = false;
+
+  (void)MEM_gcScanRoots(allocator, registers);
+  MEM_gcDrain(allocator, stack);
+
+  while (stack->overflow)
+  {
+    stack->overflow = false;
+    MEM_gcRescan(allocator);
+  }
+
+  for (map = allocator->mmap_list; map; map = map->next)
+  {
+    meta_data = (block_header_t *)((uintptr_t)map - sizeof(block_header_t));
+
+    (void)MEM_gcSetMark(allocator, meta_data);
   }
 
-  if (sbrk(increment) == (void *)-1)
+  for (index = 0u; index < allocator->gc_snap.words; ++index)
   {
-    old_break = PTR_ERR(-ENOMEM);
-    LOG_ERROR("Failed to adjust break (increment=%" PRIdPTR ""
-              "Error code: %d.\n",
-              increment,
-              (int)(intptr_t)old_break);
-    goto function_output;
+    report->words[index] = allocator->start_bits.words[index]
+                         & ~allocator->mark_bits.words[index];
   }
 
-  new_break = sbrk(0);
-  if (new_break == (void *)-1)
+  for (map = allocator->mmap_list; map; map = map->next)
   {
-    old_break = PTR_ERR(-ENOMEM);
-    LOG_ERROR("Failed to read new break. "
-              "Error code: %d.\n",
-              (int)(intptr_t)old_break);
-    goto function_output;
+    block = (block_header_t *)map->addr;
+    if (MEM_gcIsMarked(allocator, block) || block->free)
+      continue;
+
+    if (report->num_maps == GC_SNAP_MAX_MAPS)
+      break;
+
+    report->maps[report->num_maps++] = block;
   }
 
-  LOG_INFO("Program break moved from %p to %p (increment: %" PRIdPTR ").\n",
-           old_break,
-           new_break,
-           increment);
+  atomic_store_explicit(&report->complete, true, memory_order_release);
 
 function_output:
-  return old_break;
+  return;
 }
 
 /** ============================================================================
- *  @brief  Validates the integrity and boundaries of a memory block.
+ *  @brief  Waits for the marking child and checks its report.
  *
- *  This function ensures that the specified @p block lies within the
- * allocator’s heap or one of its mmap regions, that its header canary matches
- * the expected magic value to detect metadata corruption, that its data canary
- * is intact to catch buffer overruns, and that the block’s size does not extend
- * past the heap’s end.  On any failure, an appropriate negative errno is
- * returned.
+ *  Runs without gc_lock, so mutators keep allocating and freeing while the
+ *  child marks. ECHILD from waitpid() means the child was already reaped,
+ *  e.g. with SIGCHLD ignored; the report then tells whether it finished.
  *
- *  @param[in]  allocator Pointer to the allocator context.
- *  @param[in]  block     Pointer to the block header to validate.
+ *  @param[in]  allocator Memory allocator context.
  *
  *  @return Integer status code.
  *
- *  @retval EXIT_SUCCESS: @p block is valid.
- *  @retval -EINVAL:      @p allocator or @p block pointer is NULL.
- *  @retval -EFAULT:      @p block lies outside heap and mmap regions.
- *  @retval -EPROTO:      @p block canary does not match expected value.
- *  @retval -EFBIG:       @p block size causes it to extend past heap end.
- *  @retval -EOVERFLOW:   @p block canary indicates buffer overflow.
+ *  @retval EXIT_SUCCESS: Report complete.
+ *  @retval -ECHILD:      The child ended without a complete report.
+ *  @retval ret<0:        Negated errno of waitpid().
  * ========================================================================== */
-static int MEM_validateBlock(mem_allocator_t *const allocator,
-                             block_header_t *const  block)
+static int MEM_gcSnapWait(mem_allocator_t *const allocator)
 {
-  int ret = EXIT_SUCCESS;
+  int ret    = EXIT_SUCCESS;
+  int status = 0;
 
-  mmap_t *map = (mmap_t *)NULL;
+  gc_snap_t *snap = (gc_snap_t *)NULL;
 
-  uintptr_t addr       = 0u;
-  uintptr_t heap_start = 0u;
-  uintptr_t heap_end   = 0u;
-  uintptr_t map_start  = 0u;
-  uintptr_t map_end    = 0u;
+  uint64_t start = 0u;
 
-  size_t hdr_sz    = 0u;
-  size_t min_total = 0u;
-  size_t bsize     = 0u;
+  pid_t pid = 0;
 
-  uintptr_t  tail_addr = 0u;
-  uintptr_t *tail      = (uintptr_t *)NULL;
+  snap  = &allocator->gc_snap;
+  start = MEM_gcClockNs( );
 
-  bool in_heap = false;
-  bool in_mmap = false;
+  do
+  {
+    pid = waitpid(snap->child, &status, 0);
+  } while (pid < 0 && errno == EINTR);
 
-  if (UNLIKELY((allocator == NULL) || (block == NULL)))
+  allocator->gc_stats.current.mark_ns += MEM_gcClockNs( ) - start;
+
+  if (pid < 0 && errno != ECHILD)
   {
-    ret = -EINVAL;
-    LOG_ERROR("Invalid parameters. Allocator: %p, Block: %p. Error code: %d.\n",
-              (void *)allocator,
-              (void *)block,
+    ret = -errno;
+    LOG_ERROR("Failed to wait for the GC snapshot child %d. "
+              "Error code: %d.\n",
+              (int)snap->child,
               ret);
     goto function_output;
   }
 
-  addr       = (uintptr_t)block;
-  heap_start = (uintptr_t)allocator->heap_start;
-  heap_end   = (uintptr_t)allocator->heap_end;
-  hdr_sz     = sizeof(block_header_t);
-  min_total  = (size_t)(hdr_sz + sizeof(uintptr_t));
-
-  if ((addr >= heap_start) && (addr < heap_end))
+  if (!atomic_load_explicit(&snap->report->complete, memory_order_acquire))
   {
-    in_heap = true;
+    ret = -ECHILD;
+    LOG_ERROR("GC snapshot child %d ended without a report (status %d). "
+              "Error code: %d.\n",
+              (int)snap->child,
+              status,
+              ret);
   }
-  else
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Frees reported blocks from the cursor until done or time is up.
+ *
+ *  Reported heap blocks are freed GC_SWEEP_CHUNK words at a time. Having
+ *  been unreachable at fork(), they cannot have been freed or reused by
+ *  the program since; the header checks are those of MEM_gcSweepWords().
+ *  A reported mmap block is released through its mmap_list link.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  deadline  CLOCK_MONOTONIC time, in nanoseconds, to stop at.
+ *
+ *  @return true once every reported block was handled.
+ * ========================================================================== */
+static bool MEM_gcSnapSweep(mem_allocator_t *const allocator,
+                            const uint64_t         deadline)
+{
+  gc_snap_t        *snap   = (gc_snap_t *)NULL;
+  gc_snap_report_t *report = (gc_snap_report_t *)NULL;
+
+  block_header_t *block = (block_header_t *)NULL;
+  mmap_t        **scan  = (mmap_t **)NULL;
+
+  void *user_ptr = (void *)NULL;
+
+  uint64_t candidates = 0u;
+  uint64_t start      = 0u;
+
+  size_t last  = 0u;
+  size_t index = 0u;
+  size_t bit   = 0u;
+
+  snap   = &allocator->gc_snap;
+  report = snap->report;
+  start  = MEM_gcClockNs( );
+
+  while (snap->sweep_word < snap->words)
   {
-    for (map = allocator->mmap_list; map; map = map->next)
+    last = snap->sweep_word + GC_SWEEP_CHUNK;
+    if (last > snap->words)
+      last = snap->words;
+
+    for (index = snap->sweep_word; index < last; ++index)
     {
-      map_start = (uintptr_t)map->addr;
-      map_end   = map_start + map->size;
+      candidates = report->words[index];
 
-      if ((addr >= map_start) && (addr < map_end))
+      while (candidates != 0u)
       {
-        in_mmap = true;
-        break;
-      }
-    }
-  }
+        bit         = (size_t)(unsigned)__builtin_ctzll(candidates);
+        candidates &= candidates - 1u;
 
-  if (UNLIKELY(!in_heap && !in_mmap))
-  {
-    ret = -EFAULT;
-    LOG_ERROR("Block %p is outside managed regions. Heap=[%p .. %p]. Error "
-              "code: %d.\n",
-              (void *)block,
-              (void *)allocator->heap_start,
-              (void *)allocator->heap_end,
-              ret);
-    goto function_output;
-  }
+        block = (block_header_t *)(allocator->start_bits.base
+                                   + (index * GC_BITS_PER_WORD + bit)
+                                       * GC_GRANULE);
+        if ((uint8_t *)block >= allocator->heap_end || block->free
+            || block->magic != MAGIC_NUMBER)
+          continue;
 
-  if ((addr & (ARCH_ALIGNMENT - 1u)) != 0u)
-  {
-    ret = -ENOENT;
-    LOG_WARNING("Not a memalloc block: misaligned header at %p (alignment=%u). "
-                "Error code: %d.\n",
-                (void *)block,
-                (unsigned)ARCH_ALIGNMENT,
-                ret);
-    goto function_output;
-  }
+        LOG_INFO("Sweep Free(sbrk): block %p (%zu bytes).\n",
+                 (void *)((uint8_t *)block + sizeof(block_header_t)),
+                 block->size);
 
-  if (in_heap)
-  {
-    const uintptr_t user_start = heap_start + allocator->metadata_size;
+        ++allocator->gc_stats.current.blocks_freed;
+        allocator->gc_stats.current.bytes_freed += block->size;
 
-    if (addr < user_start)
-    {
-      ret = -ENOENT;
-      LOG_WARNING("Not a memalloc block: header at %p lies inside allocator "
-                  "metadata region [%p .. %p). Error code: %d.\n",
-                  (void *)block,
-                  (void *)allocator->heap_start,
-                  (void *)user_start,
-                  ret);
-      goto function_output;
+        user_ptr = (uint8_t *)block + sizeof(*block);
+        MEM_freeOp(allocator, user_ptr, __FILE__, __LINE__);
+      }
     }
 
-    if (addr > (heap_end - hdr_sz))
+    snap->sweep_word = last;
+
+    if (MEM_gcClockNs( ) >= deadline)
     {
-      ret = -ENOENT;
-      LOG_WARNING("Not a memalloc block: header at %p truncated at heap end "
-                  "%p. Error code: %d.\n",
-                  (void *)block,
-                  (void *)allocator->heap_end,
-                  ret);
-      goto function_output;
+      allocator->gc_stats.current.sweep_ns += MEM_gcClockNs( ) - start;
+      return false;
     }
   }
-  else
+
+  for (; snap->sweep_map < report->num_maps; ++snap->sweep_map)
   {
-    if (addr > (map_end - hdr_sz))
+    block = report->maps[snap->sweep_map];
+
+    for (scan = &allocator->mmap_list; *scan; scan = &(*scan)->next)
     {
-      ret = -ENOENT;
-      LOG_WARNING("Not a memalloc block: header at %p truncated inside mmap "
-                  "region [%p .. %p). Error code: %d.\n",
-                  (void *)block,
-                  (void *)map->addr,
-                  (void *)((uint8_t *)map->addr + map->size),
-                  ret);
-      goto function_output;
+      if ((*scan)->addr == (void *)block)
+        break;
     }
+
+    if (*scan != NULL && !block->free)
+      MEM_gcFreeMap(allocator, scan);
   }
 
-  bsize = block->size;
+  allocator->gc_stats.current.sweep_ns += MEM_gcClockNs( ) - start;
+  MEM_gcStatsEnd(allocator);
 
-  if (bsize < min_total)
-  {
-    ret = -ENOENT;
-    LOG_WARNING("Not a memalloc block: too small size at %p (%zu < %zu). Error "
-                "code: %d.\n",
-                (void *)block,
-                bsize,
-                min_total,
-                ret);
-    goto function_output;
-  }
+  return true;
+}
 
-  if ((bsize & (ARCH_ALIGNMENT - 1u)) != 0u)
-  {
-    ret = -ENOENT;
-    LOG_WARNING("Not a memalloc block: size not aligned at %p (%zu, "
-                "alignment=%u). Error code: %d.\n",
-                (void *)block,
-                bsize,
-                (unsigned)ARCH_ALIGNMENT,
-                ret);
-    goto function_output;
-  }
+/** ============================================================================
+ *  @brief  Releases the report and ends the snapshot cycle.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ * ========================================================================== */
+static void MEM_gcSnapEnd(mem_allocator_t *const allocator)
+{
+  gc_snap_t *snap = (gc_snap_t *)NULL;
 
-  if (in_heap && ((addr + bsize) > heap_end))
-  {
-    ret = -ENOENT;
-    LOG_WARNING("Not a memalloc block: block at %p extends past heap end (%p). "
-                "size=%zu. Error code: %d.\n",
-                (void *)block,
-                (void *)allocator->heap_end,
-                bsize,
-                ret);
-    goto function_output;
-  }
-  if (in_mmap && ((addr + bsize) > map_end))
-  {
-    ret = -ENOENT;
-    LOG_WARNING("Not a memalloc block: block at %p extends past mmap end (%p). "
-                "size=%zu. Error code: %d.\n",
-                (void *)block,
-                (void *)map_end,
-                bsize,
-                ret);
-    goto function_output;
-  }
+  snap = &allocator->gc_snap;
 
-  if (block->magic != MAGIC_NUMBER)
-  {
-    ret = -ENOENT;
-    LOG_WARNING("Not a memalloc block: magic mismatch at %p (0x%" PRIxPTR
-                " vs 0x%" PRIxPTR "). Error code: %d.\n",
-                (void *)block,
-                block->magic,
-                (uintptr_t)MAGIC_NUMBER,
-                ret);
-    goto function_output;
-  }
+  if (snap->report != NULL)
+    munmap((void *)snap->report, snap->size);
+
+  snap->report = (gc_snap_report_t *)NULL;
+  snap->child  = 0;
+  snap->active = false;
+}
+
+/** ============================================================================
+ *  @brief  Dedicated thread loop driving mark-and-sweep iterations.
+ *
+ *  This function runs as the GC worker thread.  It locks gc_lock and waits
+ *  on gc_cond until either gc_running or gc_exit is set.  On wakeup, it
+ *  refreshes the cgroup snapshot once refresh_ms elapsed (MEM_cgroupLoad())
+ *  and dispatches any pressure event this raised; then, if gc_exit is
+ *  true, it breaks and exits the loop; otherwise it performs one
+ *  GC cycle, then waits on gc_cond (MEM_gcPaceWait()) until the allocation
+ *  volume since the cycle reaches the trigger, MEM_gcCollect() requests a
+ *  collection, or the idle back-off elapses.  With MEM_gcSetGenerational() enabled, the
+ *  cycle is a minor or full generational one (MEM_gcGenCycle()); else,
+ *  with MEM_gcSetSnapshot() enabled, it is marked by a fork()ed child
+ *  (MEM_gcSnapCycle()). Otherwise, or
+ *  when the snapshot fails, it is mostly concurrent when soft-dirty page
+ *  tracking works (MEM_gcConcurrentCycle()), and else a stop-the-world
+ *  MEM_gcMark() and MEM_gcSweep() with gc_lock held, so no allocation can
+ *  reshape the heap mid-cycle.  With MEM_gcSetLazySweep() enabled, the
+ *  last two leave the sweep to allocations; whatever they did not sweep
+ *  is finished in GC_SLICE_US slices before the next cycle.  A requested
+ *  collection is a full one.  On exit it clears gc_running, wakes
+ *  MEM_gcCollect() callers and ensures gc_lock is released.
+ *
+ *  @param[in]  arg Pointer to the mem_allocator_t context.
+ *
+ *  @return NULL on clean exit; an error-encoded pointer (via PTR_ERR())
+ *          if any initialization or GC step fails.
+ *
+ *  @retval NULL:     Clean exit after gc_exit.
+ *  @retval -EINVAL:  @p arg is NULL.
+ *  @retval ret<0:    cond errors, or MEM_gcMark() / MEM_gcSweep() failures.
+ * ========================================================================== */
+static void *MEM_gcThreadFunc(void *arg)
+{
+  int ret = EXIT_SUCCESS;
+
+  mem_allocator_t *allocator = (mem_allocator_t *)NULL;
+  gc_thread_t     *gc_thread = (gc_thread_t *)NULL;
 
-  if (in_heap && (block->canary != CANARY_VALUE))
+  if (UNLIKELY(arg == NULL))
   {
-    ret = -EPROTO;
-    LOG_WARNING("Memalloc block corrupted: header canary mismatch at %p "
-                "(0x%" PRIxPTR " vs 0x%" PRIxPTR "). Error code: %d.\n",
-                (void *)block,
-                block->canary,
-                (uintptr_t)CANARY_VALUE,
-                ret);
+    ret = -EINVAL;
+    LOG_ERROR("Invalid parameters: arg: %p. "
+              "Error code: %d.\n",
+              (void *)arg,
+              (int)(intptr_t)ret);
     goto function_output;
   }
 
-  tail_addr = addr + bsize - sizeof(uintptr_t);
-  tail      = (uintptr_t *)tail_addr;
+  allocator = (mem_allocator_t *)arg;
 
-  if (in_heap)
+  gc_thread = &allocator->gc_thread;
+
+  pthread_mutex_lock(&gc_thread->gc_lock);
+
+  while (!gc_thread->gc_exit)
   {
-    if (*tail != CANARY_VALUE)
+    while (!gc_thread->gc_running && !gc_thread->gc_exit)
+      pthread_cond_wait(&gc_thread->gc_cond, &gc_thread->gc_lock);
+
+    if (MEM_cgroupDue(allocator))
     {
-      ret = -EOVERFLOW;
-      LOG_WARNING("Memalloc block corrupted: data canary mismatch at %p "
-                  "(0x%" PRIxPTR "). Error code: %d.\n",
-                  (void *)block,
-                  *tail,
-                  ret);
-      goto function_output;
+      (void)MEM_cgroupLoad(allocator);
+
+      pthread_mutex_unlock(&gc_thread->gc_lock);
+      (void)MEM_pressureDispatch(allocator);
+      pthread_mutex_lock(&gc_thread->gc_lock);
     }
-  }
-  else
-  {
-    if (tail_addr >= map_end)
+
+    if (gc_thread->gc_exit)
+      goto mutex_unlock;
+
+    while (allocator->gc_incr.phase == GC_INCR_SWEEP && !gc_thread->gc_exit
+           && !MEM_gcIncrSweep(allocator,
+                               MEM_gcClockNs( )
+                                 + (uint64_t)GC_SLICE_US * NSEC_PER_USEC))
     {
-      ret = -ENOENT;
-      LOG_WARNING("Not a memalloc block: trailing canary out of mmap bounds at "
-                  "%p. Error code: %d.\n",
-                  (void *)block,
-                  ret);
-      goto function_output;
+      pthread_mutex_unlock(&gc_thread->gc_lock);
+      sched_yield( );
+      pthread_mutex_lock(&gc_thread->gc_lock);
     }
 
-    if (*tail != CANARY_VALUE)
+    ++allocator->gc_pace.started;
+
+    if (allocator->gc_pace.requested)
     {
-      ret = -EOVERFLOW;
-      LOG_WARNING("Memalloc block corrupted (mmap): data canary mismatch at %p "
-                  "(0x%" PRIxPTR "). Error code: %d.\n",
-                  (void *)block,
-                  *tail,
-                  ret);
-      goto function_output;
+      allocator->gc_pace.requested = false;
+      allocator->gc_gen.minors     = allocator->gc_gen.full_every;
     }
-  }
 
-  LOG_INFO("Block validated: addr=%p, size=%zu, region=%s.\n",
-           (void *)block,
-           bsize,
-           in_heap ? "heap" : "mmap");
+    if (allocator->gc_gen.full_every != 0u)
+    {
+      ret = MEM_gcGenCycle(allocator);
+      if (ret != EXIT_SUCCESS)
+        goto mutex_unlock;
+    }
+    else if (!allocator->gc_snap.enabled
+             || MEM_gcSnapCycle(allocator) != EXIT_SUCCESS)
+    {
+      if (MEM_gcDirtyProbe(allocator))
+      {
+        ret = MEM_gcConcurrentCycle(allocator);
+        if (ret != EXIT_SUCCESS)
+          goto mutex_unlock;
+      }
+      else
+      {
+        ret = MEM_gcMark(allocator);
+        if (ret != EXIT_SUCCESS)
+          goto mutex_unlock;
+
+        if (allocator->gc_incr.lazy)
+        {
+          allocator->gc_incr.phase      = GC_INCR_SWEEP;
+          allocator->gc_incr.sweep_word = 0u;
+        }
+        else
+        {
+          ret = MEM_gcSweep(allocator);
+          if (ret != EXIT_SUCCESS)
+            goto mutex_unlock;
+        }
+      }
+    }
+
+    MEM_gcPaceDone(allocator);
+    MEM_gcPaceWait(allocator);
+  }
 
+mutex_unlock:
+  gc_thread->gc_running = false;
+  pthread_cond_broadcast(&allocator->gc_pace.done);
+  pthread_mutex_unlock(&gc_thread->gc_lock);
 function_output:
-  return ret;
+  return PTR_ERR(ret);
 }
 
 /** ============================================================================
- *  @brief  Calculates the size class index for a requested memory size.
- *
- *  This function determines which size class the given allocation request
- *  belongs to by dividing the requested @p size by BYTES_PER_CLASS (rounding
- *  up). If the computed index exceeds the maximum available class, it will
- *  be clamped to the highest class and a warning emitted.
+ *  @brief  Runs a mostly-concurrent collection from the GC thread.
  *
- *  @param[in]  allocator Pointer to the allocator context.
- *  @param[in]  size  Requested memory size in bytes (must be > 0).
+ *  Drives the incremental collector in GC_SLICE_US steps, releasing
+ *  gc_lock between them so mutators allocate and free while the heap is
+ *  traced. Only the root scan and the remark of the soft-dirty pages stop
+ *  the world. An incremental cycle already started by MEM_gcStep() is
+ *  carried on rather than restarted. With lazy sweeping, returns as soon
+ *  as the heap is marked.
  *
- *  @return On success, returns a non-negative integer size class index;
- *          on failure, returns a negative error code.
+ *  @param[in]  allocator Memory allocator context.
  *
- *  @retval ret>0:    Valid size class index.
- *  @retval -EINVAL:  @p allocator is NULL, or @p size is zero.
+ *  @return EXIT_SUCCESS once the cycle completed or gc_exit was raised,
+ *          negative error code on failure.
  * ========================================================================== */
-static int MEM_getSizeClass(mem_allocator_t *const allocator, const size_t size)
+static int MEM_gcConcurrentCycle(mem_allocator_t *const allocator)
 {
   int ret = EXIT_SUCCESS;
 
-  size_t index     = 0u;
-  size_t max_class = 0u;
+  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
 
-  if (UNLIKELY(allocator == NULL))
-  {
-    ret = -EINVAL;
-    LOG_ERROR("Invalid allocator pointer: %p. "
-              "Error code: %d.\n",
-              (void *)allocator,
-              ret);
-    goto function_output;
-  }
+  gc_thread = &allocator->gc_thread;
 
-  if (UNLIKELY(size <= 0))
+  while (!gc_thread->gc_exit)
   {
-    ret = -EINVAL;
-    LOG_ERROR("Invalid size requested: %zu"
-              "Error code: %d.\n",
-              size,
-              ret);
-    goto function_output;
-  }
+    ret = MEM_gcStepOp(allocator, GC_SLICE_US);
+    if (ret != EXIT_SUCCESS)
+      break;
 
-  max_class = (size_t)((allocator->num_size_classes - 1u) * BYTES_PER_CLASS);
-  index     = (size_t)((size + BYTES_PER_CLASS - 1u) / BYTES_PER_CLASS);
+    if (allocator->gc_incr.lazy && allocator->gc_incr.phase == GC_INCR_SWEEP)
+      break;
 
-  if (UNLIKELY(index >= allocator->num_size_classes))
-  {
-    LOG_WARNING("Size overflow - "
-                "Requested: %zu bytes | Max class: %zu bytes | "
-                "Clamped to class %zu.\n",
-                size,
-                max_class,
-                (allocator->num_size_classes - 1u));
-    index = (size_t)(allocator->num_size_classes - 1);
+    pthread_mutex_unlock(&gc_thread->gc_lock);
+    sched_yield( );
+    pthread_mutex_lock(&gc_thread->gc_lock);
   }
-  else
+
+  if (ret == MEM_GC_CYCLE_DONE)
+    ret = EXIT_SUCCESS;
+
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Runs a collection marked by a fork()ed child from the GC thread.
+ *
+ *  Mutators pause only for the fork() in MEM_gcSnapBegin(). gc_lock is
+ *  released while the child marks, then the report is swept lazily in
+ *  GC_SLICE_US steps, releasing gc_lock between them.
+ *
+ *  @param[in]  allocator Memory allocator context.
+ *
+ *  @return EXIT_SUCCESS once the cycle completed or gc_exit was raised,
+ *          negative error code when no snapshot could be marked.
+ * ========================================================================== */
+static int MEM_gcSnapCycle(mem_allocator_t *const allocator)
+{
+  int ret = EXIT_SUCCESS;
+
+  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
+
+  gc_thread = &allocator->gc_thread;
+
+  ret = MEM_gcSnapBegin(allocator);
+  if (ret != EXIT_SUCCESS)
+    goto snap_failed;
+
+  pthread_mutex_unlock(&gc_thread->gc_lock);
+  ret = MEM_gcSnapWait(allocator);
+  pthread_mutex_lock(&gc_thread->gc_lock);
+
+  if (ret != EXIT_SUCCESS)
+    goto snap_end;
+
+  while (!gc_thread->gc_exit
+         && !MEM_gcSnapSweep(allocator,
+                             MEM_gcClockNs( )
+                               + (uint64_t)GC_SLICE_US * NSEC_PER_USEC))
   {
-    LOG_INFO("Size class calculated - "
-             "Requested: %zu bytes | Class: %zu (%zu-%zu bytes).\n",
-             size,
-             index,
-             index * BYTES_PER_CLASS,
-             ((index + 1u) * BYTES_PER_CLASS - 1u));
+    pthread_mutex_unlock(&gc_thread->gc_lock);
+    sched_yield( );
+    pthread_mutex_lock(&gc_thread->gc_lock);
   }
 
-  ret = (int)index;
+snap_end:
+  MEM_gcSnapEnd(allocator);
+snap_failed:
+  if (ret != EXIT_SUCCESS)
+    LOG_WARNING("GC snapshot failed; marking in process this cycle.\n");
 
-function_output:
   return ret;
 }
 
 /** ============================================================================
- *  @brief  Inserts a block into the appropriate free list based on its size.
+ *  @brief  Collects only the blocks allocated since the last collection.
  *
- *  This function computes the size class index for the given @p block by
- *  calling MEM_getSizeClass(), then pushes the block onto the head of that
- *  free list within the allocator. It updates both forward and backward
- *  links to maintain the doubly‐linked list of free blocks.
+ *  Must be called with gc_lock held. The marks left by the previous
+ *  collection are kept: marked blocks form the old generation and are
+ *  neither traced from the roots nor swept. With the world stopped, the
+ *  roots are scanned, then the remembered set: the old blocks on pages
+ *  written since the last collection (MEM_gcRemarkDirty()), or every old
+ *  block when soft-dirty tracking is unavailable. Survivors stay marked,
+ *  which promotes them. Only the bitmap words that received an allocation
+ *  since the last collection are swept.
  *
- *  @param[in]  allocator Pointer to the allocator context.
- *  @param[in]  block     Pointer to the block header to insert.
+ *  @param[in]  allocator Memory allocator context.
  *
  *  @return Integer status code.
  *
- *  @retval EXIT_SUCCESS: @p block successfully inserted.
- *  @retval -EINVAL:      @p allocator or @p block is NULL.
- *  @retval -ENOMEM:      Size class calculation failed (request too large).
+ *  @retval EXIT_SUCCESS: Minor collection done.
+ *  @retval -ENOMEM:      The mmap index could not be grown.
  * ========================================================================== */
-static int MEM_insertFreeBlock(mem_allocator_t *const allocator,
-                               block_header_t *const  block)
+static int MEM_gcMinor(mem_allocator_t *const allocator)
 {
   int ret = EXIT_SUCCESS;
 
-  int index = 0u;
+  gc_gen_t        *gen   = (gc_gen_t *)NULL;
+  gc_mark_stack_t *stack = (gc_mark_stack_t *)NULL;
 
-  if (UNLIKELY(allocator == NULL || block == NULL))
-  {
-    ret = -EINVAL;
-    LOG_ERROR("Invalid parameters - Allocator: %p, Block: %p. "
-              "Error code: %d.\n",
-              (void *)allocator,
-              (void *)block,
-              ret);
+  block_header_t *meta_data = (block_header_t *)NULL;
+  mmap_t         *map       = (mmap_t *)NULL;
+
+  uint64_t start = 0u;
+  uint64_t sweep = 0u;
+
+  size_t stack_bytes = 0u;
+  size_t pages       = 0u;
+  size_t words       = 0u;
+  size_t last        = 0u;
+
+  uint32_t rescans = 0u;
+
+  bool full = false;
+
+  ucontext_t registers;
+
+  gen   = &allocator->gc_gen;
+  stack = &allocator->gc_pool.workers[0].stack;
+
+  MEM_gcStatsBegin(allocator, MEM_GC_KIND_MINOR);
+
+  MEM_gcCollectRoots(allocator);
+
+  ret = MEM_gcIndexMaps(allocator);
+  if (ret != EXIT_SUCCESS)
     goto function_output;
+
+  stack->len      = 0u;
+  stack->overflow = false;
+
+  MEM_memset(&registers, 0, sizeof(registers));
+  (void)getcontext(&registers);
+
+  start = MEM_gcClockNs( );
+
+  MEM_gcStopWorld(allocator);
+
+  stack_bytes = MEM_gcScanRoots(allocator, &registers);
+  MEM_gcDrain(allocator, stack);
+
+  full = !gen->tracking;
+  if (!full && MEM_gcRemarkDirty(allocator, &pages) != EXIT_SUCCESS)
+    full = true;
+
+  gen->tracking = gen->tracking && MEM_gcDirtyClear( ) == EXIT_SUCCESS;
+
+  while (full || stack->overflow)
+  {
+    full            = false;
+    stack->overflow = false;
+    ++rescans;
+    MEM_gcRescan(allocator);
   }
 
-  index = MEM_getSizeClass(allocator, block->size);
-  if (index < 0)
+  MEM_gcStartWorld(allocator);
+
+  for (map = allocator->mmap_list; map; map = map->next)
   {
-    ret = -ENOMEM;
-    goto function_output;
+    meta_data = (block_header_t *)((uintptr_t)map - sizeof(block_header_t));
+
+    (void)MEM_gcSetMark(allocator, meta_data);
   }
 
-  block->fl_next = allocator->free_lists[index];
+  sweep = MEM_gcClockNs( );
 
-  block->fl_prev = (block_header_t *)NULL;
-  if (allocator->free_lists[index])
-    allocator->free_lists[index]->fl_prev = block;
+  allocator->gc_stats.current.mark_ns = sweep - allocator->gc_stats.start_ns;
 
-  allocator->free_lists[index] = block;
-  LOG_INFO("Block %p inserted into free list %d (size: %zu)\n",
-           (void *)block,
-           index,
-           block->size);
+  words = allocator->mark_bits.used_words;
+  if (allocator->start_bits.used_words < words)
+    words = allocator->start_bits.used_words;
+
+  last = (gen->young_hi < words) ? gen->young_hi : words;
+  if (gen->young_lo < last)
+    (void)MEM_gcSweepWords(allocator, gen->young_lo, last);
+
+  MEM_gcSweepMaps(allocator);
+
+  allocator->gc_stats.current.sweep_ns = MEM_gcClockNs( ) - sweep;
+  MEM_gcStatsEnd(allocator);
+
+  LOG_INFO("GC minor: %llu us | %zu stack bytes | %zu dirty pages | "
+           "%u rescans | %zu young words.\n",
+           (unsigned long long)((MEM_gcClockNs( ) - start) / NSEC_PER_USEC),
+           stack_bytes,
+           pages,
+           rescans,
+           (gen->young_lo < last) ? last - gen->young_lo : 0u);
 
 function_output:
   return ret;
 }
 
 /** ============================================================================
- *  @brief  Removes a block from its free list.
+ *  @brief  Runs a generational collection from the GC thread.
  *
- *  This function unlinks the specified @p block from the free list
- * corresponding to its size class within the allocator. It computes the
- * size‐class index via MEM_getSizeClass(), validates parameters, then adjusts
- * the neighboring blocks’ fl_next and fl_prev pointers (or the list head) to
- * remove @p block. The block’s own fl_next and fl_prev are then cleared.
+ *  Must be called with gc_lock held. Runs a full MEM_gcMark() and
+ *  MEM_gcSweep() when the marks do not describe the old generation yet, or
+ *  after @b full_every minor collections; otherwise runs MEM_gcMinor().
+ *  A full collection clears the soft-dirty bits before marking, so every
+ *  store the mark could miss lands on a page the next minor rescans. The
+ *  generation is valid from the end of the mark on, so that MEM_gcTrack()
+ *  clears the start bits of the blocks the sweep frees, which later minor
+ *  collections rely on to resolve pointers.
  *
  *  @param[in]  allocator Memory allocator context.
- *  @param[in]  block     Block header to remove.
  *
- *  @return Integer status code.
- *
- *  @retval EXIT_SUCCESS: Block removed successfully.
- *  @retval -EINVAL:      @p allocator or @p block is NULL.
- *  @retval -ENOMEM:      Size‐class calculation failed.
+ *  @return EXIT_SUCCESS on success, negative error code on failure.
  * ========================================================================== */
-static int MEM_removeFreeBlock(mem_allocator_t *const allocator,
-                               block_header_t *const  block)
+static int MEM_gcGenCycle(mem_allocator_t *const allocator)
 {
   int ret = EXIT_SUCCESS;
 
-  int index = 0u;
+  gc_gen_t *gen = (gc_gen_t *)NULL;
+
+  gen = &allocator->gc_gen;
 
-  if (UNLIKELY(allocator == NULL || block == NULL))
+  if (gen->valid && gen->minors < gen->full_every)
   {
-    ret = -EINVAL;
-    LOG_ERROR("Invalid parameters: allocator: %p, block: %p. "
-              "Error code: %d.\n",
-              (void *)allocator,
-              (void *)block,
-              ret);
-    goto function_output;
-  }
+    ret = MEM_gcMinor(allocator);
+    if (ret != EXIT_SUCCESS)
+      goto function_output;
 
-  index = MEM_getSizeClass(allocator, block->size);
-  if (index < 0)
-  {
-    ret = -ENOMEM;
-    goto function_output;
+    ++gen->minors;
   }
-
-  if (block->fl_prev)
-    block->fl_prev->fl_next = block->fl_next;
   else
-    allocator->free_lists[index] = block->fl_next;
+  {
+    gen->tracking
+      = MEM_gcDirtyProbe(allocator) && MEM_gcDirtyClear( ) == EXIT_SUCCESS;
 
-  if (block->fl_next)
-    block->fl_next->fl_prev = block->fl_prev;
+    ret = MEM_gcMark(allocator);
+    if (ret != EXIT_SUCCESS)
+      goto function_output;
 
-  block->fl_next = (block_header_t *)NULL;
-  block->fl_prev = (block_header_t *)NULL;
+    gen->valid = true;
 
-  LOG_INFO("Block %p removed from free list %d (size: %zu)\n",
-           (void *)block,
-           index,
-           block->size);
+    ret = MEM_gcSweep(allocator);
+    if (ret != EXIT_SUCCESS)
+    {
+      gen->valid = false;
+      goto function_output;
+    }
+
+    gen->minors = 0u;
+
+    LOG_INFO("GC full collection; old generation reset.\n");
+  }
+
+  gen->young_lo = SIZE_MAX;
+  gen->young_hi = 0u;
 
 function_output:
   return ret;
 }
 
 /** ============================================================================
- *  @brief  Initializes the memory allocator and its internal structures.
+ *  @brief  Start or signal the GC thread to perform a collection cycle.
  *
- *  This function prepares the allocator’s heap by:
- *    - Reading and aligning the initial program break to ARCH_ALIGNMENT.
- *    - Allocating the arena array and free‐list bins via MEM_growUserHeap().
- *    - Zeroing out the free‐list bins.
- *    - Initializing the allocator fields (heap_start, heap_end, free_lists).
- *    - Setting up the garbage‐collector thread state and its mutex/cond.
- *    - Capturing the current thread’s stack bounds via MEM_stackBounds().
- *    - (If under Valgrind) creating a mempool for the allocator.
+ *  This function saves the caller’s thread ID as main_thread, locks gc_lock,
+ *  installs the stop-the-world handlers, registers the caller as a root
+ *  thread, and if the GC thread has not been started, sets gc_running and
+ *  gc_exit flags and spawns MEM_gcThreadFunc(); otherwise it sets gc_running
+ *  and signals gc_cond to wake the existing thread.  Finally it unlocks
+ *  gc_lock.
  *
- *  @param[in]  allocator Pointer to a mem_allocator_t instance to initialize.
+ *  @param[in]  allocator Pointer to the mem_allocator_t context.
  *
- *  @return Integer status code indicating initialization result.
+ *  @return Integer status code.
  *
- *  @retval EXIT_SUCCESS: Allocator initialized successfully.
- *  @retval -EINVAL:      Invalid @p allocator pointer.
- *  @retval -ENOMEM:      Heap alignment or arena/bin allocation failed.
+ *  @retval EXIT_SUCCESS: GC thread started or signaled successfully.
+ *  @retval -EINVAL:      @p allocator is NULL.
+ *  @retval ret<0:        Negated error code returned by pthread_create().
  * ========================================================================== */
-static int MEM_allocatorInit(mem_allocator_t *const allocator)
+static int MEM_runGc(mem_allocator_t *const allocator)
 {
   int ret = EXIT_SUCCESS;
 
-  __UNUSED static bool mempool_created = false;
-
-  mem_arena_t *arena     = (mem_arena_t *)NULL;
   gc_thread_t *gc_thread = (gc_thread_t *)NULL;
 
-  void *base = (void *)NULL;
-  void *old  = (void *)NULL;
-
-  uintptr_t addr = 0;
-
-  size_t pad        = 0u;
-  size_t bins_bytes = 0u;
-
-  g_allocator_inited = true;
-
-  allocator->last_brk_start = NULL;
-  allocator->last_brk_end   = NULL;
-
-  base = MEM_sbrk(0);
-  if (base == PTR_ERR(-ENOMEM))
+  if (UNLIKELY(allocator == NULL))
   {
-    ret = -ENOMEM;
-    LOG_ERROR("unable to get heap base address %p. "
+    ret = -EINVAL;
+    LOG_ERROR("Invalid parameters: allocator: %p. "
               "Error code: %d.\n",
-              (void *)base,
+              (void *)allocator,
               ret);
     goto function_output;
   }
 
-  addr = (uintptr_t)base;
-  pad  = (size_t)((ARCH_ALIGNMENT - (addr % ARCH_ALIGNMENT)) % ARCH_ALIGNMENT);
+  gc_thread = &allocator->gc_thread;
 
-  if (pad)
+  gc_thread->main_thread = pthread_self( );
+
+  pthread_mutex_lock(&gc_thread->gc_lock);
+
+  ret = MEM_gcInstallSignals(allocator);
+  if (ret != EXIT_SUCCESS)
+    goto mutex_unlock;
+
+  ret = MEM_gcRegister(allocator, gc_thread->main_thread);
+  if (ret != EXIT_SUCCESS && ret != -EALREADY)
+    goto mutex_unlock;
+
+  ret = EXIT_SUCCESS;
+
+  if (!gc_thread->gc_thread_started)
   {
-    old = MEM_sbrk((intptr_t)pad);
-    if (old == PTR_ERR(-ENOMEM) || old == PTR_ERR(-EINVAL))
+    gc_thread->gc_thread_started = true;
+    gc_thread->gc_running        = true;
+    gc_thread->gc_exit           = false;
+
+    ret = pthread_create(&gc_thread->gc_thread,
+                         (const pthread_attr_t *)NULL,
+                         MEM_gcThreadFunc,
+                         (void *)allocator);
+    if (ret != EXIT_SUCCESS)
     {
-      ret = -ENOMEM;
-      LOG_ERROR("Unable to align heap (requested pad=%zu bytes). "
+      gc_thread->gc_thread_started = false;
+      gc_thread->gc_running        = false;
+
+      ret = -ret;
+      LOG_ERROR("Failed to create gc thread. "
                 "Error code: %d.\n",
-                pad,
                 ret);
-      goto function_output;
+      goto mutex_unlock;
     }
   }
-
-  allocator->heap_start     = (uint8_t *)base;
-  allocator->heap_end       = (uint8_t *)base;
-  allocator->last_allocated = (block_header_t *)NULL;
-
-  allocator->num_arenas = 1u;
-
-  allocator->arenas
-    = (mem_arena_t *)MEM_growUserHeap(allocator, sizeof(mem_arena_t));
-  if (allocator->arenas == PTR_ERR(-ENOMEM))
+  else
   {
-    ret = -ENOMEM;
-    LOG_ERROR("Unable to allocate memory for arenas. "
-              "Error code: %d.\n",
-              ret);
-    goto function_output;
+    gc_thread->gc_running = true;
+    pthread_cond_signal(&gc_thread->gc_cond);
   }
 
-  arena = &allocator->arenas[0];
+mutex_unlock:
+  pthread_mutex_unlock(&gc_thread->gc_lock);
+function_output:
+  return ret;
+}
 
-  arena->num_bins = DEFAULT_NUM_BINS;
+/** ============================================================================
+ *  @brief  Stop the GC thread and perform a final collection.
+ *
+ *  This function clears gc_running and sets gc_exit under gc_lock, signals
+ *  gc_cond to wake the GC thread if it’s running, then joins it without the
+ *  lock held.  After the thread exits, it runs one final MEM_gcMark() +
+ *  MEM_gcSweep() on the caller thread under gc_lock to reclaim any remaining
+ *  garbage, clears gc_thread_started, joins the mark/sweep worker pool and
+ *  releases the mark stacks, bitmaps and mmap index.
+ *
+ *  @param[in]  allocator Pointer to the mem_allocator_t context.
+ *
+ *  @return Integer status code.
+ *
+ *  @retval EXIT_SUCCESS: GC thread stopped and final collection done.
+ *  @retval -EINVAL:      @p allocator is NULL.
+ *  @retval ret<0:        Error code from pthread MEM_gcMark(), or
+ * MEM_gcSweep().
+ * ========================================================================== */
+static int MEM_stopGc(mem_allocator_t *const allocator)
+{
+  int ret = EXIT_SUCCESS;
 
-  bins_bytes = (size_t)(arena->num_bins * sizeof(block_header_t *));
+  gc_thread_t    *gc_thread = (gc_thread_t *)NULL;
+  gc_bitmap_t    *bits      = (gc_bitmap_t *)NULL;
+  gc_map_index_t *index     = (gc_map_index_t *)NULL;
 
-  arena->bins = MEM_growUserHeap(allocator, (intptr_t)bins_bytes);
-  if (arena->bins == (void *)(-ENOMEM))
+  bool started = false;
+
+  if (UNLIKELY(allocator == NULL))
   {
-    ret = -ENOMEM;
-    LOG_ERROR("Unable to allocate memory for free lists (bins). "
+    ret = -EINVAL;
+    LOG_ERROR("Invalid parameters: allocator: %p. "
               "Error code: %d.\n",
+              (void *)allocator,
               ret);
     goto function_output;
   }
 
-  MEM_memset(arena->bins, 0, bins_bytes);
+  gc_thread = &allocator->gc_thread;
 
-  allocator->free_lists       = arena->bins;
-  allocator->num_size_classes = arena->num_bins;
+  pthread_mutex_lock(&gc_thread->gc_lock);
+  gc_thread->gc_running = false;
+  gc_thread->gc_exit    = true;
 
-  allocator->mmap_list = (mmap_t *)NULL;
+  started = gc_thread->gc_thread_started;
 
-  allocator->metadata_size
-    = ((uintptr_t)arena->bins + bins_bytes) - (uintptr_t)allocator->heap_start;
+  pthread_cond_signal(&gc_thread->gc_cond);
+  pthread_mutex_unlock(&gc_thread->gc_lock);
 
-  gc_thread = &allocator->gc_thread;
+  if (!started)
+    goto function_output;
 
-  gc_thread->gc_interval_ms = GC_INTERVAL_MS;
+  pthread_join(gc_thread->gc_thread, NULL);
 
+  pthread_mutex_lock(&gc_thread->gc_lock);
   gc_thread->gc_thread_started = false;
-  gc_thread->gc_running        = false;
-  gc_thread->gc_exit           = false;
+  allocator->gc_gen.valid      = false;
 
-  ret = pthread_mutex_init(&gc_thread->gc_lock,
-                           (const pthread_mutexattr_t *)NULL);
+  ret = MEM_gcMark(allocator);
   if (ret != EXIT_SUCCESS)
-    goto function_output;
+    goto mutex_unlock;
 
-  ret
-    = pthread_cond_init(&gc_thread->gc_cond, (const pthread_condattr_t *)NULL);
+  ret = MEM_gcSweep(allocator);
   if (ret != EXIT_SUCCESS)
-    goto function_output;
+    goto mutex_unlock;
 
-  ret = MEM_stackBounds(pthread_self( ), allocator);
-  if (ret != EXIT_SUCCESS)
+  MEM_gcPoolStop(allocator);
+
+  bits = &allocator->mark_bits;
+  if (bits->words != NULL)
   {
-    LOG_ERROR("Unable to capture stack bounds. "
-              "Error code: %d.\n",
-              ret);
-    goto function_output;
+    munmap(bits->words, bits->cap_words * sizeof(uint64_t));
+
+    bits->words      = (uint64_t *)NULL;
+    bits->cap_words  = 0u;
+    bits->used_words = 0u;
   }
 
-#ifdef RUNNING_ON_VALGRIND
-  if (mempool_created)
-    VALGRIND_DESTROY_MEMPOOL(allocator);
+  bits = &allocator->start_bits;
+  if (bits->words != NULL)
+  {
+    munmap(bits->words, bits->cap_words * sizeof(uint64_t));
 
-  VALGRIND_CREATE_MEMPOOL(allocator, 0, false);
-  mempool_created = true;
-#endif
+    bits->words      = (uint64_t *)NULL;
+    bits->cap_words  = 0u;
+    bits->used_words = 0u;
+  }
 
-  LOG_INFO("Allocator initialized: initial_heap=[%p...%p], bins=%zu.\n",
-           (void *)allocator->heap_start,
-           (void *)allocator->heap_end,
-           arena->num_bins);
+  index = &allocator->map_index;
+  if (index->ranges != NULL)
+  {
+    munmap(index->ranges, index->cap * sizeof(gc_map_range_t));
+
+    index->ranges = (gc_map_range_t *)NULL;
+    index->len    = 0u;
+    index->cap    = 0u;
+  }
 
+mutex_unlock:
+  pthread_mutex_unlock(&gc_thread->gc_lock);
 function_output:
   return ret;
 }
 
+#endif
+
 /** ============================================================================
- *  @brief  Expands the user heap by a specified increment.
- *
- *  This function moves the program break by @p inc bytes via MEM_sbrk(),
- *  zeroes the newly allocated region, updates the allocator’s heap_end, and
- *  initializes a block_header_t at the start of the new region to record its
- *  size, mark it as allocated, and set its free flag to false.
- *
- *  @param[in]  allocator Pointer to the allocator context.
- *  @param[in]  inc       Signed number of bytes to grow (or shrink) the heap.
- *
- *  @return Pointer to the previous program break (start of new region)
- *          on success; an error-encoded pointer (via PTR_ERR()) on failure.
- *
- *  @retval (ret>=0): Previous heap end address (new region start).
- *  @retval -EINVAL:  @p allocator is NULL.
- *  @retval -ENOMEM:  Heap expansion failed (out of memory).
+ *          P U B L I C  F U N C T I O N S  D E F I N I T I O N S
  * ========================================================================== */
-static void *MEM_growUserHeap(mem_allocator_t *const allocator,
-                              const intptr_t         inc)
-{
-  void *old = (void *)NULL;
-
-  block_header_t *header = (block_header_t *)NULL;
 
-  if (UNLIKELY(allocator == NULL))
-  {
-    old = PTR_ERR(-EINVAL);
-    LOG_ERROR("Invalid arguments: allocator=%p. "
-              "Error code: %d.\n",
-              (void *)allocator,
-              (int)(intptr_t)old);
-    goto function_output;
-  }
+/** ============================================================================
+ *  @brief  Allocates memory using the FIRST_FIT strategy.
+ *
+ *  This function locks the GC mutex, invokes MEM_allocOp() with
+ *  FIRST_FIT strategy, automatically supplying __FILE__, __LINE__, and variable
+ *  name for debugging, then unlocks the mutex.
+ *
+ *  @param[in]  size      Number of bytes requested.
+ *
+ *  @return Pointer to the allocated user memory on success,
+ *          or an error‐encoded pointer (via PTR_ERR()) on failure.
+ * ========================================================================== */
+void *MEM_allocFirstFit(const size_t size)
+{
+  void *ret_addr = (void *)NULL;
 
-  old = MEM_sbrk(inc);
+  int ret_init = EXIT_SUCCESS;
 
-  if ((intptr_t)old < 0)
-    goto function_output;
+  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
 
-  MEM_memset(old, 0, (size_t)inc);
+  if (!g_allocator_inited)
+  {
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
 
-  header = (block_header_t *)old;
+    ret_init = MEM_allocatorInit(&g_allocator);
+    if (ret_init != EXIT_SUCCESS)
+      goto function_output;
+  }
 
-  header->size   = (size_t)inc;
-  header->free   = 1u;
-  header->marked = 0u;
+  gc_thread = &g_allocator.gc_thread;
 
-  allocator->heap_end = (uint8_t *)((uint8_t *)old + inc);
+  pthread_mutex_lock(&gc_thread->gc_lock);
+  ret_addr = MEM_allocOp(&g_allocator,
+                         size,
+                         __FILE__,
+                         __LINE__,
+                         FIRST_FIT,
+                         MEM_TAG_DEFAULT);
+  pthread_mutex_unlock(&gc_thread->gc_lock);
 
-  allocator->last_brk_start = (uint8_t *)old;
-  allocator->last_brk_end   = (uint8_t *)old + inc;
+  (void)MEM_pressureDispatch(&g_allocator);
+
+#if defined(GARBAGE_COLLECTOR)
+  MEM_gcAssist(&g_allocator, size);
+#endif
 
 function_output:
-  return old;
+  return ret_addr;
 }
+
 /** ============================================================================
- *  @brief      Allocates a page-aligned memory region via mmap and registers it
- *              in the allocator’s mmap list for later freeing.
- *
- *  This function rounds up @p total_size to a multiple of the system page size,
- *  invokes mmap() to obtain an anonymous read/write region, then allocates
- *  an mmap_t metadata node via MEM_allocOp() and links it into
- *  allocator->mmap_list.  It initializes a block_header_t and trailing canary
- *  in the mapped region to integrate with the allocator’s debugging and GC.
+ *  @brief  Allocates memory using the BEST_FIT strategy.
  *
- *  @param[in]  allocator   Pointer to the memory allocator context.
- *  @param[in]  total_size  Number of bytes requested.
+ *  This function locks the GC mutex, invokes MEM_allocOp() with
+ *  BEST_FIT strategy, automatically supplying __FILE__, __LINE__, and variable
+ *  name for debugging, then unlocks the mutex.
  *
- *  @return On success, returns the address of the mapped region.
- *          On failure, returns an error-encoded pointer (via PTR_ERR()).
+ *  @param[in]  size      Number of bytes requested.
  *
- *  @retval ret!=MAP_FAILED:  Address of the mapped region.
- *  @retval -EINVAL:          @p allocator is NULL.
- *  @retval -EIO:             mmap() failed.
- *  @retval -ENOMEM:          Allocation of mmap_t metadata failed.
+ *  @return Pointer to the allocated user memory on success,
+ *          or an error‐encoded pointer (via PTR_ERR()) on failure.
  * ========================================================================== */
-static void *MEM_mapAlloc(mem_allocator_t *const allocator,
-                          const size_t           total_size)
+void *MEM_allocBestFit(const size_t size)
 {
-  void *ptr = (void *)NULL;
-
-  mmap_t *map_block = (mmap_t *)NULL;
-
-  block_header_t *header = (block_header_t *)NULL;
-
-  uintptr_t *data_canary = (uintptr_t *)NULL;
-  uintptr_t  canary_addr = 0u;
-
-  size_t page     = 0u;
-  size_t map_size = 0u;
+  void *ret_addr = (void *)NULL;
 
-  if (UNLIKELY(allocator == NULL))
-  {
-    ptr = PTR_ERR(-EINVAL);
-    LOG_ERROR("Invalid arguments: allocator=%p. "
-              "Error code: %d.\n",
-              (void *)allocator,
-              (int)(intptr_t)ptr);
-    goto function_output;
-  }
+  int ret_init = EXIT_SUCCESS;
 
-  page     = (size_t)sysconf(_SC_PAGESIZE);
-  map_size = ((total_size + page - 1u) / page) * page;
+  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
 
-  ptr = mmap(NULL,
-             map_size,
-             PROT_READ | PROT_WRITE,
-             MAP_PRIVATE | MAP_ANONYMOUS,
-             -1,
-             0);
-  if (ptr == MAP_FAILED)
+  if (!g_allocator_inited)
   {
-    ptr = PTR_ERR(-EIO);
-    LOG_ERROR("Mmap failed: %zu bytes. "
-              "Error code: %d.\n",
-              map_size,
-              (int)(intptr_t)ptr);
-    goto function_output;
-  }
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
 
-  map_block
-    = MEM_allocOp(allocator, sizeof(mmap_t), __FILE__, __LINE__, FIRST_FIT);
-  if (map_block == NULL)
-  {
-    munmap(ptr, map_size);
-    ptr = PTR_ERR(-ENOMEM);
-    LOG_ERROR("Mmap metadata allocation failed: %zu bytes. "
-              "Error code: %d.\n",
-              sizeof(mmap_t),
-              (int)(intptr_t)ptr);
-    goto function_output;
+    ret_init = MEM_allocatorInit(&g_allocator);
+    if (ret_init != EXIT_SUCCESS)
+      goto function_output;
   }
 
-  map_block->addr      = ptr;
-  map_block->size      = map_size;
-  map_block->next      = allocator->mmap_list;
-  allocator->mmap_list = map_block;
-
-  header = (block_header_t *)ptr;
+  gc_thread = &g_allocator.gc_thread;
 
-  header->magic  = MAGIC_NUMBER;
-  header->size   = map_size;
-  header->free   = 0u;
-  header->marked = 1u;
-  header->prev   = (block_header_t *)NULL;
-  header->next   = (block_header_t *)NULL;
-  header->file   = (const char *)NULL;
-  header->line   = 0u;
+  pthread_mutex_lock(&gc_thread->gc_lock);
+  ret_addr = MEM_allocOp(&g_allocator,
+                         size,
+                         __FILE__,
+                         __LINE__,
+                         BEST_FIT,
+                         MEM_TAG_DEFAULT);
+  pthread_mutex_unlock(&gc_thread->gc_lock);
 
-  canary_addr  = (uintptr_t)ptr + map_size - sizeof(uintptr_t);
-  data_canary  = (uintptr_t *)canary_addr;
-  *data_canary = CANARY_VALUE;
+  (void)MEM_pressureDispatch(&g_allocator);
 
-  LOG_INFO("Mmap allocated: %zu bytes at %p.\n", map_size, ptr);
+#if defined(GARBAGE_COLLECTOR)
+  MEM_gcAssist(&g_allocator, size);
+#endif
 
 function_output:
-  return ptr;
+  return ret_addr;
 }
 
 /** ============================================================================
- *  @brief  Unmaps a previously mapped memory region and removes its
- *          metadata entry from the allocator’s mmap list.
- *
- *  This function searches the allocator’s mmap_list for an entry matching
- *  @p addr, calls munmap() to unmap the region, unlinks the corresponding
- *  mmap_t metadata node, and frees it via MEM_freeOp().  Errors during
- *  munmap are returned; if metadata freeing fails, an error is logged but
- *  success is returned.
+ *  @brief  Allocates memory using the NEXT_FIT strategy.
  *
- *  @param[in]  allocator Memory allocator context.
- *  @param[in]  addr      Address of the memory region to unmap.
+ *  This function locks the GC mutex, invokes MEM_allocOp() with
+ *  NEXT_FIT strategy, automatically supplying __FILE__, __LINE__, and variable
+ *  name for debugging, then unlocks the mutex.
  *
- *  @return Integer status code.
+ *  @param[in]  size      Number of bytes requested.
  *
- *  @retval EXIT_SUCCESS: Region unmapped and metadata entry removed.
- *  @retval -EINVAL:      @p allocator / @p addr is NULL, or not found in list.
- *  @retval -ENOMEM:      munmap() failed to unmap the region.
+ *  @return Pointer to the allocated user memory on success,
+ *          or an error‐encoded pointer (via PTR_ERR()) on failure.
  * ========================================================================== */
-static int MEM_mapFree(mem_allocator_t *const allocator, void *const addr)
+void *MEM_allocNextFit(const size_t size)
 {
-  int ret = EXIT_SUCCESS;
+  void *ret_addr = (void *)NULL;
 
-  mmap_t **map_ref = (mmap_t **)NULL;
-  mmap_t  *to_free = (mmap_t *)NULL;
+  int ret_init = EXIT_SUCCESS;
 
-  size_t map_size = 0u;
+  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
 
-  if (UNLIKELY(allocator == NULL || addr == NULL))
+  if (!g_allocator_inited)
   {
-    ret = -EINVAL;
-    LOG_ERROR("Invalid arguments: allocator=%p addr=%p. "
-              "Error code: %d.\n",
-              (void *)allocator,
-              addr,
-              ret);
-    goto function_output;
-  }
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
 
-  map_ref = &allocator->mmap_list;
-  while (*map_ref)
-  {
-    if ((*map_ref)->addr == addr)
-    {
-      map_size = (*map_ref)->size;
+    ret_init = MEM_allocatorInit(&g_allocator);
+    if (ret_init != EXIT_SUCCESS)
+      goto function_output;
+  }
 
-      if (munmap(addr, map_size) != 0)
-      {
-        ret = -ENOMEM;
-        LOG_ERROR("Mmap failed: %zu bytes. "
-                  "Error code: %d.\n",
-                  map_size,
-                  ret);
-        goto function_output;
-      }
+  gc_thread = &g_allocator.gc_thread;
 
-      to_free  = *map_ref;
-      *map_ref = to_free->next;
+  pthread_mutex_lock(&gc_thread->gc_lock);
+  ret_addr = MEM_allocOp(&g_allocator,
+                         size,
+                         __FILE__,
+                         __LINE__,
+                         NEXT_FIT,
+                         MEM_TAG_DEFAULT);
+  pthread_mutex_unlock(&gc_thread->gc_lock);
 
-      ret = MEM_freeOp(allocator, (void *)to_free, __FILE__, __LINE__);
-      if (ret != EXIT_SUCCESS)
-      {
-        LOG_ERROR("Mmap metadata free failed: %zu bytes. "
-                  "Error code: %d.\n",
-                  sizeof(mmap_t),
-                  (int)(intptr_t)ret);
-        goto function_output;
-      }
+  (void)MEM_pressureDispatch(&g_allocator);
 
-      LOG_INFO("Munmap freed: %zu bytes at %p.\n", map_size, addr);
-    }
-    else
-    {
-      map_ref = &(*map_ref)->next;
-    }
-  }
+#if defined(GARBAGE_COLLECTOR)
+  MEM_gcAssist(&g_allocator, size);
+#endif
 
 function_output:
-  return ret;
+  return ret_addr;
 }
 
 /** ============================================================================
- *  @brief  Searches for the first suitable free memory block in size‐class
- * lists.
- *
- *  This function computes the starting size class for the requested @p size via
- *  MEM_getSizeClass(), then scans each free‐list from that class upward.  For
- * each candidate block, it calls MEM_validateBlock() to ensure integrity, and
- * returns the first block that is marked free and large enough. The found block
- * pointer is stored in @p fit_block.
+ *  @brief  Allocates memory using the specified strategy.
  *
- *  @param[in]  allocator Pointer to the allocator context.
- *  @param[in]  size       Requested allocation size in bytes.
- *  @param[out] fit_block On success, set to the pointer of a suitable free
- * block.
+ *  This function locks the GC mutex, invokes MEM_allocOp() with the
+ *  given @p strategy, automatically supplying __FILE__, __LINE__, and variable
+ *  name for debugging, then unlocks the mutex.
  *
- *  @return Integer status code.
+ *  @param[in]  size      Number of bytes requested
+ *  @param[in]  strategy  Allocation strategy.
  *
- *  @retval EXIT_SUCCESS: Suitable block found successfully.
- *  @retval -EINVAL:      @p allocator or @p fit_block are NULL;
- *  @retval -ENOMEM:      Size calculation failed or no suitable block found.
+ *  @return Pointer to the allocated user memory on success,
+ *          or an error‐encoded pointer (via PTR_ERR()) on failure.
  * ========================================================================== */
-static int MEM_findFirstFit(mem_allocator_t *const allocator,
-                            const size_t           size,
-                            block_header_t       **fit_block)
+void *MEM_alloc(const size_t size, const allocation_strategy_t strategy)
 {
-  int ret = EXIT_SUCCESS;
+  void *ret_addr = (void *)NULL;
 
-  block_header_t *current = (block_header_t *)NULL;
+  int ret_init = EXIT_SUCCESS;
 
-  int    start_class = 0;
-  size_t class_idx   = 0u;
+  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
 
-  if (UNLIKELY(allocator == NULL || fit_block == NULL))
+  if (!g_allocator_inited)
   {
-    ret = -EINVAL;
-    LOG_ERROR("Invalid parameters: allocator %p | fit_block %p. "
-              "Error code: %d.\n",
-              (void *)allocator,
-              (void *)fit_block,
-              ret);
-    goto function_output;
-  }
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
 
-  start_class = MEM_getSizeClass(allocator, size);
-  if (start_class < 0)
-  {
-    ret = -ENOMEM;
-    goto function_output;
+    ret_init = MEM_allocatorInit(&g_allocator);
+    if (ret_init != EXIT_SUCCESS)
+      goto function_output;
   }
 
-  for (class_idx = (size_t)start_class; class_idx < allocator->num_size_classes;
-       class_idx++)
-  {
-    current = allocator->free_lists[class_idx];
-    while (current)
-    {
-      ret = MEM_validateBlock(allocator, current);
-      if ((ret == EXIT_SUCCESS) && (current->free && current->size >= size))
-      {
-        *fit_block = current;
-        goto function_output;
-      }
+  gc_thread = &g_allocator.gc_thread;
 
-      current = current->fl_next;
-    }
-  }
+  pthread_mutex_lock(&gc_thread->gc_lock);
+  ret_addr = MEM_allocOp(&g_allocator,
+                         size,
+                         __FILE__,
+                         __LINE__,
+                         strategy,
+                         MEM_TAG_DEFAULT);
+  pthread_mutex_unlock(&gc_thread->gc_lock);
 
-  ret = -ENOMEM;
-  LOG_WARNING("First-fit allocation failed: "
-              "Req size: %zu | Max checked class: %zu. "
-              "Error code: %d.\n",
-              size,
-              (size_t)(allocator->num_size_classes - 1u),
-              ret);
+  (void)MEM_pressureDispatch(&g_allocator);
+
+#if defined(GARBAGE_COLLECTOR)
+  MEM_gcAssist(&g_allocator, size);
+#endif
 
 function_output:
-  return ret;
+  return ret_addr;
 }
 
 /** ============================================================================
- *  @brief  Searches for the next suitable free memory block using the
- *          NEXT_FIT strategy starting from the last allocated position.
- *
- *  This function attempts to find a free block of at least @p size bytes by
- *  scanning the heap starting at allocator->last_allocated.  If last_allocated
- *  is NULL, not free, or corrupted, it falls back to First-Fit.  It wraps
- *  around to the heap start if needed, stopping once it returns to the start.
+ *  @brief  Allocates and zero‐initializes memory using the specified strategy.
  *
- *  @param[in]  allocator Pointer to the allocator context.
- *  @param[in]  size      Requested allocation size in bytes.
- *  @param[out] fit_block Pointer to store the address of the found block.
+ *  This function locks the GC mutex, invokes MEM_callocOp() with the
+ *  given @p strategy, automatically supplying __FILE__, __LINE__, and variable
+ *  name for debugging, then unlocks the mutex.
  *
- *  @return Integer status code.
+ *  @param[in]  size      Number of bytes requested.
+ *  @param[in]  var       Variable name for debugging.
  *
- *  @retval EXIT_SUCCESS: Suitable block found and fit_block set.
- *  @retval -EINVAL:      @p allocator or @p fit_block is NULL.
- *  @retval -ENOMEM:      No suitable block found in heap.
+ *  @return Pointer to the allocated zeroed memory on success,
+ *          or an error‐encoded pointer (via PTR_ERR()) on failure.
  * ========================================================================== */
-static int MEM_findNextFit(mem_allocator_t *const allocator,
-                           const size_t           size,
-                           block_header_t       **fit_block)
+void *MEM_calloc(const size_t size, const allocation_strategy_t strategy)
 {
-  int ret = EXIT_SUCCESS;
+  void *ret_addr = (void *)NULL;
 
-  block_header_t *current = (block_header_t *)NULL;
-  block_header_t *start   = (block_header_t *)NULL;
+  int ret_init = EXIT_SUCCESS;
 
-  if (UNLIKELY(allocator == NULL || fit_block == NULL))
-  {
-    ret = -EINVAL;
-    LOG_ERROR("Invalid parameters: allocator %p | fit_block %p. "
-              "Error code: %d.\n",
-              (void *)allocator,
-              (void *)fit_block,
-              ret);
-    goto function_output;
-  }
+  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
 
-  if (allocator->last_allocated == NULL || allocator->last_allocated->free == 0
-      || allocator->last_allocated->magic != MAGIC_NUMBER)
+  if (!g_allocator_inited)
   {
-    LOG_INFO("Fallback to First-Fit (no valid last_allocated).\n");
-    ret = MEM_findFirstFit(allocator, size, fit_block);
-    if (ret == EXIT_SUCCESS)
-      allocator->last_allocated = *fit_block;
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
 
-    goto function_output;
+    ret_init = MEM_allocatorInit(&g_allocator);
+    if (ret_init != EXIT_SUCCESS)
+      goto function_output;
   }
 
-  current = allocator->last_allocated;
-  start   = current;
-
-  do
-  {
-    ret = MEM_validateBlock(allocator, current);
-    if ((ret == EXIT_SUCCESS) && (current->free && current->size >= size))
-    {
-      *fit_block                = current;
-      allocator->last_allocated = current;
-      goto function_output;
-    }
+  gc_thread = &g_allocator.gc_thread;
 
-    current
-      = (current->next)
-          ? current->next
-          : (block_header_t *)ASSUME_ALIGNED((uint8_t *)allocator->heap_start
-                                               + allocator->metadata_size,
-                                             ARCH_ALIGNMENT);
+  pthread_mutex_lock(&gc_thread->gc_lock);
+  ret_addr = MEM_callocOp(&g_allocator, size, __FILE__, __LINE__, strategy);
+  pthread_mutex_unlock(&gc_thread->gc_lock);
 
-  } while (current != start);
+  (void)MEM_pressureDispatch(&g_allocator);
 
-  ret = -ENOMEM;
-  LOG_WARNING("Next-fit allocation failed: "
-              "Req size: %zu | Start block: %p. "
-              "Error code: %d.\n",
-              size,
-              (void *)start,
-              ret);
+#if defined(GARBAGE_COLLECTOR)
+  MEM_gcAssist(&g_allocator, size);
+#endif
 
 function_output:
-  return ret;
+  return ret_addr;
 }
 
 /** ============================================================================
- *  @brief  Searches for the smallest suitable free memory block
- *          in size‐class lists (BEST_FIT).
- *
- *  This function computes the starting size class for the requested @p size via
- *  MEM_getSizeClass(), then scans each free‐list from that class upward.  It
- *  validates each candidate with MEM_validateBlock() and tracks the smallest
- *  free block that is large enough.  Once a block in any class is chosen, the
- *  search stops.
+ *  @brief  Reallocates memory with safety checks using the specified strategy.
  *
- *  @param[in]   allocator  Pointer to the allocator context.
- *  @param[in]   size       Requested allocation size in bytes.
- *  @param[out]  best_fit   On success, set to the pointer of the free block.
+ *  This function locks the GC mutex, invokes MEM_reallocOp() with the
+ *  given @p strategy, automatically supplying __FILE__, __LINE__, and variable
+ *  name for debugging, then unlocks the mutex.
  *
- *  @return Integer status code.
+ *  @param[in]  ptr       Pointer to existing memory.
+ *  @param[in]  new_size  New requested size.
+ *  @param[in]  strategy  Allocation strategy.
  *
- *  @retval EXIT_SUCCESS: Suitable block found successfully.
- *  @retval -EINVAL:      @p allocator or @p best_fit is NULL.
- *  @retval -ENOMEM:      Size calculation failed or no suitable block found.
+ *  @return Pointer to the reallocated memory on success (may be same as @p
+ * ptr), or an error‐encoded pointer (via PTR_ERR()) on failure.
  * ========================================================================== */
-static int MEM_findBestFit(mem_allocator_t *const allocator,
-                           const size_t           size,
-                           block_header_t       **best_fit)
+void *MEM_realloc(void *const                 ptr,
+                  const size_t                new_size,
+                  const allocation_strategy_t strategy)
 {
-  int ret = EXIT_SUCCESS;
-
-  block_header_t *current = (block_header_t *)NULL;
+  void *ret_addr = (void *)NULL;
 
-  size_t iterator = 0u;
+  int ret_init = EXIT_SUCCESS;
 
-  int start_class = 0;
+  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
 
-  if (UNLIKELY(allocator == NULL || best_fit == NULL))
+  if (!g_allocator_inited)
   {
-    ret = -EINVAL;
-    LOG_ERROR("Invalid parameters: allocator %p | best_fit %p"
-              "Error code: %d.\n",
-              (void *)allocator,
-              (void *)best_fit,
-              ret);
-    goto function_output;
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
+
+    ret_init = MEM_allocatorInit(&g_allocator);
+    if (ret_init != EXIT_SUCCESS)
+      goto function_output;
   }
 
-  *best_fit = (block_header_t *)NULL;
+  gc_thread = &g_allocator.gc_thread;
 
-  start_class = MEM_getSizeClass(allocator, size);
-  if (start_class < 0)
-  {
-    ret = -ENOMEM;
-    goto function_output;
-  }
+  pthread_mutex_lock(&gc_thread->gc_lock);
+  ret_addr
+    = MEM_reallocOp(&g_allocator, ptr, new_size, __FILE__, __LINE__, strategy);
+  pthread_mutex_unlock(&gc_thread->gc_lock);
 
-  for (iterator = (size_t)start_class; iterator < allocator->num_size_classes;
-       iterator++)
-  {
-    current = allocator->free_lists[iterator];
+  (void)MEM_pressureDispatch(&g_allocator);
 
-    while (current)
-    {
-      ret = MEM_validateBlock(allocator, current);
-      if ((ret == EXIT_SUCCESS) && (current->free && current->size >= size))
-      {
-        if (!(*best_fit) || current->size < (*best_fit)->size)
-          *best_fit = current;
-      }
+#if defined(GARBAGE_COLLECTOR)
+  MEM_gcAssist(&g_allocator, new_size);
+#endif
 
-      current = current->fl_next;
-    }
+function_output:
+  return ret_addr;
+}
 
-    if (*best_fit)
+/** ============================================================================
+ *  @brief  Releases allocated memory back to the heap.
+ *
+ *  This function locks the GC mutex, invokes MEM_freeOp() with
+ *  automatically supplied __FILE__, __LINE__, and variable name for debugging,
+ *  then unlocks the mutex.
+ *
+ *  @param[in]  ptr       Pointer to memory to free.
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ * ========================================================================== */
+int MEM_free(void *const ptr)
+{
+  int ret_addr = EXIT_SUCCESS;
+
+  int ret_init = EXIT_SUCCESS;
+
+  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
+
+  if (!g_allocator_inited)
+  {
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
+
+    ret_init = MEM_allocatorInit(&g_allocator);
+    if (ret_init != EXIT_SUCCESS)
       goto function_output;
   }
 
-  ret = -ENOMEM;
-  LOG_WARNING("Best-fit allocation failed: "
-              "Req size: %zu | Max checked class: %zu. "
-              "Error code: %d.\n",
-              size,
-              (allocator->num_size_classes - 1),
-              ret);
+  gc_thread = &g_allocator.gc_thread;
+
+  pthread_mutex_lock(&gc_thread->gc_lock);
+  ret_addr = MEM_freeOp(&g_allocator, ptr, __FILE__, __LINE__);
+  pthread_mutex_unlock(&gc_thread->gc_lock);
 
 function_output:
-  return ret;
+  return ret_addr;
 }
 
 /** ============================================================================
- *  @brief  Splits a memory block into allocated and free portions.
- *
- *  This function takes an existing free @p block and a requested allocation
- *  size @p req_size, and divides the block into:
- *    - an allocated portion of size aligned up to ALIGN(req_size) plus header
- *      and canary, marked as used;
- *    - a remaining free portion (if its size ≥ MIN_BLOCK_SIZE) inserted back
- *      into the appropriate free list.
- *  If the leftover space would be too small (< MIN_BLOCK_SIZE), the entire
- *  block is allocated without splitting.
+ *  @brief  Registers (or looks up) a named accounting tag.
  *
- *  @param[in]  allocator Pointer to the mem_allocator_t context.
- *  @param[in]  block     Pointer to the block_header_t to split.
- *  @param[in]  req_size  Requested allocation size in bytes.
+ *  Registering a name that already exists returns the existing identifier,
+ *  so subsystems may call this unconditionally at start-up. This includes
+ *  the reserved name "default", which yields MEM_TAG_DEFAULT.
  *
- *  @return Integer status code.
+ *  @param[in]  name      NUL-terminated tag name (truncated to
+ *                        MEM_TAG_NAME_LEN - 1 characters).
  *
- *  @retval EXIT_SUCCESS: Block split (or fully allocated) successfully.
- *  @retval -EINVAL:      nvalid @p allocator or @p block pointer.
- *  @retval -EPROTO:      Header canary mismatch (block corrupted).
- *  @retval -EOVERFLOW:   Data canary mismatch (buffer overflow detected).
- *  @retval -EFBIG:       Block’s size would extend past heap end.
- *  @retval -EFAULT:      Block lies outside heap or mmap regions.
- *  @retval -ENOMEM:      Failed to insert the new free remainder block.
+ *  @return Tag identifier on success (> MEM_TAG_DEFAULT for any name but
+ *          "default"), negative error code on failure.
  *
- *  @note If the remaining space after splitting would be less than
- *        MIN_BLOCK_SIZE, this function allocates the entire block
- *        no split) and removes it from its free list.
+ *  @retval -EINVAL:  @p name is NULL or empty.
+ *  @retval -ENOSPC:  All MEM_MAX_TAGS slots are in use.
  * ========================================================================== */
-static int MEM_splitBlock(mem_allocator_t *const allocator,
-                          block_header_t *const  block,
-                          const size_t           req_size)
+int MEM_registerTag(const char *const name)
 {
   int ret = EXIT_SUCCESS;
 
-  block_header_t *new_block = (block_header_t *)NULL;
+  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
+  mem_tag_t   *tag       = (mem_tag_t *)NULL;
 
-  uintptr_t *data_canary = (uintptr_t *)NULL;
-  uintptr_t  canary_addr = 0u;
+  uint32_t num_tags = 0u;
+  uint32_t iterator = 0u;
 
-  size_t aligned_size   = 0u;
-  size_t total_size     = 0u;
-  size_t remaining_size = 0u;
-  size_t original_size  = 0u;
+  size_t name_len = 0u;
 
-  if (UNLIKELY(allocator == NULL || block == NULL))
+  if (UNLIKELY(name == NULL || name[0] == '\0'))
   {
     ret = -EINVAL;
-    LOG_ERROR("Invalid parameters: allocator %p | block %p. "
+    LOG_ERROR("Invalid tag name: %p. "
               "Error code: %d.\n",
-              (void *)allocator,
-              (void *)block,
+              (const void *)name,
               ret);
     goto function_output;
   }
 
-  ret = MEM_validateBlock(allocator, block);
-  if (ret != EXIT_SUCCESS)
-    goto function_output;
+  if (!g_allocator_inited)
+  {
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
 
-  aligned_size = ALIGN(req_size);
-  total_size
-    = (size_t)(aligned_size + sizeof(block_header_t) + sizeof(uintptr_t));
+    ret = MEM_allocatorInit(&g_allocator);
+    if (ret != EXIT_SUCCESS)
+      goto function_output;
+  }
 
-  ret = MEM_removeFreeBlock(allocator, block);
-  if (ret != EXIT_SUCCESS)
-    goto function_output;
+  gc_thread = &g_allocator.gc_thread;
+  name_len  = strnlen(name, (size_t)(MEM_TAG_NAME_LEN - 1u));
 
-  original_size = block->size;
+  pthread_mutex_lock(&gc_thread->gc_lock);
 
-  if (block->size < total_size + MIN_BLOCK_SIZE)
+  num_tags = atomic_load_explicit(&g_allocator.num_tags, memory_order_relaxed);
+  for (iterator = 0u; iterator < num_tags; ++iterator)
   {
-    block->free   = 0u;
-    block->magic  = MAGIC_NUMBER;
-    block->canary = CANARY_VALUE;
-
-    canary_addr  = (uintptr_t)block + block->size - sizeof(uintptr_t);
-    data_canary  = (uintptr_t *)canary_addr;
-    *data_canary = CANARY_VALUE;
+    tag = &g_allocator.tags[iterator];
+    if ((strncmp(tag->name, name, name_len) == 0)
+        && (tag->name[name_len] == '\0'))
+    {
+      ret = (int)iterator;
+      goto mutex_unlock;
+    }
+  }
 
-    LOG_DEBUG("Using full block %p | Req size: %zu | Block size: %zu.\n",
-              (void *)block,
-              req_size,
-              original_size);
-    goto function_output;
+  if (num_tags >= MEM_MAX_TAGS)
+  {
+    ret = -ENOSPC;
+    LOG_ERROR("Tag registry full (%u tags). "
+              "Error code: %d.\n",
+              (unsigned)MEM_MAX_TAGS,
+              ret);
+    goto mutex_unlock;
   }
 
-  remaining_size = block->size - total_size;
+  tag = &g_allocator.tags[num_tags];
 
-  block->size   = total_size;
-  block->free   = 0u;
-  block->magic  = MAGIC_NUMBER;
-  block->canary = CANARY_VALUE;
+  MEM_memcpy(tag->name, name, name_len);
+  tag->name[name_len] = '\0';
 
-  canary_addr  = (uintptr_t)block + block->size - sizeof(uintptr_t);
-  data_canary  = (uintptr_t *)canary_addr;
-  *data_canary = CANARY_VALUE;
+  atomic_store_explicit(&g_allocator.num_tags,
+                        num_tags + 1u,
+                        memory_order_release);
 
-  new_block = (block_header_t *)((uintptr_t)block + total_size);
+  ret = (int)num_tags;
+  LOG_INFO("Tag registered: '%s' -> %d.\n", tag->name, ret);
 
-  new_block->magic  = MAGIC_NUMBER;
-  new_block->size   = remaining_size;
-  new_block->free   = 1u;
-  new_block->marked = 0u;
-  new_block->file   = (const char *)NULL;
-  new_block->line   = 0ull;
-  new_block->prev   = block;
-  new_block->next   = block->next;
+mutex_unlock:
+  pthread_mutex_unlock(&gc_thread->gc_lock);
+function_output:
+  return ret;
+}
 
-  if (block->next)
-    block->next->prev = new_block;
-  block->next = new_block;
+/** ============================================================================
+ *  @brief  Allocates memory (FIRST_FIT) and charges it to an accounting tag.
+ *
+ *  The tag travels with the block: MEM_free() credits it back and
+ *  MEM_realloc() keeps it on the new block.
+ *
+ *  @param[in]  size      Number of bytes requested.
+ *  @param[in]  tag       Identifier returned by MEM_registerTag().
+ *
+ *  @return Pointer to the allocated user memory on success,
+ *          or an error‐encoded pointer (via PTR_ERR()) on failure.
+ *
+ *  @retval -EINVAL:  @p tag is not registered or @p size is zero.
+ * ========================================================================== */
+void *MEM_allocTagged(const size_t size, const uint32_t tag)
+{
+  void *ret_addr = (void *)NULL;
 
-  new_block->canary = CANARY_VALUE;
-  canary_addr  = (uintptr_t)new_block + new_block->size - sizeof(uintptr_t);
-  data_canary  = (uintptr_t *)canary_addr;
-  *data_canary = CANARY_VALUE;
+  int ret_init = EXIT_SUCCESS;
 
-  new_block->fl_next = (block_header_t *)NULL;
-  new_block->fl_prev = (block_header_t *)NULL;
+  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
 
-  ret = MEM_insertFreeBlock(allocator, new_block);
-  if (ret != EXIT_SUCCESS)
+  if (!g_allocator_inited)
+  {
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
+
+    ret_init = MEM_allocatorInit(&g_allocator);
+    if (ret_init != EXIT_SUCCESS)
+      goto function_output;
+  }
+
+  if (UNLIKELY(tag >= atomic_load_explicit(&g_allocator.num_tags,
+                                           memory_order_acquire)))
+  {
+    ret_addr = PTR_ERR(-EINVAL);
+    LOG_ERROR("Unregistered tag: %u. "
+              "Error code: %d.\n",
+              tag,
+              (int)(intptr_t)ret_addr);
     goto function_output;
+  }
 
-  LOG_DEBUG("Block split | Original: %p (%zu) | Alloc: %p (%zu) | Remainder: "
-            "%p (%zu).\n",
-            (void *)block,
-            original_size,
-            (void *)block,
-            block->size,
-            (void *)new_block,
-            new_block->size);
+  gc_thread = &g_allocator.gc_thread;
+
+  pthread_mutex_lock(&gc_thread->gc_lock);
+  ret_addr
+    = MEM_allocOp(&g_allocator, size, __FILE__, __LINE__, FIRST_FIT, tag);
+  pthread_mutex_unlock(&gc_thread->gc_lock);
+
+  (void)MEM_pressureDispatch(&g_allocator);
+
+#if defined(GARBAGE_COLLECTOR)
+  MEM_gcAssist(&g_allocator, size);
+#endif
 
 function_output:
-  return ret;
+  return ret_addr;
 }
 
 /** ============================================================================
- *  @brief      Merges adjacent free memory blocks.
+ *  @brief  Registers (or looks up) a precise pointer layout.
  *
- *  This function removes the specified @p block from its free list, then checks
- *  its immediate neighbor blocks in memory.  If the next block is free and
- *  valid, it unlinks and combines it with @p block, updating size, links, and
- *  trailing canary.  It then checks the previous block; if it is also free and
- *  valid, it merges @p block into the previous block.  Finally, the resulting
- *  merged block is reinserted into the appropriate free list.
+ *  Bit i of @p bitmap is set when word i of the type holds a heap pointer.
+ *  Registering a layout that already exists returns the existing
+ *  identifier, so each type may be registered unconditionally. A layout
+ *  without pointer words is MEM_LAYOUT_ATOMIC.
  *
- *  @param[in]  allocator Pointer to the allocator context.
- *  @param[in]  block     Pointer to the free block header to merge.
+ *  @param[in]  bitmap    Pointer-word bitmap, (words + 63) / 64 words long.
+ *  @param[in]  words     Size of the type in words.
  *
- *  @return Integer status code.
+ *  @return Layout identifier on success, negative error code on failure.
  *
- *  @retval EXIT_SUCCESS: Blocks merged (or single block reinserted)
- * successfully.
- *  @retval -EINVAL:      @p allocator or @p block is NULL.
- *  @retval ret<0:        Returned by MEM_removeFreeBlock(),
- * MEM_validateBlock(), MEM_insertFreeBlock(), or munmap() in inner calls
- *                        indicating the specific failure.
+ *  @retval -EINVAL:  @p bitmap is NULL or @p words is 0 or above
+ *                    MEM_LAYOUT_MAX_WORDS.
+ *  @retval -ENOSPC:  All MEM_MAX_LAYOUTS slots are in use.
  * ========================================================================== */
-static int MEM_mergeBlocks(mem_allocator_t *const allocator,
-                           block_header_t        *block)
+int MEM_registerLayout(const uint64_t *const bitmap, const size_t words)
 {
   int ret = EXIT_SUCCESS;
 
-  uint8_t *next_addr = (uint8_t *)NULL;
+  gc_thread_t  *gc_thread = (gc_thread_t *)NULL;
+  mem_layout_t *layout    = (mem_layout_t *)NULL;
 
-  block_header_t *next_block = (block_header_t *)NULL;
-  block_header_t *prev_block = (block_header_t *)NULL;
+  mem_layout_t wanted = { 0 };
 
-  uintptr_t *data_canary = (uintptr_t *)NULL;
-  uintptr_t  canary_addr = 0u;
+  uint32_t num_layouts = 0u;
+  uint32_t iterator    = 0u;
 
-  if (UNLIKELY(allocator == NULL || block == NULL))
+  size_t index = 0u;
+
+  bool pointers = false;
+
+  if (UNLIKELY(bitmap == NULL || words == 0u || words > MEM_LAYOUT_MAX_WORDS))
   {
     ret = -EINVAL;
-    LOG_ERROR("Invalid parameters: allocator=%p, block=%p. "
+    LOG_ERROR("Invalid layout: %p, %zu words. "
               "Error code: %d.\n",
-              (void *)allocator,
-              (void *)block,
+              (const void *)bitmap,
+              words,
               ret);
     goto function_output;
   }
 
-  ret = MEM_validateBlock(allocator, block);
-  if (ret != EXIT_SUCCESS)
-    goto function_output;
-
-  next_addr = (uint8_t *)((uint8_t *)block + block->size);
-  if (next_addr + sizeof(block_header_t) <= allocator->heap_end)
+  if (!g_allocator_inited)
   {
-    next_block = (block_header_t *)(uintptr_t)next_addr;
-
-    ret = MEM_validateBlock(allocator, next_block);
-    if (ret == EXIT_SUCCESS && next_block->free)
-    {
-      LOG_DEBUG("Merging blocks (next): cur=%p (%zu) | next=%p (%zu).\n",
-                (void *)((uint8_t *)block + sizeof(block_header_t)),
-                block->size,
-                (void *)((uint8_t *)next_block + sizeof(block_header_t)),
-                next_block->size);
-
-      ret = MEM_removeFreeBlock(allocator, next_block);
-      if (ret != EXIT_SUCCESS)
-        goto function_output;
-
-      block->size += next_block->size;
-      block->next  = next_block->next;
-      if (next_block->next)
-        next_block->next->prev = block;
-
-      canary_addr  = (uintptr_t)block + block->size - sizeof(uintptr_t);
-      data_canary  = (uintptr_t *)canary_addr;
-      *data_canary = CANARY_VALUE;
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
 
-      LOG_DEBUG("Merged(next): payload=%p (%zu).\n",
-                (void *)((uint8_t *)block + sizeof(block_header_t)),
-                block->size);
-    }
+    ret = MEM_allocatorInit(&g_allocator);
+    if (ret != EXIT_SUCCESS)
+      goto function_output;
   }
 
-  prev_block = block->prev;
-  if (prev_block)
+  wanted.words = words;
+  for (index = 0u; index * GC_BITS_PER_WORD < words; ++index)
   {
-    ret = MEM_validateBlock(allocator, prev_block);
-    if (ret == EXIT_SUCCESS && prev_block->free)
-    {
-      LOG_DEBUG("Merging blocks (prev): prev=%p (%zu) | cur=%p (%zu).\n",
-                (void *)((uint8_t *)prev_block + sizeof(block_header_t)),
-                prev_block->size,
-                (void *)((uint8_t *)block + sizeof(block_header_t)),
-                block->size);
+    wanted.bits[index] = bitmap[index];
+    if (words - index * GC_BITS_PER_WORD < GC_BITS_PER_WORD)
+      wanted.bits[index]
+        &= ((uint64_t)1u << (words - index * GC_BITS_PER_WORD)) - 1u;
 
-      ret = MEM_removeFreeBlock(allocator, prev_block);
-      if (ret != EXIT_SUCCESS)
-        goto function_output;
+    pointers = pointers || wanted.bits[index] != 0u;
+  }
 
-      prev_block->size += block->size;
-      prev_block->next  = block->next;
-      if (block->next)
-        block->next->prev = prev_block;
+  if (!pointers)
+  {
+    ret = (int)MEM_LAYOUT_ATOMIC;
+    goto function_output;
+  }
 
-      canary_addr
-        = (uintptr_t)prev_block + prev_block->size - sizeof(uintptr_t);
-      data_canary  = (uintptr_t *)canary_addr;
-      *data_canary = CANARY_VALUE;
+  gc_thread = &g_allocator.gc_thread;
 
-      block = prev_block;
+  pthread_mutex_lock(&gc_thread->gc_lock);
 
-      LOG_DEBUG("Merged(prev): payload=%p (%zu).\n",
-                (void *)((uint8_t *)block + sizeof(block_header_t)),
-                block->size);
+  num_layouts
+    = atomic_load_explicit(&g_allocator.num_layouts, memory_order_relaxed);
+  for (iterator = MEM_LAYOUT_FIRST; iterator < num_layouts; ++iterator)
+  {
+    layout = &g_allocator.layouts[iterator];
+    if (memcmp(layout, &wanted, sizeof(mem_layout_t)) == 0)
+    {
+      ret = (int)iterator;
+      goto mutex_unlock;
     }
   }
 
-  block->fl_next = (block_header_t *)NULL;
-  block->fl_prev = (block_header_t *)NULL;
+  if (num_layouts >= MEM_MAX_LAYOUTS)
+  {
+    ret = -ENOSPC;
+    LOG_ERROR("Layout registry full (%u layouts). "
+              "Error code: %d.\n",
+              (unsigned)MEM_MAX_LAYOUTS,
+              ret);
+    goto mutex_unlock;
+  }
+
+  g_allocator.layouts[num_layouts] = wanted;
 
-  ret = MEM_insertFreeBlock(allocator, block);
-  if (ret != EXIT_SUCCESS)
-    goto function_output;
+  atomic_store_explicit(&g_allocator.num_layouts,
+                        num_layouts + 1u,
+                        memory_order_release);
+
+  ret = (int)num_layouts;
+  LOG_INFO("Layout registered: %zu words -> %d.\n", words, ret);
 
+mutex_unlock:
+  pthread_mutex_unlock(&gc_thread->gc_lock);
 function_output:
   return ret;
 }
 
 /** ============================================================================
- *  @brief  Allocates memory using the specified strategy.
+ *  @brief  Allocates memory (FIRST_FIT) with a precise pointer layout.
  *
- *  This function attempts to allocate at least @p size bytes of user data by
- *  choosing between heap‐based allocation (via free‐lists and optional heap
- *  growth) or mmap (for large requests > MMAP_THRESHOLD).  It uses the
- *  given @p strategy (FIRST_FIT, NEXT_FIT, BEST_FIT) to locate a free block,
- *  grows the heap if necessary, splits a larger block to fit exactly, and
- *  records debugging metadata (source file, line).  For mmap
- *  allocations it rounds up to page size and tracks the region in the
- * allocator.
+ *  The layout is set in the block header after MEM_allocOp(), under
+ *  gc_lock, so no collection sees the block without it. The collector then
+ *  follows only the pointer words of the layout, repeated over the payload.
  *
- *  @param[in]  allocator Memory allocator context.
  *  @param[in]  size      Number of bytes requested.
- *  @param[in]  file      Source file name for debugging metadata.
- *  @param[in]  line      Source line number for debugging metadata.
- *  @param[in]  strategy  Allocation strategy.
+ *  @param[in]  layout    MEM_LAYOUT_* constant or identifier returned by
+ *                        MEM_registerLayout().
  *
- *  @return Pointer to the start of the allocated user region (just past
- *          the internal header) on success; an error‐encoded pointer
- *          (via PTR_ERR()) on failure.
+ *  @return Pointer to the allocated user memory on success,
+ *          or an error‐encoded pointer (via PTR_ERR()) on failure.
  *
- *  @retval ptr:      Valid user pointer on success.
- *  @retval -EINVAL:  @p allocator is NULL or @p size is zero.
- *  @retval -ENOMEM:  Out of memory: heap grow failed, no free
- *                    block found, or internal metadata allocation
- *                    (e.g. mmap_t node) failed.
- *  @retval -EIO:     mmap() I/O error for large allocations.
+ *  @retval -EINVAL:  @p layout is not registered or @p size is zero.
  * ========================================================================== */
-static void *MEM_allocOp(mem_allocator_t *const      allocator,
-                         const size_t                size,
-                         const char *const           file,
-                         const int                   line,
-                         const allocation_strategy_t strategy)
+void *MEM_allocTyped(const size_t size, const uint32_t layout)
 {
-  void *user_ptr = (void *)NULL;
-
-  mem_arena_t    *arena = (mem_arena_t *)NULL;
-  block_header_t *block = (block_header_t *)NULL;
-
-  void *old_brk  = (void *)NULL;
-  void *raw_mmap = (void *)NULL;
+  void *ret_addr = (void *)NULL;
 
-  uintptr_t *data_canary = (uintptr_t *)NULL;
-  uintptr_t  canary_addr = 0u;
+  int ret_init = EXIT_SUCCESS;
 
-  size_t total_size = 0u;
+  gc_thread_t    *gc_thread = (gc_thread_t *)NULL;
+  block_header_t *block     = (block_header_t *)NULL;
 
-  int ret = EXIT_SUCCESS;
+  if (!g_allocator_inited)
+  {
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
 
-  const find_fn_t find_fns[] = {
-    [FIRST_FIT] = MEM_findFirstFit,
-    [NEXT_FIT]  = MEM_findNextFit,
-    [BEST_FIT]  = MEM_findBestFit,
-  };
+    ret_init = MEM_allocatorInit(&g_allocator);
+    if (ret_init != EXIT_SUCCESS)
+      goto function_output;
+  }
 
-  if (UNLIKELY(allocator == NULL || size <= 0))
+  if (UNLIKELY(layout >= atomic_load_explicit(&g_allocator.num_layouts,
+                                              memory_order_acquire)))
   {
-    user_ptr = PTR_ERR(-EINVAL);
-    LOG_ERROR("Invalid arguments: allocator=%p | size=%zu. "
+    ret_addr = PTR_ERR(-EINVAL);
+    LOG_ERROR("Unregistered layout: %u. "
               "Error code: %d.\n",
-              (void *)allocator,
-              size,
-              (int)(intptr_t)user_ptr);
-    goto null_pointer;
+              layout,
+              (int)(intptr_t)ret_addr);
+    goto function_output;
   }
 
-  total_size = ALIGN(size) + sizeof(block_header_t) + sizeof(uintptr_t);
-  arena      = &allocator->arenas[0];
+  gc_thread = &g_allocator.gc_thread;
 
-  if (size > MMAP_THRESHOLD)
+  pthread_mutex_lock(&gc_thread->gc_lock);
+  ret_addr = MEM_allocOp(&g_allocator,
+                         size,
+                         __FILE__,
+                         __LINE__,
+                         FIRST_FIT,
+                         MEM_TAG_DEFAULT);
+  if (ret_addr != NULL && (intptr_t)ret_addr > 0)
   {
-    raw_mmap = MEM_mapAlloc(allocator, total_size);
-    if (raw_mmap == NULL)
-    {
-      user_ptr = PTR_ERR(-ENOMEM);
-      LOG_ERROR("Mmap failed: %zu bytes. Error code: %d.\n",
-                total_size,
-                (int)(intptr_t)user_ptr);
-      goto function_output;
-    }
+    block = (block_header_t *)((uintptr_t)ret_addr - sizeof(block_header_t));
+    block->layout = layout;
+  }
+  pthread_mutex_unlock(&gc_thread->gc_lock);
 
-    block = (block_header_t *)raw_mmap;
+  (void)MEM_pressureDispatch(&g_allocator);
 
-    block->magic  = MAGIC_NUMBER;
-    block->size   = total_size;
-    block->free   = 0u;
-    block->marked = 0u;
-    block->next   = (block_header_t *)NULL;
-    block->prev   = (block_header_t *)NULL;
-    block->canary = CANARY_VALUE;
+#if defined(GARBAGE_COLLECTOR)
+  MEM_gcAssist(&g_allocator, size);
+#endif
 
-    canary_addr  = (uintptr_t)block + total_size - sizeof(uintptr_t);
-    data_canary  = (uintptr_t *)canary_addr;
-    *data_canary = CANARY_VALUE;
+function_output:
+  return ret_addr;
+}
 
-    block->file = file;
-    block->line = (uint64_t)line;
+/** ============================================================================
+ *  @brief  Allocates memory (FIRST_FIT) that never holds heap pointers.
+ *
+ *  Shorthand for MEM_allocTyped() with MEM_LAYOUT_ATOMIC: the collector
+ *  marks the block when it is referenced but never scans its payload.
+ *
+ *  @param[in]  size      Number of bytes requested.
+ *
+ *  @return Pointer to the allocated user memory on success,
+ *          or an error‐encoded pointer (via PTR_ERR()) on failure.
+ * ========================================================================== */
+void *MEM_allocAtomic(const size_t size)
+{
+  return MEM_allocTyped(size, MEM_LAYOUT_ATOMIC);
+}
 
-    LOG_INFO("Mmap used for alloc: %p (%zu bytes).\n", raw_mmap, size);
-    user_ptr = (uint8_t *)raw_mmap + sizeof(block_header_t);
-    goto function_output;
-  }
+/** ============================================================================
+ *  @brief  Sets or clears the soft limit of an accounting tag.
+ *
+ *  Allocations that leave the tag above @p soft_limit still succeed; they
+ *  are counted in mem_tag_stats_t::limit_hits and a warning is logged when
+ *  the limit is first crossed.
+ *
+ *  @param[in]  tag         Identifier returned by MEM_registerTag().
+ *  @param[in]  soft_limit  Limit in payload bytes, or 0 to disable.
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ *
+ *  @retval -EINVAL:  @p tag is not registered.
+ * ========================================================================== */
+int MEM_setTagLimit(const uint32_t tag, const size_t soft_limit)
+{
+  int ret = EXIT_SUCCESS;
 
-  ret = find_fns[strategy](allocator, total_size, &block);
-  if (ret == -ENOMEM)
+  if (!g_allocator_inited)
   {
-    old_brk = MEM_growUserHeap(allocator, (intptr_t)total_size);
-    if ((intptr_t)old_brk < 0)
-    {
-      user_ptr = PTR_ERR(-ENOMEM);
-      LOG_ERROR("Heap grow failed: requested %zu bytes, old_brk=%ld. "
-                "Error code: %d.\n",
-                total_size,
-                (long)old_brk,
-                (int)(intptr_t)user_ptr);
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
+
+    ret = MEM_allocatorInit(&g_allocator);
+    if (ret != EXIT_SUCCESS)
       goto function_output;
-    }
+  }
 
-    allocator->last_brk_start = (uint8_t *)((uint8_t *)old_brk);
-    allocator->last_brk_end   = (uint8_t *)((uint8_t *)old_brk + total_size);
+  if (UNLIKELY(tag >= atomic_load_explicit(&g_allocator.num_tags,
+                                           memory_order_acquire)))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Unregistered tag: %u. "
+              "Error code: %d.\n",
+              tag,
+              ret);
+    goto function_output;
+  }
 
-    block = (block_header_t *)old_brk;
+  atomic_store_explicit(&g_allocator.tags[tag].soft_limit,
+                        soft_limit,
+                        memory_order_relaxed);
 
-    block->magic  = MAGIC_NUMBER;
-    block->size   = total_size;
-    block->free   = 1u;
-    block->marked = 0u;
-    block->next   = (block_header_t *)NULL;
-    block->prev   = (block_header_t *)NULL;
-    block->canary = CANARY_VALUE;
+function_output:
+  return ret;
+}
 
-    canary_addr  = (uintptr_t)block + total_size - sizeof(uintptr_t);
-    data_canary  = (uintptr_t *)canary_addr;
-    *data_canary = CANARY_VALUE;
+/** ============================================================================
+ *  @brief  Reads the accounting counters of a tag.
+ *
+ *  Counters are summed from per-thread shards without taking the allocator
+ *  lock, and the shard high-water marks are folded into peak_bytes
+ *  (MEM_tagPeak()). alloc_rate is computed against the previous call for
+ *  the same tag.
+ *
+ *  @param[in]  tag       Identifier returned by MEM_registerTag().
+ *  @param[out] stats     Destination snapshot.
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ *
+ *  @retval -EINVAL:  @p tag is not registered or @p stats is NULL.
+ * ========================================================================== */
+int MEM_getTagStats(const uint32_t tag, mem_tag_stats_t *const stats)
+{
+  int ret = EXIT_SUCCESS;
 
-    block->fl_next = (block_header_t *)NULL;
-    block->fl_prev = (block_header_t *)NULL;
+  mem_tag_t *entry = (mem_tag_t *)NULL;
 
-    ret = MEM_insertFreeBlock(allocator, block);
+  struct timespec now = { 0 };
+
+  uint64_t now_ns     = 0u;
+  uint64_t prev_ns    = 0u;
+  uint64_t prev_bytes = 0u;
+
+  if (UNLIKELY(stats == NULL))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid stats pointer: %p. "
+              "Error code: %d.\n",
+              (void *)stats,
+              ret);
+    goto function_output;
+  }
+
+  if (!g_allocator_inited)
+  {
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
+
+    ret = MEM_allocatorInit(&g_allocator);
     if (ret != EXIT_SUCCESS)
       goto function_output;
-
-    ret = find_fns[strategy](allocator, total_size, &block);
   }
 
-  if (ret != EXIT_SUCCESS)
+  if (UNLIKELY(tag >= atomic_load_explicit(&g_allocator.num_tags,
+                                           memory_order_acquire)))
   {
-    user_ptr = PTR_ERR((ret == -ENOMEM) ? -ENOMEM : -EIO);
+    ret = -EINVAL;
+    LOG_ERROR("Unregistered tag: %u. "
+              "Error code: %d.\n",
+              tag,
+              ret);
     goto function_output;
   }
 
-  if (strategy == NEXT_FIT)
-    allocator->last_allocated = block;
+  entry = &g_allocator.tags[tag];
 
-  arena->top_chunk = block;
+  MEM_memset(stats, 0, sizeof(*stats));
+  MEM_tagSum(entry, stats);
+  MEM_tagPeak(entry, stats->live_bytes);
 
-  ret = MEM_splitBlock(allocator, block, size);
-  if (ret != EXIT_SUCCESS)
-    goto function_output;
+  stats->peak_bytes
+    = atomic_load_explicit(&entry->peak_bytes, memory_order_relaxed);
+  stats->soft_limit
+    = atomic_load_explicit(&entry->soft_limit, memory_order_relaxed);
+  stats->limit_hits
+    = atomic_load_explicit(&entry->limit_hits, memory_order_relaxed);
 
-  block->file = file;
-  block->line = (uint64_t)line;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  now_ns = (uint64_t)now.tv_sec * NSEC_PER_SEC + (uint64_t)now.tv_nsec;
 
-  user_ptr = (void *)((uint8_t *)block + sizeof(block_header_t));
+  prev_ns = atomic_exchange_explicit(&entry->rate_ns,
+                                     now_ns,
+                                     memory_order_relaxed);
+  prev_bytes = atomic_exchange_explicit(&entry->rate_bytes,
+                                        stats->total_bytes,
+                                        memory_order_relaxed);
+
+  if ((prev_ns != 0u) && (now_ns > prev_ns)
+      && (stats->total_bytes >= prev_bytes))
+  {
+    stats->alloc_rate
+      = (uint64_t)((double)(stats->total_bytes - prev_bytes)
+                   * (double)NSEC_PER_SEC / (double)(now_ns - prev_ns));
+  }
 
 function_output:
+  return ret;
+}
 
-#ifdef RUNNING_ON_VALGRIND
-  VALGRIND_MEMPOOL_ALLOC(allocator,
-                         user_ptr,
-                         block ? (block->size - sizeof(block_header_t)
-                                  - sizeof(uintptr_t))
-                               : 0);
-#endif
+/** ============================================================================
+ *  @brief  Sets the soft and hard footprint limits of the allocator.
+ *
+ *  The footprint is the size of the user heap plus every mmap region. Limits
+ *  are only evaluated when the allocator asks the kernel for more memory.
+ *  Crossing @p soft runs the MEM_onPressure() callbacks followed by
+ *  MEM_trim(); a request that would exceed @p hard fails with -ENOMEM.
+ *  Passing 0 for both falls back to the soft limit derived from the cgroup
+ *  (see MEM_cgroupRefresh()), if any; no hard limit is derived from it.
+ *
+ *  @param[in]  soft      Soft limit in bytes, or 0 to disable.
+ *  @param[in]  hard      Hard limit in bytes, or 0 to disable.
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ *
+ *  @retval -EINVAL:  Both limits set and @p soft is above @p hard.
+ * ========================================================================== */
+int MEM_setLimit(const size_t soft, const size_t hard)
+{
+  int ret = EXIT_SUCCESS;
 
-null_pointer:
-  return user_ptr;
+  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
+
+  if (UNLIKELY(soft != 0u && hard != 0u && soft > hard))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid limits: soft=%zu | hard=%zu. "
+              "Error code: %d.\n",
+              soft,
+              hard,
+              ret);
+    goto function_output;
+  }
+
+  if (!g_allocator_inited)
+  {
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
+
+    ret = MEM_allocatorInit(&g_allocator);
+    if (ret != EXIT_SUCCESS)
+      goto function_output;
+  }
+
+  gc_thread = &g_allocator.gc_thread;
+
+  pthread_mutex_lock(&gc_thread->gc_lock);
+  g_allocator.limits.soft_limit = soft;
+  g_allocator.limits.hard_limit = hard;
+  g_allocator.limits.user_set   = (soft != 0u || hard != 0u);
+  g_allocator.limits.over_soft  = false;
+
+  if (!g_allocator.limits.user_set && g_allocator.cgroup.enabled)
+  {
+    g_allocator.limits.soft_limit = g_allocator.cgroup.soft_limit;
+    g_allocator.limits.hard_limit = 0u;
+  }
+  pthread_mutex_unlock(&gc_thread->gc_lock);
+
+  LOG_INFO("Footprint limits set: soft=%zu | hard=%zu.\n", soft, hard);
+
+function_output:
+  return ret;
 }
 
 /** ============================================================================
- *  @brief  Reallocates memory with safety checks.
- *
- *  This function resizes an existing allocation to @p new_size bytes:
- *    - If @p ptr is NULL, behaves like malloc().
- *    - If the existing block is already large enough, returns the same pointer.
- *    - Otherwise, allocates a new block with the specified @p strategy,
- *      copies the lesser of old and new sizes, frees the old block, and
- *      returns the new pointer.
+ *  @brief  Registers a memory pressure callback.
  *
- *  @param[in]  allocator Memory allocator context.
- *  @param[in]  ptr       Pointer to the block to resize, or NULL to allocate.
- *  @param[in]  new_size  New requested size in bytes.
- *  @param[in]  file      Source file name for debugging metadata.
- *  @param[in]  line      Source line number for debugging metadata.
- *  @param[in]  strategy  Allocation strategy to use.
+ *  @param[in]  callback  Function run on soft/hard limit events.
+ *  @param[in]  arg       User pointer handed back to @p callback.
  *
- *  @return Pointer to the reallocated memory region (which may be the same
- *          as @p ptr) on success; an error-encoded pointer (via PTR_ERR())
- *          on failure.
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
  *
- *  @retval ptr:      Valid pointer to a block of at least @p new_size bytes.
- *  @retval -EINVAL:  @p allocator is NULL, @p new_size is zero.
- *  @retval -ENOMEM:  Out of memory (allocation or free failure).
- *  @retval -EIO:     I/O error for large mmap-based allocations.
+ *  @retval -EINVAL:  @p callback is NULL.
+ *  @retval -ENOSPC:  MEM_MAX_PRESSURE_CBS callbacks already registered.
  * ========================================================================== */
-static void *MEM_reallocOp(mem_allocator_t *const      allocator,
-                           void *const                 ptr,
-                           const size_t                new_size,
-                           const char *const           file,
-                           const int                   line,
-                           const allocation_strategy_t strategy)
+int MEM_onPressure(const mem_pressure_cb_t callback, void *const arg)
 {
   int ret = EXIT_SUCCESS;
 
-  void *new_ptr = (void *)NULL;
-  ;
-
-  block_header_t *old_block = (block_header_t *)NULL;
-  ;
-
-  size_t old_size = 0u;
+  gc_thread_t  *gc_thread = (gc_thread_t *)NULL;
+  mem_limits_t *limits    = (mem_limits_t *)NULL;
 
-  if (UNLIKELY(allocator == NULL || new_size <= 0))
+  if (UNLIKELY(callback == NULL))
   {
-    new_ptr = PTR_ERR(-EINVAL);
-    LOG_ERROR("Invalid arguments: allocator=%p | size=%zu. "
+    ret = -EINVAL;
+    LOG_ERROR("Invalid pressure callback: %p. "
               "Error code: %d.\n",
-              (void *)allocator,
-              new_size,
-              (int)(intptr_t)new_ptr);
+              (void *)(uintptr_t)callback,
+              ret);
     goto function_output;
   }
 
-  if (ptr == NULL)
+  if (!g_allocator_inited)
   {
-    new_ptr = MEM_allocOp(allocator, new_size, file, line, strategy);
-    goto function_output;
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
+
+    ret = MEM_allocatorInit(&g_allocator);
+    if (ret != EXIT_SUCCESS)
+      goto function_output;
   }
 
-  old_block = (block_header_t *)((uintptr_t)ptr - sizeof(block_header_t));
+  gc_thread = &g_allocator.gc_thread;
+  limits    = &g_allocator.limits;
 
-  ret = MEM_validateBlock(allocator, old_block);
-  if (ret != EXIT_SUCCESS)
-    goto function_output;
+  pthread_mutex_lock(&gc_thread->gc_lock);
 
-  old_size
-    = (size_t)(old_block->size - sizeof(block_header_t) - sizeof(uintptr_t));
-  if (old_size >= new_size)
+  if (limits->num_cbs >= MEM_MAX_PRESSURE_CBS)
   {
-    LOG_DEBUG("Reallocation not needed: "
-              "Addr: %p | Current size: %zu | New size: %zu.\n",
-              ptr,
-              old_size,
-              new_size);
-    new_ptr = ptr;
-    goto function_output;
+    ret = -ENOSPC;
+    LOG_ERROR("Pressure callback table full (%u entries). "
+              "Error code: %d.\n",
+              (unsigned)MEM_MAX_PRESSURE_CBS,
+              ret);
+    goto mutex_unlock;
   }
 
-  new_ptr = MEM_allocOp(allocator, new_size, file, line, strategy);
-  if (new_ptr != NULL)
+  limits->cbs[limits->num_cbs]     = callback;
+  limits->cb_args[limits->num_cbs] = arg;
+  limits->num_cbs++;
+
+mutex_unlock:
+  pthread_mutex_unlock(&gc_thread->gc_lock);
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Returns free memory to the kernel.
+ *
+ *  Releases a free block sitting at the top of the heap through sbrk() and
+ *  applies madvise(MADV_DONTNEED) to the page-aligned interior of the other
+ *  free blocks. Block headers and canaries are left resident.
+ *
+ *  @return Number of bytes released (>= 0) on success,
+ *          negative error code on failure.
+ * ========================================================================== */
+intptr_t MEM_trim(void)
+{
+  intptr_t ret = 0;
+
+  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
+
+  if (!g_allocator_inited)
   {
-    if (MEM_memcpy(new_ptr, ptr, old_size) != new_ptr)
-    {
-      new_ptr = PTR_ERR(-EINVAL);
-      goto function_output;
-    }
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
 
-    ret = MEM_freeOp(allocator, ptr, file, line);
+    ret = (intptr_t)MEM_allocatorInit(&g_allocator);
     if (ret != EXIT_SUCCESS)
       goto function_output;
-
-    LOG_INFO("Reallocated: Old: %p (%zu bytes) | New: %p (%zu bytes).\n",
-             ptr,
-             old_size,
-             new_ptr,
-             new_size);
   }
 
+  gc_thread = &g_allocator.gc_thread;
+
+  pthread_mutex_lock(&gc_thread->gc_lock);
+  ret = MEM_trimOp(&g_allocator);
+  pthread_mutex_unlock(&gc_thread->gc_lock);
+
 function_output:
-  return new_ptr;
+  return ret;
 }
 
 /** ============================================================================
- *  @brief  Allocates and zero‐initializes memory.
+ *  @brief  Re-reads the cgroup v2 memory files and re-derives the tuning.
  *
- *  This function behaves like calloc(), allocating at least @p size bytes of
- *  zeroed memory via MEM_allocOp() and then setting all bytes to zero.
- *  It records debugging metadata (source file, line) and uses
- *  the given @p strategy for allocation.
+ *  The allocator reads its cgroup once at initialisation and again every
+ *  mem_cgroup_info_t::refresh_ms, from the garbage collector thread while
+ *  it runs, from the PSI monitor thread while it runs (MEM_psiMonitorStart())
+ *  and from the growth path otherwise. This call forces a
+ *  refresh, optionally switching to another cgroup directory. Limits set
+ *  through MEM_setLimit() take precedence over the derived soft limit, and
+ *  the derived GC cadence is then left alone. The derived hard level is
+ *  only reported; a hard cap needs MEM_setLimit().
  *
- *  @param[in]  allocator Pointer to the mem_allocator_t context.
- *  @param[in]  size      Number of bytes to allocate.
- *  @param[in]  file      Source file name for debugging metadata.
- *  @param[in]  line      Source line number for debugging metadata.
- *  @param[in]  strategy  Allocation strategy to use.
+ *  @param[in]  dir       cgroup directory, or NULL to keep the current one.
  *
- *  @return Pointer to the start of the allocated zeroed region;
- *          an error‐encoded pointer via PTR_ERR() on failure.
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
  *
- *  @retval ptr:      Valid pointer to @p size bytes of zeroed memory.
- *  @retval -EINVAL:  @p allocator is NULL or @p size is zero.
- *  @retval -ENOMEM:  Out of memory: allocation failed.
- *  @retval -EIO:     I/O error for large mmap‐based allocations.
+ *  @retval -ENOENT:        memory.max or memory.current cannot be read.
+ *  @retval -EINVAL:        A file holds an unparsable value.
+ *  @retval -ENAMETOOLONG:  @p dir does not fit in PATH_MAX.
  * ========================================================================== */
-static void *MEM_callocOp(mem_allocator_t *const      allocator,
-                          const size_t                size,
-                          const char *const           file,
-                          const int                   line,
-                          const allocation_strategy_t strategy)
+int MEM_cgroupRefresh(const char *const dir)
 {
-  void *ptr = (void *)NULL;
-  ;
+  int ret = EXIT_SUCCESS;
 
-  block_header_t *block = (block_header_t *)NULL;
-  ;
+  gc_thread_t  *gc_thread = (gc_thread_t *)NULL;
+  mem_cgroup_t *cgroup    = (mem_cgroup_t *)NULL;
 
-  size_t data_size = 0u;
+  size_t dir_len = 0u;
 
-  if (UNLIKELY(allocator == NULL || size == 0))
+  if (!g_allocator_inited)
   {
-    ptr = PTR_ERR(-EINVAL);
-    LOG_ERROR("Invalid arguments: allocator=%p | size=%zu. "
-              "Error code: %d.\n",
-              (void *)allocator,
-              size,
-              (int)(intptr_t)ptr);
-    goto function_output;
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
+
+    ret = MEM_allocatorInit(&g_allocator);
+    if (ret != EXIT_SUCCESS)
+      goto function_output;
   }
 
-  ptr = MEM_allocOp(allocator, size, file, line, strategy);
-  if (ptr == NULL)
-    goto function_output;
+  gc_thread = &g_allocator.gc_thread;
+  cgroup    = &g_allocator.cgroup;
 
-  block = (block_header_t *)((uintptr_t)ptr - sizeof(block_header_t));
-  data_size
-    = (size_t)(block->size - sizeof(block_header_t) - sizeof(uintptr_t));
+  if (dir != NULL)
+  {
+    dir_len = strnlen(dir, (size_t)PATH_MAX);
+    if (dir_len == 0u || dir_len >= (size_t)PATH_MAX)
+    {
+      ret = -ENAMETOOLONG;
+      LOG_ERROR("Invalid cgroup directory length: %zu. "
+                "Error code: %d.\n",
+                dir_len,
+                ret);
+      goto function_output;
+    }
+  }
 
-  MEM_memset(ptr, 0, data_size);
+  pthread_mutex_lock(&gc_thread->gc_lock);
 
-  LOG_DEBUG("Zero-initialized memory: addr: %p (%zu bytes).\n", ptr, size);
+  if (dir != NULL)
+  {
+    MEM_memcpy(cgroup->dir, dir, dir_len);
+    cgroup->dir[dir_len] = '\0';
+  }
+  else if (cgroup->dir[0] == '\0')
+  {
+    ret = MEM_cgroupResolve(cgroup->dir);
+    if (ret != EXIT_SUCCESS)
+      goto mutex_unlock;
+  }
+
+  ret = MEM_cgroupLoad(&g_allocator);
+
+mutex_unlock:
+  pthread_mutex_unlock(&gc_thread->gc_lock);
+
+  (void)MEM_pressureDispatch(&g_allocator);
 
 function_output:
-  return ptr;
+  return ret;
 }
 
 /** ============================================================================
- *  @brief  Releases allocated memory back to the heap.
- *
- *  This function frees a pointer previously returned by MEM_allocOp().
- *  It supports both heap‐based and mmap‐based allocations:
- *    - For mmap regions, it delegates to MEM_mapFree() to unmap and remove
- metadata.
- *    - For heap blocks, it validates the block, checks for double frees,
- *      marks the block free, merges with adjacent free blocks, and reinserts
- *      the merged block into the free list.  If the freed block lies at the
- *      current heap end, it shrinks the heap via MEM_sbrk().
+ *  @brief  Reads the last cgroup snapshot and derived tuning.
  *
- *  @param[in]  allocator Memory allocator context.
- *  @param[in]  ptr       Pointer to memory to free.
- *  @param[in]  file      Source file name for debugging metadata.
- *  @param[in]  line      Source line number for debugging metadata.
+ *  @param[out] info      Destination snapshot.
  *
- *  @return Integer status code.
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
  *
- *  @retval EXIT_SUCCESS: Memory freed (and heap possibly shrunk) successfully.
- *  @retval -EINVAL:      @p allocator or @p ptr is NULL, @p ptr not found in
-                          @p allocator, or double free detected.
- *  @retval -ENOMEM:      munmap() failed when freeing an mmap region.
- *  @retval -EFAULT:      Block lies outside heap and mmap regions.
- *  @retval -EPROTO:      Header canary mismatch (block corrupted).
- *  @retval -EOVERFLOW:   Data canary mismatch (buffer overrun detected).
- *  @retval -EFBIG:       Block size extends past heap end.
- *  @retval rer<0:        Errors returned by MEM_validateBlock(),
- *                        MEM_removeFreeBlock(), MEM_mergeBlocks(),
- *                        or MEM_insertFreeBlock().
+ *  @retval -EINVAL:  @p info is NULL.
+ *  @retval -ENOENT:  No cgroup v2 memory controller was found.
  * ========================================================================== */
-static int MEM_freeOp(mem_allocator_t *const allocator,
-                      void *const            ptr,
-                      const char *const      file,
-                      const int              line)
+int MEM_getCgroupInfo(mem_cgroup_info_t *const info)
 {
   int ret = EXIT_SUCCESS;
 
-  block_header_t *block = (block_header_t *)NULL;
-  mmap_t         *map   = (mmap_t *)NULL;
+  gc_thread_t  *gc_thread = (gc_thread_t *)NULL;
+  mem_cgroup_t *cgroup    = (mem_cgroup_t *)NULL;
 
-  void *old = (void *)NULL;
+  if (UNLIKELY(info == NULL))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid parameters: info=%p. "
+              "Error code: %d.\n",
+              (void *)info,
+              ret);
+    goto function_output;
+  }
 
-  uint8_t *block_end = (uint8_t *)NULL;
+  if (!g_allocator_inited)
+  {
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
 
-  uint8_t *cur_brk = (uint8_t *)NULL;
+    ret = MEM_allocatorInit(&g_allocator);
+    if (ret != EXIT_SUCCESS)
+      goto function_output;
+  }
 
-  intptr_t delta = 0;
+  gc_thread = &g_allocator.gc_thread;
+  cgroup    = &g_allocator.cgroup;
 
-  size_t shrink_size = 0u;
-  size_t freed_size  = 0u;
-  size_t lease       = 0u;
+  pthread_mutex_lock(&gc_thread->gc_lock);
 
-  if (UNLIKELY(allocator == NULL || ptr == NULL))
+  if (!cgroup->enabled)
   {
-    ret = -EINVAL;
-    LOG_ERROR("Invalid parameters: allocator: %p | ptr: %p. "
-              "Error code: %d.\n",
-              (void *)allocator,
-              ptr,
-              ret);
-    goto function_output;
+    ret = -ENOENT;
+    goto mutex_unlock;
   }
 
-  block = (block_header_t *)((uintptr_t)ptr - sizeof(block_header_t));
-  for (map = allocator->mmap_list; map; map = map->next)
-  {
-    if ((void *)block == map->addr)
-    {
-      ret = MEM_mapFree(allocator, map->addr);
-      goto function_output;
-    }
-  }
+  info->max            = cgroup->max;
+  info->current        = cgroup->current;
+  info->soft_limit     = cgroup->soft_limit;
+  info->hard_limit     = cgroup->hard_limit;
+  info->cache_budget   = cgroup->cache_budget;
+  info->gc_interval_ms = gc_thread->gc_interval_ms;
+  info->refresh_ms     = cgroup->refresh_ms;
+
+mutex_unlock:
+  pthread_mutex_unlock(&gc_thread->gc_lock);
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Starts the memory pressure-stall (PSI) monitor thread.
+ *
+ *  Registers the trigger "some <stall_us> <window_us>" on
+ *  /proc/pressure/memory and blocks in poll() until the kernel reports that
+ *  tasks stalled on memory for @p stall_us within @p window_us. Each event
+ *  runs the MEM_onPressure() callbacks, trims the heap and wakes the
+ *  garbage collector. While a cgroup is tracked the thread also wakes every
+ *  mem_cgroup_info_t::refresh_ms to refresh it (see MEM_cgroupRefresh()).
+ *
+ *  Unprivileged processes need @p window_us to be a multiple of 2 s.
+ *
+ *  @param[in]  stall_us  Stall threshold in microseconds.
+ *  @param[in]  window_us Tracking window in microseconds.
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ *
+ *  @retval -EINVAL:    @p stall_us is 0 or above @p window_us.
+ *  @retval -EALREADY:  The monitor is already running.
+ *  @retval -ENOTSUP:   The kernel does not expose PSI.
+ *  @retval ret<0:      Negated errno of a refused trigger or thread creation.
+ * ========================================================================== */
+int MEM_psiMonitorStart(const uint32_t stall_us, const uint32_t window_us)
+{
+  int ret = EXIT_SUCCESS;
+  int fd  = -1;
+
+  int wake[2] = { -1, -1 };
 
-  block = (block_header_t *)((uintptr_t)ptr - sizeof(block_header_t));
+  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
+  mem_psi_t   *psi       = (mem_psi_t *)NULL;
 
-  ret = MEM_validateBlock(allocator, block);
-  if (ret != EXIT_SUCCESS)
-    goto function_output;
+  char trigger[64] = { 0 };
+  int  len         = 0;
 
-  if (block->free)
+  if (UNLIKELY(stall_us == 0u || stall_us > window_us))
   {
     ret = -EINVAL;
-    LOG_ERROR("Double free on a freed block (%p). "
+    LOG_ERROR("Invalid PSI trigger: stall=%u us | window=%u us. "
               "Error code: %d.\n",
-              ptr,
+              stall_us,
+              window_us,
               ret);
     goto function_output;
   }
 
-#ifdef RUNNING_ON_VALGRIND
-  VALGRIND_MEMPOOL_FREE(allocator, ptr);
-#endif
+  if (!g_allocator_inited)
+  {
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
 
-  block->free   = 1u;
-  block->marked = 0u;
-  block->file   = file;
-  block->line   = (uint64_t)line;
+    ret = MEM_allocatorInit(&g_allocator);
+    if (ret != EXIT_SUCCESS)
+      goto function_output;
+  }
 
-  ret = MEM_mergeBlocks(allocator, block);
-  if (ret != EXIT_SUCCESS)
-    goto function_output;
+  gc_thread = &g_allocator.gc_thread;
+  psi       = &g_allocator.psi;
 
-  block_end = (uint8_t *)block + block->size;
+  pthread_mutex_lock(&gc_thread->gc_lock);
 
-  if (block_end == allocator->heap_end)
+  if (psi->running)
   {
-    cur_brk = (uint8_t *)sbrk(0);
+    ret = -EALREADY;
+    goto mutex_unlock;
+  }
 
-    if (cur_brk == allocator->heap_end && allocator->last_brk_start != NULL
-        && allocator->last_brk_end != NULL
-        && allocator->last_brk_end == allocator->heap_end)
-    {
-      lease = (size_t)(allocator->last_brk_end - allocator->last_brk_start);
+  fd = open(PSI_MEMORY_PATH, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+  if (fd < 0)
+  {
+    ret = (errno == ENOENT) ? -ENOTSUP : -errno;
+    LOG_WARNING("PSI unavailable (%s). "
+                "Error code: %d.\n",
+                PSI_MEMORY_PATH,
+                ret);
+    goto mutex_unlock;
+  }
 
-      if (lease > 0u && block->size >= lease)
-      {
-        ret = MEM_removeFreeBlock(allocator, block);
-        if (ret != EXIT_SUCCESS)
-          goto function_output;
+  len = snprintf(trigger, sizeof(trigger), "some %u %u", stall_us, window_us);
+  if (write(fd, trigger, (size_t)len + 1u) < 0)
+  {
+    ret = -errno;
+    LOG_WARNING("PSI trigger '%s' refused. "
+                "Error code: %d.\n",
+                trigger,
+                ret);
+    goto close_fds;
+  }
 
-        shrink_size = lease;
-        delta       = -(intptr_t)shrink_size;
+  if (pipe2(wake, O_CLOEXEC) != 0)
+  {
+    ret = -errno;
+    goto close_fds;
+  }
 
-        LOG_INFO("Conservative shrink: returning last lease of %zu bytes.\n",
-                 shrink_size);
+  psi->fd      = fd;
+  psi->wake[0] = wake[0];
+  psi->wake[1] = wake[1];
 
-        old = MEM_sbrk(delta);
-        if ((intptr_t)old >= 0)
-        {
-          allocator->heap_end       = allocator->heap_end + delta;
-          allocator->last_brk_start = (uint8_t *)NULL;
-          allocator->last_brk_end   = (uint8_t *)NULL;
-          allocator->last_allocated
-            = (block_header_t *)(uintptr_t)allocator->heap_start;
+  ret = pthread_create(&psi->thread,
+                       (const pthread_attr_t *)NULL,
+                       MEM_psiThreadFunc,
+                       (void *)&g_allocator);
+  if (ret != EXIT_SUCCESS)
+  {
+    ret = -ret;
+    LOG_ERROR("Failed to create PSI thread. "
+              "Error code: %d.\n",
+              ret);
+    goto close_fds;
+  }
 
-          LOG_INFO("Heap shrunk by %zu bytes. New heap_end=%p.\n",
-                   shrink_size,
-                   (void *)allocator->heap_end);
+  psi->running = true;
+  LOG_INFO("PSI monitor started: %s.\n", trigger);
+  goto mutex_unlock;
 
-          goto function_output;
-        }
-        else
-        {
-          (void)MEM_insertFreeBlock(allocator, block);
-          LOG_WARNING("sbrk(-%zu) failed; skipping shrink. errno=%d\n",
-                      shrink_size,
-                      ENOMEM);
-          ret = EXIT_SUCCESS;
-        }
-      }
-    }
+close_fds:
+  close(fd);
+  if (wake[0] >= 0)
+  {
+    close(wake[0]);
+    close(wake[1]);
   }
 
-  freed_size = (size_t)(block->size - sizeof(*block) - sizeof(uintptr_t));
-  LOG_INFO("Memory freed: addr: %p (%zu bytes).\n", ptr, freed_size);
-
+  psi->fd      = -1;
+  psi->wake[0] = -1;
+  psi->wake[1] = -1;
+mutex_unlock:
+  pthread_mutex_unlock(&gc_thread->gc_lock);
 function_output:
   return ret;
 }
 
 /** ============================================================================
- *      P R I V A T E  G A R B A G E  C O L L E C T O R  F U N C T I O N S
- * ========================================================================== */
-
-#if defined(GARBAGE_COLLECTOR)
-
-/** ============================================================================
- *  @brief  Reset “marked” flags across all allocated regions.
- *
- *  This function prepares for a new garbage-collection cycle by clearing the
- *  mark flag on every heap block and every mmap’d block payload.  It scans
- *  the heap from allocator->heap_start + metadata_size up to
- * allocator->heap_end, resetting each valid block’s marked flag (and skipping
- * malformed blocks to avoid infinite loops).  It then iterates
- * allocator->mmap_list, clearing the mark on each payload block while
- * preserving the metadata header’s mark so the allocator’s own bookkeeping
- * regions are never freed.
+ *  @brief  Stops the PSI monitor thread and releases its trigger.
  *
- *  @param[in]  allocator Memory allocator context.
- *
- *  @return Integer status code.
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
  *
- *  @retval EXIT_SUCCESS: All marks cleared and metadata marks preserved.
- *  @retval -EINVAL:      @p allocator is NULL.
+ *  @retval -EINVAL:  The monitor is not running, or it already exited on
+ *                    a failed poll() or a torn-down trigger.
  * ========================================================================== */
-static int MEM_setInitialMarks(mem_allocator_t *const allocator)
+int MEM_psiMonitorStop(void)
 {
   int ret = EXIT_SUCCESS;
 
-  block_header_t *block = (block_header_t *)NULL;
+  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
+  mem_psi_t   *psi       = (mem_psi_t *)NULL;
 
-  block_header_t *meta_data = (block_header_t *)NULL;
-  mmap_t         *map       = (mmap_t *)NULL;
+  const char stop = 0;
 
-  uintptr_t heap_ptr   = 0u;
-  uintptr_t heap_start = 0u;
-  uintptr_t heap_end   = 0u;
+  if (!g_allocator_inited)
+  {
+    ret = -EINVAL;
+    goto function_output;
+  }
 
-  if (UNLIKELY(allocator == NULL))
+  gc_thread = &g_allocator.gc_thread;
+  psi       = &g_allocator.psi;
+
+  pthread_mutex_lock(&gc_thread->gc_lock);
+  if (!psi->running)
   {
     ret = -EINVAL;
-    LOG_ERROR("Invalid parameters: allocator: %p. "
-              "Error code: %d.\n",
-              (void *)allocator,
-              ret);
+    pthread_mutex_unlock(&gc_thread->gc_lock);
     goto function_output;
   }
+  psi->running = false;
+  pthread_mutex_unlock(&gc_thread->gc_lock);
 
-  heap_start = (uintptr_t)allocator->heap_start + allocator->metadata_size;
-  heap_end   = (uintptr_t)allocator->heap_end;
+  if (write(psi->wake[1], &stop, sizeof(stop)) < 0)
+    LOG_WARNING("PSI stop signal failed. errno=%d\n", errno);
 
-  heap_ptr = heap_start;
-  while (heap_ptr < heap_end)
+  pthread_join(psi->thread, NULL);
+
+  MEM_psiClose(psi);
+
+  LOG_INFO("PSI monitor stopped after %" PRIu64 " events.\n",
+           atomic_load_explicit(&psi->events, memory_order_relaxed));
+
+function_output:
+  return ret;
+}
+
+/** ============================================================================
+ *  @brief  Allocates a movable block and returns its handle.
+ *
+ *  The block is unpinned: MEM_compact() and pressure events may move it.
+ *  Its address is only obtained, and kept stable, through MEM_hLock().
+ *
+ *  @param[in]  size      Number of bytes requested.
+ *
+ *  @return Handle (> 0) on success, negative error code on failure.
+ *
+ *  @retval -EINVAL:  @p size is zero or too large.
+ *  @retval -ENOSPC:  INT32_MAX handles are in use.
+ *  @retval -ENOMEM:  Out of memory.
+ * ========================================================================== */
+mem_handle_t MEM_hAlloc(const size_t size)
+{
+  mem_handle_t handle = 0;
+
+  int ret_init = EXIT_SUCCESS;
+
+  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
+
+  if (!g_allocator_inited)
   {
-    block = (block_header_t *)heap_ptr;
-    if (block->size >= sizeof(block_header_t)
-        && (heap_ptr + block->size) <= heap_end)
-    {
-      block->marked = 0u;
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
 
-      heap_ptr += block->size;
-    }
-    else
+    ret_init = MEM_allocatorInit(&g_allocator);
+    if (ret_init != EXIT_SUCCESS)
     {
-      heap_ptr += sizeof(block_header_t);
+      handle = (mem_handle_t)ret_init;
+      goto function_output;
     }
   }
 
-  for (map = allocator->mmap_list; map; map = map->next)
-  {
-    block = (block_header_t *)map->addr;
+  gc_thread = &g_allocator.gc_thread;
 
-    block->marked = 0u;
+  pthread_mutex_lock(&gc_thread->gc_lock);
+  handle = MEM_hAllocOp(&g_allocator, size, __FILE__, __LINE__);
+  pthread_mutex_unlock(&gc_thread->gc_lock);
 
-    meta_data = (block_header_t *)((uintptr_t)map - sizeof(block_header_t));
+  (void)MEM_pressureDispatch(&g_allocator);
 
-    meta_data->marked = 1u;
-  }
+#if defined(GARBAGE_COLLECTOR)
+  MEM_gcAssist(&g_allocator, size);
+#endif
 
 function_output:
-  return ret;
+  return handle;
 }
 
 /** ============================================================================
- *  @brief  Mark all live blocks reachable from the stack.
+ *  @brief  Pins a movable block and returns its current address.
  *
- *  This function performs the marking phase of garbage collection by:
- *    - Calling MEM_setInitialMarks() to clear previous marks.
- *    - Capturing stack bounds via MEM_stackBounds() for the current thread.
- *    - Optionally informing Valgrind to treat the stack region as defined.
- *    - Scanning each word between stack_bottom and stack_top:
- *        • If the word’s value lies within the heap bounds, validating the
- *          corresponding block header and marking the block if it is live.
- *    - Iterating the allocator’s mmap_list and marking any mmap’d block whose
- *      payload contains a stack reference.
+ *  Locks nest: the block stays in place until every MEM_hLock() has been
+ *  matched by MEM_hUnlock().
  *
- *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  handle    Handle returned by MEM_hAlloc().
  *
- *  @return Integer status code.
+ *  @return Pointer to the payload on success,
+ *          or an error-encoded pointer (via PTR_ERR()) on failure.
  *
- *  @retval EXIT_SUCCESS: All reachable blocks marked successfully.
- *  @retval -EINVAL:      @p allocator is NULL.
- *  @retval ret<0:        Error code returned by MEM_stackBounds(),
- *                        MEM_validateBlock(), or other internal calls.
+ *  @retval -EINVAL:    @p handle is not allocated.
+ *  @retval -EOVERFLOW: @p handle holds UINT32_MAX locks.
  * ========================================================================== */
-static int MEM_gcMark(mem_allocator_t *const allocator)
+void *MEM_hLock(const mem_handle_t handle)
 {
-  int ret = EXIT_SUCCESS;
+  void *ptr = (void *)NULL;
 
-  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
+  gc_thread_t       *gc_thread = (gc_thread_t *)NULL;
+  mem_handle_slot_t *slot      = (mem_handle_slot_t *)NULL;
 
-  block_header_t *block = (block_header_t *)NULL;
+  if (!g_allocator_inited)
+  {
+    ptr = PTR_ERR(-EINVAL);
+    goto function_output;
+  }
 
-  mmap_t *map = (mmap_t *)NULL;
+  gc_thread = &g_allocator.gc_thread;
+
+  pthread_mutex_lock(&gc_thread->gc_lock);
 
-  volatile uintptr_t *stack_ptr = (volatile uintptr_t *)NULL;
+  slot = MEM_handleSlot(&g_allocator, handle);
+  if (slot == NULL)
+  {
+    ptr = PTR_ERR(-EINVAL);
+    LOG_ERROR("Invalid handle: %d. Error code: %d.\n",
+              handle,
+              (int)(intptr_t)ptr);
+    goto mutex_unlock;
+  }
 
-  void *stack_frame = (void *)NULL;
+  if (slot->locks == UINT32_MAX)
+  {
+    ptr = PTR_ERR(-EOVERFLOW);
+    LOG_ERROR("Handle %d lock count saturated. Error code: %d.\n",
+              handle,
+              (int)(intptr_t)ptr);
+    goto mutex_unlock;
+  }
 
-  uintptr_t *stack_tmp    = (uintptr_t *)NULL;
-  uintptr_t *stack_bottom = (uintptr_t *)NULL;
-  uintptr_t *stack_top    = (uintptr_t *)NULL;
+  slot->locks++;
+  ptr = (uint8_t *)slot->ptr + HANDLE_PREFIX;
 
-  uintptr_t heap_start = 0u;
-  uintptr_t heap_end   = 0u;
+mutex_unlock:
+  pthread_mutex_unlock(&gc_thread->gc_lock);
+function_output:
+  return ptr;
+}
 
-  uintptr_t block_addr    = 0u;
-  uintptr_t payload_start = 0u;
-  uintptr_t payload_end   = 0u;
+/** ============================================================================
+ *  @brief  Drops one pin taken by MEM_hLock().
+ *
+ *  Once the last pin is gone, the address returned by MEM_hLock() must no
+ *  longer be used: the block may move.
+ *
+ *  @param[in]  handle    Handle returned by MEM_hAlloc().
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ *
+ *  @retval -EINVAL:  @p handle is not allocated.
+ *  @retval -EPERM:   @p handle is not locked.
+ * ========================================================================== */
+int MEM_hUnlock(const mem_handle_t handle)
+{
+  int ret = EXIT_SUCCESS;
 
-  bool mmap_found = false;
+  gc_thread_t       *gc_thread = (gc_thread_t *)NULL;
+  mem_handle_slot_t *slot      = (mem_handle_slot_t *)NULL;
 
-  if (UNLIKELY(allocator == NULL))
+  if (!g_allocator_inited)
   {
     ret = -EINVAL;
-    LOG_ERROR("Invalid parameters: allocator: %p. "
-              "Error code: %d.\n",
-              (void *)allocator,
-              ret);
     goto function_output;
   }
 
-  gc_thread = &allocator->gc_thread;
+  gc_thread = &g_allocator.gc_thread;
 
-  ret = MEM_stackBounds(gc_thread->main_thread, allocator);
-  if (ret != EXIT_SUCCESS)
-    goto function_output;
+  pthread_mutex_lock(&gc_thread->gc_lock);
 
-  heap_start = (uintptr_t)allocator->heap_start + allocator->metadata_size;
+  slot = MEM_handleSlot(&g_allocator, handle);
+  if (slot == NULL)
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid handle: %d. Error code: %d.\n", handle, ret);
+    goto mutex_unlock;
+  }
 
-  stack_bottom = allocator->stack_bottom;
-  stack_top    = allocator->stack_top;
+  if (slot->locks == 0u)
+  {
+    ret = -EPERM;
+    LOG_ERROR("Handle %d is not locked. Error code: %d.\n", handle, ret);
+    goto mutex_unlock;
+  }
 
-  #ifdef RUNNING_ON_VALGRIND
-  VALGRIND_MAKE_MEM_DEFINED((void *)stack_bottom,
-                            (size_t)((char *)stack_top - (char *)stack_bottom));
-  #endif
+  slot->locks--;
 
-  MEM_setInitialMarks(allocator);
+mutex_unlock:
+  pthread_mutex_unlock(&gc_thread->gc_lock);
+function_output:
+  return ret;
+}
 
-  if (stack_bottom > stack_top)
-  {
-    stack_tmp    = stack_bottom;
-    stack_bottom = stack_top;
-    stack_top    = stack_tmp;
-  }
+/** ============================================================================
+ *  @brief  Releases a movable block and its handle.
+ *
+ *  @param[in]  handle    Handle returned by MEM_hAlloc().
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ *
+ *  @retval -EINVAL:  @p handle is not allocated.
+ *  @retval -EBUSY:   @p handle is locked.
+ * ========================================================================== */
+int MEM_hFree(const mem_handle_t handle)
+{
+  int ret = EXIT_SUCCESS;
 
-  for (stack_ptr = stack_bottom; stack_ptr < stack_top; ++stack_ptr)
+  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
+
+  if (!g_allocator_inited)
   {
-    stack_frame = (void *)(*stack_ptr);
-    if (stack_frame != NULL)
-    {
-      block_addr = (uintptr_t)stack_frame;
-      heap_end   = (uintptr_t)allocator->heap_end;
+    ret = -EINVAL;
+    goto function_output;
+  }
 
-      if (block_addr >= heap_start && block_addr < heap_end)
-      {
-        block = (block_header_t *)(block_addr - sizeof(block_header_t));
+  gc_thread = &g_allocator.gc_thread;
 
-        payload_start = (uintptr_t)block + sizeof(*block);
-        payload_end   = (uintptr_t)block + block->size - sizeof(uintptr_t);
+  pthread_mutex_lock(&gc_thread->gc_lock);
+  ret = MEM_hFreeOp(&g_allocator, handle, __FILE__, __LINE__);
+  pthread_mutex_unlock(&gc_thread->gc_lock);
 
-        ret = MEM_validateBlock(allocator, block);
-        if (block_addr >= payload_start && block_addr < payload_end
-            && ret == EXIT_SUCCESS && !block->free)
-        {
-          block->marked = 1u;
-          LOG_INFO("Block Marked(sbrk): %p (%zu bytes). "
-                   "stack = %lu.\n",
-                   (void *)((uint8_t *)block + sizeof(block_header_t)),
-                   block->size,
-                   (unsigned long)stack_ptr);
-        }
-        else
-        {
-          block->marked = 0u;
-        }
-      }
+function_output:
+  return ret;
+}
 
-      mmap_found = false;
-      for (map = allocator->mmap_list; map && !mmap_found; map = map->next)
-      {
-        block = (block_header_t *)map->addr;
+/** ============================================================================
+ *  @brief  Compacts the heap, then returns free memory to the kernel.
+ *
+ *  Slides every unlocked MEM_hAlloc() block toward the heap start, over
+ *  the free space below it, so the free space gathers at the top where
+ *  MEM_trim() can release it. Ordinary and locked blocks stay in place.
+ *  Meant for idle time: the heap is walked and copied with the allocator
+ *  lock held. Blocks are not moved while a collection is in progress.
+ *
+ *  @return Number of bytes released (>= 0) on success,
+ *          negative error code on failure.
+ * ========================================================================== */
+intptr_t MEM_compact(void)
+{
+  intptr_t ret = 0;
 
-        payload_start = (uintptr_t)map->addr + sizeof(*block);
-        payload_end   = (uintptr_t)map->addr + map->size - sizeof(uintptr_t);
+  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
 
-        if (block_addr >= payload_start && block_addr < payload_end
-            && !block->free)
-        {
-          block->marked = 1u;
-          LOG_INFO("Block Marked(sbrk): %p (%zu bytes).\n",
-                   (void *)((uint8_t *)block + sizeof(block_header_t)),
-                   block->size);
-          mmap_found = true;
-        }
-      }
-    }
+  if (!g_allocator_inited)
+  {
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
 
-    ret = EXIT_SUCCESS;
+    ret = (intptr_t)MEM_allocatorInit(&g_allocator);
+    if (ret != EXIT_SUCCESS)
+      goto function_output;
   }
 
+  gc_thread = &g_allocator.gc_thread;
+
+  pthread_mutex_lock(&gc_thread->gc_lock);
+  ret = MEM_compactOp(&g_allocator);
+  pthread_mutex_unlock(&gc_thread->gc_lock);
+
 function_output:
   return ret;
 }
 
 /** ============================================================================
- *  @brief  Reclaim any unmarked blocks from heap and mmap regions.
- *
- *  This function performs the “sweep” phase of garbage collection:
- *    - It iterates over every block in the heap:
- *        • Logs each block’s free and marked status.
- *        • If a block is allocated (free==0) but unmarked, calls
- *          MEM_freeOp() on its payload pointer to reclaim it.
- *        • Clears each block’s marked flag.
- *    - It then traverses allocator->mmap_list via a pointer-to-pointer scan:
- *        • Logs each mmap’d region’s status.
- *        • If an mmap’d block is unmarked and not already free, unlinks
- *          the mmap_t node, calls munmap() on the region, and frees its
- *          metadata header via MEM_freeOp().
- *        • Otherwise, clears the block’s marked flag and advances to the next
- * node.
+ *  @brief  Tells whether a block is worth moving to defragment the heap.
  *
- *  @param[in]  allocator Memory allocator context.
+ *  True when the block sits alone, or nearly so, in heap pages that would
+ *  otherwise be free, so that freeing it would let those pages be released,
+ *  and a free block in pages already in use can take it. mmap blocks are
+ *  released on their own and always report false.
  *
- *  @return Integer status code.
+ *  @param[in]  ptr       Pointer returned by an allocation function.
  *
- *  @retval EXIT_SUCCESS: All unreachable blocks reclaimed successfully.
- *  @retval -EINVAL:      @p allocator is NULL.
- *  @retval ret<0:        Errors returned by MEM_freeOp(),
- *                        munmap(), or internal validation functions.
+ *  @return true if MEM_relocate() would move the block, false otherwise.
  * ========================================================================== */
-static int MEM_gcSweep(mem_allocator_t *const allocator)
+bool MEM_shouldRelocate(const void *const ptr)
 {
-  int ret = EXIT_SUCCESS;
+  bool relocate = false;
 
-  block_header_t *block = (block_header_t *)NULL;
+  gc_thread_t    *gc_thread = (gc_thread_t *)NULL;
+  block_header_t *target    = (block_header_t *)NULL;
 
-  mmap_t  *map  = (mmap_t *)NULL;
-  mmap_t **scan = (mmap_t **)NULL;
+  if (!g_allocator_inited || ptr == NULL)
+    goto function_output;
 
-  void *user_ptr = (void *)NULL;
+  gc_thread = &g_allocator.gc_thread;
 
-  uint8_t *heap_end   = (uint8_t *)NULL;
-  uint8_t *heap_start = (uint8_t *)NULL;
-  uint8_t *heap_ptr   = (uint8_t *)NULL;
+  pthread_mutex_lock(&gc_thread->gc_lock);
+  relocate = MEM_relocateFind(&g_allocator, ptr, &target) != NULL;
+  pthread_mutex_unlock(&gc_thread->gc_lock);
 
-  size_t min_size    = 0u;
-  size_t remain_size = 0u;
-  size_t step        = 0u;
+function_output:
+  return relocate;
+}
 
-  if (UNLIKELY(allocator == NULL))
+/** ============================================================================
+ *  @brief  Moves a block out of a sparsely used heap region.
+ *
+ *  When MEM_shouldRelocate() holds, copies the payload into a block placed
+ *  in densely used pages, keeping its tag and layout, and frees the
+ *  original; @p ptr must not be used afterwards. Otherwise returns @p ptr.
+ *  Applications migrate their data incrementally by calling it on each
+ *  object and updating their references.
+ *
+ *  @param[in]  ptr       Pointer returned by an allocation function.
+ *
+ *  @return New pointer when the block moved, @p ptr when it stays,
+ *          or an error-encoded pointer (via PTR_ERR()) on failure.
+ *
+ *  @retval -EINVAL:  @p ptr is NULL or the allocator is not initialised.
+ * ========================================================================== */
+void *MEM_relocate(void *const ptr)
+{
+  void *ret_addr = (void *)NULL;
+
+  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
+
+  if (!g_allocator_inited)
   {
-    ret = -EINVAL;
-    LOG_ERROR("Invalid parameters: allocator: %p. "
-              "Error code: %d.\n",
-              (void *)allocator,
-              ret);
+    ret_addr = PTR_ERR(-EINVAL);
     goto function_output;
   }
 
-  heap_start
-    = (uint8_t *)((uintptr_t)allocator->heap_start + allocator->metadata_size);
-  heap_end = allocator->heap_end;
+  gc_thread = &g_allocator.gc_thread;
 
-  min_size = sizeof(block_header_t);
+  pthread_mutex_lock(&gc_thread->gc_lock);
+  ret_addr = MEM_relocateOp(&g_allocator, ptr, __FILE__, __LINE__);
+  pthread_mutex_unlock(&gc_thread->gc_lock);
 
-  heap_ptr = heap_start;
+function_output:
+  return ret_addr;
+}
 
-  while (heap_ptr < heap_end)
-  {
-    block = (block_header_t *)(uintptr_t)heap_ptr;
+#if defined(GARBAGE_COLLECTOR)
 
-    remain_size = (size_t)(heap_end - heap_ptr);
+/** ============================================================================
+ *  @brief  Start or signal the garbage collector thread.
+ *
+ *  This function wraps MEM_runGc(), starting the GC thread if needed
+ *  or signaling it to perform a collection cycle.
+ *
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator (initialised on first use).
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ * ========================================================================== */
+int MEM_enableGc(mem_allocator_t *const allocator)
+{
+  int ret = EXIT_SUCCESS;
 
-    if (block->size >= min_size && block->size <= remain_size)
-    {
-      LOG_INFO("Block Sweep(sbrk): block %p (%zu bytes). "
-               "free=%u | marked=%u.\n",
-               (void *)((uint8_t *)block + sizeof(block_header_t)),
-               block->size,
-               block->free,
-               block->marked);
-
-      if (!block->free && !block->marked)
-      {
-        LOG_INFO("Sweep Free(sbrk): block %p (%zu bytes).\n",
-                 (void *)((uint8_t *)block + sizeof(block_header_t)),
-                 block->size);
-        user_ptr = (uint8_t *)block + sizeof(*block);
-        MEM_freeOp(allocator, user_ptr, __FILE__, __LINE__);
-        block->free = 1;
-      }
+  mem_allocator_t *target = (mem_allocator_t *)NULL;
 
-      block->marked = 0U;
+  target = (allocator != NULL) ? allocator : &g_allocator;
 
-      step = block->size;
-    }
-    else
-    {
-      step = min_size;
-    }
+  if (target == &g_allocator && !g_allocator_inited)
+  {
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
 
-    heap_ptr += step;
-    heap_end  = allocator->heap_end;
+    ret = MEM_allocatorInit(&g_allocator);
+    if (ret != EXIT_SUCCESS)
+      goto function_output;
   }
 
-  scan = &allocator->mmap_list;
-  while (*scan)
-  {
-    map   = *scan;
-    block = (block_header_t *)map->addr;
+  ret = MEM_runGc(target);
 
-    LOG_INFO("Block Sweep(mmap): block %p (%zu bytes). "
-             "free=%u | marked=%u.\n",
-             (void *)((uint8_t *)block + sizeof(block_header_t)),
-             map->size,
-             block->free,
-             block->marked);
+function_output:
+  return ret;
+}
 
-    if (!block->marked && !block->free)
-    {
-      *scan = map->next;
+/** ============================================================================
+ *  @brief  Stop the garbage collector thread and perform a final collection.
+ *
+ *  This function wraps MEM_stopGc(), signaling the GC thread to exit,
+ *  joining it, and running a final mark-and-sweep cycle on the caller thread.
+ *
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator (initialised on first use).
+ *
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ * ========================================================================== */
+int MEM_disableGc(mem_allocator_t *const allocator)
+{
+  int ret = EXIT_SUCCESS;
 
-      LOG_INFO("Sweep Free(mmap): block %p (%zu bytes).\n",
-               (void *)((uint8_t *)block + sizeof(block_header_t)),
-               map->size);
+  mem_allocator_t *target = (mem_allocator_t *)NULL;
 
-      munmap(map->addr, map->size);
-      MEM_freeOp(allocator, (void *)map, __FILE__, __LINE__);
-    }
-    else
-    {
-      block->marked = 0;
+  target = (allocator != NULL) ? allocator : &g_allocator;
 
-      scan = &map->next;
-    }
+  if (target == &g_allocator && !g_allocator_inited)
+  {
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
+
+    ret = MEM_allocatorInit(&g_allocator);
+    if (ret != EXIT_SUCCESS)
+      goto function_output;
   }
 
+  ret = MEM_stopGc(target);
+
 function_output:
   return ret;
 }
 
+
 /** ============================================================================
- *  @brief  Dedicated thread loop driving mark-and-sweep iterations.
+ *  @brief  Registers the calling thread as a garbage collector root.
  *
- *  This function runs as the GC worker thread.  It locks gc_lock and waits
- *  on gc_cond until either gc_running or gc_exit is set.  On wakeup, if
- *  gc_exit is true, it breaks and exits the loop; otherwise it unlocks and
- *  performs one full GC cycle by calling MEM_gcMark() and MEM_gcSweep(),
- *  then sleeps for gc_interval_ms before re-acquiring the lock and waiting
- *  again.  On exit it ensures gc_lock is released.
+ *  Installs the stop-the-world handlers if needed and adds the caller to
+ *  the allocator's thread registry under gc_lock. The slot is released by
+ *  MEM_gcThreadExit() if the thread exits while still registered.
  *
- *  @param[in]  arg Pointer to the mem_allocator_t context.
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator (initialised on first use).
  *
- *  @return NULL on clean exit; an error-encoded pointer (via PTR_ERR())
- *          if any initialization or GC step fails.
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
  *
- *  @retval NULL:     Clean exit after gc_exit.
- *  @retval -EINVAL:  @p arg is NULL.
- *  @retval ret<0:    cond errors, or MEM_gcMark() / MEM_gcSweep() failures.
+ *  @retval -EALREADY:  The calling thread is already registered.
+ *  @retval -ENOSPC:    MEM_GC_MAX_THREADS threads are already registered.
  * ========================================================================== */
-static void *MEM_gcThreadFunc(void *arg)
+int MEM_gcRegisterThread(mem_allocator_t *const allocator)
 {
   int ret = EXIT_SUCCESS;
 
-  mem_allocator_t *allocator = (mem_allocator_t *)NULL;
-  gc_thread_t     *gc_thread = (gc_thread_t *)NULL;
-
-  if (UNLIKELY(arg == NULL))
-  {
-    ret = -EINVAL;
-    LOG_ERROR("Invalid parameters: arg: %p. "
-              "Error code: %d.\n",
-              (void *)arg,
-              (int)(intptr_t)ret);
-    goto function_output;
-  }
-
-  allocator = (mem_allocator_t *)arg;
-
-  gc_thread = &allocator->gc_thread;
+  mem_allocator_t *target = (mem_allocator_t *)NULL;
 
-  pthread_mutex_lock(&gc_thread->gc_lock);
+  target = (allocator != NULL) ? allocator : &g_allocator;
 
-  while (!gc_thread->gc_exit)
+  if (target == &g_allocator && !g_allocator_inited)
   {
-    while (!gc_thread->gc_running && !gc_thread->gc_exit)
-      pthread_cond_wait(&gc_thread->gc_cond, &gc_thread->gc_lock);
-
-    if (gc_thread->gc_exit)
-      goto mutex_unlock;
-
-    pthread_mutex_unlock(&gc_thread->gc_lock);
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
 
-    ret = MEM_gcMark(allocator);
+    ret = MEM_allocatorInit(&g_allocator);
     if (ret != EXIT_SUCCESS)
-      goto mutex_unlock;
+      goto function_output;
+  }
 
-    ret = MEM_gcSweep(allocator);
-    if (ret != EXIT_SUCCESS)
-      goto mutex_unlock;
+  pthread_mutex_lock(&target->gc_thread.gc_lock);
 
-    usleep((__useconds_t)(gc_thread->gc_interval_ms * NR_OBJS));
+  ret = MEM_gcInstallSignals(target);
+  if (ret != EXIT_SUCCESS)
+    goto mutex_unlock;
 
-    pthread_mutex_lock(&gc_thread->gc_lock);
-  }
+  ret = MEM_gcRegister(target, pthread_self( ));
 
 mutex_unlock:
-  pthread_mutex_unlock(&gc_thread->gc_lock);
+  pthread_mutex_unlock(&target->gc_thread.gc_lock);
 function_output:
-  return PTR_ERR(ret);
+  return ret;
 }
 
 /** ============================================================================
- *  @brief  Start or signal the GC thread to perform a collection cycle.
- *
- *  This function saves the caller’s thread ID as main_thread, locks gc_lock,
- *  and if the GC thread has not been started, sets gc_running and gc_exit
- *  flags and spawns MEM_gcThreadFunc(); otherwise it sets gc_running and
- *  signals gc_cond to wake the existing thread.  Finally it unlocks gc_lock.
+ *  @brief  Removes the calling thread from the garbage collector roots.
  *
- *  @param[in]  allocator Pointer to the mem_allocator_t context.
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator.
  *
- *  @return Integer status code.
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
  *
- *  @retval EXIT_SUCCESS: GC thread started or signaled successfully.
- *  @retval -EINVAL:      @p allocator is NULL.
- *  @retval ret<0:        Error code returned by pthread_create().
+ *  @retval -ENOENT:  The calling thread is not registered.
  * ========================================================================== */
-static int MEM_runGc(mem_allocator_t *const allocator)
+int MEM_gcUnregisterThread(mem_allocator_t *const allocator)
 {
   int ret = EXIT_SUCCESS;
 
-  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
+  mem_allocator_t *target = (mem_allocator_t *)NULL;
 
-  pthread_t thread;
+  target = (allocator != NULL) ? allocator : &g_allocator;
 
-  if (UNLIKELY(allocator == NULL))
+  if (target == &g_allocator && !g_allocator_inited)
   {
-    ret = -EINVAL;
-    LOG_ERROR("Invalid parameters: allocator: %p. "
-              "Error code: %d.\n",
-              (void *)allocator,
-              ret);
+    ret = -ENOENT;
     goto function_output;
   }
 
-  gc_thread = &allocator->gc_thread;
-
-  gc_thread->main_thread = pthread_self( );
-
-  pthread_mutex_lock(&gc_thread->gc_lock);
-  if (!gc_thread->gc_thread_started)
-  {
-    gc_thread->gc_thread_started = true;
-    gc_thread->gc_running        = true;
-    gc_thread->gc_exit           = false;
-
-    thread = gc_thread->gc_thread;
-
-    ret = pthread_create((pthread_t *)&thread,
-                         (const pthread_attr_t *)NULL,
-                         MEM_gcThreadFunc,
-                         (void *)allocator);
-    if (ret != EXIT_SUCCESS)
-    {
-      LOG_ERROR("Failed to create gc thread: %p. "
-                "Error code: %d.\n",
-                (void *)gc_thread->gc_thread,
-                ret);
-      goto function_output;
-    }
-  }
-  else
-  {
-    gc_thread->gc_running = true;
-    pthread_cond_signal(&gc_thread->gc_cond);
-  }
-
-  pthread_mutex_unlock(&gc_thread->gc_lock);
+  pthread_mutex_lock(&target->gc_thread.gc_lock);
+  ret = MEM_gcUnregister(target, pthread_self( ));
+  pthread_mutex_unlock(&target->gc_thread.gc_lock);
 
 function_output:
   return ret;
 }
 
 /** ============================================================================
- *  @brief  Stop the GC thread and perform a final collection.
+ *  @brief  Sets the number of threads that mark and sweep in parallel.
  *
- *  This function clears gc_running and sets gc_exit, signals gc_cond to wake
- *  the GC thread if it’s running, then joins it.  After the thread exits, it
- *  runs one final MEM_gcMark() + MEM_gcSweep() on the caller thread to
- *  reclaim any remaining garbage, then clears gc_thread_started.
+ *  Stores the count under gc_lock; MEM_gcPoolStart() creates the missing
+ *  pool threads before the next cycle. Lowering the count leaves the extra
+ *  threads parked.
  *
- *  @param[in]  allocator Pointer to the mem_allocator_t context.
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator (initialised on first use).
+ *  @param[in]  workers   Worker count, 1 to MEM_GC_MAX_WORKERS.
  *
- *  @return Integer status code.
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
  *
- *  @retval EXIT_SUCCESS: GC thread stopped and final collection done.
- *  @retval -EINVAL:      @p allocator is NULL.
- *  @retval ret<0:        Error code from pthread MEM_gcMark(), or
- * MEM_gcSweep().
+ *  @retval -EINVAL:  @p workers is out of range.
  * ========================================================================== */
-static int MEM_stopGc(mem_allocator_t *const allocator)
+int MEM_gcSetWorkers(mem_allocator_t *const allocator, const uint32_t workers)
 {
   int ret = EXIT_SUCCESS;
 
-  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
+  mem_allocator_t *target = (mem_allocator_t *)NULL;
 
-  if (UNLIKELY(allocator == NULL))
+  if (UNLIKELY(workers == 0u || workers > MEM_GC_MAX_WORKERS))
   {
     ret = -EINVAL;
-    LOG_ERROR("Invalid parameters: allocator: %p. "
+    LOG_ERROR("Invalid parameters: workers: %u (1..%u). "
               "Error code: %d.\n",
-              (void *)allocator,
+              workers,
+              (unsigned)MEM_GC_MAX_WORKERS,
               ret);
     goto function_output;
   }
 
-  gc_thread = &allocator->gc_thread;
-
-  gc_thread->gc_running = false;
-  gc_thread->gc_exit    = true;
-
-  if (gc_thread->gc_thread_started)
-  {
-    pthread_cond_signal(&gc_thread->gc_cond);
-    pthread_join(gc_thread->gc_thread, NULL);
+  target = (allocator != NULL) ? allocator : &g_allocator;
 
-    ret = MEM_gcMark(allocator);
-    if (ret != EXIT_SUCCESS)
-      goto function_output;
+  if (target == &g_allocator && !g_allocator_inited)
+  {
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
 
-    ret = MEM_gcSweep(allocator);
+    ret = MEM_allocatorInit(&g_allocator);
     if (ret != EXIT_SUCCESS)
       goto function_output;
-
-    gc_thread->gc_thread_started = false;
   }
 
+  pthread_mutex_lock(&target->gc_thread.gc_lock);
+  target->gc_pool.num_workers = workers;
+  pthread_mutex_unlock(&target->gc_thread.gc_lock);
+
 function_output:
   return ret;
 }
 
-#endif
-
-/** ============================================================================
- *          P U B L I C  F U N C T I O N S  D E F I N I T I O N S
- * ========================================================================== */
-
 /** ============================================================================
- *  @brief  Allocates memory using the FIRST_FIT strategy.
+ *  @brief  Runs a bounded step of an incremental collection.
  *
- *  This function locks the GC mutex, invokes MEM_allocOp() with
- *  FIRST_FIT strategy, automatically supplying __FILE__, __LINE__, and variable
- *  name for debugging, then unlocks the mutex.
+ *  Starts a cycle when none is in progress, then resumes where the last
+ *  step stopped: tracing with mutators running, a short stop-the-world
+ *  remark, and sweeping. Returns after about @p budget_us, or earlier when
+ *  the cycle completes.
  *
- *  @param[in]  size      Number of bytes requested.
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator (initialised on first use).
+ *  @param[in]  budget_us Time budget, in microseconds.
  *
- *  @return Pointer to the allocated user memory on success,
- *          or an error‐encoded pointer (via PTR_ERR()) on failure.
+ *  @return EXIT_SUCCESS while the cycle is in progress,
+ *          MEM_GC_CYCLE_DONE when it completed,
+ *          negative error code on failure.
+ *
+ *  @retval -ENOMEM:  The mark bitmaps could not be grown.
+ *  @retval -EBUSY:   The GC thread is collecting a fork() snapshot.
  * ========================================================================== */
-void *MEM_allocFirstFit(const size_t size)
+int MEM_gcStep(mem_allocator_t *const allocator, const uint32_t budget_us)
 {
-  void *ret_addr = (void *)NULL;
+  int ret = EXIT_SUCCESS;
 
-  int ret_init = EXIT_SUCCESS;
+  mem_allocator_t *target = (mem_allocator_t *)NULL;
 
-  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
+  target = (allocator != NULL) ? allocator : &g_allocator;
 
-  if (!g_allocator_inited)
+  if (target == &g_allocator && !g_allocator_inited)
   {
     MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
 
-    ret_init = MEM_allocatorInit(&g_allocator);
-    if (ret_init != EXIT_SUCCESS)
+    ret = MEM_allocatorInit(&g_allocator);
+    if (ret != EXIT_SUCCESS)
       goto function_output;
   }
 
-  gc_thread = &g_allocator.gc_thread;
-
-  pthread_mutex_lock(&gc_thread->gc_lock);
-  ret_addr = MEM_allocOp(&g_allocator, size, __FILE__, __LINE__, FIRST_FIT);
-  pthread_mutex_unlock(&gc_thread->gc_lock);
+  pthread_mutex_lock(&target->gc_thread.gc_lock);
+  ret = MEM_gcStepOp(target, budget_us);
+  pthread_mutex_unlock(&target->gc_thread.gc_lock);
 
 function_output:
-  return ret_addr;
+  return ret;
 }
 
 /** ============================================================================
- *  @brief  Allocates memory using the BEST_FIT strategy.
+ *  @brief  Sets how much collection work allocation pays for.
  *
- *  This function locks the GC mutex, invokes MEM_allocOp() with
- *  BEST_FIT strategy, automatically supplying __FILE__, __LINE__, and variable
- *  name for debugging, then unlocks the mutex.
+ *  While an incremental cycle is in progress, every GC_ASSIST_QUANTUM bytes
+ *  allocated make the allocating thread run a MEM_gcStep() of
+ *  @p us_per_mib microseconds per MiB allocated. Zero disables assists.
  *
- *  @param[in]  size      Number of bytes requested.
+ *  @param[in]  allocator  Memory allocator context, or NULL for the global
+ *                         allocator (initialised on first use).
+ *  @param[in]  us_per_mib Step budget per MiB allocated, in microseconds.
  *
- *  @return Pointer to the allocated user memory on success,
- *          or an error‐encoded pointer (via PTR_ERR()) on failure.
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
  * ========================================================================== */
-void *MEM_allocBestFit(const size_t size)
+int MEM_gcSetAssist(mem_allocator_t *const allocator,
+                    const uint32_t         us_per_mib)
 {
-  void *ret_addr = (void *)NULL;
+  int ret = EXIT_SUCCESS;
 
-  int ret_init = EXIT_SUCCESS;
+  mem_allocator_t *target = (mem_allocator_t *)NULL;
 
-  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
+  target = (allocator != NULL) ? allocator : &g_allocator;
 
-  if (!g_allocator_inited)
+  if (target == &g_allocator && !g_allocator_inited)
   {
     MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
 
-    ret_init = MEM_allocatorInit(&g_allocator);
-    if (ret_init != EXIT_SUCCESS)
+    ret = MEM_allocatorInit(&g_allocator);
+    if (ret != EXIT_SUCCESS)
       goto function_output;
   }
 
-  gc_thread = &g_allocator.gc_thread;
-
-  pthread_mutex_lock(&gc_thread->gc_lock);
-  ret_addr = MEM_allocOp(&g_allocator, size, __FILE__, __LINE__, BEST_FIT);
-  pthread_mutex_unlock(&gc_thread->gc_lock);
+  pthread_mutex_lock(&target->gc_thread.gc_lock);
+  __atomic_store_n(&target->gc_incr.debt, 0u, __ATOMIC_RELAXED);
+  __atomic_store_n(&target->gc_incr.assist, us_per_mib, __ATOMIC_RELAXED);
+  pthread_mutex_unlock(&target->gc_thread.gc_lock);
 
 function_output:
-  return ret_addr;
+  return ret;
 }
 
 /** ============================================================================
- *  @brief  Allocates memory using the NEXT_FIT strategy.
+ *  @brief  Selects fork()-snapshot marking for the GC thread.
  *
- *  This function locks the GC mutex, invokes MEM_allocOp() with
- *  NEXT_FIT strategy, automatically supplying __FILE__, __LINE__, and variable
- *  name for debugging, then unlocks the mutex.
+ *  When enabled, each cycle of the GC thread forks a child that marks a
+ *  copy-on-write snapshot of the heap and reports the unreachable blocks
+ *  through shared memory; the thread then frees them in short slices.
+ *  Mutators pause only for the fork(). A cycle whose snapshot fails falls
+ *  back to in-process marking.
  *
- *  @param[in]  size      Number of bytes requested.
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator (initialised on first use).
+ *  @param[in]  enable    true to mark in a child process.
  *
- *  @return Pointer to the allocated user memory on success,
- *          or an error‐encoded pointer (via PTR_ERR()) on failure.
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
  * ========================================================================== */
-void *MEM_allocNextFit(const size_t size)
+int MEM_gcSetSnapshot(mem_allocator_t *const allocator, const bool enable)
 {
-  void *ret_addr = (void *)NULL;
+  int ret = EXIT_SUCCESS;
 
-  int ret_init = EXIT_SUCCESS;
+  mem_allocator_t *target = (mem_allocator_t *)NULL;
 
-  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
+  target = (allocator != NULL) ? allocator : &g_allocator;
 
-  if (!g_allocator_inited)
+  if (target == &g_allocator && !g_allocator_inited)
   {
     MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
 
-    ret_init = MEM_allocatorInit(&g_allocator);
-    if (ret_init != EXIT_SUCCESS)
+    ret = MEM_allocatorInit(&g_allocator);
+    if (ret != EXIT_SUCCESS)
       goto function_output;
   }
 
-  gc_thread = &g_allocator.gc_thread;
-
-  pthread_mutex_lock(&gc_thread->gc_lock);
-  ret_addr = MEM_allocOp(&g_allocator, size, __FILE__, __LINE__, NEXT_FIT);
-  pthread_mutex_unlock(&gc_thread->gc_lock);
+  pthread_mutex_lock(&target->gc_thread.gc_lock);
+  target->gc_snap.enabled = enable;
+  pthread_mutex_unlock(&target->gc_thread.gc_lock);
 
 function_output:
-  return ret_addr;
+  return ret;
 }
 
 /** ============================================================================
- *  @brief  Allocates memory using the specified strategy.
+ *  @brief  Selects generational collection for the GC thread.
  *
- *  This function locks the GC mutex, invokes MEM_allocOp() with the
- *  given @p strategy, automatically supplying __FILE__, __LINE__, and variable
- *  name for debugging, then unlocks the mutex.
+ *  Stores the setting under gc_lock and invalidates the old generation, so
+ *  the next cycle of the GC thread is a full collection that establishes
+ *  it. Later cycles are minor ones, with a full one after every
+ *  @p full_every of them.
  *
- *  @param[in]  size      Number of bytes requested
- *  @param[in]  strategy  Allocation strategy.
+ *  @param[in]  allocator  Memory allocator context, or NULL for the global
+ *                         allocator (initialised on first use).
+ *  @param[in]  full_every Minor collections between full ones; 0 disables
+ *                         generational mode.
  *
- *  @return Pointer to the allocated user memory on success,
- *          or an error‐encoded pointer (via PTR_ERR()) on failure.
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
  * ========================================================================== */
-void *MEM_alloc(const size_t size, const allocation_strategy_t strategy)
+int MEM_gcSetGenerational(mem_allocator_t *const allocator,
+                          const uint32_t         full_every)
 {
-  void *ret_addr = (void *)NULL;
+  int ret = EXIT_SUCCESS;
 
-  int ret_init = EXIT_SUCCESS;
+  mem_allocator_t *target = (mem_allocator_t *)NULL;
 
-  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
+  target = (allocator != NULL) ? allocator : &g_allocator;
 
-  if (!g_allocator_inited)
+  if (target == &g_allocator && !g_allocator_inited)
   {
     MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
 
-    ret_init = MEM_allocatorInit(&g_allocator);
-    if (ret_init != EXIT_SUCCESS)
+    ret = MEM_allocatorInit(&g_allocator);
+    if (ret != EXIT_SUCCESS)
       goto function_output;
   }
 
-  gc_thread = &g_allocator.gc_thread;
-
-  pthread_mutex_lock(&gc_thread->gc_lock);
-  ret_addr = MEM_allocOp(&g_allocator, size, __FILE__, __LINE__, strategy);
-  pthread_mutex_unlock(&gc_thread->gc_lock);
+  pthread_mutex_lock(&target->gc_thread.gc_lock);
+  target->gc_gen.full_every = full_every;
+  target->gc_gen.minors     = 0u;
+  target->gc_gen.valid      = false;
+  target->gc_gen.young_lo   = SIZE_MAX;
+  target->gc_gen.young_hi   = 0u;
+  pthread_mutex_unlock(&target->gc_thread.gc_lock);
 
 function_output:
-  return ret_addr;
+  return ret;
 }
 
 /** ============================================================================
- *  @brief  Allocates and zero‐initializes memory using the specified strategy.
+ *  @brief  Hands the sweep of GC thread cycles over to allocations.
  *
- *  This function locks the GC mutex, invokes MEM_callocOp() with the
- *  given @p strategy, automatically supplying __FILE__, __LINE__, and variable
- *  name for debugging, then unlocks the mutex.
+ *  Stores the setting under gc_lock. While enabled, the GC thread marks
+ *  the heap and leaves it in GC_INCR_SWEEP; MEM_gcLazySweep() then sweeps
+ *  it from the allocation path. Disabling it lets a pending sweep be
+ *  finished by the GC thread.
  *
- *  @param[in]  size      Number of bytes requested.
- *  @param[in]  var       Variable name for debugging.
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator (initialised on first use).
+ *  @param[in]  enable    true to sweep on allocation, false to sweep in
+ *                        the GC thread.
  *
- *  @return Pointer to the allocated zeroed memory on success,
- *          or an error‐encoded pointer (via PTR_ERR()) on failure.
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
  * ========================================================================== */
-void *MEM_calloc(const size_t size, const allocation_strategy_t strategy)
+int MEM_gcSetLazySweep(mem_allocator_t *const allocator, const bool enable)
 {
-  void *ret_addr = (void *)NULL;
+  int ret = EXIT_SUCCESS;
 
-  int ret_init = EXIT_SUCCESS;
+  mem_allocator_t *target = (mem_allocator_t *)NULL;
 
-  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
+  target = (allocator != NULL) ? allocator : &g_allocator;
 
-  if (!g_allocator_inited)
+  if (target == &g_allocator && !g_allocator_inited)
   {
     MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
 
-    ret_init = MEM_allocatorInit(&g_allocator);
-    if (ret_init != EXIT_SUCCESS)
+    ret = MEM_allocatorInit(&g_allocator);
+    if (ret != EXIT_SUCCESS)
       goto function_output;
   }
 
-  gc_thread = &g_allocator.gc_thread;
-
-  pthread_mutex_lock(&gc_thread->gc_lock);
-  ret_addr = MEM_callocOp(&g_allocator, size, __FILE__, __LINE__, strategy);
-  pthread_mutex_unlock(&gc_thread->gc_lock);
+  pthread_mutex_lock(&target->gc_thread.gc_lock);
+  target->gc_incr.lazy = enable;
+  pthread_mutex_unlock(&target->gc_thread.gc_lock);
 
 function_output:
-  return ret_addr;
+  return ret;
 }
 
 /** ============================================================================
- *  @brief  Reallocates memory with safety checks using the specified strategy.
+ *  @brief  Allows or forbids soft-dirty page tracking in GC cycles.
  *
- *  This function locks the GC mutex, invokes MEM_reallocOp() with the
- *  given @p strategy, automatically supplying __FILE__, __LINE__, and variable
- *  name for debugging, then unlocks the mutex.
+ *  Stores the setting under gc_lock. Forbidding tracking also drops the
+ *  generational remembered set, so the next minor collection rescans the
+ *  whole old generation. MEM_gcDirtyProbe() reports tracking unavailable
+ *  while it is forbidden.
  *
- *  @param[in]  ptr       Pointer to existing memory.
- *  @param[in]  new_size  New requested size.
- *  @param[in]  strategy  Allocation strategy.
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator (initialised on first use).
+ *  @param[in]  enable    true to use soft-dirty tracking when available,
+ *                        false to never use it.
  *
- *  @return Pointer to the reallocated memory on success (may be same as @p
- * ptr), or an error‐encoded pointer (via PTR_ERR()) on failure.
+ *  @return EXIT_SUCCESS on success,
+ *          negative error code on failure.
+ *
+ *  @retval -ENOTSUP: @p enable is true but the kernel does not report
+ *                    soft-dirty pages; the setting is stored anyway.
  * ========================================================================== */
-void *MEM_realloc(void *const                 ptr,
-                  const size_t                new_size,
-                  const allocation_strategy_t strategy)
+int MEM_gcSetDirtyTracking(mem_allocator_t *const allocator, const bool enable)
 {
-  void *ret_addr = (void *)NULL;
+  int ret = EXIT_SUCCESS;
 
-  int ret_init = EXIT_SUCCESS;
+  mem_allocator_t *target = (mem_allocator_t *)NULL;
 
-  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
+  target = (allocator != NULL) ? allocator : &g_allocator;
 
-  if (!g_allocator_inited)
+  if (target == &g_allocator && !g_allocator_inited)
   {
     MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
 
-    ret_init = MEM_allocatorInit(&g_allocator);
-    if (ret_init != EXIT_SUCCESS)
+    ret = MEM_allocatorInit(&g_allocator);
+    if (ret != EXIT_SUCCESS)
       goto function_output;
   }
 
-  gc_thread = &g_allocator.gc_thread;
+  pthread_mutex_lock(&target->gc_thread.gc_lock);
+  target->gc_incr.dirty_off = !enable;
 
-  pthread_mutex_lock(&gc_thread->gc_lock);
-  ret_addr
-    = MEM_reallocOp(&g_allocator, ptr, new_size, __FILE__, __LINE__, strategy);
-  pthread_mutex_unlock(&gc_thread->gc_lock);
+  if (!enable)
+    target->gc_gen.tracking = false;
+  else if (!MEM_gcDirtyProbe(target))
+    ret = -ENOTSUP;
+  pthread_mutex_unlock(&target->gc_thread.gc_lock);
 
 function_output:
-  return ret_addr;
+  return ret;
 }
 
 /** ============================================================================
- *  @brief  Releases allocated memory back to the heap.
+ *  @brief  Sets the allocation volume that triggers a GC thread cycle.
  *
- *  This function locks the GC mutex, invokes MEM_freeOp() with
- *  automatically supplied __FILE__, __LINE__, and variable name for debugging,
- *  then unlocks the mutex.
+ *  Stores the ratio under gc_lock and recomputes the trigger from the live
+ *  bytes the last cycle left, then wakes the GC thread so that its wait
+ *  sees the new trigger.
  *
- *  @param[in]  ptr       Pointer to memory to free.
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator (initialised on first use).
+ *  @param[in]  percent   Heap growth, in percent of the live heap, that
+ *                        triggers a cycle; 0 leaves only timed cycles.
  *
  *  @return EXIT_SUCCESS on success,
  *          negative error code on failure.
  * ========================================================================== */
-int MEM_free(void *const ptr)
+int MEM_gcSetRatio(mem_allocator_t *const allocator, const uint32_t percent)
 {
-  int ret_addr = EXIT_SUCCESS;
+  int ret = EXIT_SUCCESS;
 
-  int ret_init = EXIT_SUCCESS;
+  mem_allocator_t *target = (mem_allocator_t *)NULL;
+  gc_pace_t       *pace   = (gc_pace_t *)NULL;
 
-  gc_thread_t *gc_thread = (gc_thread_t *)NULL;
+  target = (allocator != NULL) ? allocator : &g_allocator;
 
-  if (!g_allocator_inited)
+  if (target == &g_allocator && !g_allocator_inited)
   {
     MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
 
-    ret_init = MEM_allocatorInit(&g_allocator);
-    if (ret_init != EXIT_SUCCESS)
+    ret = MEM_allocatorInit(&g_allocator);
+    if (ret != EXIT_SUCCESS)
       goto function_output;
   }
 
-  gc_thread = &g_allocator.gc_thread;
+  pace = &target->gc_pace;
 
-  pthread_mutex_lock(&gc_thread->gc_lock);
-  ret_addr = MEM_freeOp(&g_allocator, ptr, __FILE__, __LINE__);
-  pthread_mutex_unlock(&gc_thread->gc_lock);
+  pthread_mutex_lock(&target->gc_thread.gc_lock);
+
+  pace->ratio   = percent;
+  pace->trigger = pace->live_bytes / 100u * percent;
+  if (pace->trigger < GC_MIN_TRIGGER)
+    pace->trigger = GC_MIN_TRIGGER;
+
+  pthread_cond_signal(&target->gc_thread.gc_cond);
+  pthread_mutex_unlock(&target->gc_thread.gc_lock);
 
 function_output:
-  return ret_addr;
+  return ret;
 }
 
-#if defined(GARBAGE_COLLECTOR)
-
 /** ============================================================================
- *  @brief  Start or signal the garbage collector thread.
+ *  @brief  Runs a full collection and waits for it to complete.
  *
- *  This function simply wraps MEM_runGc(), starting the GC thread if needed
- *  or signaling it to perform a collection cycle.
+ *  With the GC thread running, requests a cycle and waits on gc_pace.done
+ *  until a cycle started after the request completed, then finishes its
+ *  lazy sweep if one is pending. Otherwise, or if the thread stops first,
+ *  drives MEM_gcStepOp() on the caller with gc_lock held, completing any
+ *  cycle in progress before running a fresh one.
  *
- *  @param[in]  allocator Memory allocator context.
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator (initialised on first use).
  *
  *  @return EXIT_SUCCESS on success,
  *          negative error code on failure.
+ *
+ *  @retval -ENOMEM:  The mark bitmaps could not be grown.
+ *  @retval -EBUSY:   A fork() snapshot is still being collected.
  * ========================================================================== */
-int MEM_enableGc(mem_allocator_t *const allocator)
+int MEM_gcCollect(mem_allocator_t *const allocator)
 {
   int ret = EXIT_SUCCESS;
 
-  ret = MEM_runGc(allocator);
+  mem_allocator_t *target    = (mem_allocator_t *)NULL;
+  gc_thread_t     *gc_thread = (gc_thread_t *)NULL;
+  gc_pace_t       *pace      = (gc_pace_t *)NULL;
+
+  uint64_t wanted = 0u;
+
+  bool fresh = false;
+
+  target = (allocator != NULL) ? allocator : &g_allocator;
+
+  if (target == &g_allocator && !g_allocator_inited)
+  {
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
+
+    ret = MEM_allocatorInit(&g_allocator);
+    if (ret != EXIT_SUCCESS)
+      goto function_output;
+  }
+
+  gc_thread = &target->gc_thread;
+  pace      = &target->gc_pace;
+
+  pthread_mutex_lock(&gc_thread->gc_lock);
+
+  if (gc_thread->gc_thread_started && gc_thread->gc_running)
+  {
+    wanted          = pace->started + 1u;
+    pace->requested = true;
+    pthread_cond_signal(&gc_thread->gc_cond);
+
+    while (pace->cycles < wanted && gc_thread->gc_running)
+      pthread_cond_wait(&pace->done, &gc_thread->gc_lock);
+
+    if (pace->cycles >= wanted)
+    {
+      while (target->gc_incr.phase == GC_INCR_SWEEP
+             && !MEM_gcIncrSweep(target,
+                                 MEM_gcClockNs( )
+                                   + (uint64_t)GC_SLICE_US * NSEC_PER_USEC))
+        continue;
+
+      goto mutex_unlock;
+    }
+  }
+
+  fresh = (target->gc_incr.phase == GC_INCR_IDLE);
+
+  do
+  {
+    ret = MEM_gcStepOp(target, GC_SLICE_US);
+    if (ret == MEM_GC_CYCLE_DONE && !fresh)
+    {
+      fresh = true;
+      ret   = EXIT_SUCCESS;
+    }
+  } while (ret == EXIT_SUCCESS);
+
+  if (ret == MEM_GC_CYCLE_DONE)
+    ret = EXIT_SUCCESS;
 
+mutex_unlock:
+  pthread_mutex_unlock(&gc_thread->gc_lock);
+function_output:
   return ret;
 }
 
 /** ============================================================================
- *  @brief  Stop the garbage collector thread and perform a final collection.
+ *  @brief  Reads the garbage collector cycle metrics.
  *
- *  This function simply wraps MEM_stopGc(), signaling the GC thread to exit,
- *  joining it, and running a final mark-and-sweep cycle on the caller thread.
+ *  Copies the totals and the recorded part of the ring, oldest cycle first,
+ *  under gc_lock.
  *
- *  @param[in]  allocator Memory allocator context
+ *  @param[in]  allocator Memory allocator context, or NULL for the global
+ *                        allocator (initialised on first use).
+ *  @param[out] stats     Destination snapshot.
  *
  *  @return EXIT_SUCCESS on success,
  *          negative error code on failure.
+ *
+ *  @retval -EINVAL:  @p stats is NULL.
  * ========================================================================== */
-int MEM_disableGc(mem_allocator_t *const allocator)
+int MEM_getGcStats(mem_allocator_t *const allocator,
+                   mem_gc_stats_t *const  stats)
 {
   int ret = EXIT_SUCCESS;
 
-  ret = MEM_stopGc(allocator);
+  mem_allocator_t *target = (mem_allocator_t *)NULL;
+  gc_stats_t      *source = (gc_stats_t *)NULL;
+
+  uint64_t first = 0u;
+
+  uint32_t iterator = 0u;
+
+  if (UNLIKELY(stats == NULL))
+  {
+    ret = -EINVAL;
+    LOG_ERROR("Invalid parameters: stats: %p. "
+              "Error code: %d.\n",
+              (void *)stats,
+              ret);
+    goto function_output;
+  }
+
+  target = (allocator != NULL) ? allocator : &g_allocator;
+
+  if (target == &g_allocator && !g_allocator_inited)
+  {
+    MEM_memset(&g_allocator, 0, sizeof(mem_allocator_t));
+
+    ret = MEM_allocatorInit(&g_allocator);
+    if (ret != EXIT_SUCCESS)
+      goto function_output;
+  }
+
+  source = &target->gc_stats;
+
+  pthread_mutex_lock(&target->gc_thread.gc_lock);
+
+  stats->cycles       = source->cycles;
+  stats->gc_ns        = source->gc_ns;
+  stats->pause_ns     = source->pause_ns;
+  stats->max_pause_ns = source->max_pause_ns;
 
+  stats->count = (source->cycles < MEM_GC_STATS_RING)
+                 ? (uint32_t)source->cycles
+                 : (uint32_t)MEM_GC_STATS_RING;
+
+  first = source->cycles - stats->count;
+  for (iterator = 0u; iterator < stats->count; ++iterator)
+    stats->recent[iterator]
+      = source->ring[(first + iterator) % MEM_GC_STATS_RING];
+
+  pthread_mutex_unlock(&target->gc_thread.gc_lock);
+
+function_output:
   return ret;
 }
 
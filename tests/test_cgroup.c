@@ -0,0 +1,563 @@
+/*
+ * SPDX-FileCopyrightText: 2024-2025 Rafael V. Volkmer
+ * SPDX-FileCopyrightText: <rafael.v.volkmer@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+/** ============================================================================
+ *  @ingroup    Libmemalloc
+ *
+ *  @brief      cgroup-aware tuning test.
+ *
+ *  @file       test_cgroup.c
+ *  @headerfile libmemalloc.h
+ *
+ *  @details    Points the allocator at a fake cgroup v2 directory through
+ *              MEM_CGROUP_ENV and checks the limits, cadence and cache
+ *              budget derived from memory.max / memory.current, the
+ *              pressure event raised when usage is high, that the derived
+ *              soft limit is checked against memory.current while the
+ *              derived hard level never refuses an allocation, that limits
+ *              set through MEM_setLimit() keep the GC cadence, that the
+ *              PSI monitor refreshes the snapshot without any allocation,
+ *              and the fallback when the cgroup is unlimited or missing.
+ *
+ *  @version    v1.0.00
+ *  @date       18.10.2026
+ *  @author     Rafael V. Volkmer <rafael.v.volkmer@gmail.com>
+ * ========================================================================== */
+
+/** ============================================================================
+ *                      P R I V A T E  I N C L U D E S
+ * ========================================================================== */
+
+/*< Implemented >*/
+#include "libmemalloc.h"
+#include "logs.h"
+
+/*< Dependencies >*/
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/** ============================================================================
+ *               P R I V A T E  D E F I N E S  &  M A C R O S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @def        EXIT_ERROR
+ *  @brief      Standard error return code for test failures.
+ *
+ *  @details    Defined as a uint8_t value of 1 to indicate any
+ *              assertion or test step failure within the test suite.
+ *              Returned by test functions when a CHECK() fails.
+ * ========================================================================== */
+#define EXIT_ERROR    (uint8_t)(1U)
+
+/** ============================================================================
+ *  @def        CGROUP_MAX
+ *  @brief      memory.max written to the fake cgroup.
+ * ========================================================================== */
+#define CGROUP_MAX    (size_t)(8U * 1024U * 1024U)
+
+/** ============================================================================
+ *  @def        CGROUP_IDLE
+ *  @brief      memory.current below every derived threshold.
+ * ========================================================================== */
+#define CGROUP_IDLE   (size_t)(1U * 1024U * 1024U)
+
+/** ============================================================================
+ *  @def        CGROUP_BUSY
+ *  @brief      memory.current above the derived soft level.
+ * ========================================================================== */
+#define CGROUP_BUSY   (size_t)(7U * 1024U * 1024U)
+
+/** ============================================================================
+ *  @def        CGROUP_GROW
+ *  @brief      Request that takes CGROUP_BUSY past the derived hard
+ *              level.
+ * ========================================================================== */
+#define CGROUP_GROW   (size_t)(1U * 1024U * 1024U)
+
+/** ============================================================================
+ *  @def        MONITOR_STALL_US
+ *  @brief      PSI stall threshold of the monitor started by the test.
+ * ========================================================================== */
+#define MONITOR_STALL_US  (uint32_t)(150000U)
+
+/** ============================================================================
+ *  @def        MONITOR_WINDOW_US
+ *  @brief      PSI window accepted from unprivileged processes.
+ * ========================================================================== */
+#define MONITOR_WINDOW_US (uint32_t)(2000000U)
+
+/** ============================================================================
+ *  @def        MONITOR_POLL_US
+ *  @brief      Interval between two reads of the cgroup snapshot.
+ * ========================================================================== */
+#define MONITOR_POLL_US   (uint32_t)(10000U)
+
+/** ============================================================================
+ *  @def        MONITOR_WAIT_US
+ *  @brief      Longest wait for the monitor to refresh the snapshot.
+ * ========================================================================== */
+#define MONITOR_WAIT_US   (uint32_t)(2000000U)
+
+/** ============================================================================
+ *  @def        CHECK(expr)
+ *  @brief      Assertion macro for validating test expressions.
+ *
+ *  @param [in] expr  Boolean expression to evaluate.
+ *
+ *  @details    Evaluates the given expression and, if false,
+ *              logs an error with file and line information,
+ *              then returns EXIT_ERROR from the current function.
+ *              Ensures immediate test termination on failure.
+ * ========================================================================== */
+#define CHECK(expr)                                                          \
+  do                                                                         \
+  {                                                                          \
+    if (!(expr))                                                             \
+    {                                                                        \
+      LOG_ERROR("Assertion failed at %s:%d: %s", __FILE__, __LINE__, #expr); \
+      return EXIT_ERROR;                                                     \
+    }                                                                        \
+  } while (0)
+
+/** ============================================================================
+ *                  P R I V A T E  G L O B A L  V A R I A B L E S
+ * ========================================================================== */
+
+/** @brief Fake cgroup directory created by main(). */
+static char g_cgroup_dir[] = "/tmp/memalloc_cgroupXXXXXX";
+
+/** @brief Number of pressure events observed. */
+static size_t g_pressure_events = 0u;
+
+/** ============================================================================
+ *          P R I V A T E  F U N C T I O N S  P R O T O T Y P E S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         TEST_writeValue
+ *  @brief      Writes a memory file of the fake cgroup.
+ *
+ *  @param[in]  file      File name inside g_cgroup_dir.
+ *  @param[in]  value     Text written to the file.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_writeValue(const char *const file, const char *const value);
+
+/** ============================================================================
+ *  @fn         TEST_onPressure
+ *  @brief      Pressure callback counting events.
+ *
+ *  @param[in]  level     Pressure severity.
+ *  @param[in]  footprint Footprint reported by the allocator.
+ *  @param[in]  arg       Unused.
+ * ========================================================================== */
+static void TEST_onPressure(const mem_pressure_level_t level,
+                            const size_t               footprint,
+                            void *const                arg);
+
+/** ============================================================================
+ *  @fn         TEST_cgroupInit
+ *  @brief      Checks the tuning derived at initialisation.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_cgroupInit(void);
+
+/** ============================================================================
+ *  @fn         TEST_cgroupPressure
+ *  @brief      Checks high usage tuning, pressure and the derived limits.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_cgroupPressure(void);
+
+/** ============================================================================
+ *  @fn         TEST_cgroupUserLimit
+ *  @brief      Checks that a refresh leaves the GC cadence alone while
+ *              MEM_setLimit() limits are in force.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_cgroupUserLimit(void);
+
+/** ============================================================================
+ *  @fn         TEST_cgroupMonitor
+ *  @brief      Checks that the PSI monitor thread refreshes the snapshot
+ *              while nothing allocates.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_cgroupMonitor(void);
+
+/** ============================================================================
+ *  @fn         TEST_cgroupUnlimited
+ *  @brief      Checks that an unlimited cgroup disables derived limits.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_cgroupUnlimited(void);
+
+/** ============================================================================
+ *  @fn         TEST_cgroupMissing
+ *  @brief      Checks the behavior with a missing cgroup directory.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_cgroupMissing(void);
+
+/** ============================================================================
+ *                          M A I N  F U N C T I O N
+ * ========================================================================== */
+
+int main(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  char max[32]     = { 0 };
+  char current[32] = { 0 };
+
+  CHECK(mkdtemp(g_cgroup_dir) != NULL);
+
+  (void)snprintf(max, sizeof(max), "%zu\n", CGROUP_MAX);
+  (void)snprintf(current, sizeof(current), "%zu\n", CGROUP_IDLE);
+
+  ret = TEST_writeValue("memory.max", max);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_writeValue("memory.current", current);
+  CHECK(ret == EXIT_SUCCESS);
+
+  CHECK(setenv(MEM_CGROUP_ENV, g_cgroup_dir, 1) == 0);
+
+  ret = TEST_cgroupInit( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_cgroupPressure( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_cgroupUserLimit( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_cgroupMonitor( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_cgroupUnlimited( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_cgroupMissing( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  (void)TEST_writeValue("memory.max", (const char *)NULL);
+  (void)TEST_writeValue("memory.current", (const char *)NULL);
+  (void)rmdir(g_cgroup_dir);
+
+  LOG_INFO("cgroup test passed.\n");
+  return ret;
+}
+
+/** ============================================================================
+ *                  F U N C T I O N S  D E F I N I T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         TEST_writeValue
+ *  @brief      Writes a memory file of the fake cgroup (NULL removes it).
+ *
+ *  @param[in]  file      File name inside g_cgroup_dir.
+ *  @param[in]  value     Text written to the file.
+ *
+ *  @return     EXIT_SUCCESS on success, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_writeValue(const char *const file, const char *const value)
+{
+  char path[256] = { 0 };
+
+  FILE *stream = (FILE *)NULL;
+
+  (void)snprintf(path, sizeof(path), "%s/%s", g_cgroup_dir, file);
+
+  if (value == NULL)
+    return (unlink(path) == 0) ? EXIT_SUCCESS : EXIT_ERROR;
+
+  stream = fopen(path, "w");
+  CHECK(stream != NULL);
+
+  CHECK(fputs(value, stream) >= 0);
+  CHECK(fclose(stream) == 0);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_onPressure
+ *  @brief      Pressure callback counting events.
+ *
+ *  @param[in]  level     Pressure severity.
+ *  @param[in]  footprint Footprint reported by the allocator.
+ *  @param[in]  arg       Unused.
+ * ========================================================================== */
+static void TEST_onPressure(const mem_pressure_level_t level,
+                            const size_t               footprint,
+                            void *const                arg)
+{
+  (void)level;
+  (void)footprint;
+  (void)arg;
+
+  g_pressure_events++;
+}
+
+/** ============================================================================
+ *  @fn         TEST_cgroupInit
+ *  @brief      Checks the tuning derived at initialisation.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_cgroupInit(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  mem_cgroup_info_t info = { 0 };
+
+  ret = MEM_getCgroupInfo(&info);
+  CHECK(ret == EXIT_SUCCESS);
+
+  CHECK(info.max == CGROUP_MAX);
+  CHECK(info.current == CGROUP_IDLE);
+  CHECK(info.soft_limit == CGROUP_MAX / 100u * 80u);
+  CHECK(info.hard_limit == CGROUP_MAX / 100u * 95u);
+  CHECK(info.cache_budget == CGROUP_MAX / 8u);
+  CHECK(info.gc_interval_ms == GC_INTERVAL_MS);
+  CHECK(info.refresh_ms == 1000u);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_cgroupPressure
+ *  @brief      Checks high usage tuning, pressure and the derived limits.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_cgroupPressure(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  char current[32] = { 0 };
+
+  void *ptr = (void *)NULL;
+
+  mem_cgroup_info_t info = { 0 };
+
+  ret = MEM_onPressure(TEST_onPressure, NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  (void)snprintf(current, sizeof(current), "%zu\n", CGROUP_BUSY);
+
+  ret = TEST_writeValue("memory.current", current);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_cgroupRefresh((const char *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(g_pressure_events == 1u);
+
+  ret = MEM_getCgroupInfo(&info);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(info.current == CGROUP_BUSY);
+  CHECK(info.gc_interval_ms < GC_INTERVAL_MS);
+  CHECK(info.refresh_ms < 1000u);
+
+  ptr = MEM_alloc(CGROUP_GROW, FIRST_FIT);
+  CHECK(ptr != NULL && (intptr_t)ptr > 0);
+  CHECK(g_pressure_events == 2u);
+
+  ret = MEM_free(ptr);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_cgroupUserLimit
+ *  @brief      Checks that a refresh leaves the GC cadence alone while
+ *              MEM_setLimit() limits are in force.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_cgroupUserLimit(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  char current[32] = { 0 };
+
+  void *ptr = (void *)NULL;
+
+  mem_cgroup_info_t info = { 0 };
+
+  uint32_t interval = 0u;
+
+  ret = MEM_getCgroupInfo(&info);
+  CHECK(ret == EXIT_SUCCESS);
+  interval = info.gc_interval_ms;
+
+  ret = MEM_setLimit(2u * CGROUP_MAX, 4u * CGROUP_MAX);
+  CHECK(ret == EXIT_SUCCESS);
+
+  (void)snprintf(current, sizeof(current), "%zu\n", CGROUP_IDLE);
+
+  ret = TEST_writeValue("memory.current", current);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_cgroupRefresh((const char *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_getCgroupInfo(&info);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(info.current == CGROUP_IDLE);
+  CHECK(info.gc_interval_ms == interval);
+
+  ptr = MEM_alloc(CGROUP_GROW, FIRST_FIT);
+  CHECK(ptr != NULL && (intptr_t)ptr > 0);
+
+  ret = MEM_free(ptr);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_setLimit(0u, 0u);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_cgroupRefresh((const char *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_getCgroupInfo(&info);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(info.gc_interval_ms == GC_INTERVAL_MS);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_cgroupMonitor
+ *  @brief      Checks that the PSI monitor thread refreshes the snapshot
+ *              while nothing allocates.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_cgroupMonitor(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  char current[32] = { 0 };
+
+  mem_cgroup_info_t info = { 0 };
+
+  uint32_t waited = 0u;
+
+  (void)snprintf(current, sizeof(current), "%zu\n", CGROUP_BUSY);
+
+  ret = TEST_writeValue("memory.current", current);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_cgroupRefresh((const char *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_psiMonitorStart(MONITOR_STALL_US, MONITOR_WINDOW_US);
+  if (ret != EXIT_SUCCESS)
+  {
+    CHECK(ret < 0);
+    LOG_INFO("PSI not available here (%d), monitor refresh skipped.\n", ret);
+    return EXIT_SUCCESS;
+  }
+
+  (void)snprintf(current, sizeof(current), "%zu\n", CGROUP_IDLE);
+
+  ret = TEST_writeValue("memory.current", current);
+  CHECK(ret == EXIT_SUCCESS);
+
+  do
+  {
+    (void)usleep(MONITOR_POLL_US);
+    waited += MONITOR_POLL_US;
+
+    ret = MEM_getCgroupInfo(&info);
+    CHECK(ret == EXIT_SUCCESS);
+  } while (info.current != CGROUP_IDLE && waited < MONITOR_WAIT_US);
+
+  ret = MEM_psiMonitorStop( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  CHECK(info.current == CGROUP_IDLE);
+  CHECK(info.refresh_ms == 1000u);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_cgroupUnlimited
+ *  @brief      Checks that an unlimited cgroup disables derived limits.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_cgroupUnlimited(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  void *ptr = (void *)NULL;
+
+  mem_cgroup_info_t info = { 0 };
+
+  ret = TEST_writeValue("memory.max", "max\n");
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_cgroupRefresh(g_cgroup_dir);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_getCgroupInfo(&info);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(info.max == SIZE_MAX);
+  CHECK(info.soft_limit == 0u);
+  CHECK(info.hard_limit == 0u);
+  CHECK(info.gc_interval_ms == GC_INTERVAL_MS);
+
+  ptr = MEM_alloc(CGROUP_MAX, FIRST_FIT);
+  CHECK(ptr != NULL && (intptr_t)ptr > 0);
+
+  ret = MEM_free(ptr);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_cgroupMissing
+ *  @brief      Checks the behavior with a missing cgroup directory.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_cgroupMissing(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  mem_cgroup_info_t info = { 0 };
+
+  ret = MEM_cgroupRefresh("/nonexistent/memalloc");
+  CHECK(ret == -ENOENT);
+
+  ret = MEM_getCgroupInfo(&info);
+  CHECK(ret == -ENOENT);
+
+  ret = MEM_getCgroupInfo((mem_cgroup_info_t *)NULL);
+  CHECK(ret == -EINVAL);
+
+  return EXIT_SUCCESS;
+}
+
+/*< end of file >*/
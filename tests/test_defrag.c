@@ -0,0 +1,264 @@
+/*
+ * SPDX-FileCopyrightText: 2024-2025 Rafael V. Volkmer
+ * SPDX-FileCopyrightText: <rafael.v.volkmer@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+/** ============================================================================
+ *  @ingroup    Libmemalloc
+ *
+ *  @brief      Cooperative relocation test.
+ *
+ *  @file       test_defrag.c
+ *  @headerfile libmemalloc.h
+ *
+ *  @details    Leaves a small block alone between freed page-sized runs
+ *              above a densely used region with holes, checks that
+ *              MEM_shouldRelocate() reports it, that MEM_relocate() moves
+ *              it down into a hole with its contents, and that dense,
+ *              mmap and NULL pointers are left where they are.
+ *
+ *  @version    v1.0.00
+ *  @date       18.10.2026
+ *  @author     Rafael V. Volkmer <rafael.v.volkmer@gmail.com>
+ * ========================================================================== */
+
+/** ============================================================================
+ *                      P R I V A T E  I N C L U D E S
+ * ========================================================================== */
+
+/*< Implemented >*/
+#include "libmemalloc.h"
+#include "logs.h"
+
+/*< Dependencies >*/
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** ============================================================================
+ *               P R I V A T E  D E F I N E S  &  M A C R O S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @def        EXIT_ERROR
+ *  @brief      Standard error return code for test failures.
+ *
+ *  @details    Defined as a uint8_t value of 1 to indicate any
+ *              assertion or test step failure within the test suite.
+ *              Returned by test functions when a CHECK() fails.
+ * ========================================================================== */
+#define EXIT_ERROR  (uint8_t)(1U)
+
+/** ============================================================================
+ *  @def        NUM_DENSE
+ *  @brief      Blocks allocated for the densely used region.
+ * ========================================================================== */
+#define NUM_DENSE   (size_t)(64U)
+
+/** ============================================================================
+ *  @def        SMALL_SIZE
+ *  @brief      Payload size of the dense blocks and of the relocated block.
+ * ========================================================================== */
+#define SMALL_SIZE  (size_t)(256U)
+
+/** ============================================================================
+ *  @def        SPACER_SIZE
+ *  @brief      Payload size of the runs freed around the relocated block.
+ * ========================================================================== */
+#define SPACER_SIZE (size_t)(16U * 1024U)
+
+/** ============================================================================
+ *  @def        MMAP_SIZE
+ *  @brief      Payload size served by mmap rather than the heap.
+ * ========================================================================== */
+#define MMAP_SIZE   (size_t)(256U * 1024U)
+
+/** ============================================================================
+ *  @def        CHECK(expr)
+ *  @brief      Assertion macro for validating test expressions.
+ *
+ *  @param [in] expr  Boolean expression to evaluate.
+ *
+ *  @details    Evaluates the given expression and, if false,
+ *              logs an error with file and line information,
+ *              then returns EXIT_ERROR from the current function.
+ *              Ensures immediate test termination on failure.
+ * ========================================================================== */
+#define CHECK(expr)                                                          \
+  do                                                                         \
+  {                                                                          \
+    if (!(expr))                                                             \
+    {                                                                        \
+      LOG_ERROR("Assertion failed at %s:%d: %s", __FILE__, __LINE__, #expr); \
+      return EXIT_ERROR;                                                     \
+    }                                                                        \
+  } while (0)
+
+/** ============================================================================
+ *          P R I V A T E  F U N C T I O N S  P R O T O T Y P E S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         TEST_relocateSparse
+ *  @brief      Checks that a block isolated in free pages is reported and
+ *              moved down into the dense region with its contents.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_relocateSparse(void);
+
+/** ============================================================================
+ *  @fn         TEST_relocateStays
+ *  @brief      Checks that mmap and NULL pointers are not relocated.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_relocateStays(void);
+
+/** ============================================================================
+ *                          M A I N  F U N C T I O N
+ * ========================================================================== */
+
+int main(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  ret = TEST_relocateSparse( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_relocateStays( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  LOG_INFO("Defragmentation test passed.\n");
+  return ret;
+}
+
+/** ============================================================================
+ *                  F U N C T I O N S  D E F I N I T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         TEST_relocateSparse
+ *  @brief      Checks that a block isolated in free pages is reported and
+ *              moved down into the dense region with its contents.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_relocateSparse(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  static uint8_t *dense[NUM_DENSE] = { 0 };
+
+  uint8_t *spacer_lo = (uint8_t *)NULL;
+  uint8_t *spacer_hi = (uint8_t *)NULL;
+  uint8_t *victim    = (uint8_t *)NULL;
+  uint8_t *moved     = (uint8_t *)NULL;
+  uint8_t *pin       = (uint8_t *)NULL;
+
+  size_t iterator = 0u;
+
+  for (iterator = 0u; iterator < NUM_DENSE; ++iterator)
+  {
+    dense[iterator] = (uint8_t *)MEM_allocFirstFit(SMALL_SIZE);
+    CHECK(dense[iterator] != NULL && (intptr_t)dense[iterator] > 0);
+  }
+
+  spacer_lo = (uint8_t *)MEM_allocFirstFit(SPACER_SIZE);
+  CHECK(spacer_lo != NULL && (intptr_t)spacer_lo > 0);
+
+  victim = (uint8_t *)MEM_allocFirstFit(SMALL_SIZE);
+  CHECK(victim != NULL && (intptr_t)victim > 0);
+
+  spacer_hi = (uint8_t *)MEM_allocFirstFit(SPACER_SIZE);
+  CHECK(spacer_hi != NULL && (intptr_t)spacer_hi > 0);
+
+  pin = (uint8_t *)MEM_allocFirstFit(SMALL_SIZE);
+  CHECK(pin != NULL && (intptr_t)pin > 0);
+
+  CHECK(dense[NUM_DENSE - 1u] < spacer_lo && spacer_lo < victim);
+  CHECK(victim < spacer_hi && spacer_hi < pin);
+
+  MEM_memset(victim, 0x5A, SMALL_SIZE);
+
+  CHECK(!MEM_shouldRelocate(victim));
+
+  for (iterator = 0u; iterator < NUM_DENSE; iterator += 2u)
+  {
+    ret = MEM_free(dense[iterator]);
+    CHECK(ret == EXIT_SUCCESS);
+
+    dense[iterator] = (uint8_t *)NULL;
+  }
+
+  CHECK(!MEM_shouldRelocate(victim));
+
+  ret = MEM_free(spacer_lo);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_free(spacer_hi);
+  CHECK(ret == EXIT_SUCCESS);
+
+  CHECK(MEM_shouldRelocate(victim));
+  CHECK(!MEM_shouldRelocate(dense[1]));
+
+  moved = (uint8_t *)MEM_relocate(victim);
+  CHECK(moved != NULL && (intptr_t)moved > 0);
+  CHECK(moved < dense[NUM_DENSE - 1u]);
+  CHECK(moved[0] == 0x5A && moved[SMALL_SIZE - 1u] == 0x5A);
+
+  CHECK(!MEM_shouldRelocate(moved));
+  CHECK(MEM_relocate(moved) == moved);
+
+  ret = MEM_free(moved);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_free(pin);
+  CHECK(ret == EXIT_SUCCESS);
+
+  for (iterator = 1u; iterator < NUM_DENSE; iterator += 2u)
+  {
+    ret = MEM_free(dense[iterator]);
+    CHECK(ret == EXIT_SUCCESS);
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_relocateStays
+ *  @brief      Checks that mmap and NULL pointers are not relocated.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_relocateStays(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  uint8_t *large = (uint8_t *)NULL;
+
+  void *result = (void *)NULL;
+
+  large = (uint8_t *)MEM_allocFirstFit(MMAP_SIZE);
+  CHECK(large != NULL && (intptr_t)large > 0);
+
+  CHECK(!MEM_shouldRelocate(large));
+
+  result = MEM_relocate(large);
+  CHECK(result == large);
+
+  CHECK(!MEM_shouldRelocate(NULL));
+
+  result = MEM_relocate(NULL);
+  CHECK((intptr_t)result == -EINVAL);
+
+  ret = MEM_free(large);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/*< end of file >*/
@@ -0,0 +1,2250 @@
+/*
+ * SPDX-FileCopyrightText: 2024-2025 Rafael V. Volkmer
+ * SPDX-FileCopyrightText: <rafael.v.volkmer@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+/** ============================================================================
+ *  @ingroup    Libmemalloc
+ *
+ *  @brief      Garbage collector marking test.
+ *
+ *  @file       test_gc.c
+ *  @headerfile libmemalloc.h
+ *
+ *  @details    Builds linked lists reachable only through their head pointer,
+ *              held on the main stack, in a global and on the stacks of
+ *              registered worker threads, runs the collector and checks that
+ *              every node survives the sweep. Then allocates tagged blocks
+ *              whose pointers are dropped and checks that the collector
+ *              reclaims them, and that blocks referenced only through
+ *              interior pointers are kept. The marking and garbage checks
+ *              are repeated with several parallel workers. Finally runs
+ *              a cycle in time-budgeted MEM_gcStep() calls, storing a
+ *              pointer into an already traced block and allocating between
+ *              steps, and checks mutator assists complete a cycle. Then
+ *              lets the GC thread collect while the main thread keeps
+ *              moving the only reference to a block between the first and
+ *              last cells of a long chain, with soft-dirty tracking
+ *              allowed and forbidden, and checks the block survives. Last,
+ *              lets the collector thread mark in a fork()ed child while
+ *              the main thread keeps allocating, and checks the garbage
+ *              is freed and the live lists kept. Then runs generational
+ *              cycles and checks that a young block referenced only from
+ *              an old one survives the minor collections while young
+ *              garbage is freed, and that a list whose nodes are freed
+ *              and replaced by young copies, linked from old nodes, stays
+ *              intact across full and minor collections while garbage is
+ *              reclaimed around it. Last, leaves the sweep to allocations
+ *              and checks they reclaim the garbage, and that a block
+ *              referenced only from a MEM_allocAtomic() block is freed
+ *              while the atomic block is kept. Last, registers a precise
+ *              layout and checks that a typed block keeps the block its
+ *              pointer field references but not the one whose address
+ *              sits in an integer field. Last, checks that
+ *              MEM_gcCollect() reclaims garbage at once, both through the
+ *              GC thread and on the caller. Last, leaves the address
+ *              of a freed block in a global and checks that, after a
+ *              cycle, a new block is not placed on its blacklisted page.
+ *              Last, checks that MEM_getGcStats() reports the collected
+ *              cycle with its timings and mark and sweep counts. Last,
+ *              keeps a list reachable only from a MEM_hAlloc() block and
+ *              checks that both survive a collection and a compaction.
+ *              Last, lets more threads than the registry holds register
+ *              and exit without unregistering, and checks that each one
+ *              registers and that a collection still completes.
+ *              Built without GARBAGE_COLLECTOR, the test only reports a
+ *              skip.
+ *
+ *  @version    v1.0.00
+ *  @date       18.10.2026
+ *  @author     Rafael V. Volkmer <rafael.v.volkmer@gmail.com>
+ * ========================================================================== */
+
+/** ============================================================================
+ *                      P R I V A T E  I N C L U D E S
+ * ========================================================================== */
+
+/*< Implemented >*/
+#include "libmemalloc.h"
+#include "logs.h"
+
+/*< Dependencies >*/
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/** ============================================================================
+ *               P R I V A T E  D E F I N E S  &  M A C R O S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @def        EXIT_ERROR
+ *  @brief      Standard error return code for test failures.
+ *
+ *  @details    Defined as a uint8_t value of 1 to indicate any
+ *              assertion or test step failure within the test suite.
+ *              Returned by test functions when a CHECK() fails.
+ * ========================================================================== */
+#define EXIT_ERROR     (uint8_t)(1U)
+
+/** ============================================================================
+ *  @def        NUM_NODES
+ *  @brief      Number of nodes in the collected linked list.
+ * ========================================================================== */
+#define NUM_NODES      (uint16_t)(256U)
+
+/** ============================================================================
+ *  @def        NUM_WORKERS
+ *  @brief      Number of registered threads holding their own list.
+ * ========================================================================== */
+#define NUM_WORKERS    (uint8_t)(4U)
+
+/** ============================================================================
+ *  @def        NUM_GARBAGE
+ *  @brief      Number of unreachable blocks handed to the collector.
+ * ========================================================================== */
+#define NUM_GARBAGE    (uint8_t)(64U)
+
+/** ============================================================================
+ *  @def        GARBAGE_SIZE
+ *  @brief      Payload size of each unreachable block.
+ * ========================================================================== */
+#define GARBAGE_SIZE   (size_t)(96U)
+
+/** ============================================================================
+ *  @def        SCRUB_SIZE
+ *  @brief      Bytes of stack cleared to drop stale garbage pointers.
+ * ========================================================================== */
+#define SCRUB_SIZE     (size_t)(4096U)
+
+/** ============================================================================
+ *  @def        INNER_SIZE
+ *  @brief      Payload size of the heap block kept by an interior pointer.
+ * ========================================================================== */
+#define INNER_SIZE     (size_t)(200U)
+
+/** ============================================================================
+ *  @def        INNER_LARGE
+ *  @brief      Payload size of the mmap block kept by an interior pointer.
+ * ========================================================================== */
+#define INNER_LARGE    (size_t)(256U * 1024U)
+
+/** ============================================================================
+ *  @def        INNER_OFFSET
+ *  @brief      Offset of the interior pointer kept into each block.
+ * ========================================================================== */
+#define INNER_OFFSET   (size_t)(40U)
+
+/** ============================================================================
+ *  @def        NUM_LISTS
+ *  @brief      Number of lists traced concurrently by the parallel workers.
+ * ========================================================================== */
+#define NUM_LISTS      (uint8_t)(16U)
+
+/** ============================================================================
+ *  @def        GC_WAIT_US
+ *  @brief      Time given to the collector thread before it is stopped.
+ * ========================================================================== */
+#define GC_WAIT_US     (useconds_t)(100000U)
+
+/** ============================================================================
+ *  @def        STEP_BUDGET_US
+ *  @brief      Time budget of each incremental step.
+ * ========================================================================== */
+#define STEP_BUDGET_US (uint32_t)(50U)
+
+/** ============================================================================
+ *  @def        MAX_STEPS
+ *  @brief      Steps allowed before an incremental cycle is deemed stuck.
+ * ========================================================================== */
+#define MAX_STEPS      (uint32_t)(100000U)
+
+/** ============================================================================
+ *  @def        HIDDEN_SIZE
+ *  @brief      Payload size of the block hidden from the root scan.
+ * ========================================================================== */
+#define HIDDEN_SIZE    (size_t)(160U)
+
+/** ============================================================================
+ *  @def        HIDE_KEY
+ *  @brief      Mask that keeps the hidden block's address from looking like
+ *              a pointer.
+ * ========================================================================== */
+#define HIDE_KEY       (uintptr_t)(0x5555555555555555ULL)
+
+/** ============================================================================
+ *  @def        ASSIST_US
+ *  @brief      Mutator assist budget per MiB allocated.
+ * ========================================================================== */
+#define ASSIST_US      (uint32_t)(1000U)
+
+/** ============================================================================
+ *  @def        ASSIST_SIZE
+ *  @brief      Payload size of the allocations paying for assists.
+ * ========================================================================== */
+#define ASSIST_SIZE    (size_t)(4096U)
+
+/** ============================================================================
+ *  @def        SNAP_POLLS
+ *  @brief      Polls of the tag counters before a snapshot cycle fails.
+ * ========================================================================== */
+#define SNAP_POLLS     (uint32_t)(500U)
+
+/** ============================================================================
+ *  @def        SNAP_POLL_US
+ *  @brief      Delay between two polls of the tag counters.
+ * ========================================================================== */
+#define SNAP_POLL_US   (useconds_t)(10000U)
+
+/** ============================================================================
+ *  @def        FULL_EVERY
+ *  @brief      Minor collections between full ones in generational mode.
+ * ========================================================================== */
+#define FULL_EVERY     (uint32_t)(4U)
+
+/** ============================================================================
+ *  @def        CONC_CELLS
+ *  @brief      Cells of the chain traced while the main thread mutates it.
+ * ========================================================================== */
+#define CONC_CELLS     (uint32_t)(16384U)
+
+/** ============================================================================
+ *  @def        CONC_CYCLES
+ *  @brief      GC thread collections run against the mutating chain.
+ * ========================================================================== */
+#define CONC_CYCLES    (uint32_t)(24U)
+
+/** ============================================================================
+ *  @def        CHURN_ROUNDS
+ *  @brief      Rounds of node replacement in the generational churn test.
+ * ========================================================================== */
+#define CHURN_ROUNDS   (uint32_t)(40U)
+
+/** ============================================================================
+ *  @def        CHURN_STRIDE
+ *  @brief      One list node in CHURN_STRIDE is replaced per round.
+ * ========================================================================== */
+#define CHURN_STRIDE   (uint32_t)(4U)
+
+/** ============================================================================
+ *  @def        CHURN_US
+ *  @brief      Delay between two churn rounds.
+ * ========================================================================== */
+#define CHURN_US       (useconds_t)(25000U)
+
+/** ============================================================================
+ *  @def        ATOMIC_SIZE
+ *  @brief      Initial payload size of the pointer-free block.
+ * ========================================================================== */
+#define ATOMIC_SIZE    (size_t)(64U)
+
+/** ============================================================================
+ *  @def        TYPED_COUNT
+ *  @brief      Number of records in the typed array.
+ * ========================================================================== */
+#define TYPED_COUNT    (size_t)(4U)
+
+/** ============================================================================
+ *  @def        DEFAULT_RATIO
+ *  @brief      Default GC trigger ratio restored by TEST_gcCollect().
+ * ========================================================================== */
+#define DEFAULT_RATIO  (uint32_t)(100U)
+
+/** ============================================================================
+ *  @def        BLACKLIST_SIZE
+ *  @brief      Payload size of the blocks placed around the false pointer.
+ * ========================================================================== */
+#define BLACKLIST_SIZE (size_t)(512U)
+
+/** ============================================================================
+ *  @def        BLACKLIST_PAGE
+ *  @brief      Heap bytes the collector blacklists per false pointer.
+ * ========================================================================== */
+#define BLACKLIST_PAGE (uintptr_t)(4096U)
+
+/** ============================================================================
+ *  @def        CHECK(expr)
+ *  @brief      Assertion macro for validating test expressions.
+ *
+ *  @param [in] expr  Boolean expression to evaluate.
+ *
+ *  @details    Evaluates the given expression and, if false,
+ *              logs an error with file and line information,
+ *              then returns EXIT_ERROR from the current function.
+ *              Ensures immediate test termination on failure.
+ * ========================================================================== */
+#define CHECK(expr)                                                          \
+  do                                                                         \
+  {                                                                          \
+    if (!(expr))                                                             \
+    {                                                                        \
+      LOG_ERROR("Assertion failed at %s:%d: %s", __FILE__, __LINE__, #expr); \
+      return EXIT_ERROR;                                                     \
+    }                                                                        \
+  } while (0)
+
+#if defined(GARBAGE_COLLECTOR)
+
+/** ============================================================================
+ *                P R I V A T E  T Y P E S  D E F I N I T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @typedef    node_t
+ *  @brief      Singly linked list node reachable only through its head.
+ * ========================================================================== */
+typedef struct Node
+{
+  struct Node *next;  /**< Next node, or NULL */
+  uint32_t     value; /**< Position in the list */
+} node_t;
+
+/** ============================================================================
+ *  @typedef    record_t
+ *  @brief      Typed record with one pointer field among integer fields.
+ * ========================================================================== */
+typedef struct Record
+{
+  uint64_t  id;     /**< Integer field */
+  void     *child;  /**< Only pointer field of the layout */
+  uintptr_t cookie; /**< Integer field that may look like an address */
+} record_t;
+
+/** ============================================================================
+ *  @typedef    cell_t
+ *  @brief      Chain cell carrying one spare reference.
+ * ========================================================================== */
+typedef struct Cell
+{
+  struct Cell *next;         /**< Next cell, or NULL */
+  void *volatile ref;        /**< Reference moved by the mutator */
+} cell_t;
+
+/** ============================================================================
+ *              P R I V A T E  G L O B A L  V A R I A B L E S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @var        g_root
+ *  @brief      List head reachable only from the data segment.
+ * ========================================================================== */
+static node_t *volatile g_root = (node_t *)NULL;
+
+/** ============================================================================
+ *  @var        g_ready
+ *  @brief      Number of workers whose list is built.
+ * ========================================================================== */
+static _Atomic uint32_t g_ready = 0u;
+
+/** ============================================================================
+ *  @var        g_release
+ *  @brief      Set once collection is over and workers may check their list.
+ * ========================================================================== */
+static _Atomic bool g_release = false;
+
+/** ============================================================================
+ *  @var        g_holder
+ *  @brief      Block receiving a pointer in the middle of an incremental
+ *              cycle.
+ * ========================================================================== */
+static void **volatile g_holder = (void **)NULL;
+
+/** ============================================================================
+ *  @var        g_atomic
+ *  @brief      Pointer-free block whose payload the collector never scans.
+ * ========================================================================== */
+static void **volatile g_atomic = (void **)NULL;
+
+/** ============================================================================
+ *  @var        g_typed
+ *  @brief      Array of records allocated with a precise layout.
+ * ========================================================================== */
+static record_t *volatile g_typed = (record_t *)NULL;
+
+/** ============================================================================
+ *  @var        g_hidden
+ *  @brief      Address of the hidden block, XORed with HIDE_KEY.
+ * ========================================================================== */
+static volatile uintptr_t g_hidden = 0u;
+
+/** ============================================================================
+ *  @var        g_fresh
+ *  @brief      Nodes allocated while an incremental cycle is in progress.
+ * ========================================================================== */
+static node_t *volatile g_fresh = (node_t *)NULL;
+
+/** ============================================================================
+ *  @var        g_false
+ *  @brief      Address of a freed block, seen by the collector as a false
+ *              pointer.
+ * ========================================================================== */
+static volatile uintptr_t g_false = 0u;
+
+/** ============================================================================
+ *  @var        g_chain
+ *  @brief      Head of the chain mutated during GC thread cycles.
+ * ========================================================================== */
+static cell_t *volatile g_chain = (cell_t *)NULL;
+
+/** ============================================================================
+ *  @var        g_cycles_done
+ *  @brief      Set by TEST_collector() once its collections are over.
+ * ========================================================================== */
+static _Atomic bool g_cycles_done = false;
+
+/** ============================================================================
+ *          P R I V A T E  F U N C T I O N S  P R O T O T Y P E S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         TEST_gcLinkedList
+ *  @brief      Checks that every node of a list reachable from its head
+ *              survives collection.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcLinkedList(void);
+
+/** ============================================================================
+ *  @fn         TEST_gcGlobalRoot
+ *  @brief      Checks that a list reachable only from a global survives
+ *              collection.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcGlobalRoot(void);
+
+/** ============================================================================
+ *  @fn         TEST_gcThreads
+ *  @brief      Checks that lists held on registered threads' stacks survive
+ *              collection.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcThreads(void);
+
+/** ============================================================================
+ *  @fn         TEST_gcGarbage
+ *  @brief      Checks that unreachable blocks are reclaimed.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcGarbage(void);
+
+/** ============================================================================
+ *  @fn         TEST_gcInteriorPointer
+ *  @brief      Checks that blocks referenced only by interior pointers
+ *              survive the sweep.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcInteriorPointer(void);
+
+/** ============================================================================
+ *  @fn         TEST_gcParallel
+ *  @brief      Checks marking and sweeping with several GC workers.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcParallel(void);
+
+/** ============================================================================
+ *  @fn         TEST_gcIncremental
+ *  @brief      Checks incremental cycles run by MEM_gcStep() and by mutator
+ *              assists.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcIncremental(void);
+
+/** ============================================================================
+ *  @fn         TEST_gcConcurrent
+ *  @brief      Checks that a block whose only reference the mutator moves
+ *              into an already traced block survives GC thread cycles.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcConcurrent(void);
+
+/** ============================================================================
+ *  @fn         TEST_gcSnapshot
+ *  @brief      Checks collections marked by a fork()ed child.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcSnapshot(void);
+
+/** ============================================================================
+ *  @fn         TEST_gcGenerational
+ *  @brief      Checks minor collections and old-to-young pointers.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcGenerational(void);
+
+/** ============================================================================
+ *  @fn         TEST_gcGenChurn
+ *  @brief      Checks a list rebuilt from young nodes across full and minor
+ *              collections.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcGenChurn(void);
+
+/** ============================================================================
+ *  @fn         TEST_gcLazySweep
+ *  @brief      Checks that allocations sweep GC thread cycles.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcLazySweep(void);
+
+/** ============================================================================
+ *  @fn         TEST_gcAtomic
+ *  @brief      Checks that pointer-free blocks are kept but not scanned.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcAtomic(void);
+
+/** ============================================================================
+ *  @fn         TEST_gcTyped
+ *  @brief      Checks that typed blocks are scanned only at pointer fields.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcTyped(void);
+
+/** ============================================================================
+ *  @fn         TEST_gcCollect
+ *  @brief      Checks that explicit collections reclaim garbage at once.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcCollect(void);
+
+/** ============================================================================
+ *  @fn         TEST_gcBlacklist
+ *  @brief      Checks that blocks avoid pages hit by false pointers.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcBlacklist(void);
+
+/** ============================================================================
+ *  @fn         TEST_gcStats
+ *  @brief      Checks that collections record their cycle metrics.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcStats(void);
+
+/** ============================================================================
+ *  @fn         TEST_gcHandles
+ *  @brief      Checks that movable blocks, and what they reference, are
+ *              kept by the collector.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcHandles(void);
+
+/** ============================================================================
+ *  @fn         TEST_gcThreadExit
+ *  @brief      Checks that threads exiting while registered free their slot.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcThreadExit(void);
+
+/** ============================================================================
+ *  @fn         TEST_buildList
+ *  @brief      Allocates a list of NUM_NODES nodes valued 0..NUM_NODES-1.
+ *
+ *  @return     List head, or NULL on allocation failure.
+ * ========================================================================== */
+static node_t *TEST_buildList(void);
+
+/** ============================================================================
+ *  @fn         TEST_checkList
+ *  @brief      Verifies and frees a list built by TEST_buildList().
+ *
+ *  @param [in] head  List head.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_checkList(node_t *head);
+
+/** ============================================================================
+ *  @fn         TEST_worker
+ *  @brief      Registered thread keeping a list on its own stack.
+ *
+ *  @param [in] arg  Unused.
+ *
+ *  @return     EXIT_SUCCESS or EXIT_ERROR, cast to a pointer.
+ * ========================================================================== */
+static void *TEST_worker(void *arg);
+
+/** ============================================================================
+ *  @fn         TEST_exitWorker
+ *  @brief      Registers the thread and exits without unregistering.
+ *
+ *  @param [in] arg  Unused.
+ *
+ *  @return     MEM_gcRegisterThread() result, cast to a pointer.
+ * ========================================================================== */
+static void *TEST_exitWorker(void *arg);
+
+/** ============================================================================
+ *  @fn         TEST_collector
+ *  @brief      Requests CONC_CYCLES collections, then sets g_cycles_done.
+ *
+ *  @param [in] arg  Unused.
+ *
+ *  @return     EXIT_SUCCESS or the first MEM_gcCollect() error, cast to a
+ *              pointer.
+ * ========================================================================== */
+static void *TEST_collector(void *arg);
+
+/** ============================================================================
+ *  @fn         TEST_mutateChain
+ *  @brief      Runs GC thread collections while moving the only reference
+ *              to a hidden block between the first and last cells of
+ *              g_chain.
+ *
+ *  @param [in] tag   Accounting tag of the hidden block.
+ *  @param [in] kind  Kind the collections are expected to run as.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_mutateChain(const uint32_t tag, const mem_gc_kind_t kind);
+
+/** ============================================================================
+ *  @fn         TEST_makeGarbage
+ *  @brief      Allocates tagged blocks and drops every pointer to them.
+ *
+ *  @param [in] tag  Accounting tag of the blocks.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_makeGarbage(const uint32_t tag) __attribute__((noinline));
+
+/** ============================================================================
+ *  @fn         TEST_scrubStack
+ *  @brief      Clears a stack area so stale pointers do not act as roots.
+ * ========================================================================== */
+static void TEST_scrubStack(void) __attribute__((noinline));
+
+/** ============================================================================
+ *  @fn         TEST_makeInterior
+ *  @brief      Allocates a heap and an mmap tagged block and returns only
+ *              pointers INNER_OFFSET bytes into their payloads.
+ *
+ *  @param [in]  tag    Accounting tag of the blocks.
+ *  @param [out] small  Interior pointer into the heap block.
+ *  @param [out] large  Interior pointer into the mmap block.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_makeInterior(const uint32_t  tag,
+                             uint8_t **const small,
+                             uint8_t **const large) __attribute__((noinline));
+
+/** ============================================================================
+ *  @fn         TEST_makeHidden
+ *  @brief      Allocates a tagged block and keeps its address only in
+ *              g_hidden, masked with HIDE_KEY.
+ *
+ *  @param [in] tag  Accounting tag of the block.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_makeHidden(const uint32_t tag) __attribute__((noinline));
+
+#endif
+
+/** ============================================================================
+ *                          M A I N  F U N C T I O N
+ * ========================================================================== */
+
+int main(void)
+{
+  int ret = EXIT_SUCCESS;
+
+#if defined(GARBAGE_COLLECTOR)
+  ret = TEST_gcLinkedList( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_gcGlobalRoot( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_gcThreads( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_gcGarbage( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_gcInteriorPointer( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_gcParallel( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_gcIncremental( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_gcConcurrent( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_gcSnapshot( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_gcGenerational( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_gcGenChurn( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_gcLazySweep( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_gcAtomic( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_gcTyped( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_gcCollect( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_gcBlacklist( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_gcStats( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_gcHandles( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_gcThreadExit( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  LOG_INFO("Garbage collector test passed.\n");
+#else
+  LOG_INFO("Garbage collector disabled; test skipped.\n");
+#endif
+
+  return ret;
+}
+
+#if defined(GARBAGE_COLLECTOR)
+
+/** ============================================================================
+ *                  F U N C T I O N S  D E F I N I T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         TEST_gcLinkedList
+ *  @brief      Checks that every node of a list reachable from its head
+ *              survives collection.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcLinkedList(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  node_t *volatile head = (node_t *)NULL;
+
+  head = TEST_buildList( );
+  CHECK(head != NULL);
+
+  ret = MEM_enableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  usleep(GC_WAIT_US);
+
+  ret = MEM_disableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return TEST_checkList(head);
+}
+
+/** ============================================================================
+ *  @fn         TEST_gcGlobalRoot
+ *  @brief      Checks that a list reachable only from a global survives
+ *              collection.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcGlobalRoot(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  g_root = TEST_buildList( );
+  CHECK(g_root != NULL);
+
+  ret = MEM_enableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  usleep(GC_WAIT_US);
+
+  ret = MEM_disableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret    = TEST_checkList(g_root);
+  g_root = (node_t *)NULL;
+
+  return ret;
+}
+
+/** ============================================================================
+ *  @fn         TEST_gcThreads
+ *  @brief      Checks that lists held on registered threads' stacks survive
+ *              collection.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcThreads(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  pthread_t workers[NUM_WORKERS];
+
+  void *result = (void *)NULL;
+
+  uint8_t iterator = 0u;
+
+  for (iterator = 0u; iterator < NUM_WORKERS; ++iterator)
+  {
+    ret = pthread_create(&workers[iterator],
+                         (const pthread_attr_t *)NULL,
+                         TEST_worker,
+                         (void *)NULL);
+    CHECK(ret == EXIT_SUCCESS);
+  }
+
+  while (atomic_load(&g_ready) < NUM_WORKERS)
+    usleep(1000u);
+
+  ret = MEM_enableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  usleep(GC_WAIT_US);
+
+  ret = MEM_disableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  atomic_store(&g_release, true);
+
+  for (iterator = 0u; iterator < NUM_WORKERS; ++iterator)
+  {
+    ret = pthread_join(workers[iterator], &result);
+    CHECK(ret == EXIT_SUCCESS);
+    CHECK((intptr_t)result == EXIT_SUCCESS);
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_gcGarbage
+ *  @brief      Checks that unreachable blocks are reclaimed.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcGarbage(void)
+{
+  int tag = 0;
+  int ret = EXIT_SUCCESS;
+
+  mem_tag_stats_t stats = { 0 };
+
+  tag = MEM_registerTag("garbage");
+  CHECK(tag > (int)MEM_TAG_DEFAULT);
+
+  ret = TEST_makeGarbage((uint32_t)tag);
+  CHECK(ret == EXIT_SUCCESS);
+
+  TEST_scrubStack( );
+
+  ret = MEM_enableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  usleep(GC_WAIT_US);
+
+  ret = MEM_disableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_getTagStats((uint32_t)tag, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(stats.alloc_count == NUM_GARBAGE);
+  CHECK(stats.free_count >= NUM_GARBAGE / 2u);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_gcInteriorPointer
+ *  @brief      Checks that blocks referenced only by interior pointers
+ *              survive the sweep.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcInteriorPointer(void)
+{
+  int tag = 0;
+  int ret = EXIT_SUCCESS;
+
+  uint8_t *volatile small = (uint8_t *)NULL;
+  uint8_t *volatile large = (uint8_t *)NULL;
+
+  uint8_t *inner_small = (uint8_t *)NULL;
+  uint8_t *inner_large = (uint8_t *)NULL;
+
+  mem_tag_stats_t stats = { 0 };
+
+  tag = MEM_registerTag("interior");
+  CHECK(tag > (int)MEM_TAG_DEFAULT);
+
+  ret = TEST_makeInterior((uint32_t)tag, &inner_small, &inner_large);
+  CHECK(ret == EXIT_SUCCESS);
+
+  small = inner_small;
+  large = inner_large;
+
+  inner_small = (uint8_t *)NULL;
+  inner_large = (uint8_t *)NULL;
+
+  TEST_scrubStack( );
+
+  ret = MEM_enableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  usleep(GC_WAIT_US);
+
+  ret = MEM_disableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_getTagStats((uint32_t)tag, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(stats.alloc_count == 2u);
+  CHECK(stats.free_count == 0u);
+
+  CHECK(small[0] == 0xA5u && small[INNER_SIZE - INNER_OFFSET - 1u] == 0xA5u);
+  CHECK(large[0] == 0x5Au && large[INNER_LARGE - INNER_OFFSET - 1u] == 0x5Au);
+
+  ret = MEM_free(small - INNER_OFFSET);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_free(large - INNER_OFFSET);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_gcParallel
+ *  @brief      Checks marking and sweeping with several GC workers.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcParallel(void)
+{
+  int tag = 0;
+  int ret = EXIT_SUCCESS;
+
+  node_t *volatile lists[NUM_LISTS] = { NULL };
+
+  mem_tag_stats_t stats = { 0 };
+
+  uint8_t iterator = 0u;
+
+  ret = MEM_gcSetWorkers((mem_allocator_t *)NULL, 0u);
+  CHECK(ret == -EINVAL);
+
+  ret = MEM_gcSetWorkers((mem_allocator_t *)NULL, MEM_GC_MAX_WORKERS + 1u);
+  CHECK(ret == -EINVAL);
+
+  ret = MEM_gcSetWorkers((mem_allocator_t *)NULL, NUM_WORKERS);
+  CHECK(ret == EXIT_SUCCESS);
+
+  for (iterator = 0u; iterator < NUM_LISTS; ++iterator)
+  {
+    lists[iterator] = TEST_buildList( );
+    CHECK(lists[iterator] != NULL);
+  }
+
+  tag = MEM_registerTag("parallel");
+  CHECK(tag > (int)MEM_TAG_DEFAULT);
+
+  ret = TEST_makeGarbage((uint32_t)tag);
+  CHECK(ret == EXIT_SUCCESS);
+
+  TEST_scrubStack( );
+
+  ret = MEM_enableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  usleep(GC_WAIT_US);
+
+  ret = MEM_disableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  for (iterator = 0u; iterator < NUM_LISTS; ++iterator)
+  {
+    ret = TEST_checkList(lists[iterator]);
+    CHECK(ret == EXIT_SUCCESS);
+  }
+
+  ret = MEM_getTagStats((uint32_t)tag, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(stats.free_count >= NUM_GARBAGE / 2u);
+
+  ret = MEM_gcSetWorkers((mem_allocator_t *)NULL, 1u);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_gcIncremental
+ *  @brief      Checks incremental cycles run by MEM_gcStep() and by mutator
+ *              assists.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcIncremental(void)
+{
+  int hidden_tag  = 0;
+  int garbage_tag = 0;
+  int ret         = EXIT_SUCCESS;
+
+  uint8_t *hidden = (uint8_t *)NULL;
+  node_t  *node   = (node_t *)NULL;
+  void    *ptr    = (void *)NULL;
+
+  mem_tag_stats_t stats = { 0 };
+
+  uint32_t steps = 0u;
+
+  g_root = TEST_buildList( );
+  CHECK(g_root != NULL);
+
+  g_holder = (void **)MEM_allocFirstFit(sizeof(void *));
+  CHECK(g_holder != NULL);
+  *g_holder = NULL;
+
+  hidden_tag = MEM_registerTag("hidden");
+  CHECK(hidden_tag > (int)MEM_TAG_DEFAULT);
+
+  ret = TEST_makeHidden((uint32_t)hidden_tag);
+  CHECK(ret == EXIT_SUCCESS);
+
+  garbage_tag = MEM_registerTag("stepped");
+  CHECK(garbage_tag > (int)MEM_TAG_DEFAULT);
+
+  ret = TEST_makeGarbage((uint32_t)garbage_tag);
+  CHECK(ret == EXIT_SUCCESS);
+
+  TEST_scrubStack( );
+
+  ret = MEM_gcStep((mem_allocator_t *)NULL, 0u);
+  CHECK(ret == EXIT_SUCCESS);
+
+  *g_holder = (void *)(g_hidden ^ HIDE_KEY);
+  g_hidden  = 0u;
+
+  while (ret != MEM_GC_CYCLE_DONE)
+  {
+    CHECK(++steps < MAX_STEPS);
+
+    node = (node_t *)MEM_allocFirstFit(sizeof(node_t));
+    CHECK(node != NULL);
+    node->value = (g_fresh != NULL) ? g_fresh->value + 1u : 0u;
+    node->next  = g_fresh;
+    g_fresh     = node;
+
+    ret = MEM_gcStep((mem_allocator_t *)NULL, STEP_BUDGET_US);
+    CHECK(ret >= EXIT_SUCCESS);
+  }
+
+  ret = TEST_checkList(g_root);
+  CHECK(ret == EXIT_SUCCESS);
+  g_root = (node_t *)NULL;
+
+  ret = MEM_getTagStats((uint32_t)hidden_tag, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(stats.free_count == 0u);
+
+  hidden = (uint8_t *)*g_holder;
+  CHECK(hidden[0] == 0xC3u && hidden[HIDDEN_SIZE - 1u] == 0xC3u);
+
+  ret = MEM_getTagStats((uint32_t)garbage_tag, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(stats.free_count >= NUM_GARBAGE / 2u);
+
+  for (node = g_fresh; node != NULL; node = g_fresh)
+  {
+    CHECK(node->value == steps - 1u);
+    --steps;
+
+    g_fresh = node->next;
+    ret     = MEM_free((void *)node);
+    CHECK(ret == EXIT_SUCCESS);
+  }
+  CHECK(steps == 0u);
+
+  ret = MEM_free((void *)hidden);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_free((void *)g_holder);
+  CHECK(ret == EXIT_SUCCESS);
+  g_holder = (void **)NULL;
+
+  ret = MEM_gcSetAssist((mem_allocator_t *)NULL, ASSIST_US);
+  CHECK(ret == EXIT_SUCCESS);
+
+  garbage_tag = MEM_registerTag("assisted");
+  CHECK(garbage_tag > (int)MEM_TAG_DEFAULT);
+
+  ret = TEST_makeGarbage((uint32_t)garbage_tag);
+  CHECK(ret == EXIT_SUCCESS);
+
+  TEST_scrubStack( );
+
+  ret = MEM_gcStep((mem_allocator_t *)NULL, 0u);
+  CHECK(ret == EXIT_SUCCESS);
+
+  for (steps = 0u; steps < MAX_STEPS; ++steps)
+  {
+    ret = MEM_getTagStats((uint32_t)garbage_tag, &stats);
+    CHECK(ret == EXIT_SUCCESS);
+    if (stats.free_count >= NUM_GARBAGE / 2u)
+      break;
+
+    ptr = MEM_allocFirstFit(ASSIST_SIZE);
+    CHECK(ptr != NULL);
+
+    ret = MEM_free(ptr);
+    CHECK(ret == EXIT_SUCCESS);
+  }
+  CHECK(steps < MAX_STEPS);
+
+  ret = MEM_gcSetAssist((mem_allocator_t *)NULL, 0u);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_gcConcurrent
+ *  @brief      Checks that a block whose only reference the mutator moves
+ *              into an already traced block survives GC thread cycles.
+ *
+ *  @details    Runs the collections with soft-dirty tracking allowed, where
+ *              the kernel supports it, so they mark mostly concurrently and
+ *              remark the written pages, then with tracking forbidden, so
+ *              they fall back to stop-the-world cycles.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcConcurrent(void)
+{
+  int tag = 0;
+  int ret = EXIT_SUCCESS;
+
+  tag = MEM_registerTag("concurrent");
+  CHECK(tag > (int)MEM_TAG_DEFAULT);
+
+  ret = MEM_gcSetDirtyTracking((mem_allocator_t *)NULL, true);
+  if (ret == -ENOTSUP)
+  {
+    LOG_INFO("Soft-dirty tracking unavailable; concurrent path skipped.\n");
+  }
+  else
+  {
+    CHECK(ret == EXIT_SUCCESS);
+
+    ret = TEST_mutateChain((uint32_t)tag, MEM_GC_KIND_INCREMENTAL);
+    CHECK(ret == EXIT_SUCCESS);
+  }
+
+  ret = MEM_gcSetDirtyTracking((mem_allocator_t *)NULL, false);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_mutateChain((uint32_t)tag, MEM_GC_KIND_FULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_gcSetDirtyTracking((mem_allocator_t *)NULL, true);
+  CHECK(ret == EXIT_SUCCESS || ret == -ENOTSUP);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_gcSnapshot
+ *  @brief      Checks collections marked by a fork()ed child.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcSnapshot(void)
+{
+  int tag = 0;
+  int ret = EXIT_SUCCESS;
+
+  node_t *node = (node_t *)NULL;
+
+  mem_tag_stats_t stats = { 0 };
+
+  uint32_t polls = 0u;
+
+  ret = MEM_gcSetSnapshot((mem_allocator_t *)NULL, true);
+  CHECK(ret == EXIT_SUCCESS);
+
+  g_root = TEST_buildList( );
+  CHECK(g_root != NULL);
+
+  tag = MEM_registerTag("snapshot");
+  CHECK(tag > (int)MEM_TAG_DEFAULT);
+
+  ret = TEST_makeGarbage((uint32_t)tag);
+  CHECK(ret == EXIT_SUCCESS);
+
+  TEST_scrubStack( );
+
+  ret = MEM_enableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  for (polls = 0u; polls < SNAP_POLLS; ++polls)
+  {
+    node = (node_t *)MEM_allocFirstFit(sizeof(node_t));
+    CHECK(node != NULL);
+    node->value = polls;
+    node->next  = g_fresh;
+    g_fresh     = node;
+
+    ret = MEM_getTagStats((uint32_t)tag, &stats);
+    CHECK(ret == EXIT_SUCCESS);
+    if (stats.free_count >= NUM_GARBAGE / 2u)
+      break;
+
+    usleep(SNAP_POLL_US);
+  }
+
+  ret = MEM_disableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(polls < SNAP_POLLS);
+
+  ret = TEST_checkList(g_root);
+  CHECK(ret == EXIT_SUCCESS);
+  g_root = (node_t *)NULL;
+
+  for (node = g_fresh; node != NULL; node = g_fresh)
+  {
+    CHECK(node->value == polls);
+    --polls;
+
+    g_fresh = node->next;
+    ret     = MEM_free((void *)node);
+    CHECK(ret == EXIT_SUCCESS);
+  }
+
+  ret = MEM_gcSetSnapshot((mem_allocator_t *)NULL, false);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_gcGenerational
+ *  @brief      Checks minor collections and old-to-young pointers.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcGenerational(void)
+{
+  int young_tag   = 0;
+  int garbage_tag = 0;
+  int ret         = EXIT_SUCCESS;
+
+  uint8_t *young = (uint8_t *)NULL;
+
+  mem_tag_stats_t stats = { 0 };
+
+  uint32_t polls = 0u;
+
+  ret = MEM_gcSetGenerational((mem_allocator_t *)NULL, FULL_EVERY);
+  CHECK(ret == EXIT_SUCCESS);
+
+  g_root = TEST_buildList( );
+  CHECK(g_root != NULL);
+
+  g_holder = (void **)MEM_allocFirstFit(sizeof(void *));
+  CHECK(g_holder != NULL);
+  *g_holder = NULL;
+
+  young_tag = MEM_registerTag("young");
+  CHECK(young_tag > (int)MEM_TAG_DEFAULT);
+
+  garbage_tag = MEM_registerTag("generational");
+  CHECK(garbage_tag > (int)MEM_TAG_DEFAULT);
+
+  ret = MEM_enableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  usleep(GC_WAIT_US);
+
+  *g_holder = MEM_allocTagged(HIDDEN_SIZE, (uint32_t)young_tag);
+  CHECK(*g_holder != NULL);
+  memset(*g_holder, 0xC3, HIDDEN_SIZE);
+
+  ret = TEST_makeGarbage((uint32_t)garbage_tag);
+  CHECK(ret == EXIT_SUCCESS);
+
+  TEST_scrubStack( );
+
+  for (polls = 0u; polls < SNAP_POLLS; ++polls)
+  {
+    ret = MEM_getTagStats((uint32_t)garbage_tag, &stats);
+    CHECK(ret == EXIT_SUCCESS);
+    if (stats.free_count >= NUM_GARBAGE / 2u)
+      break;
+
+    usleep(SNAP_POLL_US);
+  }
+
+  usleep(GC_WAIT_US);
+
+  ret = MEM_disableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(polls < SNAP_POLLS);
+
+  ret = TEST_checkList(g_root);
+  CHECK(ret == EXIT_SUCCESS);
+  g_root = (node_t *)NULL;
+
+  ret = MEM_getTagStats((uint32_t)young_tag, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(stats.free_count == 0u);
+
+  young = (uint8_t *)*g_holder;
+  CHECK(young[0] == 0xC3u && young[HIDDEN_SIZE - 1u] == 0xC3u);
+
+  ret = MEM_free((void *)young);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_free((void *)g_holder);
+  CHECK(ret == EXIT_SUCCESS);
+  g_holder = (void **)NULL;
+
+  ret = MEM_gcSetGenerational((mem_allocator_t *)NULL, 0u);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_gcGenChurn
+ *  @brief      Checks a list rebuilt from young nodes across full and minor
+ *              collections.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcGenChurn(void)
+{
+  int tag = 0;
+  int ret = EXIT_SUCCESS;
+
+  node_t *node   = (node_t *)NULL;
+  node_t *victim = (node_t *)NULL;
+  node_t *fresh  = (node_t *)NULL;
+
+  void *garbage = (void *)NULL;
+
+  mem_gc_stats_t gc_stats = { 0 };
+
+  uint32_t round    = 0u;
+  uint32_t iterator = 0u;
+  uint32_t minors   = 0u;
+
+  ret = MEM_gcSetGenerational((mem_allocator_t *)NULL, 1u);
+  CHECK(ret == EXIT_SUCCESS);
+
+  g_root = TEST_buildList( );
+  CHECK(g_root != NULL);
+
+  tag = MEM_registerTag("churn");
+  CHECK(tag > (int)MEM_TAG_DEFAULT);
+
+  ret = MEM_enableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  for (round = 0u; round < CHURN_ROUNDS; ++round)
+  {
+    for (node = g_root; node->next != NULL; node = node->next)
+    {
+      if ((node->value + round) % CHURN_STRIDE != 0u)
+        continue;
+
+      victim = node->next;
+
+      fresh = (node_t *)MEM_allocFirstFit(sizeof(node_t));
+      CHECK(fresh != NULL);
+
+      fresh->value = victim->value;
+      fresh->next  = victim->next;
+      node->next   = fresh;
+
+      ret = MEM_free((void *)victim);
+      CHECK(ret == EXIT_SUCCESS);
+    }
+
+    for (iterator = 0u; iterator < NUM_GARBAGE; ++iterator)
+    {
+      garbage = MEM_allocTagged(GARBAGE_SIZE + (iterator % 8u) * 16u,
+                                (uint32_t)tag);
+      CHECK(garbage != NULL);
+
+      memset(garbage, 0, GARBAGE_SIZE);
+    }
+
+    garbage = NULL;
+    TEST_scrubStack( );
+
+    usleep(CHURN_US);
+  }
+
+  ret = MEM_disableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_getGcStats((mem_allocator_t *)NULL, &gc_stats);
+  CHECK(ret == EXIT_SUCCESS);
+
+  for (iterator = 0u; iterator < gc_stats.count; ++iterator)
+  {
+    if (gc_stats.recent[iterator].kind == MEM_GC_KIND_MINOR)
+      ++minors;
+  }
+  CHECK(minors != 0u);
+
+  ret = TEST_checkList(g_root);
+  CHECK(ret == EXIT_SUCCESS);
+  g_root = (node_t *)NULL;
+
+  ret = MEM_gcSetGenerational((mem_allocator_t *)NULL, 0u);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_gcLazySweep
+ *  @brief      Checks that allocations sweep GC thread cycles.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcLazySweep(void)
+{
+  int tag = 0;
+  int ret = EXIT_SUCCESS;
+
+  node_t *node = (node_t *)NULL;
+
+  mem_tag_stats_t stats = { 0 };
+
+  uint32_t polls = 0u;
+
+  ret = MEM_gcSetLazySweep((mem_allocator_t *)NULL, true);
+  CHECK(ret == EXIT_SUCCESS);
+
+  g_root = TEST_buildList( );
+  CHECK(g_root != NULL);
+
+  tag = MEM_registerTag("lazy");
+  CHECK(tag > (int)MEM_TAG_DEFAULT);
+
+  ret = TEST_makeGarbage((uint32_t)tag);
+  CHECK(ret == EXIT_SUCCESS);
+
+  TEST_scrubStack( );
+
+  ret = MEM_enableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  for (polls = 0u; polls < SNAP_POLLS; ++polls)
+  {
+    node = (node_t *)MEM_allocFirstFit(sizeof(node_t));
+    CHECK(node != NULL);
+    node->value = polls;
+    node->next  = g_fresh;
+    g_fresh     = node;
+
+    ret = MEM_getTagStats((uint32_t)tag, &stats);
+    CHECK(ret == EXIT_SUCCESS);
+    if (stats.free_count >= NUM_GARBAGE / 2u)
+      break;
+
+    usleep(SNAP_POLL_US);
+  }
+
+  ret = MEM_disableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(polls < SNAP_POLLS);
+
+  ret = TEST_checkList(g_root);
+  CHECK(ret == EXIT_SUCCESS);
+  g_root = (node_t *)NULL;
+
+  for (node = g_fresh; node != NULL; node = g_fresh)
+  {
+    CHECK(node->value == polls);
+    --polls;
+
+    g_fresh = node->next;
+    ret     = MEM_free((void *)node);
+    CHECK(ret == EXIT_SUCCESS);
+  }
+
+  ret = MEM_gcSetLazySweep((mem_allocator_t *)NULL, false);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_gcAtomic
+ *  @brief      Checks that pointer-free blocks are kept but not scanned.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcAtomic(void)
+{
+  int tag = 0;
+  int ret = EXIT_SUCCESS;
+
+  mem_tag_stats_t stats = { 0 };
+
+  uint32_t steps = 0u;
+
+  g_atomic = (void **)MEM_allocAtomic(ATOMIC_SIZE);
+  CHECK(g_atomic != NULL);
+
+  g_atomic = (void **)MEM_realloc((void *)g_atomic,
+                                  4u * ATOMIC_SIZE,
+                                  FIRST_FIT);
+  CHECK(g_atomic != NULL);
+
+  tag = MEM_registerTag("unscanned");
+  CHECK(tag > (int)MEM_TAG_DEFAULT);
+
+  ret = TEST_makeHidden((uint32_t)tag);
+  CHECK(ret == EXIT_SUCCESS);
+
+  g_atomic[0] = (void *)(g_hidden ^ HIDE_KEY);
+  g_hidden    = 0u;
+
+  TEST_scrubStack( );
+
+  do
+  {
+    CHECK(++steps < MAX_STEPS);
+
+    ret = MEM_gcStep((mem_allocator_t *)NULL, STEP_BUDGET_US);
+    CHECK(ret >= EXIT_SUCCESS);
+  } while (ret != MEM_GC_CYCLE_DONE);
+
+  ret = MEM_getTagStats((uint32_t)tag, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(stats.free_count == 1u);
+
+  ret = MEM_free((void *)g_atomic);
+  CHECK(ret == EXIT_SUCCESS);
+  g_atomic = (void **)NULL;
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_gcTyped
+ *  @brief      Checks that typed blocks are scanned only at pointer fields.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcTyped(void)
+{
+  int kept_tag = 0;
+  int fake_tag = 0;
+  int layout   = 0;
+  int again    = 0;
+  int ret      = EXIT_SUCCESS;
+
+  mem_tag_stats_t stats = { 0 };
+
+  uint64_t bitmap = 0u;
+  uint32_t steps  = 0u;
+
+  bitmap = (uint64_t)1u << (offsetof(record_t, child) / sizeof(uintptr_t));
+
+  layout = MEM_registerLayout(&bitmap, sizeof(record_t) / sizeof(uintptr_t));
+  CHECK(layout >= (int)MEM_LAYOUT_FIRST);
+
+  again = MEM_registerLayout(&bitmap, sizeof(record_t) / sizeof(uintptr_t));
+  CHECK(again == layout);
+
+  ret = MEM_registerLayout(&bitmap, 0u);
+  CHECK(ret == -EINVAL);
+
+  g_typed = (record_t *)MEM_allocTyped(TYPED_COUNT * sizeof(record_t),
+                                       (uint32_t)layout);
+  CHECK(g_typed != NULL);
+  MEM_memset((void *)g_typed, 0, TYPED_COUNT * sizeof(record_t));
+
+  kept_tag = MEM_registerTag("typed-kept");
+  CHECK(kept_tag > (int)MEM_TAG_DEFAULT);
+
+  fake_tag = MEM_registerTag("typed-fake");
+  CHECK(fake_tag > (int)MEM_TAG_DEFAULT);
+
+  ret = TEST_makeHidden((uint32_t)kept_tag);
+  CHECK(ret == EXIT_SUCCESS);
+  g_typed[TYPED_COUNT - 1u].child = (void *)(g_hidden ^ HIDE_KEY);
+
+  ret = TEST_makeHidden((uint32_t)fake_tag);
+  CHECK(ret == EXIT_SUCCESS);
+  g_typed[TYPED_COUNT - 1u].cookie = g_hidden ^ HIDE_KEY;
+  g_hidden                         = 0u;
+
+  TEST_scrubStack( );
+
+  do
+  {
+    CHECK(++steps < MAX_STEPS);
+
+    ret = MEM_gcStep((mem_allocator_t *)NULL, STEP_BUDGET_US);
+    CHECK(ret >= EXIT_SUCCESS);
+  } while (ret != MEM_GC_CYCLE_DONE);
+
+  ret = MEM_getTagStats((uint32_t)fake_tag, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(stats.free_count == 1u);
+
+  ret = MEM_getTagStats((uint32_t)kept_tag, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(stats.free_count == 0u);
+
+  ret = MEM_free(g_typed[TYPED_COUNT - 1u].child);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_free((void *)g_typed);
+  CHECK(ret == EXIT_SUCCESS);
+  g_typed = (record_t *)NULL;
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_gcCollect
+ *  @brief      Checks that explicit collections reclaim garbage at once.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcCollect(void)
+{
+  int tag = 0;
+  int ret = EXIT_SUCCESS;
+
+  mem_tag_stats_t stats = { 0 };
+
+  uint64_t freed = 0u;
+
+  tag = MEM_registerTag("collect");
+  CHECK(tag > (int)MEM_TAG_DEFAULT);
+
+  ret = MEM_gcSetRatio((mem_allocator_t *)NULL, 0u);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_enableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  usleep(GC_WAIT_US);
+
+  ret = TEST_makeGarbage((uint32_t)tag);
+  CHECK(ret == EXIT_SUCCESS);
+
+  TEST_scrubStack( );
+
+  ret = MEM_gcCollect((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_getTagStats((uint32_t)tag, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(stats.free_count >= NUM_GARBAGE / 2u);
+
+  ret = MEM_disableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_getTagStats((uint32_t)tag, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+  freed = stats.free_count;
+
+  ret = TEST_makeGarbage((uint32_t)tag);
+  CHECK(ret == EXIT_SUCCESS);
+
+  TEST_scrubStack( );
+
+  ret = MEM_gcCollect((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_getTagStats((uint32_t)tag, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(stats.free_count >= freed + NUM_GARBAGE / 2u);
+
+  ret = MEM_gcSetRatio((mem_allocator_t *)NULL, DEFAULT_RATIO);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_gcBlacklist
+ *  @brief      Checks that blocks avoid pages hit by false pointers.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcBlacklist(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  uint8_t *victim = (uint8_t *)NULL;
+  uint8_t *guard  = (uint8_t *)NULL;
+  uint8_t *fresh  = (uint8_t *)NULL;
+
+  uintptr_t page = 0u;
+
+  victim = (uint8_t *)MEM_allocFirstFit(BLACKLIST_SIZE);
+  CHECK(victim != NULL);
+
+  guard = (uint8_t *)MEM_allocFirstFit(BLACKLIST_SIZE);
+  CHECK(guard != NULL);
+
+  ret = MEM_free(victim);
+  CHECK(ret == EXIT_SUCCESS);
+
+  g_false = (uintptr_t)victim;
+  page    = g_false / BLACKLIST_PAGE;
+
+  ret = MEM_gcCollect((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  fresh = (uint8_t *)MEM_allocFirstFit(BLACKLIST_SIZE);
+  CHECK(fresh != NULL);
+  CHECK((uintptr_t)fresh / BLACKLIST_PAGE != page);
+  CHECK(((uintptr_t)fresh + BLACKLIST_SIZE - 1u) / BLACKLIST_PAGE != page);
+
+  g_false = 0u;
+
+  ret = MEM_free(fresh);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_free(guard);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_gcStats
+ *  @brief      Checks that collections record their cycle metrics.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcStats(void)
+{
+  int tag = 0;
+  int ret = EXIT_SUCCESS;
+
+  static mem_gc_stats_t before = { 0 };
+  static mem_gc_stats_t after  = { 0 };
+
+  const mem_gc_cycle_t *last = (const mem_gc_cycle_t *)NULL;
+
+  tag = MEM_registerTag("stats");
+  CHECK(tag > (int)MEM_TAG_DEFAULT);
+
+  ret = MEM_getGcStats((mem_allocator_t *)NULL, (mem_gc_stats_t *)NULL);
+  CHECK(ret == -EINVAL);
+
+  ret = MEM_getGcStats((mem_allocator_t *)NULL, &before);
+  CHECK(ret == EXIT_SUCCESS);
+
+  g_root = TEST_buildList( );
+  CHECK(g_root != NULL);
+
+  ret = TEST_makeGarbage((uint32_t)tag);
+  CHECK(ret == EXIT_SUCCESS);
+
+  TEST_scrubStack( );
+
+  ret = MEM_gcCollect((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_getGcStats((mem_allocator_t *)NULL, &after);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(after.cycles > before.cycles);
+  CHECK(after.count >= 1u);
+  CHECK(after.gc_ns > before.gc_ns);
+
+  last = &after.recent[after.count - 1u];
+  CHECK(last->seq == after.cycles);
+  CHECK(last->bytes_scanned > 0u);
+  CHECK(last->blocks_marked >= NUM_NODES);
+  CHECK(last->blocks_freed >= NUM_GARBAGE / 2u);
+  CHECK(last->mark_ns > 0u);
+  CHECK(last->pause_ns > 0u);
+  CHECK(last->heap_before > 0u);
+
+  ret    = TEST_checkList(g_root);
+  g_root = (node_t *)NULL;
+
+  return ret;
+}
+
+/** ============================================================================
+ *  @fn         TEST_gcHandles
+ *  @brief      Checks that movable blocks, and what they reference, are
+ *              kept by the collector.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcHandles(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  mem_handle_t handle = 0;
+
+  node_t **slot = (node_t **)NULL;
+
+  handle = MEM_hAlloc(sizeof(node_t *));
+  CHECK(handle > 0);
+
+  slot = (node_t **)MEM_hLock(handle);
+  CHECK(slot != NULL && (intptr_t)slot > 0);
+
+  *slot = TEST_buildList( );
+  CHECK(*slot != NULL);
+
+  ret = MEM_hUnlock(handle);
+  CHECK(ret == EXIT_SUCCESS);
+
+  slot = (node_t **)NULL;
+  TEST_scrubStack( );
+
+  ret = MEM_gcCollect((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  CHECK(MEM_compact( ) >= 0);
+
+  slot = (node_t **)MEM_hLock(handle);
+  CHECK(slot != NULL && (intptr_t)slot > 0);
+
+  ret = TEST_checkList(*slot);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_hUnlock(handle);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_hFree(handle);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_gcThreadExit
+ *  @brief      Checks that threads exiting while registered free their slot.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_gcThreadExit(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  pthread_t thread;
+
+  void *result = (void *)NULL;
+
+  uint32_t iterator = 0u;
+
+  for (iterator = 0u; iterator < 2u * MEM_GC_MAX_THREADS; ++iterator)
+  {
+    ret = pthread_create(&thread,
+                         (const pthread_attr_t *)NULL,
+                         TEST_exitWorker,
+                         (void *)NULL);
+    CHECK(ret == EXIT_SUCCESS);
+
+    ret = pthread_join(thread, &result);
+    CHECK(ret == EXIT_SUCCESS);
+    CHECK((intptr_t)result == EXIT_SUCCESS);
+  }
+
+  ret = MEM_gcCollect((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_buildList
+ *  @brief      Allocates a list of NUM_NODES nodes valued 0..NUM_NODES-1.
+ *
+ *  @return     List head, or NULL on allocation failure.
+ * ========================================================================== */
+static node_t *TEST_buildList(void)
+{
+  node_t *head = (node_t *)NULL;
+  node_t *node = (node_t *)NULL;
+
+  uint32_t iterator = 0u;
+
+  for (iterator = 0u; iterator < NUM_NODES; ++iterator)
+  {
+    node = (node_t *)MEM_allocFirstFit(sizeof(node_t));
+    if (node == NULL)
+      return (node_t *)NULL;
+
+    node->value = NUM_NODES - 1u - iterator;
+    node->next  = head;
+    head        = node;
+  }
+
+  return head;
+}
+
+/** ============================================================================
+ *  @fn         TEST_checkList
+ *  @brief      Verifies and frees a list built by TEST_buildList().
+ *
+ *  @param [in] head  List head.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_checkList(node_t *head)
+{
+  int ret = EXIT_SUCCESS;
+
+  node_t *node = (node_t *)NULL;
+  node_t *next = (node_t *)NULL;
+
+  uint32_t iterator = 0u;
+
+  for (node = head; node != NULL; node = node->next)
+  {
+    CHECK(node->value == iterator);
+    ++iterator;
+  }
+  CHECK(iterator == NUM_NODES);
+
+  for (node = head; node != NULL; node = next)
+  {
+    next = node->next;
+
+    ret = MEM_free((void *)node);
+    CHECK(ret == EXIT_SUCCESS);
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_worker
+ *  @brief      Registered thread keeping a list on its own stack.
+ *
+ *  @param [in] arg  Unused.
+ *
+ *  @return     EXIT_SUCCESS or EXIT_ERROR, cast to a pointer.
+ * ========================================================================== */
+static void *TEST_worker(void *arg)
+{
+  int ret = EXIT_SUCCESS;
+
+  node_t *volatile head = (node_t *)NULL;
+
+  (void)arg;
+
+  ret = MEM_gcRegisterThread((mem_allocator_t *)NULL);
+  if (ret == EXIT_SUCCESS)
+    head = TEST_buildList( );
+
+  atomic_fetch_add(&g_ready, 1u);
+
+  while (!atomic_load(&g_release))
+    usleep(1000u);
+
+  if (ret != EXIT_SUCCESS || head == NULL)
+    return (void *)(intptr_t)EXIT_ERROR;
+
+  ret = TEST_checkList(head);
+  if (ret == EXIT_SUCCESS)
+    ret = MEM_gcUnregisterThread((mem_allocator_t *)NULL);
+
+  return (void *)(intptr_t)ret;
+}
+
+/** ============================================================================
+ *  @fn         TEST_exitWorker
+ *  @brief      Registers the thread and exits without unregistering.
+ *
+ *  @param [in] arg  Unused.
+ *
+ *  @return     MEM_gcRegisterThread() result, cast to a pointer.
+ * ========================================================================== */
+static void *TEST_exitWorker(void *arg)
+{
+  (void)arg;
+
+  return (void *)(intptr_t)MEM_gcRegisterThread((mem_allocator_t *)NULL);
+}
+
+/** ============================================================================
+ *  @fn         TEST_collector
+ *  @brief      Requests CONC_CYCLES collections, then sets g_cycles_done.
+ *
+ *  @param [in] arg  Unused.
+ *
+ *  @return     EXIT_SUCCESS or the first MEM_gcCollect() error, cast to a
+ *              pointer.
+ * ========================================================================== */
+static void *TEST_collector(void *arg)
+{
+  int ret = EXIT_SUCCESS;
+
+  uint32_t cycle = 0u;
+
+  (void)arg;
+
+  for (cycle = 0u; cycle < CONC_CYCLES && ret == EXIT_SUCCESS; ++cycle)
+    ret = MEM_gcCollect((mem_allocator_t *)NULL);
+
+  atomic_store(&g_cycles_done, true);
+
+  return (void *)(intptr_t)ret;
+}
+
+/** ============================================================================
+ *  @fn         TEST_mutateChain
+ *  @brief      Runs GC thread collections while moving the only reference
+ *              to a hidden block between the first and last cells of
+ *              g_chain.
+ *
+ *  @details    The chain is traced from its head, so the head is scanned
+ *              long before the tail. Moving the reference from the tail
+ *              to the head after the head was scanned hides the block
+ *              from the trace; only the remark can find it again. The
+ *              reference only ever passes through a register.
+ *
+ *  @param [in] tag   Accounting tag of the hidden block.
+ *  @param [in] kind  Kind the collections are expected to run as.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_mutateChain(const uint32_t tag, const mem_gc_kind_t kind)
+{
+  int ret = EXIT_SUCCESS;
+
+  pthread_t collector;
+
+  cell_t *cell = (cell_t *)NULL;
+  cell_t *tail = (cell_t *)NULL;
+
+  uint8_t *hidden = (uint8_t *)NULL;
+  void    *result = (void *)NULL;
+
+  mem_tag_stats_t before = { 0 };
+  mem_tag_stats_t after  = { 0 };
+  mem_gc_stats_t  stats  = { 0 };
+
+  uint32_t iterator = 0u;
+  uint64_t moves    = 0u;
+
+  for (iterator = 0u; iterator < CONC_CELLS; ++iterator)
+  {
+    cell = (cell_t *)MEM_allocFirstFit(sizeof(cell_t));
+    CHECK(cell != NULL);
+
+    cell->next = (cell_t *)NULL;
+    cell->ref  = NULL;
+
+    if (tail != NULL)
+      tail->next = cell;
+    else
+      g_chain = cell;
+    tail = cell;
+  }
+
+  ret = TEST_makeHidden(tag);
+  CHECK(ret == EXIT_SUCCESS);
+
+  tail->ref = (void *)(g_hidden ^ HIDE_KEY);
+  g_hidden  = 0u;
+
+  TEST_scrubStack( );
+
+  ret = MEM_getTagStats(tag, &before);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_enableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  atomic_store(&g_cycles_done, false);
+  CHECK(pthread_create(&collector, NULL, TEST_collector, NULL) == 0);
+
+  while (!atomic_load(&g_cycles_done))
+  {
+    if (tail->ref != NULL)
+    {
+      g_chain->ref = tail->ref;
+      tail->ref    = NULL;
+    }
+    else
+    {
+      tail->ref    = g_chain->ref;
+      g_chain->ref = NULL;
+    }
+    ++moves;
+  }
+
+  CHECK(pthread_join(collector, &result) == 0);
+  CHECK((intptr_t)result == EXIT_SUCCESS);
+
+  ret = MEM_disableGc((mem_allocator_t *)NULL);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_getGcStats((mem_allocator_t *)NULL, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(stats.count != 0u);
+  CHECK(stats.recent[stats.count - 1u].kind == kind);
+
+  ret = MEM_getTagStats(tag, &after);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(after.free_count == before.free_count);
+
+  hidden = (uint8_t *)((tail->ref != NULL) ? tail->ref : g_chain->ref);
+  CHECK(hidden != NULL);
+  CHECK(hidden[0] == 0xC3u && hidden[HIDDEN_SIZE - 1u] == 0xC3u);
+
+  LOG_INFO("Concurrent chain: %llu moves over %u cycles.\n",
+           (unsigned long long)moves,
+           (unsigned)CONC_CYCLES);
+
+  ret = MEM_free((void *)hidden);
+  CHECK(ret == EXIT_SUCCESS);
+
+  for (cell = g_chain; cell != NULL; cell = g_chain)
+  {
+    g_chain = cell->next;
+    ret     = MEM_free((void *)cell);
+    CHECK(ret == EXIT_SUCCESS);
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_makeGarbage
+ *  @brief      Allocates tagged blocks and drops every pointer to them.
+ *
+ *  @param [in] tag  Accounting tag of the blocks.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_makeGarbage(const uint32_t tag)
+{
+  void *ptr = (void *)NULL;
+
+  uint8_t iterator = 0u;
+
+  for (iterator = 0u; iterator < NUM_GARBAGE; ++iterator)
+  {
+    ptr = MEM_allocTagged(GARBAGE_SIZE, tag);
+    CHECK(ptr != NULL);
+
+    memset(ptr, 0, GARBAGE_SIZE);
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_scrubStack
+ *  @brief      Clears a stack area so stale pointers do not act as roots.
+ * ========================================================================== */
+static void TEST_scrubStack(void)
+{
+  uint8_t scratch[SCRUB_SIZE];
+
+  (void)MEM_memset(scratch, 0, SCRUB_SIZE);
+}
+
+/** ============================================================================
+ *  @fn         TEST_makeInterior
+ *  @brief      Allocates a heap and an mmap tagged block and returns only
+ *              pointers INNER_OFFSET bytes into their payloads.
+ *
+ *  @param [in]  tag    Accounting tag of the blocks.
+ *  @param [out] small  Interior pointer into the heap block.
+ *  @param [out] large  Interior pointer into the mmap block.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_makeInterior(const uint32_t  tag,
+                             uint8_t **const small,
+                             uint8_t **const large)
+{
+  uint8_t *block = (uint8_t *)NULL;
+
+  block = MEM_allocTagged(INNER_SIZE, tag);
+  CHECK(block != NULL);
+  MEM_memset(block, 0xA5, INNER_SIZE);
+  *small = block + INNER_OFFSET;
+
+  block = MEM_allocTagged(INNER_LARGE, tag);
+  CHECK(block != NULL);
+  MEM_memset(block, 0x5A, INNER_LARGE);
+  *large = block + INNER_OFFSET;
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_makeHidden
+ *  @brief      Allocates a tagged block and keeps its address only in
+ *              g_hidden, masked with HIDE_KEY.
+ *
+ *  @param [in] tag  Accounting tag of the block.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_makeHidden(const uint32_t tag)
+{
+  uint8_t *block = (uint8_t *)NULL;
+
+  block = MEM_allocTagged(HIDDEN_SIZE, tag);
+  CHECK(block != NULL);
+  MEM_memset(block, 0xC3, HIDDEN_SIZE);
+
+  g_hidden = (uintptr_t)block ^ HIDE_KEY;
+
+  return EXIT_SUCCESS;
+}
+
+#endif
+
+/*< end of file >*/
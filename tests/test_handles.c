@@ -0,0 +1,328 @@
+/*
+ * SPDX-FileCopyrightText: 2024-2025 Rafael V. Volkmer
+ * SPDX-FileCopyrightText: <rafael.v.volkmer@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+/** ============================================================================
+ *  @ingroup    Libmemalloc
+ *
+ *  @brief      Movable allocation and compaction test.
+ *
+ *  @file       test_handles.c
+ *  @headerfile libmemalloc.h
+ *
+ *  @details    Fragments the heap with handle-based blocks, checks that
+ *              MEM_compact() slides the unlocked ones down with their
+ *              contents and releases the top of the heap, that locked
+ *              blocks stay in place, and that invalid handles, unbalanced
+ *              unlocks and frees of locked handles are refused.
+ *
+ *  @version    v1.0.00
+ *  @date       18.10.2026
+ *  @author     Rafael V. Volkmer <rafael.v.volkmer@gmail.com>
+ * ========================================================================== */
+
+/** ============================================================================
+ *                      P R I V A T E  I N C L U D E S
+ * ========================================================================== */
+
+/*< Implemented >*/
+#include "libmemalloc.h"
+#include "logs.h"
+
+/*< Dependencies >*/
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** ============================================================================
+ *               P R I V A T E  D E F I N E S  &  M A C R O S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @def        EXIT_ERROR
+ *  @brief      Standard error return code for test failures.
+ *
+ *  @details    Defined as a uint8_t value of 1 to indicate any
+ *              assertion or test step failure within the test suite.
+ *              Returned by test functions when a CHECK() fails.
+ * ========================================================================== */
+#define EXIT_ERROR  (uint8_t)(1U)
+
+/** ============================================================================
+ *  @def        NUM_HANDLES
+ *  @brief      Movable blocks allocated by the compaction test.
+ * ========================================================================== */
+#define NUM_HANDLES (size_t)(64U)
+
+/** ============================================================================
+ *  @def        HANDLE_SIZE
+ *  @brief      Payload size of each movable block.
+ * ========================================================================== */
+#define HANDLE_SIZE (size_t)(2U * 1024U)
+
+/** ============================================================================
+ *  @def        CHECK(expr)
+ *  @brief      Assertion macro for validating test expressions.
+ *
+ *  @param [in] expr  Boolean expression to evaluate.
+ *
+ *  @details    Evaluates the given expression and, if false,
+ *              logs an error with file and line information,
+ *              then returns EXIT_ERROR from the current function.
+ *              Ensures immediate test termination on failure.
+ * ========================================================================== */
+#define CHECK(expr)                                                          \
+  do                                                                         \
+  {                                                                          \
+    if (!(expr))                                                             \
+    {                                                                        \
+      LOG_ERROR("Assertion failed at %s:%d: %s", __FILE__, __LINE__, #expr); \
+      return EXIT_ERROR;                                                     \
+    }                                                                        \
+  } while (0)
+
+/** ============================================================================
+ *          P R I V A T E  F U N C T I O N S  P R O T O T Y P E S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         TEST_compact
+ *  @brief      Checks that MEM_compact() moves unlocked blocks down, keeps
+ *              their contents and releases the freed heap top.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_compact(void);
+
+/** ============================================================================
+ *  @fn         TEST_pinned
+ *  @brief      Checks that a locked block is not moved and that locks nest.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_pinned(void);
+
+/** ============================================================================
+ *  @fn         TEST_handleInvalid
+ *  @brief      Checks rejection of bad sizes, stale handles, unbalanced
+ *              unlocks and frees of locked handles.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_handleInvalid(void);
+
+/** ============================================================================
+ *                          M A I N  F U N C T I O N
+ * ========================================================================== */
+
+int main(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  ret = TEST_compact( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_pinned( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_handleInvalid( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  LOG_INFO("Handles test passed.\n");
+  return ret;
+}
+
+/** ============================================================================
+ *                  F U N C T I O N S  D E F I N I T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         TEST_compact
+ *  @brief      Checks that MEM_compact() moves unlocked blocks down, keeps
+ *              their contents and releases the freed heap top.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_compact(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  static mem_handle_t handles[NUM_HANDLES] = { 0 };
+
+  uint8_t *last_before = (uint8_t *)NULL;
+  uint8_t *last_after  = (uint8_t *)NULL;
+  uint8_t *data        = (uint8_t *)NULL;
+
+  intptr_t released = 0;
+
+  size_t iterator = 0u;
+  size_t offset   = 0u;
+
+  for (iterator = 0u; iterator < NUM_HANDLES; ++iterator)
+  {
+    handles[iterator] = MEM_hAlloc(HANDLE_SIZE);
+    CHECK(handles[iterator] > 0);
+
+    data = (uint8_t *)MEM_hLock(handles[iterator]);
+    CHECK(data != NULL && (intptr_t)data > 0);
+
+    MEM_memset(data, (int)(iterator & 0xFFu), HANDLE_SIZE);
+
+    ret = MEM_hUnlock(handles[iterator]);
+    CHECK(ret == EXIT_SUCCESS);
+  }
+
+  last_before = (uint8_t *)MEM_hLock(handles[NUM_HANDLES - 1u]);
+  CHECK(last_before != NULL && (intptr_t)last_before > 0);
+
+  ret = MEM_hUnlock(handles[NUM_HANDLES - 1u]);
+  CHECK(ret == EXIT_SUCCESS);
+
+  for (iterator = 0u; iterator < NUM_HANDLES; iterator += 2u)
+  {
+    ret = MEM_hFree(handles[iterator]);
+    CHECK(ret == EXIT_SUCCESS);
+
+    handles[iterator] = 0;
+  }
+
+  released = MEM_compact( );
+  CHECK(released >= (intptr_t)(NUM_HANDLES / 4u * HANDLE_SIZE));
+
+  last_after = (uint8_t *)MEM_hLock(handles[NUM_HANDLES - 1u]);
+  CHECK(last_after != NULL && (intptr_t)last_after > 0);
+  CHECK(last_after < last_before);
+
+  ret = MEM_hUnlock(handles[NUM_HANDLES - 1u]);
+  CHECK(ret == EXIT_SUCCESS);
+
+  for (iterator = 1u; iterator < NUM_HANDLES; iterator += 2u)
+  {
+    data = (uint8_t *)MEM_hLock(handles[iterator]);
+    CHECK(data != NULL && (intptr_t)data > 0);
+
+    for (offset = 0u; offset < HANDLE_SIZE; offset += 64u)
+      CHECK(data[offset] == (uint8_t)(iterator & 0xFFu));
+    CHECK(data[HANDLE_SIZE - 1u] == (uint8_t)(iterator & 0xFFu));
+
+    ret = MEM_hUnlock(handles[iterator]);
+    CHECK(ret == EXIT_SUCCESS);
+
+    ret = MEM_hFree(handles[iterator]);
+    CHECK(ret == EXIT_SUCCESS);
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_pinned
+ *  @brief      Checks that a locked block is not moved and that locks nest.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_pinned(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  mem_handle_t hole   = 0;
+  mem_handle_t pinned = 0;
+  mem_handle_t tail   = 0;
+
+  uint8_t *first  = (uint8_t *)NULL;
+  uint8_t *second = (uint8_t *)NULL;
+
+  hole = MEM_hAlloc(HANDLE_SIZE);
+  CHECK(hole > 0);
+
+  pinned = MEM_hAlloc(HANDLE_SIZE);
+  CHECK(pinned > 0);
+
+  tail = MEM_hAlloc(HANDLE_SIZE);
+  CHECK(tail > 0);
+
+  first = (uint8_t *)MEM_hLock(pinned);
+  CHECK(first != NULL && (intptr_t)first > 0);
+
+  MEM_memset(first, 0x3C, HANDLE_SIZE);
+
+  ret = MEM_hFree(hole);
+  CHECK(ret == EXIT_SUCCESS);
+
+  CHECK(MEM_compact( ) >= 0);
+
+  second = (uint8_t *)MEM_hLock(pinned);
+  CHECK(second == first);
+  CHECK(second[HANDLE_SIZE - 1u] == 0x3C);
+
+  ret = MEM_hUnlock(pinned);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_hUnlock(pinned);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_hUnlock(pinned);
+  CHECK(ret == -EPERM);
+
+  ret = MEM_hFree(pinned);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_hFree(tail);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_handleInvalid
+ *  @brief      Checks rejection of bad sizes, stale handles, unbalanced
+ *              unlocks and frees of locked handles.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_handleInvalid(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  mem_handle_t handle = 0;
+
+  void *data = (void *)NULL;
+
+  handle = MEM_hAlloc(0u);
+  CHECK(handle == -EINVAL);
+
+  data = MEM_hLock((mem_handle_t)0);
+  CHECK((intptr_t)data == -EINVAL);
+
+  ret = MEM_hFree((mem_handle_t)INT32_MAX);
+  CHECK(ret == -EINVAL);
+
+  handle = MEM_hAlloc(HANDLE_SIZE);
+  CHECK(handle > 0);
+
+  data = MEM_hLock(handle);
+  CHECK(data != NULL && (intptr_t)data > 0);
+
+  ret = MEM_hFree(handle);
+  CHECK(ret == -EBUSY);
+
+  ret = MEM_hUnlock(handle);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_hFree(handle);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_hFree(handle);
+  CHECK(ret == -EINVAL);
+
+  data = MEM_hLock(handle);
+  CHECK((intptr_t)data == -EINVAL);
+
+  return EXIT_SUCCESS;
+}
+
+/*< end of file >*/
@@ -0,0 +1,332 @@
+/*
+ * SPDX-FileCopyrightText: 2024-2025 Rafael V. Volkmer
+ * SPDX-FileCopyrightText: <rafael.v.volkmer@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+/** ============================================================================
+ *  @ingroup    Libmemalloc
+ *
+ *  @brief      Footprint limits and memory pressure test.
+ *
+ *  @file       test_limits.c
+ *  @headerfile libmemalloc.h
+ *
+ *  @details    Installs soft and hard footprint limits, checks that crossing
+ *              the soft limit runs the pressure callback (which evicts a
+ *              cached block through MEM_free()), that the hard limit refuses
+ *              growth with -ENOMEM, and that MEM_trim() hands free pages
+ *              back to the kernel.
+ *
+ *  @version    v1.0.00
+ *  @date       18.10.2026
+ *  @author     Rafael V. Volkmer <rafael.v.volkmer@gmail.com>
+ * ========================================================================== */
+
+/** ============================================================================
+ *                      P R I V A T E  I N C L U D E S
+ * ========================================================================== */
+
+/*< Implemented >*/
+#include "libmemalloc.h"
+#include "logs.h"
+
+/*< Dependencies >*/
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** ============================================================================
+ *               P R I V A T E  D E F I N E S  &  M A C R O S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @def        EXIT_ERROR
+ *  @brief      Standard error return code for test failures.
+ *
+ *  @details    Defined as a uint8_t value of 1 to indicate any
+ *              assertion or test step failure within the test suite.
+ *              Returned by test functions when a CHECK() fails.
+ * ========================================================================== */
+#define EXIT_ERROR (uint8_t)(1U)
+
+/** ============================================================================
+ *  @def        SOFT_LIMIT
+ *  @brief      Soft footprint limit installed by the test.
+ * ========================================================================== */
+#define SOFT_LIMIT (size_t)(1024U * 1024U)
+
+/** ============================================================================
+ *  @def        HARD_LIMIT
+ *  @brief      Hard footprint limit installed by the test.
+ * ========================================================================== */
+#define HARD_LIMIT (size_t)(4U * 1024U * 1024U)
+
+/** ============================================================================
+ *  @def        CACHE_SIZE
+ *  @brief      Size of the block evicted by the pressure callback.
+ * ========================================================================== */
+#define CACHE_SIZE (size_t)(512U * 1024U)
+
+/** ============================================================================
+ *  @def        TRIM_SIZE
+ *  @brief      Heap-backed block released by the trim test.
+ * ========================================================================== */
+#define TRIM_SIZE  (size_t)(64U * 1024U)
+
+/** ============================================================================
+ *  @def        PIN_SIZE
+ *  @brief      Block keeping the trimmed block away from the heap top.
+ * ========================================================================== */
+#define PIN_SIZE   (size_t)(16U * 1024U)
+
+/** ============================================================================
+ *  @def        CHECK(expr)
+ *  @brief      Assertion macro for validating test expressions.
+ *
+ *  @param [in] expr  Boolean expression to evaluate.
+ *
+ *  @details    Evaluates the given expression and, if false,
+ *              logs an error with file and line information,
+ *              then returns EXIT_ERROR from the current function.
+ *              Ensures immediate test termination on failure.
+ * ========================================================================== */
+#define CHECK(expr)                                                          \
+  do                                                                         \
+  {                                                                          \
+    if (!(expr))                                                             \
+    {                                                                        \
+      LOG_ERROR("Assertion failed at %s:%d: %s", __FILE__, __LINE__, #expr); \
+      return EXIT_ERROR;                                                     \
+    }                                                                        \
+  } while (0)
+
+/** ============================================================================
+ *                  P R I V A T E  T Y P E S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @struct     PressureState
+ *  @typedef    pressure_state_t
+ *  @brief      Observations collected by TEST_onPressure().
+ * ========================================================================== */
+typedef struct PressureState
+{
+  void *cache;       /**< Block evicted on the first soft event */
+
+  size_t soft_hits;  /**< Number of MEM_PRESSURE_SOFT events */
+  size_t hard_hits;  /**< Number of MEM_PRESSURE_HARD events */
+  size_t footprint;  /**< Footprint reported by the last event */
+} pressure_state_t;
+
+/** ============================================================================
+ *          P R I V A T E  F U N C T I O N S  P R O T O T Y P E S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         TEST_onPressure
+ *  @brief      Pressure callback: records the event and evicts the cache.
+ *
+ *  @param[in]  level     Pressure severity.
+ *  @param[in]  footprint Footprint reported by the allocator.
+ *  @param[in]  arg       Pointer to a pressure_state_t.
+ * ========================================================================== */
+static void TEST_onPressure(const mem_pressure_level_t level,
+                            const size_t               footprint,
+                            void *const                arg);
+
+/** ============================================================================
+ *  @fn         TEST_limitEvents
+ *  @brief      Checks soft-limit callbacks and hard-limit refusal.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_limitEvents(void);
+
+/** ============================================================================
+ *  @fn         TEST_limitInvalid
+ *  @brief      Checks rejection of inconsistent limits and NULL callbacks.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_limitInvalid(void);
+
+/** ============================================================================
+ *  @fn         TEST_trim
+ *  @brief      Checks that MEM_trim() releases the pages of a free block and
+ *              that the block is reusable afterwards.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_trim(void);
+
+/** ============================================================================
+ *                          M A I N  F U N C T I O N
+ * ========================================================================== */
+
+int main(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  ret = TEST_limitEvents( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_limitInvalid( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_trim( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  LOG_INFO("Limits test passed.\n");
+  return ret;
+}
+
+/** ============================================================================
+ *                  F U N C T I O N S  D E F I N I T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         TEST_onPressure
+ *  @brief      Pressure callback: records the event and evicts the cache.
+ *
+ *  @param[in]  level     Pressure severity.
+ *  @param[in]  footprint Footprint reported by the allocator.
+ *  @param[in]  arg       Pointer to a pressure_state_t.
+ * ========================================================================== */
+static void TEST_onPressure(const mem_pressure_level_t level,
+                            const size_t               footprint,
+                            void *const                arg)
+{
+  pressure_state_t *state = (pressure_state_t *)arg;
+
+  state->footprint = footprint;
+
+  if (level == MEM_PRESSURE_HARD)
+    state->hard_hits++;
+  else
+    state->soft_hits++;
+
+  if (state->cache != NULL)
+  {
+    (void)MEM_free(state->cache);
+    state->cache = NULL;
+  }
+}
+
+/** ============================================================================
+ *  @fn         TEST_limitEvents
+ *  @brief      Checks soft-limit callbacks and hard-limit refusal.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_limitEvents(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  static pressure_state_t state = { 0 };
+
+  void *block = (void *)NULL;
+  void *huge  = (void *)NULL;
+
+  ret = MEM_onPressure(TEST_onPressure, &state);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_setLimit(SOFT_LIMIT, HARD_LIMIT);
+  CHECK(ret == EXIT_SUCCESS);
+
+  state.cache = MEM_alloc(CACHE_SIZE, FIRST_FIT);
+  CHECK(state.cache != NULL);
+  CHECK(state.soft_hits == 0u);
+
+  block = MEM_alloc(CACHE_SIZE + CACHE_SIZE / 2u, FIRST_FIT);
+  CHECK(block != NULL);
+  CHECK(state.soft_hits == 1u);
+  CHECK(state.footprint > SOFT_LIMIT);
+  CHECK(state.cache == NULL);
+
+  huge = MEM_alloc(HARD_LIMIT, FIRST_FIT);
+  CHECK((intptr_t)huge == -ENOMEM);
+  CHECK(state.hard_hits == 1u);
+
+  ret = MEM_free(block);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_setLimit(0u, 0u);
+  CHECK(ret == EXIT_SUCCESS);
+
+  huge = MEM_alloc(HARD_LIMIT, FIRST_FIT);
+  CHECK(huge != NULL && (intptr_t)huge > 0);
+
+  ret = MEM_free(huge);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_limitInvalid
+ *  @brief      Checks rejection of inconsistent limits and NULL callbacks.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_limitInvalid(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  ret = MEM_setLimit(HARD_LIMIT, SOFT_LIMIT);
+  CHECK(ret == -EINVAL);
+
+  ret = MEM_onPressure((mem_pressure_cb_t)NULL, NULL);
+  CHECK(ret == -EINVAL);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_trim
+ *  @brief      Checks that MEM_trim() releases the pages of a free block and
+ *              that the block is reusable afterwards.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_trim(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  intptr_t released = 0;
+
+  void *block = (void *)NULL;
+  void *pin   = (void *)NULL;
+
+  block = MEM_alloc(TRIM_SIZE, FIRST_FIT);
+  CHECK(block != NULL);
+
+  pin = MEM_alloc(PIN_SIZE, FIRST_FIT);
+  CHECK(pin != NULL);
+
+  MEM_memset(block, 0xA5, TRIM_SIZE);
+
+  ret = MEM_free(block);
+  CHECK(ret == EXIT_SUCCESS);
+
+  released = MEM_trim( );
+  CHECK(released >= (intptr_t)(TRIM_SIZE / 2u));
+
+  block = MEM_alloc(TRIM_SIZE, FIRST_FIT);
+  CHECK(block != NULL);
+
+  MEM_memset(block, 0x5A, TRIM_SIZE);
+  CHECK(((uint8_t *)block)[TRIM_SIZE - 1u] == 0x5A);
+
+  ret = MEM_free(block);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_free(pin);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/*< end of file >*/
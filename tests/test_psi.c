@@ -0,0 +1,191 @@
+/*
+ * SPDX-FileCopyrightText: 2024-2025 Rafael V. Volkmer
+ * SPDX-FileCopyrightText: <rafael.v.volkmer@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+/** ============================================================================
+ *  @ingroup    Libmemalloc
+ *
+ *  @brief      Pressure-stall (PSI) monitor test.
+ *
+ *  @file       test_psi.c
+ *  @headerfile libmemalloc.h
+ *
+ *  @details    Validates the arguments of MEM_psiMonitorStart(), then starts
+ *              and stops the monitor. Kernels or sandboxes without PSI (or
+ *              refusing the trigger) must be reported through a negative
+ *              error code without leaving a thread behind.
+ *
+ *  @version    v1.0.00
+ *  @date       18.10.2026
+ *  @author     Rafael V. Volkmer <rafael.v.volkmer@gmail.com>
+ * ========================================================================== */
+
+/** ============================================================================
+ *                      P R I V A T E  I N C L U D E S
+ * ========================================================================== */
+
+/*< Implemented >*/
+#include "libmemalloc.h"
+#include "logs.h"
+
+/*< Dependencies >*/
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/** ============================================================================
+ *               P R I V A T E  D E F I N E S  &  M A C R O S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @def        EXIT_ERROR
+ *  @brief      Standard error return code for test failures.
+ *
+ *  @details    Defined as a uint8_t value of 1 to indicate any
+ *              assertion or test step failure within the test suite.
+ *              Returned by test functions when a CHECK() fails.
+ * ========================================================================== */
+#define EXIT_ERROR (uint8_t)(1U)
+
+/** ============================================================================
+ *  @def        STALL_US
+ *  @brief      Stall threshold of the test trigger.
+ * ========================================================================== */
+#define STALL_US   (uint32_t)(150000U)
+
+/** ============================================================================
+ *  @def        WINDOW_US
+ *  @brief      Window of the test trigger (2 s, allowed unprivileged).
+ * ========================================================================== */
+#define WINDOW_US  (uint32_t)(2000000U)
+
+/** ============================================================================
+ *  @def        CHECK(expr)
+ *  @brief      Assertion macro for validating test expressions.
+ *
+ *  @param [in] expr  Boolean expression to evaluate.
+ *
+ *  @details    Evaluates the given expression and, if false,
+ *              logs an error with file and line information,
+ *              then returns EXIT_ERROR from the current function.
+ *              Ensures immediate test termination on failure.
+ * ========================================================================== */
+#define CHECK(expr)                                                          \
+  do                                                                         \
+  {                                                                          \
+    if (!(expr))                                                             \
+    {                                                                        \
+      LOG_ERROR("Assertion failed at %s:%d: %s", __FILE__, __LINE__, #expr); \
+      return EXIT_ERROR;                                                     \
+    }                                                                        \
+  } while (0)
+
+/** ============================================================================
+ *          P R I V A T E  F U N C T I O N S  P R O T O T Y P E S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         TEST_psiInvalid
+ *  @brief      Checks rejection of inconsistent triggers.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_psiInvalid(void);
+
+/** ============================================================================
+ *  @fn         TEST_psiLifecycle
+ *  @brief      Starts and stops the monitor, or checks graceful refusal.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_psiLifecycle(void);
+
+/** ============================================================================
+ *                          M A I N  F U N C T I O N
+ * ========================================================================== */
+
+int main(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  ret = TEST_psiInvalid( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_psiLifecycle( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  LOG_INFO("PSI monitor test passed.\n");
+  return ret;
+}
+
+/** ============================================================================
+ *                  F U N C T I O N S  D E F I N I T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         TEST_psiInvalid
+ *  @brief      Checks rejection of inconsistent triggers.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_psiInvalid(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  ret = MEM_psiMonitorStart(0u, WINDOW_US);
+  CHECK(ret == -EINVAL);
+
+  ret = MEM_psiMonitorStart(WINDOW_US + 1u, WINDOW_US);
+  CHECK(ret == -EINVAL);
+
+  ret = MEM_psiMonitorStop( );
+  CHECK(ret == -EINVAL);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_psiLifecycle
+ *  @brief      Starts and stops the monitor, or checks graceful refusal.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_psiLifecycle(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  void *ptr = (void *)NULL;
+
+  ret = MEM_psiMonitorStart(STALL_US, WINDOW_US);
+  if (ret != EXIT_SUCCESS)
+  {
+    CHECK(ret < 0);
+    LOG_INFO("PSI not available here (%d), lifecycle skipped.\n", ret);
+
+    ret = MEM_psiMonitorStop( );
+    CHECK(ret == -EINVAL);
+    return EXIT_SUCCESS;
+  }
+
+  ret = MEM_psiMonitorStart(STALL_US, WINDOW_US);
+  CHECK(ret == -EALREADY);
+
+  ptr = MEM_alloc(sizeof(uint64_t), FIRST_FIT);
+  CHECK(ptr != NULL);
+
+  ret = MEM_free(ptr);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_psiMonitorStop( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_psiMonitorStop( );
+  CHECK(ret == -EINVAL);
+
+  return EXIT_SUCCESS;
+}
+
+/*< end of file >*/
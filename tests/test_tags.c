@@ -0,0 +1,371 @@
+/*
+ * SPDX-FileCopyrightText: 2024-2025 Rafael V. Volkmer
+ * SPDX-FileCopyrightText: <rafael.v.volkmer@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+/** ============================================================================
+ *  @ingroup    Libmemalloc
+ *
+ *  @brief      Per-tag memory accounting test.
+ *
+ *  @file       test_tags.c
+ *  @headerfile libmemalloc.h
+ *
+ *  @details    Registers a tag, allocates and frees tagged blocks (heap and
+ *              mmap backed) and verifies live, peak, count and soft-limit
+ *              counters reported by MEM_getTagStats(), including a peak
+ *              allocated and freed between two reads. Also checks that
+ *              MEM_realloc() keeps the tag and that unknown tags are
+ *              rejected.
+ *
+ *  @version    v1.0.00
+ *  @date       18.10.2026
+ *  @author     Rafael V. Volkmer <rafael.v.volkmer@gmail.com>
+ * ========================================================================== */
+
+/** ============================================================================
+ *                      P R I V A T E  I N C L U D E S
+ * ========================================================================== */
+
+/*< Implemented >*/
+#include "libmemalloc.h"
+#include "logs.h"
+
+/*< Dependencies >*/
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** ============================================================================
+ *               P R I V A T E  D E F I N E S  &  M A C R O S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @def        EXIT_ERROR
+ *  @brief      Standard error return code for test failures.
+ *
+ *  @details    Defined as a uint8_t value of 1 to indicate any
+ *              assertion or test step failure within the test suite.
+ *              Returned by test functions when a CHECK() fails.
+ * ========================================================================== */
+#define EXIT_ERROR   (uint8_t)(1U)
+
+/** ============================================================================
+ *  @def        SMALL_SIZE
+ *  @brief      Payload size of the heap-backed tagged allocations.
+ * ========================================================================== */
+#define SMALL_SIZE   (size_t)(128U)
+
+/** ============================================================================
+ *  @def        LARGE_SIZE
+ *  @brief      Payload size of the mmap-backed tagged allocation.
+ * ========================================================================== */
+#define LARGE_SIZE   (size_t)(256U * 1024U)
+
+/** ============================================================================
+ *  @def        NUM_BLOCKS
+ *  @brief      Number of heap-backed tagged allocations.
+ * ========================================================================== */
+#define NUM_BLOCKS   (uint8_t)(4U)
+
+/** ============================================================================
+ *  @def        CHECK(expr)
+ *  @brief      Assertion macro for validating test expressions.
+ *
+ *  @param [in] expr  Boolean expression to evaluate.
+ *
+ *  @details    Evaluates the given expression and, if false,
+ *              logs an error with file and line information,
+ *              then returns EXIT_ERROR from the current function.
+ *              Ensures immediate test termination on failure.
+ * ========================================================================== */
+#define CHECK(expr)                                                          \
+  do                                                                         \
+  {                                                                          \
+    if (!(expr))                                                             \
+    {                                                                        \
+      LOG_ERROR("Assertion failed at %s:%d: %s", __FILE__, __LINE__, #expr); \
+      return EXIT_ERROR;                                                     \
+    }                                                                        \
+  } while (0)
+
+/** ============================================================================
+ *          P R I V A T E  F U N C T I O N S  P R O T O T Y P E S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         TEST_tagAccounting
+ *  @brief      Checks live/peak/count bookkeeping of a registered tag.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_tagAccounting(void);
+
+/** ============================================================================
+ *  @fn         TEST_tagSoftLimit
+ *  @brief      Checks that allocations above a soft limit succeed and are
+ *              counted in limit_hits.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_tagSoftLimit(void);
+
+/** ============================================================================
+ *  @fn         TEST_tagPeak
+ *  @brief      Checks that a block allocated and freed between two stats
+ *              reads still shows in peak_bytes.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_tagPeak(void);
+
+/** ============================================================================
+ *  @fn         TEST_tagInvalid
+ *  @brief      Checks rejection of invalid names and unregistered tags.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_tagInvalid(void);
+
+/** ============================================================================
+ *                          M A I N  F U N C T I O N
+ * ========================================================================== */
+
+int main(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  ret = TEST_tagAccounting( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_tagSoftLimit( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_tagPeak( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = TEST_tagInvalid( );
+  CHECK(ret == EXIT_SUCCESS);
+
+  LOG_INFO("Tag accounting test passed.\n");
+  return ret;
+}
+
+/** ============================================================================
+ *                  F U N C T I O N S  D E F I N I T I O N S
+ * ========================================================================== */
+
+/** ============================================================================
+ *  @fn         TEST_tagAccounting
+ *  @brief      Checks live/peak/count bookkeeping of a registered tag.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_tagAccounting(void)
+{
+  int tag   = 0;
+  int again = 0;
+  int ret   = EXIT_SUCCESS;
+
+  void *blocks[NUM_BLOCKS] = { NULL };
+  void *large              = (void *)NULL;
+
+  mem_tag_stats_t stats = { 0 };
+
+  size_t peak     = 0u;
+  size_t iterator = 0u;
+
+  tag = MEM_registerTag("cache");
+  CHECK(tag > (int)MEM_TAG_DEFAULT);
+
+  again = MEM_registerTag("cache");
+  CHECK(again == tag);
+
+  again = MEM_registerTag("default");
+  CHECK(again == (int)MEM_TAG_DEFAULT);
+
+  for (iterator = 0u; iterator < NUM_BLOCKS; ++iterator)
+  {
+    blocks[iterator] = MEM_allocTagged(SMALL_SIZE, (uint32_t)tag);
+    CHECK(blocks[iterator] != NULL);
+  }
+
+  ret = MEM_getTagStats((uint32_t)tag, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(stats.alloc_count == NUM_BLOCKS);
+  CHECK(stats.free_count == 0u);
+  CHECK(stats.live_bytes >= NUM_BLOCKS * SMALL_SIZE);
+
+  large = MEM_allocTagged(LARGE_SIZE, (uint32_t)tag);
+  CHECK(large != NULL);
+
+  ret = MEM_getTagStats((uint32_t)tag, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(stats.live_bytes >= NUM_BLOCKS * SMALL_SIZE + LARGE_SIZE);
+
+  peak = stats.peak_bytes;
+  CHECK(peak >= stats.live_bytes);
+
+  ret = MEM_free(large);
+  CHECK(ret == EXIT_SUCCESS);
+
+  blocks[0] = MEM_realloc(blocks[0], 4u * SMALL_SIZE, FIRST_FIT);
+  CHECK(blocks[0] != NULL);
+
+  ret = MEM_getTagStats((uint32_t)tag, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(stats.alloc_count == NUM_BLOCKS + 2u);
+  CHECK(stats.free_count == 2u);
+  CHECK(stats.peak_bytes == peak);
+
+  for (iterator = 0u; iterator < NUM_BLOCKS; ++iterator)
+  {
+    ret = MEM_free(blocks[iterator]);
+    CHECK(ret == EXIT_SUCCESS);
+  }
+
+  ret = MEM_getTagStats((uint32_t)tag, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(stats.live_bytes == 0u);
+  CHECK(stats.alloc_count == stats.free_count);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_tagSoftLimit
+ *  @brief      Checks that allocations above a soft limit succeed and are
+ *              counted in limit_hits.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_tagSoftLimit(void)
+{
+  int tag = 0;
+  int ret = EXIT_SUCCESS;
+
+  void *first  = (void *)NULL;
+  void *second = (void *)NULL;
+
+  mem_tag_stats_t stats = { 0 };
+
+  tag = MEM_registerTag("sessions");
+  CHECK(tag > (int)MEM_TAG_DEFAULT);
+
+  ret = MEM_setTagLimit((uint32_t)tag, SMALL_SIZE + SMALL_SIZE / 2u);
+  CHECK(ret == EXIT_SUCCESS);
+
+  first = MEM_allocTagged(SMALL_SIZE, (uint32_t)tag);
+  CHECK(first != NULL);
+
+  ret = MEM_getTagStats((uint32_t)tag, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(stats.limit_hits == 0u);
+
+  second = MEM_allocTagged(SMALL_SIZE, (uint32_t)tag);
+  CHECK(second != NULL);
+
+  ret = MEM_getTagStats((uint32_t)tag, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(stats.limit_hits == 1u);
+  CHECK(stats.soft_limit == SMALL_SIZE + SMALL_SIZE / 2u);
+
+  ret = MEM_free(second);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_free(first);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_tagPeak
+ *  @brief      Checks that a block allocated and freed between two stats
+ *              reads still shows in peak_bytes.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_tagPeak(void)
+{
+  int tag = 0;
+  int ret = EXIT_SUCCESS;
+
+  void *base  = (void *)NULL;
+  void *spike = (void *)NULL;
+
+  mem_tag_stats_t stats = { 0 };
+
+  size_t live = 0u;
+  size_t peak = 0u;
+
+  tag = MEM_registerTag("spikes");
+  CHECK(tag > (int)MEM_TAG_DEFAULT);
+
+  base = MEM_allocTagged(SMALL_SIZE, (uint32_t)tag);
+  CHECK(base != NULL);
+
+  ret = MEM_getTagStats((uint32_t)tag, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(stats.peak_bytes == stats.live_bytes);
+  live = stats.live_bytes;
+
+  spike = MEM_allocTagged(LARGE_SIZE, (uint32_t)tag);
+  CHECK(spike != NULL);
+
+  ret = MEM_free(spike);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_getTagStats((uint32_t)tag, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(stats.live_bytes == live);
+  CHECK(stats.peak_bytes >= live + LARGE_SIZE);
+  peak = stats.peak_bytes;
+
+  ret = MEM_free(base);
+  CHECK(ret == EXIT_SUCCESS);
+
+  ret = MEM_getTagStats((uint32_t)tag, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+  CHECK(stats.live_bytes == 0u);
+  CHECK(stats.peak_bytes == peak);
+
+  return EXIT_SUCCESS;
+}
+
+/** ============================================================================
+ *  @fn         TEST_tagInvalid
+ *  @brief      Checks rejection of invalid names and unregistered tags.
+ *
+ *  @return     EXIT_SUCCESS on correct behavior, EXIT_ERROR on failure.
+ * ========================================================================== */
+static int TEST_tagInvalid(void)
+{
+  int ret = EXIT_SUCCESS;
+
+  void *ptr = (void *)NULL;
+
+  mem_tag_stats_t stats = { 0 };
+
+  ret = MEM_registerTag("");
+  CHECK(ret == -EINVAL);
+
+  ptr = MEM_allocTagged(SMALL_SIZE, MEM_MAX_TAGS);
+  CHECK((intptr_t)ptr == -EINVAL);
+
+  ret = MEM_setTagLimit(MEM_MAX_TAGS, SMALL_SIZE);
+  CHECK(ret == -EINVAL);
+
+  ret = MEM_getTagStats(MEM_TAG_DEFAULT, (mem_tag_stats_t *)NULL);
+  CHECK(ret == -EINVAL);
+
+  ret = MEM_getTagStats(MEM_TAG_DEFAULT, &stats);
+  CHECK(ret == EXIT_SUCCESS);
+
+  return EXIT_SUCCESS;
+}
+
+/*< end of file >*/